@@ -31,8 +31,16 @@
  *  @author federico.marulli3@unbo.it
  */
 
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <atomic>
+
 #include "Field3D.h"
 #include "Catalogue.h"
+#include "ColumnarFile.h"
+#include "CatalogueView.h"
+#include "MangleMask.h"
 
 using namespace std;
 
@@ -40,6 +48,11 @@ using namespace cbl;
 using namespace catalogue;
 using namespace chainmesh;
 
+// the number of modifications of the objects made through any catalogue: since the copies of a
+// catalogue share the objects, the cached statistics are valid only if no catalogue has modified
+// the objects after they have been computed
+static std::atomic<size_t> objects_modifications {0};
+
 
 // ============================================================================
 
@@ -117,110 +130,375 @@ cbl::catalogue::Catalogue::Catalogue (const ObjectType objectType, const Coordin
 
 cbl::catalogue::Catalogue::Catalogue (const ObjectType objectType, const CoordinateType coordinateType, const std::vector<std::string> file, const int col1, const int col2, const int col3, const int colWeight, const int colRegion, const double nSub, const double fact, const cosmology::Cosmology &cosm, const CoordinateUnits inputUnits, const CharEncode charEncode, const std::string comment, const int seed) 
 { 
-  // parameters for random numbers used in case nSub!=1
-  random::UniformRandomNumbers ran(0., 1., seed);
+  // the ASCII files are read in parallel
   
-  // read the input catalogue files
+  if (charEncode==CharEncode::_ascii_)
+    m_read_ascii(objectType, coordinateType, file, col1, col2, col3, colWeight, colRegion, nSub, fact, cosm, inputUnits, comment, seed);
+
+  else {
+    
+    // parameters for random numbers used in case nSub!=1
+    random::UniformRandomNumbers ran(0., 1., seed);
   
-  for (size_t dd=0; dd<file.size(); ++dd) {
+    // read the input catalogue files
+  
+    for (size_t dd=0; dd<file.size(); ++dd) {
 
-    string line, file_in = file[dd];
+      string file_in = file[dd];
          
-    if (charEncode==CharEncode::_ascii_) {
-	  
-      coutCBL << "I'm reading the catalogue: " << file_in << endl;
-      ifstream finr(file_in.c_str()); checkIO(finr, file_in);
+      if (charEncode==CharEncode::_binary_) {
+            
+	// read the input catalogue files
+	
+	coutCBL << "I'm reading the catalogue: " << file_in << endl;
+
+	short num_bin;
+	float val;
       
-      double Weight, Value; long Region;
+	ifstream finr(file_in.c_str(), ios::in|ios::binary|ios::ate); checkIO(finr, file_in);	
+
+	comovingCoordinates coord;
+
+	if (finr.is_open())
+	  finr.seekg(0, ios::beg);
+      
+	finr.read((char*)(&num_bin), 2);
+
+	int n_blocks = num_bin;
+      
+	for (int i=1; i<=n_blocks; ++i) {
+	  finr.read((char*)(&num_bin), 4);
+	  int n_objs = num_bin;
+
+	  for (int j=1; j<=n_objs; ++j) {
+	    finr.read((char*)(&val), 4);
+	    coord.xx = (val)*fact;
+	    finr.read((char*)(&val), 4);
+	    coord.yy = (val)*fact;
+	    finr.read((char*)(&val), 4);
+	    coord.zz = (val)*fact;
+	    // Weight = (colWeight!=-1 && colWeight-1<value.size()) ? value[colWeight-1] : 1.;
+	    // Region = (colRegion!=-1 && colRegion-1<value.size()) ? (long)value[colRegion-1] : 0;
+	    if (ran()<nSub) m_object.push_back(move(Object::Create(objectType, coord)));
+	    // if (ran()<nSub) m_object.push_back(move(Object::Create(objectType, coord, Weight, Region)));
+	  }
+	
+	  finr.read((char*)(&num_bin), 4);
+
+	  int n_objs2 = num_bin;
+	
+	  if (n_objs2!=n_objs) ErrorCBL("Error in cbl::catalogue::Catalogue::Catalogue() in Catalogue.cpp: wrong reading of input binary file");
+	}
+      
+	finr.clear(); finr.close();
+      }
+
+      else if (charEncode==CharEncode::_columnar_) {
+
+	// memory-map the input catalogue file: only the required columns are read from disk
+      
+	coutCBL << "I'm reading the catalogue: " << file_in << endl;
+
+	const ColumnarFile cf(file_in);
+
+	const bool comoving = cf.isSetVar(Var::_X_) && cf.isSetVar(Var::_Y_) && cf.isSetVar(Var::_Z_);
+	const bool observed = cf.isSetVar(Var::_RA_) && cf.isSetVar(Var::_Dec_);
+	const bool isSet_redshift = cf.isSetVar(Var::_Redshift_);
+	const bool isSet_weight = cf.isSetVar(Var::_Weight_);
+	const bool isSet_region = cf.isSetVar(Var::_Region_);
+
+	if (coordinateType==cbl::CoordinateType::_comoving_ && !comoving)
+	  ErrorCBL("Error in cbl::catalogue::Catalogue::Catalogue() in Catalogue.cpp: the comoving coordinates are not stored in "+file_in+"!");
+	if (coordinateType==cbl::CoordinateType::_observed_ && !observed)
+	  ErrorCBL("Error in cbl::catalogue::Catalogue::Catalogue() in Catalogue.cpp: the observed coordinates are not stored in "+file_in+"!");
+	if (coordinateType!=cbl::CoordinateType::_comoving_ && coordinateType!=cbl::CoordinateType::_observed_)
+	  ErrorCBL("Error in cbl::catalogue::Catalogue::Catalogue() in Catalogue.cpp: CoordinateType is not valid!");
+
+	// the columns are resolved once: the floating point columns are read directly from the
+	// memory map, while the regions, stored as integers, are converted
+	auto column = [&cf] (const Var var) { return (cf.isSetVar(var)) ? cf.column(var) : nullptr; };
+	const double *X = column(Var::_X_), *Y = column(Var::_Y_), *Z = column(Var::_Z_);
+	const double *RA = column(Var::_RA_), *Dec = column(Var::_Dec_), *Redshift = column(Var::_Redshift_), *Weight = column(Var::_Weight_);
+	const vector<double> Region = (isSet_region) ? cf.column_vector(Var::_Region_) : vector<double>();
+
+	// the objects are created in parallel, in blocks of rows; the random subsampling of each
+	// block uses its own seed, so that the selected objects do not depend on the number of threads
+	const long nObj = cf.nObjects(), block_size = 100000, nBlocks = (nObj+block_size-1)/block_size;
+	vector<vector<shared_ptr<Object>>> object(nBlocks);
+
+#pragma omp parallel for schedule(dynamic)
+	for (long bb=0; bb<nBlocks; ++bb) {
+
+	  random::UniformRandomNumbers ran_block(0., 1., seed+dd*nBlocks+bb);
+	  
+	  for (long i=bb*block_size; i<min(nObj, (bb+1)*block_size); ++i) {
+	    
+	    if (ran_block()<nSub) { // extract a subsample
+
+	      const double ww = (isSet_weight) ? Weight[i] : 1.;
+	      const long rr = (isSet_region) ? (long)Region[i] : 0;
+
+	      if (comoving && observed && isSet_redshift) // both comoving and observed coordinates
+		object[bb].push_back(move(Object::Create(objectType, X[i]*fact, Y[i]*fact, Z[i]*fact, RA[i], Dec[i], Redshift[i], ww, rr)));
+	  
+	      else if (coordinateType==cbl::CoordinateType::_comoving_) { // comoving coordinates (x, y, z)
+		comovingCoordinates coord;
+		coord.xx = X[i]*fact;
+		coord.yy = Y[i]*fact;
+		coord.zz = Z[i]*fact;
+		object[bb].push_back(move(Object::Create(objectType, coord, ww, rr)));
+	      }
+
+	      else { // observed coordinates (R.A., Dec (redshift)), stored in radians
+		observedCoordinates coord;
+		coord.ra = RA[i];
+		coord.dec = Dec[i];
+		coord.redshift = (isSet_redshift) ? Redshift[i] : 1.;
+		object[bb].push_back(move(Object::Create(objectType, coord, cosm, ww, rr)));
+	      }
+	    }
+	  }
+	}
+
+	// store the objects, in the order of the file
+	size_t nTot = m_object.size();
+	for (auto &&obj : object) nTot += obj.size();
+	m_object.reserve(nTot);
+	
+	for (auto &&obj : object)
+	  m_object.insert(m_object.end(), make_move_iterator(obj.begin()), make_move_iterator(obj.end()));
+      }
+        
+      else ErrorCBL("Error in cbl::catalogue::Catalogue::Catalogue() in Catalogue.cpp: charEncode is not valid!");
+    }
+  }
+}
+
+
+// ============================================================================
+
+
+/**
+ *  @brief parse a floating point number
+ *
+ *  the number is parsed independently of the locale; the numbers
+ *  with at most 15 significant digits and a decimal exponent
+ *  smaller than 22 in absolute value, i.e. most of the numbers
+ *  written in catalogue files, are computed exactly with a single
+ *  floating point operation, while the others are parsed with
+ *  std::strtod
+ *
+ *  @param ptr pointer to the first character to be parsed; leading
+ *  blank characters are skipped
+ *
+ *  @param end pointer to the end of the line
+ *
+ *  @param value the parsed number
+ *
+ *  @return pointer to the first character after the number, or
+ *  nullptr if no number can be parsed
+ */
+static const char *parse_double (const char *ptr, const char *end, double &value)
+{
+  static const double pow10[] = {1.e0, 1.e1, 1.e2, 1.e3, 1.e4, 1.e5, 1.e6, 1.e7, 1.e8, 1.e9, 1.e10, 1.e11, 1.e12, 1.e13, 1.e14, 1.e15, 1.e16, 1.e17, 1.e18, 1.e19, 1.e20, 1.e21, 1.e22};
+  
+  while (ptr<end && (*ptr==' ' || *ptr=='\t' || *ptr=='\r')) ++ptr;
+
+  const char *begin = ptr;
+
+  bool negative = false;
+  if (ptr<end && (*ptr=='+' || *ptr=='-')) negative = (*ptr++=='-');
+
+  unsigned long long mantissa = 0;
+  int nDigits = 0, exponent = 0;
+  bool digits = false;
+
+  // integer and fractional parts: the digits after the 19th are only counted
+  
+  for (; ptr<end && *ptr>='0' && *ptr<='9'; ++ptr, digits=true) {
+    if (nDigits<19) { mantissa = 10*mantissa+(*ptr-'0'); if (mantissa>0) nDigits ++; }
+    else exponent ++;
+  }
+
+  if (ptr<end && *ptr=='.')
+    for (++ptr; ptr<end && *ptr>='0' && *ptr<='9'; ++ptr, digits=true)
+      if (nDigits<19) { mantissa = 10*mantissa+(*ptr-'0'); if (mantissa>0) nDigits ++; exponent --; }
+
+  if (!digits) return nullptr;
+
+  // exponent
+  
+  if (ptr+1<end && (*ptr=='e' || *ptr=='E')) {
+    const char *pp = ptr+1;
+    bool negative_exp = false;
+    if (*pp=='+' || *pp=='-') negative_exp = (*pp++=='-');
+    if (pp<end && *pp>='0' && *pp<='9') {
+      int nExp = 0;
+      for (; pp<end && *pp>='0' && *pp<='9'; ++pp)
+	if (nExp<100000) nExp = 10*nExp+(*pp-'0');
+      exponent += (negative_exp) ? -nExp : nExp;
+      ptr = pp;
+    }
+  }
+
+  // the mantissa and the power of 10 are exactly represented as doubles
+  
+  if (nDigits<=15 && exponent>=-22 && exponent<=22) {
+    value = (exponent<0) ? mantissa/pow10[-exponent] : mantissa*pow10[exponent];
+    if (negative) value = -value;
+  }
+  else {
+    const string number(begin, ptr);
+    value = strtod(number.c_str(), nullptr);
+  }
+  
+  return ptr;
+}
+
+
+// ============================================================================
+
+
+void cbl::catalogue::Catalogue::m_read_ascii (const ObjectType objectType, const CoordinateType coordinateType, const std::vector<std::string> file, const int col1, const int col2, const int col3, const int colWeight, const int colRegion, const double nSub, const double fact, const cosmology::Cosmology &cosm, const CoordinateUnits inputUnits, const std::string comment, const int seed)
+{
+  if (coordinateType!=cbl::CoordinateType::_comoving_ && coordinateType!=cbl::CoordinateType::_observed_)
+    ErrorCBL("Error in cbl::catalogue::Catalogue::m_read_ascii() in Catalogue.cpp: CoordinateType is not valid!");
+  
+  const size_t nFiles = file.size();
+
+  
+  // memory-map the input catalogue files
+
+  vector<const char*> map(nFiles, nullptr);
+  vector<size_t> size(nFiles, 0);
+
+  for (size_t dd=0; dd<nFiles; ++dd) {
+    
+    coutCBL << "I'm reading the catalogue: " << file[dd] << endl;
+
+    const int fd = open(file[dd].c_str(), O_RDONLY);
+    if (fd<0) ErrorCBL("Error in cbl::catalogue::Catalogue::m_read_ascii() in Catalogue.cpp: the file "+file[dd]+" cannot be opened!");
+
+    struct stat st;
+    fstat(fd, &st);
+    size[dd] = st.st_size;
+
+    if (size[dd]>0) {
+      void *mm = mmap(nullptr, size[dd], PROT_READ, MAP_PRIVATE, fd, 0);
+      if (mm==MAP_FAILED) { close(fd); ErrorCBL("Error in cbl::catalogue::Catalogue::m_read_ascii() in Catalogue.cpp: the file "+file[dd]+" cannot be mapped!"); }
+      madvise(mm, size[dd], MADV_SEQUENTIAL);
+      map[dd] = static_cast<const char*>(mm);
+    }
+    
+    close(fd);
+  }
+
+  
+  // split the files in chunks of lines of about 4 MB: the chunks do
+  // not depend on the number of threads, and the chunks of different
+  // files are parsed concurrently
+
+  const size_t chunk_size = 4194304;
+  
+  vector<size_t> chunk_file, chunk_begin, chunk_end;
+  
+  for (size_t dd=0; dd<nFiles; ++dd) {
+    size_t begin = 0;
+    while (begin<size[dd]) {
+      size_t end = min(begin+chunk_size, size[dd]);
+      if (end<size[dd]) {
+	const char *eol = static_cast<const char*>(memchr(map[dd]+end, '\n', size[dd]-end));
+	end = (eol!=nullptr) ? eol-map[dd]+1 : size[dd];
+      }
+      chunk_file.emplace_back(dd);
+      chunk_begin.emplace_back(begin);
+      chunk_end.emplace_back(end);
+      begin = end;
+    }
+  }
+
+  const long nChunks = chunk_file.size();
+
+  
+  // parse the chunks
+  
+  vector<vector<shared_ptr<Object>>> object(nChunks);
+  vector<string> error(nChunks);
+
+  const int colMax = (coordinateType==cbl::CoordinateType::_comoving_) ? max(max(col1, col2), col3) : max(col1, col2);
+  
+#pragma omp parallel for schedule(dynamic)
+  for (long cc=0; cc<nChunks; ++cc) {
+
+    // parameters for random numbers used in case nSub!=1
+    random::UniformRandomNumbers ran(0., 1., seed+cc);
+
+    const char *ptr = map[chunk_file[cc]]+chunk_begin[cc];
+    const char *chunk_end_ptr = map[chunk_file[cc]]+chunk_end[cc];
+    
+    vector<double> value;
+    
+    while (ptr<chunk_end_ptr && error[cc].empty()) { // read the lines
+
+      const char *eol = static_cast<const char*>(memchr(ptr, '\n', chunk_end_ptr-ptr));
+      if (eol==nullptr) eol = chunk_end_ptr;
+
+      const char *first = ptr;
+      while (first<eol && (*first==' ' || *first=='\t' || *first=='\r')) ++first;
       
-      while (getline(finr, line)) { // read the lines
+      if (first<eol && search(ptr, eol, comment.begin(), comment.end())==eol) { // skip empty lines and comments
 
-	if (line.find(comment)==string::npos) { // skip a comment
+	if (ran()<nSub) { // extract a subsample
 
-	  if (ran()<nSub) { // extract a subsample
+	  value.clear();
+	  double Value;
+	  for (const char *pp=ptr; (pp=parse_double(pp, eol, Value))!=nullptr; ) value.emplace_back(Value);
 	  
-	    stringstream ss(line);
-	    vector<double> value; while (ss>>Value) value.emplace_back(Value);
-	    checkDim(value, col1, "value", false); checkDim(value, col2, "value", false); 
+	  if ((int)value.size()<colMax) 
+	    error[cc] = "Error in cbl::catalogue::Catalogue::m_read_ascii() in Catalogue.cpp: the line \""+string(ptr, eol)+"\" of "+file[chunk_file[cc]]+" has "+conv(value.size(), par::fINT)+" columns ( < "+conv(colMax, par::fINT)+" )";
 
+	  else {
+	    const double Weight = (colWeight!=-1 && colWeight-1<(int)value.size()) ? value[colWeight-1] : 1.;
+	    const long Region = (colRegion!=-1 && colRegion-1<(int)value.size()) ? (long)value[colRegion-1] : 0;
+	    
 	    if (coordinateType==cbl::CoordinateType::_comoving_) { // comoving coordinates (x, y, z)
-	      checkDim(value, col3, "value", false);
 	      comovingCoordinates coord;
 	      coord.xx = value[col1-1]*fact;
 	      coord.yy = value[col2-1]*fact;
 	      coord.zz = value[col3-1]*fact;
-	      Weight = (colWeight!=-1 && colWeight-1<(int)value.size()) ? value[colWeight-1] : 1.;
-	      Region = (colRegion!=-1 && colRegion-1<(int)value.size()) ? (long)value[colRegion-1] : 0;
-	      m_object.push_back(move(Object::Create(objectType, coord, Weight, Region)));
+	      object[cc].push_back(move(Object::Create(objectType, coord, Weight, Region)));
 	    }
 
-	    else if (coordinateType==cbl::CoordinateType::_observed_) { // observed coordinates (R.A., Dec (redshift))
+	    else { // observed coordinates (R.A., Dec (redshift))
 	      observedCoordinates coord;
 	      coord.ra = value[col1-1]*fact;
 	      coord.dec = value[col2-1]*fact;
 	      coord.redshift = ((int)value.size()>=col3) ? value[col3-1] : 1.;
-	      Weight = (colWeight!=-1 && colWeight-1<(int)value.size()) ? value[colWeight-1] : 1.;
-	      Region = (colRegion!=-1 && colRegion-1<(int)value.size()) ? (long)value[colRegion-1] : 0;
-	      m_object.push_back(move(Object::Create(objectType, coord, inputUnits, cosm, Weight, Region)));
+	      object[cc].push_back(move(Object::Create(objectType, coord, inputUnits, cosm, Weight, Region)));
 	    }
-	  
-	    else ErrorCBL("Error in cbl::catalogue::Catalogue::Catalogue() in Catalogue.cpp: CoordinateType is not valid!");	
 	  }
 	}
       }
       
-      finr.clear(); finr.close();
+      ptr = eol+1;
     }
-          
-    else if (charEncode==CharEncode::_binary_) {
-            
-      // read the input catalogue files
-	
-      coutCBL << "I'm reading the catalogue: " << file_in << endl;
+  }
 
-      short num_bin;
-      float val;
-      
-      ifstream finr(file_in.c_str(), ios::in|ios::binary|ios::ate); checkIO(finr, file_in);	
+  for (size_t dd=0; dd<nFiles; ++dd)
+    if (map[dd]!=nullptr) munmap(const_cast<char*>(map[dd]), size[dd]);
 
-      comovingCoordinates coord;
+  for (long cc=0; cc<nChunks; ++cc)
+    if (!error[cc].empty()) ErrorCBL(error[cc]);
 
-      if (finr.is_open())
-	finr.seekg(0, ios::beg);
-      
-      finr.read((char*)(&num_bin), 2);
-
-      int n_blocks = num_bin;
-      
-      for (int i=1; i<=n_blocks; ++i) {
-        finr.read((char*)(&num_bin), 4);
-        int n_objs = num_bin;
-
-        for (int j=1; j<=n_objs; ++j) {
-          finr.read((char*)(&val), 4);
-          coord.xx = (val)*fact;
-          finr.read((char*)(&val), 4);
-          coord.yy = (val)*fact;
-          finr.read((char*)(&val), 4);
-          coord.zz = (val)*fact;
-	  // Weight = (colWeight!=-1 && colWeight-1<value.size()) ? value[colWeight-1] : 1.;
-	  // Region = (colRegion!=-1 && colRegion-1<value.size()) ? (long)value[colRegion-1] : 0;
-          if (ran()<nSub) m_object.push_back(move(Object::Create(objectType, coord)));
-	  // if (ran()<nSub) m_object.push_back(move(Object::Create(objectType, coord, Weight, Region)));
-        }
-	
-        finr.read((char*)(&num_bin), 4);
+  
+  // store the objects, in the order of the input files
 
-	int n_objs2 = num_bin;
-	
-        if (n_objs2!=n_objs) ErrorCBL("Error in cbl::catalogue::Catalogue::Catalogue() in Catalogue.cpp: wrong reading of input binary file");
-      }
-      
-      finr.clear(); finr.close();
-    }
-        
-    else ErrorCBL("Error in cbl::catalogue::Catalogue::Catalogue() in Catalogue.cpp: charEncode is not valid!");
-  }
+  size_t nObj = m_object.size();
+  for (auto &&obj : object) nObj += obj.size();
+  m_object.reserve(nObj);
+  
+  for (auto &&obj : object)
+    m_object.insert(m_object.end(), make_move_iterator(obj.begin()), make_move_iterator(obj.end()));
 }
 
 
@@ -708,6 +986,8 @@ bool cbl::catalogue::Catalogue::isSetVar (Var var_name) const
 void cbl::catalogue::Catalogue::set_region (const std::vector<long> region)
 {
   for (size_t i=0; i<nObjects(); ++i) m_object[i]->set_region(region[i]);
+
+  m_reset_stats();
 }
 
 
@@ -880,6 +1160,7 @@ void cbl::catalogue::Catalogue::set_var (const int index, const Var var_name, co
     ErrorCBL("Error in cbl::catalogue::Catalogue::set_var() in Catalogue.cpp: no such a variable in the list!");
   }
 
+  m_reset_stats();
 }
 
 
@@ -1048,6 +1329,7 @@ void cbl::catalogue::Catalogue::set_var (const Var var_name, const std::vector<d
     ErrorCBL("Error in cbl::catalogue::Catalogue::set_var() in Catalogue.cpp: no such a variable in the list!");
   }
 
+  m_reset_stats();
 }
 
 
@@ -1098,7 +1380,7 @@ void cbl::catalogue::Catalogue::var_distr (const Var var_name, std::vector<doubl
 
 void cbl::catalogue::Catalogue::computeComovingCoordinates (const cosmology::Cosmology &cosm, const CoordinateUnits inputUnits)
 {
-  double red, xx, yy, zz;
+  double xx, yy, zz;
 
   
   // ----- unit conversion -----
@@ -1112,11 +1394,12 @@ void cbl::catalogue::Catalogue::computeComovingCoordinates (const cosmology::Cos
 
   
   // ----- compute comoving coordinates -----
+
+  const vector<double> DC = cosm.D_C(var(Var::_Redshift_));
   
   for (size_t i=0; i<nObjects(); ++i) {
 
-    red = redshift(i);
-    m_object[i]->set_dc(cosm.D_C(red));
+    m_object[i]->set_dc(DC[i]);
     
     cartesian_coord(RA[i], DEC[i], dc(i), xx, yy, zz);
     
@@ -1124,6 +1407,8 @@ void cbl::catalogue::Catalogue::computeComovingCoordinates (const cosmology::Cos
     m_object[i]->set_yy(yy); 
     m_object[i]->set_zz(zz);
   }
+
+  m_reset_stats();
 }
 
 
@@ -1175,7 +1460,8 @@ void cbl::catalogue::Catalogue::computePolarCoordinates (const CoordinateUnits o
 
     else ErrorCBL("Error in cbl::catalogue::Catalogue::computePolarCoordinates() of Catalogue.cpp outputUnits type not allowed!");
   }
-  
+
+  m_reset_stats();
 }
 
 // ============================================================================
@@ -1221,7 +1507,8 @@ void cbl::catalogue::Catalogue::computePolarCoordinates (const cosmology::Cosmol
 
     else ErrorCBL("Error in cbl::catalogue::Catalogue::computePolarCoordinates() of Catalogue.cpp: outputUnits type not allowed!");
   }
-  
+
+  m_reset_stats();
 }
 
 // ============================================================================
@@ -1234,6 +1521,8 @@ void cbl::catalogue::Catalogue::normalizeComovingCoordinates ()
     m_object[i]->set_yy(yy(i)/dc(i)); 
     m_object[i]->set_zz(zz(i)/dc(i));
   }
+
+  m_reset_stats();
 }
 
 
@@ -1247,6 +1536,8 @@ void cbl::catalogue::Catalogue::restoreComovingCoordinates ()
     m_object[i]->set_yy(yy(i)*dc(i)); 
     m_object[i]->set_zz(zz(i)*dc(i));
   }
+
+  m_reset_stats();
 }
 
 
@@ -1269,6 +1560,8 @@ void cbl::catalogue::Catalogue::Order (const std::vector<int> vv)
   }
 
   m_object = obj;
+
+  m_reset_stats();
 }
 
 
@@ -1288,6 +1581,8 @@ void cbl::catalogue::Catalogue::Order ()
   
   for (size_t i=0; i<nObj; i++) 
     m_object[i] = obj[m_index[i]];
+
+  m_reset_stats();
 }
 
 
@@ -1296,10 +1591,119 @@ void cbl::catalogue::Catalogue::Order ()
 
 double cbl::catalogue::Catalogue::weightedN () const
 {
-  double nn = 0.;
-  for (size_t i=0; i<m_object.size(); i++)
-    nn += m_object[i]->weight();
-  return nn;
+  return (m_object.size()>0) ? Sum(Var::_Weight_) : 0.;
+}
+
+
+// ============================================================================
+
+
+std::shared_ptr<const cbl::catalogue::Catalogue::VarStats> cbl::catalogue::Catalogue::m_stats (const Var var_name) const
+{
+  shared_ptr<const VarStats> &cached = m_var_stats[static_cast<int>(var_name)];
+  
+  const size_t modifications = objects_modifications.load();
+  
+  shared_ptr<const VarStats> stats = atomic_load(&cached);
+  if (stats!=nullptr && stats->modifications==modifications) return stats;
+
+  if (m_object.size()==0) ErrorCBL("Error in cbl::catalogue::Catalogue::m_stats() in Catalogue.cpp: the catalogue is empty!");
+
+  // if more threads get here at the same time, they compute the same
+  // statistics, so the last one stored is equivalent to the others
+  
+  VarStats vs;
+  vs.min = vs.max = var(0, var_name);
+  vs.sum = 0.;
+  vs.modifications = modifications;
+  
+  for (size_t i=0; i<m_object.size(); ++i) {
+    const double vv = var(i, var_name);
+    vs.min = min(vs.min, vv);
+    vs.max = max(vs.max, vv);
+    vs.sum += vv;
+  }
+
+  stats = make_shared<const VarStats>(vs);
+  atomic_store(&cached, stats);
+  
+  return stats;
+}
+
+
+// ============================================================================
+
+
+std::shared_ptr<const std::vector<long>> cbl::catalogue::Catalogue::m_regions () const
+{
+  const size_t modifications = objects_modifications.load();
+  
+  shared_ptr<const RegionList> regions = atomic_load(&m_region_list);
+  
+  if (regions==nullptr || regions->modifications!=modifications) {
+    regions = make_shared<const RegionList>(RegionList {different_elements(region()), modifications});
+    atomic_store(&m_region_list, regions);
+  }
+  
+  return shared_ptr<const vector<long>>(regions, &regions->list);
+}
+
+
+// ============================================================================
+
+
+void cbl::catalogue::Catalogue::m_update_stats (const size_t first)
+{
+  const size_t modifications = objects_modifications.load();
+  
+  for (size_t k=0; k<m_var_stats.size(); ++k) {
+    if (m_var_stats[k]==nullptr) continue;
+    if (m_var_stats[k]->modifications!=modifications) { m_var_stats[k] = nullptr; continue; }
+
+    const Var var_name = static_cast<Var>(k);
+    VarStats vs = *m_var_stats[k];
+    bool isSet = true;
+    
+    for (size_t i=first; i<m_object.size() && isSet; ++i) {
+      isSet = isSetVar(i, var_name);
+      if (isSet) {
+	const double vv = var(i, var_name);
+	vs.min = min(vs.min, vv);
+	vs.max = max(vs.max, vv);
+	vs.sum += vv;
+      }
+    }
+
+    // if the new objects do not have the variable, the error is raised when the statistics are required
+    m_var_stats[k] = (isSet) ? make_shared<const VarStats>(vs) : nullptr;
+  }
+
+  if (m_region_list!=nullptr && m_region_list->modifications!=modifications)
+    m_region_list = nullptr;
+  
+  if (m_region_list!=nullptr) {
+    vector<long> regions = m_region_list->list;
+    bool isSet = true;
+    
+    for (size_t i=first; i<m_object.size() && isSet; ++i) {
+      isSet = isSetVar(i, Var::_Region_);
+      if (isSet) regions.emplace_back(m_object[i]->region());
+    }
+    
+    m_region_list = (isSet) ? make_shared<const RegionList>(RegionList {different_elements(regions), modifications}) : nullptr;
+  }
+}
+
+
+// ============================================================================
+
+
+void cbl::catalogue::Catalogue::m_reset_stats ()
+{
+  ++objects_modifications;
+  
+  for (auto &&stats : m_var_stats) stats = nullptr;
+  m_region_list = nullptr;
 }
 
 
@@ -1347,9 +1751,34 @@ void cbl::catalogue::Catalogue::write_obs_coordinates (const std::string outputF
 // ============================================================================
 
 
-void cbl::catalogue::Catalogue::write_data (const std::string outputFile, const std::vector<Var> var_name) const 
+void cbl::catalogue::Catalogue::write_data (const std::string outputFile, const std::vector<Var> var_name, const CharEncode charEncode) const 
 {
   coutCBL << "I'm writing the file: " << outputFile << "..." << endl;
+
+  if (charEncode==CharEncode::_columnar_) {
+
+    vector<Var> vv = var_name;
+    
+    if (vv.size()==0) {
+      vv = {Var::_X_, Var::_Y_, Var::_Z_};
+      if (isSetVar(Var::_RA_) && isSetVar(Var::_Dec_) && isSetVar(Var::_Redshift_))
+	vv.insert(vv.end(), {Var::_RA_, Var::_Dec_, Var::_Redshift_});
+      vv.emplace_back(Var::_Weight_);
+      if (isSetVar(Var::_Region_)) vv.emplace_back(Var::_Region_);
+    }
+
+    vector<vector<double>> data;
+    for (size_t j=0; j<vv.size(); j++)
+      data.push_back(var(vv[j]));
+
+    ColumnarFile::write(outputFile, vv, data);
+    
+    coutCBL << "I wrote the file: " << outputFile << endl;
+    return;
+  }
+
+  else if (charEncode!=CharEncode::_ascii_)
+    ErrorCBL("Error in cbl::catalogue::Catalogue::write_data() in Catalogue.cpp: charEncode is not valid!");
   
   ofstream fout(outputFile.c_str()); checkIO(fout, outputFile);
 
@@ -1390,21 +1819,7 @@ void cbl::catalogue::Catalogue::write_data (const std::string outputFile, const
 
 Catalogue cbl::catalogue::Catalogue::sub_catalogue (const Var var_name, const double down, const double up, const bool excl) const
 {
-  vector<shared_ptr<Object>> objects;
-  vector<double> vvar = var(var_name);
-  vector<int> w(vvar.size());
-
-  for (size_t i=0; i<m_object.size(); i++) {
-    w[i] = (excl) ? 1 : 0;
-    if (vvar[i] >= down && vvar[i] < up)
-      w[i] = (excl) ? 0 : 1;
-  }
-  
-  for (size_t i=0; i<m_object.size(); i++)
-    if (w[i]==1)
-      objects.push_back(m_object[i]);
- 
-  return Catalogue{objects};
+  return CatalogueView(*this).sub_catalogue(var_name, down, up, excl).catalogue();
 }
 
 
@@ -1413,45 +1828,13 @@ Catalogue cbl::catalogue::Catalogue::sub_catalogue (const Var var_name, const do
 
 Catalogue cbl::catalogue::Catalogue::mangle_cut (const std::string mangle_mask, const bool excl) const
 {
+  const vector<long> polygon = MangleMask({mangle_mask}).polygon(var(Var::_RA_), var(Var::_Dec_));
 
   vector<shared_ptr<Object>> objects;
-
-  string mangle_dir = par::DirCosmo+"/External/mangle/";
-
-  string mangle_working_dir = mangle_dir+"output/";
-  string mkdir = "mkdir -p "+mangle_working_dir;
-  if (system(mkdir.c_str())) {}
-
-  string input = mangle_working_dir+"temporary.dat";
-  string output = mangle_working_dir+"temporary_output.dat";
-
-  write_obs_coordinates(input);
-
-  string polyid = mangle_dir+"/bin/polyid -ur "+mangle_mask+" "+input+" "+output;
-  if (system(polyid.c_str())) {}
-
-  ifstream fin(output);
-  string line;
-
-  int nn=0;
-  getline(fin, line);
-
-  while(getline(fin, line))
-  {
-    stringstream ss(line);
-    vector<double> num; double NN = par::defaultDouble;
-    while (ss>>NN) num.push_back(NN);
-    
-    if( !excl && num.size()>2)
-      objects.push_back(m_object[nn]);
-    if( excl && num.size()<3)
-      objects.push_back(m_object[nn]);
-    nn++;
-  }
-  fin.clear(); fin.close();
   
-  string rm = "rm "+input+" "+output;
-  if (system(rm.c_str())) {}
+  for (size_t i=0; i<m_object.size(); ++i)
+    if ((polygon[i]>=0) != excl)
+      objects.push_back(m_object[i]);
 
   return Catalogue{objects};
 }
@@ -1461,25 +1844,7 @@ Catalogue cbl::catalogue::Catalogue::mangle_cut (const std::string mangle_mask,
 
 Catalogue cbl::catalogue::Catalogue::diluted_catalogue (const double nSub, const int seed) const
 {
-  if (nSub<=0 || nSub>1 || !isfinite(nSub)) ErrorCBL("Error in cbl::catalogue::Catalogue::diluted_catalogue() in Catalogue.cpp: nSub must be in the range (0,1] !");
-  
-  // copy the catalogue into a new one 
-  auto diluted_catalogue = *this;
-  
-  // set the index vector that will be used to remove the objects
-  vector<bool> index(nObjects(), false);
-
-  // nObjects()*(1-nSub) will be removed
-  for (size_t i=0; i<nObjects()*(1-nSub); ++i) index[i] = true;
-  
-  // shuffle the indexes of the objects that will be removed
-  default_random_engine engine(seed);
-  shuffle(begin(index), end(index), engine);
-  
-  // dilute the new catalogue
-  diluted_catalogue.remove_objects(index);
-  
-  return diluted_catalogue;
+  return CatalogueView(*this).diluted(nSub, seed).catalogue();
 }
 
   
@@ -1539,7 +1904,7 @@ shared_ptr<Catalogue> cbl::catalogue::Catalogue::smooth (const double gridsize,
     int j1 = min(int((cat->yy(i)-Min(Var::_Y_))/Cell_Y), ny-1);
     int z1 = min(int((cat->zz(i)-Min(Var::_Z_))/Cell_Z), nz-1);
     int index = z1+nz*(j1+ny*i1);
-    cat->catalogue_object(i)->set_region(index);
+    cat->set_region(i, index);
   }
   
   size_t nRegions = cat->nRegions();
@@ -1653,63 +2018,16 @@ data::ScalarField3D cbl::catalogue::Catalogue::counts_in_cell (const double cell
 
   data::ScalarField3D density(cell_size, _minX, _maxX, _minY, _maxY, _minZ, _maxZ);
 
-  double deltaX = density.deltaX();
-  double deltaY = density.deltaY();
-  double deltaZ = density.deltaZ();
-  int nx = density.nx();
-  int ny = density.ny();
-  int nz = density.nz();
-
-  for (size_t i=0; i<nObjects(); ++i) {
-    int i1 = min(int((xx(i)-density.MinX())/deltaX),nx-1);
-    int j1 = min(int((yy(i)-density.MinY())/deltaY),ny-1);
-    int k1 = min(int((zz(i)-density.MinZ())/deltaZ),nz-1);
-
-    double w = (useMass) ? mass(i)*weight(i) : weight(i);
-
-    if (interpolation_type==0) {
-      density.set_ScalarField(w, i1, j1, k1, 1);
-    }
-    else if (interpolation_type==1) {
-
-      double dx = (xx(i)-density.XX(i1))/deltaX;
-      double dy = (yy(i)-density.YY(j1))/deltaY;
-      double dz = (zz(i)-density.ZZ(k1))/deltaZ;
-
-      int i2 = (dx<0) ? i1-1 : i1+1;
-      int j2 = (dy<0) ? j1-1 : j1+1;
-      int k2 = (dz<0) ? k1-1 : k1+1;
-
-      dx = fabs(dx);
-      dy = fabs(dy);
-      dz = fabs(dz);
-
-      double tx = 1-dx;
-      double ty = 1-dy;
-      double tz = 1-dz;
-
-      double ww = 0.;
-      ww += w*tx*ty*tz;
-      ww += w*dx*ty*tz;
-      ww += w*tx*dy*tz;
-      ww += w*tx*ty*dz;
-      ww += w*dx*dy*tz;
-      ww += w*dx*ty*dz;
-      ww += w*tx*dy*dz;
-      ww += w*dx*dy*dz;
-
-      density.set_ScalarField(w*tx*ty*tz, i1, j1, k1, 1);
-      density.set_ScalarField(w*dx*ty*tz, i2, j1, k1, 1);
-      density.set_ScalarField(w*tx*dy*tz, i1, j2, k1, 1);
-      density.set_ScalarField(w*tx*ty*dz, i1, j1, k2, 1);
-      density.set_ScalarField(w*dx*dy*tz, i2, j2, k1, 1);
-      density.set_ScalarField(w*dx*ty*dz, i2, j1, k2, 1);
-      density.set_ScalarField(w*tx*dy*dz, i1, j2, k2, 1);
-      density.set_ScalarField(w*dx*dy*dz, i2, j2, k2, 1);
-
-    }
+  vector<double> ww = var(Var::_Weight_);
+  
+  if (useMass) {
+    const vector<double> mm = var(Var::_Mass_);
+    for (size_t i=0; i<nObjects(); ++i)
+      ww[i] *= mm[i];
   }
 
+  density.assign_mass(var(Var::_X_), var(Var::_Y_), var(Var::_Z_), ww, interpolation_type);
+
   return density;
 }
 
@@ -1880,6 +2198,8 @@ void cbl::catalogue::Catalogue::remove_objects (const std::vector<bool> index)
     if (!index[ii]) object_temp.emplace_back(m_object[ii]);
   
   m_object.swap(object_temp);
+
+  m_reset_stats();
 }
 
 
@@ -1935,9 +2255,9 @@ void cbl::catalogue::Catalogue::sort (const Var var_name, const bool increasing)
 void cbl::catalogue::Catalogue::compute_catalogueProperties (const double boxside)
 {
   m_volume = (boxside > 0.) ? pow(boxside, 3.) :
-    (cbl::Max(var(Var::_X_)) - cbl::Min(var(Var::_X_)))*
-    (cbl::Max(var(Var::_Y_)) - cbl::Min(var(Var::_Y_)))*
-    (cbl::Max(var(Var::_Z_)) - cbl::Min(var(Var::_Z_)));
+    (Max(Var::_X_) - Min(Var::_X_))*
+    (Max(Var::_Y_) - Min(Var::_Y_))*
+    (Max(Var::_Z_) - Min(Var::_Z_));
   coutCBL << "Sample volume = " << m_volume << " (Mpc/h)^3" << endl;
   
   m_numdensity = m_object.size()/m_volume;
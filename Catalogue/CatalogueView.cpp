@@ -0,0 +1,180 @@
+/********************************************************************
+ *  Copyright (C) 2010 by Federico Marulli and Alfonso Veropalumbo  *
+ *  federico.marulli3@unibo.it                                      *
+ *                                                                  *
+ *  This program is free software; you can redistribute it and/or   *
+ *  modify it under the terms of the GNU General Public License as  *
+ *  published by the Free Software Foundation; either version 2 of  *
+ *  the License, or (at your option) any later version.             *
+ *                                                                  *
+ *  This program is distributed in the hope that it will be useful, *
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of  *
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the   *
+ *  GNU General Public License for more details.                    *
+ *                                                                  *
+ *  You should have received a copy of the GNU General Public       *
+ *  License along with this program; if not, write to the Free      *
+ *  Software Foundation, Inc.,                                      *
+ *  59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.       *
+ *******************************************************************/
+
+/**
+ *  @file Catalogue/CatalogueView.cpp
+ *
+ *  @brief Methods of the class CatalogueView
+ *
+ *  This file contains the implementation of the methods of the class
+ *  CatalogueView, used to select subsets of the objects of a
+ *  catalogue without copying them
+ *
+ *  @authors Federico Marulli, Alfonso Veropalumbo
+ *
+ *  @authors federico.marulli3@unbo.it, alfonso.veropalumbo@unibo.it
+ */
+
+#include "CatalogueView.h"
+
+using namespace std;
+
+using namespace cbl;
+using namespace catalogue;
+
+
+// ============================================================================
+
+
+cbl::catalogue::CatalogueView::CatalogueView (const Catalogue &parent)
+  : m_parent(shared_ptr<const Catalogue>(), &parent), m_index(parent.nObjects())
+{
+  // the aliasing constructor provides a pointer that does not own the parent catalogue
+  iota(m_index.begin(), m_index.end(), 0);
+}
+
+
+// ============================================================================
+
+
+cbl::catalogue::CatalogueView::CatalogueView (const std::shared_ptr<const Catalogue> parent)
+  : m_parent(parent), m_index(parent->nObjects())
+{
+  iota(m_index.begin(), m_index.end(), 0);
+}
+
+
+// ============================================================================
+
+
+cbl::catalogue::CatalogueView::CatalogueView (const std::shared_ptr<const Catalogue> parent, const std::vector<size_t> index)
+  : m_parent(parent), m_index(index)
+{
+  for (auto &&ii : m_index)
+    if (ii>=m_parent->nObjects()) ErrorCBL("Error in cbl::catalogue::CatalogueView::CatalogueView() in CatalogueView.cpp: the index "+conv(ii, par::fINT)+" is out of range!");
+}
+
+
+// ============================================================================
+
+
+CatalogueView cbl::catalogue::CatalogueView::m_select (std::function<bool(const size_t)> select) const
+{
+  CatalogueView view = *this;
+  view.m_index.clear();
+
+  for (size_t i=0; i<m_index.size(); ++i)
+    if (select(i)) view.m_index.emplace_back(m_index[i]);
+
+  return view;
+}
+
+
+// ============================================================================
+
+
+std::vector<double> cbl::catalogue::CatalogueView::var (const Var var_name) const
+{
+  vector<double> vv(m_index.size());
+
+  for (size_t i=0; i<m_index.size(); ++i) vv[i] = var(i, var_name);
+
+  return vv;
+}
+
+
+// ============================================================================
+
+
+double cbl::catalogue::CatalogueView::weightedN () const
+{
+  double nn = 0.;
+  for (size_t i=0; i<m_index.size(); ++i)
+    nn += m_parent->weight(m_index[i]);
+  return nn;
+}
+
+
+// ============================================================================
+
+
+CatalogueView cbl::catalogue::CatalogueView::diluted (const double nSub, const int seed) const
+{
+  if (nSub<=0 || nSub>1 || !isfinite(nSub)) ErrorCBL("Error in cbl::catalogue::CatalogueView::diluted() in CatalogueView.cpp: nSub must be in the range (0,1] !");
+
+  // nObjects()*(1-nSub) will be removed
+  vector<bool> remove(nObjects(), false);
+  for (size_t i=0; i<nObjects()*(1-nSub); ++i) remove[i] = true;
+
+  // shuffle the indexes of the objects that will be removed
+  default_random_engine engine(seed);
+  shuffle(begin(remove), end(remove), engine);
+
+  return m_select([&] (const size_t i) { return !remove[i]; });
+}
+
+
+// ============================================================================
+
+
+CatalogueView cbl::catalogue::CatalogueView::sub_catalogue (const Var var_name, const double down, const double up, const bool excl) const
+{
+  return m_select([&] (const size_t i)
+		  {
+		    const double vv = var(i, var_name);
+		    return (vv>=down && vv<up) != excl;
+		  });
+}
+
+
+// ============================================================================
+
+
+CatalogueView cbl::catalogue::CatalogueView::select_regions (const std::vector<long> region_list) const
+{
+  vector<long> regions = different_elements(region_list);
+
+  return m_select([&] (const size_t i) { return binary_search(regions.begin(), regions.end(), m_parent->region(m_index[i])); });
+}
+
+
+// ============================================================================
+
+
+CatalogueView cbl::catalogue::CatalogueView::exclude_regions (const std::vector<long> region_list) const
+{
+  vector<long> regions = different_elements(region_list);
+
+  return m_select([&] (const size_t i) { return !binary_search(regions.begin(), regions.end(), m_parent->region(m_index[i])); });
+}
+
+
+// ============================================================================
+
+
+Catalogue cbl::catalogue::CatalogueView::catalogue () const
+{
+  vector<shared_ptr<Object>> objects(m_index.size());
+
+  for (size_t i=0; i<m_index.size(); ++i)
+    objects[i] = m_parent->catalogue_object(m_index[i]);
+
+  return Catalogue{move(objects)};
+}
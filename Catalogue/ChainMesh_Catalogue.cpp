@@ -61,6 +61,8 @@ void cbl::chainmesh::ChainMesh_Catalogue::set_par (const double cell_size, std::
   data = { m_catalogue->var(Var::_X_), m_catalogue->var(Var::_Y_), m_catalogue->var(Var::_Z_) }; 
 
   create_chain_mesh(data, rmax);
+
+  m_cellObjects = cell_objects(m_catalogue);
 }
 
 
@@ -113,3 +115,144 @@ vector<std::shared_ptr<Object> > cbl::chainmesh::ChainMesh_Catalogue::object_lis
   return obj_list;
 }
 
+
+
+// ============================================================================
+
+
+cbl::chainmesh::CellObjects cbl::chainmesh::ChainMesh_Catalogue::cell_objects (std::shared_ptr<Catalogue> cat, const std::vector<Var> required) const
+{
+  const long nObj = cat->nObjects();
+  
+  // get the cell of each object, assigning the objects outside the chain-mesh to the closest border cell
+  
+  vector<long> cell(nObj);
+  vector<long> indx(m_nDim);
+  
+  for (long i=0; i<nObj; ++i) {
+    const vector<double> center = {cat->xx(i), cat->yy(i), cat->zz(i)};
+    for (long j=0; j<m_nDim; j++)
+      indx[j] = min(max(long((center[j]-m_Lim[j][0])/m_cell_size), (long)0), m_nCell[j]-1);
+    cell[i] = inds_to_index(indx);
+  }
+
+  
+  // count the objects of each cell and set the index of the first object of each cell
+  
+  CellObjects objects;
+  objects.first.resize(m_nCell_tot+1, 0);
+
+  for (long i=0; i<nObj; ++i) 
+    objects.first[cell[i]+1] ++;
+  
+  for (long k=0; k<m_nCell_tot; ++k) {
+    if (objects.first[k+1]>0) objects.nonEmpty_cells.push_back(k);
+    objects.first[k+1] += objects.first[k];
+  }
+
+  
+  // order the objects by cell and, inside each cell, by region (preserving the order of the
+  // objects of the same region), so that the objects of each region of a cell are contiguous
+
+  vector<long> index(nObj);
+  vector<long> position(objects.first.begin(), objects.first.end()-1);
+  
+  for (long i=0; i<nObj; ++i) 
+    index[position[cell[i]]++] = i;
+
+  vector<long> region(nObj, par::defaultLong);
+  for (long i=0; i<nObj; ++i)
+    if (cat->catalogue_object(i)->isSet_region()) region[i] = cat->region(i);
+  
+  for (auto &&k : objects.nonEmpty_cells)
+    stable_sort(index.begin()+objects.first[k], index.begin()+objects.first[k+1], [&region] (const long i, const long j) { return region[i]<region[j]; });
+
+  
+  // store the object properties ordered by cell
+  
+  objects.resize(nObj);
+
+  for (long k=0; k<nObj; ++k) 
+    objects.set_object(k, cat->catalogue_object(index[k]));
+
+  objects.set_box();
+  objects.set_variables();
+  objects.check_variables(required);
+
+  return objects;
+}
+
+
+// ============================================================================
+
+
+void cbl::chainmesh::CellObjects::resize (const long nObj)
+{
+  xx.resize(nObj); yy.resize(nObj); zz.resize(nObj);
+  ra.resize(nObj); dec.resize(nObj); dc.resize(nObj);
+  redshift.resize(nObj); weight.resize(nObj); region.resize(nObj);
+}
+
+
+// ============================================================================
+
+
+void cbl::chainmesh::CellObjects::set_object (const long k, const std::shared_ptr<Object> object)
+{
+  xx[k] = object->xx();
+  yy[k] = object->yy();
+  zz[k] = object->zz();
+  ra[k] = (object->isSet_ra()) ? object->ra() : par::defaultDouble;
+  dec[k] = (object->isSet_dec()) ? object->dec() : par::defaultDouble;
+  dc[k] = (object->isSet_dc()) ? object->dc() : par::defaultDouble;
+  redshift[k] = (object->isSet_redshift()) ? object->redshift() : par::defaultDouble;
+  weight[k] = object->weight();
+  region[k] = (object->isSet_region()) ? object->region() : par::defaultLong;
+}
+
+
+// ============================================================================
+
+
+void cbl::chainmesh::CellObjects::set_variables ()
+{
+  variables.erase(variables.begin(), variables.end());
+
+  const vector<Var> var = {Var::_RA_, Var::_Dec_, Var::_Redshift_, Var::_Dc_};
+  const vector<const vector<double> *> values = {&ra, &dec, &redshift, &dc};
+
+  for (size_t k=0; k<var.size(); ++k)
+    if (std::all_of(values[k]->begin(), values[k]->end(), [] (const double val) { return cbl::isSet(val); }))
+      variables.push_back(var[k]);
+}
+
+
+// ============================================================================
+
+
+void cbl::chainmesh::CellObjects::check_variables (const std::vector<Var> required) const
+{
+  for (size_t k=0; k<required.size(); ++k)
+    if (std::find(variables.begin(), variables.end(), required[k])==variables.end())
+      ErrorCBL("Error in cbl::chainmesh::CellObjects::check_variables() of ChainMesh_Catalogue.cpp: the variable "+VarNames()[int(required[k])]+" is needed to count the pairs, but it is not set for all the objects!");
+}
+
+
+// ============================================================================
+
+
+void cbl::chainmesh::CellObjects::set_box ()
+{
+  box.resize(6*nonEmpty_cells.size());
+
+  const vector<const vector<double> *> coord = {&xx, &yy, &zz};
+  
+  for (size_t n=0; n<nonEmpty_cells.size(); ++n) {
+    const long k = nonEmpty_cells[n];
+    for (int dim=0; dim<3; ++dim) {
+      const auto lim = minmax_element(coord[dim]->begin()+first[k], coord[dim]->begin()+first[k+1]);
+      box[6*n+2*dim] = *lim.first;
+      box[6*n+2*dim+1] = *lim.second;
+    }
+  }
+}
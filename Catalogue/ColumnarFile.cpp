@@ -0,0 +1,220 @@
+/********************************************************************
+ *  Copyright (C) 2010 by Federico Marulli and Alfonso Veropalumbo  *
+ *  federico.marulli3@unibo.it                                      *
+ *                                                                  *
+ *  This program is free software; you can redistribute it and/or   *
+ *  modify it under the terms of the GNU General Public License as  *
+ *  published by the Free Software Foundation; either version 2 of  *
+ *  the License, or (at your option) any later version.             *
+ *                                                                  *
+ *  This program is distributed in the hope that it will be useful, *
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of  *
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the   *
+ *  GNU General Public License for more details.                    *
+ *                                                                  *
+ *  You should have received a copy of the GNU General Public       *
+ *  License along with this program; if not, write to the Free      *
+ *  Software Foundation, Inc.,                                      *
+ *  59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.       *
+ *******************************************************************/
+
+/**
+ *  @file Catalogue/ColumnarFile.cpp
+ *
+ *  @brief Methods of the class ColumnarFile
+ *
+ *  This file contains the implementation of the methods of the class
+ *  ColumnarFile, used to write and read catalogues in the native
+ *  columnar binary format
+ *
+ *  @authors Federico Marulli, Alfonso Veropalumbo
+ *
+ *  @authors federico.marulli3@unbo.it, alfonso.veropalumbo@unibo.it
+ */
+
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+
+#include "ColumnarFile.h"
+
+using namespace std;
+
+using namespace cbl;
+using namespace catalogue;
+
+
+// the header of the file: the format identifier, a value used to check the byte order, the
+// number of columns and the number of objects, followed by the variable and the type of each column
+
+static const char columnar_magic[8] = {'C', 'B', 'L', 'C', 'O', 'L', '1', '\0'};
+
+static const uint32_t columnar_endian = 0x01020304;
+
+
+// ============================================================================
+
+
+cbl::catalogue::ColumnarFile::ColumnarFile (const std::string file)
+  : m_file(file)
+{
+  const int fd = open(file.c_str(), O_RDONLY);
+  if (fd<0) ErrorCBL("Error in cbl::catalogue::ColumnarFile::ColumnarFile() in ColumnarFile.cpp: the file "+file+" cannot be opened!");
+
+  struct stat st;
+  if (fstat(fd, &st)!=0) {
+    close(fd);
+    ErrorCBL("Error in cbl::catalogue::ColumnarFile::ColumnarFile() in ColumnarFile.cpp: the size of "+file+" cannot be read!");
+  }
+  m_size = st.st_size;
+
+  const size_t header_size = sizeof(columnar_magic)+2*sizeof(uint32_t)+sizeof(uint64_t);
+
+  if (m_size<header_size) {
+    close(fd);
+    ErrorCBL("Error in cbl::catalogue::ColumnarFile::ColumnarFile() in ColumnarFile.cpp: "+file+" is not a columnar catalogue file!");
+  }
+
+  void *map = mmap(nullptr, m_size, PROT_READ, MAP_PRIVATE, fd, 0);
+  close(fd);
+  if (map==MAP_FAILED) ErrorCBL("Error in cbl::catalogue::ColumnarFile::ColumnarFile() in ColumnarFile.cpp: the file "+file+" cannot be mapped!");
+
+  // from now on, the file is unmapped by the destructor of m_map, also if the checks below fail
+  const size_t size = m_size;
+  m_map = unique_ptr<const char, function<void(const char *)>>(static_cast<const char*>(map), [size] (const char *ptr) { munmap(const_cast<char*>(ptr), size); });
+
+
+  // read the header
+
+  const char *pos = m_map.get();
+
+  if (memcmp(pos, columnar_magic, sizeof(columnar_magic))!=0)
+    ErrorCBL("Error in cbl::catalogue::ColumnarFile::ColumnarFile() in ColumnarFile.cpp: "+file+" is not a columnar catalogue file!");
+  pos += sizeof(columnar_magic);
+
+  uint32_t endian, nColumns;
+  uint64_t nObjects;
+  memcpy(&endian, pos, sizeof(uint32_t)); pos += sizeof(uint32_t);
+  memcpy(&nColumns, pos, sizeof(uint32_t)); pos += sizeof(uint32_t);
+  memcpy(&nObjects, pos, sizeof(uint64_t)); pos += sizeof(uint64_t);
+
+  if (endian!=columnar_endian)
+    ErrorCBL("Error in cbl::catalogue::ColumnarFile::ColumnarFile() in ColumnarFile.cpp: the byte order of "+file+" is different from the one of this machine!");
+
+  m_nObjects = nObjects;
+
+  size_t offset = header_size+nColumns*2*sizeof(int32_t);
+
+  if (m_size!=offset+nColumns*m_nObjects*sizeof(double))
+    ErrorCBL("Error in cbl::catalogue::ColumnarFile::ColumnarFile() in ColumnarFile.cpp: the size of "+file+" is not consistent with its header!");
+
+  m_column_index.fill(-1);
+  
+  for (uint32_t k=0; k<nColumns; ++k) {
+    int32_t var, type;
+    memcpy(&var, pos, sizeof(int32_t)); pos += sizeof(int32_t);
+    memcpy(&type, pos, sizeof(int32_t)); pos += sizeof(int32_t);
+    if (var<0 || var>=(int32_t)m_column_index.size() || (type!=0 && type!=1))
+      ErrorCBL("Error in cbl::catalogue::ColumnarFile::ColumnarFile() in ColumnarFile.cpp: the column "+conv(k, par::fINT)+" of "+file+" is not valid!");
+    m_var.push_back(static_cast<Var>(var));
+    m_type.push_back(type);
+    m_offset.push_back(offset);
+    m_column_index[var] = k;
+    offset += m_nObjects*sizeof(double);
+  }
+
+  // the columns are read sequentially
+  madvise(map, m_size, MADV_SEQUENTIAL);
+}
+
+
+// ============================================================================
+
+
+void cbl::catalogue::ColumnarFile::write (const std::string file, const std::vector<Var> var, const std::vector<std::vector<double>> &column)
+{
+  if (var.size()!=column.size())
+    ErrorCBL("Error in cbl::catalogue::ColumnarFile::write() in ColumnarFile.cpp: the number of variables and columns must be equal!");
+
+  const uint64_t nObjects = (column.size()>0) ? column[0].size() : 0;
+  for (auto &&col : column)
+    if (col.size()!=nObjects) ErrorCBL("Error in cbl::catalogue::ColumnarFile::write() in ColumnarFile.cpp: the columns must have the same size!");
+
+  ofstream fout(file.c_str(), ios::out|ios::binary); checkIO(fout, file);
+
+
+  // write the header
+
+  const uint32_t nColumns = var.size();
+  fout.write(columnar_magic, sizeof(columnar_magic));
+  fout.write(reinterpret_cast<const char*>(&columnar_endian), sizeof(uint32_t));
+  fout.write(reinterpret_cast<const char*>(&nColumns), sizeof(uint32_t));
+  fout.write(reinterpret_cast<const char*>(&nObjects), sizeof(uint64_t));
+
+  vector<int32_t> type(nColumns);
+  for (uint32_t k=0; k<nColumns; ++k) {
+    const int32_t vv = static_cast<int32_t>(var[k]);
+    type[k] = (var[k]==Var::_Region_) ? 1 : 0;
+    fout.write(reinterpret_cast<const char*>(&vv), sizeof(int32_t));
+    fout.write(reinterpret_cast<const char*>(&type[k]), sizeof(int32_t));
+  }
+
+
+  // write the columns
+
+  for (uint32_t k=0; k<nColumns; ++k) {
+    if (type[k]==1) {
+      vector<int64_t> col(column[k].begin(), column[k].end());
+      fout.write(reinterpret_cast<const char*>(col.data()), nObjects*sizeof(int64_t));
+    }
+    else fout.write(reinterpret_cast<const char*>(column[k].data()), nObjects*sizeof(double));
+  }
+
+  fout.clear(); fout.close();
+}
+
+
+// ============================================================================
+
+
+double cbl::catalogue::ColumnarFile::value (const Var var, const size_t i) const
+{
+  const int k = m_column(var);
+  if (k<0) ErrorCBL("Error in cbl::catalogue::ColumnarFile::value() in ColumnarFile.cpp: the variable "+VarNames()[static_cast<int>(var)]+" is not stored in "+m_file+"!");
+
+  if (m_type[k]==1) {
+    int64_t val;
+    memcpy(&val, m_map.get()+m_offset[k]+i*sizeof(int64_t), sizeof(int64_t));
+    return val;
+  }
+
+  double val;
+  memcpy(&val, m_map.get()+m_offset[k]+i*sizeof(double), sizeof(double));
+  return val;
+}
+
+
+// ============================================================================
+
+
+const double *cbl::catalogue::ColumnarFile::column (const Var var) const
+{
+  const int k = m_column(var);
+  if (k<0) ErrorCBL("Error in cbl::catalogue::ColumnarFile::column() in ColumnarFile.cpp: the variable "+VarNames()[static_cast<int>(var)]+" is not stored in "+m_file+"!");
+  if (m_type[k]!=0) ErrorCBL("Error in cbl::catalogue::ColumnarFile::column() in ColumnarFile.cpp: the variable "+VarNames()[static_cast<int>(var)]+" is not stored as double!");
+
+  // the header size is a multiple of 8 bytes, so the columns are aligned
+  return reinterpret_cast<const double*>(m_map.get()+m_offset[k]);
+}
+
+
+// ============================================================================
+
+
+std::vector<double> cbl::catalogue::ColumnarFile::column_vector (const Var var) const
+{
+  vector<double> vv(m_nObjects);
+  for (size_t i=0; i<m_nObjects; ++i)
+    vv[i] = value(var, i);
+  return vv;
+}
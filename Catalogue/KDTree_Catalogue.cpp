@@ -0,0 +1,215 @@
+/********************************************************************
+ *  Copyright (C) 2010 by Federico Marulli and Alfonso Veropalumbo  *
+ *  federico.marulli3@unibo.it                                      *
+ *                                                                  *
+ *  This program is free software; you can redistribute it and/or   *
+ *  modify it under the terms of the GNU General Public License as  *
+ *  published by the Free Software Foundation; either version 2 of  *
+ *  the License, or (at your option) any later version.             *
+ *                                                                  *
+ *  This program is distributed in the hope that it will be useful, *
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of  *
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the   *
+ *  GNU General Public License for more details.                    *
+ *                                                                  *
+ *  You should have received a copy of the GNU General Public       *
+ *  License along with this program; if not, write to the Free      *
+ *  Software Foundation, Inc.,                                      *
+ *  59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.       *
+ *******************************************************************/
+
+/**
+ *  @file Catalogue/KDTree_Catalogue.cpp
+ *
+ *  @brief Methods of the class KDTree_Catalogue
+ *
+ *  This file contains the implementation of the methods of the class
+ *  KDTree_Catalogue, to fast search between objects in Catalogues
+ *
+ *  @author Federico Marulli
+ *
+ *  @author federico.marulli3@unbo.it
+ */
+
+#include "KDTree_Catalogue.h"
+
+using namespace std;
+
+using namespace cbl;
+using namespace catalogue;
+using namespace chainmesh;
+
+
+// ============================================================================
+
+
+void cbl::chainmesh::KDTree_Catalogue::set_par (std::shared_ptr<Catalogue> cat, const double rMax, const long leaf_size)
+{
+  if (leaf_size<1)
+    ErrorCBL("Error in set_par() of KDTree_Catalogue.cpp: leaf_size must be larger than 0!");
+
+  m_catalogue = cat;
+  m_rMax = rMax;
+  m_leaf_size = leaf_size;
+
+  m_cellObjects = CellObjects();
+  m_node_box.erase(m_node_box.begin(), m_node_box.end());
+  m_node_child.erase(m_node_child.begin(), m_node_child.end());
+  m_node_leaf.erase(m_node_leaf.begin(), m_node_leaf.end());
+
+  const long nObj = cat->nObjects();
+
+  vector<vector<double>> coord(3, vector<double>(nObj));
+  for (long i=0; i<nObj; ++i) {
+    coord[0][i] = cat->xx(i);
+    coord[1][i] = cat->yy(i);
+    coord[2][i] = cat->zz(i);
+  }
+
+
+  // construct the tree, ordering the object indices by leaf
+
+  m_index.resize(nObj);
+  for (long i=0; i<nObj; ++i) m_index[i] = i;
+
+  m_cellObjects.first.push_back(0);
+
+  if (nObj>0) {
+    m_node_box.resize(6);
+    m_node_child.push_back(-1);
+    m_node_leaf.push_back(-1);
+    m_split(0, 0, nObj, coord);
+  }
+
+
+  const long nLeaves = m_cellObjects.first.size()-1;
+
+  m_cellObjects.nonEmpty_cells.resize(nLeaves);
+  for (long k=0; k<nLeaves; ++k) m_cellObjects.nonEmpty_cells[k] = k;
+
+
+  // order the objects of each leaf by region, as done in the chain-mesh cells, so that the objects
+  // of each region of a leaf are contiguous
+
+  vector<long> region(nObj, par::defaultLong);
+  for (long i=0; i<nObj; ++i)
+    if (cat->catalogue_object(i)->isSet_region()) region[i] = cat->region(i);
+
+  for (long k=0; k<nLeaves; ++k)
+    stable_sort(m_index.begin()+m_cellObjects.first[k], m_index.begin()+m_cellObjects.first[k+1], [&region] (const long i, const long j) { return region[i]<region[j]; });
+
+  
+  // store the object properties ordered by leaf
+
+  m_cellObjects.resize(nObj);
+  for (long k=0; k<nObj; ++k)
+    m_cellObjects.set_object(k, cat->catalogue_object(m_index[k]));
+
+  m_cellObjects.set_box();
+  m_cellObjects.set_variables();
+}
+
+
+// ============================================================================
+
+
+void cbl::chainmesh::KDTree_Catalogue::m_split (const long node, const long begin, const long end, const std::vector<std::vector<double>> &coord)
+{
+  // bounding box of the objects of the node
+
+  for (int dim=0; dim<3; ++dim) {
+    double Min = coord[dim][m_index[begin]], Max = Min;
+    for (long k=begin+1; k<end; ++k) {
+      Min = min(Min, coord[dim][m_index[k]]);
+      Max = max(Max, coord[dim][m_index[k]]);
+    }
+    m_node_box[6*node+2*dim] = Min;
+    m_node_box[6*node+2*dim+1] = Max;
+  }
+
+
+  // the node is a leaf if it contains at most m_leaf_size objects
+
+  if (end-begin<=m_leaf_size) {
+    m_node_leaf[node] = m_cellObjects.first.size()-1;
+    m_cellObjects.first.push_back(end);
+    return;
+  }
+
+
+  // otherwise split the node at the median of the widest dimension
+
+  int dim = 0;
+  for (int k=1; k<3; ++k)
+    if (m_node_box[6*node+2*k+1]-m_node_box[6*node+2*k] > m_node_box[6*node+2*dim+1]-m_node_box[6*node+2*dim]) dim = k;
+
+  const long mid = (begin+end)/2;
+  const vector<double> &cc = coord[dim];
+  nth_element(m_index.begin()+begin, m_index.begin()+mid, m_index.begin()+end, [&cc] (const long i, const long j) { return cc[i]<cc[j]; });
+
+  const long child = m_node_leaf.size();
+  m_node_child[node] = child;
+  m_node_box.resize(m_node_box.size()+12);
+  m_node_child.resize(m_node_child.size()+2, -1);
+  m_node_leaf.resize(m_node_leaf.size()+2, -1);
+
+  // the left child is split first, so that the leaves are numbered following the object order
+  m_split(child, begin, mid, coord);
+  m_split(child+1, mid, end, coord);
+}
+
+
+// ============================================================================
+
+
+std::vector<long> cbl::chainmesh::KDTree_Catalogue::m_close_leaves (const double *box) const
+{
+  vector<long> leaves;
+  if (m_node_leaf.size()==0) return leaves;
+
+  // the bounds are slightly loosened, to be safe against round-off errors
+  const double rMax2 = m_rMax*m_rMax*(1.+1.e-10);
+
+  vector<long> stack = {0};
+
+  while (stack.size()>0) {
+    const long node = stack.back();
+    stack.pop_back();
+
+    // minimum distance between the box and the bounding box of the node
+    double dist2 = 0.;
+    for (int dim=0; dim<3; ++dim) {
+      const double gap = max(0., max(box[2*dim]-m_node_box[6*node+2*dim+1], m_node_box[6*node+2*dim]-box[2*dim+1]));
+      dist2 += gap*gap;
+    }
+
+    if (dist2>rMax2) continue;
+
+    if (m_node_leaf[node]>-1) leaves.push_back(m_node_leaf[node]);
+    else {
+      stack.push_back(m_node_child[node]+1);
+      stack.push_back(m_node_child[node]);
+    }
+  }
+
+  sort(leaves.begin(), leaves.end());
+
+  return leaves;
+}
+
+
+// ============================================================================
+
+
+std::vector<long> cbl::chainmesh::KDTree_Catalogue::close_objects (const std::vector<double> center, const long ii) const
+{
+  const double box[6] = {center[0], center[0], center[1], center[1], center[2], center[2]};
+
+  vector<long> list;
+
+  for (auto &&leaf : m_close_leaves(box))
+    for (long k=m_cellObjects.first[leaf]; k<m_cellObjects.first[leaf+1]; ++k)
+      if (m_index[k]>ii) list.push_back(m_index[k]);
+
+  return list;
+}
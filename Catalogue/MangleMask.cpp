@@ -0,0 +1,369 @@
+/********************************************************************
+ *  Copyright (C) 2010 by Federico Marulli and Alfonso Veropalumbo  *
+ *  federico.marulli3@unibo.it                                      *
+ *                                                                  *
+ *  This program is free software; you can redistribute it and/or   *
+ *  modify it under the terms of the GNU General Public License as  *
+ *  published by the Free Software Foundation; either version 2 of  *
+ *  the License, or (at your option) any later version.             *
+ *                                                                  *
+ *  This program is distributed in the hope that it will be useful, *
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of  *
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the   *
+ *  GNU General Public License for more details.                    *
+ *                                                                  *
+ *  You should have received a copy of the GNU General Public       *
+ *  License along with this program; if not, write to the Free      *
+ *  Software Foundation, Inc.,                                      *
+ *  59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.       *
+ *******************************************************************/
+
+/**
+ *  @file Catalogue/MangleMask.cpp
+ *
+ *  @brief Methods of the class MangleMask
+ *
+ *  This file contains the implementation of the methods of the class
+ *  MangleMask, used to handle angular masks in the mangle polygon
+ *  format
+ *
+ *  @authors Federico Marulli, Alfonso Veropalumbo
+ *
+ *  @authors federico.marulli3@unbo.it, alfonso.veropalumbo@unibo.it
+ */
+
+#include "MangleMask.h"
+#include "RandomNumbers.h"
+
+using namespace std;
+
+using namespace cbl;
+using namespace catalogue;
+
+
+// ============================================================================
+
+
+cbl::catalogue::MangleMask::MangleMask (const std::vector<std::string> file, const int nTheta)
+  : m_nTheta(nTheta), m_nPhi(2*nTheta)
+{
+  if (nTheta<1) ErrorCBL("Error in cbl::catalogue::MangleMask::MangleMask() in MangleMask.cpp: nTheta must be positive!");
+  
+  for (auto &&ff : file) m_read(ff);
+
+  if (m_polygon.size()==0) ErrorCBL("Error in cbl::catalogue::MangleMask::MangleMask() in MangleMask.cpp: no polygons have been read!");
+
+  m_pixelize();
+}
+
+
+// ============================================================================
+
+
+void cbl::catalogue::MangleMask::m_read (const std::string file)
+{
+  ifstream fin(file.c_str()); checkIO(fin, file);
+
+  string line;
+  
+  while (getline(fin, line)) {
+
+    // the lines before the polygons (number of polygons, pixelization scheme, etc.) are skipped
+    
+    stringstream ss(line);
+    string word;
+    if (!(ss >> word) || word!="polygon") continue;
+
+    Polygon pp;
+    pp.weight = 1.;
+    pp.area = -1.;
+
+    if (!(ss >> pp.id)) ErrorCBL("Error in cbl::catalogue::MangleMask::m_read() in MangleMask.cpp: wrong polygon header in "+file+": "+line);
+
+    
+    // the header has the form: polygon id ( nCaps caps, weight weight, pixel pixel, area str):
+    
+    const size_t open = line.find('('), close = line.find(')');
+    if (open==string::npos || close==string::npos) ErrorCBL("Error in cbl::catalogue::MangleMask::m_read() in MangleMask.cpp: wrong polygon header in "+file+": "+line);
+
+    int nCaps = -1;
+    stringstream sh(line.substr(open+1, close-open-1));
+    string field;
+    
+    while (getline(sh, field, ',')) {
+      stringstream sf(field);
+      double value; string name;
+      if (!(sf >> value >> name)) continue;
+      if (name=="caps") nCaps = value;
+      else if (name=="weight") pp.weight = value;
+      else if (name=="str") pp.area = value;
+    }
+
+    if (nCaps<0) ErrorCBL("Error in cbl::catalogue::MangleMask::m_read() in MangleMask.cpp: the number of caps is not provided in "+file+": "+line);
+
+
+    // read the caps, and find the smallest one, used to bound the polygon
+    
+    pp.centre = {0., 0., 1.};
+    pp.cm = 2.;
+    
+    for (int k=0; k<nCaps; ++k) {
+      array<double, 4> cap;
+      if (!getline(fin, line)) ErrorCBL("Error in cbl::catalogue::MangleMask::m_read() in MangleMask.cpp: the caps of the polygon "+conv(pp.id, par::fINT)+" are missing in "+file+"!");
+      stringstream sc(line);
+      if (!(sc >> cap[0] >> cap[1] >> cap[2] >> cap[3])) ErrorCBL("Error in cbl::catalogue::MangleMask::m_read() in MangleMask.cpp: wrong cap in "+file+": "+line);
+      pp.cap.emplace_back(cap);
+
+      if (cap[3]>0. && cap[3]<pp.cm) {
+	pp.centre = {cap[0], cap[1], cap[2]};
+	pp.cm = cap[3];
+      }
+    }
+
+    m_polygon.emplace_back(pp);
+  }
+
+  fin.clear(); fin.close();
+}
+
+
+// ============================================================================
+
+
+void cbl::catalogue::MangleMask::m_pixelize ()
+{
+  vector<vector<int>> pixel_polygon(m_nTheta*m_nPhi);
+
+  const double dPhi = 2.*par::pi/m_nPhi;
+
+  for (size_t p=0; p<m_polygon.size(); ++p) {
+
+    // the polygon is inside the cap with centre (theta_c, phi_c) and radius RR
+    
+    const Polygon &pp = m_polygon[p];
+    const double RR = (pp.cm<2.) ? acos(1.-pp.cm) : par::pi;
+    const double theta_c = acos(max(-1., min(1., pp.centre[2])));
+    double phi_c = atan2(pp.centre[1], pp.centre[0]);
+    if (phi_c<0.) phi_c += 2.*par::pi;
+
+    
+    // the rows that contain the cap, enlarged by one row to account for rounding errors
+    
+    const double z_min = cos(min(par::pi, theta_c+RR)), z_max = cos(max(0., theta_c-RR));
+    const int row_min = max(0, int((z_min+1.)*0.5*m_nTheta)-1);
+    const int row_max = min(m_nTheta-1, int((z_max+1.)*0.5*m_nTheta)+1);
+
+    
+    // the columns that contain the cap: if the cap does not contain a pole, its maximum
+    // difference in azimuth from the centre is asin(sin(RR)/sin(theta_c))
+    
+    int col_min = 0, col_max = m_nPhi-1;
+    
+    if (RR<theta_c && RR<par::pi-theta_c && RR<0.5*par::pi) {
+      const double dphi = asin(min(1., sin(RR)/sin(theta_c)));
+      col_min = int(floor((phi_c-dphi)/dPhi))-1;
+      col_max = int(floor((phi_c+dphi)/dPhi))+1;
+      if (col_max-col_min+1>=m_nPhi) { col_min = 0; col_max = m_nPhi-1; }
+    }
+
+    for (int row=row_min; row<=row_max; ++row)
+      for (int col=col_min; col<=col_max; ++col)
+	pixel_polygon[row*m_nPhi+((col%m_nPhi)+m_nPhi)%m_nPhi].emplace_back(p);
+  }
+
+  
+  // store the polygons of all the pixels in a single vector
+  
+  m_pixel_start.resize(pixel_polygon.size()+1, 0);
+  for (size_t i=0; i<pixel_polygon.size(); ++i)
+    m_pixel_start[i+1] = m_pixel_start[i]+pixel_polygon[i].size();
+
+  m_pixel_polygon.reserve(m_pixel_start.back());
+  for (auto &&pix : pixel_polygon)
+    m_pixel_polygon.insert(m_pixel_polygon.end(), pix.begin(), pix.end());
+}
+
+
+// ============================================================================
+
+
+int cbl::catalogue::MangleMask::m_pixel (const std::array<double, 3> &vv) const
+{
+  const int row = max(0, min(int((vv[2]+1.)*0.5*m_nTheta), m_nTheta-1));
+  
+  double phi = atan2(vv[1], vv[0]);
+  if (phi<0.) phi += 2.*par::pi;
+  const int col = max(0, min(int(phi/(2.*par::pi)*m_nPhi), m_nPhi-1));
+
+  return row*m_nPhi+col;
+}
+
+
+// ============================================================================
+
+
+bool cbl::catalogue::MangleMask::m_inside (const Polygon &pp, const std::array<double, 3> &vv) const
+{
+  for (auto &&cap : pp.cap) {
+    const double cd = 1.-(cap[0]*vv[0]+cap[1]*vv[1]+cap[2]*vv[2]);
+    
+    // a positive cap contains the directions with 1-cos(theta) < cm; a negative one is its complement
+    if ((cap[3]>=0.) ? !(cd<cap[3]) : !(cd>-cap[3])) return false;
+  }
+  
+  return true;
+}
+
+
+// ============================================================================
+
+
+int cbl::catalogue::MangleMask::m_find (const std::array<double, 3> &vv) const
+{
+  const int pix = m_pixel(vv);
+
+  // the polygons are stored in the order of the files, so the first one is returned, as polyid does
+  for (size_t k=m_pixel_start[pix]; k<m_pixel_start[pix+1]; ++k)
+    if (m_inside(m_polygon[m_pixel_polygon[k]], vv)) return m_pixel_polygon[k];
+
+  return -1;
+}
+
+
+// ============================================================================
+
+
+double cbl::catalogue::MangleMask::area () const
+{
+  double area = 0.;
+  for (auto &&pp : m_polygon) area += max(0., pp.area);
+  return area;
+}
+
+
+// ============================================================================
+
+
+long cbl::catalogue::MangleMask::polygon (const double ra, const double dec) const
+{
+  const int index = m_find({cos(dec)*cos(ra), cos(dec)*sin(ra), sin(dec)});
+  return (index<0) ? -1 : m_polygon[index].id;
+}
+
+
+// ============================================================================
+
+
+std::vector<long> cbl::catalogue::MangleMask::polygon (const std::vector<double> &ra, const std::vector<double> &dec) const
+{
+  if (ra.size()!=dec.size()) ErrorCBL("Error in cbl::catalogue::MangleMask::polygon() in MangleMask.cpp: ra and dec must have the same size!");
+  
+  vector<long> id(ra.size());
+
+#pragma omp parallel for schedule(static)
+  for (size_t i=0; i<ra.size(); ++i)
+    id[i] = polygon(ra[i], dec[i]);
+
+  return id;
+}
+
+
+// ============================================================================
+
+
+double cbl::catalogue::MangleMask::weight (const double ra, const double dec) const
+{
+  const int index = m_find({cos(dec)*cos(ra), cos(dec)*sin(ra), sin(dec)});
+  return (index<0) ? 0. : m_polygon[index].weight;
+}
+
+
+// ============================================================================
+
+
+std::vector<double> cbl::catalogue::MangleMask::weight (const std::vector<double> &ra, const std::vector<double> &dec) const
+{
+  if (ra.size()!=dec.size()) ErrorCBL("Error in cbl::catalogue::MangleMask::weight() in MangleMask.cpp: ra and dec must have the same size!");
+  
+  vector<double> ww(ra.size());
+
+#pragma omp parallel for schedule(static)
+  for (size_t i=0; i<ra.size(); ++i)
+    ww[i] = weight(ra[i], dec[i]);
+
+  return ww;
+}
+
+
+// ============================================================================
+
+
+void cbl::catalogue::MangleMask::random_directions (std::vector<double> &ra, std::vector<double> &dec, const size_t nRandom, const int seed) const
+{
+  // the probability of each polygon is proportional to its area times its weight
+  
+  vector<double> cumulative(m_polygon.size());
+  double total = 0.;
+  
+  for (size_t p=0; p<m_polygon.size(); ++p) {
+    if (m_polygon[p].area<0.) ErrorCBL("Error in cbl::catalogue::MangleMask::random_directions() in MangleMask.cpp: the area of the polygon "+conv(m_polygon[p].id, par::fINT)+" is not provided!");
+    total += m_polygon[p].area*max(0., m_polygon[p].weight);
+    cumulative[p] = total;
+  }
+
+  if (total<=0.) ErrorCBL("Error in cbl::catalogue::MangleMask::random_directions() in MangleMask.cpp: the mask has null area!");
+
+  ra.resize(nRandom);
+  dec.resize(nRandom);
+  
+  const size_t block = 65536;
+  const long nBlocks = (nRandom+block-1)/block;
+  const int maxTrials = 1000000;
+  bool failed = false;
+
+#pragma omp parallel for schedule(dynamic)
+  for (long bb=0; bb<nBlocks; ++bb) {
+    
+    random::UniformRandomNumbers ran(0., 1., seed+bb);
+
+    for (size_t i=bb*block; i<min(nRandom, (bb+1)*block); ++i) {
+
+      // extract the polygon
+      
+      const size_t p = min(size_t(upper_bound(cumulative.begin(), cumulative.end(), ran()*total)-cumulative.begin()), m_polygon.size()-1);
+      const Polygon &pp = m_polygon[p];
+
+      
+      // extract directions uniformly in the cap that contains the polygon, until one is inside it
+      
+      const array<double, 3> &cc = pp.centre;
+      array<double, 3> e1 = (fabs(cc[0])<0.9) ? array<double, 3>{0., cc[2], -cc[1]} : array<double, 3>{-cc[2], 0., cc[0]};
+      const double norm = sqrt(e1[0]*e1[0]+e1[1]*e1[1]+e1[2]*e1[2]);
+      for (auto &&ee : e1) ee /= norm;
+      const array<double, 3> e2 = {cc[1]*e1[2]-cc[2]*e1[1], cc[2]*e1[0]-cc[0]*e1[2], cc[0]*e1[1]-cc[1]*e1[0]};
+
+      array<double, 3> vv;
+      bool inside = false;
+      
+      for (int trial=0; trial<maxTrials && !inside; ++trial) {
+	const double cos_theta = 1.-pp.cm*ran();
+	const double sin_theta = sqrt(max(0., 1.-cos_theta*cos_theta));
+	const double phi = 2.*par::pi*ran();
+	for (int k=0; k<3; ++k)
+	  vv[k] = sin_theta*(cos(phi)*e1[k]+sin(phi)*e2[k])+cos_theta*cc[k];
+	inside = m_inside(pp, vv);
+      }
+
+      if (!inside) {
+#pragma omp atomic write
+	failed = true;
+      }
+      
+      ra[i] = atan2(vv[1], vv[0]);
+      if (ra[i]<0.) ra[i] += 2.*par::pi;
+      dec[i] = asin(max(-1., min(1., vv[2])));
+    }
+  }
+
+  if (failed) ErrorCBL("Error in cbl::catalogue::MangleMask::random_directions() in MangleMask.cpp: the random directions cannot be extracted inside some polygons, whose area is likely wrong!");
+}
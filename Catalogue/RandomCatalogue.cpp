@@ -32,6 +32,7 @@
  */
 
 #include "Catalogue.h"
+#include "MangleMask.h"
 
 using namespace std;
 
@@ -288,42 +289,11 @@ cbl::catalogue::Catalogue::Catalogue (const RandomType type, const std::vector<s
 {
   if (type!=RandomType::_createRandom_MANGLE_) ErrorCBL("Error in cbl::catalogue::Catalogue::Catalogue() in RandomCatalogue.cpp: the random catalogue has to be of type _MANGLE_!");
 
-  string mangle_dir = par::DirCosmo+"External/mangle/";
-
-  string mangle_working_dir = mangle_dir+"output/";
-  string mkdir = "mkdir -p "+mangle_working_dir;
-  if (system(mkdir.c_str())) {}
-
-  string mangle_mask_list;
-  for (size_t i=0; i<mangle_mask.size(); i++)
-    mangle_mask_list += mangle_mask[i]+" ";
-
-  string random_output = mangle_working_dir+"temporary_random_output.dat";
-
-
-  // generate the angular random distribution with mangle
-
-  double nrandom = N_R*catalogue.nObjects();
-  string nrandom_str = cbl::conv(nrandom, par::fDP1);
-
-  string ransack = mangle_dir+"/bin/ransack -r"+nrandom_str+" "+mangle_mask_list+" "+random_output;
-  if (system(ransack.c_str())) {}
+  // generate the angular random distribution inside the mask
 
   vector<double> random_ra, random_dec, random_redshift;
   
-  ifstream fin(random_output.c_str()); checkIO(fin, random_output);
-  string line;
-
-  getline(fin, line);
-
-  while (getline(fin, line)) {
-    stringstream ss(line);
-    double ra, dec;
-    ss >> ra; ss >> dec;
-    random_ra.push_back(ra);
-    random_dec.push_back(dec);
-  }
-  fin.clear(); fin.close();
+  MangleMask(mangle_mask).random_directions(random_ra, random_dec, size_t(N_R*catalogue.nObjects()), seed);
 
   
   // generate the redshift distribution from the input catalogue
@@ -337,9 +307,12 @@ cbl::catalogue::Catalogue::Catalogue (const RandomType type, const std::vector<s
   
   random_redshift = vector_from_distribution(random_ra.size(), xx, yy, catalogue.Min(Var::_Redshift_), catalogue.Max(Var::_Redshift_), seed);
 
-  for (size_t i =0; i<random_ra.size(); i++) {
-    observedCoordinates coord = {radians(random_ra[i]), radians(random_dec[i]), random_redshift[i]};
-    m_object.push_back(move(Object::Create(ObjectType::_Random_, coord, cosm)));
+  m_object.resize(random_ra.size());
+  
+#pragma omp parallel for schedule(static)
+  for (size_t i=0; i<random_ra.size(); i++) {
+    observedCoordinates coord = {random_ra[i], random_dec[i], random_redshift[i]};
+    m_object[i] = Object::Create(ObjectType::_Random_, coord, cosm);
   }
   
 }
@@ -418,8 +391,11 @@ cbl::catalogue::Catalogue::Catalogue (const RandomType type, const Catalogue cat
     random_redshift = vector_from_distribution(random_ra.size(), xx, yy, catalogue.Min(Var::_Redshift_), catalogue.Max(Var::_Redshift_), seed);
   }
 
-  for (size_t i =0; i<random_ra.size(); i++) {
-    observedCoordinates coord = {radians(random_ra[i]), radians(random_dec[i]), random_redshift[i]};
-    m_object.push_back(move(Object::Create(ObjectType::_Random_, coord, cosm)));
+  m_object.resize(random_ra.size());
+  
+#pragma omp parallel for schedule(static)
+  for (size_t i=0; i<random_ra.size(); i++) {
+    observedCoordinates coord = {random_ra[i], random_dec[i], random_redshift[i]};
+    m_object[i] = Object::Create(ObjectType::_Random_, coord, cosm);
   }
 }
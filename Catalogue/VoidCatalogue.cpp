@@ -1164,11 +1164,13 @@ void cbl::catalogue::Catalogue::compute_centralDensity (const shared_ptr<Catalog
   for (size_t j=0; j<m_object.size(); j++)
     if (remove[j]) eraser.push_back(j);
   cbl::Erase(m_object, eraser);
+  m_reset_stats();
   ///
   //coutCBL << "check4" << endl;
   ///
   coutCBL << "I removed " << void_voids << " voids in calculating the central density!" << endl;
-  
+
+  m_reset_stats();
 }
 
 /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -1222,8 +1224,10 @@ void cbl::catalogue::Catalogue::compute_densityContrast (const shared_ptr<Catalo
   for (size_t j=0; j<m_object.size(); j++)
     if (remove[j]) eraser.push_back(j);
   cbl::Erase(m_object, eraser);
+  m_reset_stats();
   
   coutCBL << "Cloud-in-void: " << cloud_in_void << endl;
   coutCBL << "I removed " << void_voids+cloud_in_void << " voids in calculating the density contrast!" << endl;
-  
+
+  m_reset_stats();
 }
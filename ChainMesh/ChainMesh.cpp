@@ -131,29 +131,22 @@ void cbl::chainmesh::ChainMesh::index_to_inds (const long index, const vector<lo
 // ============================================================================
 
 
-void cbl::chainmesh::ChainMesh::create_chain_mesh (const vector<vector<double> > data, const double rMAX, const long nMIN, const long nMAX) 
+void cbl::chainmesh::ChainMesh::set_cells (const vector<double> lim_min, const vector<double> lim_max, const double rMAX, const long nMIN, const long nMAX) 
 { 
-  // setting stuff, generalized for n(=nDim) dimensions 
-  
-  long nObj = data[0].size();
-  m_List.erase(m_List.begin(), m_List.end()); m_List.resize(nObj, -1);
-  m_NonEmpty_Cells.erase(m_NonEmpty_Cells.begin(), m_NonEmpty_Cells.end());  
-
   m_nCell_tot = pow(nMAX,3)+1;
-  m_nCell_NonEmpty = 0;
   
   double fact = 1.;
 
-  check_memory(3.0, true, "cbl::chainmesh::ChainMesh::create_chain_mesh of ChainMesh.cpp");
+  check_memory(3.0, true, "cbl::chainmesh::ChainMesh::set_cells of ChainMesh.cpp");
   
   while (m_nCell_tot>pow(nMAX, 3) || m_nCell_tot<nMIN
-	 || !check_memory(3.0, false, "cbl::chainmesh::ChainMesh::create_chain_mesh of ChainMesh.cpp")) {
+	 || !check_memory(3.0, false, "cbl::chainmesh::ChainMesh::set_cells of ChainMesh.cpp")) {
   
     m_nCell_tot = 1;
     m_cell_size *= fact;
     for (int i=0; i<m_nDim; i++) {
-      m_Lim[i][0] = Min(data[i])-1.05*rMAX; 
-      m_Lim[i][1] = Max(data[i])+1.05*rMAX;
+      m_Lim[i][0] = lim_min[i]-1.05*rMAX; 
+      m_Lim[i][1] = lim_max[i]+1.05*rMAX;
       m_Delta[i] = m_Lim[i][1]-m_Lim[i][0];
       m_nCell[i] = nint(m_Delta[i]/m_cell_size);
       m_nCell_tot *= m_nCell[i];
@@ -161,9 +154,31 @@ void cbl::chainmesh::ChainMesh::create_chain_mesh (const vector<vector<double> >
     }
     fact *= 1.1;
 
-    m_Label.erase(m_Label.begin(), m_Label.end()); 
-    
   }
+}
+
+
+// ============================================================================
+
+
+void cbl::chainmesh::ChainMesh::create_chain_mesh (const vector<vector<double> > data, const double rMAX, const long nMIN, const long nMAX) 
+{ 
+  // setting stuff, generalized for n(=nDim) dimensions 
+  
+  long nObj = data[0].size();
+  m_List.erase(m_List.begin(), m_List.end()); m_List.resize(nObj, -1);
+  m_NonEmpty_Cells.erase(m_NonEmpty_Cells.begin(), m_NonEmpty_Cells.end());  
+  m_nCell_NonEmpty = 0;
+
+  vector<double> lim_min(m_nDim), lim_max(m_nDim);
+  for (int i=0; i<m_nDim; i++) {
+    lim_min[i] = Min(data[i]);
+    lim_max[i] = Max(data[i]);
+  }
+  
+  m_Label.erase(m_Label.begin(), m_Label.end()); 
+  
+  set_cells(lim_min, lim_max, rMAX, nMIN, nMAX);
 
   m_Label.resize(m_nCell_tot, -1);
   
@@ -317,6 +332,23 @@ vector<long> cbl::chainmesh::ChainMesh::close_objects (const vector<double> cent
 // ============================================================================
 
 
+vector<long> cbl::chainmesh::ChainMesh::close_cells (const long cell_index) const
+{
+  vector<long> list(m_search_region.size());
+
+  for (size_t i=0; i<m_search_region.size(); i++)
+    list[i] = min(max(m_search_region[i]+cell_index, (long)0), m_nCell_tot-1);
+
+  sort(list.begin(), list.end());
+  list.erase(unique(list.begin(), list.end()), list.end());
+
+  return list;
+}
+
+
+// ============================================================================
+
+
 vector<long> cbl::chainmesh::ChainMesh::get_list (const long cell_index) const
 {
   vector<long> list;
@@ -399,3 +431,63 @@ cbl::chainmesh::ChainMesh3D::ChainMesh3D (const double cell_size, const std::vec
 }
 
 
+// ============================================================================
+
+
+void cbl::chainmesh::ChainMesh::cost (double &nObjectPairs, double &nObjectCells, double &nCellPairs, const long nSample) const
+{
+  nObjectPairs = 0.; nObjectCells = 0.; nCellPairs = 0.;
+
+  // number of objects in each non-empty cell
+  
+  vector<double> nObj(m_nCell_NonEmpty, 0.);
+  
+  for (long n=0; n<m_nCell_NonEmpty; ++n) {
+    long j = m_Label[m_NonEmpty_Cells[n]];
+    while (j>-1) {
+      nObj[n] ++;
+      j = m_List[j];
+    }
+  }
+  
+  // each couple of close cells is considered only once, as when counting the pairs; only
+  // one every step non-empty cells is considered, and the result is rescaled accordingly
+  
+  const long step = max(m_nCell_NonEmpty/max(nSample, (long)1), (long)1);
+  
+  for (long n1=0; n1<m_nCell_NonEmpty; n1+=step) 
+    for (auto &&cell2 : close_cells(m_NonEmpty_Cells[n1])) {
+      if (cell2<m_NonEmpty_Cells[n1]) continue;
+      
+      auto it = lower_bound(m_NonEmpty_Cells.begin(), m_NonEmpty_Cells.end(), cell2);
+      if (it==m_NonEmpty_Cells.end() || *it!=cell2) continue;
+      const double nObj2 = nObj[it-m_NonEmpty_Cells.begin()];
+      
+      nObjectPairs += (cell2==m_NonEmpty_Cells[n1]) ? 0.5*nObj[n1]*(nObj[n1]-1.) : nObj[n1]*nObj2;
+      nObjectCells += nObj[n1];
+      nCellPairs ++;
+    }
+
+  nObjectPairs *= step; nObjectCells *= step; nCellPairs *= step;
+}
+
+
+// ============================================================================
+
+
+std::vector<double> cbl::chainmesh::chainMesh_cost (const std::vector<std::vector<double>> data, const double rMAX, const std::vector<double> cell_size, const double objectCell_cost, const double cellPair_cost, const double cell_cost)
+{
+  vector<double> cost(cell_size.size());
+
+  for (size_t i=0; i<cell_size.size(); ++i) {
+    ChainMesh chainMesh(cell_size[i], data.size());
+    chainMesh.create_chain_mesh(data, rMAX);
+
+    double nObjectPairs, nObjectCells, nCellPairs;
+    chainMesh.cost(nObjectPairs, nObjectCells, nCellPairs);
+    
+    cost[i] = nObjectPairs+objectCell_cost*nObjectCells+cellPair_cost*nCellPairs+cell_cost*chainMesh.nCell();
+  }
+
+  return cost;
+}
@@ -702,18 +702,81 @@ double cbl::cosmology::Cosmology::sigma8 (const double redshift) const
 // =====================================================================================
 
 
-double cbl::cosmology::Cosmology::D_C (const double redshift) const 
+/// @cond glob
+constexpr double cbl::cosmology::DistanceTable::z_limit;
+constexpr int cbl::cosmology::DistanceTable::nCalls_min;
+constexpr double cbl::cosmology::DistanceTable::prec;
+/// @endcond
+
+
+// =====================================================================================
+
+
+/**
+ *  @brief cubic Hermite interpolation of a function tabulated on a
+ *  uniform grid starting from 0
+ *  @param ff the tabulated function
+ *  @param df the tabulated derivative of the function
+ *  @param delta the step of the grid
+ *  @param xx the point where the function is interpolated
+ *  @return the interpolated function
+ */
+static double hermite_interpolation (const std::vector<double> &ff, const std::vector<double> &df, const double delta, const double xx)
 {
-  if (redshift<0) ErrorCBL("Error in cbl::cosmology::Cosmology::D_C of Cosmology.cpp: redshift have to be >=0!");
+  const size_t i = min((size_t)(xx/delta), ff.size()-2);
+  const double tt = xx/delta-i, tt2 = tt*tt, tt3 = tt2*tt;
   
-  double Dc;
+  return (2.*tt3-3.*tt2+1.)*ff[i]+(tt3-2.*tt2+tt)*delta*df[i]+(3.*tt2-2.*tt3)*ff[i+1]+(tt3-tt2)*delta*df[i+1];
+}
 
-  if (m_model=="LCDM") {
-    function<double(double)> integrand = bind(&Cosmology::EE_inv, this, std::placeholders::_1);
-    Dc = wrapper::gsl::GSL_integrate_qag(integrand,0, redshift); 
+
+// =====================================================================================
+
+
+/**
+ *  @brief inverse of the cubic Hermite interpolation of a monotonic
+ *  increasing function tabulated on a uniform grid starting from 0
+ *  @param ff the tabulated function
+ *  @param df the tabulated derivative of the function
+ *  @param delta the step of the grid
+ *  @param yy the value of the function
+ *  @return the point where the interpolated function is equal to yy
+ */
+static double hermite_inversion (const std::vector<double> &ff, const std::vector<double> &df, const double delta, const double yy)
+{
+  const size_t index = upper_bound(ff.begin(), ff.end(), yy)-ff.begin();
+  const size_t i = (index==0) ? 0 : min(index-1, ff.size()-2);
+
+  // Newton-Raphson iterations, starting from the linear interpolation
+  
+  double tt = (yy-ff[i])/(ff[i+1]-ff[i]);
+
+  for (int iter=0; iter<20; ++iter) {
+    const double tt2 = tt*tt, tt3 = tt2*tt;
+    const double pp = (2.*tt3-3.*tt2+1.)*ff[i]+(tt3-2.*tt2+tt)*delta*df[i]+(3.*tt2-2.*tt3)*ff[i+1]+(tt3-tt2)*delta*df[i+1]-yy;
+    const double dp = 6.*(tt2-tt)*(ff[i]-ff[i+1])+(3.*tt2-4.*tt+1.)*delta*df[i]+(3.*tt2-2.*tt)*delta*df[i+1];
+    const double dt = pp/dp;
+    tt -= dt;
+    if (fabs(dt)<1.e-15) break;
   }
+
+  return (i+tt)*delta;
+}
+
+
+// =====================================================================================
+
+
+cbl::cosmology::DistanceTable cbl::cosmology::Cosmology::m_compute_distance_table (const double z_max) const
+{
+  DistanceTable table;
+  table.parameter = {m_Omega_matter, m_Omega_DE, m_Omega_k, m_Omega_radiation, m_w0, m_wa};
+  table.model = m_model;
+
   
-  else {
+  // the tabulated comoving distance of the non-LCDM models, read only once
+
+  if (m_model!="LCDM") {
     string dir = par::DirCosmo+"Cosmology/Tables/dc_cDE/";
     string file_in;
     if (m_model=="LCDM_Baldi_wmap7") file_in = dir+"LCDM-wmap7-comovingdist.dat"; 
@@ -726,27 +789,191 @@ double cbl::cosmology::Cosmology::D_C (const double redshift) const
     else if (m_model=="EXP008e3_Baldi_CoDECS") file_in = dir+"EXP008e3_CoDECS-comovingdist.dat";
     else if (m_model=="EXP010e2_Baldi_CoDECS") file_in = dir+"EXP010e2_CoDECS-comovingdist.dat";
     else if (m_model=="SUGRA003_Baldi_CoDECS") file_in = dir+"SUGRA003_CoDECS-comovingdist.dat";
-    else { string Err = "Error in cbl::cosmology::Cosmology::D_C of Cosmology.cpp: model = " + m_model + "!"; ErrorCBL(Err); }
+    else { string Err = "Error in cbl::cosmology::Cosmology::m_compute_distance_table of Cosmology.cpp: model = " + m_model + "!"; ErrorCBL(Err); }
                      
     ifstream fin(file_in.c_str()); checkIO(fin, file_in); 
     
     double Red, DC;
-    vector<double> Redshift, dc;
     while (fin >>Red>>DC) {
-      Redshift.push_back(Red);
-      dc.push_back(DC);
+      table.file_redshift.push_back(Red);
+      table.file_dc.push_back(DC);
     }
     fin.clear(); fin.close();
 
-    double err = -1.;
-    Dc = interpolated(redshift, Redshift, dc, "Rat");
+    // the Hermite tables are not used by the non-LCDM models
+    table.z_max = std::numeric_limits<double>::infinity();
+    table.delta_x = 0.;
+    
+    return table;
+  }
+
+  
+  // Gauss-Legendre nodes and weights in [-1,1], used to integrate
+  // dD_C/dx=(1+z)/E(z) and dt/dx=1/E(z) in the intervals of the grid
+  
+  const int nGL = 10;
+  vector<double> xGL(nGL), wGL(nGL);
+  gauleg(-1., 1., xGL.data(), wGL.data(), nGL);
+
+  auto integrate = [&] (const double x1, const double x2, double &int_dc, double &int_time) {
+    int_dc = 0.; int_time = 0.;
+    for (int k=0; k<nGL; ++k) {
+      const double xx = 0.5*(x1+x2)+0.5*(x2-x1)*xGL[k];
+      const double EEinv = 1./EE(expm1(xx));
+      int_dc += wGL[k]*exp(xx)*EEinv;
+      int_time += wGL[k]*EEinv;
+    }
+    int_dc *= 0.5*(x2-x1);
+    int_time *= 0.5*(x2-x1);
+  };
+
+  
+  // tabulate the comoving distance and the lookback time, halving
+  // the step until the interpolation error at the centre of each
+  // interval is smaller than prec
+
+  table.z_max = z_max;
+  const double x_max = log1p(z_max);
+  
+  const int nBins_max = 1048576;
+  int nBins = 256;
+  
+  bool accurate = false;
+  
+  while (!accurate) {
+
+    table.delta_x = x_max/nBins;
+    
+    table.dc.resize(nBins+1); table.dc_deriv.resize(nBins+1);
+    table.time.resize(nBins+1); table.time_deriv.resize(nBins+1);
+
+    double int_dc, int_time;
+    
+    for (int i=0; i<=nBins; ++i) {
+      const double xx = i*table.delta_x;
+      const double EEinv = 1./EE(expm1(xx));
+      table.dc_deriv[i] = exp(xx)*EEinv;
+      table.time_deriv[i] = EEinv;
+      if (i==0) table.dc[i] = table.time[i] = 0.;
+      else {
+	integrate(xx-table.delta_x, xx, int_dc, int_time);
+	table.dc[i] = table.dc[i-1]+int_dc;
+	table.time[i] = table.time[i-1]+int_time;
+      }
+    }
+
+    accurate = true;
+    
+    for (int i=0; i<nBins && accurate; ++i) {
+      const double xx = (i+0.5)*table.delta_x;
+      integrate(i*table.delta_x, xx, int_dc, int_time);
+      if (fabs(hermite_interpolation(table.dc, table.dc_deriv, table.delta_x, xx)-table.dc[i]-int_dc)>DistanceTable::prec*(table.dc[i]+int_dc) ||
+	  fabs(hermite_interpolation(table.time, table.time_deriv, table.delta_x, xx)-table.time[i]-int_time)>DistanceTable::prec*(table.time[i]+int_time))
+	accurate = false;
+    }
+
+    if (!accurate) {
+      if (nBins==nBins_max) {
+	WarningMsg("Attention in cbl::cosmology::Cosmology::m_compute_distance_table of Cosmology.cpp: the required accuracy of the distance tables has not been reached!");
+	accurate = true;
+      }
+      else nBins *= 2;
+    }
+  }
+  
+  return table;
+}
+
+
+// =====================================================================================
+
+
+std::shared_ptr<const cbl::cosmology::DistanceTable> cbl::cosmology::Cosmology::m_get_distance_table (const double redshift, const bool batch) const
+{
+  const vector<double> parameter = {m_Omega_matter, m_Omega_DE, m_Omega_k, m_Omega_radiation, m_w0, m_wa};
+
+  auto sameParameters = [&] (const shared_ptr<const DistanceTable> &table)
+    { return table!=nullptr && table->model==m_model && table->parameter==parameter; };
+  
+  shared_ptr<const DistanceTable> table = atomic_load(&m_distance_table);
+
+  if (sameParameters(table) && table->z_max>=redshift) return table;
+
+  // the tables are computed only by one thread at a time
+  
+#pragma omp critical (cosmology_distance_table)
+  {
+    table = atomic_load(&m_distance_table);
+    
+    if (!sameParameters(table) || table->z_max<redshift) {
+
+      // count the distances requested with the same parameters,
+      // integrated directly until the tables are worth computing
+      
+      if (m_distance_key.first==parameter && m_distance_key.second==m_model) m_distance_calls ++;
+      else { m_distance_key = {parameter, m_model}; m_distance_calls = 1; }
+
+      if (m_model!="LCDM" || batch || sameParameters(table) || m_distance_calls>=DistanceTable::nCalls_min) {
+
+	// the range of the tables, in x=ln(1+z), is at least doubled
+	// at each extension
+	
+	double x_max = max(2.*log1p(redshift), log1p(3.));
+	if (sameParameters(table)) x_max = max(x_max, 2.*log1p(table->z_max));
+	
+	table = make_shared<const DistanceTable>(m_compute_distance_table(expm1(min(x_max, log1p(DistanceTable::z_limit)))));
+	atomic_store(&m_distance_table, table);
+      }
+
+      else table = nullptr;
+    }
+  }
+  
+  return table;
+}
+
+
+// =====================================================================================
+
+
+std::shared_ptr<const cbl::cosmology::DistanceTable> cbl::cosmology::Cosmology::m_get_distance_table_dc (const double d_c, const bool batch) const
+{
+  shared_ptr<const DistanceTable> table = m_get_distance_table(0., batch);
+
+  // the tables are extended until they include the given comoving distance
+  
+  while (m_model=="LCDM" && table!=nullptr && d_c>m_D_H*table->dc.back() && table->z_max<DistanceTable::z_limit)
+    table = m_get_distance_table(nextafter(table->z_max, DistanceTable::z_limit), batch);
+  
+  return table;
+}
+
+
+// =====================================================================================
+
+
+double cbl::cosmology::Cosmology::D_C (const double redshift) const 
+{
+  if (redshift<0) ErrorCBL("Error in cbl::cosmology::Cosmology::D_C of Cosmology.cpp: redshift have to be >=0!");
+  
+  double Dc;
+
+  if (m_model=="LCDM") {
+    const shared_ptr<const DistanceTable> table = (redshift<=DistanceTable::z_limit) ? m_get_distance_table(redshift) : nullptr;
     
-    if (err/Dc>0.1) {
-      string Err = "Error in cbl::cosmology::Cosmology::D_C of Cosmology.cpp: " + conv(redshift,par::fDP3) + "   " + conv(Redshift.size(),par::fINT) + "   " + conv(dc.size(),par::fINT);
-      ErrorCBL(Err);
+    if (table!=nullptr) 
+      Dc = hermite_interpolation(table->dc, table->dc_deriv, table->delta_x, log1p(redshift));
+    else {
+      function<double(double)> integrand = bind(&Cosmology::EE_inv, this, std::placeholders::_1);
+      Dc = wrapper::gsl::GSL_integrate_qag(integrand,0, redshift); 
     }
   }
   
+  else {
+    const shared_ptr<const DistanceTable> table = m_get_distance_table(redshift);
+    Dc = interpolated(redshift, table->file_redshift, table->file_dc, "Rat");
+  }
+  
   return m_D_H*Dc;
 }
 
@@ -754,6 +981,30 @@ double cbl::cosmology::Cosmology::D_C (const double redshift) const
 // =====================================================================================
 
 
+std::vector<double> cbl::cosmology::Cosmology::D_C (const std::vector<double> redshift) const 
+{
+  double z_max = 0.;
+  for (auto &&red : redshift) {
+    if (red<0) ErrorCBL("Error in cbl::cosmology::Cosmology::D_C of Cosmology.cpp: redshift have to be >=0!");
+    z_max = max(z_max, red);
+  }
+  
+  // the tables are computed before the parallel loop
+  const shared_ptr<const DistanceTable> table = m_get_distance_table(min(z_max, DistanceTable::z_limit), true);
+
+  vector<double> Dc(redshift.size());
+  
+#pragma omp parallel for schedule(static)
+  for (size_t i=0; i<redshift.size(); ++i)
+    Dc[i] = (m_model=="LCDM" && redshift[i]<=table->z_max) ? m_D_H*hermite_interpolation(table->dc, table->dc_deriv, table->delta_x, log1p(redshift[i])) : D_C(redshift[i]);
+
+  return Dc;
+}
+
+
+// =====================================================================================
+
+
 void cbl::cosmology::Cosmology::D_C_table (const std::string file_table, const double z_min, const double z_max, const int step, std::vector<double> &Redshift, std::vector<double> &dc) const
 {
   string File_table = par::DirCosmo+"Cosmology/Tables/dc/"+file_table;
@@ -891,10 +1142,56 @@ double cbl::cosmology::Cosmology::Distance (const double redshift, const std::st
 // =====================================================================================
 
 
+std::vector<double> cbl::cosmology::Cosmology::Distance (const std::vector<double> redshift, const std::string distance_type) const 
+{
+  if (distance_type=="Dvrs" || distance_type=="rsDv") {
+
+    // the sound horizon is computed only once
+    const double rs = rs_CAMB();
+
+    vector<double> dist = Distance(redshift, "Dv");
+    for (auto &&dd : dist) dd = (distance_type=="Dvrs") ? dd/rs : rs/dd;
+    
+    return dist;
+  }
+
+  if (distance_type!="DC" && distance_type!="DL" && distance_type!="DA" && distance_type!="Dv")
+    ErrorCBL("Error in Distance of Cosmology, Cosmology/Lib/Cosmology.cpp. No such a distance type");
+
+  double z_max = 0.;
+  for (auto &&red : redshift) {
+    if (red<0) ErrorCBL("Error in cbl::cosmology::Cosmology::Distance of Cosmology.cpp: redshift have to be >=0!");
+    z_max = max(z_max, red);
+  }
+  
+  // the tables are computed before the parallel loop
+  m_get_distance_table(min(z_max, DistanceTable::z_limit), true);
+  
+  vector<double> dist(redshift.size());
+
+#pragma omp parallel for schedule(static)
+  for (size_t i=0; i<redshift.size(); ++i)
+    dist[i] = Distance(redshift[i], distance_type);
+
+  return dist;
+}
+
+
+// =====================================================================================
+
+
 double cbl::cosmology::Cosmology::lookback_time (const double redshift) const 
 {
-  function<double(double)> integrand = bind(&Cosmology::EE_inv2, this, std::placeholders::_1);
-  double tt =  wrapper::gsl::GSL_integrate_qag(integrand,0, redshift); 
+  double tt;
+
+  const shared_ptr<const DistanceTable> table = (m_model=="LCDM" && redshift>=0 && redshift<=DistanceTable::z_limit) ? m_get_distance_table(redshift) : nullptr;
+  
+  if (table!=nullptr)
+    tt = hermite_interpolation(table->time, table->time_deriv, table->delta_x, log1p(redshift));
+  else {
+    function<double(double)> integrand = bind(&Cosmology::EE_inv2, this, std::placeholders::_1);
+    tt =  wrapper::gsl::GSL_integrate_qag(integrand,0, redshift); 
+  }
 
   double Mpc = par::mega*par::pc*1.e-3; // in Km;
   double Gyr = par::giga*par::yr; // in sec
@@ -1006,45 +1303,47 @@ double cbl::cosmology::Cosmology::Redshift (const double d_c, const double z1_gu
   }
 
   double redshift = -1.;
-  
+
   if (m_model=="LCDM") {
-    function<double(double)> func = bind(&Cosmology::D_C, this, std::placeholders::_1);
-    redshift =  wrapper::gsl::GSL_root_brent(func, d_c, z1_guess, z2_guess, prec); 
+    const shared_ptr<const DistanceTable> table = m_get_distance_table_dc(d_c, false);
+    
+    if (table!=nullptr && d_c>=0 && d_c<=m_D_H*table->dc.back())
+      redshift = expm1(hermite_inversion(table->dc, table->dc_deriv, table->delta_x, d_c/m_D_H));
+    else {
+      function<double(double)> func = bind(static_cast<double(Cosmology::*)(const double) const>(&Cosmology::D_C), this, std::placeholders::_1);
+      redshift =  wrapper::gsl::GSL_root_brent(func, d_c, z1_guess, z2_guess, prec); 
+    }
   }
   
   else {
     WarningMsg("Attention in cbl::cosmology::Cosmology::Redshift of Cosmology.cpp: the quantity prec is not used");
+    const shared_ptr<const DistanceTable> table = m_get_distance_table(0.);
+    redshift = interpolated(d_c/m_D_H, table->file_dc, table->file_redshift, "Rat");
+  }
+  
+  return redshift;
+}
 
-    string dir = par::DirCosmo+"Cosmology/Tables/dc_cDE/";
-    string file_in;
 
-    if (m_model=="LCDM_Baldi_wmap7") file_in = dir+"LCDM-wmap7-comovingdist.dat"; 
-    else if (m_model=="EXP005_Baldi_wmap7") file_in = dir+"EXP005-wmap7-comovingdist.dat";
-    else if (m_model=="EXP010e2_Baldi_wmap7") file_in = dir+"EXP010e2-wmap7-comovingdist.dat";
-    else if (m_model=="LCDM_Baldi_CoDECS") file_in = dir+"LCDM_CoDECS-comovingdist.dat"; 
-    else if (m_model=="EXP001_Baldi_CoDECS") file_in = dir+"EXP001_CoDECS-comovingdist.dat";
-    else if (m_model=="EXP002_Baldi_CoDECS") file_in = dir+"EXP002_CoDECS-comovingdist.dat";
-    else if (m_model=="EXP003_Baldi_CoDECS") file_in = dir+"EXP003_CoDECS-comovingdist.dat";
-    else if (m_model=="EXP008e3_Baldi_CoDECS") file_in = dir+"EXP003_CoDECS-comovingdist.dat";
-    else if (m_model=="EXP010e2_Baldi_CoDECS") file_in = dir+"EXP010e2_CoDECS-comovingdist.dat";
-    else if (m_model=="SUGRA003_Baldi_CoDECS") file_in = dir+"SUGRA003_CoDECS-comovingdist.dat";
-    else { string Err = "Error in cbl::cosmology::Cosmology::Redshift of Cosmology.cpp: model = " + m_model + "!"; ErrorCBL(Err); }
-    
-    ifstream fin(file_in.c_str()); checkIO(fin, file_in); 
-    
-    double Red, DC;
-    vector<double> Redshift, dc;
-    while (fin >> Red >> DC) {
-      Redshift.push_back(Red);
-      dc.push_back(m_D_H*DC);
-    }
-    fin.clear(); fin.close();
-    
-    double err = -1;
-    redshift = interpolated(d_c, dc, Redshift, "Rat");
-    if (err/redshift>0.1) ErrorCBL("Error in cbl::cosmology::Cosmology::Redshift of Cosmology.cpp!");
-  }
+// =====================================================================================
+
+
+std::vector<double> cbl::cosmology::Cosmology::Redshift (const std::vector<double> d_c) const
+{
+  double dc_max = 0.;
+  for (auto &&dc : d_c) dc_max = max(dc_max, dc);
+  
+  // the tables are computed before the parallel loop
+  const shared_ptr<const DistanceTable> table = m_get_distance_table_dc(dc_max, true);
+
+  if (m_model=="LCDM") dc_max = m_D_H*table->dc.back();
   
+  vector<double> redshift(d_c.size());
+
+#pragma omp parallel for schedule(static)
+  for (size_t i=0; i<d_c.size(); ++i)
+    redshift[i] = (m_model=="LCDM" && d_c[i]>=0 && d_c[i]<=dc_max) ? expm1(hermite_inversion(table->dc, table->dc_deriv, table->delta_x, d_c[i]/m_D_H)) : Redshift(d_c[i]);
+
   return redshift;
 }
 
@@ -1081,7 +1380,7 @@ double cbl::cosmology::Cosmology::Redshift_LCDM (const double d_c, const double
 
   // choice of the method
 
-  function<double(double)> DC = (go_fast) ? bind(&Cosmology::D_C_LCDM, this, std::placeholders::_1) : bind(&Cosmology::D_C, this, std::placeholders::_1);
+  function<double(double)> DC = (go_fast) ? bind(&Cosmology::D_C_LCDM, this, std::placeholders::_1) : bind(static_cast<double(Cosmology::*)(const double) const>(&Cosmology::D_C), this, std::placeholders::_1);
 
   
   // interval check: needs z0<=z and z1>=z
@@ -1172,7 +1471,7 @@ double cbl::cosmology::Cosmology::max_redshift (const double Volume, const doubl
   double Area_steradians = Area*pow(par::pi/180.,2);
   double dcz2 = pow(3*Volume/Area_steradians+pow(D_C(z_min),3),1./3);
 
-  function<double(double)> func = bind(&Cosmology::D_C, this, std::placeholders::_1);
+  function<double(double)> func = bind(static_cast<double(Cosmology::*)(const double) const>(&Cosmology::D_C), this, std::placeholders::_1);
   return wrapper::gsl::GSL_root_brent(func, dcz2, z_min, 10, 1.e-9); 
 }
 
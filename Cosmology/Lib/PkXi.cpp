@@ -247,7 +247,142 @@ void cbl::cosmology::Cosmology::run_CAMB (std::vector<double> &kk, std::vector<d
 // =====================================================================================
 
 
+double cbl::cosmology::PowerSpectrumTable::operator() (const double lgk) const
+{
+  const size_t size = lgkk.size();
+  
+  if (size<2) ErrorCBL("Error in cbl::cosmology::PowerSpectrumTable::operator() of PkXi.cpp: the table is empty!");
+
+  const size_t index = upper_bound(lgkk.begin(), lgkk.end(), lgk)-lgkk.begin();
+  const size_t i = (index==0) ? 0 : min(index-1, size-2);
+  
+  return lgPk[i]+(lgk-lgkk[i])/(lgkk[i+1]-lgkk[i])*(lgPk[i+1]-lgPk[i]);
+}
+
+
+// =====================================================================================
+
+
+std::shared_ptr<const cbl::cosmology::PowerSpectrumTable> cbl::cosmology::PowerSpectrumCache::table (const std::string &key) const
+{
+  shared_ptr<const PowerSpectrumTable> table;
+  
+#pragma omp critical (cosmology_Pk_cache)
+  {
+    auto it = m_table.find(key);
+    if (it!=m_table.end()) table = it->second;
+  }
+
+  return table;
+}
+
+
+// =====================================================================================
+
+
+void cbl::cosmology::PowerSpectrumCache::set_table (const std::string &key, const std::shared_ptr<const PowerSpectrumTable> table)
+{
+#pragma omp critical (cosmology_Pk_cache)
+  {
+    if (m_table.emplace(key, table).second) {
+      m_table_key.emplace_back(key);
+      if (m_table_key.size()>nMax) {
+	m_table.erase(m_table_key.front());
+	m_table_key.pop_front();
+      }
+    }
+  }
+}
+
+
+// =====================================================================================
+
+
+bool cbl::cosmology::PowerSpectrumCache::value (const std::string &key, double &value) const
+{
+  bool found = false;
+  
+#pragma omp critical (cosmology_Pk_cache)
+  {
+    auto it = m_value.find(key);
+    if (it!=m_value.end()) { value = it->second; found = true; }
+  }
+
+  return found;
+}
+
+
+// =====================================================================================
+
+
+void cbl::cosmology::PowerSpectrumCache::set_value (const std::string &key, const double value)
+{
+#pragma omp critical (cosmology_Pk_cache)
+  {
+    if (m_value.emplace(key, value).second) {
+      m_value_key.emplace_back(key);
+      if (m_value_key.size()>nMax) {
+	m_value.erase(m_value_key.front());
+	m_value_key.pop_front();
+      }
+    }
+  }
+}
+
+
+// =====================================================================================
+
+
+std::string cbl::cosmology::Cosmology::m_Pk_key (const std::string name, const std::vector<double> value) const
+{
+  const double parameter[] = {m_Omega_matter, m_Omega_baryon, m_Omega_neutrinos, m_massless_neutrinos, (double)m_massive_neutrinos, m_Omega_DE, m_Omega_radiation, m_Omega_k, m_Omega_CDM, m_hh, m_sigma8, m_scalar_amp, m_scalar_pivot, m_n_spec, m_w0, m_wa, m_tau, (double)m_unit};
+
+  // the parameters are stored with their binary representation, so that the key is exact
+  
+  string key = name+"|"+m_model+"|";
+  key.append(reinterpret_cast<const char*>(parameter), sizeof(parameter));
+  key.append(reinterpret_cast<const char*>(value.data()), value.size()*sizeof(double));
+
+  return key;
+}
+
+
+// =====================================================================================
+
+
+std::shared_ptr<const cbl::cosmology::PowerSpectrumTable> cbl::cosmology::Cosmology::m_Pk_table (const std::string code, const bool NL, const double redshift, const std::string output_root, const double k_max, const std::string file_par) const
+{
+  // the table computed by the Boltzmann codes does not depend on k_max once stored on disk
+  const string key = m_Pk_key("Table_PkCodes|"+code+"|"+file_par, {(double)NL, redshift});
+
+  shared_ptr<const PowerSpectrumTable> table = m_Pk_cache->table(key);
+
+  if (table==nullptr) {
+    PowerSpectrumTable tab;
+    m_read_Pk_table(code, NL, tab.lgkk, tab.lgPk, redshift, output_root, k_max, file_par);
+    table = make_shared<const PowerSpectrumTable>(move(tab));
+    m_Pk_cache->set_table(key, table);
+  }
+
+  return table;
+}
+
+
+// =====================================================================================
+
+
 void cbl::cosmology::Cosmology::Table_PkCodes (const std::string code, const bool NL, std::vector<double> &lgkk, std::vector<double> &lgPk, const double redshift, const std::string output_root, const double k_max, string file_par) const 
+{
+  const shared_ptr<const PowerSpectrumTable> table = m_Pk_table(code, NL, redshift, output_root, k_max, file_par);
+  lgkk = table->lgkk;
+  lgPk = table->lgPk;
+}
+
+
+// =====================================================================================
+
+
+void cbl::cosmology::Cosmology::m_read_Pk_table (const std::string code, const bool NL, std::vector<double> &lgkk, std::vector<double> &lgPk, const double redshift, const std::string output_root, const double k_max, string file_par) const 
 {
   if (code=="MPTbreeze-v1" && m_sigma8<0) 
     ErrorCBL("Error in cbl::cosmology::Cosmology::Table_PkCodes of PkXi.cpp: sigma8 must be >0 if MPTbreeze-v1 is used!"); 
@@ -571,6 +706,19 @@ void cbl::cosmology::Cosmology::Pk_0 (const std::string method_Pk, const double
 {  
   if (m_sigma8<0) ErrorCBL("Error in cbl::cosmology::Cosmology::Pk_0 of PkXi.cpp, sigma8<0!");
 
+  // the normalisation is computed only once for each set of parameters
+  
+  const string key = m_Pk_key("Pk_0|"+method_Pk+"|"+file_par, {redshift, k_min, k_max, prec});
+  double Pk0;
+  
+  if (m_Pk_cache->value(key, Pk0)) {
+    if (method_Pk=="EisensteinHu") m_Pk0_EH = Pk0;
+    if (method_Pk=="CAMB") m_Pk0_CAMB = Pk0;
+    if (method_Pk=="MPTbreeze-v1") m_Pk0_MPTbreeze = Pk0;
+    if (method_Pk=="classgal_v1") m_Pk0_CLASS = Pk0;
+    return;
+  }
+  
   double RR = 8.; // sigma_8 = sigma(8Mpc/h)
   double RHO = rho_m(0., true); 
   double MM = Mass(RR, RHO);
@@ -594,8 +742,7 @@ void cbl::cosmology::Cosmology::Pk_0 (const std::string method_Pk, const double
   }
 
   else if (method_Pk=="CAMB" || method_Pk=="MPTbreeze-v1" || method_Pk=="classgal_v1") {
-    vector<double> lgkk, lgPk;
-    Table_PkCodes(method_Pk, NL, lgkk, lgPk, redshift, output_root, k_max, file_par);
+    const shared_ptr<const PowerSpectrumTable> table = m_Pk_table(method_Pk, NL, redshift, output_root, k_max, file_par);
 
     int limit_size = 1000;
     gsl_integration_workspace *ww = gsl_integration_workspace_alloc(limit_size);
@@ -607,8 +754,8 @@ void cbl::cosmology::Cosmology::Pk_0 (const std::string method_Pk, const double
     str.n_spec = m_n_spec;
     str.mass = MM;
     str.rho = RHO;
-    str.lgkk = lgkk;
-    str.lgPk = lgPk;
+    str.lgkk = table->lgkk;
+    str.lgPk = table->lgPk;
 
     Func.function = &glob::func_SSM_GSL;
     Func.params = &str;
@@ -619,10 +766,13 @@ void cbl::cosmology::Cosmology::Pk_0 (const std::string method_Pk, const double
   else ErrorCBL("Error in cbl::cosmology::Cosmology::sigma8_Pk of PkXi.cpp: method_Pk is wrong!");
 
 
-  if (method_Pk=="EisensteinHu") m_Pk0_EH = 2.*pow(par::pi*m_sigma8,2)/Int*pow(DD(redshift)/DD(0),2);
-  if (method_Pk=="CAMB") m_Pk0_CAMB = 2.*pow(par::pi*m_sigma8,2)/Int*pow(DD(redshift)/DD(0),2);
-  if (method_Pk=="MPTbreeze-v1") m_Pk0_MPTbreeze = 2.*pow(par::pi*m_sigma8,2)/Int*pow(DD(redshift)/DD(0),2);
-  if (method_Pk=="classgal_v1") m_Pk0_CLASS = 2.*pow(par::pi*m_sigma8,2)/Int*pow(DD(redshift)/DD(0),2);
+  Pk0 = 2.*pow(par::pi*m_sigma8,2)/Int*pow(DD(redshift)/DD(0),2);
+  m_Pk_cache->set_value(key, Pk0);
+  
+  if (method_Pk=="EisensteinHu") m_Pk0_EH = Pk0;
+  if (method_Pk=="CAMB") m_Pk0_CAMB = Pk0;
+  if (method_Pk=="MPTbreeze-v1") m_Pk0_MPTbreeze = Pk0;
+  if (method_Pk=="classgal_v1") m_Pk0_CLASS = Pk0;
 
 }
 
@@ -654,10 +804,7 @@ double cbl::cosmology::Cosmology::Pk (const double kk, const std::string method_
   
   if (method_Pk=="CAMB" || method_Pk=="MPTbreeze-v1" || method_Pk=="classgal_v1") {
     double lgk = log10(kk/fact1);
-    vector<double> lgkk, lgPk;
-    Table_PkCodes(method_Pk, NL, lgkk, lgPk, redshift, output_root, k_max, file_par);
-
-    double lgPK = interpolated(lgk, lgkk, lgPk, "Linear");
+    double lgPK = (*m_Pk_table(method_Pk, NL, redshift, output_root, k_max, file_par))(lgk);
 
     double PP0 = -1.;
     if (method_Pk=="CAMB") PP0 = m_Pk0_CAMB;
@@ -671,6 +818,59 @@ double cbl::cosmology::Cosmology::Pk (const double kk, const std::string method_
 
 }
 
+
+// =====================================================================================
+
+
+std::vector<double> cbl::cosmology::Cosmology::Pk_grid (const std::vector<double> kk, const std::string method_Pk, const bool NL, const double redshift, const std::string output_root, const int norm, const double k_min, const double k_max, const double prec, const std::string file_par, const bool unit1)
+{
+  int Norm = norm;
+
+  const double fact1 = (m_unit || unit1) ? 1. : m_hh;
+  const double fact2 = pow(fact1, 3);
+
+  if (Norm==-1) Norm = (m_sigma8>0) ? 1 : 0;
+ 
+  if (method_Pk=="MPTbreeze-v1") Norm = 0; // check!!!
+
+  if (Norm==1) Pk_0(method_Pk, redshift, output_root, k_min, k_max, prec, file_par);
+  else { m_Pk0_EH = 1.; m_Pk0_CAMB = 1.; m_Pk0_MPTbreeze = 1.; m_Pk0_CLASS = 1.; }
+
+  vector<double> Pk(kk.size());
+  
+  if (method_Pk=="EisensteinHu") { // NL is not used!!!
+
+#pragma omp parallel num_threads(omp_get_max_threads())
+    {
+      EisensteinHu eh;
+      eh.TFmdm_set_cosm(m_Omega_matter, m_Omega_baryon, m_Omega_neutrinos, m_massive_neutrinos, m_Omega_DE, m_hh, redshift, m_scalar_amp, m_scalar_pivot, m_n_spec);
+
+#pragma omp for schedule(static)
+      for (size_t i=0; i<kk.size(); ++i)
+	Pk[i] = m_Pk0_EH*eh.Pk(kk[i]/fact1)/fact2;
+    }
+  }
+
+  else if (method_Pk=="CAMB" || method_Pk=="MPTbreeze-v1" || method_Pk=="classgal_v1") {
+    
+    const shared_ptr<const PowerSpectrumTable> table = m_Pk_table(method_Pk, NL, redshift, output_root, k_max, file_par);
+    
+    double PP0 = -1.;
+    if (method_Pk=="CAMB") PP0 = m_Pk0_CAMB;
+    if (method_Pk=="MPTbreeze-v1") PP0 = m_Pk0_MPTbreeze;
+    if (method_Pk=="classgal_v1") PP0 = m_Pk0_CLASS;
+
+#pragma omp parallel for schedule(static) num_threads(omp_get_max_threads())
+    for (size_t i=0; i<kk.size(); ++i)
+      Pk[i] = PP0*pow(10., (*table)(log10(kk[i]/fact1)))/fact2;
+  }
+
+  else ErrorCBL("Error in cbl::cosmology::Cosmology::Pk_grid of PkXi.cpp: method_Pk is wrong!");
+
+  return Pk;
+}
+
+
 // =====================================================================================
 
 
@@ -83,14 +83,17 @@ double cbl::cosmology::Cosmology::m_func_sigma (const string method_Pk, const do
     
   else if (method_Pk=="EisensteinHu" && input_file==par::defaultString) {
     
-    auto ff = [&] (const double kk)
+    // the transfer function is set only once, and not at each call of the integrand
+    auto eh = make_shared<EisensteinHu>();
+    eh->TFmdm_set_cosm(m_Omega_matter, m_Omega_baryon, m_Omega_neutrinos, m_massive_neutrinos, m_Omega_DE, m_hh, redshift, m_scalar_amp, m_scalar_pivot, m_n_spec);
+    
+    auto ff = [eh, fact] (const double kk)
     {
-      EisensteinHu eh;
-      eh.TFmdm_set_cosm(m_Omega_matter, m_Omega_baryon, m_Omega_neutrinos, m_massive_neutrinos, m_Omega_DE, m_hh, redshift, m_scalar_amp, m_scalar_pivot, m_n_spec);
+      const double Pk = eh->Pk(kk*fact);
       
-      if (eh.Pk(kk)!=eh.Pk(kk)) ErrorCBL("Error in cbl::cosmology::Cosmology::m_func_sigma() of Sigma.cpp: eh.Pk=nan!");
+      if (Pk!=Pk) ErrorCBL("Error in cbl::cosmology::Cosmology::m_func_sigma() of Sigma.cpp: eh.Pk=nan!");
 
-      return eh.Pk(kk*fact)*pow(fact, -3.);
+      return Pk*pow(fact, -3.);
     };
     
     func = ff;
@@ -98,14 +101,13 @@ double cbl::cosmology::Cosmology::m_func_sigma (const string method_Pk, const do
 
   else if (method_Pk=="CAMB" || method_Pk=="classgal_v1") {
     
-    vector<double> lgkk, lgPk; 
-    Table_PkCodes(method_Pk, false, lgkk, lgPk, redshift, output_root, kmax, input_file);
+    const shared_ptr<const PowerSpectrumTable> table = m_Pk_table(method_Pk, false, redshift, output_root, kmax, input_file);
 
-    for (size_t i=0; i<lgkk.size(); i++) {
-      const double KK = pow(10., lgkk[i])*fact;
+    for (size_t i=0; i<table->lgkk.size(); i++) {
+      const double KK = pow(10., table->lgkk[i])*fact;
       if (KK<kmax) {
 	kk.emplace_back(KK);
-	Pk.emplace_back(pow(10., lgPk[i])*pow(fact, -3.));
+	Pk.emplace_back(pow(10., table->lgPk[i])*pow(fact, -3.));
       }
     }
 
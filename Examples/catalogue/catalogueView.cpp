@@ -0,0 +1,70 @@
+// ======================================================================
+// Example code: how to select the objects of a catalogue with the views
+// ======================================================================
+
+#include "CatalogueView.h"
+#include "GlobalFunc.h"
+
+// these two variables contain the name of the CosmoBolognaLib
+// directory and the name of the current directory (useful when
+// launching the code on remote systems)
+std::string cbl::par::DirCosmo = DIRCOSMO, cbl::par::DirLoc = DIRL;
+
+int main () {
+
+  try {
+
+    // ------------------------------------------------------
+    // ------- read the catalogue and set its regions -------
+    // ------------------------------------------------------
+
+    cbl::catalogue::Catalogue catalogue {cbl::catalogue::ObjectType::_Galaxy_, cbl::CoordinateType::_comoving_, {"cat.dat"}};
+
+    cbl::set_ObjectRegion_SubBoxes(catalogue, 3, 3, 3);
+
+
+    // -----------------------------------------------------------------------------
+    // ------- select the objects with a view, without copying the catalogue -------
+    // -----------------------------------------------------------------------------
+
+    const double zMin = catalogue.Min(cbl::catalogue::Var::_Z_), zMax = catalogue.Max(cbl::catalogue::Var::_Z_);
+    const double zCut = 0.5*(zMin+zMax);
+
+    // the selections can be combined, storing only the indexes of the selected objects
+    const cbl::catalogue::CatalogueView view = cbl::catalogue::CatalogueView(catalogue).diluted(0.5).sub_catalogue(cbl::catalogue::Var::_Z_, zMin, zCut);
+
+    // the same selection done with the catalogues
+    const cbl::catalogue::Catalogue selected = catalogue.diluted_catalogue(0.5).sub_catalogue(cbl::catalogue::Var::_Z_, zMin, zCut);
+
+    std::cout << "The number of selected galaxies is " << view.nObjects() << std::endl;
+
+    if (view.nObjects()!=selected.nObjects())
+      cbl::ErrorCBL("the view and the catalogue contain a different number of objects!");
+
+    // the view is converted into a catalogue only when it has to be used, e.g. by the measurement classes
+    const cbl::catalogue::Catalogue converted = view.catalogue();
+
+    for (size_t i=0; i<converted.nObjects(); ++i)
+      if (converted.catalogue_object(i)!=view[i])
+	cbl::ErrorCBL("the converted catalogue does not share the objects of the parent catalogue!");
+
+
+    // ---------------------------------------------------------------------------
+    // ------- exclude the objects of a region, as in jackknife resampling -------
+    // ---------------------------------------------------------------------------
+
+    const cbl::catalogue::CatalogueView jackknife = cbl::catalogue::CatalogueView(catalogue).exclude_regions({0});
+
+    const size_t nRegion0 = catalogue.nObjects_condition(cbl::catalogue::Var::_Region_, 0, 1);
+
+    std::cout << "The number of galaxies outside the first region is " << jackknife.nObjects() << std::endl;
+
+    if (jackknife.nObjects()+nRegion0!=catalogue.nObjects())
+      cbl::ErrorCBL("the region has not been excluded correctly!");
+
+  }
+
+  catch(cbl::glob::Exception &exc) { std::cerr << exc.what() << std::endl; exit(1); }
+
+  return 0;
+}
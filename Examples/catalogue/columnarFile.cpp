@@ -0,0 +1,66 @@
+// ======================================================================
+// Example code: how to write and read a catalogue in the native columnar
+// binary format
+// ======================================================================
+
+#include "ColumnarFile.h"
+
+// these two variables contain the name of the CosmoBolognaLib
+// directory and the name of the current directory (useful when
+// launching the code on remote systems)
+std::string cbl::par::DirCosmo = DIRCOSMO, cbl::par::DirLoc = DIRL;
+
+int main () {
+
+  try {
+
+    // -----------------------------------------------------------------------
+    // ------- read an ASCII catalogue and write it in columnar format -------
+    // -----------------------------------------------------------------------
+
+    const cbl::catalogue::Catalogue catalogue {cbl::catalogue::ObjectType::_Galaxy_, cbl::CoordinateType::_comoving_, {"cat.dat"}};
+
+    const std::string file_columnar = "temp_cat.col";
+
+    catalogue.write_data(file_columnar, {cbl::catalogue::Var::_X_, cbl::catalogue::Var::_Y_, cbl::catalogue::Var::_Z_, cbl::catalogue::Var::_Weight_}, cbl::catalogue::CharEncode::_columnar_);
+
+
+    // -------------------------------------------------------------------------
+    // ------- read the columnar file: no parsing is required to load it -------
+    // -------------------------------------------------------------------------
+
+    const cbl::catalogue::Catalogue catalogue_columnar {cbl::catalogue::ObjectType::_Galaxy_, cbl::CoordinateType::_comoving_, {file_columnar}, 1, 2, 3, -1, -1, 1.1, 1., {}, cbl::CoordinateUnits::_radians_, cbl::catalogue::CharEncode::_columnar_};
+
+    std::cout << "The number of galaxies in the columnar catalogue is " << catalogue_columnar.nObjects() << std::endl;
+
+    if (catalogue_columnar.nObjects()!=catalogue.nObjects())
+      cbl::ErrorCBL("the columnar catalogue does not contain all the objects!");
+
+    for (size_t i=0; i<catalogue.nObjects(); ++i)
+      if (catalogue_columnar.xx(i)!=catalogue.xx(i) || catalogue_columnar.yy(i)!=catalogue.yy(i) || catalogue_columnar.zz(i)!=catalogue.zz(i))
+	cbl::ErrorCBL("the coordinates read from the columnar file are different from the original ones!");
+
+
+    // ------------------------------------------------------------------------
+    // ------- access the columns directly, from the memory-mapped file -------
+    // ------------------------------------------------------------------------
+
+    {
+      const cbl::catalogue::ColumnarFile cf(file_columnar);
+
+      const double *xx = cf.column(cbl::catalogue::Var::_X_);
+
+      std::cout << "The x coordinate of the first galaxy is " << xx[0] << std::endl;
+
+      if (cf.isSetVar(cbl::catalogue::Var::_Region_) || xx[cf.nObjects()-1]!=catalogue.xx(catalogue.nObjects()-1))
+	cbl::ErrorCBL("the columns of the file are not the expected ones!");
+    }
+
+    remove(file_columnar.c_str());
+
+  }
+
+  catch(cbl::glob::Exception &exc) { std::cerr << exc.what() << std::endl; exit(1); }
+
+  return 0;
+}
@@ -0,0 +1,82 @@
+// =====================================================================
+// Example code: how to search for close objects with a kd-tree
+// =====================================================================
+
+#include "KDTree_Catalogue.h"
+
+// these two variables contain the name of the CosmoBolognaLib
+// directory and the name of the current directory (useful when
+// launching the code on remote systems)
+std::string cbl::par::DirCosmo = DIRCOSMO, cbl::par::DirLoc = DIRL;
+
+int main () {
+
+  try {
+
+    // ---------------------------------------------------------------
+    // ------- create a clustered catalogue in a non-cubic box -------
+    // ---------------------------------------------------------------
+
+    // the objects are distributed in a thin slab, with half of them
+    // in a small clump: a geometry for which most of the chain-mesh
+    // cells would be empty
+
+    const int nObjects = 10000;
+
+    cbl::random::UniformRandomNumbers ran(0., 1., 1234);
+
+    std::vector<double> xx(nObjects), yy(nObjects), zz(nObjects);
+    for (int i=0; i<nObjects; ++i) {
+      const double size = (i%2==0) ? 500. : 20.;
+      xx[i] = size*ran();
+      yy[i] = size*ran();
+      zz[i] = 10.*ran();
+    }
+
+    auto catalogue = std::make_shared<cbl::catalogue::Catalogue>(cbl::catalogue::Catalogue(cbl::catalogue::ObjectType::_Galaxy_, cbl::CoordinateType::_comoving_, xx, yy, zz));
+
+
+    // -------------------------------------
+    // ------- construct the kd-tree -------
+    // -------------------------------------
+
+    const double rMax = 5.; // the maximum separation
+
+    const cbl::chainmesh::KDTree_Catalogue tree(catalogue, rMax, 16);
+
+    std::cout << "The kd-tree has " << tree.nNodes() << " nodes and " << tree.nLeaves() << " leaves" << std::endl;
+
+    if (tree.nLeaves()<nObjects/16 || tree.nNodes()!=2*tree.nLeaves()-1)
+      cbl::ErrorCBL("the kd-tree has not been constructed correctly!");
+
+
+    // --------------------------------------------------------------------------
+    // ------- the close objects include all the objects closer than rMax -------
+    // --------------------------------------------------------------------------
+
+    for (int i=0; i<nObjects; i+=100) {
+
+      // all the objects of the leaves close to the i-th object
+      std::vector<long> close = tree.close_objects({xx[i], yy[i], zz[i]});
+      std::sort(close.begin(), close.end());
+
+      // only the objects of index larger than i, as used to count the pairs
+      const std::vector<long> close_ii = tree.close_objects({xx[i], yy[i], zz[i]}, i);
+
+      for (int j=0; j<nObjects; ++j) {
+	const double dist = sqrt(pow(xx[i]-xx[j], 2)+pow(yy[i]-yy[j], 2)+pow(zz[i]-zz[j], 2));
+	if (dist<rMax && !std::binary_search(close.begin(), close.end(), j))
+	  cbl::ErrorCBL("the kd-tree has missed an object closer than the maximum separation!");
+      }
+
+      for (auto &&j : close_ii)
+	if (j<=i)
+	  cbl::ErrorCBL("the kd-tree has returned an object of index smaller than the selected one!");
+    }
+
+  }
+
+  catch(cbl::glob::Exception &exc) { std::cerr << exc.what() << std::endl; exit(1); }
+
+  return 0;
+}
@@ -0,0 +1,111 @@
+// =====================================================================
+// Example code: how to use an angular mask in the mangle polygon format
+// =====================================================================
+
+#include <omp.h>
+#include "MangleMask.h"
+
+// these two variables contain the name of the CosmoBolognaLib
+// directory and the name of the current directory (useful when
+// launching the code on remote systems)
+std::string cbl::par::DirCosmo = DIRCOSMO, cbl::par::DirLoc = DIRL;
+
+int main () {
+
+  try {
+
+    // ---------------------------------------------------------------
+    // ------- write a mask with two polygons in mangle format -------
+    // ---------------------------------------------------------------
+
+    // polygon 1: the cap at Dec > 60 deg, with weight 1
+    const double area1 = 2.*cbl::par::pi*(1.-cos(cbl::par::pi/6.));
+
+    // polygon 2: the region at 0 < RA < 90 deg and -30 < Dec < 0 deg,
+    // with weight 0.5; it is the intersection of four caps
+    const double area2 = 0.25*cbl::par::pi, weight2 = 0.5;
+
+    const std::string file_mask = "temp_mask.ply";
+
+    std::ofstream fout(file_mask.c_str()); cbl::checkIO(fout, file_mask);
+    fout << std::setprecision(15)
+	 << "2 polygons" << std::endl
+	 << "polygon 1 ( 1 caps, 1 weight, 0 pixel, " << area1 << " str):" << std::endl
+	 << "0 0 1 " << 1.-cos(cbl::par::pi/6.) << std::endl
+	 << "polygon 2 ( 4 caps, " << weight2 << " weight, 0 pixel, " << area2 << " str):" << std::endl
+	 << "0 0 1 1.5" << std::endl  // Dec > -30 deg
+	 << "0 0 1 -1" << std::endl   // Dec < 0
+	 << "0 1 0 1" << std::endl    // 0 < RA < 180 deg
+	 << "1 0 0 1" << std::endl;   // -90 < RA < 90 deg
+    fout.clear(); fout.close();
+
+    const cbl::catalogue::MangleMask mask({file_mask});
+
+    std::cout << "The mask has " << mask.nPolygons() << " polygons, with a total area of " << mask.area() << " steradians" << std::endl;
+
+    if (mask.nPolygons()!=2 || fabs(mask.area()-area1-area2)>1.e-10)
+      cbl::ErrorCBL("the polygons have not been read correctly!");
+
+
+    // --------------------------------------------------------------
+    // ------- find the polygons that contain some directions -------
+    // --------------------------------------------------------------
+
+    const double deg = cbl::par::pi/180.;
+
+    const std::vector<double> ra = {0., 45.*deg, 180.*deg, 45.*deg};
+    const std::vector<double> dec = {80.*deg, -15.*deg, -15.*deg, 15.*deg};
+
+    const std::vector<long> id = mask.polygon(ra, dec);
+    const std::vector<double> ww = mask.weight(ra, dec);
+
+    for (size_t i=0; i<ra.size(); ++i)
+      std::cout << "RA = " << ra[i]/deg << ", Dec = " << dec[i]/deg << " --> polygon " << id[i] << ", weight " << ww[i] << std::endl;
+
+    if (id!=std::vector<long>{1, 2, -1, -1} || ww!=std::vector<double>{1., weight2, 0., 0.})
+      cbl::ErrorCBL("the polygons that contain the directions are wrong!");
+
+
+    // ----------------------------------------------------------
+    // ------- generate random directions inside the mask -------
+    // ----------------------------------------------------------
+
+    const size_t nRandom = 200000;
+
+    std::vector<double> random_ra, random_dec;
+    mask.random_directions(random_ra, random_dec, nRandom, 4321);
+
+    // the number of directions in each polygon is proportional to its area times its weight
+    const std::vector<long> random_id = mask.polygon(random_ra, random_dec);
+
+    if (std::count(random_id.begin(), random_id.end(), -1)>0)
+      cbl::ErrorCBL("some random directions are outside the mask!");
+
+    const double fraction = std::count(random_id.begin(), random_id.end(), 2)/double(nRandom);
+    const double expected = area2*weight2/(area1+area2*weight2);
+
+    std::cout << "The fraction of random directions in the second polygon is " << fraction << " (expected: " << expected << ")" << std::endl;
+
+    if (fabs(fraction-expected)>5.*sqrt(expected*(1.-expected)/nRandom))
+      cbl::ErrorCBL("the random directions are not distributed according to the weights of the polygons!");
+
+    // the random directions do not depend on the number of threads
+    const int nThreads = omp_get_max_threads();
+    omp_set_num_threads(1);
+
+    std::vector<double> random_ra_serial, random_dec_serial;
+    mask.random_directions(random_ra_serial, random_dec_serial, nRandom, 4321);
+
+    omp_set_num_threads(nThreads);
+
+    if (random_ra_serial!=random_ra || random_dec_serial!=random_dec)
+      cbl::ErrorCBL("the random directions depend on the number of threads!");
+
+    remove(file_mask.c_str());
+
+  }
+
+  catch(cbl::glob::Exception &exc) { std::cerr << exc.what() << std::endl; exit(1); }
+
+  return 0;
+}
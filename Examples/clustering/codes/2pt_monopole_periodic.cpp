@@ -0,0 +1,69 @@
+// ==========================================================================
+// Example code: how to measure the monopole of the two-point correlation
+// function in a periodic box, without random catalogues
+// ==========================================================================
+
+#include "TwoPointCorrelation1D_monopole.h"
+
+// these two variables contain the name of the CosmoBolognaLib
+// directory and the name of the current directory (useful when
+// launching the code on remote systems)
+std::string cbl::par::DirCosmo = DIRCOSMO, cbl::par::DirLoc = DIRL;
+
+
+int main () {
+
+  try {
+
+    // ------------------------------------------------------------------------------
+    // ---------------- create a Poisson catalogue in a periodic box ----------------
+    // ------------------------------------------------------------------------------
+
+    const double side = 100.; // the side of the box
+    const std::vector<double> box_min = {1000., 1000., 1000.}; // the minimum coordinates of the box
+
+    const int nObjects = 20000;
+
+    cbl::random::UniformRandomNumbers ran(0., side, 4321);
+
+    std::vector<double> xx(nObjects), yy(nObjects), zz(nObjects);
+    for (int i=0; i<nObjects; ++i) {
+      xx[i] = box_min[0]+ran();
+      yy[i] = box_min[1]+ran();
+      zz[i] = box_min[2]+ran();
+    }
+
+    const cbl::catalogue::Catalogue catalogue {cbl::catalogue::ObjectType::_Galaxy_, cbl::CoordinateType::_comoving_, xx, yy, zz};
+
+
+    // --------------------------------------------------------------------------------------------
+    // ---------------- measure the monopole of the two-point correlation function ----------------
+    // --------------------------------------------------------------------------------------------
+
+    const double rMin = 5.;   // minimum separation
+    const double rMax = 20.;  // maximum separation
+    const int nbins = 5;      // number of bins
+    const double shift = 0.5; // spatial shift used to set the bin centre
+
+    // the random pairs are computed analytically from the volume of the box
+    cbl::measure::twopt::TwoPointCorrelation1D_monopole TwoP {catalogue, side, cbl::BinType::_logarithmic_, rMin, rMax, nbins, shift, box_min};
+
+    TwoP.measure(cbl::measure::ErrorType::_Poisson_);
+
+
+    // the two-point correlation function of a Poisson catalogue is consistent with zero
+
+    const std::vector<double> rr = TwoP.xx(), xi = TwoP.xi1D(), error = TwoP.error1D();
+
+    for (size_t i=0; i<xi.size(); ++i) {
+      std::cout << "xi(" << rr[i] << ") = " << xi[i] << " +/- " << error[i] << std::endl;
+      if (!(error[i]>0.) || fabs(xi[i])>5.*error[i])
+	cbl::ErrorCBL("the two-point correlation function of the Poisson catalogue is not consistent with zero!");
+    }
+
+  }
+
+  catch(cbl::glob::Exception &exc) { std::cerr << exc.what() << std::endl; exit(1); }
+
+  return 0;
+}
@@ -0,0 +1,144 @@
+// ==========================================================================
+// Example code: how to check that the pair counts do not depend on the
+// number of threads and of MPI tasks
+// ==========================================================================
+
+// to distribute the pair counts across the MPI tasks, compile the
+// CosmoBolognaLib and this code with C=mpicxx FLAGS_MPI=-DUSE_MPI,
+// and run it with mpirun
+
+#ifdef USE_MPI
+#define OMPI_SKIP_MPICXX
+#define MPICH_SKIP_MPICXX
+#include <mpi.h>
+#endif
+
+#include <omp.h>
+#include "TwoPointCorrelation1D_monopole.h"
+
+// these two variables contain the name of the CosmoBolognaLib
+// directory and the name of the current directory (useful when
+// launching the code on remote systems)
+std::string cbl::par::DirCosmo = DIRCOSMO, cbl::par::DirLoc = DIRL;
+
+
+// this class gives access to the functions used to count the pairs,
+// with a single task or distributing the computation across the MPI
+// tasks
+
+class TwoPointCorrelation : public cbl::measure::twopt::TwoPointCorrelation1D_monopole {
+
+public:
+
+  TwoPointCorrelation (const cbl::catalogue::Catalogue &data, const double rMin, const double rMax, const int nbins)
+    : cbl::measure::twopt::TwoPointCorrelation(data, data), TwoPointCorrelation1D(data, data), TwoPointCorrelation1D_monopole(data, data, cbl::BinType::_logarithmic_, rMin, rMax, nbins, 0.5) {}
+
+  // the data-data pairs, in total and by couple of regions
+  std::vector<std::shared_ptr<cbl::pairs::Pair>> pairs (const bool regions, const bool distributed)
+  {
+    const int nRegions = m_data->nRegions();
+
+    std::vector<std::shared_ptr<cbl::pairs::Pair>> pp((regions) ? nRegions*(nRegions+1)/2+1 : 1);
+    for (auto &&pp_i : pp)
+      pp_i = cbl::pairs::Pair::Create(m_dd->pairType(), m_dd->pairInfo(), m_dd->sMin(), m_dd->sMax(), m_dd->nbins(), m_dd->shift());
+
+    const std::vector<std::shared_ptr<cbl::pairs::Pair>> pp_regions(pp.begin()+1, pp.end());
+
+    if (distributed)
+      count_pairs_distributed(m_data, m_data, m_dd->sMax(), pp[0], pp_regions, false);
+
+    else {
+      const cbl::chainmesh::ChainMesh_Catalogue ChM(chainMesh_cell_size(m_data, m_dd->sMax(), m_dd), m_data, m_dd->sMax());
+      if (regions) count_pairs_region(m_data, ChM, pp[0], pp_regions, false);
+      else count_pairs(m_data, ChM, pp[0], false);
+    }
+
+    return pp;
+  }
+
+};
+
+
+int main (int argc, char **argv) {
+
+#ifdef USE_MPI
+  MPI_Init(&argc, &argv);
+#else
+  (void)argc; (void)argv;
+#endif
+
+  try {
+
+    // ----------------------------------------------------------------------------
+    // ---------------- create a weighted catalogue with 8 regions ----------------
+    // ----------------------------------------------------------------------------
+
+    const double side = 100.; // the side of the box
+    const int nObjects = 20000;
+
+    cbl::random::UniformRandomNumbers ran(0., 1., 2143);
+
+    std::vector<double> xx(nObjects), yy(nObjects), zz(nObjects), weight(nObjects);
+    std::vector<long> region(nObjects);
+    for (int i=0; i<nObjects; ++i) {
+      xx[i] = side*ran();
+      yy[i] = side*ran();
+      zz[i] = side*ran();
+      // the weights are not integer, so that the weighted counts depend on the order of the sums, if not summed exactly
+      weight[i] = 0.1+ran();
+      region[i] = int(2.*xx[i]/side)+2*int(2.*yy[i]/side)+4*int(2.*zz[i]/side);
+    }
+
+    cbl::catalogue::Catalogue catalogue {cbl::catalogue::ObjectType::_Galaxy_, cbl::CoordinateType::_comoving_, xx, yy, zz, weight};
+    catalogue.set_region(region);
+
+    TwoPointCorrelation TwoP {catalogue, 1., 20., 10};
+
+
+    // ----------------------------------------------------------------------------------------------------
+    // ---------------- count the pairs with one thread, all the threads and all the tasks ----------------
+    // ----------------------------------------------------------------------------------------------------
+
+    // the number of pairs and the weighted number of pairs in each bin
+    auto counts = [] (const std::vector<std::shared_ptr<cbl::pairs::Pair>> pp)
+      {
+	std::vector<std::vector<double>> cc;
+	for (auto &&pp_i : pp) {
+	  cc.emplace_back(pp_i->PP1D());
+	  cc.emplace_back(pp_i->PP1D_weighted());
+	}
+	return cc;
+      };
+
+    for (auto &&regions : {false, true}) {
+
+      const int nThreads = omp_get_max_threads();
+      omp_set_num_threads(1);
+      const std::vector<std::vector<double>> counts_single = counts(TwoP.pairs(regions, false));
+      omp_set_num_threads(nThreads);
+
+      const std::vector<std::vector<double>> counts_threads = counts(TwoP.pairs(regions, false));
+      const std::vector<std::vector<double>> counts_tasks = counts(TwoP.pairs(regions, true));
+
+      if (cbl::wrapper::mpi::rank()==0)
+	std::cout << "The weighted number of pairs in the first bin is " << std::setprecision(17) << counts_single[1][0] << " with one thread, "
+		  << counts_threads[1][0] << " with " << nThreads << " threads, and " << counts_tasks[1][0] << " with " << cbl::wrapper::mpi::size() << " MPI tasks" << std::endl;
+
+      // the counts are compared bit by bit
+      if (counts_threads!=counts_single)
+	cbl::ErrorCBL("the pair counts depend on the number of threads!");
+
+      if (counts_tasks!=counts_single)
+	cbl::ErrorCBL("the pair counts depend on the number of MPI tasks!");
+    }
+
+  }
+
+  catch(cbl::glob::Exception &exc) { std::cerr << exc.what() << std::endl; exit(1); }
+
+#ifdef USE_MPI
+  MPI_Finalize();
+#endif
+
+  return 0;
+}
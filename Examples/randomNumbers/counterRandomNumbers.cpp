@@ -0,0 +1,109 @@
+// =====================================================================================
+// Example code: how to use the CounterRandomNumbers class to generate random numbers in
+// parallel, with results that do not depend on the number of threads
+// =====================================================================================
+
+#include <omp.h>
+#include "RandomNumbers.h"
+
+
+// this class gives access to the Philox4x32-10 blocks, to compare
+// them with the known-answer tests of Salmon et al. (2011)
+
+class Philox : public cbl::random::CounterRandomNumbers {
+
+public:
+
+  Philox () : CounterRandomNumbers(0, 0) {}
+
+  std::array<uint32_t, 4> block (const std::array<uint32_t, 4> counter, const std::array<uint32_t, 2> key)
+  {
+    m_counter = counter;
+    m_key = key;
+    m_next_block();
+    return m_block;
+  }
+
+};
+
+
+int main () {
+
+  try {
+
+    // ---------------------------------------------------------------
+    // ------- check the generator with the known-answer tests -------
+    // ---------------------------------------------------------------
+
+    Philox philox;
+
+    if (philox.block({{0, 0, 0, 0}}, {{0, 0}})!=std::array<uint32_t, 4>{{0x6627e8d5, 0xe169c58d, 0xbc57ac4c, 0x9b00dbd8}} ||
+	philox.block({{0xffffffff, 0xffffffff, 0xffffffff, 0xffffffff}}, {{0xffffffff, 0xffffffff}})!=std::array<uint32_t, 4>{{0x408f276d, 0x41c83b0e, 0xa20bc7c6, 0x6d5451fd}} ||
+	philox.block({{0x243f6a88, 0x85a308d3, 0x13198a2e, 0x03707344}}, {{0xa4093822, 0x299f31d0}})!=std::array<uint32_t, 4>{{0xd16cfe09, 0x94fdcceb, 0x5001e420, 0x24126ea1}})
+      cbl::ErrorCBL("the Philox4x32-10 blocks are different from the known answers!");
+
+
+    // ---------------------------------------------------------------------------
+    // ------- generate random numbers in parallel, one stream per element -------
+    // ---------------------------------------------------------------------------
+
+    const int seed = 1231;
+    const int nElements = 1000, nNumbers = 100;
+
+    auto generate = [&] () {
+      std::vector<std::vector<double>> numbers(nElements, std::vector<double>(nNumbers));
+
+#pragma omp parallel for schedule(dynamic)
+      for (int i=0; i<nElements; ++i) {
+	// each element has its own stream: the numbers do not depend on the thread that extracts them
+	cbl::random::CounterRandomNumbers ran(seed, i);
+	for (auto &&num : numbers[i]) num = ran();
+      }
+
+      return numbers;
+    };
+
+    const std::vector<std::vector<double>> numbers = generate();
+
+    const int nThreads = omp_get_max_threads();
+    omp_set_num_threads(1);
+    const std::vector<std::vector<double>> numbers_serial = generate();
+    omp_set_num_threads(nThreads);
+
+    if (numbers_serial!=numbers)
+      cbl::ErrorCBL("the random numbers depend on the number of threads!");
+
+
+    // -----------------------------------------------------------------------
+    // ------- the numbers are uniform and the streams are independent -------
+    // -----------------------------------------------------------------------
+
+    const double nn = nElements*nNumbers;
+
+    double mean = 0., correlation = 0.;
+    for (int i=0; i<nElements; ++i)
+      for (int j=0; j<nNumbers; ++j) {
+	if (numbers[i][j]<0. || numbers[i][j]>=1.)
+	  cbl::ErrorCBL("the random numbers are outside [0,1)!");
+	mean += numbers[i][j]/nn;
+	// correlation between the same position of two contiguous streams
+	correlation += 12.*(numbers[i][j]-0.5)*(numbers[(i+1)%nElements][j]-0.5)/nn;
+      }
+
+    std::cout << "The mean of the random numbers is " << mean << " (expected: 0.5)" << std::endl;
+    std::cout << "The correlation between contiguous streams is " << correlation << " (expected: 0)" << std::endl;
+
+    if (fabs(mean-0.5)>5.*sqrt(1./(12.*nn)) || fabs(correlation)>5./sqrt(nn))
+      cbl::ErrorCBL("the random numbers are not uniform, or the streams are correlated!");
+
+    // the substreams are different from the stream
+    cbl::random::CounterRandomNumbers ran0(seed, 0), ran1(seed, 0, 1);
+    if (ran0()==ran1())
+      cbl::ErrorCBL("the substreams are equal!");
+
+  }
+
+  catch(cbl::glob::Exception &exc) { std::cerr << exc.what() << std::endl; exit(1); }
+
+  return 0;
+}
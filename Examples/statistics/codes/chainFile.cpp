@@ -0,0 +1,108 @@
+// ===========================================================================
+// Example code: how to write the MCMC chains on a file while sampling, and
+// how to resume an interrupted run
+// ===========================================================================
+
+#include "Sampler.h"
+
+// these two variables contain the name of the CosmoBolognaLib
+// directory and the name of the current directory (useful when
+// launching the code on remote systems)
+std::string cbl::par::DirCosmo = DIRCOSMO, cbl::par::DirLoc = DIRL;
+
+
+double func (std::vector<double> &x)
+{
+  return -(100.*pow(x[1]-x[0]*x[0], 2)+pow(1.-x[0], 2))/20.;
+}
+
+
+int main () {
+
+  try {
+
+    const int npar = 2;
+    const int nwalkers = 10;
+    const int chain_size = 1000;
+    const int seed = 4314234;
+
+    cbl::random::NormalRandomNumbers ran(0., 1.e-3, 43213234, -100., 100.);
+    std::vector<std::vector<double>> start(nwalkers, std::vector<double>(npar, 0.));
+    for (auto &&walker : start)
+      for (auto &&par : walker)
+	par = ran();
+
+    cbl::statistics::Sampler sampler(npar, &func);
+
+    const std::string file_chains = "temp_chains.bin";
+    const std::string file_resumed = "temp_chains_resumed.bin";
+
+
+    // -----------------------------------------------------------------
+    // ------- sample the function, writing the chains on a file -------
+    // -----------------------------------------------------------------
+
+    {
+      auto chain_file = std::make_shared<cbl::statistics::ChainFile>(file_chains, npar, nwalkers, seed);
+      sampler.sample_stretch_move_parallel(chain_file, chain_size, start, seed);
+    }
+
+
+    // ----------------------------------------------------------------
+    // ------- sample the first half of the chains, then resume -------
+    // ----------------------------------------------------------------
+
+    {
+      auto chain_file = std::make_shared<cbl::statistics::ChainFile>(file_resumed, npar, nwalkers, seed);
+      sampler.sample_stretch_move_parallel(chain_file, chain_size/2, start, seed);
+    }
+
+    {
+      // open the existing file: the sampling continues from its last step
+      auto chain_file = std::make_shared<cbl::statistics::ChainFile>(file_resumed);
+      sampler.sample_stretch_move_parallel(chain_file, chain_size, start, seed);
+    }
+
+
+    // --------------------------------------------------------------------------
+    // ------- the resumed chains are identical to the uninterrupted ones -------
+    // --------------------------------------------------------------------------
+
+    cbl::statistics::ChainFile chains(file_chains), resumed(file_resumed);
+
+    std::vector<std::vector<double>> chain_value, chain_value_resumed;
+    std::vector<double> function, function_resumed;
+
+    chains.read(chain_value, function);
+    resumed.read(chain_value_resumed, function_resumed);
+
+    std::cout << "The number of steps of the resumed chains is " << resumed.nsteps() << std::endl;
+
+    if (resumed.nsteps()!=chain_size || chain_value_resumed!=chain_value || function_resumed!=function)
+      cbl::ErrorCBL("the resumed chains are different from the uninterrupted ones!");
+
+
+    // ------------------------------------------------------------------
+    // ------- the chains cannot be resumed with a different seed -------
+    // ------------------------------------------------------------------
+
+    bool different_seed = false;
+
+    try {
+      auto chain_file = std::make_shared<cbl::statistics::ChainFile>(file_resumed);
+      sampler.sample_stretch_move_parallel(chain_file, 2*chain_size, start, seed+1);
+    }
+    catch(cbl::glob::Exception &) { different_seed = true; }
+
+    if (!different_seed)
+      cbl::ErrorCBL("the chains have been resumed with a different seed!");
+
+    remove(file_chains.c_str());
+    remove(file_resumed.c_str());
+
+  }
+
+  catch(cbl::glob::Exception &exc) { std::cerr << exc.what() << std::endl; exit(1); }
+
+  return 0;
+}
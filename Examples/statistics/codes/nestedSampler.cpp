@@ -0,0 +1,124 @@
+// ===================================================================
+// Example code: how to compute the Bayesian evidence and sample the
+// posterior with the nested sampler
+// ===================================================================
+
+#include "Data1D.h"
+#include "Posterior.h"
+
+// these two variables contain the name of the CosmoBolognaLib
+// directory and the name of the current directory (useful when
+// launching the code on remote systems)
+std::string cbl::par::DirCosmo = DIRCOSMO, cbl::par::DirLoc = DIRL;
+
+
+// =====================================================================
+
+
+// the sine model has 3 parameters: the amplitude A and the phase phi
+// are free parameters, D = A*cos(phi) is a derived parameter
+
+std::vector<double> sine_model (const std::vector<double> x, const std::shared_ptr<void> modelInput, std::vector<double> &parameter)
+{
+  (void)modelInput;
+
+  std::vector<double> model(x.size(), 0.);
+  for (size_t i=0; i<x.size(); ++i)
+    model[i] = parameter[0]*sin(x[i]+parameter[1]);
+
+  parameter[2] = parameter[0]*cos(parameter[1]);
+
+  return model;
+}
+
+
+// =====================================================================
+
+
+int main () {
+
+  try {
+
+    // ---------------------------------------------------------------
+    // ------- the evidence of a bimodal Gaussian distribution -------
+    // ---------------------------------------------------------------
+
+    // the likelihood is the sum of two normalised Gaussians in a
+    // uniform prior of area 100, so that the evidence is 1/100
+
+    const double sigma = 0.3, area = 100.;
+
+    auto log_likelihood = [&] (std::vector<double> &pp)
+      {
+	const double r1 = pow(pp[0]-2., 2)+pp[1]*pp[1], r2 = pow(pp[0]+2., 2)+pp[1]*pp[1];
+	return log(0.5*(exp(-0.5*r1/(sigma*sigma))+exp(-0.5*r2/(sigma*sigma)))/(2.*cbl::par::pi*sigma*sigma));
+      };
+
+    auto log_prior = [&] (std::vector<double> &pp)
+      { return (fabs(pp[0])<=5. && fabs(pp[1])<=5.) ? -log(area) : cbl::par::defaultDouble; };
+
+    cbl::random::UniformRandomNumbers ran(-5., 5., 3214);
+    auto prior_sample = [&] () { return std::vector<double> {ran(), ran()}; };
+
+    cbl::statistics::NestedSampler sampler(2, log_likelihood, log_prior, prior_sample);
+    sampler.sample(500, 0.1);
+
+    std::cout << "log(Z) = " << sampler.log_evidence() << " +/- " << sampler.log_evidence_error() << " (expected: " << -log(area) << ")" << std::endl;
+
+    if (fabs(sampler.log_evidence()+log(area))>5.*sampler.log_evidence_error())
+      cbl::ErrorCBL("the evidence of the bimodal distribution is wrong!");
+
+    // both the modes have to be sampled, with the same weight
+    std::vector<std::vector<double>> samples;
+    std::vector<double> logL;
+    sampler.get_equal_weighted_samples(samples, logL);
+
+    const double fraction = std::count_if(samples[0].begin(), samples[0].end(), [] (const double xx) { return xx>0.; })/double(samples[0].size());
+
+    std::cout << "The fraction of samples in the mode at x>0 is " << fraction << std::endl;
+
+    if (fraction<0.25 || fraction>0.75)
+      cbl::ErrorCBL("the two modes have not been sampled correctly!");
+
+
+    // -------------------------------------------------------------
+    // ------- fit a sine function, with a derived parameter -------
+    // -------------------------------------------------------------
+
+    const double A_true = 2., phi_true = 0.5, error = 0.1;
+
+    cbl::random::NormalRandomNumbers noise(0., error, 6543);
+
+    std::vector<double> xx(50), yy(50), ee(50, error);
+    for (size_t i=0; i<xx.size(); ++i) {
+      xx[i] = 2.*cbl::par::pi*i/xx.size();
+      yy[i] = A_true*sin(xx[i]+phi_true)+noise();
+    }
+
+    auto ptr_data = std::make_shared<cbl::data::Data1D>(cbl::data::Data1D(xx, yy, ee));
+
+    std::vector<cbl::statistics::ParameterType> parType = {cbl::statistics::ParameterType::_Base_, cbl::statistics::ParameterType::_Base_, cbl::statistics::ParameterType::_Derived_};
+    auto ptr_model = std::make_shared<cbl::statistics::Model1D>(cbl::statistics::Model1D(&sine_model, 3, parType, {"A", "phi", "D"}));
+
+    cbl::statistics::Likelihood likelihood(ptr_data, ptr_model, cbl::statistics::LikelihoodType::_Gaussian_Error_);
+
+    auto prior_A = std::make_shared<cbl::statistics::PriorDistribution>(cbl::statistics::PriorDistribution(cbl::glob::DistributionType::_Uniform_, 0., 5., 666));
+    auto prior_phi = std::make_shared<cbl::statistics::PriorDistribution>(cbl::statistics::PriorDistribution(cbl::glob::DistributionType::_Uniform_, -1.5, 1.5, 999));
+
+    cbl::statistics::Posterior posterior({prior_A, prior_phi}, likelihood, 696);
+
+    posterior.sample_nested(300);
+
+    const double A = posterior.parameters()->bestfit_value(0), phi = posterior.parameters()->bestfit_value(1), D = posterior.parameters()->bestfit_value(2);
+
+    std::cout << "A = " << A << ", phi = " << phi << ", D = " << D << std::endl;
+
+    if (fabs(A-A_true)>0.1 || fabs(phi-phi_true)>0.1 || fabs(D-A_true*cos(phi_true))>0.2)
+      cbl::ErrorCBL("the parameters of the sine function are wrong!");
+
+  }
+
+  catch(cbl::glob::Exception &exc) { std::cerr << exc.what() << std::endl; exit(1); }
+
+  return 0;
+}
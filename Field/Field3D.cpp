@@ -177,6 +177,119 @@ void cbl::data::Field3D::set_parameters (const int nx, const int ny, const int n
 // ============================================================================
 
 
+// the FFTW configuration and the plans, shared by all the fields; the FFTW planner is not
+// thread-safe, so they are accessed only inside the critical section fftw_planner
+
+static unsigned int fftw_planner_flag = FFTW_MEASURE;
+
+static int fftw_nThreads = 0;
+
+static std::string fftw_wisdom_file;
+
+static std::map<std::array<int, 4>, fftw_plan> fftw_plans;
+
+static bool fftw_threads ()
+{
+  // the threads are initialised once, before any call to the planner or to the wisdom functions
+  static const bool threads_init = (fftw_init_threads()!=0);
+  return threads_init;
+}
+
+static void fftw_destroy_plans ()
+{
+  for (auto &&plan : fftw_plans)
+    fftw_destroy_plan(plan.second);
+  fftw_plans.clear();
+}
+
+
+// ============================================================================
+
+
+void cbl::data::Field3D::set_FFTW_planner (const unsigned int planner_flag)
+{
+#pragma omp critical (fftw_planner)
+  {
+    fftw_planner_flag = planner_flag;
+    fftw_destroy_plans();
+  }
+}
+
+
+// ============================================================================
+
+
+void cbl::data::Field3D::set_FFTW_nThreads (const int nThreads)
+{
+#pragma omp critical (fftw_planner)
+  {
+    fftw_nThreads = nThreads;
+    fftw_destroy_plans();
+  }
+}
+
+
+// ============================================================================
+
+
+void cbl::data::Field3D::set_FFTW_wisdom (const std::string wisdom_file)
+{
+#pragma omp critical (fftw_planner)
+  {
+    fftw_threads();
+    fftw_wisdom_file = wisdom_file;
+    if (!fftw_wisdom_file.empty() && ifstream(fftw_wisdom_file.c_str()).good())
+      if (fftw_import_wisdom_from_filename(fftw_wisdom_file.c_str())==0)
+	WarningMsg("Attention in cbl::data::Field3D::set_FFTW_wisdom() of Field3D.cpp: the FFTW wisdom cannot be read from "+fftw_wisdom_file+"!");
+  }
+}
+
+
+// ============================================================================
+
+
+fftw_plan cbl::data::Field3D::m_FFTW_plan (const int nx, const int ny, const int nz, const bool forward)
+{
+  const array<int, 4> key = {nx, ny, nz, (forward) ? 1 : 0};
+  fftw_plan plan = nullptr;
+  
+#pragma omp critical (fftw_planner)
+  {
+    auto it = fftw_plans.find(key);
+
+    if (it!=fftw_plans.end()) plan = it->second;
+
+    else {
+      if (fftw_threads()) fftw_plan_with_nthreads((fftw_nThreads>0) ? fftw_nThreads : omp_get_max_threads());
+
+      // the planner overwrites the arrays when measuring, so the plans are created on
+      // temporary arrays, and then executed on the ones of the fields
+      
+      const size_t nCells = size_t(nx)*ny*nz, nCells_Fourier = size_t(nx)*ny*(nz/2+1);
+      double *field = fftw_alloc_real(nCells);
+      fftw_complex *field_FourierSpace = fftw_alloc_complex(nCells_Fourier);
+
+      plan = (forward) ? fftw_plan_dft_r2c_3d(nx, ny, nz, field, field_FourierSpace, fftw_planner_flag) : fftw_plan_dft_c2r_3d(nx, ny, nz, field_FourierSpace, field, fftw_planner_flag);
+
+      fftw_free(field);
+      fftw_free(field_FourierSpace);
+
+      if (plan!=nullptr) {
+	fftw_plans[key] = plan;
+	if (!fftw_wisdom_file.empty()) fftw_export_wisdom_to_filename(fftw_wisdom_file.c_str());
+      }
+    }
+  }
+
+  if (plan==nullptr) ErrorCBL("Error in cbl::data::Field3D::m_FFTW_plan() of Field3D.cpp: the FFTW plan cannot be created!");
+
+  return plan;
+}
+
+
+// ============================================================================
+
+
 cbl::data::ScalarField3D::ScalarField3D (const double deltaR, const double minX, const double maxX, const double minY, const double maxY, const double minZ, const double maxZ) : Field3D(deltaR, minX, maxX, minY, maxY, minZ, maxZ) 
 {
   m_field = fftw_alloc_real(m_nCells);
@@ -216,17 +329,9 @@ cbl::data::ScalarField3D::ScalarField3D (const int nx, const int ny, const int n
 
 void cbl::data::ScalarField3D::FourierTransformField () 
 {
-  
-  for (int i=0; i<m_nCells_Fourier; i++) {
-    m_field_FourierSpace[i][0] = 0;
-    m_field_FourierSpace[i][1] = 0;
-  }
-
-  fftw_plan real2complex;
-  real2complex = fftw_plan_dft_r2c_3d(m_nX, m_nY, m_nZ, m_field, m_field_FourierSpace, FFTW_ESTIMATE);
-  fftw_execute(real2complex);
-  fftw_destroy_plan(real2complex);
+  fftw_execute_dft_r2c(m_FFTW_plan(m_nX, m_nY, m_nZ, true), m_field, m_field_FourierSpace);
 
+#pragma omp parallel for schedule(static)
   for(int i=0;i<m_nCells_Fourier;i++){
     m_field_FourierSpace[i][0] = m_field_FourierSpace[i][0]/m_nCells;
     m_field_FourierSpace[i][1] = m_field_FourierSpace[i][1]/m_nCells;
@@ -240,14 +345,7 @@ void cbl::data::ScalarField3D::FourierTransformField ()
 
 void cbl::data::ScalarField3D::FourierAntiTransformField () 
 {
-  for (int i=0; i<m_nCells; i++)
-    m_field[i] = 0;
-
-  fftw_plan complex2real;
-  complex2real = fftw_plan_dft_c2r_3d(m_nX, m_nY, m_nZ, m_field_FourierSpace, m_field, FFTW_ESTIMATE);
-  fftw_execute(complex2real);
-  fftw_destroy_plan(complex2real);
-
+  fftw_execute_dft_c2r(m_FFTW_plan(m_nX, m_nY, m_nZ, false), m_field_FourierSpace, m_field);
 }
 
 
@@ -286,6 +384,178 @@ void cbl::data::ScalarField3D::GaussianConvolutionField (const double kernel_siz
 // ============================================================================
 
 
+double cbl::data::Field3D::window_mass_assignment (const int i, const int j, const int k, const int assignment_type) const
+{
+  auto sinc = [] (const double xx) { return (fabs(xx)<1.e-10) ? 1. : sin(xx)/xx; };
+
+  return pow(sinc(0.5*m_kX[i]*m_deltaX)*sinc(0.5*m_kY[j]*m_deltaY)*sinc(0.5*m_kZ[k]*m_deltaZ), assignment_type+1);
+}
+
+
+// ============================================================================
+
+
+// get the weights of the mass assignment along one axis: the object, whose distance from the
+// centre of the first cell is uu (in units of the cell size), is assigned to the cells
+// first, ..., first+order-1, where first is the returned value
+
+static int mass_assignment_weights (const double uu, const int order, double *ww)
+{
+  if (order==1) {
+    ww[0] = 1.;
+    return int(floor(uu+0.5));
+  }
+
+  else if (order==2) {
+    const int first = floor(uu);
+    const double dd = uu-first;
+    ww[0] = 1.-dd;
+    ww[1] = dd;
+    return first;
+  }
+
+  else if (order==3) {
+    const int centre = floor(uu+0.5);
+    const double dd = uu-centre;
+    ww[0] = 0.5*(0.5-dd)*(0.5-dd);
+    ww[1] = 0.75-dd*dd;
+    ww[2] = 0.5*(0.5+dd)*(0.5+dd);
+    return centre-1;
+  }
+
+  const int first = floor(uu);
+  const double dd = uu-first, td = 1.-dd;
+  ww[0] = td*td*td/6.;
+  ww[1] = (4.-6.*dd*dd+3.*dd*dd*dd)/6.;
+  ww[2] = (4.-6.*td*td+3.*td*td*td)/6.;
+  ww[3] = dd*dd*dd/6.;
+  return first-1;
+}
+
+
+// ============================================================================
+
+
+void cbl::data::ScalarField3D::m_assign_mass (const std::vector<double> &xx, const std::vector<double> &yy, const std::vector<double> &zz, const std::vector<double> &weight, const int order, const double shift, double *field) const
+{
+  const int nn[3] = {m_nX, m_nY, m_nZ};
+  const double min[3] = {m_MinX, m_MinY, m_MinZ};
+  const double delta_inv[3] = {1./m_deltaX, 1./m_deltaY, 1./m_deltaZ};
+  const bool weighted = (weight.size()>0);
+
+#pragma omp parallel for schedule(static)
+  for (size_t obj=0; obj<xx.size(); ++obj) {
+
+    const double pos[3] = {xx[obj], yy[obj], zz[obj]};
+    double ww[3][4];
+    int cell[3][4];
+    
+    for (int axis=0; axis<3; ++axis) {
+      const int first = mass_assignment_weights((pos[axis]-min[axis])*delta_inv[axis]-0.5+shift, order, ww[axis]);
+      for (int c=0; c<order; ++c)
+	cell[axis][c] = (((first+c)%nn[axis])+nn[axis])%nn[axis];
+    }
+
+    const double wobj = (weighted) ? weight[obj] : 1.;
+
+    for (int a=0; a<order; ++a)
+      for (int b=0; b<order; ++b) {
+	const double wab = wobj*ww[0][a]*ww[1][b];
+	for (int c=0; c<order; ++c) {
+#pragma omp atomic
+	  field[inds_to_index(cell[0][a], cell[1][b], cell[2][c])] += wab*ww[2][c];
+	}
+      }
+  }
+}
+
+
+// ============================================================================
+
+
+void cbl::data::ScalarField3D::assign_mass (const std::vector<double> &xx, const std::vector<double> &yy, const std::vector<double> &zz, const std::vector<double> &weight, const int assignment_type, const bool interlacing, const bool compensate)
+{
+  if (yy.size()!=xx.size() || zz.size()!=xx.size() || (weight.size()>0 && weight.size()!=xx.size()))
+    ErrorCBL("Error in cbl::data::ScalarField3D::assign_mass() of Field3D.cpp: the coordinates and the weights must have the same size!");
+
+  if (assignment_type<0 || assignment_type>3)
+    ErrorCBL("Error in cbl::data::ScalarField3D::assign_mass() of Field3D.cpp: the mass assignment scheme must be 0 (NGP), 1 (CIC), 2 (TSC) or 3 (PCS)!");
+
+  const int order = assignment_type+1;
+  
+  for (int i=0; i<m_nCells; i++)
+    m_field[i] = 0;
+
+  m_assign_mass(xx, yy, zz, weight, order, 0., m_field);
+
+  if (!interlacing && !compensate) return;
+
+  FourierTransformField();
+
+  
+  // interlacing: the objects are shifted by half a cell, and the phase of the shifted field is
+  // corrected before averaging it with the original one, so that the odd images cancel out
+  
+  if (interlacing) {
+    vector<array<double, 2>> field_FourierSpace(m_nCells_Fourier);
+    for (int i=0; i<m_nCells_Fourier; i++)
+      field_FourierSpace[i] = {m_field_FourierSpace[i][0], m_field_FourierSpace[i][1]};
+
+    for (int i=0; i<m_nCells; i++)
+      m_field[i] = 0;
+    
+    m_assign_mass(xx, yy, zz, weight, order, 0.5, m_field);
+
+    FourierTransformField();
+
+#pragma omp parallel for schedule(static)
+    for (int i=0; i<m_nX; i++)
+      for (int j=0; j<m_nY; j++)
+	for (int k=0; k<m_nZF; k++) {
+	  const double phase = 0.5*(m_kX[i]*m_deltaX+m_kY[j]*m_deltaY+m_kZ[k]*m_deltaZ);
+	  const double cc = cos(phase), ss = sin(phase);
+	  const long int index = inds_to_index_Fourier(i, j, k);
+	  const double re = m_field_FourierSpace[index][0], im = m_field_FourierSpace[index][1];
+	  m_field_FourierSpace[index][0] = 0.5*(field_FourierSpace[index][0]+re*cc-im*ss);
+	  m_field_FourierSpace[index][1] = 0.5*(field_FourierSpace[index][1]+re*ss+im*cc);
+	}
+  }
+
+  
+  // compensation: the window function of the mass assignment is the product, along the three
+  // axes, of sinc(k*delta/2)^order
+  
+  if (compensate) {
+#pragma omp parallel for schedule(static)
+    for (int i=0; i<m_nX; i++)
+      for (int j=0; j<m_nY; j++)
+	for (int k=0; k<m_nZF; k++) {
+	  const double window = window_mass_assignment(i, j, k, assignment_type);
+	  const long int index = inds_to_index_Fourier(i, j, k);
+	  m_field_FourierSpace[index][0] /= window;
+	  m_field_FourierSpace[index][1] /= window;
+	}
+  }
+
+  
+  // the anti-transform overwrites the field in Fourier space, that is then restored
+  
+  vector<array<double, 2>> field_FourierSpace(m_nCells_Fourier);
+  for (int i=0; i<m_nCells_Fourier; i++)
+    field_FourierSpace[i] = {m_field_FourierSpace[i][0], m_field_FourierSpace[i][1]};
+
+  FourierAntiTransformField();
+
+  for (int i=0; i<m_nCells_Fourier; i++) {
+    m_field_FourierSpace[i][0] = field_FourierSpace[i][0];
+    m_field_FourierSpace[i][1] = field_FourierSpace[i][1];
+  }
+}
+
+
+// ============================================================================
+
+
 void cbl::data::ScalarField3D::set_ScalarField (const double value, const int i, const int j, const int k, const bool add)
 {
   m_field[inds_to_index(i,j,k)] = (add) ? m_field[inds_to_index(i,j,k)] + value : value;
@@ -448,30 +718,12 @@ cbl::data::VectorField3D::VectorField3D (const int nx, const int ny, const int n
 
 void cbl::data::VectorField3D::FourierTransformField () 
 {
+  const fftw_plan real2complex = m_FFTW_plan(m_nX, m_nY, m_nZ, true);
+  
+  for (size_t cc=0; cc<m_field.size(); cc++)
+    fftw_execute_dft_r2c(real2complex, m_field[cc], m_field_FourierSpace[cc]);
 
-  for(int i=0;i<m_nCells_Fourier;i++){
-    m_field_FourierSpace[0][i][0] = 0;
-    m_field_FourierSpace[0][i][1] = 0;
-    m_field_FourierSpace[1][i][0] = 0;
-    m_field_FourierSpace[1][i][1] = 0;
-    m_field_FourierSpace[2][i][0] = 0;
-    m_field_FourierSpace[2][i][1] = 0;
-  }
-
-  fftw_plan real2complex;
-
-  real2complex = fftw_plan_dft_r2c_3d(m_nX, m_nY, m_nZ, m_field[0], m_field_FourierSpace[0], FFTW_ESTIMATE);
-  fftw_execute(real2complex);
-  fftw_destroy_plan(real2complex);
-
-  real2complex = fftw_plan_dft_r2c_3d(m_nX, m_nY, m_nZ, m_field[1], m_field_FourierSpace[1], FFTW_ESTIMATE);
-  fftw_execute(real2complex);
-  fftw_destroy_plan(real2complex);
-
-  real2complex = fftw_plan_dft_r2c_3d(m_nX, m_nY, m_nZ, m_field[2], m_field_FourierSpace[2], FFTW_ESTIMATE);
-  fftw_execute(real2complex);
-  fftw_destroy_plan(real2complex);
-
+#pragma omp parallel for schedule(static)
   for(int i=0;i<m_nCells_Fourier;i++){
     m_field_FourierSpace[0][i][0] = m_field_FourierSpace[0][i][0]/m_nCells;
     m_field_FourierSpace[0][i][1] = m_field_FourierSpace[0][i][1]/m_nCells;
@@ -489,26 +741,10 @@ void cbl::data::VectorField3D::FourierTransformField ()
 
 void cbl::data::VectorField3D::FourierAntiTransformField () 
 {
-  for (int i=0; i<m_nCells; i++) {
-    m_field[0][i] = 0;
-    m_field[1][i] = 0;
-    m_field[2][i] = 0;
-  }
-
-  fftw_plan complex2real;
-
-  complex2real = fftw_plan_dft_c2r_3d(m_nX, m_nY, m_nZ, m_field_FourierSpace[0], m_field[0], FFTW_ESTIMATE);
-  fftw_execute(complex2real);
-  fftw_destroy_plan(complex2real);
-
-  complex2real = fftw_plan_dft_c2r_3d(m_nX, m_nY, m_nZ, m_field_FourierSpace[1], m_field[1], FFTW_ESTIMATE);
-  fftw_execute(complex2real);
-  fftw_destroy_plan(complex2real);
+  const fftw_plan complex2real = m_FFTW_plan(m_nX, m_nY, m_nZ, false);
   
-  complex2real = fftw_plan_dft_c2r_3d(m_nX, m_nY, m_nZ, m_field_FourierSpace[2], m_field[2], FFTW_ESTIMATE);
-  fftw_execute(complex2real);
-  fftw_destroy_plan(complex2real);
-
+  for (size_t cc=0; cc<m_field.size(); cc++)
+    fftw_execute_dft_c2r(complex2real, m_field_FourierSpace[cc], m_field[cc]);
 }
 
 
@@ -42,7 +42,7 @@ using namespace cbl;
 // ============================================================================
 
 
-void cbl::reconstruction_fourier_space (const catalogue::Catalogue data, const catalogue::Catalogue random, const bool random_RSD, const cosmology::Cosmology cosmology, const double redshift, const double bias, const double cell_size, const double smoothing_radius, const int interpolation_type)
+void cbl::reconstruction_fourier_space (catalogue::Catalogue data, catalogue::Catalogue random, const bool random_RSD, const cosmology::Cosmology cosmology, const double redshift, const double bias, const double cell_size, const double smoothing_radius, const int interpolation_type)
 {
   double ff = cosmology.linear_growth_rate(redshift);
   double beta = ff/bias;
@@ -113,6 +113,8 @@ void cbl::reconstruction_fourier_space (const catalogue::Catalogue data, const c
   
   // set the displacement
 
+  vector<vector<double>> data_displacement(3, vector<double>(data.nObjects()));
+  
   for (size_t i=0; i<data.nObjects(); i++) {
     int i1 = min(int((data.xx(i)-density_field.MinX())/density_field.deltaX()), density_field.nx()-1);
     int j1 = min(int((data.yy(i)-density_field.MinY())/density_field.deltaY()), density_field.ny()-1);
@@ -120,11 +122,15 @@ void cbl::reconstruction_fourier_space (const catalogue::Catalogue data, const c
 
     vector<double> displacement = displacement_field_RSD.VectorField(i1, j1, k1);
 
-    data.catalogue_object(i)->set_x_displacement(displacement[0]);
-    data.catalogue_object(i)->set_y_displacement(displacement[1]);
-    data.catalogue_object(i)->set_z_displacement(displacement[2]);
+    for (int k=0; k<3; k++) data_displacement[k][i] = displacement[k];
   }
 
+  data.set_var(catalogue::Var::_X_displacement_, data_displacement[0]);
+  data.set_var(catalogue::Var::_Y_displacement_, data_displacement[1]);
+  data.set_var(catalogue::Var::_Z_displacement_, data_displacement[2]);
+
+  vector<vector<double>> random_displacement(3, vector<double>(random.nObjects()));
+  
   for (size_t i=0; i<random.nObjects(); i++) {
     int i1 = min(int((random.xx(i)-density_field.MinX())/density_field.deltaX()), density_field.nx()-1);
     int j1 = min(int((random.yy(i)-density_field.MinY())/density_field.deltaY()), density_field.ny()-1);
@@ -132,10 +138,12 @@ void cbl::reconstruction_fourier_space (const catalogue::Catalogue data, const c
 
     vector<double> displacement = (random_RSD) ? displacement_field_RSD.VectorField(i1, j1, k1) : displacement_field.VectorField(i1, j1, k1);
 
-    random.catalogue_object(i)->set_x_displacement(displacement[0]);
-    random.catalogue_object(i)->set_y_displacement(displacement[1]);
-    random.catalogue_object(i)->set_z_displacement(displacement[2]);
+    for (int k=0; k<3; k++) random_displacement[k][i] = displacement[k];
   }
+
+  random.set_var(catalogue::Var::_X_displacement_, random_displacement[0]);
+  random.set_var(catalogue::Var::_Y_displacement_, random_displacement[1]);
+  random.set_var(catalogue::Var::_Z_displacement_, random_displacement[2]);
 }
 
 
@@ -148,21 +156,20 @@ cbl::catalogue::Catalogue cbl::displaced_catalogue (const catalogue::Catalogue i
 
   // apply the displacements
 
+  vector<double> xx = displaced_cat.var(catalogue::Var::_X_);
+  vector<double> yy = displaced_cat.var(catalogue::Var::_Y_);
+  vector<double> zz = displaced_cat.var(catalogue::Var::_Z_);
+  
   for (size_t i=0; i<displaced_cat.nObjects(); i++) {
-    
-    double xx = displaced_cat.xx(i);
-    double yy = displaced_cat.yy(i);
-    double zz = displaced_cat.zz(i);
-
-    double x_displ = displaced_cat.x_displacement(i);
-    double y_displ = displaced_cat.y_displacement(i);
-    double z_displ = displaced_cat.z_displacement(i);
-
-    displaced_cat.catalogue_object(i)->set_xx(xx+x_displ);
-    displaced_cat.catalogue_object(i)->set_yy(yy+y_displ);
-    displaced_cat.catalogue_object(i)->set_zz(zz+z_displ);
+    xx[i] += displaced_cat.x_displacement(i);
+    yy[i] += displaced_cat.y_displacement(i);
+    zz[i] += displaced_cat.z_displacement(i);
   }
 
+  displaced_cat.set_var(catalogue::Var::_X_, xx);
+  displaced_cat.set_var(catalogue::Var::_Y_, yy);
+  displaced_cat.set_var(catalogue::Var::_Z_, zz);
+
   displaced_cat.computePolarCoordinates();
 
   return displaced_cat;
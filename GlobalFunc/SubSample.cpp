@@ -32,6 +32,7 @@
  */
 
 #include "GlobalFunc.h"
+#include "MangleMask.h"
 
 using namespace std;
 
@@ -41,6 +42,76 @@ using namespace cbl;
 // ============================================================================
 
 
+/// @cond glob
+
+namespace cbl {
+
+  /**
+   *  @brief get the mangle polygons that contain the objects of a
+   *  catalogue
+   *  @param cat the catalogue
+   *  @param mask the mangle mask
+   *  @return vector containing the polygon identification numbers
+   */
+  static std::vector<long> mangle_polygons (const catalogue::Catalogue &cat, const catalogue::MangleMask &mask)
+  {
+    const vector<long> polygon = mask.polygon(cat.var(catalogue::Var::_RA_), cat.var(catalogue::Var::_Dec_));
+
+    for (auto &&pp : polygon)
+      if (pp<0) ErrorCBL("Error in cbl::set_ObjectRegion_mangle() of SubSample.cpp: some objects are outside the mask!");
+    
+    return polygon;
+  }
+
+  /**
+   *  @brief divide a list of mangle polygons in sub-regions with a
+   *  similar number of polygons
+   *  @param polygon the polygons of the objects
+   *  @param nSamples the number of sub-regions
+   *  @return vector containing the first polygon of each sub-region,
+   *  and a value greater than the last polygon
+   */
+  static std::vector<long> mangle_boundaries (const std::vector<long> &polygon, const int nSamples)
+  {
+    const vector<long> poly_list = different_elements(polygon);
+    const int nPoly = poly_list.size();
+
+    vector<long> boundaries(nSamples+1, 0);
+    boundaries[0] = poly_list[0]; boundaries[nSamples] = poly_list[nPoly-1]+100;
+
+    for (int i=1; i<nSamples; i++)
+      boundaries[i] = poly_list[i*int(nPoly/(nSamples))];
+
+    return boundaries;
+  }
+
+  /**
+   *  @brief set the regions of the objects of a catalogue from
+   *  their mangle polygons
+   *  @param cat the catalogue
+   *  @param polygon the polygons of the objects
+   *  @param boundaries the first polygon of each sub-region, and a
+   *  value greater than the last polygon
+   *  @return none
+   */
+  static void set_ObjectRegion_polygons (catalogue::Catalogue &cat, const std::vector<long> &polygon, const std::vector<long> &boundaries)
+  {
+    const long nSamples = boundaries.size()-1;
+    
+    for (size_t j=0; j<polygon.size(); j++) {
+      const long region = upper_bound(boundaries.begin(), boundaries.end(), polygon[j])-boundaries.begin()-1;
+      if (region>=0 && region<nSamples) cat.set_region(j, region);
+    }
+  }
+  
+}
+
+/// @endcond
+
+
+// ============================================================================
+
+
 void cbl::set_ObjectRegion_SubBoxes (catalogue::Catalogue &data, const int nx, const int ny, const int nz)
 {
   const double xMin = data.Min(catalogue::Var::_X_);
@@ -51,6 +122,9 @@ void cbl::set_ObjectRegion_SubBoxes (catalogue::Catalogue &data, const int nx, c
   const double Cell_Y = (data.Max(catalogue::Var::_Y_)-yMin)/ny;
   const double Cell_Z = (data.Max(catalogue::Var::_Z_)-zMin)/nz;
 
+  // the regions are computed in parallel and set at once, so that the statistics of the catalogue are discarded only once
+  vector<long> region(data.nObjects());
+  
 #pragma omp parallel num_threads(omp_get_max_threads())
   {
     
@@ -59,10 +133,11 @@ void cbl::set_ObjectRegion_SubBoxes (catalogue::Catalogue &data, const int nx, c
       const int i1 = min(int((data.xx(i)-xMin)/Cell_X), nx-1);
       const int j1 = min(int((data.yy(i)-yMin)/Cell_Y), ny-1);
       const int z1 = min(int((data.zz(i)-zMin)/Cell_Z), nz-1);
-      const int index = z1+nz*(j1+ny*i1);
-      data.catalogue_object(i)->set_region(index);
+      region[i] = z1+nz*(j1+ny*i1);
     }
   }
+
+  data.set_region(region);
 }
 
 
@@ -71,63 +146,9 @@ void cbl::set_ObjectRegion_SubBoxes (catalogue::Catalogue &data, const int nx, c
 
 void cbl::set_ObjectRegion_mangle (catalogue::Catalogue &data, const int nSamples, const std::string polygonfile)
 {
-  string mangle_dir = fullpath(par::DirCosmo)+"/External/mangle/";
-
-  string mangle_working_dir = mangle_dir+"output/";
-  string mkdir = "mkdir -p "+mangle_working_dir;
-  if (system(mkdir.c_str())) {} 
-
-  string out_cat = mangle_working_dir+"data.dat";
-  string out_ran = mangle_working_dir+"ran.dat";
-
-  ofstream fout(out_cat.c_str()); checkIO(fout, out_cat); fout.precision(10);
+  const vector<long> poly_data = mangle_polygons(data, catalogue::MangleMask({polygonfile}));
   
-  for (size_t i=0; i<data.nObjects(); i++)
-    fout << data.ra(i) << " " << data.dec(i) << endl;
-  fout.clear(); fout.close();
-  
-  string cmd = mangle_dir+"bin/polyid -ur "+polygonfile+" "+out_cat+" "+out_cat+".id";
-  if (system(cmd.c_str())) {}
-   
-  vector<int> poly_data, poly_list;
-
-  string line;
-  string in_cat = out_cat+".id";
-
-  ifstream fin(in_cat.c_str()); checkIO(fin, in_cat); 
-  getline(fin, line);
-  while (getline(fin, line)) {
-    stringstream ss(line); double NUM; int pp=-100;
-    ss >> NUM; 
-    ss >> NUM; 
-    ss >> pp;
-    if (pp==-100) ErrorCBL("Error in cbl::set_ObjectRegion_mangle()!");
-    poly_data.push_back(pp);
-  }
-  fin.clear(); fin.close();
-
-  vector<int>::iterator it = poly_list.begin();
-  sort(poly_list.begin(), poly_list.end());
-  it = unique(poly_list.begin(), poly_list.end());
-  poly_list.resize(distance(poly_list.begin(), it));
-
-  int nPoly = poly_list.size();
-
-  vector<int> boundaries(nSamples+1, 0);
-  boundaries[0] = Min(poly_list); boundaries[nSamples] = Max(poly_list)+100;
-
-  for (int i=1; i<nSamples; i++)
-    boundaries[i] = poly_list[i*int(nPoly/(nSamples))];
- 
-  for (size_t i=1; i<boundaries.size(); i++) {
-    for (size_t j=0; j<poly_data.size(); j++) 
-      if (poly_data[j]>=boundaries[i-1] && poly_data[j] <boundaries[i])
-	data.catalogue_object(j)->set_region(i-1);
-  }
-  
-  string RM = "rm -rf "+mangle_working_dir;
-  if (system(RM.c_str())) {}
-
+  set_ObjectRegion_polygons(data, poly_data, mangle_boundaries(poly_data, nSamples));
 }
 
 
@@ -174,6 +195,7 @@ void cbl::set_ObjectRegion_RaDec (catalogue::Catalogue &data, const double Cell_
     cells.push_back(vv);
   }
 
+  vector<long> region(data.nObjects());
   
 #pragma omp parallel num_threads(omp_get_max_threads())
   {
@@ -182,10 +204,12 @@ void cbl::set_ObjectRegion_RaDec (catalogue::Catalogue &data, const double Cell_
     for (size_t i=0; i<data.nObjects(); i++) {
       int j1 = min(int((data_y[i]-Lim[2])/Cell_sz), nDec-1);
       int i1 = min(int((data_x[i]-Lim[0])/cell_size_x[j1]), n_cells_x[j1]-1);
-      data.catalogue_object(i)->set_region(cells[j1][i1]);
+      region[i] = cells[j1][i1];
     }
 
   }
+
+  data.set_region(region);
 }
 
 
@@ -203,6 +227,9 @@ void cbl::set_ObjectRegion_SubBoxes (catalogue::Catalogue &data, catalogue::Cata
   const double Cell_Y = (data.Max(catalogue::Var::_Y_)-yMin)/ny;
   const double Cell_Z = (data.Max(catalogue::Var::_Z_)-zMin)/nz;
 
+  // the regions are computed in parallel and set at once, so that the statistics of the catalogues are discarded only once
+  vector<long> data_region(data.nObjects()), random_region(random.nObjects());
+  
 #pragma omp parallel num_threads(omp_get_max_threads())
   {
     
@@ -211,8 +238,7 @@ void cbl::set_ObjectRegion_SubBoxes (catalogue::Catalogue &data, catalogue::Cata
       const int i1 = min(int((data.xx(i)-xMin)/Cell_X), nx-1);
       const int j1 = min(int((data.yy(i)-yMin)/Cell_Y), ny-1);
       const int z1 = min(int((data.zz(i)-zMin)/Cell_Z), nz-1);
-      const int index = z1+nz*(j1+ny*i1);
-      data.catalogue_object(i)->set_region(index);
+      data_region[i] = z1+nz*(j1+ny*i1);
     }
 
 #pragma omp for schedule(static, 2) 
@@ -220,11 +246,13 @@ void cbl::set_ObjectRegion_SubBoxes (catalogue::Catalogue &data, catalogue::Cata
       const int i1 = min(int((random.xx(i)-xMin)/Cell_X), nx-1);
       const int j1 = min(int((random.yy(i)-yMin)/Cell_Y), ny-1);
       const int z1 = min(int((random.zz(i)-zMin)/Cell_Z), nz-1);
-      const int index = z1+nz*(j1+ny*i1);
-      random.catalogue_object(i)->set_region(index);
+      random_region[i] = z1+nz*(j1+ny*i1);
     }
   }
 
+  data.set_region(data_region);
+  random.set_region(random_region);
+
   cbl::check_regions(data, random);
 }
 
@@ -234,87 +262,16 @@ void cbl::set_ObjectRegion_SubBoxes (catalogue::Catalogue &data, catalogue::Cata
 
 void cbl::set_ObjectRegion_mangle (catalogue::Catalogue &data, catalogue::Catalogue &random, const int nSamples, const std::string polygonfile)
 {
-  string mangle_dir = fullpath(par::DirCosmo)+"/External/mangle/";
-
-  string mangle_working_dir = mangle_dir+"output/";
-  string mkdir = "mkdir -p "+mangle_working_dir;
-  if (system(mkdir.c_str())) {} 
-
-  string out_cat = mangle_working_dir+"data.dat";
-  string out_ran = mangle_working_dir+"ran.dat";
-
-  ofstream fout(out_cat.c_str()); checkIO(fout, out_cat); fout.precision(10);
-  
-  for (size_t i=0; i<data.nObjects(); i++)
-    fout << data.ra(i) << " " << data.dec(i) << endl;
-  fout.clear(); fout.close();
-   
-  fout.open(out_ran.c_str()); checkIO(fout, out_ran);
-  for (size_t i=0; i<random.nObjects(); i++)
-    fout << random.ra(i) << " " << random.dec(i) << endl;
-  fout.clear(); fout.close();
+  const catalogue::MangleMask mask({polygonfile});
   
-  string cmd = mangle_dir+"bin/polyid -ur "+polygonfile+" "+out_cat+" "+out_cat+".id";
-  if (system(cmd.c_str())) {}
-  cmd = mangle_dir+"bin/polyid -ur "+polygonfile+" "+out_ran+" "+out_ran+".id";
-  if (system(cmd.c_str())) {}
-   
-  vector<int> poly_data, poly_random, poly_list;
-
-  string line;
-  string in_cat = out_cat+".id";
-  string in_ran = out_ran+".id";
-
-  ifstream fin(in_cat.c_str()); checkIO(fin, in_cat); 
-  getline(fin, line);
-  while (getline(fin, line)) {
-    stringstream ss(line); double NUM; int pp=-100;
-    ss >> NUM; 
-    ss >> NUM; 
-    ss >> pp;
-    if (pp==-100) ErrorCBL("Error in cbl::set_ObjectRegion_mangle()!");
-    poly_data.push_back(pp);
-  }
-  fin.clear(); fin.close();
-
-  fin.open(in_ran.c_str()); checkIO(fin, in_ran); 
-  getline(fin, line);
-  while (getline(fin, line)) {
-    stringstream ss(line); double NUM; int pp = -100;
-    ss >> NUM; 
-    ss >> NUM; 
-    ss >> pp;
-    if (pp==-100) ErrorCBL("Error in cbl::set_ObjectRegion_mangle()!");
-    poly_random.push_back(pp);
-    poly_list.push_back(pp);
-  }
-  fin.clear(); fin.close();
-
-  vector<int>::iterator it = poly_list.begin();
-  sort(poly_list.begin(), poly_list.end());
-  it = unique(poly_list.begin(), poly_list.end());
-  poly_list.resize(distance(poly_list.begin(), it));
-
-  int nPoly = poly_list.size();
+  const vector<long> poly_data = mangle_polygons(data, mask);
+  const vector<long> poly_random = mangle_polygons(random, mask);
 
-  vector<int> boundaries(nSamples+1, 0);
-  boundaries[0] = Min(poly_list); boundaries[nSamples] = Max(poly_list)+100;
-
-  for (int i=1; i<nSamples; i++)
-    boundaries[i] = poly_list[i*int(nPoly/(nSamples))];
- 
-  for (size_t i=1; i<boundaries.size(); i++) {
-    for (size_t j=0; j<poly_data.size(); j++) 
-      if (poly_data[j]>=boundaries[i-1] && poly_data[j] <boundaries[i])
-	data.catalogue_object(j)->set_region(i-1);
-    
-    for (size_t j=0; j<poly_random.size(); j++) 
-      if (poly_random[j]>=boundaries[i-1] && poly_random[j]<boundaries[i]) 
-	random.catalogue_object(j)->set_region(i-1);
-  }
+  // the sub-regions are defined by the polygons of the random objects
+  const vector<long> boundaries = mangle_boundaries(poly_random, nSamples);
   
-  string RM = "rm -rf "+mangle_working_dir;
-  if (system(RM.c_str())) {}
+  set_ObjectRegion_polygons(data, poly_data, boundaries);
+  set_ObjectRegion_polygons(random, poly_random, boundaries);
 
   cbl::check_regions(data, random);
 }
@@ -369,6 +326,7 @@ void cbl::set_ObjectRegion_RaDec (catalogue::Catalogue &data, catalogue::Catalog
     cells.push_back(vv);
   }
 
+  vector<long> data_region(data.nObjects()), random_region(random.nObjects());
   
 #pragma omp parallel num_threads(omp_get_max_threads())
   {
@@ -377,17 +335,20 @@ void cbl::set_ObjectRegion_RaDec (catalogue::Catalogue &data, catalogue::Catalog
     for (size_t i=0; i<data.nObjects(); i++) {
       int j1 = min(int((data_y[i]-Lim[2])/Cell_sz), nDec-1);
       int i1 = min(int((data_x[i]-Lim[0])/cell_size_x[j1]), n_cells_x[j1]-1);
-      data.catalogue_object(i)->set_region(cells[j1][i1]);
+      data_region[i] = cells[j1][i1];
     }
 
 #pragma omp for schedule(static, 2) 
     for (size_t i=0; i<random.nObjects(); i++) {
       int j1 = min(int((random_y[i]-Lim[2])/Cell_sz), nDec-1);
       int i1 = min(int((random_x[i]-Lim[0])/cell_size_x[j1]), n_cells_x[j1]-1);
-      random.catalogue_object(i)->set_region(cells[j1][i1]);
+      random_region[i] = cells[j1][i1];
     }
   }
 
+  data.set_region(data_region);
+  random.set_region(random_region);
+
   cbl::check_regions(data, random);
 }
 
@@ -424,17 +385,16 @@ void cbl::check_regions (catalogue::Catalogue &data, catalogue::Catalogue &rando
     for (size_t i=0; i<nRegions; ++i)
       regions[data_regions[i]] = (long)i;
       
-    for (size_t i=0; i<data.nObjects(); ++i) {
-      long region = data.catalogue_object(i)->region();
-      auto search = regions.find(region);
-      data.catalogue_object(i)->set_region(search->second);
-    }
+    vector<long> data_region = data.region(), random_region = random.region();
+    
+    for (auto &&region : data_region)
+      region = regions.find(region)->second;
       
-    for (size_t i=0; i<random.nObjects(); ++i) {
-      long region = random.catalogue_object(i)->region();
-      auto search = regions.find(region);
-      random.catalogue_object(i)->set_region(search->second);
-    } 
+    for (auto &&region : random_region)
+      region = regions.find(region)->second;
+
+    data.set_region(data_region);
+    random.set_region(random_region);
   }
 
 }
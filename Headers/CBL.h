@@ -8,6 +8,8 @@
 #include "Data2D.h"
 #include "Modelling_TwoPointCorrelation2D_cartesian.h"
 #include "Catalogue.h"
+#include "CatalogueView.h"
+#include "MangleMask.h"
 #include "NumberCounts2D.h"
 #include "ChainMesh_Catalogue.h"
 #include "Triplet1D.h"
@@ -63,6 +65,7 @@
 #include "TwoPointCorrelation2D_cartesian.h"
 #include "Modelling_TwoPointCorrelation_multipoles.h"
 #include "NumberCounts.h"
+#include "PowerSpectrum.h"
 #include "Likelihood.h"
 #include "Model2D.h"
 #include "Pair.h"
@@ -349,7 +349,10 @@ namespace cbl {
       _ascii_,
       
       /// Format binary file
-      _binary_
+      _binary_,
+
+      /// native columnar binary file, written by Catalogue::write_data
+      _columnar_
       
     };
 
@@ -360,7 +363,7 @@ namespace cbl {
      * CharEncode names
      */
     inline std::vector<std::string> CharEncodeNames ()
-    { return {"ascii", "binary"}; }
+    { return {"ascii", "binary", "columnar"}; }
     
     /**
      *  @enum EstimateCriterion
@@ -540,7 +543,122 @@ namespace cbl {
       /// catalogue mean particle separation
       double m_mps;
 
-      
+      /**
+       *  @struct VarStats
+       *  @brief the summary statistics of a catalogue variable
+       */
+      struct VarStats {
+
+	/// the minimum value of the variable
+	double min;
+
+	/// the maximum value of the variable
+	double max;
+
+	/// the sum of the values of the variable
+	double sum;
+
+	/// the number of modifications of the objects when the statistics have been computed
+	size_t modifications;
+	
+      };
+
+      /**
+       *  @struct RegionList
+       *  @brief the list of regions of a catalogue
+       */
+      struct RegionList {
+
+	/// the sorted list of regions
+	std::vector<long> list;
+
+	/// the number of modifications of the objects when the list has been computed
+	size_t modifications;
+	
+      };
+
+      /// the statistics of the catalogue variables, computed only when required
+      mutable std::array<std::shared_ptr<const VarStats>, static_cast<size_t>(Var::_Generic_)+1> m_var_stats;
+
+      /// the list of regions, computed only when required
+      mutable std::shared_ptr<const RegionList> m_region_list;
+
+      /**
+       *  @brief get the statistics of a catalogue variable,
+       *  computing them at the first call
+       *
+       *  the copies of a catalogue share its objects, so the
+       *  statistics are computed again also if the objects have been
+       *  modified through any other catalogue
+       *
+       *  @param var_name the variable name
+       *  @return pointer to the statistics of the variable
+       */
+      std::shared_ptr<const VarStats> m_stats (const Var var_name) const;
+
+      /**
+       *  @brief get the list of regions, computing it at the first
+       *  call
+       *  @return pointer to the sorted list of regions
+       */
+      std::shared_ptr<const std::vector<long>> m_regions () const;
+
+      /**
+       *  @brief update the statistics already computed with the
+       *  objects added at the end of the catalogue
+       *  @param first the index of the first added object
+       *  @return none
+       */
+      void m_update_stats (const size_t first);
+
+      /**
+       *  @brief discard the statistics, that will be computed again
+       *  when required
+       *
+       *  this function has to be called by every method that
+       *  modifies the values of the object variables, or that
+       *  removes objects; since the objects can be shared by
+       *  different catalogues, it also invalidates the statistics of
+       *  all the other catalogues
+       *
+       *  @return none
+       */
+      void m_reset_stats ();
+
+      /**
+       *  @brief read the objects from ASCII files
+       *
+       *  the files are memory-mapped and split in chunks of lines of
+       *  fixed size, that are parsed in parallel; the random
+       *  subsampling of each chunk uses its own seed, so that the
+       *  selected objects do not depend on the number of threads
+       *
+       *  @param objectType the object type
+       *  @param coordinateType the coordinate type
+       *  @param file vector containing the files where the input
+       *  catalogues are stored
+       *  @param col1 column of the input file containing the first
+       *  coordinate
+       *  @param col2 column of the input file containing the second
+       *  coordinate
+       *  @param col3 column of the input file containing the third
+       *  coordinate
+       *  @param colWeight column of the input file containing the
+       *  weights
+       *  @param colRegion column of the input file containing the
+       *  regions
+       *  @param nSub the fracton of objects that will be randomly
+       *  selected
+       *  @param fact a factor used to multiply the coordinates
+       *  @param cosm object of class Cosmology
+       *  @param inputUnits the units of the input coordinates
+       *  @param comment the string used to indicate a comment
+       *  @param seed the seed for random number generation
+       *  @return none
+       */
+      void m_read_ascii (const ObjectType objectType, const CoordinateType coordinateType, const std::vector<std::string> file, const int col1, const int col2, const int col3, const int colWeight, const int colRegion, const double nSub, const double fact, const cosmology::Cosmology &cosm, const CoordinateUnits inputUnits, const std::string comment, const int seed);
+
+
       /**
        *  @name private variables and functions used to read catalogues from standard GADGET files
        */
@@ -626,7 +744,28 @@ namespace cbl {
        *  @return object of class Catalogue
        */
       Catalogue (const Catalogue &cat)
-	: m_object(cat.sample()), m_index(cat.index()) {}
+	: m_object(cat.m_object), m_index(cat.m_index) {}
+
+      /**
+       *  @brief default move constructor
+       *  @param cat object of class Catalogue
+       *  @return object of class Catalogue
+       */
+      Catalogue (Catalogue &&cat) = default;
+
+      /**
+       *  @brief default copy assignment
+       *  @param cat object of class Catalogue
+       *  @return object of class Catalogue
+       */
+      Catalogue & operator= (const Catalogue &cat) = default;
+
+      /**
+       *  @brief default move assignment
+       *  @param cat object of class Catalogue
+       *  @return object of class Catalogue
+       */
+      Catalogue & operator= (Catalogue &&cat) = default;
       
       /**
        *  @brief constructor
@@ -730,7 +869,11 @@ namespace cbl {
        *  @param inputUnits the units of the input coordinates
        *
        *  @param charEncode character encoding of input file,
-       *  ascii or binary
+       *  ascii, binary or columnar; in the latter case, the columns
+       *  are identified by the catalogue variables stored in the
+       *  file, so col1, col2, col3, colWeight, colRegion and
+       *  inputUnits are not used, and fact multiplies only the
+       *  comoving coordinates
        *
        *  @param comment the string used to indicate a comment in the
        *  input file; all the data occurring on a line after a comment
@@ -861,10 +1004,8 @@ namespace cbl {
        *  in the cbl::catalogue::ObjectType enumeration
        *  @return object of class Catalogue
        */
-      Catalogue (std::vector<std::shared_ptr<Object> > sample) {
-	for (auto &&i : sample)
-	  m_object.push_back(move(i));
-      }
+      Catalogue (std::vector<std::shared_ptr<Object> > sample)
+	: m_object(std::move(sample)) {}
 
       /**
        *  @brief constructor, reading a file with attributes of the
@@ -1421,7 +1562,7 @@ namespace cbl {
        *
        *  @return the list of regions 
        */
-      std::vector<long> region_list () const { return different_elements(region()); }
+      std::vector<long> region_list () const { return *m_regions(); }
 
       /**
        *  @brief get the total number of regions by which the
@@ -1429,7 +1570,7 @@ namespace cbl {
        *
        *  @return the total number of regions
        */
-      size_t nRegions () const { return N_different_elements(region()); }
+      size_t nRegions () const { return m_regions()->size(); }
       
       /**
        *  @brief get the list of fields where the objects have been
@@ -1605,10 +1746,15 @@ namespace cbl {
       /**
        * @brief get the minimum value of a variable of the catalogue
        * objects
+       *
+       * the statistics of each variable are computed at the first
+       * call and then kept until the catalogue is modified, so that
+       * the following calls do not depend on the number of objects
+       *
        * @param var_name the variable name
        * @return the minimum value of the variable
        */
-      double Min (const Var var_name) const { return cbl::Min(var(var_name)); }
+      double Min (const Var var_name) const { return m_stats(var_name)->min; }
 
       /**
        * @brief get the maximum value of a variable of the catalogue
@@ -1616,7 +1762,25 @@ namespace cbl {
        * @param var_name the variable name
        * @return the maximum value of the variable
        */
-      double Max (const Var var_name) const { return cbl::Max(var(var_name)); }
+      double Max (const Var var_name) const { return m_stats(var_name)->max; }
+
+      /**
+       * @brief get the sum of the values of a variable of the
+       * catalogue objects
+       * @param var_name the variable name
+       * @return the sum of the values of the variable
+       */
+      double Sum (const Var var_name) const { return m_stats(var_name)->sum; }
+
+      /**
+       * @brief get the box that contains all the objects of the
+       * catalogue
+       * @return vector containing the minimum and the maximum values
+       * of the comoving coordinates: {{xmin, ymin, zmin}, {xmax,
+       * ymax, zmax}}
+       */
+      std::vector<std::vector<double>> bounding_box () const
+      { return {{Min(Var::_X_), Min(Var::_Y_), Min(Var::_Z_)}, {Max(Var::_X_), Max(Var::_Y_), Max(Var::_Z_)}}; }
 
       /**
        * @brief get the mean, the median, the standard deviation, and
@@ -1708,6 +1872,23 @@ namespace cbl {
        */
       void set_region (const std::vector<long> region);
 
+      /**
+       * @brief set the region of an object
+       *
+       * the statistics of the catalogue are discarded at each call,
+       * so this function cannot be called by concurrent threads: in
+       * parallel loops, the regions have to be set with
+       * Catalogue::set_region(const std::vector<long>)
+       *
+       * @param index the index of the object
+       * @param region the region of the object
+       * @return none
+       */
+      void set_region (const int index, const long region) {
+	m_object[index]->set_region(region);
+	m_reset_stats();
+      }
+
       /**
        * @brief set a private variable
        * @param field vector containing the object fields
@@ -1744,6 +1925,7 @@ namespace cbl {
        */
       void set_satellite (const int index, const std::shared_ptr<Object> satellite={}) {
 	m_object[index]->set_satellite(satellite);
+	m_reset_stats();
       }
 
       /**
@@ -1754,6 +1936,7 @@ namespace cbl {
        */
       void set_satellites (const int index, const std::vector<std::shared_ptr<Object>> satellites={}) {
 	m_object[index]->set_satellites(satellites);
+	m_reset_stats();
       }
 
       /**
@@ -1820,7 +2003,7 @@ namespace cbl {
        * @param object pointer to an object of type \e Object
        * @return none
        */
-      void add_object (std::shared_ptr<Object> object) { m_object.push_back(move(object)); }
+      void add_object (std::shared_ptr<Object> object) { m_object.push_back(move(object)); m_update_stats(m_object.size()-1); }
 
       /**
        * @brief add one single object to the catalogue
@@ -1828,7 +2011,7 @@ namespace cbl {
        * @return none
        */
       template<typename T>
-	void add_object (T object) { m_object.push_back(move(std::make_shared<T>(T(object)))); }
+	void add_object (T object) { m_object.push_back(move(std::make_shared<T>(T(object)))); m_update_stats(m_object.size()-1); }
 
       /**
        * @brief add some objects to the catalogue
@@ -1836,8 +2019,10 @@ namespace cbl {
        * @return none
        */
       void add_objects (std::vector<std::shared_ptr<Object> > sample) { 
+	const size_t first = m_object.size();
 	for (auto &&i : sample)
 	  m_object.push_back(move(i));
+	m_update_stats(first);
       }
 
       /**
@@ -1859,6 +2044,7 @@ namespace cbl {
       template<typename T>
 	void replace_objects(std::vector<T> sample) {
 	m_object.erase(m_object.begin(), m_object.end());
+	m_reset_stats();
 	add_objects(sample);
       }
 
@@ -1869,6 +2055,7 @@ namespace cbl {
        */
       void replace_objects (std::vector<std::shared_ptr<Object> > sample) {
 	m_object.erase(m_object.begin(), m_object.end());
+	m_reset_stats();
 	for (auto &&i : sample)
 	  m_object.push_back(move(i));
       }
@@ -1877,14 +2064,14 @@ namespace cbl {
        * @brief remove all objects 
        * @return none
        */
-      void remove_objects () { m_object.erase(m_object.begin(), m_object.end()); }
+      void remove_objects () { m_object.erase(m_object.begin(), m_object.end()); m_reset_stats(); }
       
       /**
        * @brief remove an existing object
        * @param index the index of the object to be removed
        * @return none
        */
-      void remove_object (const int index) { m_object.erase(m_object.begin()+index); }
+      void remove_object (const int index) { m_object.erase(m_object.begin()+index); m_reset_stats(); }
       
       /**
        * @brief remove a set of existing objects
@@ -1910,6 +2097,9 @@ namespace cbl {
        *  @param increasing if true order from lower to higher, if
        *  false from higher to lower
        *
+       *  since the objects are only reordered, the statistics of the
+       *  catalogue variables are not computed again
+       *
        *  @return none
        */
       void sort (const Var var_name, const bool increasing=false);
@@ -2005,9 +2195,14 @@ namespace cbl {
        *  @param var_name vector containing the variable names to be
        *  written
        *
+       *  @param charEncode character encoding of the output file:
+       *  ascii or columnar; if columnar, by default the comoving and
+       *  polar coordinates (if set), the weights and the regions (if
+       *  set) are written
+       *
        *  @return none
        */
-      void write_data (const std::string outputFile, const std::vector<Var> var_name={}) const;
+      void write_data (const std::string outputFile, const std::vector<Var> var_name={}, const CharEncode charEncode=CharEncode::_ascii_) const;
       
       /**
        * @brief get the distrance between the i-th object of the
@@ -2137,8 +2332,9 @@ namespace cbl {
       /**
        *  @brief return the density field from object positions
        *  @param cell_size the minimum size of the density field
-       *  @param interpolation_type the type of interpolation false
-       *  &rarr; nearest-grid-point; true &rarr; cloud-in-cell
+       *  @param interpolation_type the mass assignment scheme: 0
+       *  &rarr; nearest-grid-point; 1 &rarr; cloud-in-cell; 2 &rarr;
+       *  triangular-shaped-cloud; 3 &rarr; piecewise cubic spline
        *  @param useMass generate the density field using the mass
        *  information
        *  @param minX minimum value of the x coordinate
@@ -2156,8 +2352,9 @@ namespace cbl {
        *  @param cell_size the minimum size of the density field
        *  @param mask_catalogue catalogue containing points sampling
        *  the selecion function of the catalogue
-       *  @param interpolation_type the type of interpolation false
-       *  &rarr; nearest-grid-point; true &rarr; cloud-in-cell
+       *  @param interpolation_type the mass assignment scheme: 0
+       *  &rarr; nearest-grid-point; 1 &rarr; cloud-in-cell; 2 &rarr;
+       *  triangular-shaped-cloud; 3 &rarr; piecewise cubic spline
        *  @param kernel_radius size of the kernel for the gaussian
        *  smoothing
        *  @param useMass generate the density field using the mass
@@ -0,0 +1,285 @@
+/********************************************************************
+ *  Copyright (C) 2010 by Federico Marulli and Alfonso Veropalumbo  *
+ *  federico.marulli3@unibo.it                                      *
+ *                                                                  *
+ *  This program is free software; you can redistribute it and/or   *
+ *  modify it under the terms of the GNU General Public License as  *
+ *  published by the Free Software Foundation; either version 2 of  *
+ *  the License, or (at your option) any later version.             *
+ *                                                                  *
+ *  This program is distributed in the hope that it will be useful, *
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of  *
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the   *
+ *  GNU General Public License for more details.                    *
+ *                                                                  *
+ *  You should have received a copy of the GNU General Public       *
+ *  License along with this program; if not, write to the Free      *
+ *  Software Foundation, Inc.,                                      *
+ *  59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.       *
+ *******************************************************************/
+
+/**
+ *  @file Headers/CatalogueView.h
+ *
+ *  @brief The class CatalogueView
+ *
+ *  This file defines the interface of the class CatalogueView, used
+ *  to select subsets of the objects of a catalogue without copying
+ *  them
+ *
+ *  @authors Federico Marulli, Alfonso Veropalumbo
+ *
+ *  @authors federico.marulli3@unbo.it, alfonso.veropalumbo@unibo.it
+ */
+
+#ifndef __CATALOGUEVIEW__
+#define __CATALOGUEVIEW__
+
+#include "Catalogue.h"
+
+
+namespace cbl {
+
+  namespace catalogue {
+
+    /**
+     *  @class CatalogueView CatalogueView.h
+     *  "Headers/CatalogueView.h"
+     *
+     *  @brief The class CatalogueView
+     *
+     *  This class is used to select a subset of the objects of a
+     *  parent catalogue, storing only the indexes of the selected
+     *  objects. The selections (dilutions, cuts in any variable,
+     *  region exclusions) can be combined, and copy neither
+     *  the objects nor the vector of pointers to the objects of the
+     *  parent catalogue. To be used by the measurement classes, a
+     *  view has to be converted explicitly into an object of class
+     *  Catalogue: the objects are shared with the parent catalogue,
+     *  but the conversion creates the vector of pointers to the
+     *  selected objects, so it should be done only once, after all
+     *  the selections
+     */
+    class CatalogueView {
+
+    private:
+
+      /// the parent catalogue
+      std::shared_ptr<const Catalogue> m_parent;
+
+      /// the indexes of the selected objects in the parent catalogue
+      std::vector<size_t> m_index;
+
+      /**
+       *  @brief create a view of the selected objects
+       *  @param select function that returns true if the i-th object
+       *  of the view has to be selected
+       *  @return object of class CatalogueView
+       */
+      CatalogueView m_select (std::function<bool(const size_t)> select) const;
+
+    public:
+
+      /**
+       *  @name Constructors/destructors
+       */
+      ///@{
+
+      /**
+       *  @brief constructor that selects all the objects of a
+       *  catalogue
+       *
+       *  the view does not own the catalogue, that must exist as
+       *  long as the view is used
+       *
+       *  @param parent the parent catalogue
+       *  @return object of class CatalogueView
+       */
+      explicit CatalogueView (const Catalogue &parent);
+
+      /**
+       *  @brief the views of temporary catalogues are not allowed,
+       *  since the view does not own the parent catalogue
+       *  @param parent the parent catalogue
+       */
+      CatalogueView (Catalogue &&parent) = delete;
+
+      /**
+       *  @brief constructor that selects all the objects of a
+       *  catalogue
+       *  @param parent pointer to the parent catalogue, that is kept
+       *  as long as the view exists
+       *  @return object of class CatalogueView
+       */
+      explicit CatalogueView (const std::shared_ptr<const Catalogue> parent);
+
+      /**
+       *  @brief constructor that selects some objects of a catalogue
+       *  @param parent pointer to the parent catalogue, that is kept
+       *  as long as the view exists
+       *  @param index the indexes of the selected objects in the
+       *  parent catalogue
+       *  @return object of class CatalogueView
+       */
+      CatalogueView (const std::shared_ptr<const Catalogue> parent, const std::vector<size_t> index);
+
+      /**
+       *  @brief default destructor
+       *  @return none
+       */
+      ~CatalogueView () = default;
+
+      ///@}
+
+
+      /**
+       *  @name Functions to get the properties of the view
+       */
+      ///@{
+
+      /**
+       *  @brief get the parent catalogue
+       *  @return reference to the parent catalogue
+       */
+      const Catalogue & parent () const { return *m_parent; }
+
+      /**
+       *  @brief get the indexes of the selected objects
+       *  @return vector containing the indexes of the selected
+       *  objects in the parent catalogue
+       */
+      const std::vector<size_t> & index () const { return m_index; }
+
+      /**
+       *  @brief get the number of selected objects
+       *  @return the number of selected objects
+       */
+      size_t nObjects () const { return m_index.size(); }
+
+      /**
+       *  @brief get the i-th selected object
+       *  @param i the object index in the view
+       *  @return pointer to the object
+       */
+      std::shared_ptr<Object> operator[] (const size_t i) const { return m_parent->catalogue_object(m_index[i]); }
+
+      /**
+       *  @brief get the value of a variable of the i-th selected
+       *  object
+       *  @param i the object index in the view
+       *  @param var_name the variable name
+       *  @return the value of the variable
+       */
+      double var (const size_t i, const Var var_name) const { return m_parent->var(m_index[i], var_name); }
+
+      /**
+       *  @brief get the values of a variable of the selected objects
+       *  @param var_name the variable name
+       *  @return vector containing the values of the variable
+       */
+      std::vector<double> var (const Var var_name) const;
+
+      /**
+       *  @brief get the total weight of the selected objects
+       *  @return the total weight
+       */
+      double weightedN () const;
+
+      ///@}
+
+
+      /**
+       *  @name Functions to select the objects
+       */
+      ///@{
+
+      /**
+       *  @brief create a diluted view
+       *
+       *  the selected objects are the same of
+       *  Catalogue::diluted_catalogue, for the same seed
+       *
+       *  @param nSub the fraction of objects that will be randomly
+       *  selected (nSub=1 \f$ \rightarrow \f$ all objects are
+       *  selected)
+       *  @param seed the seed for random number generation
+       *  @return object of class CatalogueView
+       */
+      CatalogueView diluted (const double nSub, const int seed=3213) const;
+
+      /**
+       *  @brief create a view of the objects in a range of a variable
+       *  @param var_name the variable name
+       *  @param down minimum variable used to cut the catalogue
+       *  @param up maximum variable used to cut the catalogue
+       *  @param excl false &rarr; select the objects inside down-up;
+       *  true &rarr; select the objects outside down-up
+       *  @return object of class CatalogueView
+       */
+      CatalogueView sub_catalogue (const Var var_name, const double down, const double up, const bool excl=false) const;
+
+      /**
+       *  @brief create a view of the objects in a redshift range
+       *  @param z_min the minimum redshift
+       *  @param z_max the maximum redshift
+       *  @return object of class CatalogueView
+       */
+      CatalogueView redshift_cut (const double z_min, const double z_max) const
+      { return sub_catalogue(Var::_Redshift_, z_min, z_max); }
+
+      /**
+       *  @brief create a view of the objects that belong to some
+       *  regions
+       *  @param region_list the list of regions
+       *  @return object of class CatalogueView
+       */
+      CatalogueView select_regions (const std::vector<long> region_list) const;
+
+      /**
+       *  @brief create a view excluding the objects that belong to
+       *  some regions, as required by jackknife resampling
+       *  @param region_list the list of regions to be excluded
+       *  @return object of class CatalogueView
+       */
+      CatalogueView exclude_regions (const std::vector<long> region_list) const;
+
+      ///@}
+
+
+      /**
+       *  @name Functions to convert the view into a catalogue
+       */
+      ///@{
+
+      /**
+       *  @brief create a catalogue with the selected objects
+       *
+       *  the objects are not copied, but shared with the parent
+       *  catalogue; the vector of pointers to the selected objects
+       *  is created, with a cost proportional to the number of
+       *  selected objects
+       *
+       *  @return object of class Catalogue
+       */
+      Catalogue catalogue () const;
+
+      /**
+       *  @brief explicit conversion to a catalogue, so that the
+       *  view can be passed to all the functions that require a
+       *  catalogue
+       *
+       *  the conversion is explicit since, as
+       *  CatalogueView::catalogue, it creates the vector of pointers
+       *  to the selected objects
+       *
+       *  @return object of class Catalogue
+       */
+      explicit operator Catalogue () const { return catalogue(); }
+
+      ///@}
+
+    };
+  }
+}
+
+#endif
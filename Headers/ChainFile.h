@@ -0,0 +1,237 @@
+/********************************************************************
+ *  Copyright (C) 2014 by Federico Marulli and Alfonso Veropalumbo  *
+ *  federico.marulli3@unibo.it                                      *
+ *                                                                  *
+ *  This program is free software; you can redistribute it and/or   *
+ *  modify it under the terms of the GNU General Public License as  *
+ *  published by the Free Software Foundation; either version 2 of  *
+ *  the License, or (at your option) any later version.             *
+ *                                                                  *
+ *  This program is distributed in the hope that it will be useful, *
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of  *
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the   *
+ *  GNU General Public License for more details.                    *
+ *                                                                  *
+ *  You should have received a copy of the GNU General Public       *
+ *  License along with this program; if not, write to the Free      *
+ *  Software Foundation, Inc.,                                      *
+ *  59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.       *
+ ********************************************************************/
+
+/**
+ *  @file Headers/ChainFile.h
+ *
+ *  @brief The class ChainFile
+ *
+ *  This file defines the interface of the class ChainFile, used to
+ *  store the MCMC chains in a binary file while sampling
+ *
+ *  @authors Federico Marulli, Alfonso Veropalumbo
+ *
+ *  @authors federico.marulli3@unbo.it, alfonso.veropalumbo@unibo.it
+ */
+
+#ifndef __CHAINFILE__
+#define __CHAINFILE__
+
+#include "Kernel.h"
+
+
+// ============================================================================================
+
+
+namespace cbl {
+
+  namespace statistics {
+
+    /**
+     *  @class ChainFile ChainFile.h "Headers/ChainFile.h"
+     *
+     *  @brief The class ChainFile
+     *
+     *  This class is used to write the MCMC chains on a binary file
+     *  while sampling, in blocks of steps, so that only the last
+     *  steps have to be kept in memory, and a run can be resumed
+     *  from the file. The file contains a header (the string
+     *  CBLCHAIN, the number of parameters, the number of walkers and
+     *  the seed of the random numbers),
+     *  followed by the steps: for each walker, the parameters and
+     *  the value of the sampled function. An incomplete step at the
+     *  end of the file, left by an interrupted run, is ignored and
+     *  overwritten
+     */
+    class ChainFile
+    {
+
+    protected:
+
+      /// the name of the file
+      std::string m_file;
+
+      /// the number of parameters
+      int m_npar = 0;
+
+      /// the number of walkers
+      int m_nwalkers = 0;
+
+      /// the seed of the random numbers used to sample the chains
+      int m_seed = 0;
+
+      /// the number of complete steps written on the file
+      int m_nsteps_file = 0;
+
+      /// the number of steps written on the file at once
+      int m_block_size = 100;
+
+      /// the steps not yet written on the file
+      std::vector<double> m_buffer;
+
+      /**
+       *  @brief get the size of the header
+       *  @return the size of the header, in bytes
+       */
+      static std::streamoff m_header_size ();
+
+      /**
+       *  @brief get the size of a step
+       *  @return the size of a step, in bytes
+       */
+      std::streamoff m_step_size () const;
+
+    public:
+
+      /**
+       *  @name Constructors/destructors
+       */
+      ///@{
+
+      /**
+       *  @brief default constructor
+       *  @return object of class ChainFile
+       */
+      ChainFile () = default;
+
+      /**
+       *  @brief constructor that opens an existing file, to read
+       *  the chains or to append new steps
+       *  @param file the name of the file
+       *  @param block_size the number of steps written on the file
+       *  at once
+       *  @return object of class ChainFile
+       */
+      ChainFile (const std::string file, const int block_size=100);
+
+      /**
+       *  @brief constructor that creates a new file, overwriting it
+       *  if it exists
+       *  @param file the name of the file
+       *  @param npar the number of parameters
+       *  @param nwalkers the number of walkers
+       *  @param seed the seed of the random numbers used to sample
+       *  the chains, checked when the chains are resumed
+       *  @param block_size the number of steps written on the file
+       *  at once
+       *  @return object of class ChainFile
+       */
+      ChainFile (const std::string file, const int npar, const int nwalkers, const int seed, const int block_size=100);
+
+      /**
+       *  @brief copy constructor, deleted since the buffered steps
+       *  must be written only once
+       *  @return none
+       */
+      ChainFile (const ChainFile &) = delete;
+
+      /**
+       *  @brief copy assignment, deleted since the buffered steps
+       *  must be written only once
+       *  @return none
+       */
+      ChainFile & operator= (const ChainFile &) = delete;
+
+      /**
+       *  @brief destructor, that writes the buffered steps
+       *  @return none
+       */
+      ~ChainFile () { flush(); }
+
+      ///@}
+
+      /**
+       *  @brief check if a file is a binary chain file
+       *  @param file the name of the file
+       *  @return true if the file exists and starts with the header
+       *  of a binary chain file; false otherwise
+       */
+      static bool is_chain_file (const std::string file);
+
+      /**
+       *  @brief get the number of parameters
+       *  @return the number of parameters
+       */
+      int npar () const { return m_npar; }
+
+      /**
+       *  @brief get the number of walkers
+       *  @return the number of walkers
+       */
+      int nwalkers () const { return m_nwalkers; }
+
+      /**
+       *  @brief get the seed of the random numbers used to sample
+       *  the chains
+       *  @return the seed
+       */
+      int seed () const { return m_seed; }
+
+      /**
+       *  @brief get the number of steps, including the ones not yet
+       *  written on the file
+       *  @return the number of steps
+       */
+      int nsteps () const { return m_nsteps_file+int(m_buffer.size()/(m_nwalkers*(m_npar+1))); }
+
+      /**
+       *  @brief append a step; the steps are written on the file
+       *  when the buffered steps are block_size
+       *  @param chain_step the parameters of each walker:
+       *  chain_step[walker][parameter]
+       *  @param function_step the value of the function for each
+       *  walker
+       *  @return none
+       */
+      void append_step (const std::vector<std::vector<double>> &chain_step, const std::vector<double> &function_step);
+
+      /**
+       *  @brief write the buffered steps on the file
+       *  @return none
+       */
+      void flush ();
+
+      /**
+       *  @brief read the last step
+       *  @param [out] chain_step the parameters of each walker:
+       *  chain_step[walker][parameter]
+       *  @param [out] function_step the value of the function for
+       *  each walker
+       *  @return none
+       */
+      void last_step (std::vector<std::vector<double>> &chain_step, std::vector<double> &function_step);
+
+      /**
+       *  @brief read the chains
+       *  @param [out] chain_value the chains:
+       *  chain_value[parameter][step*nwalkers+walker]
+       *  @param [out] function the value of the function:
+       *  function[step*nwalkers+walker]
+       *  @param [in] start the first step to be read (burn-in)
+       *  @param [in] thin the step used for dilution
+       *  @return none
+       */
+      void read (std::vector<std::vector<double>> &chain_value, std::vector<double> &function, const int start=0, const int thin=1);
+
+    };
+  }
+}
+
+#endif
@@ -148,6 +148,12 @@ namespace cbl {
        *  @return indexes of non-empty cells 
        */
       std::vector<long> NonEmpty_Cells() const { return m_NonEmpty_Cells; }
+
+      /**
+       *  @brief get the private member ChainMesh::m_cell_size
+       *  @return the cell size 
+       */
+      double cell_size () const { return m_cell_size; }
     
       /**
        * @brief get the index of the cell given the object coordinates
@@ -172,6 +178,20 @@ namespace cbl {
        */  
       void index_to_inds (const long index, const std::vector<long> nn, std::vector<long> &indx) const;
 
+      /**
+       * @brief set the limits and the number of cells of the chain
+       * mesh, enlarging the cell size if the number of cells is
+       * larger than nMAX<SUP>3</SUP>, or if the cells do not fit in
+       * memory
+       * @param lim_min the minimum coordinates of the objects 
+       * @param lim_max the maximum coordinates of the objects 
+       * @param rMax the maximum radius
+       * @param nMIN minimum number of cells
+       * @param nMAX maximum number of cells
+       * @return none
+       */
+      void set_cells (const std::vector<double> lim_min, const std::vector<double> lim_max, const double rMax, const long nMIN=10, const long nMAX=300);
+
       /**
        * @brief create the chain mesh
        * @param data the vector containing the coordinate of the object 
@@ -212,7 +232,15 @@ namespace cbl {
        * @param ii the minimum index given in output
        * @return vector containing the index of the objects inside the cell
        */
-      std::vector<long> close_objects (std::vector<double> center, long ii=-1) const; 
+      std::vector<long> close_objects (std::vector<double> center, long ii=-1) const;
+
+      /**
+       * @brief get the indices of the cells close to a cell
+       * @param cell_index the cell index
+       * @return vector containing the (sorted and not repeated) indices
+       * of the cells inside the searching region
+       */
+      std::vector<long> close_cells (const long cell_index) const;
 
       /**
        * @brief get the index of the object inside a cell
@@ -221,8 +249,45 @@ namespace cbl {
        */
       std::vector<long> get_list (const long cell_index) const;
 
+      /**
+       * @brief estimate the work needed to count the pairs of the
+       * objects of the chain-mesh, cell by cell
+       * @param [out] nObjectPairs the number of object pairs
+       * inside the searching regions
+       * @param [out] nObjectCells the number of times an object is
+       * compared with a non-empty cell
+       * @param [out] nCellPairs the number of couples of non-empty
+       * cells inside the searching regions
+       * @param [in] nSample the approximate number of non-empty
+       * cells used to estimate the work, to keep the estimate much
+       * faster than the pair count itself
+       * @return none
+       */
+      void cost (double &nObjectPairs, double &nObjectCells, double &nCellPairs, const long nSample=1000) const;
+
     };
 
+    /**
+     * @brief estimate the cost of counting the pairs of a set of
+     * objects with chain-meshes of different cell sizes
+     *
+     * the cost is modelled as the number of object pairs, plus the
+     * overhead of comparing each object with each close cell, plus
+     * the overhead of each couple of close cells, plus the cost of
+     * allocating the cells; the coefficients are given in units of
+     * the cost of one object pair
+     *
+     * @param data the coordinates of the objects
+     * @param rMAX the maximum separation
+     * @param cell_size the candidate cell sizes
+     * @param objectCell_cost the cost of comparing an object with a
+     * cell
+     * @param cellPair_cost the cost of a couple of cells
+     * @param cell_cost the cost of allocating a cell
+     * @return the estimated cost for each cell size
+     */
+    std::vector<double> chainMesh_cost (const std::vector<std::vector<double>> data, const double rMAX, const std::vector<double> cell_size, const double objectCell_cost=8., const double cellPair_cost=50., const double cell_cost=1.);
+
     /**
      *  @class ChainMesh1D ChainMesh.h "Headers/ChainMesh.h"
      *
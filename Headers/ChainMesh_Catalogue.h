@@ -41,6 +41,151 @@
 namespace cbl {
 
   namespace chainmesh {
+
+    /**
+     *  @struct CellObjects ChainMesh_Catalogue.h
+     *  "Headers/ChainMesh_Catalogue.h"
+     *
+     *  @brief the object properties used to count pairs, stored as
+     *  contiguous arrays ordered by chain-mesh cell
+     *
+     *  The objects inside the chain-mesh cell k have indices in the
+     *  range [first[k], first[k+1]), so that the pair-counting kernels
+     *  can loop over whole cells without accessing the objects through
+     *  pointers; inside each cell, the objects of the same region are
+     *  contiguous
+     */
+    struct CellObjects {
+
+      /// comoving coordinate x
+      std::vector<double> xx;
+
+      /// comoving coordinate y
+      std::vector<double> yy;
+
+      /// comoving coordinate z
+      std::vector<double> zz;
+
+      /// right ascension
+      std::vector<double> ra;
+
+      /// declination
+      std::vector<double> dec;
+
+      /// comoving distance
+      std::vector<double> dc;
+
+      /// redshift
+      std::vector<double> redshift;
+
+      /// weight
+      std::vector<double> weight;
+
+      /// region
+      std::vector<long> region;
+
+      /// index of the first object of each cell (the last element is the number of objects)
+      std::vector<long> first;
+
+      /// indices of the non-empty cells
+      std::vector<long> nonEmpty_cells;
+
+      /// bounding box of the objects of each non-empty cell: {x<SUB>min</SUB>, x<SUB>max</SUB>, y<SUB>min</SUB>, y<SUB>max</SUB>, z<SUB>min</SUB>, z<SUB>max</SUB>} for each cell in nonEmpty_cells
+      std::vector<double> box;
+
+      /// the variables among right ascension, declination, redshift and comoving distance that are set for all the objects
+      std::vector<catalogue::Var> variables;
+
+      /**
+       *  @brief get the number of objects
+       *  @return the number of objects
+       */
+      long nObjects () const { return (long)xx.size(); }
+
+      /**
+       *  @brief set the number of objects
+       *  @param nObj the number of objects
+       *  @return none
+       */
+      void resize (const long nObj);
+
+      /**
+       *  @brief store the properties of an object
+       *  @param k the position where the object is stored
+       *  @param object pointer to an object of class Object
+       *  @return none
+       */
+      void set_object (const long k, const std::shared_ptr<catalogue::Object> object);
+
+      /**
+       *  @brief compute the bounding box of the objects of each
+       *  non-empty cell
+       *  @return none
+       */
+      void set_box ();
+
+      /**
+       *  @brief set the variables, among right ascension,
+       *  declination, redshift and comoving distance, that are set
+       *  for all the objects
+       *  @return none
+       */
+      void set_variables ();
+
+      /**
+       *  @brief check that the variables needed to count the pairs
+       *  are set for all the objects
+       *  @param required the variables needed to count the pairs
+       *  (e.g. the output of Pair::variables())
+       *  @return none; an error is raised if any of the required
+       *  variables is not set
+       */
+      void check_variables (const std::vector<catalogue::Var> required) const;
+
+      /**
+       *  @brief get the position of a cell in the vector of non-empty
+       *  cells
+       *  @param cell the cell index
+       *  @return the position of the cell in nonEmpty_cells, or -1 if
+       *  the cell is empty
+       */
+      long nonEmpty_index (const long cell) const
+      {
+	auto it = std::lower_bound(nonEmpty_cells.begin(), nonEmpty_cells.end(), cell);
+	return (it!=nonEmpty_cells.end() && *it==cell) ? (long)(it-nonEmpty_cells.begin()) : -1;
+      }
+
+      /**
+       *  @brief get the range of the Euclidean distances between the
+       *  objects of a non-empty cell and the objects of a non-empty
+       *  cell of another set of objects
+       *  @param index1 the position of the first cell in
+       *  nonEmpty_cells
+       *  @param objects2 the second set of objects
+       *  @param index2 the position of the second cell in
+       *  objects2.nonEmpty_cells
+       *  @param [out] dist_min the minimum distance between the
+       *  bounding boxes of the two cells
+       *  @param [out] dist_max the maximum distance between the
+       *  bounding boxes of the two cells
+       *  @return none
+       */
+      void separation_range (const long index1, const CellObjects &objects2, const long index2, double &dist_min, double &dist_max) const
+      {
+	double dist2_min = 0., dist2_max = 0.;
+	for (int k=0; k<3; ++k) {
+	  const double min1 = box[6*index1+2*k], max1 = box[6*index1+2*k+1];
+	  const double min2 = objects2.box[6*index2+2*k], max2 = objects2.box[6*index2+2*k+1];
+	  const double gap = std::max(0., std::max(min1-max2, min2-max1));
+	  const double span = std::max(max1-min2, max2-min1);
+	  dist2_min += gap*gap;
+	  dist2_max += span*span;
+	}
+	dist_min = sqrt(dist2_min);
+	dist_max = sqrt(dist2_max);
+      }
+      
+    };
     
     /**
      *  @class ChainMesh_Catalogue ChainMesh_Catalogue.h
@@ -59,6 +204,9 @@ namespace cbl {
       /// pointer to catalogue used for the chain-mesh
       std::shared_ptr<catalogue::Catalogue> m_catalogue;
 
+      /// the objects of the catalogue used for the chain-mesh, ordered by cell
+      CellObjects m_cellObjects;
+
     public:
       /**
        *  @brief default constructor
@@ -115,6 +263,29 @@ namespace cbl {
        *  @return the internal variable m_catalogue
        */
       std::shared_ptr<catalogue::Catalogue> catalogue () const { return m_catalogue; }
+
+      /**
+       *  @brief get the internal variable m_cellObjects
+       *  @return the objects of the catalogue used for the chain-mesh,
+       *  ordered by cell
+       */
+      const CellObjects & cellObjects () const { return m_cellObjects; }
+
+      /**
+       *  @brief distribute the objects of a catalogue in the cells of
+       *  the chain-mesh
+       *
+       *  @param cat pointer to an object of class Catalogue
+       *
+       *  @param required the variables needed to count the pairs; an
+       *  error is raised if any of them is not set
+       *
+       *  @return the objects of the input catalogue, ordered by
+       *  chain-mesh cell and, inside each cell, by region; objects
+       *  outside the chain-mesh are assigned to the closest border
+       *  cell
+       */
+      CellObjects cell_objects (std::shared_ptr<catalogue::Catalogue> cat, const std::vector<catalogue::Var> required={}) const;
       
     };
   }
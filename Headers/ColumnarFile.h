@@ -0,0 +1,183 @@
+/********************************************************************
+ *  Copyright (C) 2010 by Federico Marulli and Alfonso Veropalumbo  *
+ *  federico.marulli3@unibo.it                                      *
+ *                                                                  *
+ *  This program is free software; you can redistribute it and/or   *
+ *  modify it under the terms of the GNU General Public License as  *
+ *  published by the Free Software Foundation; either version 2 of  *
+ *  the License, or (at your option) any later version.             *
+ *                                                                  *
+ *  This program is distributed in the hope that it will be useful, *
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of  *
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the   *
+ *  GNU General Public License for more details.                    *
+ *                                                                  *
+ *  You should have received a copy of the GNU General Public       *
+ *  License along with this program; if not, write to the Free      *
+ *  Software Foundation, Inc.,                                      *
+ *  59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.       *
+ *******************************************************************/
+
+/**
+ *  @file Headers/ColumnarFile.h
+ *
+ *  @brief The class ColumnarFile
+ *
+ *  This file defines the interface of the class ColumnarFile, used
+ *  to write and read catalogues in the native columnar binary
+ *  format
+ *
+ *  @authors Federico Marulli, Alfonso Veropalumbo
+ *
+ *  @authors federico.marulli3@unbo.it, alfonso.veropalumbo@unibo.it
+ */
+
+#ifndef __COLUMNARFILE__
+#define __COLUMNARFILE__
+
+#include "Catalogue.h"
+
+
+namespace cbl {
+
+  namespace catalogue {
+
+    /**
+     *  @class ColumnarFile ColumnarFile.h
+     *  "Headers/ColumnarFile.h"
+     *
+     *  @brief The class ColumnarFile
+     *
+     *  This class is used to handle the files of catalogues in the
+     *  native columnar binary format. The file contains a header,
+     *  with the number of objects and the catalogue variable and the
+     *  type (64-bit floating point or integer) of each column,
+     *  followed by the columns, stored one after the other in the
+     *  native byte order. The file is memory-mapped, so that no
+     *  parsing is required and the columns are loaded from disk only
+     *  when they are accessed
+     */
+    class ColumnarFile {
+
+    private:
+
+      /// the name of the file
+      std::string m_file;
+
+      /// the size of the file (in bytes)
+      size_t m_size = 0;
+
+      /// the memory-mapped file, unmapped when the object is destroyed, or if the constructor fails
+      std::unique_ptr<const char, std::function<void(const char *)>> m_map;
+
+      /// the number of objects
+      size_t m_nObjects = 0;
+
+      /// the catalogue variables stored in the file
+      std::vector<Var> m_var;
+
+      /// the type of each column: 0 &rarr; double; 1 &rarr; long
+      std::vector<int> m_type;
+
+      /// the position in the file of each column (in bytes)
+      std::vector<size_t> m_offset;
+
+      /// the index of the column of each catalogue variable, or -1 if the variable is not stored in the file
+      std::array<int, static_cast<size_t>(Var::_Generic_)+1> m_column_index;
+
+      /**
+       *  @brief get the index of a column
+       *  @param var the catalogue variable
+       *  @return the index of the column, or -1 if the variable
+       *  is not stored in the file
+       */
+      int m_column (const Var var) const { return m_column_index[static_cast<int>(var)]; }
+
+    public:
+
+      /**
+       *  @brief constructor that memory-maps a file
+       *  @param file the name of the file
+       *  @return object of class ColumnarFile
+       */
+      ColumnarFile (const std::string file);
+
+      /**
+       *  @brief the copy constructor is deleted, since the object
+       *  owns the memory map
+       *  @param cf an object of class ColumnarFile
+       */
+      ColumnarFile (const ColumnarFile &cf) = delete;
+
+      /**
+       *  @brief the copy assignment is deleted, since the object
+       *  owns the memory map
+       *  @param cf an object of class ColumnarFile
+       *  @return none
+       */
+      ColumnarFile & operator= (const ColumnarFile &cf) = delete;
+
+      /**
+       *  @brief default destructor, that unmaps the file
+       *  @return none
+       */
+      ~ColumnarFile () = default;
+
+      /**
+       *  @brief write a file in the columnar binary format
+       *  @param file the name of the file
+       *  @param var the catalogue variables
+       *  @param column the columns, one for each variable; the
+       *  regions are stored as integers
+       *  @return none
+       */
+      static void write (const std::string file, const std::vector<Var> var, const std::vector<std::vector<double>> &column);
+
+      /**
+       *  @brief get the number of objects
+       *  @return the number of objects
+       */
+      size_t nObjects () const { return m_nObjects; }
+
+      /**
+       *  @brief get the catalogue variables stored in the file
+       *  @return vector containing the catalogue variables
+       */
+      std::vector<Var> var () const { return m_var; }
+
+      /**
+       *  @brief check if a catalogue variable is stored in the file
+       *  @param var the catalogue variable
+       *  @return true if the variable is stored in the file; false
+       *  otherwise
+       */
+      bool isSetVar (const Var var) const { return m_column(var)>-1; }
+
+      /**
+       *  @brief get the value of a catalogue variable of an object
+       *  @param var the catalogue variable
+       *  @param i the object index
+       *  @return the value of the variable
+       */
+      double value (const Var var, const size_t i) const;
+
+      /**
+       *  @brief get a column, stored in the memory-mapped file
+       *  @param var the catalogue variable, that must be stored as
+       *  double
+       *  @return pointer to the first value of the column
+       */
+      const double *column (const Var var) const;
+
+      /**
+       *  @brief get a column, copied to a vector
+       *  @param var the catalogue variable
+       *  @return vector containing the values of the variable
+       */
+      std::vector<double> column_vector (const Var var) const;
+
+    };
+  }
+}
+
+#endif
@@ -248,6 +248,163 @@ namespace cbl {
      */
     std::string CosmologicalParameter_name (const CosmologicalParameter parameter);
 
+    /**
+     *  @struct DistanceTable
+     *  @brief the tables used to interpolate the cosmic distances
+     *
+     *  the comoving distance and the lookback time, in units of the
+     *  Hubble distance and time, are tabulated on a uniform grid in
+     *  x=ln(1+z), together with their exact derivatives, and are
+     *  interpolated with cubic Hermite polynomials; the grid is
+     *  refined until the interpolation error, checked at the centre
+     *  of each interval, is smaller than DistanceTable::prec; the
+     *  redshift at a given comoving distance is obtained by
+     *  inverting the interpolating polynomial
+     *
+     *  the tables are computed only for the LCDM model, and only up
+     *  to the redshifts actually requested: they are extended,
+     *  doubling their range in x, when higher redshifts are needed;
+     *  the distances are integrated directly, without the tables,
+     *  until DistanceTable::nCalls_min distances have been computed
+     *  with the same cosmological parameters, so that the tables
+     *  are not recomputed at each call when the parameters change
+     *  continuously (e.g. in a Monte Carlo Markov chain)
+     */
+    struct DistanceTable {
+
+      /// the maximum redshift up to which the tables can be computed
+      static constexpr double z_limit = 1.e4;
+
+      /// the number of distances computed with the same cosmological parameters after which the tables are computed
+      static constexpr int nCalls_min = 64;
+
+      /// the relative accuracy of the interpolation
+      static constexpr double prec = 1.e-9;
+
+      /// the cosmological parameters the tables depend on: &Omega;<SUB>M</SUB>, &Omega;<SUB>DE</SUB>, &Omega;<SUB>k</SUB>, &Omega;<SUB>rad</SUB>, w<SUB>0</SUB>, w<SUB>a</SUB>
+      std::vector<double> parameter;
+
+      /// the cosmological model used to compute distances
+      std::string model;
+
+      /// the maximum redshift of the tables
+      double z_max;
+
+      /// the step of the grid in x=ln(1+z)
+      double delta_x;
+
+      /// the comoving distance, in units of the Hubble distance
+      std::vector<double> dc;
+
+      /// the derivative of the comoving distance with respect to x
+      std::vector<double> dc_deriv;
+
+      /// the lookback time, in units of the Hubble time
+      std::vector<double> time;
+
+      /// the derivative of the lookback time with respect to x
+      std::vector<double> time_deriv;
+
+      /// the redshifts of the comoving distance table of the non-LCDM models
+      std::vector<double> file_redshift;
+
+      /// the comoving distances, in units of the Hubble distance, of the non-LCDM models
+      std::vector<double> file_dc;
+      
+    };
+    
+    /**
+     *  @struct PowerSpectrumTable
+     *  @brief a power spectrum tabulated by CAMB, CLASS or MPTbreeze
+     */
+    struct PowerSpectrumTable {
+
+      /// log<SUB>10</SUB> of the wave vector modules
+      std::vector<double> lgkk;
+
+      /// log<SUB>10</SUB> of the power spectrum
+      std::vector<double> lgPk;
+
+      /**
+       *  @brief interpolate the power spectrum, linearly in
+       *  log-log, extrapolating linearly outside the table
+       *  @param lgk log<SUB>10</SUB> of the wave vector module
+       *  @return log<SUB>10</SUB> of the power spectrum
+       */
+      double operator() (const double lgk) const;
+      
+    };
+
+    /**
+     *  @class PowerSpectrumCache Cosmology.h "Headers/Cosmology.h"
+     *
+     *  @brief in-memory cache of the power spectrum tables and
+     *  normalisations
+     *
+     *  the entries are identified by a key containing all the
+     *  cosmological parameters and the arguments they depend on
+     *  (see Cosmology::m_Pk_key), so that the same cache can be
+     *  shared by different copies of a Cosmology object; the
+     *  oldest entries are removed when more than
+     *  PowerSpectrumCache::nMax entries are stored; the cache can be
+     *  accessed concurrently by different threads
+     */
+    class PowerSpectrumCache {
+
+    private:
+
+      /// the power spectrum tables
+      std::map<std::string, std::shared_ptr<const PowerSpectrumTable>> m_table;
+
+      /// the keys of the power spectrum tables, in insertion order
+      std::deque<std::string> m_table_key;
+      
+      /// the normalisations
+      std::map<std::string, double> m_value;
+
+      /// the keys of the normalisations, in insertion order
+      std::deque<std::string> m_value_key;
+
+    public:
+
+      /// the maximum number of stored tables and normalisations
+      static const size_t nMax = 128;
+      
+      /**
+       *  @brief get a power spectrum table
+       *  @param key the key of the table
+       *  @return pointer to the table, or nullptr if the table is
+       *  not stored
+       */
+      std::shared_ptr<const PowerSpectrumTable> table (const std::string &key) const;
+
+      /**
+       *  @brief store a power spectrum table
+       *  @param key the key of the table
+       *  @param table pointer to the table
+       *  @return none
+       */
+      void set_table (const std::string &key, const std::shared_ptr<const PowerSpectrumTable> table);
+
+      /**
+       *  @brief get a normalisation
+       *  @param [in] key the key of the normalisation
+       *  @param [out] value the normalisation
+       *  @return true if the normalisation is stored; false
+       *  otherwise
+       */
+      bool value (const std::string &key, double &value) const;
+
+      /**
+       *  @brief store a normalisation
+       *  @param key the key of the normalisation
+       *  @param value the normalisation
+       *  @return none
+       */
+      void set_value (const std::string &key, const double value);
+      
+    };
+    
     /**
      *  @class Cosmology Cosmology.h "Headers/Cosmology.h"
      *
@@ -357,6 +514,18 @@ namespace cbl {
       /// false \f$\rightarrow\f$ phyical units; true \f$\rightarrow\f$ cosmological units (i.e. without \e h)
       bool m_unit;
 
+      /// the tables used to interpolate the cosmic distances, built when first needed
+      mutable std::shared_ptr<const DistanceTable> m_distance_table;
+
+      /// the cosmological parameters and model of the last distances computed without the tables
+      mutable std::pair<std::vector<double>, std::string> m_distance_key;
+
+      /// the number of distances computed without the tables with the cosmological parameters m_distance_key
+      mutable int m_distance_calls = 0;
+
+      /// the memoised power spectrum tables and normalisations, shared by the copies of the object
+      std::shared_ptr<PowerSpectrumCache> m_Pk_cache = std::make_shared<PowerSpectrumCache>();
+
       
       /**
        *  @name Auxiliary functions of internal usage
@@ -369,6 +538,108 @@ namespace cbl {
        *  @return none
        */
       void set_default ();
+
+      /**
+       *  @brief get the tables used to interpolate the cosmic
+       *  distances
+       *
+       *  the tables are computed when DistanceTable::nCalls_min
+       *  distances have been requested with the same cosmological
+       *  parameters, and recomputed if the parameters they depend on
+       *  have changed or if they do not reach the requested
+       *  redshift
+       *
+       *  @param redshift the maximum redshift where the distances
+       *  have to be interpolated; it must not exceed
+       *  DistanceTable::z_limit
+       *
+       *  @param batch true \f$\rightarrow\f$ the tables are
+       *  computed at once, as they are used to compute several
+       *  distances
+       *
+       *  @return pointer to the tables, or nullptr if the distances
+       *  have to be integrated directly
+       */
+      std::shared_ptr<const DistanceTable> m_get_distance_table (const double redshift, const bool batch=false) const;
+
+      /**
+       *  @brief get the tables used to interpolate the cosmic
+       *  distances, including a given comoving distance
+       *
+       *  @param d_c the maximum comoving distance where the redshifts
+       *  have to be interpolated
+       *
+       *  @param batch true \f$\rightarrow\f$ the tables are
+       *  computed at once, as they are used to compute several
+       *  redshifts
+       *
+       *  @return pointer to the tables, or nullptr if the redshifts
+       *  have to be computed without the tables
+       */
+      std::shared_ptr<const DistanceTable> m_get_distance_table_dc (const double d_c, const bool batch=false) const;
+
+      /**
+       *  @brief compute the tables used to interpolate the cosmic
+       *  distances
+       *
+       *  @param z_max the maximum redshift of the tables
+       *
+       *  @return the tables
+       */
+      DistanceTable m_compute_distance_table (const double z_max) const;
+
+      /**
+       *  @brief the key identifying a power spectrum table or
+       *  normalisation in the cache
+       *
+       *  @param name the name of the quantity, including the string
+       *  arguments it depends on
+       *
+       *  @param value the numerical arguments the quantity depends
+       *  on
+       *
+       *  @return the key, containing the name, the cosmological
+       *  parameters and the arguments
+       */
+      std::string m_Pk_key (const std::string name, const std::vector<double> value) const;
+
+      /**
+       *  @brief get the power spectrum tabulated by CAMB, CLASS or
+       *  MPTbreeze, computing or reading it only at the first call
+       *
+       *  @param code method used to compute the power spectrum
+       *  @param NL 0 \f$\rightarrow\f$ linear power spectrum; 1
+       *  \f$\rightarrow\f$ non-linear power spectrum
+       *  @param redshift redshift
+       *  @param output_root output_root of the parameter file used
+       *  to compute the power spectrum
+       *  @param k_max maximum wave vector module up to which the
+       *  power spectrum is computed
+       *  @param file_par name of the parameter file
+       *
+       *  @return pointer to the table
+       */
+      std::shared_ptr<const PowerSpectrumTable> m_Pk_table (const std::string code, const bool NL, const double redshift, const std::string output_root, const double k_max, const std::string file_par) const;
+
+      /**
+       *  @brief compute or read the power spectrum tabulated by
+       *  CAMB, CLASS or MPTbreeze, without using the cache
+       *
+       *  @param [in] code method used to compute the power spectrum
+       *  @param [in] NL 0 \f$\rightarrow\f$ linear power spectrum; 1
+       *  \f$\rightarrow\f$ non-linear power spectrum
+       *  @param [out] lgkk vector of log(k)
+       *  @param [out] lgPk vector of log(P(k))
+       *  @param [in] redshift redshift
+       *  @param [in] output_root output_root of the parameter file
+       *  used to compute the power spectrum
+       *  @param [in] k_max maximum wave vector module up to which the
+       *  power spectrum is computed
+       *  @param [in] file_par name of the parameter file
+       *
+       *  @return none
+       */
+      void m_read_Pk_table (const std::string code, const bool NL, std::vector<double> &lgkk, std::vector<double> &lgPk, const double redshift, const std::string output_root, const double k_max, std::string file_par) const;
       
       /**
        *  @brief function to compute the not-yet-normalised mass
@@ -1934,6 +2205,19 @@ namespace cbl {
        */
       double Redshift (const double d_c=1., const double z1_guess=0., const double z2_guess=10., const double prec=0.0001) const; 
 
+      /**
+       *  @brief redshifts at given comoving distances
+       *
+       *  the redshifts are computed in parallel, by inverting the
+       *  interpolated comoving distance
+       *
+       *  @param d_c vector containing the line-of-sight comoving
+       *  distances
+       *
+       *  @return vector containing the redshifts
+       */
+      std::vector<double> Redshift (const std::vector<double> d_c) const; 
+
       /**
        *  @brief redshift at a given comoving distance
        *
@@ -2095,11 +2379,28 @@ namespace cbl {
        *
        *  for demonstration, see \ref distances.cpp
        *
+       *  the distance is interpolated from a table (see
+       *  cbl::cosmology::DistanceTable), computed when several
+       *  distances are requested with the same cosmological
+       *  parameters
+       *
        *  @param redshift the redshift
        *  @return D<SUB>C</SUB>
        */
       double D_C (const double redshift) const;  
 
+      /**
+       *  @brief the comoving line-of-sight distances at given
+       *  redshifts
+       *
+       *  the distances are computed in parallel, interpolating the
+       *  comoving distance
+       *
+       *  @param redshift vector containing the redshifts
+       *  @return vector containing D<SUB>C</SUB>
+       */
+      std::vector<double> D_C (const std::vector<double> redshift) const;  
+
       /**
        *  @brief the comoving line-of-sight distance at a given redshift
        *
@@ -2248,6 +2549,16 @@ namespace cbl {
        */
       double Distance (const double redshift, const std::string distance_type) const;
 
+      /**
+       *  @brief the distances at given redshifts, computed in
+       *  parallel; the distances available are the same of
+       *  Cosmology::Distance(const double, const std::string)
+       *  @param redshift vector containing the redshifts
+       *  @param distance_type the type of distance to return
+       *  @return vector containing the distances
+       */
+      std::vector<double> Distance (const std::vector<double> redshift, const std::string distance_type) const;
+
       /**
        *  @brief comoving volume for a given redshift range and sky area
        *
@@ -3744,6 +4055,9 @@ namespace cbl {
        *  parameter file is provided (i.e. file_par!=NULL), it will be
        *  used, ignoring the cosmological parameters of the object
        *
+       *  the table is computed or read only at the first call, and
+       *  then kept in memory
+       *
        *  @return none
        */
       void Table_PkCodes (const std::string code, const bool NL, std::vector<double> &lgkk, std::vector<double> &lgPk, const double redshift, const std::string output_root="test", const double k_max=100., std::string file_par=par::defaultString) const;
@@ -3860,6 +4174,55 @@ namespace cbl {
        */
       double Pk (const double kk, const std::string method_Pk, const bool NL, const double redshift, const std::string output_root="test", const int norm=-1, const double k_min=0., const double k_max=100., const double prec=1.e-2, const std::string file_par=par::defaultString, const bool unit1=false); 
 
+      /**
+       *  @brief normalised power spectrum at a set of wave vectors
+       *
+       *  this function provides the same power spectrum of
+       *  Cosmology::Pk(const double, const std::string, const bool,
+       *  const double, const std::string, const int, const double,
+       *  const double, const double, const std::string, const bool),
+       *  computing the normalisation and reading the table only once,
+       *  and evaluating the power spectrum in parallel
+       *
+       *  @param kk the wave vector modules
+       *
+       *  @param method_Pk method used to compute the power spectrum;
+       *  valid choices for method_Pk are: CAMB [http://camb.info/],
+       *  classgal_v1 [http://class-code.net/], MPTbreeze-v1
+       *  [http://arxiv.org/abs/1207.1465], EisensteinHu
+       *  [http://background.uchicago.edu/~whu/transfer/transferpage.html]
+       *
+       *  @param NL 0 \f$\rightarrow\f$ linear power spectrum; 1 \f$\rightarrow\f$
+       *  non-linear power spectrum
+       *
+       *  @param redshift the redshift
+       *
+       *  @param output_root the output_root parameter of the
+       *  parameter file used to compute the power spectrum; it can be
+       *  any name
+       *
+       *  @param norm 0 \f$\rightarrow\f$ don't normalise the power
+       *  spectrum; 1 \f$\rightarrow\f$ normalise the power spectrum;
+       *  -1 \f$\rightarrow\f$ normalise only if sigma8 is set
+       *
+       *  @param k_min minimum wave vector module up to which the power
+       *  spectrum is computed
+       *
+       *  @param k_max maximum wave vector module up to which the power
+       *  spectrum is computed
+       *
+       *  @param prec accuracy of the integration 
+       *
+       *  @param file_par name of the parameter file; if a parameter
+       *  file is provided (i.e. file_par!=NULL), it will be used,
+       *  ignoring the cosmological parameters of the object
+       *
+       *  @param unit1 true \f$\rightarrow\f$ force cosmological units
+       *
+       *  @return vector containing P(k)
+       */
+      std::vector<double> Pk_grid (const std::vector<double> kk, const std::string method_Pk, const bool NL, const double redshift, const std::string output_root="test", const int norm=-1, const double k_min=0., const double k_max=100., const double prec=1.e-2, const std::string file_par=par::defaultString, const bool unit1=false); 
+
       /**
        *  @brief normalised power spectrum
        *
@@ -140,6 +140,27 @@ namespace cbl {
        */
       long int inds_to_index_Fourier (const int i, const int j, const int k) const { return k+m_nZF*(j+m_nY*i); }
 
+      /**
+       * @brief get the FFTW plan for a grid
+       *
+       * the plans are created once for each grid shape and
+       * direction, with the planner flag and the number of threads
+       * set by Field3D::set_FFTW_planner and
+       * Field3D::set_FFTW_nThreads, and are shared by all the fields;
+       * they are executed with the new-array execute functions of
+       * FFTW, that require arrays allocated with fftw_alloc_real and
+       * fftw_alloc_complex
+       *
+       * @param nx number of x-axis cells
+       * @param ny number of y-axis cells
+       * @param nz number of z-axis cells
+       * @param forward true &rarr; real-to-complex transform; false
+       * &rarr; complex-to-real transform
+       *
+       * @return the FFTW plan
+       */
+      static fftw_plan m_FFTW_plan (const int nx, const int ny, const int nz, const bool forward);
+
       
     public:
 
@@ -195,6 +216,61 @@ namespace cbl {
       ///@}
 
 
+      /**
+       *  @name Member functions to set the FFTW configuration, shared by all the fields
+       */
+      ///@{
+
+      /**
+       *  @brief set the FFTW planner flag used to create the plans
+       *
+       *  the plans already created are destroyed; FFTW_MEASURE (the
+       *  default) and FFTW_PATIENT find faster plans than
+       *  FFTW_ESTIMATE, but take longer to create them, unless the
+       *  wisdom has been loaded (see Field3D::set_FFTW_wisdom)
+       *
+       *  @param planner_flag the FFTW planner flag
+       *
+       *  @return none
+       *
+       *  @warning the plans are destroyed inside the critical
+       *  section of the planner, but the function must not be called
+       *  while other threads are computing Fourier transforms
+       */
+      static void set_FFTW_planner (const unsigned int planner_flag);
+
+      /**
+       *  @brief set the number of threads used by the FFTs
+       *
+       *  the plans already created are destroyed
+       *
+       *  @param nThreads the number of threads; if smaller than 1,
+       *  the maximum number of OpenMP threads is used
+       *
+       *  @return none
+       *
+       *  @warning the plans are destroyed inside the critical
+       *  section of the planner, but the function must not be called
+       *  while other threads are computing Fourier transforms
+       */
+      static void set_FFTW_nThreads (const int nThreads);
+
+      /**
+       *  @brief set the file of the FFTW wisdom
+       *
+       *  the wisdom is read from the file, if it exists, and the file
+       *  is updated every time a new plan is created
+       *
+       *  @param wisdom_file the name of the file; if empty, the
+       *  wisdom is not stored
+       *
+       *  @return none
+       */
+      static void set_FFTW_wisdom (const std::string wisdom_file);
+      
+      ///@}
+
+
       /**
        *  @name Member functions to set the private/protected members
        */
@@ -392,6 +468,21 @@ namespace cbl {
        * @return the value of the center of the cell along the z-axis 
        */    
       double kZ(const int i) const { return m_kZ[i];}
+
+      /**
+       * @brief get the window function of a mass assignment scheme
+       * at a cell in Fourier space
+       *
+       * @param i the i-th cell along the kx-axis
+       * @param j the j-th cell along the ky-axis
+       * @param k the k-th cell along the kz-axis
+       * @param assignment_type the mass assignment scheme: 0 &rarr;
+       * NGP; 1 &rarr; CIC; 2 &rarr; TSC; 3 &rarr; PCS
+       *
+       * @return the window function, i.e. the product along the
+       * three axes of sinc(k*delta/2)^(assignment_type+1)
+       */
+      double window_mass_assignment (const int i, const int j, const int k, const int assignment_type) const;
       
       /**
        * @brief get the value of the scalar field
@@ -540,6 +631,30 @@ namespace cbl {
       virtual void GaussianConvolutionField (const double kernel_size)
       { (void)kernel_size; ErrorCBL("Error in GaussianConvolutionField of Field3D"); }
 
+      /**
+       * @brief assign the objects to the grid with a mass assignment
+       * scheme, overwriting the field
+       *
+       * @param xx the x coordinates of the objects
+       * @param yy the y coordinates of the objects
+       * @param zz the z coordinates of the objects
+       * @param weight the weights of the objects; if empty, all the
+       * objects have unit weight
+       * @param assignment_type the mass assignment scheme: 0 &rarr;
+       * nearest-grid-point (NGP); 1 &rarr; cloud-in-cell (CIC); 2
+       * &rarr; triangular-shaped-cloud (TSC); 3 &rarr; piecewise
+       * cubic spline (PCS)
+       * @param interlacing true &rarr; assign the objects also on a
+       * grid shifted by half a cell, and average the two fields in
+       * Fourier space to reduce aliasing
+       * @param compensate true &rarr; divide the field in Fourier
+       * space by the window function of the mass assignment scheme
+       *
+       * @return none
+       */
+      virtual void assign_mass (const std::vector<double> &xx, const std::vector<double> &yy, const std::vector<double> &zz, const std::vector<double> &weight={}, const int assignment_type=0, const bool interlacing=false, const bool compensate=false)
+      { (void)xx; (void)yy; (void)zz; (void)weight; (void)assignment_type; (void)interlacing; (void)compensate; ErrorCBL("Error in assign_mass of Field3D"); }
+
       /**
        * @brief set the value of the scalar field
        * 
@@ -668,6 +783,28 @@ namespace cbl {
       /// fourier transform of the scalar field
       fftw_complex *m_field_FourierSpace;
 
+      /**
+       * @brief add the objects to a grid with a mass assignment
+       * scheme
+       *
+       * the grid is periodic, so the objects close to the bounds
+       * are assigned also to the cells on the opposite side
+       *
+       * @param xx the x coordinates of the objects
+       * @param yy the y coordinates of the objects
+       * @param zz the z coordinates of the objects
+       * @param weight the weights of the objects
+       * @param order the number of cells along each axis to which an
+       * object is assigned: 1 &rarr; NGP; 2 &rarr; CIC; 3 &rarr;
+       * TSC; 4 &rarr; PCS
+       * @param shift the shift of the objects, in units of the cell
+       * size
+       * @param field the grid
+       *
+       * @return none
+       */
+      void m_assign_mass (const std::vector<double> &xx, const std::vector<double> &yy, const std::vector<double> &zz, const std::vector<double> &weight, const int order, const double shift, double *field) const;
+
     public:
 
       /**
@@ -857,6 +994,33 @@ namespace cbl {
        */
       void GaussianConvolutionField (const double kernel_size);
 
+      /**
+       * @brief assign the objects to the grid with a mass assignment
+       * scheme, overwriting the field
+       *
+       * the objects are assigned in parallel; if interlacing or
+       * compensation are required, the field is set both in
+       * configuration and in Fourier space
+       *
+       * @param xx the x coordinates of the objects
+       * @param yy the y coordinates of the objects
+       * @param zz the z coordinates of the objects
+       * @param weight the weights of the objects; if empty, all the
+       * objects have unit weight
+       * @param assignment_type the mass assignment scheme: 0 &rarr;
+       * nearest-grid-point (NGP); 1 &rarr; cloud-in-cell (CIC); 2
+       * &rarr; triangular-shaped-cloud (TSC); 3 &rarr; piecewise
+       * cubic spline (PCS)
+       * @param interlacing true &rarr; assign the objects also on a
+       * grid shifted by half a cell, and average the two fields in
+       * Fourier space to reduce aliasing
+       * @param compensate true &rarr; divide the field in Fourier
+       * space by the window function of the mass assignment scheme
+       *
+       * @return none
+       */
+      void assign_mass (const std::vector<double> &xx, const std::vector<double> &yy, const std::vector<double> &zz, const std::vector<double> &weight={}, const int assignment_type=0, const bool interlacing=false, const bool compensate=false);
+
       /**
        * @brief set to 0 the fields
        *
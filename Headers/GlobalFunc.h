@@ -474,6 +474,9 @@ namespace cbl {
    * @brief compute the non linear displacements
    * of the density field
    *
+   * the displacements are set in the objects of the catalogues,
+   * that are shared with the catalogues provided in input
+   *
    * @param data the data catalogue
    *
    * @param random the random catalogue
@@ -499,7 +502,7 @@ namespace cbl {
    *
    * @return none
    */
-  void reconstruction_fourier_space(const catalogue::Catalogue data, const catalogue::Catalogue random, const bool random_RSD, const cosmology::Cosmology cosmology, const double redshift, const double bias, const double cell_size, const double smoothing_radius, const int interpolation_type=0);
+  void reconstruction_fourier_space (catalogue::Catalogue data, catalogue::Catalogue random, const bool random_RSD, const cosmology::Cosmology cosmology, const double redshift, const double bias, const double cell_size, const double smoothing_radius, const int interpolation_type=0);
 
   /**
    * @brief return a sample with objects displaced, according to the
@@ -0,0 +1,253 @@
+/********************************************************************
+ *  Copyright (C) 2010 by Federico Marulli and Alfonso Veropalumbo  *
+ *  federico.marulli3@unibo.it                                      *
+ *                                                                  *
+ *  This program is free software; you can redistribute it and/or   *
+ *  modify it under the terms of the GNU General Public License as  *
+ *  published by the Free Software Foundation; either version 2 of  *
+ *  the License, or (at your option) any later version.             *
+ *                                                                  *
+ *  This program is distributed in the hope that it will be useful, *
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of  *
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the   *
+ *  GNU General Public License for more details.                    *
+ *                                                                  *
+ *  You should have received a copy of the GNU General Public       *
+ *  License along with this program; if not, write to the Free      *
+ *  Software Foundation, Inc.,                                      *
+ *  59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.       *
+ *******************************************************************/
+
+/**
+ *  @file Headers/KDTree_Catalogue.h
+ *
+ *  @brief Implementation of the kd-tree data structure for catalogues
+ *
+ *  This file defines the interface of the class KDTree_Catalogue,
+ *  a tree-based alternative to the chain-mesh used to count pairs and
+ *  triplets
+ *
+ *  @authors Federico Marulli, Alfonso Veropalumbo
+ *
+ *  @authors federico.marulli3@unbo.it, alfonso.veropalumbo@unibo.it
+ */
+
+#include "ChainMesh_Catalogue.h"
+
+
+#ifndef __KDTREECAT__
+#define __KDTREECAT__
+
+
+namespace cbl {
+
+  namespace chainmesh {
+
+    /**
+     *  @enum SpatialIndex
+     *  @brief the spatial index used to search for close objects
+     */
+    enum class SpatialIndex {
+
+      /// chain-mesh: a regular grid of cells
+      _chainMesh_,
+
+      /// kd-tree: a binary tree of bounding boxes
+      _kdTree_
+
+    };
+
+    /**
+     * @brief return a vector containing the SpatialIndex names
+     * @return a vector containing the SpatialIndex names
+     */
+    inline std::vector<std::string> SpatialIndexNames () { return {"chainMesh", "kdTree"}; }
+
+    /**
+     * @brief cast an enum of type SpatialIndex from its index
+     * @param spatialIndexIndex the spatial index index
+     * @return object of class SpatialIndex
+     */
+    inline SpatialIndex SpatialIndexCast (const int spatialIndexIndex) { return castFromValue<SpatialIndex>(spatialIndexIndex); }
+
+    /**
+     * @brief cast an enum of type SpatialIndex from its name
+     * @param spatialIndexName the spatial index name
+     * @return object of class SpatialIndex
+     */
+    inline SpatialIndex SpatialIndexCast (const std::string spatialIndexName) { return castFromName<SpatialIndex>(spatialIndexName, SpatialIndexNames()); }
+
+    /**
+     *  @class KDTree_Catalogue KDTree_Catalogue.h
+     *  "Headers/KDTree_Catalogue.h"
+     *
+     *  @brief The class KDTree_Catalogue
+     *
+     *  This class is used to handle objects of type <EM>
+     *  KDTree_Catalogue </EM>. The objects of the catalogue are
+     *  recursively split at the median of the widest dimension of
+     *  their bounding box, until each node contains at most
+     *  leaf_size objects. The leaves play the role of the
+     *  chain-mesh cells: the objects are stored in a CellObjects
+     *  structure ordered by leaf and, inside each leaf, by
+     *  region. The leaves close to a leaf are found with a
+     *  single-tree query of its bounding box, descending from the
+     *  root and pruning the nodes whose bounding box is farther
+     *  than the maximum separation; this is not a dual-tree
+     *  traversal, since each leaf is queried independently. Only
+     *  non-empty leaves exist, so the memory scales as O(N) for any
+     *  survey geometry. Differently from the chain-mesh, the input
+     *  catalogue is not reordered.
+     */
+    class KDTree_Catalogue {
+
+    private:
+
+      /// pointer to catalogue used for the kd-tree
+      std::shared_ptr<catalogue::Catalogue> m_catalogue;
+
+      /// the maximum separation
+      double m_rMax;
+
+      /// the maximum number of objects in each leaf
+      long m_leaf_size;
+
+      /// the objects of the catalogue, ordered by leaf
+      CellObjects m_cellObjects;
+
+      /// the index in the catalogue of the objects of m_cellObjects
+      std::vector<long> m_index;
+
+      /// the bounding box of each node: {x<SUB>min</SUB>, x<SUB>max</SUB>, y<SUB>min</SUB>, y<SUB>max</SUB>, z<SUB>min</SUB>, z<SUB>max</SUB>}
+      std::vector<double> m_node_box;
+
+      /// the index of the first child of each node (the second child follows it), or -1 for the leaves
+      std::vector<long> m_node_child;
+
+      /// the leaf index of each node, or -1 for the internal nodes
+      std::vector<long> m_node_leaf;
+
+      /**
+       *  @brief split a node of the tree, recursively
+       *  @param node the node index
+       *  @param begin the position in m_index of the first object of
+       *  the node
+       *  @param end the position in m_index following the last object
+       *  of the node
+       *  @param coord the coordinates of the catalogue objects
+       *  @return none
+       */
+      void m_split (const long node, const long begin, const long end, const std::vector<std::vector<double>> &coord);
+
+      /**
+       *  @brief get the leaves whose bounding box is closer than
+       *  m_rMax to a box
+       *  @param box the box: {x<SUB>min</SUB>, x<SUB>max</SUB>,
+       *  y<SUB>min</SUB>, y<SUB>max</SUB>, z<SUB>min</SUB>,
+       *  z<SUB>max</SUB>}
+       *  @return vector containing the (sorted) indices of the leaves
+       */
+      std::vector<long> m_close_leaves (const double *box) const;
+
+    public:
+
+      /**
+       *  @brief default constructor
+       *  @return object of class KDTree_Catalogue
+       */
+      KDTree_Catalogue () = default;
+
+      /**
+       *  @brief constructor
+       *  @param cat pointer to an object of class Catalogue
+       *  @param rMax the maximum separation
+       *  @param leaf_size the maximum number of objects in each leaf
+       *  @return object of class KDTree_Catalogue
+       */
+      KDTree_Catalogue (std::shared_ptr<catalogue::Catalogue> cat, const double rMax, const long leaf_size=32)
+	{ set_par(cat, rMax, leaf_size); }
+
+      /**
+       *  @brief default destructor
+       *  @return none
+       */
+      ~KDTree_Catalogue () = default;
+
+      /**
+       *  @brief function that set parameters for the kd-tree
+       *  @param cat pointer to an object of class Catalogue
+       *  @param rMax the maximum separation
+       *  @param leaf_size the maximum number of objects in each leaf
+       *  @return none
+       */
+      void set_par (std::shared_ptr<catalogue::Catalogue> cat, const double rMax, const long leaf_size=32);
+
+      /**
+       *  @brief get the internal variable m_catalogue
+       *  @return the internal variable m_catalogue
+       */
+      std::shared_ptr<catalogue::Catalogue> catalogue () const { return m_catalogue; }
+
+      /**
+       *  @brief get the internal variable m_cellObjects
+       *  @return the objects of the catalogue used for the kd-tree,
+       *  ordered by leaf
+       */
+      const CellObjects & cellObjects () const { return m_cellObjects; }
+
+      /**
+       *  @brief get the number of leaves
+       *  @return the number of leaves
+       */
+      long nLeaves () const { return (long)m_cellObjects.nonEmpty_cells.size(); }
+
+      /**
+       *  @brief get the number of nodes
+       *  @return the number of nodes
+       */
+      long nNodes () const { return (long)m_node_leaf.size(); }
+
+      /**
+       *  @brief get the indices of the objects close to an object
+       *  @param center coordinates of an object
+       *  @param ii -1 &rarr; takes all close objects; ii > -1 &rarr;
+       *  takes only objects of index > ii
+       *  @return vector containing the catalogue indices of the
+       *  objects of the leaves closer than the maximum separation
+       */
+      std::vector<long> close_objects (const std::vector<double> center, const long ii=-1) const;
+
+      /**
+       *  @brief get the leaves close to a leaf of another set of
+       *  objects, with a single-tree query of the bounding box of
+       *  the leaf
+       *  @param objects1 the objects, ordered by leaf, of a tree
+       *  constructed with cell_objects, or the objects of this tree
+       *  @param index1 the index of the leaf of objects1
+       *  @return vector containing the (sorted) indices of the leaves
+       *  of this tree whose bounding box is closer than the maximum
+       *  separation to the bounding box of the leaf of objects1
+       */
+      std::vector<long> close_cells (const CellObjects &objects1, const long index1) const
+      { return m_close_leaves(&objects1.box[6*index1]); }
+
+      /**
+       *  @brief distribute the objects of a catalogue in the leaves
+       *  of a kd-tree with the same parameters of this one
+       *  @param cat pointer to an object of class Catalogue
+       *  @param required the variables needed to count the pairs; an
+       *  error is raised if any of them is not set
+       *  @return the objects of the input catalogue, ordered by leaf
+       */
+      CellObjects cell_objects (std::shared_ptr<catalogue::Catalogue> cat, const std::vector<catalogue::Var> required={}) const
+      {
+	CellObjects objects = KDTree_Catalogue(cat, m_rMax, m_leaf_size).cellObjects();
+	objects.check_variables(required);
+	return objects;
+      }
+
+    };
+  }
+}
+
+#endif
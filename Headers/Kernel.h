@@ -51,6 +51,8 @@
 #include <unistd.h>
 #include <random>
 #include <map>
+#include <deque>
+#include <array>
 #include <omp.h>
 #include <stdio.h>
 #include <time.h>
@@ -1155,6 +1157,43 @@ namespace cbl {
       return vect;
     }
 
+  /**
+   *  @brief sum the partial results of the threads of a parallel
+   *  region with a tree reduction
+   *
+   *  at each step, the threads whose number is a multiple of twice
+   *  the step sum into their partial result the one of the thread
+   *  step positions ahead, which is then released; the total is
+   *  obtained in partial[0] after log<SUB>2</SUB>(number of threads)
+   *  steps, instead of accumulating the partial results serially
+   *
+   *  @warning this function has to be called by all the threads of
+   *  the parallel region, after each thread has stored its partial
+   *  result in partial[omp_get_thread_num()]; partial has to be
+   *  shared among the threads
+   *
+   *  @param partial std::vector containing the partial result of
+   *  each thread
+   *  @param sum function that adds the second partial result to the
+   *  first one
+   *  @return none
+   */
+  template <typename T> 
+    void tree_reduction (std::vector<T> &partial, const std::function<void(T &, T &)> sum) 
+    {
+      const int nThreads = omp_get_num_threads();
+      const int tid = omp_get_thread_num();
+      
+#pragma omp barrier
+      for (int step=1; step<nThreads; step*=2) {
+	if (tid%(2*step)==0 && tid+step<nThreads) {
+	  sum(partial[tid], partial[tid+step]);
+	  partial[tid+step] = T();
+	}
+#pragma omp barrier
+      }
+    }
+
   /**
    *  @brief get the number of unique elements of a std::vector
    *  @param vect_input the input std::vector
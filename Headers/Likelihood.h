@@ -75,6 +75,9 @@ namespace cbl {
       /// log-likelihood function
       LogLikelihood_function m_log_likelihood_function;
 
+      /// log-likelihood function for several sets of parameters at once (not set for user-defined likelihoods)
+      LogLikelihood_batch_function m_log_likelihood_function_batch;
+
       /// likelihood function
       Likelihood_function m_likelihood_function;
 
@@ -94,6 +97,21 @@ namespace cbl {
       /// use grid
       bool m_use_grid = false;
 
+      /// the correction for the finite number of mock catalogues used to estimate the covariance
+      CovarianceCorrection m_covariance_correction = CovarianceCorrection::_None_;
+
+      /// the number of mock catalogues used to estimate the covariance
+      int m_nMocks = 0;
+
+      /**
+       * @brief set the likelihood inputs, computing the Cholesky
+       * factor of the covariance matrix if the likelihood type is
+       * LikelihoodType::_Gaussian_Covariance_
+       *
+       * @return none
+       */
+      void m_set_likelihood_inputs ();
+
       /**
        * @brief set the likelihood grid
        * and write the grid on a file
@@ -212,6 +230,21 @@ namespace cbl {
        */
       double log (std::vector<double> &pp) const;
 
+      /**
+       * @brief evaluate the log-likelihood for several sets of
+       * parameters
+       *
+       * if the batch log-likelihood function is available, the
+       * model is computed for all the sets of parameters at once;
+       * otherwise, the log-likelihood is computed for each set
+       *
+       * @param pp the sets of likelihood parameters
+       *
+       * @return the log-likelihood \f$ \log(\mathcal{L}) \f$ for
+       * each set of parameters
+       */
+      std::vector<double> log (std::vector<std::vector<double>> &pp) const;
+
       /**
        * @brief set the data for the likelihood analysis 
        *
@@ -279,6 +312,27 @@ namespace cbl {
        */
       void set_function (const LogLikelihood_function loglikelihood_function);
 
+      /**
+       * @brief set the correction for the finite number of mock
+       * catalogues used to estimate the covariance matrix
+       *
+       * the correction is applied once, when the Cholesky factor of
+       * the covariance matrix is computed; it is used only if the
+       * likelihood type is LikelihoodType::_Gaussian_Covariance_
+       *
+       * @param covariance_correction the covariance correction:
+       * CovarianceCorrection::_Hartlap_ &rarr; the inverse covariance
+       * is rescaled by \f$(N_{mocks}-N_{data}-2)/(N_{mocks}-1)\f$;
+       * CovarianceCorrection::_SellentinHeavens_ &rarr; the Gaussian
+       * likelihood is replaced by \f$\log\mathcal{L} =
+       * -N_{mocks}/2\,\log[1+\chi^2/(N_{mocks}-1)]\f$
+       *
+       * @param nMocks the number of mock catalogues
+       *
+       * @return none
+       */
+      void set_covariance_correction (const CovarianceCorrection covariance_correction, const int nMocks);
+
       /**
        *  @brief write best-fit results on a file
        *
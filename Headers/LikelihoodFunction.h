@@ -107,6 +107,49 @@ namespace cbl {
      */
     inline std::vector<LikelihoodType> LikelihoodTypeCast (const std::vector<std::string> likelihoodTypeNames) {return castFromNames<LikelihoodType>(likelihoodTypeNames, LikelihoodTypeNames());}
 
+    /**
+     * @enum CovarianceCorrection
+     * @brief the correction applied to the Gaussian likelihood when
+     * the covariance matrix is estimated from a finite number of mock
+     * catalogues
+     */
+    enum class CovarianceCorrection {
+
+      /// no correction
+      _None_,
+
+      /// the inverse covariance is rescaled by \f$(N_{mocks}-N_{data}-2)/(N_{mocks}-1)\f$ (Hartlap et al. 2007)
+      _Hartlap_,
+
+      /// the Gaussian likelihood is replaced by a modified t-distribution (Sellentin & Heavens 2016)
+      _SellentinHeavens_
+
+    };
+
+    /**
+     * @brief return a vector containing the
+     * CovarianceCorrection names
+     * @return a vector containing the
+     * CovarianceCorrection names
+     */
+    inline std::vector<std::string> CovarianceCorrectionNames () {return {"None", "Hartlap", "SellentinHeavens"}; }
+
+    /**
+     * @brief cast an enum of type CovarianceCorrection
+     * from its index
+     * @param covarianceCorrectionIndex the covarianceCorrection index
+     * @return object of class CovarianceCorrection
+     */
+    inline CovarianceCorrection CovarianceCorrectionCast (const int covarianceCorrectionIndex) {return castFromValue<CovarianceCorrection>(covarianceCorrectionIndex);}
+
+    /**
+     * @brief cast an enum of type CovarianceCorrection
+     * from its name
+     * @param covarianceCorrectionName the covarianceCorrection name
+     * @return object of class CovarianceCorrection
+     */
+    inline CovarianceCorrection CovarianceCorrectionCast (const std::string covarianceCorrectionName) {return castFromName<CovarianceCorrection>(covarianceCorrectionName, CovarianceCorrectionNames());}
+
     /**
      * @struct STR_likelihood_inputs
      * @brief the struct STR_likelihood_inputs
@@ -140,6 +183,15 @@ namespace cbl {
       /// interpolated likelihood function - 2D
       std::shared_ptr<glob::FuncGrid2D> interp_function2D;
 
+      /// lower triangular Cholesky factor L of the covariance matrix, \f$C=LL^T\f$
+      Eigen::MatrixXd cholesky_covariance;
+
+      /// the correction for the finite number of mock catalogues used to estimate the covariance
+      CovarianceCorrection covariance_correction = CovarianceCorrection::_None_;
+
+      /// the number of mock catalogues used to estimate the covariance
+      int nMocks = 0;
+
       /**
        *  @brief constructor
        *  
@@ -151,6 +203,50 @@ namespace cbl {
        *  @return object of type STR_likelihood_inputs
        */ 
       STR_likelihood_inputs (const std::shared_ptr<data::Data> input_data, const std::shared_ptr<Model> input_model, const std::vector<size_t> input_x_index={0, 2}, const int input_w_index=-1); 
+
+      /**
+       *  @brief compute the Cholesky factor of the covariance matrix
+       *
+       *  the factorization is done once, so that the Gaussian
+       *  likelihood is computed solving a triangular system at each
+       *  evaluation, instead of multiplying by the inverse covariance
+       *  matrix
+       *
+       *  @param correction the correction for the finite number of
+       *  mock catalogues used to estimate the covariance
+       *  @param n_mocks the number of mock catalogues (used only if
+       *  a correction is applied)
+       *
+       *  @return none
+       */
+      void set_cholesky_covariance (const CovarianceCorrection correction=CovarianceCorrection::_None_, const int n_mocks=0);
+
+      /**
+       *  @brief compute the Gaussian log-likelihood from the
+       *  difference between data and model, using the Cholesky factor
+       *  of the covariance matrix
+       *
+       *  @param diff the difference between data and model; it is
+       *  overwritten by the whitened difference \f$L^{-1}(d-m)\f$
+       *
+       *  @return the value of the loglikelihood
+       */
+      double LogLikelihood_covariance (Eigen::VectorXd &diff) const;
+
+      /**
+       *  @brief compute the Gaussian log-likelihood for several sets
+       *  of parameters, from the differences between data and
+       *  models, using the Cholesky factor of the covariance matrix
+       *
+       *  the triangular system is solved once for all the columns
+       *
+       *  @param diff the differences between data and models, one
+       *  column for each set of parameters; it is overwritten by the
+       *  whitened differences \f$L^{-1}(d-m)\f$
+       *
+       *  @return the values of the loglikelihood
+       */
+      std::vector<double> LogLikelihood_covariance (Eigen::MatrixXd &diff) const;
       
     };
 
@@ -211,6 +307,15 @@ namespace cbl {
      */
     double LogLikelihood_Gaussian_2D_error (std::vector<double> &likelihood_parameters, const std::shared_ptr<void> inputs);
 
+    /** 
+     *  @brief function to compute the gaussian loglikelihood 
+     *  with the covariance matrix, for 2D datasets
+     *  @param likelihood_parameters the parameters of the model
+     *  @param inputs pointer to an object of type STR_params
+     *  @return the value of the loglikelihood 
+     */
+    double LogLikelihood_Gaussian_2D_covariance (std::vector<double> &likelihood_parameters, const std::shared_ptr<void> inputs);
+
     /** 
      *  @brief function to compute the poissonian loglikelihood 
      *  @param likelihood_parameters the parameters of the model
@@ -227,6 +332,37 @@ namespace cbl {
      */
     double LogLikelihood_Poissonian_2D_ (std::vector<double> &likelihood_parameters, const std::shared_ptr<void> inputs);
 
+    /** 
+     *  @brief function to compute the gaussian loglikelihood for
+     *  several sets of parameters at once
+     *  @param likelihood_parameters the sets of parameters of the
+     *  model
+     *  @param inputs pointer to an object of type STR_params
+     *  @return the values of the loglikelihood 
+     */
+    std::vector<double> LogLikelihood_Gaussian_1D_error_batch (std::vector<std::vector<double>> &likelihood_parameters, const std::shared_ptr<void> inputs);
+
+    /** 
+     *  @brief function to compute the gaussian loglikelihood with
+     *  the covariance matrix for several sets of parameters at once
+     *  @param likelihood_parameters the sets of parameters of the
+     *  model
+     *  @param inputs pointer to an object of type STR_params
+     *  @return the values of the loglikelihood 
+     */
+    std::vector<double> LogLikelihood_Gaussian_1D_covariance_batch (std::vector<std::vector<double>> &likelihood_parameters, const std::shared_ptr<void> inputs);
+
+    /** 
+     *  @brief function to compute the gaussian loglikelihood with
+     *  the covariance matrix, for 2D datasets, for several sets of
+     *  parameters at once
+     *  @param likelihood_parameters the sets of parameters of the
+     *  model
+     *  @param inputs pointer to an object of type STR_params
+     *  @return the values of the loglikelihood 
+     */
+    std::vector<double> LogLikelihood_Gaussian_2D_covariance_batch (std::vector<std::vector<double>> &likelihood_parameters, const std::shared_ptr<void> inputs);
+
     /**
      * @var typedef LogLikelihood_function
      * @brief definition of a function for computation of 
@@ -234,6 +370,13 @@ namespace cbl {
      */
     typedef std::function<double (std::vector<double> &, const std::shared_ptr<void>)> LogLikelihood_function;
 
+    /**
+     * @var typedef LogLikelihood_batch_function
+     * @brief definition of a function for computation of 
+     * the LogLikelihood for several sets of parameters at once
+     */
+    typedef std::function<std::vector<double> (std::vector<std::vector<double>> &, const std::shared_ptr<void>)> LogLikelihood_batch_function;
+
     /**
      * @var typedef Likelihood_function
      * @brief definition of a function for computation of 
@@ -0,0 +1,99 @@
+/*******************************************************************
+ *  Copyright (C) 2010 by Federico Marulli                         *
+ *  federico.marulli3@unibo.it                                     *
+ *                                                                 *
+ *  This program is free software; you can redistribute it and/or  *
+ *  modify it under the terms of the GNU General Public License as *
+ *  published by the Free Software Foundation; either version 2 of *
+ *  the License, or (at your option) any later version.            *
+ *                                                                 *
+ *  This program is distributed in the hope that it will be useful,*
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of *
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the  *
+ *  GNU General Public License for more details.                   *
+ *                                                                 *
+ *  You should have received a copy of the GNU General Public      *
+ *  License along with this program; if not, write to the Free     *
+ *  Software Foundation, Inc.,                                     *
+ *  59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.      *
+ *******************************************************************/
+
+/**
+ *  @file Headers/MPIwrapper.h
+ *
+ *  @brief functions that wrap the MPI routines used to distribute
+ *  the computation across different tasks
+ *
+ *  This file contains the wrappers of the MPI routines. The MPI
+ *  calls are compiled only if the library is compiled with the flag
+ *  -DUSE_MPI (e.g. with make ALL_MPI); otherwise, or if MPI has not
+ *  been initialised by the calling code, the functions behave as if
+ *  there was a single task
+ *
+ *  @author Federico Marulli
+ *
+ *  @author federico.marulli3@unbo.it
+ */
+
+#ifndef __MPIwrap__
+#define __MPIwrap__
+
+#include "Kernel.h"
+
+namespace cbl {
+
+  namespace wrapper {
+
+    /**
+     *  @brief The namespace of the <B> MPI wrappers </B>
+     *
+     *  The \e mpi namespace contains all the wrapper functions of
+     *  the MPI routines
+     */
+    namespace mpi {
+
+      /**
+       *  @brief check whether the computation is distributed across
+       *  different tasks
+       *  @return true &rarr; the library has been compiled with MPI,
+       *  MPI has been initialised and there is more than one task;
+       *  false &rarr; otherwise
+       */
+      bool distributed ();
+
+      /**
+       *  @brief get the index of the task
+       *  @return the index of the task in MPI_COMM_WORLD, or 0 if
+       *  the computation is not distributed
+       */
+      int rank ();
+
+      /**
+       *  @brief get the number of tasks
+       *  @return the number of tasks in MPI_COMM_WORLD, or 1 if the
+       *  computation is not distributed
+       */
+      int size ();
+
+      /**
+       *  @brief gather vectors of any size from all the tasks
+       *  @param data the vector of this task
+       *  @return vector containing the vectors of all the tasks,
+       *  ordered by task index
+       */
+      std::vector<std::vector<double>> allgather (const std::vector<double> &data);
+
+      /**
+       *  @brief exchange vectors of any size between all the tasks
+       *  @param data the vectors to be sent: data[i] is sent to the
+       *  i-th task
+       *  @return vector containing the vectors received from all the
+       *  tasks, ordered by task index
+       */
+      std::vector<std::vector<double>> alltoall (const std::vector<std::vector<double>> &data);
+
+    }
+  }
+}
+
+#endif
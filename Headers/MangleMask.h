@@ -0,0 +1,253 @@
+/********************************************************************
+ *  Copyright (C) 2010 by Federico Marulli and Alfonso Veropalumbo  *
+ *  federico.marulli3@unibo.it                                      *
+ *                                                                  *
+ *  This program is free software; you can redistribute it and/or   *
+ *  modify it under the terms of the GNU General Public License as  *
+ *  published by the Free Software Foundation; either version 2 of  *
+ *  the License, or (at your option) any later version.             *
+ *                                                                  *
+ *  This program is distributed in the hope that it will be useful, *
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of  *
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the   *
+ *  GNU General Public License for more details.                    *
+ *                                                                  *
+ *  You should have received a copy of the GNU General Public       *
+ *  License along with this program; if not, write to the Free      *
+ *  Software Foundation, Inc.,                                      *
+ *  59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.       *
+ *******************************************************************/
+
+/**
+ *  @file Headers/MangleMask.h
+ *
+ *  @brief The class MangleMask
+ *
+ *  This file defines the interface of the class MangleMask, used to
+ *  handle angular masks in the mangle polygon format
+ *
+ *  @authors Federico Marulli, Alfonso Veropalumbo
+ *
+ *  @authors federico.marulli3@unbo.it, alfonso.veropalumbo@unibo.it
+ */
+
+#ifndef __MANGLEMASK__
+#define __MANGLEMASK__
+
+#include "Kernel.h"
+
+
+namespace cbl {
+
+  namespace catalogue {
+
+    /**
+     *  @class MangleMask MangleMask.h "Headers/MangleMask.h"
+     *
+     *  @brief The class MangleMask
+     *
+     *  This class is used to handle angular masks in the mangle
+     *  polygon format (Swanson et al. 2008). Each polygon is the
+     *  intersection of spherical caps, and has a weight. The sky is
+     *  divided in pixels of equal area, each one storing the
+     *  polygons that may overlap with it, so that the polygon
+     *  containing a given direction is found testing only a few
+     *  polygons. This class replaces the mangle executables
+     *  <EM>polyid</EM> and <EM>ransack</EM>
+     *
+     *  The angular coordinates are in radians
+     */
+    class MangleMask {
+
+    private:
+
+      /**
+       *  @struct Polygon
+       *  @brief a mangle polygon
+       */
+      struct Polygon {
+
+	/// the polygon identification number
+	long id;
+
+	/// the polygon weight
+	double weight;
+
+	/// the polygon area (in steradians)
+	double area;
+
+	/// the caps: unit vector (x, y, z) and 1-cos(&theta;), where &theta; is the cap radius
+	std::vector<std::array<double, 4>> cap;
+
+	/// the centre of the smallest cap, that contains the polygon
+	std::array<double, 3> centre;
+
+	/// the 1-cos(&theta;) of the smallest cap, that contains the polygon
+	double cm;
+
+      };
+
+      /// the polygons
+      std::vector<Polygon> m_polygon;
+
+      /// the number of pixels in cos(&theta;)
+      int m_nTheta = 0;
+
+      /// the number of pixels in &phi;
+      int m_nPhi = 0;
+
+      /// the index of the first polygon of each pixel in m_pixel_polygon
+      std::vector<size_t> m_pixel_start;
+
+      /// the polygons of all the pixels
+      std::vector<int> m_pixel_polygon;
+
+      /**
+       *  @brief read the polygons from a file
+       *  @param file the name of the file
+       *  @return none
+       */
+      void m_read (const std::string file);
+
+      /**
+       *  @brief store the polygons that may overlap with each pixel
+       *  @return none
+       */
+      void m_pixelize ();
+
+      /**
+       *  @brief get the pixel that contains a direction
+       *  @param vv the unit vector of the direction
+       *  @return the pixel index
+       */
+      int m_pixel (const std::array<double, 3> &vv) const;
+
+      /**
+       *  @brief check if a direction is inside a polygon
+       *  @param pp the polygon
+       *  @param vv the unit vector of the direction
+       *  @return true if the direction is inside the polygon; false
+       *  otherwise
+       */
+      bool m_inside (const Polygon &pp, const std::array<double, 3> &vv) const;
+
+      /**
+       *  @brief get the polygon that contains a direction
+       *  @param vv the unit vector of the direction
+       *  @return the index of the polygon in m_polygon, or -1 if the
+       *  direction is outside the mask
+       */
+      int m_find (const std::array<double, 3> &vv) const;
+
+    public:
+
+      /**
+       *  @name Constructors/destructors
+       */
+      ///@{
+
+      /**
+       *  @brief default constructor
+       *  @return object of class MangleMask
+       */
+      MangleMask () = default;
+
+      /**
+       *  @brief constructor that reads the polygons from files
+       *  @param file vector containing the names of the files in the
+       *  mangle polygon format
+       *  @param nTheta the number of pixels in cos(&theta;); the
+       *  number of pixels in &phi; is 2*nTheta
+       *  @return object of class MangleMask
+       */
+      MangleMask (const std::vector<std::string> file, const int nTheta=256);
+
+      /**
+       *  @brief default destructor
+       *  @return none
+       */
+      ~MangleMask () = default;
+
+      ///@}
+
+
+      /**
+       *  @name Functions to get the properties of the mask
+       */
+      ///@{
+
+      /**
+       *  @brief get the number of polygons
+       *  @return the number of polygons
+       */
+      size_t nPolygons () const { return m_polygon.size(); }
+
+      /**
+       *  @brief get the total area of the polygons
+       *  @return the area (in steradians)
+       */
+      double area () const;
+
+      /**
+       *  @brief get the identification number of the polygon that
+       *  contains a direction
+       *  @param ra the Right Ascension
+       *  @param dec the Declination
+       *  @return the polygon identification number, or -1 if the
+       *  direction is outside the mask
+       */
+      long polygon (const double ra, const double dec) const;
+
+      /**
+       *  @brief get the identification numbers of the polygons that
+       *  contain some directions
+       *  @param ra the Right Ascensions
+       *  @param dec the Declinations
+       *  @return vector containing the polygon identification
+       *  numbers, or -1 for the directions outside the mask
+       */
+      std::vector<long> polygon (const std::vector<double> &ra, const std::vector<double> &dec) const;
+
+      /**
+       *  @brief get the weight of the mask in a direction
+       *  @param ra the Right Ascension
+       *  @param dec the Declination
+       *  @return the weight of the polygon that contains the
+       *  direction, or 0 if the direction is outside the mask
+       */
+      double weight (const double ra, const double dec) const;
+
+      /**
+       *  @brief get the weights of the mask in some directions
+       *  @param ra the Right Ascensions
+       *  @param dec the Declinations
+       *  @return vector containing the weights of the polygons that
+       *  contain the directions, or 0 for the directions outside the
+       *  mask
+       */
+      std::vector<double> weight (const std::vector<double> &ra, const std::vector<double> &dec) const;
+
+      ///@}
+
+
+      /**
+       *  @brief generate random directions inside the mask
+       *
+       *  the number of directions in each polygon is proportional
+       *  to its area times its weight; the directions are generated
+       *  in parallel, in blocks with their own seed, so that they do
+       *  not depend on the number of threads
+       *
+       *  @param [out] ra the Right Ascensions
+       *  @param [out] dec the Declinations
+       *  @param [in] nRandom the number of random directions
+       *  @param [in] seed the seed for random number generation
+       *  @return none
+       */
+      void random_directions (std::vector<double> &ra, std::vector<double> &dec, const size_t nRandom, const int seed=3213) const;
+
+    };
+  }
+}
+
+#endif
@@ -129,6 +129,112 @@ namespace cbl {
     inline std::vector<ErrorType> ErrorTypeCast (const std::vector<std::string> errorTypeNames)
     { return castFromNames<ErrorType>(errorTypeNames, ErrorTypeNames()); }
 
+    /**
+     *  @class ProgressReporter Measure.h
+     *  "Headers/Measure.h"
+     *
+     *  @brief The class ProgressReporter
+     *
+     *  This class is used to show the progress of the parallel loops
+     *  used to count pairs and triplets. The threads add the work
+     *  done at each iteration with an atomic update, while only the
+     *  thread 0 writes the progress, at most once per time interval,
+     *  so that the cost of the reporter in the loops is negligible
+     */
+    class ProgressReporter {
+
+    private:
+
+      /// the total work
+      double m_total;
+
+      /// the work done
+      double m_done = 0.;
+
+      /// true &rarr; show the percentage of work done
+      bool m_tcount;
+
+      /// true &rarr; show when 25%, 50% and 75% of the work are done
+      bool m_verbose;
+
+      /// the minimum time interval (in seconds) between two updates of the percentage of work done
+      double m_interval;
+
+      /// the starting time
+      double m_start;
+
+      /// the time of the last update of the percentage of work done
+      double m_last;
+
+      /// the number of quarters of the work already reported
+      int m_quarter = 0;
+
+      /// the prefix of the messages of the quarters of the work
+      std::string m_prefix;
+
+    public:
+
+      /**
+       *  @brief constructor
+       *  @param total the total work
+       *  @param tcount true &rarr; show the percentage of work done
+       *  @param verbose true &rarr; show when 25%, 50% and 75% of the
+       *  work are done
+       *  @param prefix the prefix of the messages of the quarters of
+       *  the work
+       *  @param interval the minimum time interval (in seconds)
+       *  between two updates of the percentage of work done
+       *  @return object of class ProgressReporter
+       */
+      ProgressReporter (const double total, const bool tcount, const bool verbose=true, const std::string prefix=".............", const double interval=1.)
+	: m_total(total), m_tcount(tcount), m_verbose(verbose), m_interval(interval), m_start(omp_get_wtime()), m_last(m_start), m_prefix(prefix) {}
+
+      /**
+       *  @brief default destructor
+       *  @return none
+       */
+      ~ProgressReporter () = default;
+
+      /**
+       *  @brief add the work done by a thread, and show the progress
+       *  if the thread is the thread 0
+       *  @param work the work done
+       *  @param tid the thread number
+       *  @return none
+       */
+      void update (const double work, const int tid)
+      {
+#pragma omp atomic
+	m_done += work;
+
+	if (tid!=0) return;
+
+	double done;
+#pragma omp atomic read
+	done = m_done;
+
+	if (m_tcount) {
+	  const double now = omp_get_wtime();
+	  if (now-m_last>=m_interval) {
+	    coutCBL << "\r" << 100.*done/m_total << "% completed (" << now-m_start << " seconds)\r"; std::cout.flush();
+	    m_last = now;
+	  }
+	}
+
+	while (m_verbose && m_quarter<3 && done>=0.25*(m_quarter+1)*m_total) {
+	  m_quarter ++;
+	  coutCBL << m_prefix << 25*m_quarter << "% completed" << std::endl;
+	}
+      }
+
+      /**
+       *  @brief get the time spent since the construction
+       *  @return the time spent (in seconds)
+       */
+      double time () const { return omp_get_wtime()-m_start; }
+
+    };
+    
     /**
      *  @class Measure Measure.h
      *  "Headers/Measure.h"
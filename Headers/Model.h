@@ -71,6 +71,33 @@ namespace cbl {
      */
     typedef std::function<std::vector<std::vector<double>>(std::vector<std::vector<double>>, std::shared_ptr<void>, std::vector<double> &)> model_function_generic;
 
+    /**
+     *  @brief 1D function computed for several sets of parameters at
+     *  once: the inputs are a vector of values at which the function
+     *  is computed, a pointer to a set of data used to construct the
+     *  function and the sets of parameters; it returns the function
+     *  for each set of parameters
+     */
+    typedef std::function<std::vector<std::vector<double>>(std::vector<double>, std::shared_ptr<void>, std::vector<std::vector<double>> &)> model_function_1D_batch;
+
+    /**
+     *  @brief 2D function computed for several sets of parameters at
+     *  once: the inputs are the values at which the function is
+     *  computed, a pointer to a set of data used to construct the
+     *  function and the sets of parameters; it returns the function
+     *  for each set of parameters
+     */
+    typedef std::function<std::vector<std::vector<std::vector<double>>>(std::vector<double>, std::vector<double>, std::shared_ptr<void>, std::vector<std::vector<double>> &)> model_function_2D_batch;
+
+    /**
+     *  @brief generic function computed for several sets of
+     *  parameters at once: the inputs are the values at which the
+     *  function is computed, a pointer to a set of data used to
+     *  construct the function and the sets of parameters; it returns
+     *  the function for each set of parameters
+     */
+    typedef std::function<std::vector<std::vector<std::vector<double>>>(std::vector<std::vector<double>>, std::shared_ptr<void>, std::vector<std::vector<double>> &)> model_function_generic_batch;
+
     /**
      *  @class Model Model.h "Headers/Model.h"
      *
@@ -91,6 +118,9 @@ namespace cbl {
       /// the model function
       model_function_generic m_function;
 
+      /// the model function computed for several sets of parameters at once (optional)
+      model_function_generic_batch m_function_batch;
+
       /// the model dimension
       Dim m_dimension;
 
@@ -160,6 +190,14 @@ namespace cbl {
       void set_function (const model_function_2D function)
       { (void)function; ErrorCBL("Error in set_function() of Model.h!"); } 
 
+      /**
+       *  @brief check if the model function can be computed for
+       *  several sets of parameters at once
+       *  @return true if the batch model function is set; false
+       *  otherwise
+       */
+      bool has_function_batch () const { return (m_function_batch!=nullptr); }
+
       /**
        *  @brief set the model inputs
        *
@@ -218,6 +256,24 @@ namespace cbl {
        */
       std::vector<std::vector<double>> operator () (const std::vector<std::vector<double>> xx, std::vector<double> &parameters) const;
 
+      /**
+       * @brief evaluate the model function at xx for several sets
+       * of parameters
+       *
+       * if the batch model function is set, the model is computed
+       * for all the sets of parameters with a single call, so that
+       * the quantities that do not depend on the parameters are
+       * computed once; otherwise, the model function is called for
+       * each set of parameters
+       *
+       * @param xx vector containing the positions at which the model 
+       * is computed
+       * @param parameters the sets of model parameters
+       * @return vector containing the model values for each set of
+       * parameters
+       */
+      std::vector<std::vector<std::vector<double>>> operator () (const std::vector<std::vector<double>> xx, std::vector<std::vector<double>> &parameters) const;
+
       /**
        * @brief evaluate the model function at xx, for Model1D
        *
@@ -244,6 +300,18 @@ namespace cbl {
       virtual std::vector<double> operator () (const std::vector<double> xx, std::vector<double> &parameters) const
       { (void)xx; (void)parameters; ErrorCBL("Error in operator() of Model.h!"); std::vector<double> vv; return vv; } 
 
+      /**
+       * @brief evaluate the model function at xx for several sets
+       * of parameters, for Model1D
+       * @param xx vector containing the positions at which the
+       * model is computed
+       * @param parameters the sets of model parameters
+       * @return vector containing model values for each set of
+       * parameters
+       */
+      virtual std::vector<std::vector<double>> operator () (const std::vector<double> xx, std::vector<std::vector<double>> &parameters) const
+      { (void)xx; (void)parameters; ErrorCBL("Error in operator() of Model.h!"); std::vector<std::vector<double>> vv; return vv; } 
+
       /**
        * @brief evaluate the model function at xx, yy, for Model2D
        *
@@ -274,6 +342,20 @@ namespace cbl {
       virtual std::vector<std::vector<double>> operator () (const std::vector<double> xx, const std::vector<double> yy, std::vector<double> &parameters) const
       { (void)xx; (void)yy; (void)parameters; ErrorCBL("Error in operator() of Model.h!"); std::vector<std::vector<double>> vv; return vv; } 
 
+      /**
+       *  @brief evaluate the model function at xx, yy for several
+       *  sets of parameters, for Model2D
+       *  @param xx vector containing the positions at which the
+       *  model is computed
+       *  @param yy vector containing the positions at which the
+       *  model is computed
+       *  @param parameters the sets of model parameters
+       *  @return vector containing model values for each set of
+       *  parameters
+       */
+      virtual std::vector<std::vector<std::vector<double>>> operator () (const std::vector<double> xx, const std::vector<double> yy, std::vector<std::vector<double>> &parameters) const
+      { (void)xx; (void)yy; (void)parameters; ErrorCBL("Error in operator() of Model.h!"); std::vector<std::vector<std::vector<double>>> vv; return vv; } 
+
       /**
        *  @brief compute the median and percentiles of the model
        *  from MCMC chains
@@ -109,6 +109,15 @@ namespace cbl {
        */
       void set_function (const model_function_1D function);
 
+      /**
+       * @brief set the model function computed for several sets of
+       * parameters at once
+       * @param function_batch the model function: it takes the sets
+       * of parameters and returns the model for each of them
+       * @return none 
+       */
+      void set_function_batch (const model_function_1D_batch function_batch);
+
       /**
        * @brief evaluate the model function at xx
        *
@@ -141,6 +150,17 @@ namespace cbl {
 	return Model::operator()(xvec, parameters)[0];
       }
 
+      /**
+       * @brief evaluate the model function at xx for several sets
+       * of parameters
+       * @param xx vector containing the positions at which the model 
+       * is computed
+       * @param parameters the sets of model parameters
+       * @return vector containing model values for each set of
+       * parameters
+       */
+      std::vector<std::vector<double>> operator () (const std::vector<double> xx, std::vector<std::vector<double>> &parameters) const override;
+
       /**
        *  @brief compute the median and percentiles of the model
        *  from MCMC chains
@@ -195,6 +195,31 @@ namespace cbl {
        */
       std::vector<double> xi0_linear_sigma8_bias (const std::vector<double> rad, const std::shared_ptr<void> inputs, std::vector<double> &parameter);
 
+      /**
+       *  @brief model for the monopole of the two-point correlation
+       *  function in redshift space, computed for several sets of
+       *  parameters at once
+       *
+       *  the function computes the same model as
+       *  cbl::modelling::twopt::xi0_linear_sigma8_bias; the dark
+       *  matter two-point correlation function, which does not
+       *  depend on the parameters, is computed only once for all the
+       *  sets of parameters
+       *
+       *  @param rad the scale at which the model is computed
+       *
+       *  @param inputs pointer to the structure that contains the
+       *  cosmological paramters used to compute the dark matter
+       *  two-point correlation function
+       *
+       *  @param parameter vector containing the sets of parameters:
+       *  \f$\sigma_8(z)\f$ and the linear bias
+       *
+       *  @return the monopole of the two-point correlation function
+       *  for each set of parameters
+       */
+      std::vector<std::vector<double>> xi0_linear_sigma8_bias_batch (const std::vector<double> rad, const std::shared_ptr<void> inputs, std::vector<std::vector<double>> &parameter);
+
       
       /**
        *  @brief model for the monopole of the two-point correlation
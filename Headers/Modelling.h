@@ -421,6 +421,31 @@ namespace cbl {
          */
         void sample_posterior (const int chain_size, const int nwalkers, const std::string input_dir, const std::string input_file, const int seed=34123, const double aa=2, const bool parallel=true);
 
+        /**
+         * @brief sample the posterior and compute the evidence with
+         * the nested sampler
+	 *
+	 * the posterior samples are stored as a chain with one
+	 * walker, and the evidence can be obtained with
+	 * posterior()->log_evidence()
+         *
+         * @param nlive the number of live points
+         *
+         * @param dlogz the tolerance on the logarithm of the
+         * evidence, used to stop the sampling
+         *
+         * @param nsteps the number of steps of the constrained walks
+         * used to draw the new live points
+         *
+         * @param nparallel the number of live points replaced at
+         * each iteration; if 0, it is the number of OpenMP threads
+         *
+         * @param seed the seed
+         *
+         * @return none
+         */
+        void sample_posterior_nested (const int nlive=500, const double dlogz=0.1, const int nsteps=20, const int nparallel=0, const int seed=34123);
+
         /**
          * @brief write the chains obtained after 
          * the MCMC sampling
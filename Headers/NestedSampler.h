@@ -0,0 +1,296 @@
+/********************************************************************
+ *  Copyright (C) 2014 by Federico Marulli and Alfonso Veropalumbo  *
+ *  federico.marulli3@unibo.it                                      *
+ *                                                                  *
+ *  This program is free software; you can redistribute it and/or   *
+ *  modify it under the terms of the GNU General Public License as  *
+ *  published by the Free Software Foundation; either version 2 of  *
+ *  the License, or (at your option) any later version.             *
+ *                                                                  *
+ *  This program is distributed in the hope that it will be useful, *
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of  *
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the   *
+ *  GNU General Public License for more details.                    *
+ *                                                                  *
+ *  You should have received a copy of the GNU General Public       *
+ *  License along with this program; if not, write to the Free      *
+ *  Software Foundation, Inc.,                                      *
+ *  59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.       *
+ ********************************************************************/
+
+/**
+ *  @file Headers/NestedSampler.h
+ *
+ *  @brief The class NestedSampler
+ *
+ *  This file defines the interface of the class NestedSampler, used
+ *  to sample the posterior and compute the Bayesian evidence with
+ *  the nested sampling algorithm
+ *
+ *  @authors Federico Marulli, Alfonso Veropalumbo
+ *
+ *  @authors federico.marulli3@unbo.it, alfonso.veropalumbo@unibo.it
+ */
+
+#ifndef __NESTEDSAMP__
+#define __NESTEDSAMP__
+
+#include "RandomNumbers.h"
+
+
+// ============================================================================================
+
+
+namespace cbl {
+
+  namespace statistics {
+
+    /**
+     *  @class NestedSampler NestedSampler.h "Headers/NestedSampler.h"
+     *
+     *  @brief The class NestedSampler
+     *
+     *  This class implements the nested sampling algorithm (Skilling
+     *  2006): a set of live points, drawn from the prior, is evolved
+     *  replacing the points with the lowest likelihood with new points
+     *  drawn from the prior, constrained to have a higher likelihood,
+     *  so that the prior volume shrinks exponentially towards the
+     *  regions of high likelihood. The discarded points, weighted by
+     *  the prior volume they represent, provide the Bayesian evidence
+     *  and the posterior samples.
+     *
+     *  At each iteration, the \f$k\f$ live points with the lowest
+     *  likelihood are replaced in parallel (Henderson & Goggans 2014):
+     *  the prior volume associated to the \f$j\f$-th discarded point
+     *  shrinks by the factor \f$\exp[-1/(n_{\rm live}-j)]\f$, and all
+     *  the new points are constrained above the highest likelihood
+     *  among the discarded ones.
+     *
+     *  The new points are obtained with a Metropolis-Hastings walk on
+     *  the prior, constrained above the likelihood threshold, starting
+     *  from a random live point and proposing differential-evolution
+     *  moves \f$\vec{x}' = \vec{x}+\gamma(\vec{x}_a-\vec{x}_b)\f$,
+     *  where \f$\vec{x}_a\f$ and \f$\vec{x}_b\f$ are two random live
+     *  points (ter Braak 2006): the proposals follow the shape of the
+     *  constrained prior, and the moves with \f$\gamma=1\f$ let the
+     *  walk jump between separated modes. Only the free parameters
+     *  are moved, while the other ones (e.g. the fixed and the
+     *  derived parameters) are left to the likelihood. The random
+     *  numbers are drawn from counter-based streams, and the number
+     *  of points replaced at each iteration is fixed, so that the
+     *  results do not depend on the number of threads.
+     */
+    class NestedSampler
+    {
+
+    protected:
+
+      /// number of parameters
+      int m_npar;
+
+      /// the indices of the free parameters, moved by the constrained walks
+      std::vector<unsigned int> m_free_parameters;
+
+      /// the logarithm of the likelihood
+      std::function<double(std::vector<double> &)> m_log_likelihood;
+
+      /// the logarithm of the prior
+      std::function<double(std::vector<double> &)> m_log_prior;
+
+      /// the function that draws a set of parameters from the prior
+      std::function<std::vector<double>()> m_prior_sample;
+
+      /// the discarded points and the final live points: m_samples[sample][parameter]
+      std::vector<std::vector<double>> m_samples;
+
+      /// the logarithm of the likelihood of the samples
+      std::vector<double> m_log_likelihood_samples;
+
+      /// the logarithm of the normalized posterior weights of the samples
+      std::vector<double> m_log_weight;
+
+      /// the logarithm of the evidence
+      double m_log_evidence = par::defaultDouble;
+
+      /// the error on the logarithm of the evidence
+      double m_log_evidence_error = 0.;
+
+      /// the information, i.e. the Kullback-Leibler divergence between posterior and prior
+      double m_information = 0.;
+
+      /// the effective sample size of the weighted samples
+      double m_effective_sample_size = 0.;
+
+      /// the number of likelihood evaluations
+      long m_nlikelihood = 0;
+
+      /// the number of iterations
+      int m_niterations = 0;
+
+      /**
+       *  @brief draw a new point from the prior, constrained to
+       *  have a likelihood higher than a threshold, with a
+       *  Metropolis-Hastings walk
+       *
+       *  @param [in,out] point the starting point, replaced by the
+       *  new point
+       *  @param [in,out] log_like the logarithm of the likelihood of
+       *  the point
+       *  @param [in,out] log_prior the logarithm of the prior of the
+       *  point
+       *  @param [in] live the live points
+       *  @param [in] index the indices of the live points used to
+       *  construct the proposals
+       *  @param [in] spread the spread of the live points along each
+       *  free parameter, used to add a small noise to the proposals
+       *  @param [in] log_like_min the likelihood threshold
+       *  @param [in] nsteps the number of steps of the walk
+       *  @param [in] scale the scale of the differential-evolution
+       *  moves
+       *  @param [in] ran the random number generator
+       *  @param [out] naccepted the number of accepted moves
+       *  @param [out] ncalls the number of likelihood evaluations
+       *
+       *  @return none
+       */
+      void m_constrained_walk (std::vector<double> &point, double &log_like, double &log_prior, const std::vector<std::vector<double>> &live, const std::vector<int> &index, const std::vector<double> &spread, const double log_like_min, const int nsteps, const double scale, random::CounterRandomNumbers &ran, int &naccepted, int &ncalls) const;
+
+    public:
+
+      /**
+       *  @name Constructors/destructors
+       */
+      ///@{
+
+      /**
+       *  @brief default constructor
+       *  @return object of class NestedSampler
+       */
+      NestedSampler () = default;
+
+      /**
+       *  @brief constructor
+       *
+       *  @param npar the number of parameters
+       *
+       *  @param log_likelihood the logarithm of the likelihood; it
+       *  can modify the input parameters (e.g. to set the derived
+       *  parameters), and must be thread safe
+       *
+       *  @param log_prior the logarithm of the prior; it must return
+       *  par::defaultDouble outside the prior range
+       *
+       *  @param prior_sample the function that draws a set of
+       *  parameters from the prior
+       *
+       *  @param free_parameters the indices of the free parameters,
+       *  i.e. the ones explored by the sampler; if empty, all the
+       *  parameters are free
+       *
+       *  @return object of class NestedSampler
+       */
+      NestedSampler (const int npar, const std::function<double(std::vector<double> &)> log_likelihood, const std::function<double(std::vector<double> &)> log_prior, const std::function<std::vector<double>()> prior_sample, const std::vector<unsigned int> free_parameters={});
+
+      /**
+       *  @brief default destructor
+       *  @return none
+       */
+      ~NestedSampler () = default;
+
+      ///@}
+
+      /**
+       *  @brief sample the posterior and compute the evidence
+       *
+       *  the sampling stops when the maximum contribution of the
+       *  live points to the logarithm of the evidence, estimated as
+       *  \f$\log(Z+\mathcal{L}_{\rm max}X)-\log Z\f$, is lower than
+       *  dlogz
+       *
+       *  @param nlive the number of live points
+       *  @param dlogz the tolerance on the logarithm of the evidence
+       *  @param nsteps the number of steps of the constrained walks
+       *  used to draw the new points
+       *  @param nparallel the number of live points replaced at each
+       *  iteration, evolved in parallel; the results depend on it,
+       *  but not on the number of threads
+       *  @param seed the seed for random number generator
+       *  @param max_iter the maximum number of iterations
+       *
+       *  @return none
+       */
+      void sample (const int nlive=500, const double dlogz=0.1, const int nsteps=20, const int nparallel=8, const int seed=4241, const int max_iter=100000);
+
+      /**
+       *  @brief get the logarithm of the evidence
+       *  @return the logarithm of the evidence
+       */
+      double log_evidence () const { return m_log_evidence; }
+
+      /**
+       *  @brief get the error on the logarithm of the evidence,
+       *  \f$\sqrt{H/n_{\rm live}}\f$
+       *  @return the error on the logarithm of the evidence
+       */
+      double log_evidence_error () const { return m_log_evidence_error; }
+
+      /**
+       *  @brief get the information, i.e. the Kullback-Leibler
+       *  divergence between posterior and prior
+       *  @return the information
+       */
+      double information () const { return m_information; }
+
+      /**
+       *  @brief get the effective sample size of the weighted
+       *  samples, \f$1/\sum_i w_i^2\f$
+       *  @return the effective sample size
+       */
+      double effective_sample_size () const { return m_effective_sample_size; }
+
+      /**
+       *  @brief get the number of likelihood evaluations
+       *  @return the number of likelihood evaluations
+       */
+      long nlikelihood () const { return m_nlikelihood; }
+
+      /**
+       *  @brief get the number of iterations
+       *  @return the number of iterations
+       */
+      int niterations () const { return m_niterations; }
+
+      /**
+       *  @brief get the weighted samples
+       *
+       *  @param [out] chain_value the samples:
+       *  chain_value[parameter][sample]
+       *  @param [out] log_likelihood the logarithm of the likelihood
+       *  of the samples
+       *  @param [out] weight the normalized posterior weights of the
+       *  samples
+       *
+       *  @return none
+       */
+      void get_samples (std::vector<std::vector<double>> &chain_value, std::vector<double> &log_likelihood, std::vector<double> &weight) const;
+
+      /**
+       *  @brief get equally weighted posterior samples, obtained
+       *  with a systematic resampling of the weighted samples; the
+       *  number of samples is the effective sample size
+       *
+       *  @param [out] chain_value the samples:
+       *  chain_value[parameter][sample]
+       *  @param [out] log_likelihood the logarithm of the likelihood
+       *  of the samples
+       *  @param [in] seed the seed for random number generator
+       *
+       *  @return none
+       */
+      void get_equal_weighted_samples (std::vector<std::vector<double>> &chain_value, std::vector<double> &log_likelihood, const int seed=4241) const;
+
+    };
+  }
+}
+
+#endif
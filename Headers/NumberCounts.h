@@ -35,7 +35,7 @@
 #define __NCOUNTS__
 
 
-#include "Catalogue.h"
+#include "CatalogueView.h"
 #include "Measure.h"
 #include "Histogram.h"
 
@@ -174,8 +174,8 @@ namespace cbl {
 	   *  @param data object of class Catalogue 
 	   *  @return none
 	   */
-	  void set_data (const catalogue::Catalogue data)
-	  { m_data = std::make_shared<catalogue::Catalogue>(catalogue::Catalogue(std::move(data))); }
+	  void set_data (const catalogue::Catalogue &data)
+	  { m_data = std::make_shared<catalogue::Catalogue>(data); }
 
 	  ///@}
 
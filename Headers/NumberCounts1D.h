@@ -156,7 +156,7 @@ namespace cbl {
 	   *
 	   *  @return object of class NumberCounts1D
 	   */
-	  NumberCounts1D (const catalogue::Var var, const BinType bin_type, const catalogue::Catalogue data, const size_t nbins, const double minVar=par::defaultDouble, const double maxVar=par::defaultDouble, const double shift = 0.5, const glob::HistogramType hist_type=glob::HistogramType::_N_V_, const double fact = 1.); 
+	  NumberCounts1D (const catalogue::Var var, const BinType bin_type, const catalogue::Catalogue &data, const size_t nbins, const double minVar=par::defaultDouble, const double maxVar=par::defaultDouble, const double shift = 0.5, const glob::HistogramType hist_type=glob::HistogramType::_N_V_, const double fact = 1.); 
 
 	  ///@}
 
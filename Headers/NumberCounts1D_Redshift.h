@@ -106,7 +106,7 @@ namespace cbl {
 	   *
 	   *  @return object of class NumberCounts1D_Redshift
 	   */
-	  NumberCounts1D_Redshift (const catalogue::Catalogue data, const size_t nbins, const double minVar=par::defaultDouble, const double maxVar=par::defaultDouble, const double shift = 0.5, const glob::HistogramType hist_type=glob::HistogramType::_N_V_, const double fact = 1.) : NumberCounts1D(catalogue::Var::_Redshift_, BinType::_linear_, data, nbins, minVar, maxVar, shift, hist_type, fact) {}
+	  NumberCounts1D_Redshift (const catalogue::Catalogue &data, const size_t nbins, const double minVar=par::defaultDouble, const double maxVar=par::defaultDouble, const double shift = 0.5, const glob::HistogramType hist_type=glob::HistogramType::_N_V_, const double fact = 1.) : NumberCounts1D(catalogue::Var::_Redshift_, BinType::_linear_, data, nbins, minVar, maxVar, shift, hist_type, fact) {}
 
 	  ///@}
 
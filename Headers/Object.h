@@ -1075,7 +1075,7 @@ namespace cbl {
        *
        *  @return none
        */
-      void set_redshift (const double redshift, const cosmology::Cosmology cosmology)
+      void set_redshift (const double redshift, const cosmology::Cosmology &cosmology)
       {
 	m_redshift = redshift;
 	m_dc = cosmology.D_C(m_redshift); 
@@ -35,7 +35,7 @@
 #define __PAIR__
 
 
-#include "Catalogue.h"
+#include "ChainMesh_Catalogue.h"
 
 
 // ===================================================================================================
@@ -132,6 +132,131 @@ namespace cbl {
      */
     inline std::vector<std::string> PairInfoNames () {return {"standard", "extra"}; }
 
+    /**
+     *  @class ExactSum Pair.h "Headers/Pair.h"
+     *
+     *  @brief The class ExactSum
+     *
+     *  This class is used to sum the (weighted) number of pairs
+     *  independently of the order of the additions, so that the
+     *  counts do not depend on the number of threads and MPI tasks
+     *
+     *  The sum is stored as an integer part plus a fraction, both
+     *  stored as double. Each added value is split into its nearest
+     *  integer, which is summed exactly, and the residual, which is
+     *  rounded to a multiple of 2<SUP>-51</SUP> and then summed
+     *  exactly too. The sum is therefore exact, and independent of
+     *  the order of the additions, as long as the integer part is
+     *  smaller than 2<SUP>53</SUP>; the only approximation is the
+     *  rounding of each added value, which depends on the value
+     *  only. The class relies on the IEEE round-to-nearest
+     *  arithmetic: the code must not be compiled with -ffast-math
+     */
+    class ExactSum {
+
+    private:
+
+      /// the integer part of the sum
+      double m_integer = 0.;
+
+      /// the fraction of the sum, a multiple of 2<SUP>-51</SUP> in [-1/2, 1/2]
+      double m_fraction = 0.;
+
+      /**
+       *  @brief the nearest integer of a value
+       *  @param value the value
+       *  @return the nearest integer
+       */
+      static double m_nearest_integer (const double value)
+      { return (fabs(value)<2251799813685248.) ? (value+6755399441055744.)-6755399441055744. : floor(value); }
+
+      /**
+       *  @brief add a multiple of 2<SUP>-51</SUP> in [-1/2, 1/2] to
+       *  the fraction, carrying its integer part
+       *  @param fraction the fraction
+       *  @return none
+       */
+      void m_add_fraction (const double fraction)
+      {
+	m_fraction += fraction;
+	const double carry = m_nearest_integer(m_fraction);
+	m_integer += carry;
+	m_fraction -= carry;
+      }
+
+    public:
+
+      /**
+       *  @brief constructor
+       *  @param value the initial value
+       */
+      ExactSum (const double value=0.) { *this += value; }
+
+      /**
+       *  @brief constructor
+       *  @param integer the integer part, as returned by
+       *  ExactSum::integer()
+       *  @param fraction the fraction, as returned by
+       *  ExactSum::fraction()
+       */
+      ExactSum (const double integer, const double fraction) : m_integer(integer), m_fraction(fraction) {}
+
+      /**
+       *  @brief add a value
+       *  @param value the value
+       *  @return the sum
+       */
+      ExactSum & operator+= (const double value)
+      {
+	const double integer = m_nearest_integer(value);
+	m_integer += integer;
+	m_add_fraction(((value-integer)+3.)-3.);
+	return *this;
+      }
+
+      /**
+       *  @brief add another sum
+       *  @param sum the sum
+       *  @return the sum
+       */
+      ExactSum & operator+= (const ExactSum &sum)
+      {
+	m_integer += sum.m_integer;
+	m_add_fraction(sum.m_fraction);
+	return *this;
+      }
+
+      /**
+       *  @brief add one
+       *  @return the sum before the addition
+       */
+      ExactSum operator++ (int)
+      {
+	const ExactSum sum = *this;
+	m_integer += 1.;
+	return sum;
+      }
+
+      /**
+       *  @brief the value of the sum
+       *  @return the value of the sum, rounded to double
+       */
+      operator double () const { return m_integer+m_fraction; }
+
+      /**
+       *  @brief get the integer part of the sum
+       *  @return the integer part of the sum
+       */
+      double integer () const { return m_integer; }
+
+      /**
+       *  @brief get the fraction of the sum
+       *  @return the fraction of the sum
+       */
+      double fraction () const { return m_fraction; }
+
+    };
+
     /**
      *  @class Pair Pair.h "Headers/Pair.h"
      *
@@ -182,6 +307,209 @@ namespace cbl {
       /// angular weight function
       FunctionDoubleDouble m_angularWeight;
 
+      /// indices of the close objects selected by the pair-counting kernels
+      std::vector<long> m_close;
+
+      /// squared separations of the close objects selected by the pair-counting kernels
+      std::vector<double> m_dist2;
+
+      /// separations of the close objects selected by the pair-counting kernels
+      std::vector<double> m_dist;
+
+      /// bins of the close objects selected by the pair-counting kernels (-1 if outside the binning range)
+      std::vector<int> m_bin;
+
+      /// separations in the second dimension of the close objects selected by the 2D pair-counting kernels
+      std::vector<double> m_dist_D2;
+
+      /// bins in the second dimension of the close objects selected by the 2D pair-counting kernels
+      std::vector<int> m_bin_D2;
+
+      /**
+       *  @name Member functions used by the pair-counting kernels to select the close objects
+       */
+      ///@{
+
+      /**
+       *  @brief select the objects of a block whose Euclidean
+       *  distance from an object is inside a given range
+       *
+       *  the squared distances are computed in a vectorizable loop;
+       *  the indices and the squared distances of the selected
+       *  objects are stored in the first elements of m_close and
+       *  m_dist2, respectively
+       *
+       *  @param obj1 the objects containing the first object
+       *  @param i index of the first object
+       *  @param obj2 the objects containing the block
+       *  @param j_min index of the first object of the block
+       *  @param j_max index of the last object of the block plus one
+       *  @param rMin the minimum separation
+       *  @param rMax the maximum separation
+       *  @return the number of selected objects
+       */
+      long m_close_objects_Euclidean (const chainmesh::CellObjects &obj1, const long i, const chainmesh::CellObjects &obj2, const long j_min, const long j_max, const double rMin, const double rMax);
+
+      /**
+       *  @brief select the objects of a block whose angular
+       *  separation from an object is inside a given range
+       *
+       *  the coordinates have to be normalized to the unit sphere;
+       *  the indices and the squared chord lengths of the selected
+       *  objects are stored in the first elements of m_close and
+       *  m_dist2, respectively
+       *
+       *  @param obj1 the objects containing the first object
+       *  @param i index of the first object
+       *  @param obj2 the objects containing the block
+       *  @param j_min index of the first object of the block
+       *  @param j_max index of the last object of the block plus one
+       *  @param thetaMin the minimum angular separation, in units of
+       *  m_angularUnits
+       *  @param thetaMax the maximum angular separation, in units of
+       *  m_angularUnits
+       *  @return the number of selected objects
+       */
+      long m_close_objects_angular (const chainmesh::CellObjects &obj1, const long i, const chainmesh::CellObjects &obj2, const long j_min, const long j_max, const double thetaMin, const double thetaMax);
+
+      /**
+       *  @brief select the objects of a block whose line-of-sight
+       *  separation from an object is inside a given range
+       *
+       *  the indices of the selected objects and their line-of-sight
+       *  separations are stored in the first elements of m_close and
+       *  m_dist2, respectively
+       *
+       *  @param obj1 the objects containing the first object
+       *  @param i index of the first object
+       *  @param obj2 the objects containing the block
+       *  @param j_min index of the first object of the block
+       *  @param j_max index of the last object of the block plus one
+       *  @param piMin the minimum line-of-sight separation
+       *  @param piMax the maximum line-of-sight separation
+       *  @return the number of selected objects
+       */
+      long m_close_objects_lineOfSight (const chainmesh::CellObjects &obj1, const long i, const chainmesh::CellObjects &obj2, const long j_min, const long j_max, const double piMin, const double piMax);
+
+      /**
+       *  @brief compute the separations and the bins of the close
+       *  objects selected by m_close_objects_Euclidean or
+       *  m_close_objects_angular
+       *
+       *  the separations and the bin indices are computed in a
+       *  vectorizable loop, and stored in the first elements of
+       *  m_dist and m_bin, respectively; the objects outside the
+       *  binning range have bin -1, so that the kernels only have to
+       *  update the histograms. The square roots and the bin indices
+       *  are vectorized with the instruction set of the target (see
+       *  the option SIMD of the Makefile); the logarithms and the
+       *  arcsines are vectorized only if the compiler provides a
+       *  vector math library (e.g. glibc libmvec with -ffast-math),
+       *  otherwise they are computed with scalar calls inside the
+       *  loop
+       *
+       *  @param nClose the number of selected objects
+       *  @param sMin the minimum separation
+       *  @param sMax the maximum separation
+       *  @param binSize_inv the inverse of the bin size
+       *  @param nbins the number of bins
+       *  @param logBins true &rarr; logarithmic bins; false &rarr;
+       *  linear bins
+       *  @param angular true &rarr; m_dist2 contains squared chord
+       *  lengths, converted into angular separations in units of
+       *  m_angularUnits; false &rarr; m_dist2 contains squared
+       *  Euclidean distances
+       *  @return none
+       */
+      void m_bin_close_objects (const long nClose, const double sMin, const double sMax, const double binSize_inv, const int nbins, const bool logBins, const bool angular);
+
+      /**
+       *  @brief compute the separations in polar coordinates, r and
+       *  &mu;, of the close objects selected by
+       *  m_close_objects_Euclidean
+       *
+       *  the separations r and &mu; are computed in a vectorizable
+       *  loop, and stored in the first elements of m_dist and
+       *  m_dist_D2, respectively
+       *
+       *  @param nClose the number of selected objects
+       *  @param obj1 the objects containing the selected object
+       *  @param i index of the selected object
+       *  @param obj2 the objects containing the close objects
+       *  @return none
+       */
+      void m_polar_close_objects (const long nClose, const chainmesh::CellObjects &obj1, const long i, const chainmesh::CellObjects &obj2);
+
+      /**
+       *  @brief compute the separations in Cartesian coordinates,
+       *  r<SUB>p</SUB> and &pi;, of the close objects selected by
+       *  m_close_objects_lineOfSight
+       *
+       *  the separations r<SUB>p</SUB> and &pi; are stored in the
+       *  first elements of m_dist and m_dist_D2, respectively
+       *
+       *  @param nClose the number of selected objects
+       *  @param obj1 the objects containing the selected object
+       *  @param i index of the selected object
+       *  @param obj2 the objects containing the close objects
+       *  @return none
+       */
+      void m_Cartesian_close_objects (const long nClose, const chainmesh::CellObjects &obj1, const long i, const chainmesh::CellObjects &obj2);
+
+      /**
+       *  @brief compute the 2D bins of the close objects, from the
+       *  separations stored by m_polar_close_objects or
+       *  m_Cartesian_close_objects
+       *
+       *  the bin indices are computed in a vectorizable loop, and
+       *  stored in the first elements of m_bin and m_bin_D2; the
+       *  objects outside the binning range in either dimension have
+       *  m_bin equal to -1, so that the kernels only have to update
+       *  the histograms
+       *
+       *  @param nClose the number of selected objects
+       *  @param sMin_D1 the minimum separation in the first dimension
+       *  @param sMax_D1 the maximum separation in the first dimension
+       *  @param binSize_inv_D1 the inverse of the bin size in the
+       *  first dimension
+       *  @param nbins_D1 the number of bins in the first dimension
+       *  @param logBins_D1 true &rarr; logarithmic bins in the first
+       *  dimension; false &rarr; linear bins
+       *  @param sMin_D2 the minimum separation in the second
+       *  dimension
+       *  @param sMax_D2 the maximum separation in the second
+       *  dimension
+       *  @param binSize_inv_D2 the inverse of the bin size in the
+       *  second dimension
+       *  @param nbins_D2 the number of bins in the second dimension
+       *  @param logBins_D2 true &rarr; logarithmic bins in the second
+       *  dimension; false &rarr; linear bins
+       *  @return none
+       */
+      void m_bin_close_objects_2D (const long nClose, const double sMin_D1, const double sMax_D1, const double binSize_inv_D1, const int nbins_D1, const bool logBins_D1, const double sMin_D2, const double sMax_D2, const double binSize_inv_D2, const int nbins_D2, const bool logBins_D2);
+
+      /**
+       *  @brief get the number of pairs and their total weight
+       *  between two blocks of contiguous objects
+       *  @param obj1 the objects containing the first block
+       *  @param i_min index of the first object of the first block
+       *  @param i_max index of the last object of the first block
+       *  plus one
+       *  @param obj2 the objects containing the second block
+       *  @param j_min index of the first object of the second block
+       *  @param j_max index of the last object of the second block
+       *  plus one
+       *  @param auto_pairs true &rarr; the two blocks are the same,
+       *  and only the pairs (i, j) with j>i are considered
+       *  @param [out] nPairs the number of pairs
+       *  @param [out] weight the sum of the products of the weights
+       *  of the objects of each pair, summed pair by pair as done by
+       *  the pair-counting kernels
+       *  @return none
+       */
+      void m_blocks_weight (const chainmesh::CellObjects &obj1, const long i_min, const long i_max, const chainmesh::CellObjects &obj2, const long j_min, const long j_max, const bool auto_pairs, double &nPairs, ExactSum &weight) const;
+
+      ///@}
       
     public:
       
@@ -344,6 +672,12 @@ namespace cbl {
        */
       PairInfo pairInfo () const { return m_pairInfo; }
 
+      /**
+       *  @brief get the angular weight function
+       *  @return the angular weight function
+       */
+      FunctionDoubleDouble angularWeight () const { return m_angularWeight; }
+
       /**
        *  @brief get the angular units
        *  @return the angular units
@@ -351,10 +685,12 @@ namespace cbl {
       CoordinateUnits angularUnits () { return m_angularUnits; }
 
       /**
-       *  @brief get the m_angularWeight function
-       *  @return the m_angularWeight function 
+       *  @brief get the variables, among right ascension,
+       *  declination, redshift and comoving distance, needed to
+       *  count the pairs
+       *  @return the variables needed to count the pairs
        */
-      FunctionDoubleDouble angularWeight () { return m_angularWeight; }
+      std::vector<catalogue::Var> variables () const;
       
       /**
        *  @brief get the member m_scale[i]
@@ -502,6 +838,22 @@ namespace cbl {
       virtual std::vector<double> PP1D_weighted () const
       { cbl::ErrorCBL("Error in PP1D_weighted() of Pair.h!"); std::vector<double> vv; return vv; }
 
+      /**
+       *  @brief get the member m_PP1D[i], summed exactly
+       *  @param i the bin index
+       *  @return the number of pairs in the i-th bin
+       */
+      virtual ExactSum PP1D_exact (const int i) const
+      { (void)i; cbl::ErrorCBL("Error in PP1D_exact() of Pair.h!"); return 0.; }
+
+      /**
+       *  @brief get the member m_PP1D_weighted[i], summed exactly
+       *  @param i the bin index
+       *  @return the number of weighted pairs in the i-th bin
+       */
+      virtual ExactSum PP1D_weighted_exact (const int i) const
+      { (void)i; cbl::ErrorCBL("Error in PP1D_weighted_exact() of Pair.h!"); return 0.; }
+
       /**
        *  @brief get the member m_scale_D1[i]
        *  @param i the bin index
@@ -720,6 +1072,24 @@ namespace cbl {
        */
       virtual std::vector<std::vector<double>> PP2D_weighted () const
       { cbl::ErrorCBL("Error in PP2D_weighted() of Pair.h!"); std::vector<std::vector<double>> vv; return vv; }
+
+      /**
+       *  @brief get the member m_PP2D[i][j], summed exactly
+       *  @param i the bin index in the first dimension
+       *  @param j the bin index in the second dimension
+       *  @return the number of pairs in the bin (i, j)
+       */
+      virtual ExactSum PP2D_exact (const int i, const int j) const
+      { (void)i; (void)j; cbl::ErrorCBL("Error in PP2D_exact() of Pair.h!"); return 0.; }
+
+      /**
+       *  @brief get the member m_PP2D_weighted[i][j], summed exactly
+       *  @param i the bin index in the first dimension
+       *  @param j the bin index in the second dimension
+       *  @return the number of weighted pairs in the bin (i, j)
+       */
+      virtual ExactSum PP2D_weighted_exact (const int i, const int j) const
+      { (void)i; (void)j; cbl::ErrorCBL("Error in PP2D_weighted_exact() of Pair.h!"); return 0.; }
       
       /**
        *  @brief get the member m_binSize_inv
@@ -896,6 +1266,20 @@ namespace cbl {
        */
       virtual void add_data1D (const int i, const std::shared_ptr<pairs::Pair> pair, const double ww=1.)
       { (void)i; (void)pair; (void)ww; cbl::ErrorCBL("Error in add_data1D() of Pair.h!"); }
+
+      /**
+       *  @brief set the protected members by adding new 1D data,
+       *  summing exactly the number of pairs
+       *  @param i the bin index
+       *  @param pp the number of pairs
+       *  @param pp_weighted the weighted number of pairs
+       *  @param extra vector containing the extra information to be
+       *  added, i.e. the data used by add_data1D after the number of
+       *  pairs
+       *  @return none
+       */
+      virtual void add_data1D (const int i, const ExactSum pp, const ExactSum pp_weighted, const std::vector<double> extra={})
+      { (void)i; (void)pp; (void)pp_weighted; (void)extra; cbl::ErrorCBL("Error in add_data1D() of Pair.h!"); }
       
       /**
        *  @brief set the protected members by adding new 2D data
@@ -917,6 +1301,21 @@ namespace cbl {
        */
       virtual void add_data2D (const int i, const int j, const std::shared_ptr<pairs::Pair> pair, const double ww=1.)
       { (void)i; (void)j; (void)pair; (void)ww; cbl::ErrorCBL("Error in add_data2D() of Pair.h!"); }
+
+      /**
+       *  @brief set the protected members by adding new 2D data,
+       *  summing exactly the number of pairs
+       *  @param i the bin index in the first dimension
+       *  @param j the bin index in the second dimension
+       *  @param pp the number of pairs
+       *  @param pp_weighted the weighted number of pairs
+       *  @param extra vector containing the extra information to be
+       *  added, i.e. the data used by add_data2D after the number of
+       *  pairs
+       *  @return none
+       */
+      virtual void add_data2D (const int i, const int j, const ExactSum pp, const ExactSum pp_weighted, const std::vector<double> extra={})
+      { (void)i; (void)j; (void)pp; (void)pp_weighted; (void)extra; cbl::ErrorCBL("Error in add_data2D() of Pair.h!"); }
       
       ///@}
 
@@ -1008,6 +1407,49 @@ namespace cbl {
        */
       virtual void put (const std::shared_ptr<catalogue::Object> obj1, const std::shared_ptr<catalogue::Object> obj2) = 0;
 
+      /**
+       *  @brief estimate the distances between the objects of two
+       *  blocks of contiguous objects and update the pair vector
+       *  accordingly
+       *  @param obj1 the objects containing the first block
+       *  @param i_min index of the first object of the first block
+       *  @param i_max index of the last object of the first block
+       *  plus one
+       *  @param obj2 the objects containing the second block
+       *  @param j_min index of the first object of the second block
+       *  @param j_max index of the last object of the second block
+       *  plus one
+       *  @param auto_pairs true &rarr; the two blocks are the same,
+       *  and only the pairs (i, j) with j>i are counted
+       *  @return none
+       */
+      virtual void put (const chainmesh::CellObjects &obj1, const long i_min, const long i_max, const chainmesh::CellObjects &obj2, const long j_min, const long j_max, const bool auto_pairs=false) = 0;
+
+      /**
+       *  @brief count at once all the pairs between two blocks of
+       *  contiguous objects, if their separations allow it (e.g. if
+       *  they are all outside the binning range, or all inside a
+       *  single bin)
+       *  @param obj1 the objects containing the first block
+       *  @param i_min index of the first object of the first block
+       *  @param i_max index of the last object of the first block
+       *  plus one
+       *  @param obj2 the objects containing the second block
+       *  @param j_min index of the first object of the second block
+       *  @param j_max index of the last object of the second block
+       *  plus one
+       *  @param auto_pairs true &rarr; the two blocks are the same,
+       *  and only the pairs (i, j) with j>i are counted
+       *  @param dist_min the minimum Euclidean distance between the
+       *  objects of the two blocks
+       *  @param dist_max the maximum Euclidean distance between the
+       *  objects of the two blocks
+       *  @return true if the pairs have been counted; false if they
+       *  have to be counted one by one
+       */
+      virtual bool put_cells (const chainmesh::CellObjects &obj1, const long i_min, const long i_max, const chainmesh::CellObjects &obj2, const long j_min, const long j_max, const bool auto_pairs, const double dist_min, const double dist_max)
+      { (void)obj1; (void)i_min; (void)i_max; (void)obj2; (void)j_min; (void)j_max; (void)auto_pairs; (void)dist_min; (void)dist_max; return false; }
+
       /**
        *  @brief sum the number of binned pairs
        *  @param pp an object of class Pair
@@ -1015,6 +1457,25 @@ namespace cbl {
        *  @return none
        */
       virtual void Sum (const std::shared_ptr<Pair> pp, const double ww=1) = 0;
+
+      /**
+       *  @brief get the binned pairs as a single vector, e.g. to
+       *  send them to other MPI tasks
+       *  @return vector containing, for each bin, the integer parts
+       *  and the fractions of the number of pairs and of the weighted
+       *  number of pairs (see ExactSum), followed by the extra
+       *  information used by add_data1D or add_data2D
+       */
+      std::vector<double> data () const;
+
+      /**
+       *  @brief sum the binned pairs stored in a vector obtained with
+       *  data()
+       *  @param data vector containing the binned pairs of an object
+       *  of class Pair of the same type
+       *  @return none
+       */
+      void add_data (const std::vector<double> data);
       
       ///@}
 
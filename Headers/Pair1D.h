@@ -83,10 +83,10 @@ namespace cbl {
       std::vector<double> m_scale;
       
       /// the number of binned pairs 
-      std::vector<double> m_PP1D;
+      std::vector<ExactSum> m_PP1D;
       
       /// the number of binned weighted pairs 
-      std::vector<double> m_PP1D_weighted;
+      std::vector<ExactSum> m_PP1D_weighted;
 
       /**
        *  @name binning parameters
@@ -176,7 +176,7 @@ namespace cbl {
        *  @brief get the protected member Pair1D::m_PP1D
        *  @return the vector containing the binned number of pairs
        */
-      std::vector<double> PP1D () const override { return m_PP1D; }
+      std::vector<double> PP1D () const override { return std::vector<double>(m_PP1D.begin(), m_PP1D.end()); }
 
       /**
        *  @brief get the protected member Pair1D::m_PP1D_weighted[i]
@@ -190,7 +190,23 @@ namespace cbl {
        *  @return the vector containing the binned number of weighted
        *  pairs
        */
-      std::vector<double> PP1D_weighted () const override { return m_PP1D_weighted; }
+      std::vector<double> PP1D_weighted () const override { return std::vector<double>(m_PP1D_weighted.begin(), m_PP1D_weighted.end()); }
+
+      /**
+       *  @brief get the protected member Pair1D::m_PP1D[i], summed
+       *  exactly
+       *  @param i the bin index
+       *  @return the number of pairs in the i-th bin
+       */
+      ExactSum PP1D_exact (const int i) const override { return m_PP1D[i]; }
+
+      /**
+       *  @brief get the protected member Pair1D::m_PP1D_weighted[i],
+       *  summed exactly
+       *  @param i the bin index
+       *  @return the number of weighted pairs in the i-th bin
+       */
+      ExactSum PP1D_weighted_exact (const int i) const override { return m_PP1D_weighted[i]; }
     
       /**
        *  @brief get the protected member Pair1D::m_binSize_inv
@@ -258,6 +274,17 @@ namespace cbl {
        *  @return none
        */
       void add_data1D (const int i, const std::shared_ptr<pairs::Pair> pair, const double ww=1.) override;
+
+      /**
+       *  @brief set the protected member by adding new data, summing
+       *  exactly the number of pairs
+       *  @param i the bin index
+       *  @param pp the number of pairs in the bin
+       *  @param pp_weighted the number of weighted pairs in the bin
+       *  @param extra not used
+       *  @return none
+       */
+      void add_data1D (const int i, const ExactSum pp, const ExactSum pp_weighted, const std::vector<double> extra={}) override;
       
       ///@}
 
@@ -554,6 +581,32 @@ namespace cbl {
        */
       void put (const std::shared_ptr<catalogue::Object> obj1, const std::shared_ptr<catalogue::Object> obj2) override;
 
+      /// @copydoc cbl::pairs::Pair::put(const chainmesh::CellObjects &, const long, const long, const chainmesh::CellObjects &, const long, const long, const bool)
+      void put (const chainmesh::CellObjects &obj1, const long i_min, const long i_max, const chainmesh::CellObjects &obj2, const long j_min, const long j_max, const bool auto_pairs=false) override;
+
+      /**
+       *  @brief count at once all the pairs between two blocks of
+       *  contiguous objects, if their separations are all outside
+       *  the binning range or all inside a single bin
+       *  @param obj1 the objects containing the first block
+       *  @param i_min index of the first object of the first block
+       *  @param i_max index of the last object of the first block
+       *  plus one
+       *  @param obj2 the objects containing the second block
+       *  @param j_min index of the first object of the second block
+       *  @param j_max index of the last object of the second block
+       *  plus one
+       *  @param auto_pairs true &rarr; the two blocks are the same,
+       *  and only the pairs (i, j) with j>i are counted
+       *  @param dist_min the minimum chord length, on the unit
+       *  sphere, between the objects of the two blocks
+       *  @param dist_max the maximum chord length, on the unit
+       *  sphere, between the objects of the two blocks
+       *  @return true if the pairs have been counted; false if they
+       *  have to be counted one by one
+       */
+      bool put_cells (const chainmesh::CellObjects &obj1, const long i_min, const long i_max, const chainmesh::CellObjects &obj2, const long j_min, const long j_max, const bool auto_pairs, const double dist_min, const double dist_max) override;
+
       ///@}
     
     };
@@ -701,6 +754,32 @@ namespace cbl {
        */
       void put (const std::shared_ptr<catalogue::Object> obj1, const std::shared_ptr<catalogue::Object> obj2) override;
 
+      /// @copydoc cbl::pairs::Pair::put(const chainmesh::CellObjects &, const long, const long, const chainmesh::CellObjects &, const long, const long, const bool)
+      void put (const chainmesh::CellObjects &obj1, const long i_min, const long i_max, const chainmesh::CellObjects &obj2, const long j_min, const long j_max, const bool auto_pairs=false) override;
+
+      /**
+       *  @brief count at once all the pairs between two blocks of
+       *  contiguous objects, if their separations are all outside
+       *  the binning range or all inside a single bin
+       *  @param obj1 the objects containing the first block
+       *  @param i_min index of the first object of the first block
+       *  @param i_max index of the last object of the first block
+       *  plus one
+       *  @param obj2 the objects containing the second block
+       *  @param j_min index of the first object of the second block
+       *  @param j_max index of the last object of the second block
+       *  plus one
+       *  @param auto_pairs true &rarr; the two blocks are the same,
+       *  and only the pairs (i, j) with j>i are counted
+       *  @param dist_min the minimum chord length, on the unit
+       *  sphere, between the objects of the two blocks
+       *  @param dist_max the maximum chord length, on the unit
+       *  sphere, between the objects of the two blocks
+       *  @return true if the pairs have been counted; false if they
+       *  have to be counted one by one
+       */
+      bool put_cells (const chainmesh::CellObjects &obj1, const long i_min, const long i_max, const chainmesh::CellObjects &obj2, const long j_min, const long j_max, const bool auto_pairs, const double dist_min, const double dist_max) override;
+
       ///@}
     
     };
@@ -967,7 +1046,34 @@ namespace cbl {
        *  @return none
        */
       void put (const std::shared_ptr<catalogue::Object> obj1, const std::shared_ptr<catalogue::Object> obj2) override;
-  
+
+      /// @copydoc cbl::pairs::Pair::put(const chainmesh::CellObjects &, const long, const long, const chainmesh::CellObjects &, const long, const long, const bool)
+      void put (const chainmesh::CellObjects &obj1, const long i_min, const long i_max, const chainmesh::CellObjects &obj2, const long j_min, const long j_max, const bool auto_pairs=false) override;
+  
+
+      /**
+       *  @brief count at once all the pairs between two blocks of
+       *  contiguous objects, if their separations are all outside
+       *  the binning range or all inside a single bin
+       *  @param obj1 the objects containing the first block
+       *  @param i_min index of the first object of the first block
+       *  @param i_max index of the last object of the first block
+       *  plus one
+       *  @param obj2 the objects containing the second block
+       *  @param j_min index of the first object of the second block
+       *  @param j_max index of the last object of the second block
+       *  plus one
+       *  @param auto_pairs true &rarr; the two blocks are the same,
+       *  and only the pairs (i, j) with j>i are counted
+       *  @param dist_min the minimum comoving distance between the objects
+       *  of the two blocks
+       *  @param dist_max the maximum comoving distance between the objects
+       *  of the two blocks
+       *  @return true if the pairs have been counted; false if they
+       *  have to be counted one by one
+       */
+      bool put_cells (const chainmesh::CellObjects &obj1, const long i_min, const long i_max, const chainmesh::CellObjects &obj2, const long j_min, const long j_max, const bool auto_pairs, const double dist_min, const double dist_max) override;
+
       ///@}
     
     };
@@ -1111,6 +1217,32 @@ namespace cbl {
        */
       void put (const std::shared_ptr<catalogue::Object> obj1, const std::shared_ptr<catalogue::Object> obj2) override;
 
+      /// @copydoc cbl::pairs::Pair::put(const chainmesh::CellObjects &, const long, const long, const chainmesh::CellObjects &, const long, const long, const bool)
+      void put (const chainmesh::CellObjects &obj1, const long i_min, const long i_max, const chainmesh::CellObjects &obj2, const long j_min, const long j_max, const bool auto_pairs=false) override;
+
+      /**
+       *  @brief count at once all the pairs between two blocks of
+       *  contiguous objects, if their separations are all outside
+       *  the binning range or all inside a single bin
+       *  @param obj1 the objects containing the first block
+       *  @param i_min index of the first object of the first block
+       *  @param i_max index of the last object of the first block
+       *  plus one
+       *  @param obj2 the objects containing the second block
+       *  @param j_min index of the first object of the second block
+       *  @param j_max index of the last object of the second block
+       *  plus one
+       *  @param auto_pairs true &rarr; the two blocks are the same,
+       *  and only the pairs (i, j) with j>i are counted
+       *  @param dist_min the minimum comoving distance between the objects
+       *  of the two blocks
+       *  @param dist_max the maximum comoving distance between the objects
+       *  of the two blocks
+       *  @return true if the pairs have been counted; false if they
+       *  have to be counted one by one
+       */
+      bool put_cells (const chainmesh::CellObjects &obj1, const long i_min, const long i_max, const chainmesh::CellObjects &obj2, const long j_min, const long j_max, const bool auto_pairs, const double dist_min, const double dist_max) override;
+
       ///@}
     
     };
@@ -1242,6 +1374,29 @@ namespace cbl {
        */
       double sMax () const override { return m_rMax; }
 
+      /**
+       *  @brief discard at once all the pairs between two blocks of
+       *  contiguous objects, if their separations are all outside
+       *  the binning range
+       *  @param obj1 the objects containing the first block
+       *  @param i_min index of the first object of the first block
+       *  @param i_max index of the last object of the first block
+       *  plus one
+       *  @param obj2 the objects containing the second block
+       *  @param j_min index of the first object of the second block
+       *  @param j_max index of the last object of the second block
+       *  plus one
+       *  @param auto_pairs true &rarr; the two blocks are the same,
+       *  and only the pairs (i, j) with j>i are counted
+       *  @param dist_min the minimum comoving distance between the
+       *  objects of the two blocks
+       *  @param dist_max the maximum comoving distance between the
+       *  objects of the two blocks
+       *  @return true if the pairs have been discarded; false if
+       *  they have to be counted one by one
+       */
+      bool put_cells (const chainmesh::CellObjects &obj1, const long i_min, const long i_max, const chainmesh::CellObjects &obj2, const long j_min, const long j_max, const bool auto_pairs, const double dist_min, const double dist_max) override;
+
       ///@}
     
     };
@@ -1385,6 +1540,9 @@ namespace cbl {
        *  @return none
        */
       void put (const std::shared_ptr<catalogue::Object> obj1, const std::shared_ptr<catalogue::Object> obj2) override;
+
+      /// @copydoc cbl::pairs::Pair::put(const chainmesh::CellObjects &, const long, const long, const chainmesh::CellObjects &, const long, const long, const bool)
+      void put (const chainmesh::CellObjects &obj1, const long i_min, const long i_max, const chainmesh::CellObjects &obj2, const long j_min, const long j_max, const bool auto_pairs=false) override;
   
       ///@}
     
@@ -1547,6 +1705,9 @@ namespace cbl {
        */
       void put (const std::shared_ptr<catalogue::Object> obj1, const std::shared_ptr<catalogue::Object> obj2) override;
 
+      /// @copydoc cbl::pairs::Pair::put(const chainmesh::CellObjects &, const long, const long, const chainmesh::CellObjects &, const long, const long, const bool)
+      void put (const chainmesh::CellObjects &obj1, const long i_min, const long i_max, const chainmesh::CellObjects &obj2, const long j_min, const long j_max, const bool auto_pairs=false) override;
+
       ///@}
 
       /**
@@ -274,6 +274,20 @@ namespace cbl {
        *  @return none
        */
       void add_data1D (const int i, const std::shared_ptr<pairs::Pair> pair, const double ww=1.) override;
+
+      /**
+       *  @brief set the protected members by adding new data,
+       *  summing exactly the number of pairs
+       *  @param i the bin index
+       *  @param pp the number of pairs in the bin
+       *  @param pp_weighted the number of weighted pairs in the bin
+       *  @param extra vector containing the mean scale, the scale
+       *  variance times the weighted number of pairs, the mean
+       *  redshift and the redshift variance times the weighted number
+       *  of pairs
+       *  @return none
+       */
+      void add_data1D (const int i, const ExactSum pp, const ExactSum pp_weighted, const std::vector<double> extra={}) override;
       
       ///@}
 
@@ -481,6 +495,9 @@ namespace cbl {
        *  @return none
        */
       void put (const std::shared_ptr<catalogue::Object> obj1, const std::shared_ptr<catalogue::Object> obj2) override;
+
+      /// @copydoc cbl::pairs::Pair::put(const chainmesh::CellObjects &, const long, const long, const chainmesh::CellObjects &, const long, const long, const bool)
+      void put (const chainmesh::CellObjects &obj1, const long i_min, const long i_max, const chainmesh::CellObjects &obj2, const long j_min, const long j_max, const bool auto_pairs=false) override;
   
       ///@}
       
@@ -599,6 +616,9 @@ namespace cbl {
        */
       void put (const std::shared_ptr<catalogue::Object> obj1, const std::shared_ptr<catalogue::Object> obj2) override;
 
+      /// @copydoc cbl::pairs::Pair::put(const chainmesh::CellObjects &, const long, const long, const chainmesh::CellObjects &, const long, const long, const bool)
+      void put (const chainmesh::CellObjects &obj1, const long i_min, const long i_max, const chainmesh::CellObjects &obj2, const long j_min, const long j_max, const bool auto_pairs=false) override;
+
       ///@}
     
     };
@@ -778,6 +798,9 @@ namespace cbl {
        *  @return none
        */
       void put (const std::shared_ptr<catalogue::Object> obj1, const std::shared_ptr<catalogue::Object> obj2) override;
+
+      /// @copydoc cbl::pairs::Pair::put(const chainmesh::CellObjects &, const long, const long, const chainmesh::CellObjects &, const long, const long, const bool)
+      void put (const chainmesh::CellObjects &obj1, const long i_min, const long i_max, const chainmesh::CellObjects &obj2, const long j_min, const long j_max, const bool auto_pairs=false) override;
   
       ///@}
     
@@ -892,6 +915,9 @@ namespace cbl {
        */
       void put (const std::shared_ptr<catalogue::Object> obj1, const std::shared_ptr<catalogue::Object> obj2) override;
 
+      /// @copydoc cbl::pairs::Pair::put(const chainmesh::CellObjects &, const long, const long, const chainmesh::CellObjects &, const long, const long, const bool)
+      void put (const chainmesh::CellObjects &obj1, const long i_min, const long i_max, const chainmesh::CellObjects &obj2, const long j_min, const long j_max, const bool auto_pairs=false) override;
+
       ///@}
     
     };
@@ -1073,6 +1099,9 @@ namespace cbl {
        */
       void put (const std::shared_ptr<catalogue::Object> obj1, const std::shared_ptr<catalogue::Object> obj2) override;
 
+      /// @copydoc cbl::pairs::Pair::put(const chainmesh::CellObjects &, const long, const long, const chainmesh::CellObjects &, const long, const long, const bool)
+      void put (const chainmesh::CellObjects &obj1, const long i_min, const long i_max, const chainmesh::CellObjects &obj2, const long j_min, const long j_max, const bool auto_pairs=false) override;
+
       /**
        *  @brief sum the number of binned pairs
        *  @param pair an object of class Pair
@@ -1198,6 +1227,9 @@ namespace cbl {
        */
       void put (const std::shared_ptr<catalogue::Object> obj1, const std::shared_ptr<catalogue::Object> obj2) override;
 
+      /// @copydoc cbl::pairs::Pair::put(const chainmesh::CellObjects &, const long, const long, const chainmesh::CellObjects &, const long, const long, const bool)
+      void put (const chainmesh::CellObjects &obj1, const long i_min, const long i_max, const chainmesh::CellObjects &obj2, const long j_min, const long j_max, const bool auto_pairs=false) override;
+
       /**
        *  @brief sum the number of binned pairs
        *  @param pair an object of class Pair
@@ -86,10 +86,10 @@ namespace cbl {
       std::vector<double> m_scale_D2;
       
       /// the number of binned pairs 
-      std::vector<std::vector<double>> m_PP2D;
+      std::vector<std::vector<ExactSum>> m_PP2D;
       
       /// the weighted number of binned pairs 
-      std::vector<std::vector<double>> m_PP2D_weighted;
+      std::vector<std::vector<ExactSum>> m_PP2D_weighted;
 
       /**
        *  @name binning parameters
@@ -201,7 +201,8 @@ namespace cbl {
        *  @brief get the protected member \e m_PP2D
        *  @return the vector containing the binned number of pairs
        */
-      std::vector<std::vector<double>> PP2D () const override { return m_PP2D; }
+      std::vector<std::vector<double>> PP2D () const override
+      { std::vector<std::vector<double>> pp; for (auto &&pp_i : m_PP2D) pp.emplace_back(pp_i.begin(), pp_i.end()); return pp; }
 
       /**
        *  @brief get the protected member \e m_PP2D_weighted[i]
@@ -216,7 +217,26 @@ namespace cbl {
        *  @return the vector containing the binned number of weighted
        *  pairs
        */
-      std::vector<std::vector<double>> PP2D_weighted () const override { return m_PP2D_weighted; }
+      std::vector<std::vector<double>> PP2D_weighted () const override
+      { std::vector<std::vector<double>> pp; for (auto &&pp_i : m_PP2D_weighted) pp.emplace_back(pp_i.begin(), pp_i.end()); return pp; }
+
+      /**
+       *  @brief get the protected member \e m_PP2D[i][j], summed
+       *  exactly
+       *  @param i the bin index in the first dimension
+       *  @param j the bin index in the second dimension
+       *  @return the number of pairs in the bin
+       */
+      ExactSum PP2D_exact (const int i, const int j) const override { return m_PP2D[i][j]; }
+
+      /**
+       *  @brief get the protected member \e m_PP2D_weighted[i][j],
+       *  summed exactly
+       *  @param i the bin index in the first dimension
+       *  @param j the bin index in the second dimension
+       *  @return the number of weighted pairs in the bin
+       */
+      ExactSum PP2D_weighted_exact (const int i, const int j) const override { return m_PP2D_weighted[i][j]; }
       
       /**
        *  @brief get the protected member Pair2D::m_binSize_inv_D1
@@ -287,7 +307,7 @@ namespace cbl {
        *  @param pp the number of pairs in the bin
        *  @return none
        */
-      void set_PP2D (const int i, const int j, const double pp) { checkDim(m_PP2D, i, j, "m_PP2D"); m_PP2D[i][j] = pp; }
+      void set_PP2D (const int i, const int j, const double pp) { checkDim(m_PP2D, i, j, "m_PP2D", false); m_PP2D[i][j] = pp; }
 
       /**
        *  @brief set the protected member Pair2D::m_PP2D_weighted[i][j]
@@ -296,7 +316,7 @@ namespace cbl {
        *  @param pp the number of weighetd pairs in the bin
        *  @return none
        */
-      void set_PP2D_weighted (const int i, const int j, const double pp) { checkDim(m_PP2D_weighted, i, j, "m_PP2D_weighted"); m_PP2D_weighted[i][j] = pp; }
+      void set_PP2D_weighted (const int i, const int j, const double pp) { checkDim(m_PP2D_weighted, i, j, "m_PP2D_weighted", false); m_PP2D_weighted[i][j] = pp; }
       
       /**
        *  @brief set the protected members by adding new data
@@ -317,6 +337,18 @@ namespace cbl {
        */
       void add_data2D (const int i, const int j, const std::shared_ptr<pairs::Pair> pair, const double ww=1.) override;
 
+      /**
+       *  @brief set the protected members by adding new data, summing
+       *  exactly the number of pairs
+       *  @param i the bin index in the first dimension
+       *  @param j the bin index in the second dimension
+       *  @param pp the number of pairs in the bin
+       *  @param pp_weighted the number of weighted pairs in the bin
+       *  @param extra not used
+       *  @return none
+       */
+      void add_data2D (const int i, const int j, const ExactSum pp, const ExactSum pp_weighted, const std::vector<double> extra={}) override;
+
       ///@}
 
 
@@ -577,8 +609,8 @@ namespace cbl {
 	  m_pairType = PairType::_comovingCartesian_linlin_;
 	  m_pairInfo = PairInfo::_standard_;
 	  m_set_parameters_nbins();
-	  m_PP2D.resize(m_nbins_D1+1, std::vector<double>(m_nbins_D2+1, 0.));
-	  m_PP2D_weighted.resize(m_nbins_D1+1, std::vector<double>(m_nbins_D2+1, 0.));
+	  m_PP2D.resize(m_nbins_D1+1, std::vector<ExactSum>(m_nbins_D2+1));
+	  m_PP2D_weighted.resize(m_nbins_D1+1, std::vector<ExactSum>(m_nbins_D2+1));
 	}
   
       /**
@@ -605,8 +637,8 @@ namespace cbl {
 	  m_pairType = PairType::_comovingCartesian_linlin_;
 	  m_pairInfo = PairInfo::_standard_;
 	  m_set_parameters_binSize();
-	  m_PP2D.resize(m_nbins_D1+1, std::vector<double>(m_nbins_D2+1, 0.));
-	  m_PP2D_weighted.resize(m_nbins_D1+1, std::vector<double>(m_nbins_D2+1, 0.));
+	  m_PP2D.resize(m_nbins_D1+1, std::vector<ExactSum>(m_nbins_D2+1));
+	  m_PP2D_weighted.resize(m_nbins_D1+1, std::vector<ExactSum>(m_nbins_D2+1));
 	} 
   
       /**
@@ -654,6 +686,9 @@ namespace cbl {
        *  @return none
        */
       void put (const std::shared_ptr<catalogue::Object> obj1, const std::shared_ptr<catalogue::Object> obj2) override;
+
+      /// @copydoc cbl::pairs::Pair::put(const chainmesh::CellObjects &, const long, const long, const chainmesh::CellObjects &, const long, const long, const bool)
+      void put (const chainmesh::CellObjects &obj1, const long i_min, const long i_max, const chainmesh::CellObjects &obj2, const long j_min, const long j_max, const bool auto_pairs=false) override;
   
       ///@}
 
@@ -737,8 +772,8 @@ namespace cbl {
 	  m_pairType = PairType::_comovingCartesian_loglin_;
 	  m_pairInfo = PairInfo::_standard_;
 	  m_set_parameters_nbins();
-	  m_PP2D.resize(m_nbins_D1+1, std::vector<double>(m_nbins_D2+1, 0.));
-	  m_PP2D_weighted.resize(m_nbins_D1+1, std::vector<double>(m_nbins_D2+1, 0.));
+	  m_PP2D.resize(m_nbins_D1+1, std::vector<ExactSum>(m_nbins_D2+1));
+	  m_PP2D_weighted.resize(m_nbins_D1+1, std::vector<ExactSum>(m_nbins_D2+1));
 	}
   
       /**
@@ -765,8 +800,8 @@ namespace cbl {
 	  m_pairType = PairType::_comovingCartesian_loglin_;
 	  m_pairInfo = PairInfo::_standard_;
 	  m_set_parameters_binSize();
-	  m_PP2D.resize(m_nbins_D1+1, std::vector<double>(m_nbins_D2+1, 0.));
-	  m_PP2D_weighted.resize(m_nbins_D1+1, std::vector<double>(m_nbins_D2+1, 0.));
+	  m_PP2D.resize(m_nbins_D1+1, std::vector<ExactSum>(m_nbins_D2+1));
+	  m_PP2D_weighted.resize(m_nbins_D1+1, std::vector<ExactSum>(m_nbins_D2+1));
 	} 
   
       /**
@@ -815,6 +850,9 @@ namespace cbl {
        */
       void put (const std::shared_ptr<catalogue::Object> obj1, const std::shared_ptr<catalogue::Object> obj2) override;
 
+      /// @copydoc cbl::pairs::Pair::put(const chainmesh::CellObjects &, const long, const long, const chainmesh::CellObjects &, const long, const long, const bool)
+      void put (const chainmesh::CellObjects &obj1, const long i_min, const long i_max, const chainmesh::CellObjects &obj2, const long j_min, const long j_max, const bool auto_pairs=false) override;
+
       ///@}
 
     };
@@ -896,8 +934,8 @@ namespace cbl {
 	  m_pairType = PairType::_comovingCartesian_linlog_;
 	  m_pairInfo = PairInfo::_standard_;
 	  m_set_parameters_nbins();
-	  m_PP2D.resize(m_nbins_D1+1, std::vector<double>(m_nbins_D2+1, 0.));
-	  m_PP2D_weighted.resize(m_nbins_D1+1, std::vector<double>(m_nbins_D2+1, 0.));
+	  m_PP2D.resize(m_nbins_D1+1, std::vector<ExactSum>(m_nbins_D2+1));
+	  m_PP2D_weighted.resize(m_nbins_D1+1, std::vector<ExactSum>(m_nbins_D2+1));
 	}
   
       /**
@@ -924,8 +962,8 @@ namespace cbl {
 	  m_pairType = PairType::_comovingCartesian_linlog_;
 	  m_pairInfo = PairInfo::_standard_;
 	  m_set_parameters_binSize();
-	  m_PP2D.resize(m_nbins_D1+1, std::vector<double>(m_nbins_D2+1, 0.));
-	  m_PP2D_weighted.resize(m_nbins_D1+1, std::vector<double>(m_nbins_D2+1, 0.));
+	  m_PP2D.resize(m_nbins_D1+1, std::vector<ExactSum>(m_nbins_D2+1));
+	  m_PP2D_weighted.resize(m_nbins_D1+1, std::vector<ExactSum>(m_nbins_D2+1));
 	} 
   
       /**
@@ -974,6 +1012,9 @@ namespace cbl {
        */
       void put (const std::shared_ptr<catalogue::Object> obj1, const std::shared_ptr<catalogue::Object> obj2) override;
 
+      /// @copydoc cbl::pairs::Pair::put(const chainmesh::CellObjects &, const long, const long, const chainmesh::CellObjects &, const long, const long, const bool)
+      void put (const chainmesh::CellObjects &obj1, const long i_min, const long i_max, const chainmesh::CellObjects &obj2, const long j_min, const long j_max, const bool auto_pairs=false) override;
+
       ///@}
 
     };
@@ -1055,8 +1096,8 @@ namespace cbl {
 	  m_pairType = PairType::_comovingCartesian_loglog_;
 	  m_pairInfo = PairInfo::_standard_;
 	  m_set_parameters_nbins();
-	  m_PP2D.resize(m_nbins_D1+1, std::vector<double>(m_nbins_D2+1, 0.));
-	  m_PP2D_weighted.resize(m_nbins_D1+1, std::vector<double>(m_nbins_D2+1, 0.));
+	  m_PP2D.resize(m_nbins_D1+1, std::vector<ExactSum>(m_nbins_D2+1));
+	  m_PP2D_weighted.resize(m_nbins_D1+1, std::vector<ExactSum>(m_nbins_D2+1));
 	}
   
       /**
@@ -1083,8 +1124,8 @@ namespace cbl {
 	  m_pairType = PairType::_comovingCartesian_loglog_;
 	  m_pairInfo = PairInfo::_standard_;
 	  m_set_parameters_binSize();
-	  m_PP2D.resize(m_nbins_D1+1, std::vector<double>(m_nbins_D2+1, 0.));
-	  m_PP2D_weighted.resize(m_nbins_D1+1, std::vector<double>(m_nbins_D2+1, 0.));
+	  m_PP2D.resize(m_nbins_D1+1, std::vector<ExactSum>(m_nbins_D2+1));
+	  m_PP2D_weighted.resize(m_nbins_D1+1, std::vector<ExactSum>(m_nbins_D2+1));
 	} 
   
       /**
@@ -1133,6 +1174,9 @@ namespace cbl {
        */
       void put (const std::shared_ptr<catalogue::Object> obj1, const std::shared_ptr<catalogue::Object> obj2) override;
 
+      /// @copydoc cbl::pairs::Pair::put(const chainmesh::CellObjects &, const long, const long, const chainmesh::CellObjects &, const long, const long, const bool)
+      void put (const chainmesh::CellObjects &obj1, const long i_min, const long i_max, const chainmesh::CellObjects &obj2, const long j_min, const long j_max, const bool auto_pairs=false) override;
+
       ///@}
 
     };
@@ -1285,6 +1329,29 @@ namespace cbl {
        */
       double sMax_D2 () const override { return m_muMax; }
 
+      /**
+       *  @brief discard at once all the pairs between two blocks of
+       *  contiguous objects, if their separations are all outside
+       *  the binning range
+       *  @param obj1 the objects containing the first block
+       *  @param i_min index of the first object of the first block
+       *  @param i_max index of the last object of the first block
+       *  plus one
+       *  @param obj2 the objects containing the second block
+       *  @param j_min index of the first object of the second block
+       *  @param j_max index of the last object of the second block
+       *  plus one
+       *  @param auto_pairs true &rarr; the two blocks are the same,
+       *  and only the pairs (i, j) with j>i are counted
+       *  @param dist_min the minimum comoving distance between the
+       *  objects of the two blocks
+       *  @param dist_max the maximum comoving distance between the
+       *  objects of the two blocks
+       *  @return true if the pairs have been discarded; false if
+       *  they have to be counted one by one
+       */
+      bool put_cells (const chainmesh::CellObjects &obj1, const long i_min, const long i_max, const chainmesh::CellObjects &obj2, const long j_min, const long j_max, const bool auto_pairs, const double dist_min, const double dist_max) override;
+
       ///@}
     
     };
@@ -1365,8 +1432,8 @@ namespace cbl {
 	  m_pairType = PairType::_comovingPolar_linlin_;
 	  m_pairInfo = PairInfo::_standard_;
 	  m_set_parameters_nbins();
-	  m_PP2D.resize(m_nbins_D1+1, std::vector<double>(m_nbins_D2+1, 0.));
-	  m_PP2D_weighted.resize(m_nbins_D1+1, std::vector<double>(m_nbins_D2+1, 0.));
+	  m_PP2D.resize(m_nbins_D1+1, std::vector<ExactSum>(m_nbins_D2+1));
+	  m_PP2D_weighted.resize(m_nbins_D1+1, std::vector<ExactSum>(m_nbins_D2+1));
 	}
   
       /**
@@ -1391,8 +1458,8 @@ namespace cbl {
 	  m_pairType = PairType::_comovingPolar_linlin_;
 	  m_pairInfo = PairInfo::_standard_;
 	  m_set_parameters_binSize();
-	  m_PP2D.resize(m_nbins_D1+1, std::vector<double>(m_nbins_D2+1, 0.));
-	  m_PP2D_weighted.resize(m_nbins_D1+1, std::vector<double>(m_nbins_D2+1, 0.));
+	  m_PP2D.resize(m_nbins_D1+1, std::vector<ExactSum>(m_nbins_D2+1));
+	  m_PP2D_weighted.resize(m_nbins_D1+1, std::vector<ExactSum>(m_nbins_D2+1));
 	} 
   
       /**
@@ -1441,6 +1508,9 @@ namespace cbl {
        */
       void put (const std::shared_ptr<catalogue::Object> obj1, const std::shared_ptr<catalogue::Object> obj2) override;
 
+      /// @copydoc cbl::pairs::Pair::put(const chainmesh::CellObjects &, const long, const long, const chainmesh::CellObjects &, const long, const long, const bool)
+      void put (const chainmesh::CellObjects &obj1, const long i_min, const long i_max, const chainmesh::CellObjects &obj2, const long j_min, const long j_max, const bool auto_pairs=false) override;
+
       ///@}
 
     };
@@ -1521,8 +1591,8 @@ namespace cbl {
 	  m_pairType = PairType::_comovingPolar_loglin_;
 	  m_pairInfo = PairInfo::_standard_;
 	  m_set_parameters_nbins();
-	  m_PP2D.resize(m_nbins_D1+1, std::vector<double>(m_nbins_D2+1, 0.));
-	  m_PP2D_weighted.resize(m_nbins_D1+1, std::vector<double>(m_nbins_D2+1, 0.));
+	  m_PP2D.resize(m_nbins_D1+1, std::vector<ExactSum>(m_nbins_D2+1));
+	  m_PP2D_weighted.resize(m_nbins_D1+1, std::vector<ExactSum>(m_nbins_D2+1));
 	}
   
       /**
@@ -1547,8 +1617,8 @@ namespace cbl {
 	  m_pairType = PairType::_comovingPolar_loglin_;
 	  m_pairInfo = PairInfo::_standard_;
 	  m_set_parameters_binSize();
-	  m_PP2D.resize(m_nbins_D1+1, std::vector<double>(m_nbins_D2+1, 0.));
-	  m_PP2D_weighted.resize(m_nbins_D1+1, std::vector<double>(m_nbins_D2+1, 0.));
+	  m_PP2D.resize(m_nbins_D1+1, std::vector<ExactSum>(m_nbins_D2+1));
+	  m_PP2D_weighted.resize(m_nbins_D1+1, std::vector<ExactSum>(m_nbins_D2+1));
 	} 
   
       /**
@@ -1597,6 +1667,9 @@ namespace cbl {
        */
       void put (const std::shared_ptr<catalogue::Object> obj1, const std::shared_ptr<catalogue::Object> obj2) override;
 
+      /// @copydoc cbl::pairs::Pair::put(const chainmesh::CellObjects &, const long, const long, const chainmesh::CellObjects &, const long, const long, const bool)
+      void put (const chainmesh::CellObjects &obj1, const long i_min, const long i_max, const chainmesh::CellObjects &obj2, const long j_min, const long j_max, const bool auto_pairs=false) override;
+
       ///@}
 
     };
@@ -1677,8 +1750,8 @@ namespace cbl {
 	  m_pairType = PairType::_comovingPolar_linlog_;
 	  m_pairInfo = PairInfo::_standard_;
 	  m_set_parameters_nbins();
-	  m_PP2D.resize(m_nbins_D1+1, std::vector<double>(m_nbins_D2+1, 0.));
-	  m_PP2D_weighted.resize(m_nbins_D1+1, std::vector<double>(m_nbins_D2+1, 0.));
+	  m_PP2D.resize(m_nbins_D1+1, std::vector<ExactSum>(m_nbins_D2+1));
+	  m_PP2D_weighted.resize(m_nbins_D1+1, std::vector<ExactSum>(m_nbins_D2+1));
 	}
   
       /**
@@ -1703,8 +1776,8 @@ namespace cbl {
 	  m_pairType = PairType::_comovingPolar_linlog_;
 	  m_pairInfo = PairInfo::_standard_;
 	  m_set_parameters_binSize();
-	  m_PP2D.resize(m_nbins_D1+1, std::vector<double>(m_nbins_D2+1, 0.));
-	  m_PP2D_weighted.resize(m_nbins_D1+1, std::vector<double>(m_nbins_D2+1, 0.));
+	  m_PP2D.resize(m_nbins_D1+1, std::vector<ExactSum>(m_nbins_D2+1));
+	  m_PP2D_weighted.resize(m_nbins_D1+1, std::vector<ExactSum>(m_nbins_D2+1));
 	} 
   
       /**
@@ -1753,6 +1826,9 @@ namespace cbl {
        */
       void put (const std::shared_ptr<catalogue::Object> obj1, const std::shared_ptr<catalogue::Object> obj2) override;
 
+      /// @copydoc cbl::pairs::Pair::put(const chainmesh::CellObjects &, const long, const long, const chainmesh::CellObjects &, const long, const long, const bool)
+      void put (const chainmesh::CellObjects &obj1, const long i_min, const long i_max, const chainmesh::CellObjects &obj2, const long j_min, const long j_max, const bool auto_pairs=false) override;
+
       ///@}
 
     };
@@ -1832,8 +1908,8 @@ namespace cbl {
 	  m_pairType = PairType::_comovingPolar_loglog_;
 	  m_pairInfo = PairInfo::_standard_;
 	  m_set_parameters_nbins();
-	  m_PP2D.resize(m_nbins_D1+1, std::vector<double>(m_nbins_D2+1, 0.));
-	  m_PP2D_weighted.resize(m_nbins_D1+1, std::vector<double>(m_nbins_D2+1, 0.));
+	  m_PP2D.resize(m_nbins_D1+1, std::vector<ExactSum>(m_nbins_D2+1));
+	  m_PP2D_weighted.resize(m_nbins_D1+1, std::vector<ExactSum>(m_nbins_D2+1));
 	}
   
       /**
@@ -1858,8 +1934,8 @@ namespace cbl {
 	  m_pairType = PairType::_comovingPolar_loglog_;
 	  m_pairInfo = PairInfo::_standard_;
 	  m_set_parameters_binSize();
-	  m_PP2D.resize(m_nbins_D1+1, std::vector<double>(m_nbins_D2+1, 0.));
-	  m_PP2D_weighted.resize(m_nbins_D1+1, std::vector<double>(m_nbins_D2+1, 0.));
+	  m_PP2D.resize(m_nbins_D1+1, std::vector<ExactSum>(m_nbins_D2+1));
+	  m_PP2D_weighted.resize(m_nbins_D1+1, std::vector<ExactSum>(m_nbins_D2+1));
 	} 
   
       /**
@@ -1908,6 +1984,9 @@ namespace cbl {
        */
       void put (const std::shared_ptr<catalogue::Object> obj1, const std::shared_ptr<catalogue::Object> obj2) override;
 
+      /// @copydoc cbl::pairs::Pair::put(const chainmesh::CellObjects &, const long, const long, const chainmesh::CellObjects &, const long, const long, const bool)
+      void put (const chainmesh::CellObjects &obj1, const long i_min, const long i_max, const chainmesh::CellObjects &obj2, const long j_min, const long j_max, const bool auto_pairs=false) override;
+
       ///@}
 
     };  
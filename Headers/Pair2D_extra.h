@@ -338,6 +338,21 @@ namespace cbl {
        *  @return none
        */
       void add_data2D (const int i, const int j, const std::shared_ptr<pairs::Pair> pair, const double ww=1.) override;
+
+      /**
+       *  @brief set the protected members by adding new data,
+       *  summing exactly the number of pairs
+       *  @param i the bin index in the first dimension
+       *  @param j the bin index in the second dimension
+       *  @param pp the number of pairs in the bin
+       *  @param pp_weighted the number of weighted pairs in the bin
+       *  @param extra vector containing the mean scale and the scale
+       *  variance times the weighted number of pairs in the first and
+       *  in the second dimension, the mean redshift and the redshift
+       *  variance times the weighted number of pairs
+       *  @return none
+       */
+      void add_data2D (const int i, const int j, const ExactSum pp, const ExactSum pp_weighted, const std::vector<double> extra={}) override;
       
       ///@}
 
@@ -500,8 +515,8 @@ namespace cbl {
 	  m_pairType = PairType::_comovingCartesian_linlin_;
 	  m_pairInfo = PairInfo::_extra_;
 	  m_set_parameters_nbins();
-	  m_PP2D.resize(m_nbins_D1+1, std::vector<double>(m_nbins_D2+1, 0.));
-	  m_PP2D_weighted.resize(m_nbins_D1+1, std::vector<double>(m_nbins_D2+1, 0.));
+	  m_PP2D.resize(m_nbins_D1+1, std::vector<ExactSum>(m_nbins_D2+1));
+	  m_PP2D_weighted.resize(m_nbins_D1+1, std::vector<ExactSum>(m_nbins_D2+1));
 	  m_scale_D1_mean.resize(m_nbins_D1+1, std::vector<double>(m_nbins_D2+1, 0.));
 	  m_scale_D2_mean.resize(m_nbins_D1+1, std::vector<double>(m_nbins_D2+1, 0.));
 	  m_scale_D1_S.resize(m_nbins_D1+1, std::vector<double>(m_nbins_D2+1, 0.));
@@ -537,8 +552,8 @@ namespace cbl {
 	  m_pairType = PairType::_comovingCartesian_linlin_;
 	  m_pairInfo = PairInfo::_extra_;
 	  m_set_parameters_binSize();
-	  m_PP2D.resize(m_nbins_D1+1, std::vector<double>(m_nbins_D2+1, 0.));
-	  m_PP2D_weighted.resize(m_nbins_D1+1, std::vector<double>(m_nbins_D2+1, 0.));
+	  m_PP2D.resize(m_nbins_D1+1, std::vector<ExactSum>(m_nbins_D2+1));
+	  m_PP2D_weighted.resize(m_nbins_D1+1, std::vector<ExactSum>(m_nbins_D2+1));
 	  m_scale_D1_mean.resize(m_nbins_D1+1, std::vector<double>(m_nbins_D2+1, 0.));
 	  m_scale_D2_mean.resize(m_nbins_D1+1, std::vector<double>(m_nbins_D2+1, 0.));
 	  m_scale_D1_S.resize(m_nbins_D1+1, std::vector<double>(m_nbins_D2+1, 0.));
@@ -572,6 +587,9 @@ namespace cbl {
        *  @return none
        */
       void put (const std::shared_ptr<catalogue::Object> obj1, const std::shared_ptr<catalogue::Object> obj2) override;
+
+      /// @copydoc cbl::pairs::Pair::put(const chainmesh::CellObjects &, const long, const long, const chainmesh::CellObjects &, const long, const long, const bool)
+      void put (const chainmesh::CellObjects &obj1, const long i_min, const long i_max, const chainmesh::CellObjects &obj2, const long j_min, const long j_max, const bool auto_pairs=false) override;
   
       ///@}
 
@@ -634,8 +652,8 @@ namespace cbl {
 	  m_pairType = PairType::_comovingCartesian_loglin_;
 	  m_pairInfo = PairInfo::_extra_;
 	  m_set_parameters_nbins();
-	  m_PP2D.resize(m_nbins_D1+1, std::vector<double>(m_nbins_D2+1, 0.));
-	  m_PP2D_weighted.resize(m_nbins_D1+1, std::vector<double>(m_nbins_D2+1, 0.));
+	  m_PP2D.resize(m_nbins_D1+1, std::vector<ExactSum>(m_nbins_D2+1));
+	  m_PP2D_weighted.resize(m_nbins_D1+1, std::vector<ExactSum>(m_nbins_D2+1));
 	  m_scale_D1_mean.resize(m_nbins_D1+1, std::vector<double>(m_nbins_D2+1, 0.));
 	  m_scale_D2_mean.resize(m_nbins_D1+1, std::vector<double>(m_nbins_D2+1, 0.));
 	  m_scale_D1_S.resize(m_nbins_D1+1, std::vector<double>(m_nbins_D2+1, 0.));
@@ -671,8 +689,8 @@ namespace cbl {
 	  m_pairType = PairType::_comovingCartesian_loglin_;
 	  m_pairInfo = PairInfo::_extra_;
 	  m_set_parameters_binSize();
-	  m_PP2D.resize(m_nbins_D1+1, std::vector<double>(m_nbins_D2+1, 0.));
-	  m_PP2D_weighted.resize(m_nbins_D1+1, std::vector<double>(m_nbins_D2+1, 0.));
+	  m_PP2D.resize(m_nbins_D1+1, std::vector<ExactSum>(m_nbins_D2+1));
+	  m_PP2D_weighted.resize(m_nbins_D1+1, std::vector<ExactSum>(m_nbins_D2+1));
 	  m_scale_D1_mean.resize(m_nbins_D1+1, std::vector<double>(m_nbins_D2+1, 0.));
 	  m_scale_D2_mean.resize(m_nbins_D1+1, std::vector<double>(m_nbins_D2+1, 0.));
 	  m_scale_D1_S.resize(m_nbins_D1+1, std::vector<double>(m_nbins_D2+1, 0.));
@@ -706,6 +724,9 @@ namespace cbl {
        *  @return none
        */
       void put (const std::shared_ptr<catalogue::Object> obj1, const std::shared_ptr<catalogue::Object> obj2) override;
+
+      /// @copydoc cbl::pairs::Pair::put(const chainmesh::CellObjects &, const long, const long, const chainmesh::CellObjects &, const long, const long, const bool)
+      void put (const chainmesh::CellObjects &obj1, const long i_min, const long i_max, const chainmesh::CellObjects &obj2, const long j_min, const long j_max, const bool auto_pairs=false) override;
   
       ///@}
 
@@ -767,8 +788,8 @@ namespace cbl {
 	  m_pairType = PairType::_comovingCartesian_linlog_;
 	  m_pairInfo = PairInfo::_extra_;
 	  m_set_parameters_nbins();
-	  m_PP2D.resize(m_nbins_D1+1, std::vector<double>(m_nbins_D2+1, 0.));
-	  m_PP2D_weighted.resize(m_nbins_D1+1, std::vector<double>(m_nbins_D2+1, 0.));
+	  m_PP2D.resize(m_nbins_D1+1, std::vector<ExactSum>(m_nbins_D2+1));
+	  m_PP2D_weighted.resize(m_nbins_D1+1, std::vector<ExactSum>(m_nbins_D2+1));
 	  m_scale_D1_mean.resize(m_nbins_D1+1, std::vector<double>(m_nbins_D2+1, 0.));
 	  m_scale_D2_mean.resize(m_nbins_D1+1, std::vector<double>(m_nbins_D2+1, 0.));
 	  m_scale_D1_S.resize(m_nbins_D1+1, std::vector<double>(m_nbins_D2+1, 0.));
@@ -804,8 +825,8 @@ namespace cbl {
 	  m_pairType = PairType::_comovingCartesian_linlog_;
 	  m_pairInfo = PairInfo::_extra_;
 	  m_set_parameters_binSize();
-	  m_PP2D.resize(m_nbins_D1+1, std::vector<double>(m_nbins_D2+1, 0.));
-	  m_PP2D_weighted.resize(m_nbins_D1+1, std::vector<double>(m_nbins_D2+1, 0.));
+	  m_PP2D.resize(m_nbins_D1+1, std::vector<ExactSum>(m_nbins_D2+1));
+	  m_PP2D_weighted.resize(m_nbins_D1+1, std::vector<ExactSum>(m_nbins_D2+1));
 	  m_scale_D1_mean.resize(m_nbins_D1+1, std::vector<double>(m_nbins_D2+1, 0.));
 	  m_scale_D2_mean.resize(m_nbins_D1+1, std::vector<double>(m_nbins_D2+1, 0.));
 	  m_scale_D1_S.resize(m_nbins_D1+1, std::vector<double>(m_nbins_D2+1, 0.));
@@ -839,6 +860,9 @@ namespace cbl {
        *  @return none
        */
       void put (const std::shared_ptr<catalogue::Object> obj1, const std::shared_ptr<catalogue::Object> obj2) override;
+
+      /// @copydoc cbl::pairs::Pair::put(const chainmesh::CellObjects &, const long, const long, const chainmesh::CellObjects &, const long, const long, const bool)
+      void put (const chainmesh::CellObjects &obj1, const long i_min, const long i_max, const chainmesh::CellObjects &obj2, const long j_min, const long j_max, const bool auto_pairs=false) override;
   
       ///@}
 
@@ -900,8 +924,8 @@ namespace cbl {
 	  m_pairType = PairType::_comovingCartesian_loglog_;
 	  m_pairInfo = PairInfo::_extra_;
 	  m_set_parameters_nbins();
-	  m_PP2D.resize(m_nbins_D1+1, std::vector<double>(m_nbins_D2+1, 0.));
-	  m_PP2D_weighted.resize(m_nbins_D1+1, std::vector<double>(m_nbins_D2+1, 0.));
+	  m_PP2D.resize(m_nbins_D1+1, std::vector<ExactSum>(m_nbins_D2+1));
+	  m_PP2D_weighted.resize(m_nbins_D1+1, std::vector<ExactSum>(m_nbins_D2+1));
 	  m_scale_D1_mean.resize(m_nbins_D1+1, std::vector<double>(m_nbins_D2+1, 0.));
 	  m_scale_D2_mean.resize(m_nbins_D1+1, std::vector<double>(m_nbins_D2+1, 0.));
 	  m_scale_D1_S.resize(m_nbins_D1+1, std::vector<double>(m_nbins_D2+1, 0.));
@@ -937,8 +961,8 @@ namespace cbl {
 	  m_pairType = PairType::_comovingCartesian_loglog_;
 	  m_pairInfo = PairInfo::_extra_;
 	  m_set_parameters_binSize();
-	  m_PP2D.resize(m_nbins_D1+1, std::vector<double>(m_nbins_D2+1, 0.));
-	  m_PP2D_weighted.resize(m_nbins_D1+1, std::vector<double>(m_nbins_D2+1, 0.));
+	  m_PP2D.resize(m_nbins_D1+1, std::vector<ExactSum>(m_nbins_D2+1));
+	  m_PP2D_weighted.resize(m_nbins_D1+1, std::vector<ExactSum>(m_nbins_D2+1));
 	  m_scale_D1_mean.resize(m_nbins_D1+1, std::vector<double>(m_nbins_D2+1, 0.));
 	  m_scale_D2_mean.resize(m_nbins_D1+1, std::vector<double>(m_nbins_D2+1, 0.));
 	  m_scale_D1_S.resize(m_nbins_D1+1, std::vector<double>(m_nbins_D2+1, 0.));
@@ -972,6 +996,9 @@ namespace cbl {
        *  @return none
        */
       void put (const std::shared_ptr<catalogue::Object> obj1, const std::shared_ptr<catalogue::Object> obj2) override;
+
+      /// @copydoc cbl::pairs::Pair::put(const chainmesh::CellObjects &, const long, const long, const chainmesh::CellObjects &, const long, const long, const bool)
+      void put (const chainmesh::CellObjects &obj1, const long i_min, const long i_max, const chainmesh::CellObjects &obj2, const long j_min, const long j_max, const bool auto_pairs=false) override;
   
       ///@}
 
@@ -1108,8 +1135,8 @@ namespace cbl {
 	  m_pairType = PairType::_comovingPolar_linlin_;
 	  m_pairInfo = PairInfo::_extra_;
 	  m_set_parameters_nbins();
-	  m_PP2D.resize(m_nbins_D1+1, std::vector<double>(m_nbins_D2+1, 0.));
-	  m_PP2D_weighted.resize(m_nbins_D1+1, std::vector<double>(m_nbins_D2+1, 0.));
+	  m_PP2D.resize(m_nbins_D1+1, std::vector<ExactSum>(m_nbins_D2+1));
+	  m_PP2D_weighted.resize(m_nbins_D1+1, std::vector<ExactSum>(m_nbins_D2+1));
 	  m_scale_D1_mean.resize(m_nbins_D1+1, std::vector<double>(m_nbins_D2+1, 0.));
 	  m_scale_D2_mean.resize(m_nbins_D1+1, std::vector<double>(m_nbins_D2+1, 0.));
 	  m_scale_D1_S.resize(m_nbins_D1+1, std::vector<double>(m_nbins_D2+1, 0.));
@@ -1143,8 +1170,8 @@ namespace cbl {
 	  m_pairType = PairType::_comovingPolar_linlin_;
 	  m_pairInfo = PairInfo::_extra_;
 	  m_set_parameters_binSize();
-	  m_PP2D.resize(m_nbins_D1+1, std::vector<double>(m_nbins_D2+1, 0.));
-	  m_PP2D_weighted.resize(m_nbins_D1+1, std::vector<double>(m_nbins_D2+1, 0.));
+	  m_PP2D.resize(m_nbins_D1+1, std::vector<ExactSum>(m_nbins_D2+1));
+	  m_PP2D_weighted.resize(m_nbins_D1+1, std::vector<ExactSum>(m_nbins_D2+1));
 	  m_scale_D1_mean.resize(m_nbins_D1+1, std::vector<double>(m_nbins_D2+1, 0.));
 	  m_scale_D2_mean.resize(m_nbins_D1+1, std::vector<double>(m_nbins_D2+1, 0.));
 	  m_scale_D1_S.resize(m_nbins_D1+1, std::vector<double>(m_nbins_D2+1, 0.));
@@ -1178,6 +1205,9 @@ namespace cbl {
        *  @return none
        */
       void put (const std::shared_ptr<catalogue::Object> obj1, const std::shared_ptr<catalogue::Object> obj2) override;
+
+      /// @copydoc cbl::pairs::Pair::put(const chainmesh::CellObjects &, const long, const long, const chainmesh::CellObjects &, const long, const long, const bool)
+      void put (const chainmesh::CellObjects &obj1, const long i_min, const long i_max, const chainmesh::CellObjects &obj2, const long j_min, const long j_max, const bool auto_pairs=false) override;
   
       ///@}
 
@@ -1238,8 +1268,8 @@ namespace cbl {
 	  m_pairType = PairType::_comovingPolar_loglin_;
 	  m_pairInfo = PairInfo::_extra_;
 	  m_set_parameters_nbins();
-	  m_PP2D.resize(m_nbins_D1+1, std::vector<double>(m_nbins_D2+1, 0.));
-	  m_PP2D_weighted.resize(m_nbins_D1+1, std::vector<double>(m_nbins_D2+1, 0.));
+	  m_PP2D.resize(m_nbins_D1+1, std::vector<ExactSum>(m_nbins_D2+1));
+	  m_PP2D_weighted.resize(m_nbins_D1+1, std::vector<ExactSum>(m_nbins_D2+1));
 	  m_scale_D1_mean.resize(m_nbins_D1+1, std::vector<double>(m_nbins_D2+1, 0.));
 	  m_scale_D2_mean.resize(m_nbins_D1+1, std::vector<double>(m_nbins_D2+1, 0.));
 	  m_scale_D1_S.resize(m_nbins_D1+1, std::vector<double>(m_nbins_D2+1, 0.));
@@ -1273,8 +1303,8 @@ namespace cbl {
 	  m_pairType = PairType::_comovingPolar_loglin_;
 	  m_pairInfo = PairInfo::_extra_;
 	  m_set_parameters_binSize();
-	  m_PP2D.resize(m_nbins_D1+1, std::vector<double>(m_nbins_D2+1, 0.));
-	  m_PP2D_weighted.resize(m_nbins_D1+1, std::vector<double>(m_nbins_D2+1, 0.));
+	  m_PP2D.resize(m_nbins_D1+1, std::vector<ExactSum>(m_nbins_D2+1));
+	  m_PP2D_weighted.resize(m_nbins_D1+1, std::vector<ExactSum>(m_nbins_D2+1));
 	  m_scale_D1_mean.resize(m_nbins_D1+1, std::vector<double>(m_nbins_D2+1, 0.));
 	  m_scale_D2_mean.resize(m_nbins_D1+1, std::vector<double>(m_nbins_D2+1, 0.));
 	  m_scale_D1_S.resize(m_nbins_D1+1, std::vector<double>(m_nbins_D2+1, 0.));
@@ -1308,6 +1338,9 @@ namespace cbl {
        *  @return none
        */
       void put (const std::shared_ptr<catalogue::Object> obj1, const std::shared_ptr<catalogue::Object> obj2) override;
+
+      /// @copydoc cbl::pairs::Pair::put(const chainmesh::CellObjects &, const long, const long, const chainmesh::CellObjects &, const long, const long, const bool)
+      void put (const chainmesh::CellObjects &obj1, const long i_min, const long i_max, const chainmesh::CellObjects &obj2, const long j_min, const long j_max, const bool auto_pairs=false) override;
   
       ///@}
 
@@ -1368,8 +1401,8 @@ namespace cbl {
 	  m_pairType = PairType::_comovingPolar_linlog_;
 	  m_pairInfo = PairInfo::_extra_;
 	  m_set_parameters_nbins();
-	  m_PP2D.resize(m_nbins_D1+1, std::vector<double>(m_nbins_D2+1, 0.));
-	  m_PP2D_weighted.resize(m_nbins_D1+1, std::vector<double>(m_nbins_D2+1, 0.));
+	  m_PP2D.resize(m_nbins_D1+1, std::vector<ExactSum>(m_nbins_D2+1));
+	  m_PP2D_weighted.resize(m_nbins_D1+1, std::vector<ExactSum>(m_nbins_D2+1));
 	  m_scale_D1_mean.resize(m_nbins_D1+1, std::vector<double>(m_nbins_D2+1, 0.));
 	  m_scale_D2_mean.resize(m_nbins_D1+1, std::vector<double>(m_nbins_D2+1, 0.));
 	  m_scale_D1_S.resize(m_nbins_D1+1, std::vector<double>(m_nbins_D2+1, 0.));
@@ -1403,8 +1436,8 @@ namespace cbl {
 	  m_pairType = PairType::_comovingPolar_linlog_;
 	  m_pairInfo = PairInfo::_extra_;
 	  m_set_parameters_binSize();
-	  m_PP2D.resize(m_nbins_D1+1, std::vector<double>(m_nbins_D2+1, 0.));
-	  m_PP2D_weighted.resize(m_nbins_D1+1, std::vector<double>(m_nbins_D2+1, 0.));
+	  m_PP2D.resize(m_nbins_D1+1, std::vector<ExactSum>(m_nbins_D2+1));
+	  m_PP2D_weighted.resize(m_nbins_D1+1, std::vector<ExactSum>(m_nbins_D2+1));
 	  m_scale_D1_mean.resize(m_nbins_D1+1, std::vector<double>(m_nbins_D2+1, 0.));
 	  m_scale_D2_mean.resize(m_nbins_D1+1, std::vector<double>(m_nbins_D2+1, 0.));
 	  m_scale_D1_S.resize(m_nbins_D1+1, std::vector<double>(m_nbins_D2+1, 0.));
@@ -1438,6 +1471,9 @@ namespace cbl {
        *  @return none
        */
       void put (const std::shared_ptr<catalogue::Object> obj1, const std::shared_ptr<catalogue::Object> obj2) override;
+
+      /// @copydoc cbl::pairs::Pair::put(const chainmesh::CellObjects &, const long, const long, const chainmesh::CellObjects &, const long, const long, const bool)
+      void put (const chainmesh::CellObjects &obj1, const long i_min, const long i_max, const chainmesh::CellObjects &obj2, const long j_min, const long j_max, const bool auto_pairs=false) override;
   
       ///@}
 
@@ -1497,8 +1533,8 @@ namespace cbl {
 	  m_pairType = PairType::_comovingPolar_loglog_;
 	  m_pairInfo = PairInfo::_extra_;
 	  m_set_parameters_nbins();
-	  m_PP2D.resize(m_nbins_D1+1, std::vector<double>(m_nbins_D2+1, 0.));
-	  m_PP2D_weighted.resize(m_nbins_D1+1, std::vector<double>(m_nbins_D2+1, 0.));
+	  m_PP2D.resize(m_nbins_D1+1, std::vector<ExactSum>(m_nbins_D2+1));
+	  m_PP2D_weighted.resize(m_nbins_D1+1, std::vector<ExactSum>(m_nbins_D2+1));
 	  m_scale_D1_mean.resize(m_nbins_D1+1, std::vector<double>(m_nbins_D2+1, 0.));
 	  m_scale_D2_mean.resize(m_nbins_D1+1, std::vector<double>(m_nbins_D2+1, 0.));
 	  m_scale_D1_S.resize(m_nbins_D1+1, std::vector<double>(m_nbins_D2+1, 0.));
@@ -1532,8 +1568,8 @@ namespace cbl {
 	  m_pairType = PairType::_comovingPolar_loglog_;
 	  m_pairInfo = PairInfo::_extra_;
 	  m_set_parameters_binSize();
-	  m_PP2D.resize(m_nbins_D1+1, std::vector<double>(m_nbins_D2+1, 0.));
-	  m_PP2D_weighted.resize(m_nbins_D1+1, std::vector<double>(m_nbins_D2+1, 0.));
+	  m_PP2D.resize(m_nbins_D1+1, std::vector<ExactSum>(m_nbins_D2+1));
+	  m_PP2D_weighted.resize(m_nbins_D1+1, std::vector<ExactSum>(m_nbins_D2+1));
 	  m_scale_D1_mean.resize(m_nbins_D1+1, std::vector<double>(m_nbins_D2+1, 0.));
 	  m_scale_D2_mean.resize(m_nbins_D1+1, std::vector<double>(m_nbins_D2+1, 0.));
 	  m_scale_D1_S.resize(m_nbins_D1+1, std::vector<double>(m_nbins_D2+1, 0.));
@@ -1567,6 +1603,9 @@ namespace cbl {
        *  @return none
        */
       void put (const std::shared_ptr<catalogue::Object> obj1, const std::shared_ptr<catalogue::Object> obj2) override;
+
+      /// @copydoc cbl::pairs::Pair::put(const chainmesh::CellObjects &, const long, const long, const chainmesh::CellObjects &, const long, const long, const bool)
+      void put (const chainmesh::CellObjects &obj1, const long i_min, const long i_max, const chainmesh::CellObjects &obj2, const long j_min, const long j_max, const bool auto_pairs=false) override;
   
       ///@}
 
@@ -36,6 +36,7 @@
 #include "RandomNumbers.h"
 #include "Prior.h"
 #include "Likelihood.h"
+#include "NestedSampler.h"
 
 
 // ===================================================================================================
@@ -65,6 +66,15 @@ namespace cbl {
 	/// the MCMC acceptance rate
 	std::vector<double> m_acceptance;
 
+	/// the logarithm of the evidence, computed by the nested sampler
+	double m_log_evidence = par::defaultDouble;
+
+	/// the error on the logarithm of the evidence
+	double m_log_evidence_error = par::defaultDouble;
+
+	/// the effective sample size of the nested sampler
+	double m_effective_sample_size = 0.;
+
         /// general seed for prior/posterior distribution and sampler
 	int m_seed;
 
@@ -188,6 +198,22 @@ namespace cbl {
 	 */
 	double log (std::vector<double> &pp) const;
 
+	/**
+	 *  @brief the logarithm of the un-normalized posterior for
+	 *  several sets of parameters
+	 *
+	 *  the prior is computed for each set of parameters, while the
+	 *  likelihood is computed at once for the sets of parameters
+	 *  inside the prior range, so that the model can share the
+	 *  quantities that do not depend on the parameters
+	 *
+	 *  @param pp the sets of parameters
+	 *
+	 *  @return the logarithm of the un-normalized posterior for
+	 *  each set of parameters
+	 */
+	std::vector<double> log (std::vector<std::vector<double>> &pp) const;
+
 	/**
 	 * @brief set the model for the likelihood analysis 
 	 *
@@ -395,6 +421,105 @@ namespace cbl {
 	 */
 	void sample_stretch_move (const double aa=2, const bool parallel=true, const std::string outputFile=par::defaultString, const int start=0, const int thin=1, const int nbins=50);
 
+	/**
+	 *  @brief sample the posterior using the parallel stretch-move
+	 *  sampler (Foreman-Mackey et al. 2012), writing the chains on
+	 *  a binary file while sampling
+	 *
+	 *  the steps are written on the file in blocks, and only the
+	 *  last steps are kept in memory, so that long runs do not
+	 *  need to store the full chains. If resume is true and the
+	 *  file exists, the sampling continues from its last step,
+	 *  until the chains contain the number of steps set by
+	 *  Posterior::initialize_chains; the seed of the posterior
+	 *  must be the same used to write the file. At the end, the chains are
+	 *  read from the file with the given burn-in and dilution,
+	 *  and the best-fit parameters are set to their medians
+	 *
+	 *  @param output_dir the output directory
+	 *
+	 *  @param output_file the output file
+	 *
+	 *  @param aa the parameter of the \f$g(z)\f$ distribution
+	 *
+	 *  @param resume true \f$\rightarrow\f$ continue the chains
+	 *  of the file, if it exists; false \f$\rightarrow\f$
+	 *  overwrite the file
+	 *
+	 *  @param block_size the number of steps written on the file
+	 *  at once
+	 *
+	 *  @param start the minimum chain position read from the file
+	 *  (burn-in)
+	 *
+	 *  @param thin the step used for chain dilution
+	 *
+	 *  @param nbins the number of bins to estimate the posterior
+	 *  distribution, used to assess its properties
+	 *
+	 *  @return none
+	 *
+	 *  @warning pointers cannot be used inside the posterior
+	 *  function
+	 */
+	void sample_stretch_move_streaming (const std::string output_dir, const std::string output_file, const double aa=2, const bool resume=true, const int block_size=100, const int start=0, const int thin=1, const int nbins=50);
+
+	/**
+	 *  @brief sample the posterior and compute the evidence with
+	 *  the nested sampler (see cbl::statistics::NestedSampler)
+	 *
+	 *  the live points are drawn from the prior distributions of
+	 *  the parameters; at the end, the chains are set to the
+	 *  equally weighted posterior samples (with one walker), whose
+	 *  number is the effective sample size, and the best-fit
+	 *  parameters are set to their medians
+	 *
+	 *  @param nlive the number of live points
+	 *
+	 *  @param dlogz the tolerance on the logarithm of the evidence,
+	 *  used to stop the sampling
+	 *
+	 *  @param nsteps the number of steps of the constrained walks
+	 *  used to draw the new live points
+	 *
+	 *  @param nparallel the number of live points replaced at each
+	 *  iteration, evolved in parallel; the results depend on it,
+	 *  but not on the number of threads
+	 *
+	 *  @param nbins the number of bins to estimate the posterior
+	 *  distribution, used to assess its properties
+	 *
+	 *  @return none
+	 *
+	 *  @warning pointers cannot be used inside the posterior
+	 *  function
+	 */
+	void sample_nested (const int nlive=500, const double dlogz=0.1, const int nsteps=20, const int nparallel=8, const int nbins=50);
+
+	/**
+	 *  @brief get the logarithm of the evidence, computed by
+	 *  Posterior::sample_nested
+	 *
+	 *  @return the logarithm of the evidence
+	 */
+	double log_evidence () const { return m_log_evidence; }
+
+	/**
+	 *  @brief get the error on the logarithm of the evidence,
+	 *  computed by Posterior::sample_nested
+	 *
+	 *  @return the error on the logarithm of the evidence
+	 */
+	double log_evidence_error () const { return m_log_evidence_error; }
+
+	/**
+	 *  @brief get the effective sample size of the posterior
+	 *  samples obtained by Posterior::sample_nested
+	 *
+	 *  @return the effective sample size
+	 */
+	double effective_sample_size () const { return m_effective_sample_size; }
+
 	/**
 	 * @brief write the chains obtained after 
 	 * the MCMC sampling on an ascii file
@@ -458,9 +583,14 @@ namespace cbl {
 	 * @param skip_header the lines to be skipped in
 	 * the chain file
 	 *
+	 * @param start the minimum chain position to be read
+	 * (burn-in)
+	 *
+	 * @param thin the step used for dilution
+	 *
 	 * @return none
 	 */
-	void read_chain_ascii (const std::string input_dir, const std::string input_file, const int nwalkers, const int skip_header=1);
+	void read_chain_ascii (const std::string input_dir, const std::string input_file, const int nwalkers, const int skip_header=1, const int start=0, const int thin=1);
 
 	/**
 	 * @brief read the chains from an ascii file
@@ -471,13 +601,42 @@ namespace cbl {
 	 *
 	 * @param nwalkers the number of parallel chains
 	 *
+	 * @param start the minimum chain position to be read
+	 * (burn-in)
+	 *
+	 * @param thin the step used for dilution
+	 *
+	 * @return none
+	 */
+	void read_chain_fits (const std::string input_dir, const std::string input_file, const int nwalkers, const int start=0, const int thin=1);
+
+	/**
+	 * @brief read the chains from a binary file, written by
+	 * Posterior::sample_stretch_move_streaming
+	 *
+	 * only the selected steps are read from the file
+	 *
+	 * @param input_dir the input directory
+	 *
+	 * @param input_file the input file
+	 *
+	 * @param start the minimum chain position to be read
+	 * (burn-in)
+	 *
+	 * @param thin the step used for dilution
+	 *
 	 * @return none
 	 */
-	void read_chain_fits (const std::string input_dir, const std::string input_file, const int nwalkers);
+	void read_chain_binary (const std::string input_dir, const std::string input_file, const int start=0, const int thin=1);
 
 	/**
 	 * @brief read the chains
 	 *
+	 * the binary chain files, written by
+	 * Posterior::sample_stretch_move_streaming, are recognized
+	 * from their header; in this case, skip_header and fits are
+	 * ignored
+	 *
 	 * @param input_dir the input directory
 	 *
 	 * @param input_file the input file
@@ -490,9 +649,14 @@ namespace cbl {
 	 * @param fits false \f$\rightarrow\f$ ascii file; true
 	 * \f$\rightarrow\f$ fits file
 	 *
+	 * @param start the minimum chain position to be read
+	 * (burn-in)
+	 *
+	 * @param thin the step used for dilution
+	 *
 	 * @return none
 	 */
-	void read_chain (const std::string input_dir, const std::string input_file, const int nwalkers, const int skip_header=1, const bool fits=false);
+	void read_chain (const std::string input_dir, const std::string input_file, const int nwalkers, const int skip_header=1, const bool fits=false, const int start=0, const int thin=1);
 
 	/**
 	 * @brief write maximization results on a file
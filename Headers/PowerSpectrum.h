@@ -0,0 +1,346 @@
+/********************************************************************
+ *  Copyright (C) 2010 by Federico Marulli and Alfonso Veropalumbo  *
+ *  federico.marulli3@unibo.it                                      *
+ *                                                                  *
+ *  This program is free software; you can redistribute it and/or   *
+ *  modify it under the terms of the GNU General Public License as  *
+ *  published by the Free Software Foundation; either version 2 of  *
+ *  the License, or (at your option) any later version.             *
+ *                                                                  *
+ *  This program is distributed in the hope that it will be useful, *
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of  *
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the   *
+ *  GNU General Public License for more details.                    *
+ *                                                                  *
+ *  You should have received a copy of the GNU General Public       *
+ *  License along with this program; if not, write to the Free      *
+ *  Software Foundation, Inc.,                                      *
+ *  59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.       *
+ *******************************************************************/
+
+/**
+ *  @file Headers/PowerSpectrum.h
+ *
+ *  @brief The class PowerSpectrum
+ *
+ *  This file defines the interface of the class PowerSpectrum, used
+ *  to measure the multipoles of the power spectrum with Fast Fourier
+ *  Transforms
+ *
+ *  @authors Federico Marulli, Alfonso Veropalumbo
+ *
+ *  @authors federico.marulli3@unbo.it, alfonso.veropalumbo@unibo.it
+ */
+
+#ifndef __POWERSPECTRUM__
+#define __POWERSPECTRUM__
+
+
+#include "Measure.h"
+#include "Field3D.h"
+#include "Data1D.h"
+
+
+// ===================================================================================================
+
+
+namespace cbl {
+
+  namespace measure {
+
+    /**
+     *  @brief The namespace of the <B> power spectrum </B>
+     *
+     *  The \e measure::powerspectrum namespace contains all the
+     *  functions and classes to measure the power spectrum
+     */
+    namespace powerspectrum {
+
+      /**
+       *  @class PowerSpectrum PowerSpectrum.h
+       *  "Headers/PowerSpectrum.h"
+       *
+       *  @brief The class PowerSpectrum
+       *
+       *  This class is used to measure the monopole, quadrupole and
+       *  hexadecapole of the power spectrum, using Fast Fourier
+       *  Transforms of the density field assigned to a grid
+       *  (ScalarField3D::assign_mass).
+       *
+       *  In a periodic box, the line of sight is the z-axis, and the
+       *  multipoles are obtained weighting the modes with the Legendre
+       *  polynomials of \f$\mu=k_z/k\f$.
+       *
+       *  In a survey, the field is \f$F(\vec{r}) = w(\vec{r})
+       *  [n_g(\vec{r})-\alpha n_r(\vec{r})]\f$, where \f$n_g\f$ and
+       *  \f$n_r\f$ are the data and random densities, \f$\alpha\f$
+       *  is the ratio between the weighted numbers of data and random
+       *  objects, and \f$w=1/(1+\bar{n}P_0)\f$ are the FKP weights
+       *  (Feldman, Kaiser & Peacock 1994), multiplied by the object
+       *  weights. The mean density \f$\bar{n}\f$ is estimated from
+       *  the random objects in the cells of the grid. The multipoles
+       *  are measured with the Yamamoto estimator, with the line of
+       *  sight of each object, computed with the Fast Fourier
+       *  Transforms of the field multiplied by the products of the
+       *  components of the line of sight (Bianchi et al. 2015,
+       *  Scoccimarro 2015): 1, 7 and 22 transforms are required for
+       *  the monopole, the quadrupole and the hexadecapole,
+       *  respectively. The observer is in the origin of the
+       *  coordinate system.
+       *
+       *  The shot noise is subtracted from the monopole, and the
+       *  window function of the mass assignment scheme is removed. The
+       *  errors are Gaussian, computed from the number of modes in
+       *  each bin, neglecting the survey window function.
+       */
+      class PowerSpectrum : public Measure {
+
+      protected :
+
+	/**
+	 *  @name Input catalogues
+	 */
+	///@{
+
+	/// input data catalogue
+	std::shared_ptr<catalogue::Catalogue> m_data;
+
+	/// input random catalogue (not set for a periodic box)
+	std::shared_ptr<catalogue::Catalogue> m_random;
+
+	///@}
+
+
+	/**
+	 *  @name Parameters of the measure
+	 */
+	///@{
+
+	/// the side of the periodic box (0 for a survey)
+	double m_boxSide;
+
+	/// the size of the cells of the grid
+	double m_cell_size;
+
+	/// the mass assignment scheme: 0 &rarr; NGP; 1 &rarr; CIC; 2 &rarr; TSC; 3 &rarr; PCS
+	int m_assignment_type;
+
+	/// true &rarr; the objects are assigned to the grid with interlacing
+	bool m_interlacing;
+
+	/// the power spectrum amplitude of the FKP weights
+	double m_P0_FKP;
+
+	/// the number of k bins
+	int m_nbins;
+
+	/// the minimum k
+	double m_kMin;
+
+	/// the maximum k
+	double m_kMax;
+
+	///@}
+
+
+	/**
+	 *  @name Output of the measure
+	 */
+	///@{
+
+	/// the mean k of the modes in each bin
+	std::vector<double> m_kk;
+
+	/// the number of modes in each bin
+	std::vector<double> m_nModes;
+
+	/// the monopole, quadrupole and hexadecapole in each bin
+	std::vector<std::vector<double>> m_pk;
+
+	/// the errors on the monopole, quadrupole and hexadecapole in each bin
+	std::vector<std::vector<double>> m_error;
+
+	/// the shot noise
+	double m_shot_noise = 0.;
+
+	///@}
+
+
+	/**
+	 *  @name Protected member functions to measure the power spectrum
+	 */
+	///@{
+
+	/**
+	 *  @brief measure the multipoles in a periodic box
+	 *  @param lMax the maximum order of the multipoles
+	 *  @return none
+	 */
+	void m_measure_box (const int lMax);
+
+	/**
+	 *  @brief measure the multipoles in a survey, with the Yamamoto
+	 *  estimator
+	 *  @param lMax the maximum order of the multipoles
+	 *  @return none
+	 */
+	void m_measure_survey (const int lMax);
+
+	/**
+	 *  @brief average the multipoles of the modes in the k bins
+	 *  @param field the grid, used to get the wavenumbers
+	 *  @param power the multipoles of the modes: power[l/2][index]
+	 *  is the multipole of order l of the mode with index in Fourier
+	 *  space
+	 *  @param normalization the normalization of the power spectrum
+	 *  @return none
+	 */
+	void m_bin (const data::ScalarField3D &field, const std::vector<std::vector<double>> &power, const double normalization);
+
+	///@}
+
+      public:
+
+	/**
+	 *  @name Constructors/destructors
+	 */
+	///@{
+
+	/**
+	 *  @brief default constructor
+	 *  @return object of class PowerSpectrum
+	 */
+	PowerSpectrum () = default;
+
+	/**
+	 *  @brief constructor used to measure the power spectrum in a
+	 *  periodic box
+	 *
+	 *  the box is [0, boxSide] along the three axes, and the line
+	 *  of sight is the z-axis
+	 *
+	 *  @param data object of class Catalogue containing the input
+	 *  catalogue
+	 *  @param boxSide the side of the box
+	 *  @param cell_size the size of the cells of the grid
+	 *  @param nbins the number of k bins
+	 *  @param kMin the minimum k
+	 *  @param kMax the maximum k; if not set, the Nyquist
+	 *  wavenumber of the grid is used
+	 *  @param assignment_type the mass assignment scheme: 0 &rarr;
+	 *  NGP; 1 &rarr; CIC; 2 &rarr; TSC; 3 &rarr; PCS
+	 *  @param interlacing true &rarr; assign the objects to the
+	 *  grid with interlacing, to reduce aliasing
+	 *  @return object of class PowerSpectrum
+	 */
+	PowerSpectrum (const catalogue::Catalogue &data, const double boxSide, const double cell_size, const int nbins, const double kMin=0., const double kMax=par::defaultDouble, const int assignment_type=2, const bool interlacing=true);
+
+	/**
+	 *  @brief constructor used to measure the power spectrum in a
+	 *  survey
+	 *
+	 *  the grid encloses all the data and random objects, and the
+	 *  observer is in the origin of the coordinate system
+	 *
+	 *  @param data object of class Catalogue containing the input
+	 *  catalogue
+	 *  @param random of class Catalogue containing the random data
+	 *  catalogue
+	 *  @param cell_size the size of the cells of the grid
+	 *  @param nbins the number of k bins
+	 *  @param kMin the minimum k
+	 *  @param kMax the maximum k; if not set, the Nyquist
+	 *  wavenumber of the grid is used
+	 *  @param P0_FKP the power spectrum amplitude of the FKP
+	 *  weights; if 0, the FKP weights are not used
+	 *  @param assignment_type the mass assignment scheme: 0 &rarr;
+	 *  NGP; 1 &rarr; CIC; 2 &rarr; TSC; 3 &rarr; PCS
+	 *  @param interlacing true &rarr; assign the objects to the
+	 *  grid with interlacing, to reduce aliasing
+	 *  @return object of class PowerSpectrum
+	 */
+	PowerSpectrum (const catalogue::Catalogue &data, const catalogue::Catalogue &random, const double cell_size, const int nbins, const double kMin=0., const double kMax=par::defaultDouble, const double P0_FKP=1.e4, const int assignment_type=2, const bool interlacing=true);
+
+	/**
+	 *  @brief default destructor
+	 *  @return none
+	 */
+	virtual ~PowerSpectrum () = default;
+
+	///@}
+
+
+	/**
+	 *  @name Member functions to get the protected members
+	 */
+	///@{
+
+	/**
+	 *  @brief get the mean k of the modes in each bin
+	 *  @return vector containing the mean k
+	 */
+	std::vector<double> kk () const { return m_kk; }
+
+	/**
+	 *  @brief get the number of modes in each bin
+	 *  @return vector containing the number of modes
+	 */
+	std::vector<double> nModes () const { return m_nModes; }
+
+	/**
+	 *  @brief get a multipole of the power spectrum
+	 *  @param ell the order of the multipole: 0, 2 or 4
+	 *  @return vector containing the multipole
+	 */
+	std::vector<double> Pk (const int ell) const;
+
+	/**
+	 *  @brief get the errors on a multipole of the power spectrum
+	 *  @param ell the order of the multipole: 0, 2 or 4
+	 *  @return vector containing the errors
+	 */
+	std::vector<double> error (const int ell) const;
+
+	/**
+	 *  @brief get the shot noise, subtracted from the monopole
+	 *  @return the shot noise
+	 */
+	double shot_noise () const { return m_shot_noise; }
+
+	///@}
+
+
+	/**
+	 *  @name Member functions to measure and write the power spectrum
+	 */
+	///@{
+
+	/**
+	 *  @brief measure the multipoles of the power spectrum
+	 *
+	 *  the dataset contains the monopole, quadrupole and
+	 *  hexadecapole, one after the other, as the datasets of the
+	 *  multipoles of the two-point correlation function; the
+	 *  multipoles of order larger than lMax are set to 0
+	 *
+	 *  @param lMax the maximum order of the multipoles: 0, 2 or 4
+	 *  @return none
+	 */
+	void measure (const int lMax=4);
+
+	/**
+	 *  @brief write the multipoles of the power spectrum
+	 *  @param dir output directory
+	 *  @param file output file
+	 *  @return none
+	 */
+	void write (const std::string dir, const std::string file) const;
+
+	///@}
+
+      };
+    }
+  }
+}
+
+#endif
@@ -645,6 +645,81 @@ namespace cbl {
 
     };
 
+    
+    /**
+     *  @class CounterRandomNumbers RandomNumbers.h
+     *  "Headers/RandomNumbers.h"
+     *
+     *  @brief The class CounterRandomNumbers
+     *
+     *  This class generates uniform random numbers with a
+     *  counter-based generator (Philox4x32-10, Salmon et al. 2011):
+     *  each random number is a function of the seed, of the stream
+     *  and of its position in the stream only. The objects do not
+     *  share any state, and are cheap to construct, so that each
+     *  thread, or each element of a parallel loop, can use its own
+     *  stream, and the results do not depend on the number of
+     *  threads
+     */
+    class CounterRandomNumbers
+    {
+
+    protected:
+
+      /// the key, i.e. the seed
+      std::array<uint32_t, 2> m_key;
+
+      /// the counter: the position in the stream, the substream and the stream
+      std::array<uint32_t, 4> m_counter;
+
+      /// the random numbers of the current block
+      std::array<uint32_t, 4> m_block;
+
+      /// the number of random numbers of the current block already used
+      int m_used;
+
+      /**
+       *  @brief compute the block of random numbers of the current
+       *  counter, and increase the counter
+       *  @return none
+       */
+      void m_next_block ();
+
+    public:
+
+      /**
+       *  @brief constructor
+       *  @param seed the random number generator seed
+       *  @param stream the stream (e.g. the index of the element of
+       *  a parallel loop)
+       *  @param substream the substream (e.g. the iteration)
+       *  @return object of class CounterRandomNumbers
+       */
+      CounterRandomNumbers (const int seed, const uint64_t stream, const uint32_t substream=0);
+
+      /**
+       *  @brief default destructor
+       *
+       *  @return none
+       */
+      ~CounterRandomNumbers () = default;
+
+      /**
+       * @brief extract a uniform random number in [0,1)
+       * @return random value
+       */
+      double operator () ();
+
+      /**
+       * @brief extract a uniform random integer
+       * @param MinVal the minimum value
+       * @param MaxVal the maximum value
+       * @return random integer in [MinVal, MaxVal]
+       */
+      int operator () (const int MinVal, const int MaxVal);
+
+    };
+
   }
 }
 
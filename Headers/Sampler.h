@@ -35,6 +35,7 @@
 #define __SAMP__
 
 #include "Distribution.h"
+#include "ChainFile.h"
 
 
 // ============================================================================================
@@ -55,6 +56,9 @@ namespace cbl {
 
       /// stretch-move sampler (Goodman & Weare 2010, Foreman-Mackey et al. 2012) 
       _StretchMove_,
+
+      /// nested sampler (Skilling 2006), see cbl::statistics::NestedSampler
+      _NestedSampling_,
       
     };
 
@@ -64,7 +68,7 @@ namespace cbl {
      * @return a vector containing the
      * SamplerType names
      */
-    inline std::vector<std::string> SamplerTypeNames () { return {"MetropolisHastings", "StretchMove"}; }
+    inline std::vector<std::string> SamplerTypeNames () { return {"MetropolisHastings", "StretchMove", "NestedSampling"}; }
 
     /**
      *
@@ -127,6 +131,9 @@ namespace cbl {
       /// the function to be sampled
       std::function<double(std::vector<double> &)> m_function;
 
+      /// the function to be sampled, computed for several walkers at once (optional)
+      std::function<std::vector<double>(std::vector<std::vector<double>> &)> m_function_batch;
+
       /// chain acceptance ratio
       std::vector<double> m_acceptance;
 
@@ -171,12 +178,16 @@ namespace cbl {
        *  for the parameters
        *  @param seed the seed for random number generator
        *  @param aa the stretch-move distribution parameter
+       *  @param chain_file the file where the chains are written
+       *  while sampling; if set, only the last two steps are kept
+       *  in memory, and the sampling is resumed from the last step
+       *  of the file, if any
        *
        *  @return none
        *
        *  @warning pointers cannot be used inside the input function
        */
-      void m_sample_stretch_move_parallel_cpp (const int chain_size, const int nwalkers, const std::vector<std::vector<double>> start, const int seed=4241, const double aa=2);
+      void m_sample_stretch_move_parallel_cpp (const int chain_size, const int nwalkers, const std::vector<std::vector<double>> start, const int seed=4241, const double aa=2, const std::shared_ptr<ChainFile> chain_file=NULL);
 
       /**
        *  @brief sample the input function using the stretch-move
@@ -312,6 +323,23 @@ namespace cbl {
        */
       void set_function (const std::function<double(std::vector<double> &)> function);
 
+      /**
+       * @brief set the function computed for several walkers at
+       * once
+       *
+       * if set, the parallel stretch-move sampler computes the
+       * function at the proposals of half of the walkers with a
+       * single call, so that the function can be vectorized across
+       * the walkers, or parallelized internally
+       *
+       * @param function_batch the function to be sampled: it takes
+       * the parameters of the walkers and returns the values of the
+       * function for each walker
+       *
+       * @return none
+       */
+      void set_function_batch (const std::function<std::vector<double>(std::vector<std::vector<double>> &)> function_batch);
+
       /**
        *  @brief sample the input function using the stretch-move
        *  algorithm on n-dimensional parameter space
@@ -333,6 +361,11 @@ namespace cbl {
        *  algorithm on n-dimensional parameter space - parallel
        *  version
        *
+       *  each walker extracts its random numbers from a
+       *  counter-based stream, derived from the seed, the walker
+       *  index and the step, so that the chains do not depend on
+       *  the number of threads
+       *
        *  @param chain_size number of step in each chain 
        *  @param nwalkers number of parallel walkers  
        *
@@ -348,6 +381,34 @@ namespace cbl {
        */
       void sample_stretch_move_parallel (const int chain_size, const int nwalkers, const std::vector<std::vector<double>> start, const int seed=4241, const double aa=2);
 
+      /**
+       *  @brief sample the input function using the stretch-move
+       *  algorithm on n-dimensional parameter space - parallel
+       *  version, writing the chains on a file while sampling
+       *
+       *  the steps are written on the file in blocks, and only the
+       *  last two steps are kept in memory. If the file already
+       *  contains some steps, the sampling is resumed from the last
+       *  one, and the input starting positions are ignored: since
+       *  the random numbers depend only on the seed, the walker and
+       *  the step, a resumed run is identical to an uninterrupted
+       *  one, with the same seed; an error is raised if the seed
+       *  is different from the one stored in the file
+       *
+       *  @param chain_file the file where the chains are written
+       *  @param chain_size the total number of steps in each chain,
+       *  including the ones already in the file
+       *  @param start vector containing the starting position for the
+       *  parameters
+       *  @param seed the seed for random number generator
+       *  @param aa the stretch-move distribution parameter
+       *
+       *  @return none
+       *
+       *  @warning pointers cannot be used inside the input function
+       */
+      void sample_stretch_move_parallel (const std::shared_ptr<ChainFile> chain_file, const int chain_size, const std::vector<std::vector<double>> start, const int seed=4241, const double aa=2);
+
       /**
        *  @brief write the chains in an output file
        *  
@@ -39,7 +39,8 @@
 
 
 #include "Measure.h"
-#include "ChainMesh_Catalogue.h"
+#include "KDTree_Catalogue.h"
+#include "CatalogueView.h"
 #include "Triplet1D.h"
 #include "Triplet2D.h"
 
@@ -153,6 +154,9 @@ namespace cbl {
 
 	/// output data catalogue
 	std::shared_ptr<catalogue::Catalogue> m_random;
+
+	/// the spatial index used to search for close objects when counting the triplets
+	chainmesh::SpatialIndex m_spatialIndex = chainmesh::SpatialIndex::_chainMesh_;
     
 	///@}
 
@@ -219,6 +223,53 @@ namespace cbl {
 	 */
 	void count_triplets (const std::shared_ptr<catalogue::Catalogue> cat1, const chainmesh::ChainMesh_Catalogue &ChainMesh_rMAX1, const chainmesh::ChainMesh_Catalogue &ChainMesh_rMAX2, std::shared_ptr<triplets::Triplet> tt, const bool tcount=false);
 
+	/**
+	 * @brief method to count the number of triplets, using kd-trees
+	 *
+	 * @param cat1 object of class \e Catalogue: the input catalogue
+	 * to analyse
+	 *
+	 * @param tree_rMAX1 object of class \e KDTree_Catalogue: the
+	 * kd-tree used to count the pairs relative to the first side of
+	 * the triangle (1-2)
+	 *
+	 * @param tree_rMAX2 object of class \e KDTree_Catalogue: the
+	 * kd-tree used to count the pairs relative to the second side
+	 * of the triangle (1-3)
+	 *
+	 * @param tt pointer to an object of class \e Triplet
+	 *
+	 * @param tcount 1 &rarr; activate the CPU time counter; 0 &rarr; no time counter
+	 * @return none
+	 */
+	void count_triplets (const std::shared_ptr<catalogue::Catalogue> cat1, const chainmesh::KDTree_Catalogue &tree_rMAX1, const chainmesh::KDTree_Catalogue &tree_rMAX2, std::shared_ptr<triplets::Triplet> tt, const bool tcount=false);
+
+	/**
+	 * @brief method to count the number of triplets, given the
+	 * functions used to search for close objects
+	 *
+	 * @param cat1 object of class \e Catalogue: the input catalogue
+	 * to analyse
+	 *
+	 * @param cat2 object of class \e Catalogue: the catalogue of
+	 * the second vertices of the triangles
+	 *
+	 * @param cat3 object of class \e Catalogue: the catalogue of
+	 * the third vertices of the triangles
+	 *
+	 * @param close_objects12 function that returns the indices of
+	 * the objects of cat2 close to a given position
+	 *
+	 * @param close_objects13 function that returns the indices of
+	 * the objects of cat3 close to a given position
+	 *
+	 * @param tt pointer to an object of class \e Triplet
+	 *
+	 * @param tcount 1 &rarr; activate the CPU time counter; 0 &rarr; no time counter
+	 * @return none
+	 */
+	void count_triplets (const std::shared_ptr<catalogue::Catalogue> cat1, const std::shared_ptr<catalogue::Catalogue> cat2, const std::shared_ptr<catalogue::Catalogue> cat3, std::function<std::vector<long>(const std::vector<double>)> close_objects12, std::function<std::vector<long>(const std::vector<double>)> close_objects13, std::shared_ptr<triplets::Triplet> tt, const bool tcount=false);
+
 	/**
 	 *  @brief count the data-data-data, random-random-random,
 	 *  data-data-random and data-random-random triplets, used to
@@ -364,10 +415,13 @@ namespace cbl {
 	 *  catalogue
 	 *  @param random of class Catalogue containing the random data
 	 *  catalogue
+	 *  @param spatialIndex the spatial index used to search for
+	 *  close objects: SpatialIndex::_chainMesh_ (default) or
+	 *  SpatialIndex::_kdTree_ (see set_spatialIndex)
 	 *  @return object of class ThreePointCorrelation
 	 */
-	ThreePointCorrelation (const catalogue::Catalogue data, const catalogue::Catalogue random) 
-	  : m_data(std::make_shared<catalogue::Catalogue>(catalogue::Catalogue(std::move(data)))), m_random(std::make_shared<catalogue::Catalogue>(catalogue::Catalogue(std::move(random)))) {}
+	ThreePointCorrelation (const catalogue::Catalogue &data, const catalogue::Catalogue &random, const chainmesh::SpatialIndex spatialIndex=chainmesh::SpatialIndex::_chainMesh_) 
+	  : m_data(std::make_shared<catalogue::Catalogue>(data)), m_random(std::make_shared<catalogue::Catalogue>(random)), m_spatialIndex(spatialIndex) {}
 
 	/**
 	 * @brief default destructor
@@ -396,7 +450,7 @@ namespace cbl {
 	 *  @return a pointer to an object of class
 	 *  ThreePointCorrelation of a given type
 	 */
-	static std::shared_ptr<ThreePointCorrelation> Create (const ThreePType type, const catalogue::Catalogue data, const catalogue::Catalogue random, const triplets::TripletType tripletType, const double side_s, const double side_u, const double perc_increase, const int nbins);
+	static std::shared_ptr<ThreePointCorrelation> Create (const ThreePType type, const catalogue::Catalogue &data, const catalogue::Catalogue &random, const triplets::TripletType tripletType, const double side_s, const double side_u, const double perc_increase, const int nbins);
       
 	/**
 	 *  @brief static factory used to construct three-point correlation
@@ -420,7 +474,7 @@ namespace cbl {
 	 *  @return a pointer to an object of class
 	 *  ThreePointCorrelation of a given type
 	 */
-	static std::shared_ptr<ThreePointCorrelation> Create (const ThreePType type, const catalogue::Catalogue data, const catalogue::Catalogue random, const triplets::TripletType tripletType, const double r12, const double r12_binSize, const double r13, const double r13_binSize, const int nbins);
+	static std::shared_ptr<ThreePointCorrelation> Create (const ThreePType type, const catalogue::Catalogue &data, const catalogue::Catalogue &random, const triplets::TripletType tripletType, const double r12, const double r12_binSize, const double r13, const double r13_binSize, const int nbins);
       
 	///@}
       
@@ -448,6 +502,13 @@ namespace cbl {
 	 */
 	std::shared_ptr<catalogue::Catalogue> random () const { return m_random; }
 
+	/**
+	 *  @brief get the protected member m_spatialIndex
+	 *  @return the spatial index used to search for close objects
+	 *  when counting the triplets
+	 */
+	chainmesh::SpatialIndex spatialIndex () const { return m_spatialIndex; }
+
 	/**
 	 *  @brief get the protected member m_ddd
 	 *  @return the number of data-data-data triplets
@@ -517,14 +578,23 @@ namespace cbl {
 	 *  @param data object of class Catalogue 
 	 *  @return none
 	 */
-	void set_data (const catalogue::Catalogue data) { m_data = std::make_shared<catalogue::Catalogue>(catalogue::Catalogue(std::move(data))); }
+	void set_data (const catalogue::Catalogue &data) { m_data = std::make_shared<catalogue::Catalogue>(data); }
 
 	/**
 	 *  @brief add a random catalogue
 	 *  @param random object of class Catalogue 
 	 *  @return none
 	 */
-	void set_random (const catalogue::Catalogue random) { m_random = std::make_shared<catalogue::Catalogue>(catalogue::Catalogue(std::move(random))); }
+	void set_random (const catalogue::Catalogue &random) { m_random = std::make_shared<catalogue::Catalogue>(random); }
+
+	/**
+	 *  @brief set the spatial index used to search for close
+	 *  objects when counting the triplets
+	 *  @param spatialIndex the spatial index: SpatialIndex::_chainMesh_
+	 *  (default) or SpatialIndex::_kdTree_
+	 *  @return none
+	 */
+	void set_spatialIndex (const chainmesh::SpatialIndex spatialIndex) { m_spatialIndex = spatialIndex; }
 
 	///@}
 
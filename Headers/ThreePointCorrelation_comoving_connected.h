@@ -109,11 +109,14 @@ namespace cbl {
 	 *  @param perc_increase the ratio
 	 *  &Delta;r<SUB>12</SUB>/r<SUB>12</SUB>=&Delta;r<SUB>13</SUB>/r<SUB>13</SUB>
 	 *  @param nbins number of bins
+	 *  @param spatialIndex the spatial index used to search for
+	 *  close objects: SpatialIndex::_chainMesh_ (default) or
+	 *  SpatialIndex::_kdTree_ (see set_spatialIndex)
 	 *  @return object of class
 	 *  ThreePointCorrelation_comoving_connected
 	 */
-	ThreePointCorrelation_comoving_connected (const catalogue::Catalogue data, const catalogue::Catalogue random, const triplets::TripletType tripletType, const double side_s, const double side_u, const double perc_increase, const int nbins)
-	  : ThreePointCorrelation(data, random) { set_parameters(tripletType, side_s, side_u, perc_increase, nbins); }
+	ThreePointCorrelation_comoving_connected (const catalogue::Catalogue &data, const catalogue::Catalogue &random, const triplets::TripletType tripletType, const double side_s, const double side_u, const double perc_increase, const int nbins, const chainmesh::SpatialIndex spatialIndex=chainmesh::SpatialIndex::_chainMesh_)
+	  : ThreePointCorrelation(data, random, spatialIndex) { set_parameters(tripletType, side_s, side_u, perc_increase, nbins); }
 
 	/**
 	 *  @brief constructor
@@ -128,11 +131,14 @@ namespace cbl {
 	 *  @param r13 the size of r<SUB>13</SUB>
 	 *  @param r13_binSize the size of r<SUB>13</SUB> bin
 	 *  @param nbins number of bins
+	 *  @param spatialIndex the spatial index used to search for
+	 *  close objects: SpatialIndex::_chainMesh_ (default) or
+	 *  SpatialIndex::_kdTree_ (see set_spatialIndex)
 	 *  @return object of class
 	 *  ThreePointCorrelation_comoving_connected
 	 */
-	ThreePointCorrelation_comoving_connected (const catalogue::Catalogue data, const catalogue::Catalogue random, const triplets::TripletType tripletType, const double r12, const double r12_binSize, const double r13, const double r13_binSize, const int nbins)
-	  : ThreePointCorrelation(data, random) { set_parameters(tripletType, r12, r12_binSize, r13, r13_binSize, nbins); }
+	ThreePointCorrelation_comoving_connected (const catalogue::Catalogue &data, const catalogue::Catalogue &random, const triplets::TripletType tripletType, const double r12, const double r12_binSize, const double r13, const double r13_binSize, const int nbins, const chainmesh::SpatialIndex spatialIndex=chainmesh::SpatialIndex::_chainMesh_)
+	  : ThreePointCorrelation(data, random, spatialIndex) { set_parameters(tripletType, r12, r12_binSize, r13, r13_binSize, nbins); }
 
 	/**
 	 *  @brief default destructor
@@ -36,7 +36,9 @@
 
 
 #include "Measure.h"
-#include "ChainMesh_Catalogue.h"
+#include "KDTree_Catalogue.h"
+#include "CatalogueView.h"
+#include "MPIwrapper.h"
 #include "Pair1D_extra.h"
 #include "Pair2D_extra.h"
 
@@ -273,6 +275,33 @@ namespace cbl {
 
 	/// fraction between the number of random objects in the diluted and original samples, used to improve performances in random-random pair counts
 	double m_random_dilution_fraction;
+
+	/// the spatial index used to search for close objects when counting the pairs
+	chainmesh::SpatialIndex m_spatialIndex = chainmesh::SpatialIndex::_chainMesh_;
+
+	/// the cell size of the chain-mesh; if it is not set, it is tuned automatically
+	double m_cell_size = par::defaultDouble;
+
+	/// true &rarr; tune the cell size of the chain-mesh with a timing trial, in addition to the cost model
+	bool m_cell_size_trial = false;
+
+	/// the separation above which the pairs are counted on a grid with Fast Fourier Transforms; if it is not positive, all the pairs are counted exactly
+	double m_grid_transition = 0.;
+
+	/// the cell size of the grid used to count the pairs with Fast Fourier Transforms
+	double m_grid_cell_size = 0.;
+
+	/// the mass assignment scheme of the grid used to count the pairs with Fast Fourier Transforms
+	int m_grid_assignment_type = 1;
+
+	/// the side of the periodic box containing the data catalogue; if it is not positive, the catalogue is not periodic
+	double m_periodic_box = 0.;
+
+	/// the minimum coordinates of the periodic box
+	std::vector<double> m_periodic_box_min = {0., 0., 0.};
+
+	/// true &rarr; each MPI task holds a different part of the data and random catalogues; false &rarr; the catalogues are read by all the tasks
+	bool m_distributed_catalogues = false;
       
 	///@}
 
@@ -349,6 +378,189 @@ namespace cbl {
 	 */
 	void count_pairs (const std::shared_ptr<catalogue::Catalogue> cat1, const chainmesh::ChainMesh_Catalogue &ChM, std::shared_ptr<pairs::Pair> pp, const bool cross=true, const bool tcount=false);
 
+	/**
+	 *  @brief count the number of pairs, using a kd-tree
+	 *
+	 *  @param cat1 pointer to an object of class Catalogue,
+	 *  containing the first catalogue
+	 *
+	 *  @param tree object of class KDTree_Catalogue, used to
+	 *  construct the kd-tree of the second catalogue
+	 *
+	 *  @param pp pointer to an object of class Pair
+	 *
+	 *  @param cross true &rarr; count the number of cross pairs
+	 *  (e.g. data-random pairs); false &rarr; count the number of
+	 *  pairs of objects of the same type (e.g. data-data and
+	 *  random-random pairs)
+	 *
+	 *  @param tcount true &rarr; activate the time counter; false
+	 *  &rarr; no time counter
+	 * 
+	 *  @return none
+	 */
+	void count_pairs (const std::shared_ptr<catalogue::Catalogue> cat1, const chainmesh::KDTree_Catalogue &tree, std::shared_ptr<pairs::Pair> pp, const bool cross=true, const bool tcount=false);
+
+	/**
+	 *  @brief count the number of pairs between the cells of two
+	 *  sets of objects
+	 *
+	 *  @param objects1 the objects of the first catalogue, ordered
+	 *  by cell
+	 *
+	 *  @param objects2 the objects of the second catalogue, ordered
+	 *  by cell
+	 *
+	 *  @param close_cells function that returns the (sorted) cells
+	 *  of objects2 close to the i-th non-empty cell of objects1
+	 *
+	 *  @param pp pointer to an object of class Pair
+	 *
+	 *  @param cross true &rarr; count the number of cross pairs
+	 *  (e.g. data-random pairs); false &rarr; count the number of
+	 *  pairs of objects of the same type (e.g. data-data and
+	 *  random-random pairs); in the latter case, objects1 and
+	 *  objects2 have to be the same objects
+	 *
+	 *  @param tcount true &rarr; activate the time counter; false
+	 *  &rarr; no time counter
+	 * 
+	 *  @param verbose true &rarr; show the time spent to count
+	 *  the pairs
+	 * 
+	 *  @return none
+	 */
+	void count_pairs_cells (const chainmesh::CellObjects &objects1, const chainmesh::CellObjects &objects2, std::function<std::vector<long>(const long)> close_cells, std::shared_ptr<pairs::Pair> pp, const bool cross=true, const bool tcount=false, const bool verbose=true);
+
+	/**
+	 *  @brief get the cell size of the chain-mesh used to count
+	 *  the pairs of a catalogue
+	 *
+	 *  if the cell size has not been set with set_cell_size(), it
+	 *  is chosen among a set of candidates (from 0.05 to 0.5 times
+	 *  the maximum separation, enlarged as done by the chain-mesh
+	 *  if the cells are too many) with the lowest cost estimated by
+	 *  cbl::chainmesh::chainMesh_cost(); if required, the fastest
+	 *  of the best candidates is then selected by timing the count
+	 *  of the pairs. Both the cost and the timing are estimated on
+	 *  the objects of a cubic sub-volume of the catalogue, that
+	 *  contains at least 10<SUP>5</SUP> objects and is larger than
+	 *  4 times the maximum separation, so that the object density
+	 *  is preserved; if the catalogue is empty, the cell size is
+	 *  0.1 times the maximum separation
+	 *
+	 *  @param cat pointer to an object of class Catalogue
+	 *
+	 *  @param rMAX the maximum separation
+	 *
+	 *  @param pp pointer to an object of class Pair, used to set
+	 *  the binning of the timing trial
+	 *
+	 *  @return the cell size of the chain-mesh
+	 */
+	double chainMesh_cell_size (const std::shared_ptr<catalogue::Catalogue> cat, const double rMAX, const std::shared_ptr<pairs::Pair> pp);
+
+	/**
+	 *  @brief count the number of pairs on a grid, with Fast
+	 *  Fourier Transforms
+	 *
+	 *  the objects are assigned to a grid, and the pairs are
+	 *  obtained from the cross-correlation of the grids, computed
+	 *  with Fast Fourier Transforms; the cost does not depend on
+	 *  the number of objects and on the maximum separation, so this
+	 *  method is convenient on large scales, where the pair counts
+	 *  are not affected by the grid resolution
+	 *
+	 *  the cosine of the angle between the separation and the line
+	 *  of sight is computed with respect to the line of sight of
+	 *  the object of the first catalogue, so the multipoles of the
+	 *  pairs are obtained with the Fast Fourier Transforms of the
+	 *  first grid multiplied by the products of the components of
+	 *  the line of sight, up to the hexadecapole
+	 *
+	 *  only the bins above rMin are set, overwriting their
+	 *  content; only the 1D comoving pairs (also for multipoles)
+	 *  are supported, since the 2D pairs reconstructed from the
+	 *  multipoles up to l=4 would be biased
+	 *
+	 *  @param cat1 pointer to an object of class Catalogue,
+	 *  containing the first catalogue
+	 *
+	 *  @param cat2 pointer to an object of class Catalogue,
+	 *  containing the second catalogue
+	 *
+	 *  @param pp pointer to an object of class Pair
+	 *
+	 *  @param cross true &rarr; count the number of cross pairs
+	 *  (e.g. data-random pairs); false &rarr; count the number of
+	 *  pairs of objects of the same type (e.g. data-data and
+	 *  random-random pairs); in the latter case, cat1 and cat2
+	 *  have to be the same catalogue
+	 *
+	 *  @param rMin the minimum separation: only the bins whose
+	 *  lower limit is not smaller than rMin are set
+	 *
+	 *  @return none
+	 */
+	void count_pairs_grid (const std::shared_ptr<catalogue::Catalogue> cat1, const std::shared_ptr<catalogue::Catalogue> cat2, std::shared_ptr<pairs::Pair> pp, const bool cross, const double rMin) const;
+
+	/**
+	 *  @brief get the periodic images of the data objects close
+	 *  to the faces of the periodic box
+	 *
+	 *  an object closer than rMAX to a face is replicated on the
+	 *  opposite side of the box, shifting its coordinates by the
+	 *  box side (along one, two or three axes, close to the faces,
+	 *  edges and corners of the box); if rMAX is smaller than half
+	 *  the box side, the separations between the data objects and
+	 *  the images are the minimum-image separations of the pairs
+	 *  across the box faces
+	 *
+	 *  @param rMAX the maximum separation
+	 *
+	 *  @return pointer to an object of class Catalogue, containing
+	 *  the images
+	 */
+	std::shared_ptr<catalogue::Catalogue> periodic_images (const double rMAX) const;
+
+	/**
+	 *  @brief count the number of pairs between the data objects
+	 *  and their periodic images
+	 *
+	 *  the pairs are added to the input ones with weight 1/2,
+	 *  since each pair across the box faces is counted twice, with
+	 *  the image of each of the two objects
+	 *
+	 *  @param rMAX the maximum separation
+	 *
+	 *  @param pp pointer to an object of class Pair
+	 *
+	 *  @param tcount true &rarr; activate the CPU time counter;
+	 *  false &rarr; no time counter
+	 *
+	 *  @return none
+	 */
+	void count_pairs_periodic (const double rMAX, std::shared_ptr<pairs::Pair> pp, const bool tcount);
+
+	/**
+	 *  @brief set the number of pairs of a uniform distribution in
+	 *  the periodic box
+	 *
+	 *  the number of pairs in each bin is the total number of
+	 *  pairs times the ratio between the volume of the bin and the
+	 *  volume of the box; only 1D comoving separations, in linear
+	 *  or logarithmic bins, are supported
+	 *
+	 *  @param pp pointer to an object of class Pair
+	 *
+	 *  @param nPairs the total number of pairs
+	 *
+	 *  @param nPairs_weighted the total number of weighted pairs
+	 *
+	 *  @return none
+	 */
+	void set_pairs_periodic (std::shared_ptr<pairs::Pair> pp, const double nPairs, const double nPairs_weighted) const;
+
 	/**
 	 *  @brief count the number of pairs, used for
 	 *  Jackknife/Bootstrap methods
@@ -375,6 +587,146 @@ namespace cbl {
 	 *  @return none
 	 */
 	void count_pairs_region (const std::shared_ptr<catalogue::Catalogue> cat1, const chainmesh::ChainMesh_Catalogue &ChM, std::shared_ptr<pairs::Pair> pp, std::vector< std::shared_ptr<pairs::Pair> > pp_regions, const bool cross=true, const bool tcount=false);
+
+	/**
+	 *  @brief count the number of pairs, used for
+	 *  Jackknife/Bootstrap methods, using a kd-tree
+	 *
+	 *  @param cat1 pointer to an object of class Catalogue,
+	 *  containing the first catalogue
+	 *
+	 *  @param tree object of class KDTree_Catalogue, used to
+	 *  construct the kd-tree of the second catalogue
+	 *
+	 *  @param pp pointer to an object of class Pair
+	 *
+	 *  @param pp_regions vector containing pointers to object of
+	 *  class Pair
+	 *
+	 *  @param cross true &rarr; count the number of cross pairs
+	 *  (e.g. data-random pairs); false &rarr; count the number of
+	 *  pairs of objects of the same type (e.g. data-data and
+	 *  random-random pairs)
+	 *
+	 *  @param tcount true &rarr; activate the time counter; false
+	 *  &rarr; no time counter
+	 * 
+	 *  @return none
+	 */
+	void count_pairs_region (const std::shared_ptr<catalogue::Catalogue> cat1, const chainmesh::KDTree_Catalogue &tree, std::shared_ptr<pairs::Pair> pp, std::vector< std::shared_ptr<pairs::Pair> > pp_regions, const bool cross=true, const bool tcount=false);
+
+	/**
+	 *  @brief count the number of pairs between the cells of two
+	 *  sets of objects, used for Jackknife/Bootstrap methods
+	 *
+	 *  @param objects1 the objects of the first catalogue, ordered
+	 *  by cell and, inside each cell, by region
+	 *
+	 *  @param objects2 the objects of the second catalogue,
+	 *  ordered by cell and, inside each cell, by region
+	 *
+	 *  @param close_cells function that returns the (sorted) cells
+	 *  of objects2 close to the i-th non-empty cell of objects1
+	 *
+	 *  @param pp pointer to an object of class Pair
+	 *
+	 *  @param pp_regions vector containing pointers to object of
+	 *  class Pair
+	 *
+	 *  @param cross true &rarr; count the number of cross pairs
+	 *  (e.g. data-random pairs); false &rarr; count the number of
+	 *  pairs of objects of the same type (e.g. data-data and
+	 *  random-random pairs); in the latter case, objects1 and
+	 *  objects2 have to be the same objects
+	 *
+	 *  @param tcount true &rarr; activate the time counter; false
+	 *  &rarr; no time counter
+	 * 
+	 *  @return none
+	 */
+	void count_pairs_region_cells (const chainmesh::CellObjects &objects1, const chainmesh::CellObjects &objects2, std::function<std::vector<long>(const long)> close_cells, std::shared_ptr<pairs::Pair> pp, std::vector< std::shared_ptr<pairs::Pair> > pp_regions, const bool cross=true, const bool tcount=false);
+
+	/**
+	 *  @brief count the number of pairs distributing the
+	 *  computation across the MPI tasks
+	 *
+	 *  the catalogues are decomposed in slabs perpendicular to the
+	 *  axis of largest extent of the first catalogue, each
+	 *  containing approximately the same number of objects of the
+	 *  first catalogue; each task receives the objects of its slab
+	 *  plus a halo of width rMAX, counts the pairs with the same
+	 *  methods used by a single task, and the binned pairs of all
+	 *  the tasks are then gathered and summed in rank order by all
+	 *  the tasks, so that the result does not depend on the MPI
+	 *  implementation of the reduction; since the pairs are summed
+	 *  exactly (see pairs::ExactSum), the result is the same as
+	 *  that obtained by a single task, bit by bit; if the
+	 *  catalogues are
+	 *  distributed (see
+	 *  TwoPointCorrelation::set_distributed_catalogues), each task
+	 *  sends all its objects, otherwise each task sends a
+	 *  contiguous block of the catalogues, read by all the tasks
+	 *
+	 *  @param cat1 pointer to an object of class Catalogue,
+	 *  containing the first catalogue
+	 *
+	 *  @param cat2 pointer to an object of class Catalogue,
+	 *  containing the second catalogue; for the auto pairs, cat2
+	 *  is not used
+	 *
+	 *  @param rMAX the maximum separation
+	 *
+	 *  @param pp pointer to an object of class Pair
+	 *
+	 *  @param pp_regions vector containing pointers to object of
+	 *  class Pair, used for Jackknife/Bootstrap methods; if empty,
+	 *  the pairs are not counted by region
+	 *
+	 *  @param cross true &rarr; count the number of cross pairs
+	 *  (e.g. data-random pairs); false &rarr; count the number of
+	 *  pairs of objects of the same type (e.g. data-data and
+	 *  random-random pairs)
+	 *
+	 *  @param tcount true &rarr; activate the time counter; false
+	 *  &rarr; no time counter
+	 * 
+	 *  @return none
+	 */
+	void count_pairs_distributed (const std::shared_ptr<catalogue::Catalogue> cat1, const std::shared_ptr<catalogue::Catalogue> cat2, const double rMAX, std::shared_ptr<pairs::Pair> pp, std::vector<std::shared_ptr<pairs::Pair>> pp_regions={}, const bool cross=true, const bool tcount=false);
+
+	/**
+	 *  @brief get the number of objects of a catalogue, summed
+	 *  over the MPI tasks if the catalogues are distributed
+	 *  @param catalogue pointer to an object of class Catalogue
+	 *  @return the total number of objects
+	 */
+	size_t m_nObjects (const std::shared_ptr<catalogue::Catalogue> catalogue) const;
+
+	/**
+	 *  @brief get the weighted number of objects of a catalogue,
+	 *  summed over the MPI tasks if the catalogues are distributed
+	 *  @param catalogue pointer to an object of class Catalogue
+	 *  @return the total weighted number of objects
+	 */
+	double m_weightedN (const std::shared_ptr<catalogue::Catalogue> catalogue) const;
+
+	/**
+	 *  @brief get the number of random objects used by the
+	 *  estimators: in a periodic box, the random pairs are
+	 *  computed analytically and normalised with the number of
+	 *  data objects
+	 *  @return the total number of random objects
+	 */
+	size_t m_nRandom () const { return m_nObjects((m_periodic_box>0.) ? m_data : m_random); }
+
+	/**
+	 *  @brief get the weighted number of random objects used by
+	 *  the estimators: in a periodic box, the random pairs are
+	 *  computed analytically and normalised with the weighted
+	 *  number of data objects
+	 *  @return the total weighted number of random objects
+	 */
+	double m_weightedN_random () const { return m_weightedN((m_periodic_box>0.) ? m_data : m_random); }
       
 	/**
 	 *  @brief count the number of pairs, used for
@@ -1009,8 +1361,8 @@ namespace cbl {
 	 *
 	 *  @return object of class TwoPointCorrelation
 	 */
-	TwoPointCorrelation (const catalogue::Catalogue data, const catalogue::Catalogue random, const bool compute_extra_info=false, const double random_dilution_fraction=1.) 
-	  : m_data(std::make_shared<catalogue::Catalogue>(catalogue::Catalogue(std::move(data)))), m_random(std::make_shared<catalogue::Catalogue>(catalogue::Catalogue(std::move(random)))), m_compute_extra_info(compute_extra_info), m_random_dilution_fraction(random_dilution_fraction) {}
+	TwoPointCorrelation (const catalogue::Catalogue &data, const catalogue::Catalogue &random, const bool compute_extra_info=false, const double random_dilution_fraction=1.) 
+	  : m_data(std::make_shared<catalogue::Catalogue>(data)), m_random(std::make_shared<catalogue::Catalogue>(random)), m_compute_extra_info(compute_extra_info), m_random_dilution_fraction(random_dilution_fraction) {}
     
 	/**
 	 *  @brief default destructor
@@ -1055,10 +1407,14 @@ namespace cbl {
 	 *  of objects in the diluted and original random samples, used
 	 *  to improve performances in random-random pair counts
 	 *
+	 *  @param spatialIndex the spatial index used to search for
+	 *  close objects: SpatialIndex::_chainMesh_ (default) or
+	 *  SpatialIndex::_kdTree_ (see set_spatialIndex)
+	 *
 	 *  @return a pointer to an object of class
 	 *  TwoPointCorrelation of a given type
 	 */
-	static std::shared_ptr<TwoPointCorrelation> Create (const TwoPType type, const catalogue::Catalogue data, const catalogue::Catalogue random, const BinType binType, const double Min, const double Max, const int nbins, const double shift, const CoordinateUnits angularUnits=CoordinateUnits::_radians_, std::function<double(double)> angularWeight=nullptr, const bool compute_extra_info=false, const double random_dilution_fraction=1.);
+	static std::shared_ptr<TwoPointCorrelation> Create (const TwoPType type, const catalogue::Catalogue &data, const catalogue::Catalogue &random, const BinType binType, const double Min, const double Max, const int nbins, const double shift, const CoordinateUnits angularUnits=CoordinateUnits::_radians_, std::function<double(double)> angularWeight=nullptr, const bool compute_extra_info=false, const double random_dilution_fraction=1., const chainmesh::SpatialIndex spatialIndex=chainmesh::SpatialIndex::_chainMesh_);
 
 	/**
 	 *  @brief static factory used to construct two-point
@@ -1097,10 +1453,14 @@ namespace cbl {
 	 *  of objects in the diluted and original random samples, used
 	 *  to improve performances in random-random pair counts
 	 *
+	 *  @param spatialIndex the spatial index used to search for
+	 *  close objects: SpatialIndex::_chainMesh_ (default) or
+	 *  SpatialIndex::_kdTree_ (see set_spatialIndex)
+	 *
 	 *  @return a pointer to an object of class
 	 *  TwoPointCorrelation of a given type
 	 */
-	static std::shared_ptr<TwoPointCorrelation> Create (const TwoPType type, const catalogue::Catalogue data, const catalogue::Catalogue random, const BinType binType, const double Min, const double Max, const double binSize, const double shift, const CoordinateUnits angularUnits=CoordinateUnits::_radians_, std::function<double(double)> angularWeight=nullptr, const bool compute_extra_info=false, const double random_dilution_fraction=1.);
+	static std::shared_ptr<TwoPointCorrelation> Create (const TwoPType type, const catalogue::Catalogue &data, const catalogue::Catalogue &random, const BinType binType, const double Min, const double Max, const double binSize, const double shift, const CoordinateUnits angularUnits=CoordinateUnits::_radians_, std::function<double(double)> angularWeight=nullptr, const bool compute_extra_info=false, const double random_dilution_fraction=1., const chainmesh::SpatialIndex spatialIndex=chainmesh::SpatialIndex::_chainMesh_);
 
 	/**
 	 *  @brief static factory used to construct two-point
@@ -1154,10 +1514,14 @@ namespace cbl {
 	 *  of objects in the diluted and original random samples, used
 	 *  to improve performances in random-random pair counts
 	 *
+	 *  @param spatialIndex the spatial index used to search for
+	 *  close objects: SpatialIndex::_chainMesh_ (default) or
+	 *  SpatialIndex::_kdTree_ (see set_spatialIndex)
+	 *
 	 *  @return a pointer to an object of class
 	 *  TwoPointCorrelation of a given type
 	 */
-	static std::shared_ptr<TwoPointCorrelation> Create (const TwoPType type, const catalogue::Catalogue data, const catalogue::Catalogue random, const BinType binType_D1, const double Min_D1, const double Max_D1, const int nbins_D1, const double shift_D1, const BinType binType_D2, const double Min_D2, const double Max_D2, const int nbins_D2, const double shift_D2, const CoordinateUnits angularUnits=CoordinateUnits::_radians_, std::function<double(double)> angularWeight=nullptr, const bool compute_extra_info=false, const double random_dilution_fraction=1.);
+	static std::shared_ptr<TwoPointCorrelation> Create (const TwoPType type, const catalogue::Catalogue &data, const catalogue::Catalogue &random, const BinType binType_D1, const double Min_D1, const double Max_D1, const int nbins_D1, const double shift_D1, const BinType binType_D2, const double Min_D2, const double Max_D2, const int nbins_D2, const double shift_D2, const CoordinateUnits angularUnits=CoordinateUnits::_radians_, std::function<double(double)> angularWeight=nullptr, const bool compute_extra_info=false, const double random_dilution_fraction=1., const chainmesh::SpatialIndex spatialIndex=chainmesh::SpatialIndex::_chainMesh_);
 
 	/**
 	 *  @brief static factory used to construct two-point
@@ -1211,10 +1575,14 @@ namespace cbl {
 	 *  of objects in the diluted and original random samples, used
 	 *  to improve performances in random-random pair counts
 	 *
+	 *  @param spatialIndex the spatial index used to search for
+	 *  close objects: SpatialIndex::_chainMesh_ (default) or
+	 *  SpatialIndex::_kdTree_ (see set_spatialIndex)
+	 *
 	 *  @return a pointer to an object of class
 	 *  TwoPointCorrelation of a given type
 	 */
-	static std::shared_ptr<TwoPointCorrelation> Create (const TwoPType type, const catalogue::Catalogue data, const catalogue::Catalogue random, const BinType binType_D1, const double Min_D1, const double Max_D1, const double binSize_D1, const double shift_D1, const BinType binType_D2, const double Min_D2, const double Max_D2, const double binSize_D2, const double shift_D2, const CoordinateUnits angularUnits=CoordinateUnits::_radians_, std::function<double(double)> angularWeight=nullptr, const bool compute_extra_info=false, const double random_dilution_fraction=1.);
+	static std::shared_ptr<TwoPointCorrelation> Create (const TwoPType type, const catalogue::Catalogue &data, const catalogue::Catalogue &random, const BinType binType_D1, const double Min_D1, const double Max_D1, const double binSize_D1, const double shift_D1, const BinType binType_D2, const double Min_D2, const double Max_D2, const double binSize_D2, const double shift_D2, const CoordinateUnits angularUnits=CoordinateUnits::_radians_, std::function<double(double)> angularWeight=nullptr, const bool compute_extra_info=false, const double random_dilution_fraction=1., const chainmesh::SpatialIndex spatialIndex=chainmesh::SpatialIndex::_chainMesh_);
       
 	/**
 	 *  @brief static factory used to construct two-point
@@ -1265,10 +1633,14 @@ namespace cbl {
 	 *  of objects in the diluted and original random samples, used
 	 *  to improve performances in random-random pair counts
 	 *
+	 *  @param spatialIndex the spatial index used to search for
+	 *  close objects: SpatialIndex::_chainMesh_ (default) or
+	 *  SpatialIndex::_kdTree_ (see set_spatialIndex)
+	 *
 	 *  @return a pointer to an object of class
 	 *  TwoPointCorrelation of a given type
 	 */
-	static std::shared_ptr<TwoPointCorrelation> Create (const TwoPType type, const catalogue::Catalogue data, const catalogue::Catalogue random, const BinType binType_D1, const double Min_D1, const double Max_D1, const int nbins_D1, const double shift_D1, const double Min_D2, const double Max_D2, const int nbins_D2, const double shift_D2, const CoordinateUnits angularUnits=CoordinateUnits::_radians_, std::function<double(double)> angularWeight=nullptr, const bool compute_extra_info=false, const double random_dilution_fraction=1.);
+	static std::shared_ptr<TwoPointCorrelation> Create (const TwoPType type, const catalogue::Catalogue &data, const catalogue::Catalogue &random, const BinType binType_D1, const double Min_D1, const double Max_D1, const int nbins_D1, const double shift_D1, const double Min_D2, const double Max_D2, const int nbins_D2, const double shift_D2, const CoordinateUnits angularUnits=CoordinateUnits::_radians_, std::function<double(double)> angularWeight=nullptr, const bool compute_extra_info=false, const double random_dilution_fraction=1., const chainmesh::SpatialIndex spatialIndex=chainmesh::SpatialIndex::_chainMesh_);
 
 	/**
 	 *  @brief static factory used to construct two-point
@@ -1319,10 +1691,14 @@ namespace cbl {
 	 *  of objects in the diluted and original random samples, used
 	 *  to improve performances in random-random pair counts
 	 *
+	 *  @param spatialIndex the spatial index used to search for
+	 *  close objects: SpatialIndex::_chainMesh_ (default) or
+	 *  SpatialIndex::_kdTree_ (see set_spatialIndex)
+	 *
 	 *  @return a pointer to an object of class
 	 *  TwoPointCorrelation of a given type
 	 */
-	static std::shared_ptr<TwoPointCorrelation> Create (const TwoPType type, const catalogue::Catalogue data, const catalogue::Catalogue random, const BinType binType_D1, const double Min_D1, const double Max_D1, const double binSize_D1, const double shift_D1, const double Min_D2, const double Max_D2, const double binSize_D2, const double shift_D2, const CoordinateUnits angularUnits=CoordinateUnits::_radians_, std::function<double(double)> angularWeight=nullptr, const bool compute_extra_info=false, const double random_dilution_fraction=1.);
+	static std::shared_ptr<TwoPointCorrelation> Create (const TwoPType type, const catalogue::Catalogue &data, const catalogue::Catalogue &random, const BinType binType_D1, const double Min_D1, const double Max_D1, const double binSize_D1, const double shift_D1, const double Min_D2, const double Max_D2, const double binSize_D2, const double shift_D2, const CoordinateUnits angularUnits=CoordinateUnits::_radians_, std::function<double(double)> angularWeight=nullptr, const bool compute_extra_info=false, const double random_dilution_fraction=1., const chainmesh::SpatialIndex spatialIndex=chainmesh::SpatialIndex::_chainMesh_);
 
 	/**
 	 *  @brief static factory used to construct two-point
@@ -1375,10 +1751,14 @@ namespace cbl {
 	 *  of objects in the diluted and original random samples, used
 	 *  to improve performances in random-random pair counts
 	 *
+	 *  @param spatialIndex the spatial index used to search for
+	 *  close objects: SpatialIndex::_chainMesh_ (default) or
+	 *  SpatialIndex::_kdTree_ (see set_spatialIndex)
+	 *
 	 *  @return a pointer to an object of class
 	 *  TwoPointCorrelation of a given type
 	 */
-	static std::shared_ptr<TwoPointCorrelation> Create (const TwoPType type, const catalogue::Catalogue data, const catalogue::Catalogue random, const BinType binType_D1, const double Min_D1, const double Max_D1, const int nbins_D1, const double shift_D1, const double Min_D2, const double Max_D2, const int nbins_D2, const double shift_D2, const double piMax_integral, const CoordinateUnits angularUnits=CoordinateUnits::_radians_, std::function<double(double)> angularWeight=nullptr, const bool compute_extra_info=false, const double random_dilution_fraction=1.);
+	static std::shared_ptr<TwoPointCorrelation> Create (const TwoPType type, const catalogue::Catalogue &data, const catalogue::Catalogue &random, const BinType binType_D1, const double Min_D1, const double Max_D1, const int nbins_D1, const double shift_D1, const double Min_D2, const double Max_D2, const int nbins_D2, const double shift_D2, const double piMax_integral, const CoordinateUnits angularUnits=CoordinateUnits::_radians_, std::function<double(double)> angularWeight=nullptr, const bool compute_extra_info=false, const double random_dilution_fraction=1., const chainmesh::SpatialIndex spatialIndex=chainmesh::SpatialIndex::_chainMesh_);
 
 	/**
 	 *  @brief static factory used to construct two-point
@@ -1431,10 +1811,14 @@ namespace cbl {
 	 *  of objects in the diluted and original random samples, used
 	 *  to improve performances in random-random pair counts
 	 *
+	 *  @param spatialIndex the spatial index used to search for
+	 *  close objects: SpatialIndex::_chainMesh_ (default) or
+	 *  SpatialIndex::_kdTree_ (see set_spatialIndex)
+	 *
 	 *  @return a pointer to an object of class
 	 *  TwoPointCorrelation of a given type
 	 */
-	static std::shared_ptr<TwoPointCorrelation> Create (const TwoPType type, const catalogue::Catalogue data, const catalogue::Catalogue random, const BinType binType_D1, const double Min_D1, const double Max_D1, const double binSize_D1, const double shift_D1, const double Min_D2, const double Max_D2, const double binSize_D2, const double shift_D2, const double piMax_integral, const CoordinateUnits angularUnits=CoordinateUnits::_radians_, std::function<double(double)> angularWeight=nullptr, const bool compute_extra_info=false, const double random_dilution_fraction=1.);
+	static std::shared_ptr<TwoPointCorrelation> Create (const TwoPType type, const catalogue::Catalogue &data, const catalogue::Catalogue &random, const BinType binType_D1, const double Min_D1, const double Max_D1, const double binSize_D1, const double shift_D1, const double Min_D2, const double Max_D2, const double binSize_D2, const double shift_D2, const double piMax_integral, const CoordinateUnits angularUnits=CoordinateUnits::_radians_, std::function<double(double)> angularWeight=nullptr, const bool compute_extra_info=false, const double random_dilution_fraction=1., const chainmesh::SpatialIndex spatialIndex=chainmesh::SpatialIndex::_chainMesh_);
 
 	/**
 	 *  @brief static factory used to construct two-point
@@ -1483,10 +1867,14 @@ namespace cbl {
 	 *  of objects in the diluted and original random samples, used
 	 *  to improve performances in random-random pair counts
 	 *
+	 *  @param spatialIndex the spatial index used to search for
+	 *  close objects: SpatialIndex::_chainMesh_ (default) or
+	 *  SpatialIndex::_kdTree_ (see set_spatialIndex)
+	 *
 	 *  @return a pointer to an object of class
 	 *  TwoPointCorrelation of a given type
 	 */
-	static std::shared_ptr<TwoPointCorrelation> Create (const TwoPType type, const catalogue::Catalogue data, const catalogue::Catalogue random, const BinType binType_D1, const double Min_D1, const double Max_D1, const int nbins_D1, const double shift_D1, const int nWedges, const int nbins_D2, const double shift_D2, const CoordinateUnits angularUnits=CoordinateUnits::_radians_, std::function<double(double)> angularWeight=nullptr, const bool compute_extra_info=false, const double random_dilution_fraction=1.);
+	static std::shared_ptr<TwoPointCorrelation> Create (const TwoPType type, const catalogue::Catalogue &data, const catalogue::Catalogue &random, const BinType binType_D1, const double Min_D1, const double Max_D1, const int nbins_D1, const double shift_D1, const int nWedges, const int nbins_D2, const double shift_D2, const CoordinateUnits angularUnits=CoordinateUnits::_radians_, std::function<double(double)> angularWeight=nullptr, const bool compute_extra_info=false, const double random_dilution_fraction=1., const chainmesh::SpatialIndex spatialIndex=chainmesh::SpatialIndex::_chainMesh_);
 
 	/**
 	 *  @brief static factory used to construct two-point
@@ -1535,10 +1923,14 @@ namespace cbl {
 	 *  of objects in the diluted and original random samples, used
 	 *  to improve performances in random-random pair counts
 	 *
+	 *  @param spatialIndex the spatial index used to search for
+	 *  close objects: SpatialIndex::_chainMesh_ (default) or
+	 *  SpatialIndex::_kdTree_ (see set_spatialIndex)
+	 *
 	 *  @return a pointer to an object of class
 	 *  TwoPointCorrelation of a given type
 	 */
-	static std::shared_ptr<TwoPointCorrelation> Create (const TwoPType type, const catalogue::Catalogue data, const catalogue::Catalogue random, const BinType binType_D1, const double Min_D1, const double Max_D1, const double binSize_D1, const double shift_D1, const int nWedges, const double binSize_D2, const double shift_D2, const CoordinateUnits angularUnits=CoordinateUnits::_radians_, std::function<double(double)> angularWeight=nullptr, const bool compute_extra_info=false, const double random_dilution_fraction=1.);
+	static std::shared_ptr<TwoPointCorrelation> Create (const TwoPType type, const catalogue::Catalogue &data, const catalogue::Catalogue &random, const BinType binType_D1, const double Min_D1, const double Max_D1, const double binSize_D1, const double shift_D1, const int nWedges, const double binSize_D2, const double shift_D2, const CoordinateUnits angularUnits=CoordinateUnits::_radians_, std::function<double(double)> angularWeight=nullptr, const bool compute_extra_info=false, const double random_dilution_fraction=1., const chainmesh::SpatialIndex spatialIndex=chainmesh::SpatialIndex::_chainMesh_);
 
 	///@}
 
@@ -1598,6 +1990,29 @@ namespace cbl {
 	 *  performances in random-random pair counts
 	 */
 	bool random_dilution_fraction () const { return m_random_dilution_fraction; }
+
+	/**
+	 *  @brief get the protected member m_spatialIndex
+	 *  @return the spatial index used to search for close objects
+	 *  when counting the pairs
+	 */
+	chainmesh::SpatialIndex spatialIndex () const { return m_spatialIndex; }
+
+	/**
+	 *  @brief get the protected member m_distributed_catalogues
+	 *  @return true &rarr; each MPI task holds a different part of
+	 *  the catalogues; false &rarr; the catalogues are read by all
+	 *  the tasks
+	 */
+	bool distributed_catalogues () const { return m_distributed_catalogues; }
+
+	/**
+	 *  @brief get the protected member m_cell_size
+	 *  @return the cell size of the chain-mesh used to count the
+	 *  pairs; if it is not set, the cell size is tuned
+	 *  automatically
+	 */
+	double cell_size () const { return m_cell_size; }
       
 	/**
 	 *  @brief get the x coordinates
@@ -1720,14 +2135,117 @@ namespace cbl {
 	 *  @param data object of class Catalogue 
 	 *  @return none
 	 */
-	void set_data (const catalogue::Catalogue data) { m_data = std::make_shared<catalogue::Catalogue>(catalogue::Catalogue(std::move(data))); }
+	void set_data (const catalogue::Catalogue &data) { m_data = std::make_shared<catalogue::Catalogue>(data); }
 
 	/**
 	 *  @brief add a random catalogue
 	 *  @param random object of class Catalogue 
 	 *  @return none
 	 */
-	void set_random (const catalogue::Catalogue random) { m_random = std::make_shared<catalogue::Catalogue>(catalogue::Catalogue(std::move(random))); }
+	void set_random (const catalogue::Catalogue &random) { m_random = std::make_shared<catalogue::Catalogue>(random); }
+
+	/**
+	 *  @brief set the spatial index used to search for close
+	 *  objects when counting the pairs
+	 *  @param spatialIndex the spatial index: SpatialIndex::_chainMesh_
+	 *  (default) or SpatialIndex::_kdTree_; the kd-tree is
+	 *  convenient for very anisotropic or sparse surveys, such as
+	 *  thin shells and pencil beams; it is used also when the
+	 *  pairs are counted by region, while the pairs counted on a
+	 *  grid do not depend on it
+	 *  @return none
+	 */
+	void set_spatialIndex (const chainmesh::SpatialIndex spatialIndex) { m_spatialIndex = spatialIndex; }
+
+	/**
+	 *  @brief set the cell size of the chain-mesh used to count
+	 *  the pairs
+	 *  @param cell_size the cell size; if it is not provided, the
+	 *  cell size is tuned automatically, using a cost model
+	 *  @param trial true &rarr; when the cell size is tuned, select
+	 *  the fastest of the best candidates of the cost model with a
+	 *  timing trial on a sub-volume of the catalogue
+	 *  @return none
+	 */
+	void set_cell_size (const double cell_size=par::defaultDouble, const bool trial=false) { m_cell_size = cell_size; m_cell_size_trial = trial; }
+
+	/**
+	 *  @brief count the pairs at large separations on a grid, with
+	 *  Fast Fourier Transforms
+	 *
+	 *  the pairs in the bins whose lower limit is larger than the
+	 *  transition scale are counted with
+	 *  TwoPointCorrelation::count_pairs_grid, while the pairs at
+	 *  smaller separations are counted exactly, searching for close
+	 *  objects only up to the transition scale; the grid is not
+	 *  used when the errors are estimated with resampling methods,
+	 *  and it can be used only for the monopole and the multipoles
+	 *  of the two-point correlation function
+	 *
+	 *  @param transition_scale the transition scale; if it is not
+	 *  positive, all the pairs are counted exactly
+	 *  @param cell_size the cell size of the grid, that should be
+	 *  much smaller than the transition scale
+	 *  @param assignment_type the mass assignment scheme: 0 &rarr;
+	 *  NGP; 1 &rarr; CIC; 2 &rarr; TSC; 3 &rarr; PCS
+	 *  @return none
+	 */
+	void set_grid_estimator (const double transition_scale, const double cell_size, const int assignment_type=1);
+
+	/**
+	 *  @brief measure the two-point correlation function of a
+	 *  periodic box, without random catalogues
+	 *
+	 *  the data objects have to be in [box_min, box_min+boxSide]
+	 *  along the three axes; the data-data pairs are counted with the minimum-image
+	 *  separations, including the periodic images of the objects
+	 *  close to the box faces (TwoPointCorrelation::periodic_images),
+	 *  while the random-random and data-random pairs are computed
+	 *  analytically, from the volume of the bins
+	 *  (TwoPointCorrelation::set_pairs_periodic); the random
+	 *  catalogue is not used, nor modified, and the number of
+	 *  random objects used by the estimators is the number of data
+	 *  objects; the random catalogue given to the constructors can
+	 *  be empty (see e.g. the constructors of
+	 *  TwoPointCorrelation1D_monopole for periodic boxes)
+	 *
+	 *  only the monopole of the two-point correlation function
+	 *  can be measured (i.e. the pairs have to be 1D comoving
+	 *  pairs, not multipoles): the line of sight of a pair between
+	 *  an object and the periodic image of another object would
+	 *  depend on the image counted, so the 2D and multipole pair
+	 *  counts would be wrong; the maximum separation has to be
+	 *  smaller than half the box side; the extra information of
+	 *  the pairs, the grid estimator and the resampling errors are
+	 *  not available in a periodic box
+	 *
+	 *  @param boxSide the side of the periodic box; if it is not
+	 *  positive, the catalogues are not periodic
+	 *  @param box_min the minimum coordinates of the box
+	 *  @return none
+	 */
+	void set_periodic_box (const double boxSide, const std::vector<double> box_min={0., 0., 0.});
+
+	/**
+	 *  @brief set whether the catalogues are distributed across
+	 *  the MPI tasks
+	 *
+	 *  if the catalogues are distributed, each task provides a
+	 *  different part of the data and random catalogues (e.g. it
+	 *  reads a different file, or a different block of rows), and
+	 *  holds only its part and, while counting the pairs, the
+	 *  objects of its slab and of its halo
+	 *  (TwoPointCorrelation::count_pairs_distributed); the numbers
+	 *  of objects used by the estimators are summed over all the
+	 *  tasks; the grid estimator and the resampling errors are not
+	 *  available with distributed catalogues
+	 *
+	 *  @param distributed true &rarr; each MPI task holds a
+	 *  different part of the catalogues; false &rarr; the
+	 *  catalogues are read by all the tasks
+	 *  @return none
+	 */
+	void set_distributed_catalogues (const bool distributed=true) { m_distributed_catalogues = distributed; }
 
 	///@}
 
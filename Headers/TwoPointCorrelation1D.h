@@ -303,7 +303,7 @@ namespace cbl {
 	 *  to improve performances in random-random pair counts
 	 *  @return object of class TwoPointCorrelation1D
 	 */
-	TwoPointCorrelation1D (const catalogue::Catalogue data, const catalogue::Catalogue random, const bool compute_extra_info=false, const double random_dilution_fraction=1.) 
+	TwoPointCorrelation1D (const catalogue::Catalogue &data, const catalogue::Catalogue &random, const bool compute_extra_info=false, const double random_dilution_fraction=1.) 
 	  : TwoPointCorrelation(data, random, compute_extra_info, random_dilution_fraction)
 	  { m_dataset = (!compute_extra_info) ? data::Data::Create(data::DataType::_1D_) : data::Data::Create(data::DataType::_1D_extra_); }
 
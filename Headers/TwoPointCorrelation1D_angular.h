@@ -211,11 +211,15 @@ namespace cbl {
 	 *  @param random_dilution_fraction fraction between the number
 	 *  of objects in the diluted and original random samples, used
 	 *  to improve performances in random-random pair counts
+	 *  @param spatialIndex the spatial index used to search for
+	 *  close objects: SpatialIndex::_chainMesh_ (default) or
+	 *  SpatialIndex::_kdTree_ (see
+	 *  TwoPointCorrelation::set_spatialIndex)
 	 *  @return object of class TwoPointCorrelation1D_angular
 	 */
-	TwoPointCorrelation1D_angular (const catalogue::Catalogue data, const catalogue::Catalogue random, const BinType binType, const double thetaMin, const double thetaMax, const int nbins, const double shift, const CoordinateUnits angularUnits=CoordinateUnits::_radians_, std::function<double(double)> angularWeight=nullptr, const bool compute_extra_info=false, const double random_dilution_fraction=1.)
+	TwoPointCorrelation1D_angular (const catalogue::Catalogue &data, const catalogue::Catalogue &random, const BinType binType, const double thetaMin, const double thetaMax, const int nbins, const double shift, const CoordinateUnits angularUnits=CoordinateUnits::_radians_, std::function<double(double)> angularWeight=nullptr, const bool compute_extra_info=false, const double random_dilution_fraction=1., const chainmesh::SpatialIndex spatialIndex=chainmesh::SpatialIndex::_chainMesh_)
 	  : TwoPointCorrelation(data, random, compute_extra_info, random_dilution_fraction), TwoPointCorrelation1D(data, random, compute_extra_info, random_dilution_fraction)
-	  { m_twoPType = TwoPType::_angular_; set_parameters(binType, thetaMin, thetaMax, nbins, shift, angularUnits, angularWeight, compute_extra_info); }
+	  { m_twoPType = TwoPType::_angular_; m_spatialIndex = spatialIndex; set_parameters(binType, thetaMin, thetaMax, nbins, shift, angularUnits, angularWeight, compute_extra_info); }
 
 	/**
 	 *  @brief constructor
@@ -239,11 +243,15 @@ namespace cbl {
 	 *  @param random_dilution_fraction fraction between the number
 	 *  of objects in the diluted and original random samples, used
 	 *  to improve performances in random-random pair counts
+	 *  @param spatialIndex the spatial index used to search for
+	 *  close objects: SpatialIndex::_chainMesh_ (default) or
+	 *  SpatialIndex::_kdTree_ (see
+	 *  TwoPointCorrelation::set_spatialIndex)
 	 *  @return object of class TwoPointCorrelation1D_angular
 	 */
-	TwoPointCorrelation1D_angular (const catalogue::Catalogue data, const catalogue::Catalogue random, const BinType binType, const double thetaMin, const double thetaMax, const double binSize, const double shift, const CoordinateUnits angularUnits=CoordinateUnits::_radians_, std::function<double(double)> angularWeight=nullptr, const bool compute_extra_info=false, const double random_dilution_fraction=1.)
+	TwoPointCorrelation1D_angular (const catalogue::Catalogue &data, const catalogue::Catalogue &random, const BinType binType, const double thetaMin, const double thetaMax, const double binSize, const double shift, const CoordinateUnits angularUnits=CoordinateUnits::_radians_, std::function<double(double)> angularWeight=nullptr, const bool compute_extra_info=false, const double random_dilution_fraction=1., const chainmesh::SpatialIndex spatialIndex=chainmesh::SpatialIndex::_chainMesh_)
 	  : TwoPointCorrelation(data, random, compute_extra_info, random_dilution_fraction), TwoPointCorrelation1D(data, random, compute_extra_info, random_dilution_fraction)
-	  { m_twoPType = TwoPType::_angular_; set_parameters(binType, thetaMin, thetaMax, binSize, shift, angularUnits, angularWeight, compute_extra_info); }
+	  { m_twoPType = TwoPType::_angular_; m_spatialIndex = spatialIndex; set_parameters(binType, thetaMin, thetaMax, binSize, shift, angularUnits, angularWeight, compute_extra_info); }
 
 	/**
 	 *  @brief default destructor
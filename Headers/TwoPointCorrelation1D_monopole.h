@@ -263,11 +263,15 @@ namespace cbl {
 	 *  @param random_dilution_fraction fraction between the number
 	 *  of objects in the diluted and original random samples, used
 	 *  to improve performances in random-random pair counts
+	 *  @param spatialIndex the spatial index used to search for
+	 *  close objects: SpatialIndex::_chainMesh_ (default) or
+	 *  SpatialIndex::_kdTree_ (see
+	 *  TwoPointCorrelation::set_spatialIndex)
 	 *  @return object of class TwoPointCorrelation1D_monopole
 	 */
-	TwoPointCorrelation1D_monopole (const catalogue::Catalogue data, const catalogue::Catalogue random, const BinType binType, const double rMin, const double rMax, const int nbins, const double shift, const CoordinateUnits angularUnits=CoordinateUnits::_radians_, std::function<double(double)> angularWeight=nullptr, const bool compute_extra_info=false, const double random_dilution_fraction=1.)
+	TwoPointCorrelation1D_monopole (const catalogue::Catalogue &data, const catalogue::Catalogue &random, const BinType binType, const double rMin, const double rMax, const int nbins, const double shift, const CoordinateUnits angularUnits=CoordinateUnits::_radians_, std::function<double(double)> angularWeight=nullptr, const bool compute_extra_info=false, const double random_dilution_fraction=1., const chainmesh::SpatialIndex spatialIndex=chainmesh::SpatialIndex::_chainMesh_)
 	  : TwoPointCorrelation(data, random, compute_extra_info, random_dilution_fraction), TwoPointCorrelation1D(data, random, compute_extra_info, random_dilution_fraction)
-	  { m_twoPType = TwoPType::_monopole_; set_parameters(binType, rMin, rMax, nbins, shift, angularUnits, angularWeight, compute_extra_info); }
+	  { m_twoPType = TwoPType::_monopole_; m_spatialIndex = spatialIndex; set_parameters(binType, rMin, rMax, nbins, shift, angularUnits, angularWeight, compute_extra_info); }
       
 	/**
 	 *  @brief constructor
@@ -289,11 +293,53 @@ namespace cbl {
 	 *  @param random_dilution_fraction fraction between the number
 	 *  of objects in the diluted and original random samples, used
 	 *  to improve performances in random-random pair counts
+	 *  @param spatialIndex the spatial index used to search for
+	 *  close objects: SpatialIndex::_chainMesh_ (default) or
+	 *  SpatialIndex::_kdTree_ (see
+	 *  TwoPointCorrelation::set_spatialIndex)
 	 *  @return object of class TwoPointCorrelation1D_monopole
 	 */
-	TwoPointCorrelation1D_monopole (const catalogue::Catalogue data, const catalogue::Catalogue random, const BinType binType, const double rMin, const double rMax, const double binSize, const double shift, const CoordinateUnits angularUnits=CoordinateUnits::_radians_, std::function<double(double)> angularWeight=nullptr, const bool compute_extra_info=false, const double random_dilution_fraction=1.)
+	TwoPointCorrelation1D_monopole (const catalogue::Catalogue &data, const catalogue::Catalogue &random, const BinType binType, const double rMin, const double rMax, const double binSize, const double shift, const CoordinateUnits angularUnits=CoordinateUnits::_radians_, std::function<double(double)> angularWeight=nullptr, const bool compute_extra_info=false, const double random_dilution_fraction=1., const chainmesh::SpatialIndex spatialIndex=chainmesh::SpatialIndex::_chainMesh_)
 	  : TwoPointCorrelation(data, random, compute_extra_info, random_dilution_fraction), TwoPointCorrelation1D(data, random, compute_extra_info, random_dilution_fraction)
-	  { m_twoPType = TwoPType::_monopole_; set_parameters(binType, rMin, rMax, binSize, shift, angularUnits, angularWeight, compute_extra_info); }
+	  { m_twoPType = TwoPType::_monopole_; m_spatialIndex = spatialIndex; set_parameters(binType, rMin, rMax, binSize, shift, angularUnits, angularWeight, compute_extra_info); }
+
+	/**
+	 *  @brief constructor for a periodic box, without random
+	 *  catalogue (see TwoPointCorrelation::set_periodic_box)
+	 *  @param data object of class Catalogue containing the input
+	 *  catalogue
+	 *  @param boxSide the side of the periodic box
+	 *  @param binType binning type
+	 *  @param rMin minimum separation used to count the pairs
+	 *  @param rMax maximum separation used to count the pairs
+	 *  @param nbins number of bins
+	 *  @param shift shift parameter, i.e. the radial shift is
+	 *  binSize*shift
+	 *  @param box_min the minimum coordinates of the box
+	 *  @return object of class TwoPointCorrelation1D_monopole
+	 */
+	TwoPointCorrelation1D_monopole (const catalogue::Catalogue &data, const double boxSide, const BinType binType, const double rMin, const double rMax, const int nbins, const double shift, const std::vector<double> box_min={0., 0., 0.})
+	  : TwoPointCorrelation(data, catalogue::Catalogue()), TwoPointCorrelation1D(data, catalogue::Catalogue())
+	  { m_twoPType = TwoPType::_monopole_; set_parameters(binType, rMin, rMax, nbins, shift); set_periodic_box(boxSide, box_min); }
+
+	/**
+	 *  @brief constructor for a periodic box, without random
+	 *  catalogue (see TwoPointCorrelation::set_periodic_box)
+	 *  @param data object of class Catalogue containing the input
+	 *  catalogue
+	 *  @param boxSide the side of the periodic box
+	 *  @param binType binning type
+	 *  @param rMin minimum separation used to count the pairs
+	 *  @param rMax maximum separation used to count the pairs
+	 *  @param binSize the bin size
+	 *  @param shift shift parameter, i.e. the radial shift is
+	 *  binSize*shift
+	 *  @param box_min the minimum coordinates of the box
+	 *  @return object of class TwoPointCorrelation1D_monopole
+	 */
+	TwoPointCorrelation1D_monopole (const catalogue::Catalogue &data, const double boxSide, const BinType binType, const double rMin, const double rMax, const double binSize, const double shift, const std::vector<double> box_min={0., 0., 0.})
+	  : TwoPointCorrelation(data, catalogue::Catalogue()), TwoPointCorrelation1D(data, catalogue::Catalogue())
+	  { m_twoPType = TwoPType::_monopole_; set_parameters(binType, rMin, rMax, binSize, shift); set_periodic_box(boxSide, box_min); }
 
 	/**
 	 *  @brief default destructor
@@ -278,7 +278,7 @@ namespace cbl {
 	 *  to improve performances in random-random pair counts
 	 *  @return object of class TwoPointCorrelation2D
 	 */
-	TwoPointCorrelation2D (const catalogue::Catalogue data, const catalogue::Catalogue random, const bool compute_extra_info=false, const double random_dilution_fraction=1.) 
+	TwoPointCorrelation2D (const catalogue::Catalogue &data, const catalogue::Catalogue &random, const bool compute_extra_info=false, const double random_dilution_fraction=1.) 
 	  : TwoPointCorrelation(data, random, compute_extra_info, random_dilution_fraction)
 	  { m_dataset = (!compute_extra_info) ? data::Data::Create(data::DataType::_2D_) : data::Data::Create(data::DataType::_2D_extra_); }
 
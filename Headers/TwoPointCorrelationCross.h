@@ -288,8 +288,8 @@ namespace cbl {
 	 *
 	 *  @return object of class TwoPointCorrelation
 	 */
-	TwoPointCorrelationCross (const catalogue::Catalogue data1, const catalogue::Catalogue data2, const catalogue::Catalogue random, const bool compute_extra_info=false, const double random_dilution_fraction=1.) 
-	  : TwoPointCorrelation(data1, random, compute_extra_info, random_dilution_fraction), m_data2(std::make_shared<catalogue::Catalogue>(catalogue::Catalogue(std::move(data2)))) {}
+	TwoPointCorrelationCross (const catalogue::Catalogue &data1, const catalogue::Catalogue &data2, const catalogue::Catalogue &random, const bool compute_extra_info=false, const double random_dilution_fraction=1.) 
+	  : TwoPointCorrelation(data1, random, compute_extra_info, random_dilution_fraction), m_data2(std::make_shared<catalogue::Catalogue>(data2)) {}
 
 	/**
 	 *  @brief default destructor
@@ -139,7 +139,7 @@ namespace cbl {
 	 *  to improve performances in random-random pair counts
 	 *  @return object of class TwoPointCorrelationCross1D
 	 */
-	TwoPointCorrelationCross1D (const catalogue::Catalogue data1, const catalogue::Catalogue data2, const catalogue::Catalogue random, const bool compute_extra_info=false, const double random_dilution_fraction=1.) 
+	TwoPointCorrelationCross1D (const catalogue::Catalogue &data1, const catalogue::Catalogue &data2, const catalogue::Catalogue &random, const bool compute_extra_info=false, const double random_dilution_fraction=1.) 
 	  : TwoPointCorrelationCross(data1, data2, random, compute_extra_info, random_dilution_fraction)
 	  { m_dataset = (!compute_extra_info) ? data::Data::Create(data::DataType::_1D_) : data::Data::Create(data::DataType::_1D_extra_); }
 
@@ -140,11 +140,15 @@ namespace cbl {
 	 *  @param random_dilution_fraction fraction between the number
 	 *  of objects in the diluted and original random samples, used
 	 *  to improve performances in random-random pair counts
+	 *  @param spatialIndex the spatial index used to search for
+	 *  close objects: SpatialIndex::_chainMesh_ (default) or
+	 *  SpatialIndex::_kdTree_ (see
+	 *  TwoPointCorrelation::set_spatialIndex)
 	 *  @return object of class TwoPointCorrelationCross1D_monopole
 	 */
-	TwoPointCorrelationCross1D_monopole (const catalogue::Catalogue data1, const catalogue::Catalogue data2, const catalogue::Catalogue random, const BinType binType, const double rMin, const double rMax, const int nbins, const double shift, const CoordinateUnits angularUnits=CoordinateUnits::_radians_, std::function<double(double)> angularWeight=nullptr, const bool compute_extra_info=false, const double random_dilution_fraction=1.)
+	TwoPointCorrelationCross1D_monopole (const catalogue::Catalogue &data1, const catalogue::Catalogue &data2, const catalogue::Catalogue &random, const BinType binType, const double rMin, const double rMax, const int nbins, const double shift, const CoordinateUnits angularUnits=CoordinateUnits::_radians_, std::function<double(double)> angularWeight=nullptr, const bool compute_extra_info=false, const double random_dilution_fraction=1., const chainmesh::SpatialIndex spatialIndex=chainmesh::SpatialIndex::_chainMesh_)
 	  : TwoPointCorrelation(data1, random, compute_extra_info, random_dilution_fraction), TwoPointCorrelationCross(data1, data2, random, compute_extra_info, random_dilution_fraction), TwoPointCorrelation1D(data1, random, compute_extra_info, random_dilution_fraction), TwoPointCorrelationCross1D(data1, data2, random, compute_extra_info, random_dilution_fraction)
-	  { m_twoPType = TwoPType::_monopole_; set_parameters(binType, rMin, rMax, nbins, shift, angularUnits, angularWeight, compute_extra_info); }
+	  { m_twoPType = TwoPType::_monopole_; m_spatialIndex = spatialIndex; set_parameters(binType, rMin, rMax, nbins, shift, angularUnits, angularWeight, compute_extra_info); }
       
 	/**
 	 *  @brief constructor
@@ -172,11 +176,15 @@ namespace cbl {
 	 *  @param random_dilution_fraction fraction between the number
 	 *  of objects in the diluted and original random samples, used
 	 *  to improve performances in random-random pair counts
+	 *  @param spatialIndex the spatial index used to search for
+	 *  close objects: SpatialIndex::_chainMesh_ (default) or
+	 *  SpatialIndex::_kdTree_ (see
+	 *  TwoPointCorrelation::set_spatialIndex)
 	 *  @return object of class TwoPointCorrelationCross1D_monopole
 	 */
-	TwoPointCorrelationCross1D_monopole (const catalogue::Catalogue data1, const catalogue::Catalogue data2, const catalogue::Catalogue random, const BinType binType, const double rMin, const double rMax, const double binSize, const double shift, const CoordinateUnits angularUnits=CoordinateUnits::_radians_, std::function<double(double)> angularWeight=nullptr, const bool compute_extra_info=false, const double random_dilution_fraction=1.)
+	TwoPointCorrelationCross1D_monopole (const catalogue::Catalogue &data1, const catalogue::Catalogue &data2, const catalogue::Catalogue &random, const BinType binType, const double rMin, const double rMax, const double binSize, const double shift, const CoordinateUnits angularUnits=CoordinateUnits::_radians_, std::function<double(double)> angularWeight=nullptr, const bool compute_extra_info=false, const double random_dilution_fraction=1., const chainmesh::SpatialIndex spatialIndex=chainmesh::SpatialIndex::_chainMesh_)
 	  : TwoPointCorrelation(data1, random, compute_extra_info, random_dilution_fraction), TwoPointCorrelationCross(data1, data2, random, compute_extra_info, random_dilution_fraction), TwoPointCorrelation1D(data1, random, compute_extra_info, random_dilution_fraction), TwoPointCorrelationCross1D(data1, data2, random, compute_extra_info, random_dilution_fraction)
-	  { m_twoPType = TwoPType::_monopole_; set_parameters(binType, rMin, rMax, binSize, shift, angularUnits, angularWeight, compute_extra_info); }
+	  { m_twoPType = TwoPType::_monopole_; m_spatialIndex = spatialIndex; set_parameters(binType, rMin, rMax, binSize, shift, angularUnits, angularWeight, compute_extra_info); }
 
 	/**
 	 *  @brief default destructor
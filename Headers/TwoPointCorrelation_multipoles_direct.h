@@ -273,12 +273,17 @@ namespace cbl {
            *  samples, used to improve performances in random-random
            *  pair counts
 	   *
+	   *  @param spatialIndex the spatial index used to search for
+	   *  close objects: SpatialIndex::_chainMesh_ (default) or
+	   *  SpatialIndex::_kdTree_ (see
+	   *  TwoPointCorrelation::set_spatialIndex)
+	   *
 	   *  @return object of class
 	   *  TwoPointCorrelation_multipoles_direct
            */
-          TwoPointCorrelation_multipoles_direct (const catalogue::Catalogue data, const catalogue::Catalogue random, const BinType binType, const double rMin, const double rMax, const int nbins, const double shift, const CoordinateUnits angularUnits=CoordinateUnits::_radians_, std::function<double(double)> angularWeight=nullptr, const bool compute_extra_info=false, const double random_dilution_fraction=1.) 
+          TwoPointCorrelation_multipoles_direct (const catalogue::Catalogue &data, const catalogue::Catalogue &random, const BinType binType, const double rMin, const double rMax, const int nbins, const double shift, const CoordinateUnits angularUnits=CoordinateUnits::_radians_, std::function<double(double)> angularWeight=nullptr, const bool compute_extra_info=false, const double random_dilution_fraction=1., const chainmesh::SpatialIndex spatialIndex=chainmesh::SpatialIndex::_chainMesh_)
 	    : TwoPointCorrelation(data, random, compute_extra_info, random_dilution_fraction), TwoPointCorrelation1D(data, random, compute_extra_info, random_dilution_fraction)
-	  { m_twoPType = TwoPType::_multipoles_direct_; set_parameters(binType, rMin, rMax, nbins, shift, angularUnits, angularWeight, compute_extra_info); }
+	  { m_twoPType = TwoPType::_multipoles_direct_; m_spatialIndex = spatialIndex; set_parameters(binType, rMin, rMax, nbins, shift, angularUnits, angularWeight, compute_extra_info); }
 
           /**
            *  @brief constructor
@@ -313,11 +318,16 @@ namespace cbl {
            *  samples, used to improve performances in random-random
            *  pair counts
 	   *
+           *  @param spatialIndex the spatial index used to search for
+           *  close objects: SpatialIndex::_chainMesh_ (default) or
+           *  SpatialIndex::_kdTree_ (see
+           *  TwoPointCorrelation::set_spatialIndex)
+	   *
            *  @return object of class TwoPointCorrelation_monopole
            */
-          TwoPointCorrelation_multipoles_direct (const catalogue::Catalogue data, const catalogue::Catalogue random, const BinType binType, const double rMin, const double rMax, const double binSize, const double shift, const CoordinateUnits angularUnits=CoordinateUnits::_radians_, std::function<double(double)> angularWeight=nullptr, const bool compute_extra_info=false, const double random_dilution_fraction=1.)
+          TwoPointCorrelation_multipoles_direct (const catalogue::Catalogue &data, const catalogue::Catalogue &random, const BinType binType, const double rMin, const double rMax, const double binSize, const double shift, const CoordinateUnits angularUnits=CoordinateUnits::_radians_, std::function<double(double)> angularWeight=nullptr, const bool compute_extra_info=false, const double random_dilution_fraction=1., const chainmesh::SpatialIndex spatialIndex=chainmesh::SpatialIndex::_chainMesh_)
             : TwoPointCorrelation(data, random, compute_extra_info, random_dilution_fraction), TwoPointCorrelation1D(data, random, compute_extra_info, random_dilution_fraction)
-	  { m_twoPType = TwoPType::_multipoles_direct_; set_parameters(binType, rMin, rMax, binSize, shift, angularUnits, angularWeight, compute_extra_info); }
+	  { m_twoPType = TwoPType::_multipoles_direct_; m_spatialIndex = spatialIndex; set_parameters(binType, rMin, rMax, binSize, shift, angularUnits, angularWeight, compute_extra_info); }
 
           /**
            *  @brief default destructor
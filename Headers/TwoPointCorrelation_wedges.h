@@ -352,12 +352,18 @@ namespace cbl {
 	 *  samples, used to improve performances in random-random
 	 *  pair counts
 	 *
+	 *  @param spatialIndex the spatial index used to search for
+	 *  close objects: SpatialIndex::_chainMesh_ (default) or
+	 *  SpatialIndex::_kdTree_ (see
+	 *  TwoPointCorrelation::set_spatialIndex)
+	 *
 	 *  @return object of class TwoPointCorrelation_wedges
 	 */
-	TwoPointCorrelation_wedges (catalogue::Catalogue data, catalogue::Catalogue random, const BinType binType_rad, const double rMin, const double rMax, const int nbins_rad, const double shift_rad, const int nWedges=2, const int nbins_mu=50, const double shift_mu=0.5, const CoordinateUnits angularUnits=CoordinateUnits::_radians_, std::function<double(double)> angularWeight=nullptr, const bool compute_extra_info=false, const double random_dilution_fraction=1.)
+	TwoPointCorrelation_wedges (catalogue::Catalogue data, catalogue::Catalogue random, const BinType binType_rad, const double rMin, const double rMax, const int nbins_rad, const double shift_rad, const int nWedges=2, const int nbins_mu=50, const double shift_mu=0.5, const CoordinateUnits angularUnits=CoordinateUnits::_radians_, std::function<double(double)> angularWeight=nullptr, const bool compute_extra_info=false, const double random_dilution_fraction=1., const chainmesh::SpatialIndex spatialIndex=chainmesh::SpatialIndex::_chainMesh_)
 	  : TwoPointCorrelation2D_polar(data, random, binType_rad, rMin, rMax, nbins_rad, shift_rad, BinType::_linear_, 0., 1., nbins_mu, shift_mu, angularUnits, angularWeight, compute_extra_info, random_dilution_fraction)
 	  {
 	    m_twoPType = TwoPType::_wedges_;
+	    m_spatialIndex = spatialIndex;
 	    
 	    if (nWedges<2)
 	      cbl::ErrorCBL("Error in TwoPointCorrelation_wedges() of TwoPointCorrelation_wedges.h: nWedges must be larger than2!");
@@ -420,12 +426,18 @@ namespace cbl {
 	 *  samples, used to improve performances in random-random
 	 *  pair counts
 	 *
+	 *  @param spatialIndex the spatial index used to search for
+	 *  close objects: SpatialIndex::_chainMesh_ (default) or
+	 *  SpatialIndex::_kdTree_ (see
+	 *  TwoPointCorrelation::set_spatialIndex)
+	 *
 	 *  @return object of class TwoPointCorrelation_wedges
 	 */
-	TwoPointCorrelation_wedges (catalogue::Catalogue data, catalogue::Catalogue random, const BinType binType_rad, const double rMin, const double rMax, const double binSize_rad, const double shift_rad, const int nWedges=2, const double binSize_mu=1., const double shift_mu=0.5, const CoordinateUnits angularUnits=CoordinateUnits::_radians_, std::function<double(double)> angularWeight=nullptr, const bool compute_extra_info=false, const double random_dilution_fraction=1.)
+	TwoPointCorrelation_wedges (catalogue::Catalogue data, catalogue::Catalogue random, const BinType binType_rad, const double rMin, const double rMax, const double binSize_rad, const double shift_rad, const int nWedges=2, const double binSize_mu=1., const double shift_mu=0.5, const CoordinateUnits angularUnits=CoordinateUnits::_radians_, std::function<double(double)> angularWeight=nullptr, const bool compute_extra_info=false, const double random_dilution_fraction=1., const chainmesh::SpatialIndex spatialIndex=chainmesh::SpatialIndex::_chainMesh_)
 	  : TwoPointCorrelation2D_polar(data, random, binType_rad, rMin, rMax, binSize_rad, shift_rad, BinType::_linear_, 0., 1., binSize_mu, shift_mu, angularUnits, angularWeight, compute_extra_info, random_dilution_fraction)
 	  {
 	    m_twoPType = TwoPType::_wedges_;
+	    m_spatialIndex = spatialIndex;
 
 	    if (nWedges<2)
 	      cbl::ErrorCBL("Error in TwoPointCorrelation_wedges() of TwoPointCorrelation_wedges.h: nWedges must be larger than2!");
@@ -493,21 +493,15 @@ void cbl::lognormal::LogNormalFull::set_visibility_from_random ()
 {
   coutCBL << "I'm setting the visibility from random sample..." << endl;
   int nsamples = m_random.size();
-  double cell_size_inv = 1./m_rmin;
 
   for (int s=0; s<nsamples; s++) {
     m_visibility_random[s]->reset();
 
-    int nObjects = m_random[s]->weightedN();  
-    for (int obj = 0; obj<nObjects; obj++) {
-      int i = min(int((m_random[s]->xx(obj)-m_xMin)*cell_size_inv), m_nx-1);
-      int j = min(int((m_random[s]->yy(obj)-m_yMin)*cell_size_inv), m_ny-1);
-      int k = min(int((m_random[s]->zz(obj)-m_zMin)*cell_size_inv), m_nz-1);
-
-      double ww = m_random[s]->weight(obj)/nObjects;
-      m_visibility_random[s]->set_ScalarField(ww, i, j, k, 1);
-    }
-
+    const double nObjects = m_random[s]->weightedN();
+    vector<double> ww = m_random[s]->var(catalogue::Var::_Weight_);
+    for (auto &&wobj : ww) wobj /= nObjects;
+    
+    m_visibility_random[s]->assign_mass(m_random[s]->var(catalogue::Var::_X_), m_random[s]->var(catalogue::Var::_Y_), m_random[s]->var(catalogue::Var::_Z_), ww);
   }
 
   coutCBL << "Done!" << endl;
@@ -527,6 +521,8 @@ void cbl::lognormal::LogNormalFull::set_visibility_from_random_RSD ()
     m_visibility_random[s]->reset();
 
     int nObjects = m_random[s]->nObjects();
+    vector<double> newx(nObjects), newy(nObjects), newz(nObjects), ww(nObjects);
+    
     for (int obj = 0; obj<nObjects; obj++) {
       int i = min(int((m_random[s]->xx(obj)-m_xMin)*cell_size_inv), m_nx-1);
       int j = min(int((m_random[s]->yy(obj)-m_yMin)*cell_size_inv), m_ny-1);
@@ -537,16 +533,14 @@ void cbl::lognormal::LogNormalFull::set_visibility_from_random_RSD ()
       double newred = m_random[s]->redshift(obj)-dz*(1+m_random[s]->redshift(obj));
       double newdc = m_func_DC->operator()(newred);
 
-      double newx = newdc*m_random[s]->xx(obj)/dc, newy=newdc*m_random[s]->yy(obj)/dc, newz = newdc*m_random[s]->zz(obj)/dc;
-
-      i = min(int((newx-m_xMin)*cell_size_inv), m_nx-1);
-      j = min(int((newy-m_yMin)*cell_size_inv), m_ny-1);
-      k = min(int((newz-m_zMin)*cell_size_inv), m_nz-1);
+      newx[obj] = newdc*m_random[s]->xx(obj)/dc;
+      newy[obj] = newdc*m_random[s]->yy(obj)/dc;
+      newz[obj] = newdc*m_random[s]->zz(obj)/dc;
       
-      double ww = m_random[s]->weight(obj)/nObjects;
-      m_visibility_random[s]->set_ScalarField(ww, i, j, k, 1);
+      ww[obj] = m_random[s]->weight(obj)/nObjects;
     }
 
+    m_visibility_random[s]->assign_mass(newx, newy, newz, ww);
   }
 
   coutCBL << "Done!" << endl;
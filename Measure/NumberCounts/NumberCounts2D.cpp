@@ -44,7 +44,7 @@ using namespace measure::numbercounts;
 // ============================================================================
 
 
-cbl::measure::numbercounts::NumberCounts2D::NumberCounts2D(const catalogue::Var var1, const BinType bin_type1, const catalogue::Var var2, const BinType bin_type2, const catalogue::Catalogue data, const size_t nbins1, const size_t nbins2, const double minVar1, const double maxVar1, const double minVar2, const double maxVar2, const double shift1, const double shift2, const glob::HistogramType hist_type, const double fact)
+cbl::measure::numbercounts::NumberCounts2D::NumberCounts2D(const catalogue::Var var1, const BinType bin_type1, const catalogue::Var var2, const BinType bin_type2, const catalogue::Catalogue &data, const size_t nbins1, const size_t nbins2, const double minVar1, const double maxVar1, const double minVar2, const double maxVar2, const double shift1, const double shift2, const glob::HistogramType hist_type, const double fact)
 {
   m_Var1 = var1;
   m_Var2 = var2;
@@ -0,0 +1,425 @@
+/********************************************************************
+ *  Copyright (C) 2010 by Federico Marulli and Alfonso Veropalumbo  *
+ *  federico.marulli3@unibo.it                                      *
+ *                                                                  *
+ *  This program is free software; you can redistribute it and/or   *
+ *  modify it under the terms of the GNU General Public License as  *
+ *  published by the Free Software Foundation; either version 2 of  *
+ *  the License, or (at your option) any later version.             *
+ *                                                                  *
+ *  This program is distributed in the hope that it will be useful, *
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of  *
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the   *
+ *  GNU General Public License for more details.                    *
+ *                                                                  *
+ *  You should have received a copy of the GNU General Public       *
+ *  License along with this program; if not, write to the Free      *
+ *  Software Foundation, Inc.,                                      *
+ *  59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.       *
+ *******************************************************************/
+
+/**
+ *  @file Measure/PowerSpectrum/PowerSpectrum.cpp
+ *
+ *  @brief Methods of the class PowerSpectrum
+ *
+ *  This file contains the implementation of the methods of the class
+ *  PowerSpectrum, used to measure the multipoles of the power
+ *  spectrum with Fast Fourier Transforms
+ *
+ *  @authors Federico Marulli, Alfonso Veropalumbo
+ *
+ *  @authors federico.marulli3@unbo.it, alfonso.veropalumbo@unibo.it
+ */
+
+#include "PowerSpectrum.h"
+
+using namespace std;
+
+using namespace cbl;
+using namespace catalogue;
+using namespace measure::powerspectrum;
+
+
+// ============================================================================
+
+
+cbl::measure::powerspectrum::PowerSpectrum::PowerSpectrum (const catalogue::Catalogue &data, const double boxSide, const double cell_size, const int nbins, const double kMin, const double kMax, const int assignment_type, const bool interlacing)
+  : m_data(make_shared<Catalogue>(data)), m_boxSide(boxSide), m_cell_size(cell_size), m_assignment_type(assignment_type), m_interlacing(interlacing), m_P0_FKP(0.), m_nbins(nbins), m_kMin(kMin), m_kMax(kMax)
+{
+  if (boxSide<=0.) ErrorCBL("Error in cbl::measure::powerspectrum::PowerSpectrum::PowerSpectrum() of PowerSpectrum.cpp: the side of the box must be positive!");
+  if (cell_size<=0. || cell_size>boxSide) ErrorCBL("Error in cbl::measure::powerspectrum::PowerSpectrum::PowerSpectrum() of PowerSpectrum.cpp: the cell size must be positive and smaller than the box!");
+  if (nbins<1) ErrorCBL("Error in cbl::measure::powerspectrum::PowerSpectrum::PowerSpectrum() of PowerSpectrum.cpp: the number of bins must be positive!");
+  if (assignment_type<0 || assignment_type>3) ErrorCBL("Error in cbl::measure::powerspectrum::PowerSpectrum::PowerSpectrum() of PowerSpectrum.cpp: the mass assignment scheme must be 0 (NGP), 1 (CIC), 2 (TSC) or 3 (PCS)!");
+}
+
+
+// ============================================================================
+
+
+cbl::measure::powerspectrum::PowerSpectrum::PowerSpectrum (const catalogue::Catalogue &data, const catalogue::Catalogue &random, const double cell_size, const int nbins, const double kMin, const double kMax, const double P0_FKP, const int assignment_type, const bool interlacing)
+  : m_data(make_shared<Catalogue>(data)), m_random(make_shared<Catalogue>(random)), m_boxSide(0.), m_cell_size(cell_size), m_assignment_type(assignment_type), m_interlacing(interlacing), m_P0_FKP(P0_FKP), m_nbins(nbins), m_kMin(kMin), m_kMax(kMax)
+{
+  if (cell_size<=0.) ErrorCBL("Error in cbl::measure::powerspectrum::PowerSpectrum::PowerSpectrum() of PowerSpectrum.cpp: the cell size must be positive!");
+  if (nbins<1) ErrorCBL("Error in cbl::measure::powerspectrum::PowerSpectrum::PowerSpectrum() of PowerSpectrum.cpp: the number of bins must be positive!");
+  if (P0_FKP<0.) ErrorCBL("Error in cbl::measure::powerspectrum::PowerSpectrum::PowerSpectrum() of PowerSpectrum.cpp: the power spectrum amplitude of the FKP weights cannot be negative!");
+  if (assignment_type<0 || assignment_type>3) ErrorCBL("Error in cbl::measure::powerspectrum::PowerSpectrum::PowerSpectrum() of PowerSpectrum.cpp: the mass assignment scheme must be 0 (NGP), 1 (CIC), 2 (TSC) or 3 (PCS)!");
+  if (random.nObjects()==0) ErrorCBL("Error in cbl::measure::powerspectrum::PowerSpectrum::PowerSpectrum() of PowerSpectrum.cpp: the random catalogue is empty!");
+}
+
+
+// ============================================================================
+
+
+std::vector<double> cbl::measure::powerspectrum::PowerSpectrum::Pk (const int ell) const
+{
+  if (ell!=0 && ell!=2 && ell!=4) ErrorCBL("Error in cbl::measure::powerspectrum::PowerSpectrum::Pk() of PowerSpectrum.cpp: the order of the multipole must be 0, 2 or 4!");
+  if (m_pk.size()==0) ErrorCBL("Error in cbl::measure::powerspectrum::PowerSpectrum::Pk() of PowerSpectrum.cpp: the power spectrum has not been measured!");
+  return m_pk[ell/2];
+}
+
+
+// ============================================================================
+
+
+std::vector<double> cbl::measure::powerspectrum::PowerSpectrum::error (const int ell) const
+{
+  if (ell!=0 && ell!=2 && ell!=4) ErrorCBL("Error in cbl::measure::powerspectrum::PowerSpectrum::error() of PowerSpectrum.cpp: the order of the multipole must be 0, 2 or 4!");
+  if (m_error.size()==0) ErrorCBL("Error in cbl::measure::powerspectrum::PowerSpectrum::error() of PowerSpectrum.cpp: the power spectrum has not been measured!");
+  return m_error[ell/2];
+}
+
+
+// ============================================================================
+
+
+void cbl::measure::powerspectrum::PowerSpectrum::m_bin (const data::ScalarField3D &field, const std::vector<std::vector<double>> &power, const double normalization)
+{
+  const double kMax = (m_kMax>par::defaultDouble) ? m_kMax : par::pi/max(field.deltaX(), max(field.deltaY(), field.deltaZ()));
+  if (kMax<=m_kMin) ErrorCBL("Error in cbl::measure::powerspectrum::PowerSpectrum::m_bin() of PowerSpectrum.cpp: the maximum k must be larger than the minimum one!");
+  const double dk = (kMax-m_kMin)/m_nbins;
+
+  vector<double> sum_k(m_nbins, 0.), sum_modes(m_nbins, 0.);
+  vector<vector<double>> sum_power(3, vector<double>(m_nbins, 0.));
+
+
+  // the modes with 0<kz<kNyquist are counted twice, since their complex conjugates are not stored
+
+  const int nzF = field.nzFourier();
+
+  for (int i=0; i<field.nx(); i++)
+    for (int j=0; j<field.ny(); j++)
+      for (int k=0; k<nzF; k++) {
+	const double kmod = sqrt(pow(field.kX(i), 2)+pow(field.kY(j), 2)+pow(field.kZ(k), 2));
+	if (kmod==0. || kmod<m_kMin || kmod>=kMax) continue;
+
+	const int bin = min(int((kmod-m_kMin)/dk), m_nbins-1);
+	const double nn = (k==0 || k==field.nz()/2) ? 1. : 2.;
+	const long int index = k+nzF*(j+field.ny()*i);
+
+	sum_k[bin] += nn*kmod;
+	sum_modes[bin] += nn;
+	for (size_t ll=0; ll<power.size(); ++ll)
+	  sum_power[ll][bin] += nn*power[ll][index];
+      }
+
+  m_shot_noise /= normalization;
+
+  m_kk.resize(m_nbins);
+  m_nModes = sum_modes;
+  m_pk.assign(3, vector<double>(m_nbins, 0.));
+  m_error.assign(3, vector<double>(m_nbins, 0.));
+
+  for (int bin=0; bin<m_nbins; ++bin) {
+
+    if (sum_modes[bin]==0.) {
+      m_kk[bin] = m_kMin+(bin+0.5)*dk;
+      continue;
+    }
+
+    m_kk[bin] = sum_k[bin]/sum_modes[bin];
+
+    for (size_t ll=0; ll<power.size(); ++ll)
+      m_pk[ll][bin] = sum_power[ll][bin]/sum_modes[bin]/normalization;
+    m_pk[0][bin] -= m_shot_noise;
+
+
+    // Gaussian errors: the number of independent modes is half the number of modes
+
+    for (size_t ll=0; ll<power.size(); ++ll)
+      m_error[ll][bin] = (m_pk[0][bin]+m_shot_noise)*sqrt(2.*(4*ll+1)/sum_modes[bin]);
+  }
+}
+
+
+// ============================================================================
+
+
+void cbl::measure::powerspectrum::PowerSpectrum::m_measure_box (const int lMax)
+{
+  const vector<double> xx = m_data->var(Var::_X_), yy = m_data->var(Var::_Y_), zz = m_data->var(Var::_Z_), weight = m_data->var(Var::_Weight_);
+
+  data::ScalarField3D field(m_cell_size, 0., m_boxSide, 0., m_boxSide, 0., m_boxSide);
+
+  field.assign_mass(xx, yy, zz, weight, m_assignment_type, m_interlacing, false);
+
+  // the field in Fourier space is set by the mass assignment only with interlacing
+  if (!m_interlacing) field.FourierTransformField();
+
+  double sumW = 0., sumW2 = 0.;
+  for (size_t i=0; i<weight.size(); ++i) {
+    sumW += weight[i];
+    sumW2 += weight[i]*weight[i];
+  }
+  if (sumW<=0.) ErrorCBL("Error in cbl::measure::powerspectrum::PowerSpectrum::m_measure_box() of PowerSpectrum.cpp: the total weight of the objects must be positive!");
+
+
+  // the power of each mode, weighted by the Legendre polynomials of mu=kz/k; the fields in Fourier
+  // space are normalized by the number of cells, and divided by the window function of the mass
+  // assignment scheme
+
+  const int nzF = field.nzFourier();
+  const double nCells = field.nCells();
+  vector<vector<double>> power(lMax/2+1, vector<double>(field.nCellsFourier(), 0.));
+
+#pragma omp parallel for schedule(static)
+  for (int i=0; i<field.nx(); i++)
+    for (int j=0; j<field.ny(); j++)
+      for (int k=0; k<nzF; k++) {
+	const double k2 = pow(field.kX(i), 2)+pow(field.kY(j), 2)+pow(field.kZ(k), 2);
+	if (k2==0.) continue;
+
+	const double mu2 = pow(field.kZ(k), 2)/k2;
+	const double fact = nCells/field.window_mass_assignment(i, j, k, m_assignment_type);
+	const double pk = (pow(field.ScalarField_FourierSpace_real(i, j, k), 2)+pow(field.ScalarField_FourierSpace_complex(i, j, k), 2))*fact*fact;
+	const long int index = k+nzF*(j+field.ny()*i);
+
+	power[0][index] = pk;
+	if (lMax>=2) power[1][index] = 5.*0.5*(3.*mu2-1.)*pk;
+	if (lMax>=4) power[2][index] = 9.*0.125*(35.*mu2*mu2-30.*mu2+3.)*pk;
+      }
+
+  const double normalization = sumW*sumW/field.Volume();
+  m_shot_noise = sumW2;
+
+  m_bin(field, power, normalization);
+}
+
+
+// ============================================================================
+
+
+void cbl::measure::powerspectrum::PowerSpectrum::m_measure_survey (const int lMax)
+{
+  const vector<double> xd = m_data->var(Var::_X_), yd = m_data->var(Var::_Y_), zd = m_data->var(Var::_Z_);
+  const vector<double> xr = m_random->var(Var::_X_), yr = m_random->var(Var::_Y_), zr = m_random->var(Var::_Z_);
+  vector<double> wd = m_data->var(Var::_Weight_), wr = m_random->var(Var::_Weight_);
+
+
+  // the grid encloses the data and random objects, with an empty layer wide enough to avoid that the
+  // objects are assigned to the cells on the opposite side
+
+  const double pad = (m_assignment_type+2)*m_cell_size;
+  const double minX = min(m_data->Min(Var::_X_), m_random->Min(Var::_X_))-pad, maxX = max(m_data->Max(Var::_X_), m_random->Max(Var::_X_))+pad;
+  const double minY = min(m_data->Min(Var::_Y_), m_random->Min(Var::_Y_))-pad, maxY = max(m_data->Max(Var::_Y_), m_random->Max(Var::_Y_))+pad;
+  const double minZ = min(m_data->Min(Var::_Z_), m_random->Min(Var::_Z_))-pad, maxZ = max(m_data->Max(Var::_Z_), m_random->Max(Var::_Z_))+pad;
+
+  data::ScalarField3D field(m_cell_size, minX, maxX, minY, maxY, minZ, maxZ);
+  data::ScalarField3D work(m_cell_size, minX, maxX, minY, maxY, minZ, maxZ);
+
+  double sumWd = 0., sumWr = 0.;
+  for (size_t i=0; i<wd.size(); ++i) sumWd += wd[i];
+  for (size_t i=0; i<wr.size(); ++i) sumWr += wr[i];
+  if (sumWd<=0. || sumWr<=0.) ErrorCBL("Error in cbl::measure::powerspectrum::PowerSpectrum::m_measure_survey() of PowerSpectrum.cpp: the total weights of the data and random objects must be positive!");
+
+  const double alpha = sumWd/sumWr;
+
+
+  // the mean density at the position of the objects is estimated from the random objects in the
+  // cells of the grid, and used to compute the FKP weights and the normalization
+
+  work.assign_mass(xr, yr, zr, wr, 0, false, false);
+
+  const double nbar_fact = alpha/(field.deltaX()*field.deltaY()*field.deltaZ());
+
+  double normalization = 0., shot_noise_data = 0., shot_noise_random = 0.;
+
+  for (size_t i=0; i<xr.size(); ++i) {
+    const double nbar = nbar_fact*work.ScalarField({xr[i], yr[i], zr[i]});
+    const double wFKP = 1./(1.+nbar*m_P0_FKP);
+    normalization += wr[i]*nbar*wFKP*wFKP;
+    wr[i] *= wFKP;
+    shot_noise_random += wr[i]*wr[i];
+  }
+
+  for (size_t i=0; i<xd.size(); ++i) {
+    const double nbar = nbar_fact*work.ScalarField({xd[i], yd[i], zd[i]});
+    wd[i] /= 1.+nbar*m_P0_FKP;
+    shot_noise_data += wd[i]*wd[i];
+  }
+
+  normalization *= alpha;
+  if (normalization<=0.) ErrorCBL("Error in cbl::measure::powerspectrum::PowerSpectrum::m_measure_survey() of PowerSpectrum.cpp: the normalization of the power spectrum must be positive!");
+
+  m_shot_noise = shot_noise_data+alpha*alpha*shot_noise_random;
+
+
+  // the field F = w*(n_g-alpha*n_r)
+
+  field.assign_mass(xd, yd, zd, wd, m_assignment_type, m_interlacing, false);
+  work.assign_mass(xr, yr, zr, wr, m_assignment_type, m_interlacing, false);
+
+  vector<double> FF = field.ScalarField();
+  const vector<double> FR = work.ScalarField();
+  for (size_t i=0; i<FF.size(); ++i)
+    FF[i] -= alpha*FR[i];
+
+
+  // the line of sight at the centre of each cell
+
+  const int nx = field.nx(), ny = field.ny(), nz = field.nz(), nzF = field.nzFourier();
+  const int nCF = field.nCellsFourier();
+
+  vector<array<double, 3>> los(field.nCells());
+
+#pragma omp parallel for schedule(static)
+  for (int i=0; i<nx; i++)
+    for (int j=0; j<ny; j++)
+      for (int k=0; k<nz; k++) {
+	const double rr = sqrt(pow(field.XX(i), 2)+pow(field.YY(j), 2)+pow(field.ZZ(k), 2));
+	los[k+nz*(j+ny*i)] = (rr>0.) ? array<double, 3>{field.XX(i)/rr, field.YY(j)/rr, field.ZZ(k)/rr} : array<double, 3>{0., 0., 0.};
+      }
+
+
+  // the unit vectors of the modes
+
+  vector<array<double, 3>> khat(nCF);
+
+#pragma omp parallel for schedule(static)
+  for (int i=0; i<nx; i++)
+    for (int j=0; j<ny; j++)
+      for (int k=0; k<nzF; k++) {
+	const double kk = sqrt(pow(field.kX(i), 2)+pow(field.kY(j), 2)+pow(field.kZ(k), 2));
+	khat[k+nzF*(j+ny*i)] = (kk>0.) ? array<double, 3>{field.kX(i)/kk, field.kY(j)/kk, field.kZ(k)/kk} : array<double, 3>{0., 0., 0.};
+      }
+
+
+  // the sum over the components of the line of sight, Q_n(k) = sum_{i1..in} k_i1...k_in
+  // FFT[r_i1...r_in F](k), is computed with one transform for each independent product
+  // r_x^a r_y^b r_z^c, with a+b+c=n, multiplied by its multinomial coefficient
+
+  auto ipow = [] (const double xx, const int nn) { double vv = 1.; for (int p=0; p<nn; ++p) vv *= xx; return vv; };
+
+  auto transform = [&] (const int nn, vector<complex<double>> &QQ)
+    {
+      QQ.assign(nCF, complex<double>(0., 0.));
+      const double factorial[5] = {1., 1., 2., 6., 24.};
+
+      for (int a=nn; a>=0; --a)
+	for (int b=nn-a; b>=0; --b) {
+	  const int c = nn-a-b;
+	  const double multinomial = factorial[nn]/(factorial[a]*factorial[b]*factorial[c]);
+
+#pragma omp parallel for schedule(static)
+	  for (int i=0; i<nx; i++)
+	    for (int j=0; j<ny; j++)
+	      for (int k=0; k<nz; k++) {
+		const long int index = k+nz*(j+ny*i);
+		work.set_ScalarField(FF[index]*ipow(los[index][0], a)*ipow(los[index][1], b)*ipow(los[index][2], c), i, j, k);
+	      }
+
+	  work.FourierTransformField();
+
+#pragma omp parallel for schedule(static)
+	  for (int i=0; i<nx; i++)
+	    for (int j=0; j<ny; j++)
+	      for (int k=0; k<nzF; k++) {
+		const long int index = k+nzF*(j+ny*i);
+		const double fact = multinomial*ipow(khat[index][0], a)*ipow(khat[index][1], b)*ipow(khat[index][2], c);
+		QQ[index] += fact*complex<double>(work.ScalarField_FourierSpace_real(i, j, k), work.ScalarField_FourierSpace_complex(i, j, k));
+	      }
+	}
+    };
+
+  vector<complex<double>> F0, Q2, Q4;
+  transform(0, F0);
+  if (lMax>=2) transform(2, Q2);
+  if (lMax>=4) transform(4, Q4);
+
+
+  // the power of each mode: P_l(k) = (2l+1) Re[F_l(k) F_0*(k)], with F_2 = (3Q_2-F_0)/2 and F_4 =
+  // (35Q_4-30Q_2+3F_0)/8; the fields in Fourier space are normalized by the number of cells, and
+  // divided by the window function of the mass assignment scheme
+
+  const double nCells = field.nCells();
+  vector<vector<double>> power(lMax/2+1, vector<double>(nCF, 0.));
+
+#pragma omp parallel for schedule(static)
+  for (int i=0; i<nx; i++)
+    for (int j=0; j<ny; j++)
+      for (int k=0; k<nzF; k++) {
+	const long int index = k+nzF*(j+ny*i);
+	const double fact = pow(nCells/field.window_mass_assignment(i, j, k, m_assignment_type), 2);
+	const complex<double> F0c = conj(F0[index]);
+
+	power[0][index] = fact*norm(F0[index]);
+	if (lMax>=2) power[1][index] = 5.*fact*real(0.5*(3.*Q2[index]-F0[index])*F0c);
+	if (lMax>=4) power[2][index] = 9.*fact*real(0.125*(35.*Q4[index]-30.*Q2[index]+3.*F0[index])*F0c);
+      }
+
+  m_bin(field, power, normalization);
+}
+
+
+// ============================================================================
+
+
+void cbl::measure::powerspectrum::PowerSpectrum::measure (const int lMax)
+{
+  if (lMax!=0 && lMax!=2 && lMax!=4) ErrorCBL("Error in cbl::measure::powerspectrum::PowerSpectrum::measure() of PowerSpectrum.cpp: the maximum order of the multipoles must be 0, 2 or 4!");
+
+  coutCBL << "Measuring the power spectrum multipoles..." << endl;
+
+  if (m_random==nullptr) m_measure_box(lMax);
+  else m_measure_survey(lMax);
+
+  vector<double> kk, pk, error;
+  for (int ll=0; ll<3; ++ll)
+    for (int bin=0; bin<m_nbins; ++bin) {
+      kk.push_back(m_kk[bin]);
+      pk.push_back(m_pk[ll][bin]);
+      error.push_back(m_error[ll][bin]);
+    }
+
+  m_dataset = make_shared<data::Data1D>(data::Data1D(kk, pk, error));
+
+  coutCBL << "Done!" << endl;
+}
+
+
+// ============================================================================
+
+
+void cbl::measure::powerspectrum::PowerSpectrum::write (const std::string dir, const std::string file) const
+{
+  if (m_dataset==nullptr) ErrorCBL("Error in cbl::measure::powerspectrum::PowerSpectrum::write() of PowerSpectrum.cpp: the power spectrum has not been measured!");
+
+  const string file_out = dir+file;
+  ofstream fout(file_out.c_str()); checkIO(fout, file_out);
+
+  const int precision = 5;
+
+  fout << "### [1] mean k # [2] number of modes # [3] monopole # [4] error on the monopole # [5] quadrupole # [6] error on the quadrupole # [7] hexadecapole # [8] error on the hexadecapole ###" << endl;
+  fout << "### shot noise: " << m_shot_noise << " ###" << endl;
+
+  for (int i=0; i<m_nbins; i++) {
+    fout << setiosflags(ios::fixed) << setprecision(precision) << setw(10) << right << m_kk[i]
+	 << "  "  << setiosflags(ios::fixed) << setprecision(0) << setw(10) << right << m_nModes[i];
+    for (int ll=0; ll<3; ++ll)
+      fout << "  "  << setiosflags(ios::fixed) << setprecision(precision) << setw(10) << right << m_pk[ll][i]
+	   << "  "  << setiosflags(ios::fixed) << setprecision(precision) << setw(10) << right << m_error[ll][i];
+    fout << endl;
+  }
+
+  fout.close(); cout << endl; coutCBL << "I wrote the file: " << file_out << endl << endl;
+}
@@ -55,7 +55,7 @@ using namespace measure::threept;
 // ============================================================================
 
 
-std::shared_ptr<ThreePointCorrelation> cbl::measure::threept::ThreePointCorrelation::Create (const ThreePType type, const catalogue::Catalogue data, const catalogue::Catalogue random, const triplets::TripletType tripletType, const double side_s, const double side_u, const double perc_increase, const int nbins)
+std::shared_ptr<ThreePointCorrelation> cbl::measure::threept::ThreePointCorrelation::Create (const ThreePType type, const catalogue::Catalogue &data, const catalogue::Catalogue &random, const triplets::TripletType tripletType, const double side_s, const double side_u, const double perc_increase, const int nbins)
 {
   if (type==ThreePType::_angular_connected_) return move(unique_ptr<ThreePointCorrelation_angular_connected>(new ThreePointCorrelation_angular_connected(data, random, side_s, side_u, perc_increase, nbins)));
  
@@ -74,7 +74,7 @@ std::shared_ptr<ThreePointCorrelation> cbl::measure::threept::ThreePointCorrelat
 // ============================================================================
 
 
-std::shared_ptr<ThreePointCorrelation> cbl::measure::threept::ThreePointCorrelation::Create (const ThreePType type, const catalogue::Catalogue data, const catalogue::Catalogue random, const triplets::TripletType tripletType, const double r12, const double r12_binSize, const double r13, const double r13_binSize, const int nbins)
+std::shared_ptr<ThreePointCorrelation> cbl::measure::threept::ThreePointCorrelation::Create (const ThreePType type, const catalogue::Catalogue &data, const catalogue::Catalogue &random, const triplets::TripletType tripletType, const double r12, const double r12_binSize, const double r13, const double r13_binSize, const int nbins)
 {
   if (type==ThreePType::_angular_connected_) return move(unique_ptr<ThreePointCorrelation_angular_connected>(new ThreePointCorrelation_angular_connected(data, random, r12, r12_binSize, r13, r13_binSize, nbins)));
  
@@ -92,25 +92,96 @@ std::shared_ptr<ThreePointCorrelation> cbl::measure::threept::ThreePointCorrelat
 // ============================================================================
 
 
-void cbl::measure::threept::ThreePointCorrelation::count_triplets (const std::shared_ptr<Catalogue> cat1, const ChainMesh_Catalogue &ChainMesh_rMAX1, const ChainMesh_Catalogue &ChainMesh_rMAX2, std::shared_ptr<Triplet> tt, const bool tcount) 
+// group the objects of a catalogue in the cells of a chain-mesh, and sort the cells by decreasing
+// cost, estimated as the number of objects of the cell times the square of the number of objects in
+// the cells closer than rMAX (i.e. the number of triplets expected for the objects of the cell); cells
+// with the same cost keep their order, so that the order does not depend on the number of threads
+
+static std::vector<std::vector<long>> cost_ordered_cells (const std::shared_ptr<Catalogue> cat, const double rMAX, std::vector<double> &cost)
 {
-  time_t start; time (&start);
+  ChainMesh3D ChM(0.5*rMAX, cat->var(Var::_X_), cat->var(Var::_Y_), cat->var(Var::_Z_), rMAX, 10);
+
+  vector<long> cells = ChM.NonEmpty_Cells();
+  sort(cells.begin(), cells.end());
+  
+  const size_t nCells = cells.size();
+  vector<vector<long>> objects(nCells);
   
-  int nObj = cat1->nObjects();
+  for (size_t n=0; n<nCells; ++n) {
+    objects[n] = ChM.get_list(cells[n]);
+    sort(objects[n].begin(), objects[n].end());
+  }
 
-  float fact_count = 100./nObj;
+  vector<double> cost_cell(nCells);
+  for (size_t n=0; n<nCells; ++n) {
+    double nClose = 0.;
+    for (auto &&cell : ChM.close_cells(cells[n])) {
+      auto it = lower_bound(cells.begin(), cells.end(), cell);
+      if (it!=cells.end() && *it==cell) nClose += objects[it-cells.begin()].size();
+    }
+    cost_cell[n] = objects[n].size()*nClose*nClose+1.;
+  }
+
+  vector<size_t> order(nCells);
+  for (size_t n=0; n<nCells; ++n) order[n] = n;
+  stable_sort(order.begin(), order.end(), [&cost_cell] (const size_t i, const size_t j) { return cost_cell[i]>cost_cell[j]; });
+
+  vector<vector<long>> objects_ordered(nCells);
+  cost.resize(nCells);
+  for (size_t n=0; n<nCells; ++n) {
+    objects_ordered[n] = move(objects[order[n]]);
+    cost[n] = cost_cell[order[n]];
+  }
   
-  cout.setf(ios::fixed); cout.setf(ios::showpoint); cout.precision(2);
+  return objects_ordered;
+}
+
+
+// ============================================================================
+
+
+void cbl::measure::threept::ThreePointCorrelation::count_triplets (const std::shared_ptr<Catalogue> cat1, const ChainMesh_Catalogue &ChainMesh_rMAX1, const ChainMesh_Catalogue &ChainMesh_rMAX2, std::shared_ptr<Triplet> tt, const bool tcount) 
+{
+  count_triplets(cat1, ChainMesh_rMAX1.catalogue(), ChainMesh_rMAX2.catalogue(), [&] (const vector<double> center) { return ChainMesh_rMAX1.close_objects(center, -1); }, [&] (const vector<double> center) { return ChainMesh_rMAX2.close_objects(center, -1); }, tt, tcount);
+}
 
-  shared_ptr<Catalogue> cat2 = ChainMesh_rMAX1.catalogue();
-  shared_ptr<Catalogue> cat3 = ChainMesh_rMAX2.catalogue();
 
+// ============================================================================
+
+
+void cbl::measure::threept::ThreePointCorrelation::count_triplets (const std::shared_ptr<Catalogue> cat1, const KDTree_Catalogue &tree_rMAX1, const KDTree_Catalogue &tree_rMAX2, std::shared_ptr<Triplet> tt, const bool tcount) 
+{
+  count_triplets(cat1, tree_rMAX1.catalogue(), tree_rMAX2.catalogue(), [&] (const vector<double> center) { return tree_rMAX1.close_objects(center, -1); }, [&] (const vector<double> center) { return tree_rMAX2.close_objects(center, -1); }, tt, tcount);
+}
+
+
+// ============================================================================
+
+
+void cbl::measure::threept::ThreePointCorrelation::count_triplets (const std::shared_ptr<Catalogue> cat1, const std::shared_ptr<Catalogue> cat2, const std::shared_ptr<Catalogue> cat3, std::function<std::vector<long>(const std::vector<double>)> close_objects12, std::function<std::vector<long>(const std::vector<double>)> close_objects13, std::shared_ptr<Triplet> tt, const bool tcount) 
+{
+  time_t start; time (&start);
+  
   double r12_min = tt->r12()-0.5*tt->r12_binSize();
   double r12_max = tt->r12()+0.5*tt->r12_binSize();
   double r13_min = tt->r13()-0.5*tt->r13_binSize();
   double r13_max = tt->r13()+0.5*tt->r13_binSize();
 
+  // the objects of the first catalogue, grouped in cells sorted by decreasing cost
+  vector<double> cost;
+  const vector<vector<long>> cells = cost_ordered_cells(cat1, max(r12_max, r13_max), cost);
+  const int nCells = cells.size();
+  
+  // progress of the count, weighted by the cost of the cells
+  ProgressReporter progress(accumulate(cost.begin(), cost.end(), 0.), tcount, true, ".....");
+  
+  cout.setf(ios::fixed); cout.setf(ios::showpoint); cout.precision(2);
+
   int tid = 0;
+
+  // triplets computed by each thread, summed with a tree reduction
+  vector<shared_ptr<Triplet>> tt_threads(omp_get_max_threads());
+  
 #pragma omp parallel private(tid)
   {
     tid = omp_get_thread_num();
@@ -119,60 +190,63 @@ void cbl::measure::threept::ThreePointCorrelation::count_triplets (const std::sh
 
     // internal object used by each thread to handle triplets
     shared_ptr<Triplet> tt_thread = move(Triplet::Create(tt->tripletType(), tt->r12(), tt->r12_binSize(), tt->r13(), tt->r13_binSize(), tt->nbins()));
+
+    // parallelized loop: the most expensive cells are handled first, and the idle threads take the
+    // next cell, as in cbl::measure::twopt::TwoPointCorrelation::count_pairs_cells
+#pragma omp for schedule(dynamic)
+    for (int n=0; n<nCells; n++) {
+
+      for (auto &&i : cells[n]) { // loop on the objects of the cell
     
-#pragma omp for schedule(static, 2)  
-    for (int i=0; i<nObj; i++) { // loop on the objects of the catalogue
-    
-      // get the indexes of the objects at r12
-      vector<long> close_objects12 = ChainMesh_rMAX1.close_objects(cat1->coordinate(i), -1);
+	// get the indexes of the objects at r12
+	vector<long> close_objects_r12 = close_objects12(cat1->coordinate(i));
 
-      // get the indexes of objects at r13
-      vector<long> close_objects13 = ChainMesh_rMAX2.close_objects(cat1->coordinate(i), -1);
+	// get the indexes of objects at r13
+	vector<long> close_objects_r13 = close_objects13(cat1->coordinate(i));
 
-      vector<double> x2, y2, z2, r12, w2, x3, y3, z3, r13, w3;
+	vector<double> x2, y2, z2, r12, w2, x3, y3, z3, r13, w3;
 
-      for (auto &&j : close_objects12) { // loop on the objects at r12 
+	for (auto &&j : close_objects_r12) { // loop on the objects at r12 
 
-	double rr = cat1->distance(i, cat2->catalogue_object(j));
-	if (r12_min<rr && rr<r12_max){
-	  x2.push_back(cat2->xx(j));
-	  y2.push_back(cat2->yy(j));
-	  z2.push_back(cat2->zz(j));
-	  r12.push_back(rr);
-	  w2.push_back(cat2->weight(j));
+	  double rr = cat1->distance(i, cat2->catalogue_object(j));
+	  if (r12_min<rr && rr<r12_max){
+	    x2.push_back(cat2->xx(j));
+	    y2.push_back(cat2->yy(j));
+	    z2.push_back(cat2->zz(j));
+	    r12.push_back(rr);
+	    w2.push_back(cat2->weight(j));
+	  }
 	}
-      }
 
-      for (auto &&k : close_objects13) { // loop on the objects at r13
-	double rr = cat1->distance(i, cat3->catalogue_object(k));
-	if (r13_min<rr && rr<r13_max){ 
-	  x3.push_back(cat3->xx(k));
-	  y3.push_back(cat3->yy(k));
-	  z3.push_back(cat3->zz(k));
-	  r13.push_back(rr);
-	  w3.push_back(cat3->weight(k));
+	for (auto &&k : close_objects_r13) { // loop on the objects at r13
+	  double rr = cat1->distance(i, cat3->catalogue_object(k));
+	  if (r13_min<rr && rr<r13_max){ 
+	    x3.push_back(cat3->xx(k));
+	    y3.push_back(cat3->yy(k));
+	    z3.push_back(cat3->zz(k));
+	    r13.push_back(rr);
+	    w3.push_back(cat3->weight(k));
+	  }
 	}
-      }
 
-      for (size_t j=0; j<r12.size(); j++)
-	for (size_t k=0; k<r13.size(); k++){
-	  double r23 = sqrt( pow(x2[j]-x3[k],2)+pow(y2[j]-y3[k],2)+pow(z2[j]-z3[k],2));
-	  double ww = cat1->weight(i)*w2[j]*w3[k];
-	  tt_thread->put(r12[j], r13[k], r23, ww);
-	}
+	for (size_t j=0; j<r12.size(); j++)
+	  for (size_t k=0; k<r13.size(); k++){
+	    double r23 = sqrt( pow(x2[j]-x3[k],2)+pow(y2[j]-y3[k],2)+pow(z2[j]-z3[k],2));
+	    double ww = cat1->weight(i)*w2[j]*w3[k];
+	    tt_thread->put(r12[j], r13[k], r23, ww);
+	  }
+      }
 
-      time_t end_temp; time (&end_temp); double diff_temp = difftime(end_temp, start);
-      if (tcount && tid==0) { coutCBL <<"\r..."<<float(i)*fact_count<<"% completed  ("<<diff_temp/60<<" minutes)\r"; cout.flush(); }
-      if (i==int(nObj*0.25)) coutCBL <<".....25% completed"<<endl;
-      if (i==int(nObj*0.5)) coutCBL <<".....50% completed"<<endl;
-      if (i==int(nObj*0.75)) coutCBL <<".....75% completed"<<endl;
+      // update the time count
+      progress.update(cost[n], tid);
     }
     
-#pragma omp critical
-    {
-      // sum all the object triplets computed by each thread
-      tt->Sum(tt_thread);
-    }
+    // sum all the object triplets computed by each thread
+    tt_threads[tid] = move(tt_thread);
+    tree_reduction<shared_ptr<Triplet>>(tt_threads, [] (shared_ptr<Triplet> &tt1, shared_ptr<Triplet> &tt2) { tt1->Sum(tt2); });
+
+#pragma omp master
+    tt->Sum(tt_threads[0]);
     
   }
 
@@ -200,19 +274,42 @@ void cbl::measure::threept::ThreePointCorrelation::count_allTriplets (const std:
   double cell_size2 = max(5., rMAX2*0.1);
 
   ChainMesh_Catalogue ChainMesh_data_rMAX1, ChainMesh_data_rMAX2, ChainMesh_random_rMAX1, ChainMesh_random_rMAX2;
+  KDTree_Catalogue tree_data_rMAX1, tree_data_rMAX2, tree_random_rMAX1, tree_random_rMAX2;
+
+  const bool kdTree = (m_spatialIndex==SpatialIndex::_kdTree_);
 
+  // the kd-trees do not reorder the catalogues, so they can share them
+  
   if (count_ddd || count_ddr || count_drr) {
-    auto data_rMAX1 = make_shared<catalogue::Catalogue>(*m_data);
-    auto data_rMAX2 = make_shared<catalogue::Catalogue>(*m_data);
-    ChainMesh_data_rMAX1.set_par(cell_size1, data_rMAX1, rMAX1);
-    ChainMesh_data_rMAX2.set_par(cell_size2, data_rMAX2, rMAX2);
+    if (kdTree) {
+      tree_data_rMAX1.set_par(m_data, rMAX1);
+      tree_data_rMAX2.set_par(m_data, rMAX2);
+    }
+    else {
+      auto data_rMAX1 = make_shared<catalogue::Catalogue>(*m_data);
+      auto data_rMAX2 = make_shared<catalogue::Catalogue>(*m_data);
+      ChainMesh_data_rMAX1.set_par(cell_size1, data_rMAX1, rMAX1);
+      ChainMesh_data_rMAX2.set_par(cell_size2, data_rMAX2, rMAX2);
+    }
   }
   if (count_rrr || count_ddr || count_drr) {
-    auto random_rMAX1 = make_shared<catalogue::Catalogue>(*m_random);
-    auto random_rMAX2 = make_shared<catalogue::Catalogue>(*m_random);
-    ChainMesh_random_rMAX1.set_par(cell_size1, random_rMAX1, rMAX1);
-    ChainMesh_random_rMAX2.set_par(cell_size2, random_rMAX2, rMAX2);
+    if (kdTree) {
+      tree_random_rMAX1.set_par(m_random, rMAX1);
+      tree_random_rMAX2.set_par(m_random, rMAX2);
+    }
+    else {
+      auto random_rMAX1 = make_shared<catalogue::Catalogue>(*m_random);
+      auto random_rMAX2 = make_shared<catalogue::Catalogue>(*m_random);
+      ChainMesh_random_rMAX1.set_par(cell_size1, random_rMAX1, rMAX1);
+      ChainMesh_random_rMAX2.set_par(cell_size2, random_rMAX2, rMAX2);
+    }
   }
+
+  // count the triplets using either the chain-meshes or the kd-trees
+  auto count = [&] (const shared_ptr<Catalogue> cat1, const bool data1, const bool data2, shared_ptr<Triplet> tt) {
+    if (kdTree) count_triplets(cat1, (data1) ? tree_data_rMAX1 : tree_random_rMAX1, (data2) ? tree_data_rMAX2 : tree_random_rMAX2, tt, tcount);
+    else count_triplets(cat1, (data1) ? ChainMesh_data_rMAX1 : ChainMesh_random_rMAX1, (data2) ? ChainMesh_data_rMAX2 : ChainMesh_random_rMAX2, tt, tcount);
+  };
   
   // ----------- count the number of triplets ----------- 
 
@@ -223,7 +320,7 @@ void cbl::measure::threept::ThreePointCorrelation::count_allTriplets (const std:
   file = "ddd.dat";
   
   if (count_ddd) { 
-    count_triplets(m_data, ChainMesh_data_rMAX1, ChainMesh_data_rMAX2, m_ddd, tcount);
+    count(m_data, true, true, m_ddd);
     if (dir_output_triplets!=par::defaultString) write_triplets(m_ddd, dir_output_triplets, file);
   } 
   else read_triplets (m_ddd, dir_input_triplets, file);
@@ -234,7 +331,7 @@ void cbl::measure::threept::ThreePointCorrelation::count_allTriplets (const std:
   file = "rrr.dat";
   
   if (count_rrr==1) {
-    count_triplets(m_random, ChainMesh_random_rMAX1, ChainMesh_random_rMAX2, m_rrr, tcount);
+    count(m_random, false, false, m_rrr);
     if (dir_output_triplets!=par::defaultString) write_triplets(m_rrr, dir_output_triplets, file);
   } 
   else if (count_rrr==0) read_triplets (m_rrr, dir_input_triplets, file);
@@ -250,9 +347,9 @@ void cbl::measure::threept::ThreePointCorrelation::count_allTriplets (const std:
     shared_ptr<Triplet> ddr2 = move(Triplet::Create(m_ddr->tripletType(), m_ddr->r12(), m_ddr->r12_binSize(), m_ddr->r13(), m_ddr->r13_binSize(), m_ddr->nbins()));
     shared_ptr<Triplet> ddr3 = move(Triplet::Create(m_ddr->tripletType(), m_ddr->r12(), m_ddr->r12_binSize(), m_ddr->r13(), m_ddr->r13_binSize(), m_ddr->nbins()));
 
-    count_triplets(m_data, ChainMesh_data_rMAX1, ChainMesh_random_rMAX2, ddr1, tcount);
-    count_triplets(m_data, ChainMesh_random_rMAX1, ChainMesh_data_rMAX2, ddr2, tcount);
-    count_triplets(m_random, ChainMesh_data_rMAX1, ChainMesh_data_rMAX2, ddr3, tcount);
+    count(m_data, true, false, ddr1);
+    count(m_data, false, true, ddr2);
+    count(m_random, true, true, ddr3);
 
     m_ddr->Sum(ddr1); m_ddr->Sum(ddr2); m_ddr->Sum(ddr3); 
    
@@ -272,9 +369,9 @@ void cbl::measure::threept::ThreePointCorrelation::count_allTriplets (const std:
     shared_ptr<Triplet> drr2 = move(Triplet::Create(m_drr->tripletType(), m_drr->r12(), m_drr->r12_binSize(), m_drr->r13(), m_drr->r13_binSize(), m_drr->nbins()));
     shared_ptr<Triplet> drr3 = move(Triplet::Create(m_drr->tripletType(), m_drr->r12(), m_drr->r12_binSize(), m_drr->r13(), m_drr->r13_binSize(), m_drr->nbins()));
     
-    count_triplets(m_random, ChainMesh_random_rMAX1, ChainMesh_data_rMAX2, drr1, tcount);
-    count_triplets(m_random, ChainMesh_data_rMAX1, ChainMesh_random_rMAX2, drr2, tcount);
-    count_triplets(m_data, ChainMesh_random_rMAX1, ChainMesh_random_rMAX2, drr3, tcount);
+    count(m_random, false, true, drr1);
+    count(m_random, true, false, drr2);
+    count(m_data, false, false, drr3);
 
     m_drr->Sum(drr1); m_drr->Sum(drr2); m_drr->Sum(drr3);
     
@@ -293,12 +390,6 @@ void cbl::measure::threept::ThreePointCorrelation::count_triplets_region (const
 {
   time_t start; time (&start);
   
-  int nObj = cat1->nObjects();
-
-  float fact_count = 100./nObj;
-  
-  cout.setf(ios::fixed); cout.setf(ios::showpoint); cout.precision(2);
-
   shared_ptr<Catalogue> cat2 = ChainMesh_rMAX1.catalogue();
   shared_ptr<Catalogue> cat3 = ChainMesh_rMAX2.catalogue();
 
@@ -307,87 +398,109 @@ void cbl::measure::threept::ThreePointCorrelation::count_triplets_region (const
   double r13_min = tt->r13()-0.5*tt->r13_binSize();
   double r13_max = tt->r13()+0.5*tt->r13_binSize();
 
+  // the objects of the first catalogue, grouped in cells sorted by decreasing cost
+  vector<double> cost;
+  const vector<vector<long>> cells = cost_ordered_cells(cat1, max(r12_max, r13_max), cost);
+  const int nCells = cells.size();
+  
+  // progress of the count, weighted by the cost of the cells
+  ProgressReporter progress(accumulate(cost.begin(), cost.end(), 0.), tcount, true, ".....");
+  
+  cout.setf(ios::fixed); cout.setf(ios::showpoint); cout.precision(2);
+
   int tid = 0;
+  
 #pragma omp parallel private(tid)
   {
     tid = omp_get_thread_num();
     
     // if (tid == 0) coutCBL << "Number of threads = " << omp_get_num_threads() << endl;
 
-    // internal object used by each thread to handle triplets
-    shared_ptr<Triplet> tt_thread = move(Triplet::Create(tt->tripletType(), tt->r12(), tt->r12_binSize(), tt->r13(), tt->r13_binSize(), tt->nbins()));
-    vector<shared_ptr<Triplet> > tt_region_thread(tt_region.size());
-
-    for (size_t i=0; i<tt_region.size(); ++i) 
-      tt_region_thread[i] = move(Triplet::Create(tt->tripletType(), tt->r12(), tt->r12_binSize(), tt->r13(), tt->r13_binSize() , tt->nbins()));
+    // the triplets of the cell handled by the thread, stored only for the (few) combinations of
+    // regions found in the cell: the scratch memory of each thread does not depend on the number
+    // of Jackknife/Bootstrap samples
+    vector<vector<long>> regions;
+    vector<shared_ptr<Triplet>> tt_regions;
 
-#pragma omp for schedule(static, 2)  
-    for (int i=0; i<nObj; i++) { // loop on the objects of the catalogue
+    // parallelized loop: the most expensive cells are handled first, as in count_triplets; the
+    // triplets of each cell are added to the shared triplets in the order of the cells, so that the
+    // result does not depend on the number of threads
+#pragma omp for schedule(dynamic) ordered
+    for (int n=0; n<nCells; ++n) {
+      for (auto &&i : cells[n]) { // loop on the objects of the cell
 
-      int reg1 = cat1->region(i);
+	int reg1 = cat1->region(i);
     
-      // get the indexes of the objects at r12
-      vector<long> close_objects12 = ChainMesh_rMAX1.close_objects(cat1->coordinate(i), -1);
+	// get the indexes of the objects at r12
+	vector<long> close_objects12 = ChainMesh_rMAX1.close_objects(cat1->coordinate(i), -1);
 
-      // get the indexes of objects at r13
-      vector<long> close_objects13 = ChainMesh_rMAX2.close_objects(cat1->coordinate(i), -1);
+	// get the indexes of objects at r13
+	vector<long> close_objects13 = ChainMesh_rMAX2.close_objects(cat1->coordinate(i), -1);
 
-      vector<double> x2, y2, z2, r12, w2, x3, y3, z3, r13, w3;
-      vector<long> reg2, reg3;
+	vector<double> x2, y2, z2, r12, w2, x3, y3, z3, r13, w3;
+	vector<long> reg2, reg3;
 
-      for (auto &&j : close_objects12) { // loop on the objects at r12 
-	double rr = cat1->distance(i, cat2->catalogue_object(j));
+	for (auto &&j : close_objects12) { // loop on the objects at r12 
+	  double rr = cat1->distance(i, cat2->catalogue_object(j));
 
-	if (r12_min<rr && rr<r12_max) {
-	  x2.push_back(cat2->xx(j));
-	  y2.push_back(cat2->yy(j));
-	  z2.push_back(cat2->zz(j));
-	  r12.push_back(rr);
-	  w2.push_back(cat2->weight(j));
-	  reg2.push_back(cat2->region(j));
+	  if (r12_min<rr && rr<r12_max) {
+	    x2.push_back(cat2->xx(j));
+	    y2.push_back(cat2->yy(j));
+	    z2.push_back(cat2->zz(j));
+	    r12.push_back(rr);
+	    w2.push_back(cat2->weight(j));
+	    reg2.push_back(cat2->region(j));
+	  }
 	}
-      }
 
-      for (auto &&k : close_objects13) { // loop on the objects at r12 
-	double rr = cat1->distance(i, cat3->catalogue_object(k));
+	for (auto &&k : close_objects13) { // loop on the objects at r12 
+	  double rr = cat1->distance(i, cat3->catalogue_object(k));
 
-	if (r13_min<rr && rr<r13_max) {
-	  x3.push_back(cat3->xx(k));
-	  y3.push_back(cat3->yy(k));
-	  z3.push_back(cat3->zz(k));
-	  r13.push_back(rr);
-	  w3.push_back(cat3->weight(k));
-	  reg3.push_back(cat3->region(k));
+	  if (r13_min<rr && rr<r13_max) {
+	    x3.push_back(cat3->xx(k));
+	    y3.push_back(cat3->yy(k));
+	    z3.push_back(cat3->zz(k));
+	    r13.push_back(rr);
+	    w3.push_back(cat3->weight(k));
+	    reg3.push_back(cat3->region(k));
+	  }
 	}
-      }
 
-      for (size_t j=0; j<r12.size(); j++)
-	for (size_t k=0; k<r13.size(); k++){
-	  int klin;
-	  double r23 = sqrt( pow(x2[j]-x3[k],2)+pow(y2[j]-y3[k],2)+pow(z2[j]-z3[k],2));
-	  double ww = cat1->weight(i)*w2[j]*w3[k];
-	  tt_thread->get_triplet(r12[j], r13[k], r23, klin);
-	  tt_thread->set_triplet(klin, ww);
-	  for (size_t r=0; r<weight.size(); r++) {
-	    double region_weight = weight[r][reg1]*weight[r][reg2[j]]*weight[r][reg3[k]];
-	    tt_region_thread[r]->set_triplet(klin, ww*region_weight);
+	for (size_t j=0; j<r12.size(); j++)
+	  for (size_t k=0; k<r13.size(); k++){
+	    const vector<long> reg = {reg1, reg2[j], reg3[k]};
+	    const auto it = find(regions.begin(), regions.end(), reg);
+	    shared_ptr<Triplet> tt_reg;
+	    if (it!=regions.end()) tt_reg = tt_regions[it-regions.begin()];
+	    else {
+	      tt_reg = move(Triplet::Create(tt->tripletType(), tt->r12(), tt->r12_binSize(), tt->r13(), tt->r13_binSize(), tt->nbins()));
+	      regions.emplace_back(reg);
+	      tt_regions.emplace_back(tt_reg);
+	    }
+	    
+	    int klin;
+	    double r23 = sqrt( pow(x2[j]-x3[k],2)+pow(y2[j]-y3[k],2)+pow(z2[j]-z3[k],2));
+	    double ww = cat1->weight(i)*w2[j]*w3[k];
+	    tt_reg->get_triplet(r12[j], r13[k], r23, klin);
+	    tt_reg->set_triplet(klin, ww);
 	  }
-	}
-      time_t end_temp; time (&end_temp); double diff_temp = difftime(end_temp, start);
-      if (tcount && tid==0) { coutCBL <<"\r..."<<float(i)*fact_count<<"% completed  ("<<diff_temp/60<<" minutes)\r"; cout.flush(); }
-      if (i==int(nObj*0.25)) coutCBL <<".....25% completed"<<endl;
-      if (i==int(nObj*0.5)) coutCBL <<".....50% completed"<<endl;
-      if (i==int(nObj*0.75)) coutCBL <<".....75% completed"<<endl;
-    }
-    
-#pragma omp critical
-    {
-      // sum all the object triplets computed by each thread
-      tt->Sum(tt_thread);
+      }
 
-      for (size_t k=0; k< weight.size(); k++)
-	tt_region[k]->Sum(tt_region_thread[k]);
+      // add the triplets of the cell to the shared triplets, weighted by the region weights of each
+      // Jackknife/Bootstrap sample
+#pragma omp ordered
+      {
+	for (size_t n=0; n<regions.size(); ++n) {
+	  tt->Sum(tt_regions[n]);
+	  for (size_t r=0; r<weight.size(); r++) 
+	    tt_region[r]->Sum(tt_regions[n], weight[r][regions[n][0]]*weight[r][regions[n][1]]*weight[r][regions[n][2]]);
+	}
+      }
+      regions.clear();
+      tt_regions.clear();
 
+      // update the time count
+      progress.update(cost[n], tid);
     }
     
   }
@@ -298,4 +298,282 @@ shared_ptr<Pair> cbl::pairs::Pair::Create (const cbl::pairs::PairType type, cons
 }
 
 
+// ============================================================================================
+
+
+std::vector<Var> cbl::pairs::Pair::variables () const
+{
+  vector<Var> var;
+
+  if (m_pairType==PairType::_comovingCartesian_linlin_ || m_pairType==PairType::_comovingCartesian_linlog_ || m_pairType==PairType::_comovingCartesian_loglin_ || m_pairType==PairType::_comovingCartesian_loglog_) {
+    var.push_back(Var::_RA_);
+    var.push_back(Var::_Dec_);
+  }
+
+  if (m_pairInfo==PairInfo::_extra_)
+    var.push_back(Var::_Redshift_);
+
+  if ((m_pairType!=PairType::_angular_lin_ && m_pairType!=PairType::_angular_log_ && m_pairType!=PairType::_comoving_lin_ && m_pairType!=PairType::_comoving_log_) || ((m_pairType==PairType::_comoving_lin_ || m_pairType==PairType::_comoving_log_) && m_angularWeight!=nullptr))
+    var.push_back(Var::_Dc_);
+
+  return var;
+}
+
+
+// ============================================================================================
+
+
+long cbl::pairs::Pair::m_close_objects_Euclidean (const chainmesh::CellObjects &obj1, const long i, const chainmesh::CellObjects &obj2, const long j_min, const long j_max, const double rMin, const double rMax)
+{
+  const long nObj = j_max-j_min;
+  if (nObj<1) return 0;
+  
+  if ((long)m_dist2.size()<nObj) { m_dist2.resize(nObj); m_close.resize(nObj); }
+
+  const double x1 = obj1.xx[i], y1 = obj1.yy[i], z1 = obj1.zz[i];
+  const double *xx = obj2.xx.data()+j_min, *yy = obj2.yy.data()+j_min, *zz = obj2.zz.data()+j_min;
+  double *dist2 = m_dist2.data();
+  
+#pragma omp simd
+  for (long j=0; j<nObj; ++j) 
+    dist2[j] = (x1-xx[j])*(x1-xx[j])+(y1-yy[j])*(y1-yy[j])+(z1-zz[j])*(z1-zz[j]);
+
+  // the range is slightly enlarged, so that the selection is never more restrictive than the exact check done on the separations
+  const double r2Min = rMin*rMin*(1.-1.e-10), r2Max = rMax*rMax*(1.+1.e-10);
+  
+  long nClose = 0;
+  for (long j=0; j<nObj; ++j) {
+    const double d2 = dist2[j];
+    m_close[nClose] = j_min+j;
+    dist2[nClose] = d2;
+    nClose += (r2Min<d2 && d2<r2Max);
+  }
+  
+  return nClose;
+}
+
+
+// ============================================================================================
+
+
+long cbl::pairs::Pair::m_close_objects_angular (const chainmesh::CellObjects &obj1, const long i, const chainmesh::CellObjects &obj2, const long j_min, const long j_max, const double thetaMin, const double thetaMax)
+{
+  // chord length between two points of the unit sphere at the given angular separation
+  const double theta_min = min(converted_angle(thetaMin, m_angularUnits, CoordinateUnits::_radians_), par::pi);
+  const double theta_max = converted_angle(thetaMax, m_angularUnits, CoordinateUnits::_radians_);
+  
+  const double chordMin = 2.*sin(0.5*theta_min);
+  const double chordMax = (theta_max<par::pi) ? 2.*sin(0.5*theta_max) : 2.*(1.+1.e-5);
+
+  return m_close_objects_Euclidean(obj1, i, obj2, j_min, j_max, chordMin, chordMax);
+}
+
+
+// ============================================================================================
+
+
+long cbl::pairs::Pair::m_close_objects_lineOfSight (const chainmesh::CellObjects &obj1, const long i, const chainmesh::CellObjects &obj2, const long j_min, const long j_max, const double piMin, const double piMax)
+{
+  const long nObj = j_max-j_min;
+  if (nObj<1) return 0;
+  
+  if ((long)m_dist2.size()<nObj) { m_dist2.resize(nObj); m_close.resize(nObj); }
+
+  const double dc1 = obj1.dc[i];
+  const double *dc = obj2.dc.data()+j_min;
+  double *dist2 = m_dist2.data();
+  
+#pragma omp simd
+  for (long j=0; j<nObj; ++j) 
+    dist2[j] = fabs(dc1-dc[j]);
+
+  long nClose = 0;
+  for (long j=0; j<nObj; ++j) {
+    const double pi = dist2[j];
+    m_close[nClose] = j_min+j;
+    dist2[nClose] = pi;
+    nClose += (piMin<pi && pi<piMax);
+  }
+  
+  return nClose;
+}
+
+
+// ============================================================================================
+
+
+void cbl::pairs::Pair::m_bin_close_objects (const long nClose, const double sMin, const double sMax, const double binSize_inv, const int nbins, const bool logBins, const bool angular)
+{
+  if ((long)m_dist.size()<nClose) { m_dist.resize(nClose); m_bin.resize(nClose); }
+
+  const double *dist2 = m_dist2.data();
+  double *dist = m_dist.data();
+  int *bin = m_bin.data();
+
+  // conversion factor from radians to the angular units
+  const double angle_factor = (angular && m_angularUnits!=CoordinateUnits::_radians_) ? converted_angle(1., CoordinateUnits::_radians_, m_angularUnits) : 1.;
+  const double sMin_bin = (logBins) ? log10(sMin) : sMin;
+  
+#pragma omp simd
+  for (long n=0; n<nClose; ++n) {
+    const double ss = (angular) ? angle_factor*2.*asin(0.5*sqrt(dist2[n])) : sqrt(dist2[n]);
+    const double ss_bin = (logBins) ? log10(ss) : ss;
+    dist[n] = ss;
+    bin[n] = (sMin<ss && ss<sMax) ? int(std::min(std::max((ss_bin-sMin_bin)*binSize_inv, 0.), double(nbins))) : -1;
+  }
+}
+
+
+// ============================================================================================
+
+
+void cbl::pairs::Pair::m_polar_close_objects (const long nClose, const chainmesh::CellObjects &obj1, const long i, const chainmesh::CellObjects &obj2)
+{
+  if ((long)m_dist.size()<nClose) { m_dist.resize(nClose); m_bin.resize(nClose); }
+  if ((long)m_dist_D2.size()<nClose) { m_dist_D2.resize(nClose); m_bin_D2.resize(nClose); }
+
+  const double dc1 = obj1.dc[i];
+  const double *dc = obj2.dc.data(), *dist2 = m_dist2.data();
+  const long *close = m_close.data();
+  double *dist = m_dist.data(), *mu = m_dist_D2.data();
+
+#pragma omp simd
+  for (long n=0; n<nClose; ++n) {
+    dist[n] = sqrt(dist2[n]);
+    mu[n] = fabs(dc1-dc[close[n]])/dist[n];
+  }
+}
+
+
+// ============================================================================================
+
+
+void cbl::pairs::Pair::m_Cartesian_close_objects (const long nClose, const chainmesh::CellObjects &obj1, const long i, const chainmesh::CellObjects &obj2)
+{
+  if ((long)m_dist.size()<nClose) { m_dist.resize(nClose); m_bin.resize(nClose); }
+  if ((long)m_dist_D2.size()<nClose) { m_dist_D2.resize(nClose); m_bin_D2.resize(nClose); }
+
+  // the perpendicular separations are computed with scalar calls, the line-of-sight ones are those
+  // computed by m_close_objects_lineOfSight
+  for (long n=0; n<nClose; ++n) {
+    const long j = m_close[n];
+    m_dist[n] = perpendicular_distance(obj1.ra[i], obj2.ra[j], obj1.dec[i], obj2.dec[j], obj1.dc[i], obj2.dc[j]);
+    m_dist_D2[n] = m_dist2[n];
+  }
+}
+
+
+// ============================================================================================
+
+
+void cbl::pairs::Pair::m_bin_close_objects_2D (const long nClose, const double sMin_D1, const double sMax_D1, const double binSize_inv_D1, const int nbins_D1, const bool logBins_D1, const double sMin_D2, const double sMax_D2, const double binSize_inv_D2, const int nbins_D2, const bool logBins_D2)
+{
+  const double *dist = m_dist.data(), *dist_D2 = m_dist_D2.data();
+  int *bin = m_bin.data(), *bin_D2 = m_bin_D2.data();
+
+  const double sMin_bin_D1 = (logBins_D1) ? log10(sMin_D1) : sMin_D1;
+  const double sMin_bin_D2 = (logBins_D2) ? log10(sMin_D2) : sMin_D2;
+
+#pragma omp simd
+  for (long n=0; n<nClose; ++n) {
+    const double s1 = dist[n], s2 = dist_D2[n];
+    const double s1_bin = (logBins_D1) ? log10(s1) : s1;
+    const double s2_bin = (logBins_D2) ? log10(s2) : s2;
+    const bool inside = (sMin_D1<s1 && s1<sMax_D1 && sMin_D2<s2 && s2<sMax_D2);
+    bin[n] = (inside) ? int(std::min(std::max((s1_bin-sMin_bin_D1)*binSize_inv_D1, 0.), double(nbins_D1))) : -1;
+    bin_D2[n] = (inside) ? int(std::min(std::max((s2_bin-sMin_bin_D2)*binSize_inv_D2, 0.), double(nbins_D2))) : -1;
+  }
+}
+
+
+// ============================================================================================
+
+
+void cbl::pairs::Pair::m_blocks_weight (const chainmesh::CellObjects &obj1, const long i_min, const long i_max, const chainmesh::CellObjects &obj2, const long j_min, const long j_max, const bool auto_pairs, double &nPairs, ExactSum &weight) const
+{
+  nPairs = (auto_pairs) ? 0.5*double(i_max-i_min)*double(i_max-i_min-1) : double(i_max-i_min)*double(j_max-j_min);
+
+  bool unit_weights = true;
+  for (long i=i_min; i<i_max && unit_weights; ++i) unit_weights = (obj1.weight[i]==1.);
+  for (long j=j_min; j<j_max && unit_weights; ++j) unit_weights = (obj2.weight[j]==1.);
 
+  if (unit_weights) { weight = nPairs; return; }
+
+  // the products of the weights are summed pair by pair, as done by
+  // the pair-counting kernels, so that the weighted counts do not
+  // depend on whether the pairs are counted by blocks or one by one
+  weight = 0.;
+  for (long i=i_min; i<i_max; ++i)
+    for (long j=(auto_pairs) ? i+1 : j_min; j<j_max; ++j)
+      weight += obj1.weight[i]*obj2.weight[j];
+}
+
+
+
+// ============================================================================================
+
+
+std::vector<double> cbl::pairs::Pair::data () const
+{
+  const bool extra = (m_pairInfo==PairInfo::_extra_);
+
+  vector<double> data;
+
+  if (m_pairDim==Dim::_1D_) {
+    const size_t nbins = PP1D().size();
+    for (size_t i=0; i<nbins; ++i) {
+      const ExactSum pp = PP1D_exact(i), pp_weighted = PP1D_weighted_exact(i);
+      vector<double> data_bin = {pp.integer(), pp.fraction(), pp_weighted.integer(), pp_weighted.fraction()};
+      if (extra) data_bin.insert(data_bin.end(), {scale_mean(i), scale_S(i), z_mean(i), z_S(i)});
+      data.insert(data.end(), data_bin.begin(), data_bin.end());
+    }
+  }
+  
+  else {
+    const size_t nbins_D1 = PP2D().size(), nbins_D2 = (nbins_D1>0) ? PP2D()[0].size() : 0;
+    for (size_t i=0; i<nbins_D1; ++i)
+      for (size_t j=0; j<nbins_D2; ++j) {
+	const ExactSum pp = PP2D_exact(i, j), pp_weighted = PP2D_weighted_exact(i, j);
+	vector<double> data_bin = {pp.integer(), pp.fraction(), pp_weighted.integer(), pp_weighted.fraction()};
+	if (extra) data_bin.insert(data_bin.end(), {scale_D1_mean(i, j), scale_D1_S(i, j), scale_D2_mean(i, j), scale_D2_S(i, j), z_mean(i, j), z_S(i, j)});
+	data.insert(data.end(), data_bin.begin(), data_bin.end());
+      }
+  }
+
+  return data;
+}
+
+
+// ============================================================================================
+
+
+void cbl::pairs::Pair::add_data (const std::vector<double> data)
+{
+  const bool extra = (m_pairInfo==PairInfo::_extra_);
+
+  if (m_pairDim==Dim::_1D_) {
+    const size_t nData = (extra) ? 8 : 4, nbins = PP1D().size();
+    
+    if (data.size()!=nbins*nData)
+      ErrorCBL("Error in add_data() of Pair.cpp: dimension problems!");
+
+    for (size_t i=0; i<nbins; ++i) {
+      const auto data_bin = data.begin()+i*nData;
+      add_data1D(i, ExactSum(data_bin[0], data_bin[1]), ExactSum(data_bin[2], data_bin[3]), vector<double>(data_bin+4, data_bin+nData));
+    }
+  }
+
+  else {
+    const size_t nData = (extra) ? 10 : 4;
+    const size_t nbins_D1 = PP2D().size(), nbins_D2 = (nbins_D1>0) ? PP2D()[0].size() : 0;
+
+    if (data.size()!=nbins_D1*nbins_D2*nData)
+      ErrorCBL("Error in add_data() of Pair.cpp: dimension problems!");
+
+    for (size_t i=0; i<nbins_D1; ++i)
+      for (size_t j=0; j<nbins_D2; ++j) {
+	const auto data_bin = data.begin()+(i*nbins_D2+j)*nData;
+	add_data2D(i, j, ExactSum(data_bin[0], data_bin[1]), ExactSum(data_bin[2], data_bin[3]), vector<double>(data_bin+4, data_bin+nData));
+      }
+  }
+}
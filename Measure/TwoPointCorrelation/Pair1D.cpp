@@ -460,6 +460,33 @@ void cbl::pairs::Pair1D_angular_lin::put (const shared_ptr<Object> obj1, const s
 // ============================================================================================
 
 
+void cbl::pairs::Pair1D_angular_lin::put (const chainmesh::CellObjects &obj1, const long i_min, const long i_max, const chainmesh::CellObjects &obj2, const long j_min, const long j_max, const bool auto_pairs)
+{
+  for (long i=i_min; i<i_max; ++i) {
+
+    // select the objects of the second block close to the object i of the first block
+    const long nClose = m_close_objects_angular(obj1, i, obj2, (auto_pairs) ? max(j_min, i+1) : j_min, j_max, m_thetaMin, m_thetaMax);
+
+    // separations and bins of the selected objects
+    m_bin_close_objects(nClose, m_thetaMin, m_thetaMax, m_binSize_inv, m_nbins, false, true);
+
+    for (long n=0; n<nClose; ++n) {
+
+      const int kk = m_bin[n];
+      if (kk<0) continue;
+
+      const long j = m_close[n];
+
+      m_PP1D[kk] ++;
+      m_PP1D_weighted[kk] += obj1.weight[i]*obj2.weight[j];
+    }
+  }
+}
+
+
+// ============================================================================================
+
+
 void cbl::pairs::Pair1D_angular_log::put (const shared_ptr<Object> obj1, const shared_ptr<Object> obj2)
 {
   const double dist = (m_angularUnits==CoordinateUnits::_radians_) ? angular_distance(obj1->xx(), obj2->xx(), obj1->yy(), obj2->yy(), obj1->zz(), obj2->zz()) 
@@ -479,6 +506,33 @@ void cbl::pairs::Pair1D_angular_log::put (const shared_ptr<Object> obj1, const s
 // ============================================================================================
 
 
+void cbl::pairs::Pair1D_angular_log::put (const chainmesh::CellObjects &obj1, const long i_min, const long i_max, const chainmesh::CellObjects &obj2, const long j_min, const long j_max, const bool auto_pairs)
+{
+  for (long i=i_min; i<i_max; ++i) {
+
+    // select the objects of the second block close to the object i of the first block
+    const long nClose = m_close_objects_angular(obj1, i, obj2, (auto_pairs) ? max(j_min, i+1) : j_min, j_max, m_thetaMin, m_thetaMax);
+
+    // separations and bins of the selected objects
+    m_bin_close_objects(nClose, m_thetaMin, m_thetaMax, m_binSize_inv, m_nbins, true, true);
+
+    for (long n=0; n<nClose; ++n) {
+
+      const int kk = m_bin[n];
+      if (kk<0) continue;
+
+      const long j = m_close[n];
+
+      m_PP1D[kk] ++;
+      m_PP1D_weighted[kk] += obj1.weight[i]*obj2.weight[j];
+    }
+  }
+}
+
+
+// ============================================================================================
+
+
 void cbl::pairs::Pair1D_comoving_lin::put (const shared_ptr<Object> obj1, const shared_ptr<Object> obj2)
 {
   const double dist = Euclidean_distance(obj1->xx(), obj2->xx(), obj1->yy(), obj2->yy(), obj1->zz(), obj2->zz()); 
@@ -500,6 +554,36 @@ void cbl::pairs::Pair1D_comoving_lin::put (const shared_ptr<Object> obj1, const
 // ============================================================================================
 
 
+void cbl::pairs::Pair1D_comoving_lin::put (const chainmesh::CellObjects &obj1, const long i_min, const long i_max, const chainmesh::CellObjects &obj2, const long j_min, const long j_max, const bool auto_pairs)
+{
+  for (long i=i_min; i<i_max; ++i) {
+
+    // select the objects of the second block close to the object i of the first block
+    const long nClose = m_close_objects_Euclidean(obj1, i, obj2, (auto_pairs) ? max(j_min, i+1) : j_min, j_max, m_rMin, m_rMax);
+
+    // separations and bins of the selected objects
+    m_bin_close_objects(nClose, m_rMin, m_rMax, m_binSize_inv, m_nbins, false, false);
+
+    for (long n=0; n<nClose; ++n) {
+
+      const int kk = m_bin[n];
+      if (kk<0) continue;
+
+      const long j = m_close[n];
+
+      const double angWeight = (m_angularWeight==nullptr) ? 1.
+	: max(0., m_angularWeight(converted_angle(angular_distance(obj1.xx[i]/obj1.dc[i], obj2.xx[j]/obj2.dc[j], obj1.yy[i]/obj1.dc[i], obj2.yy[j]/obj2.dc[j], obj1.zz[i]/obj1.dc[i], obj2.zz[j]/obj2.dc[j]), CoordinateUnits::_radians_, m_angularUnits)));
+
+      m_PP1D[kk] ++;
+      m_PP1D_weighted[kk] += obj1.weight[i]*obj2.weight[j]*angWeight;
+    }
+  }
+}
+
+
+// ============================================================================================
+
+
 void cbl::pairs::Pair1D_comoving_log::put (const shared_ptr<Object> obj1, const shared_ptr<Object> obj2)
 {
   const double dist = Euclidean_distance(obj1->xx(), obj2->xx(), obj1->yy(), obj2->yy(), obj1->zz(), obj2->zz()); 
@@ -521,6 +605,36 @@ void cbl::pairs::Pair1D_comoving_log::put (const shared_ptr<Object> obj1, const
 // ============================================================================================
 
 
+void cbl::pairs::Pair1D_comoving_log::put (const chainmesh::CellObjects &obj1, const long i_min, const long i_max, const chainmesh::CellObjects &obj2, const long j_min, const long j_max, const bool auto_pairs)
+{
+  for (long i=i_min; i<i_max; ++i) {
+
+    // select the objects of the second block close to the object i of the first block
+    const long nClose = m_close_objects_Euclidean(obj1, i, obj2, (auto_pairs) ? max(j_min, i+1) : j_min, j_max, m_rMin, m_rMax);
+
+    // separations and bins of the selected objects
+    m_bin_close_objects(nClose, m_rMin, m_rMax, m_binSize_inv, m_nbins, true, false);
+
+    for (long n=0; n<nClose; ++n) {
+
+      const int kk = m_bin[n];
+      if (kk<0) continue;
+
+      const long j = m_close[n];
+
+      const double angWeight = (m_angularWeight==nullptr) ? 1.
+	: max(0., m_angularWeight(converted_angle(angular_distance(obj1.xx[i]/obj1.dc[i], obj2.xx[j]/obj2.dc[j], obj1.yy[i]/obj1.dc[i], obj2.yy[j]/obj2.dc[j], obj1.zz[i]/obj1.dc[i], obj2.zz[j]/obj2.dc[j]), CoordinateUnits::_radians_, m_angularUnits)));
+
+      m_PP1D[kk] ++;
+      m_PP1D_weighted[kk] += obj1.weight[i]*obj2.weight[j]*angWeight;
+    }
+  }
+}
+
+
+// ============================================================================================
+
+
 void cbl::pairs::Pair1D_comoving_multipoles_lin::put (const shared_ptr<Object> obj1, const shared_ptr<Object> obj2)
 {
   const double dist = Euclidean_distance(obj1->xx(), obj2->xx(), obj1->yy(), obj2->yy(), obj1->zz(), obj2->zz()); 
@@ -554,6 +668,48 @@ void cbl::pairs::Pair1D_comoving_multipoles_lin::put (const shared_ptr<Object> o
 // ============================================================================================
 
 
+void cbl::pairs::Pair1D_comoving_multipoles_lin::put (const chainmesh::CellObjects &obj1, const long i_min, const long i_max, const chainmesh::CellObjects &obj2, const long j_min, const long j_max, const bool auto_pairs)
+{
+  for (long i=i_min; i<i_max; ++i) {
+
+    // select the objects of the second block close to the object i of the first block
+    const long nClose = m_close_objects_Euclidean(obj1, i, obj2, (auto_pairs) ? max(j_min, i+1) : j_min, j_max, m_rMin, m_rMax);
+
+    // separations and bins of the selected objects
+    m_bin_close_objects(nClose, m_rMin, m_rMax, m_binSize_inv, m_nbins, false, false);
+
+    for (long n=0; n<nClose; ++n) {
+
+      const int kk = m_bin[n];
+      if (kk<0) continue;
+
+      const long j = m_close[n];
+      const double dist = m_dist[n];
+
+      const double angWeight = (m_angularWeight==nullptr) ? 1.
+	: max(0., m_angularWeight(converted_angle(angular_distance(obj1.xx[i]/obj1.dc[i], obj2.xx[j]/obj2.dc[j], obj1.yy[i]/obj1.dc[i], obj2.yy[j]/obj2.dc[j], obj1.zz[i]/obj1.dc[i], obj2.zz[j]/obj2.dc[j]), CoordinateUnits::_radians_, m_angularUnits)));
+
+      const double ww = obj1.weight[i]*obj2.weight[j]*angWeight;
+      double cosmu2 = pow((obj2.dc[j]-obj1.dc[i])/dist, 2);
+
+      m_PP1D[kk] += 1.;
+      m_PP1D_weighted[kk] += ww;
+
+      double leg_pol_2 = 0.5*(3.*cosmu2-1.);
+      m_PP1D[(m_nbins+1)+kk] += 5.*leg_pol_2 ;
+      m_PP1D_weighted[(m_nbins+1)+kk] += 5.*ww*leg_pol_2;
+
+      double leg_pol_4 = 0.125*(35.*cosmu2*cosmu2-30.*cosmu2+3.);
+      m_PP1D[2.*(m_nbins+1)+kk] += 9.*leg_pol_4;
+      m_PP1D_weighted[2.*(m_nbins+1)+kk] += 9.*ww*leg_pol_4;
+    }
+  }
+}
+
+
+// ============================================================================================
+
+
 void cbl::pairs::Pair1D_comoving_multipoles_log::put (const shared_ptr<Object> obj1, const shared_ptr<Object> obj2)
 {
   const double dist = Euclidean_distance(obj1->xx(), obj2->xx(), obj1->yy(), obj2->yy(), obj1->zz(), obj2->zz()); 
@@ -586,10 +742,179 @@ void cbl::pairs::Pair1D_comoving_multipoles_log::put (const shared_ptr<Object> o
 // ============================================================================================
 
 
+void cbl::pairs::Pair1D_comoving_multipoles_log::put (const chainmesh::CellObjects &obj1, const long i_min, const long i_max, const chainmesh::CellObjects &obj2, const long j_min, const long j_max, const bool auto_pairs)
+{
+  for (long i=i_min; i<i_max; ++i) {
+
+    // select the objects of the second block close to the object i of the first block
+    const long nClose = m_close_objects_Euclidean(obj1, i, obj2, (auto_pairs) ? max(j_min, i+1) : j_min, j_max, m_rMin, m_rMax);
+
+    // separations and bins of the selected objects
+    m_bin_close_objects(nClose, m_rMin, m_rMax, m_binSize_inv, m_nbins, true, false);
+
+    for (long n=0; n<nClose; ++n) {
+
+      const int kk = m_bin[n];
+      if (kk<0) continue;
+
+      const long j = m_close[n];
+      const double dist = m_dist[n];
+
+      const double angWeight = (m_angularWeight==nullptr) ? 1.
+	: max(0., m_angularWeight(converted_angle(angular_distance(obj1.xx[i]/obj1.dc[i], obj2.xx[j]/obj2.dc[j], obj1.yy[i]/obj1.dc[i], obj2.yy[j]/obj2.dc[j], obj1.zz[i]/obj1.dc[i], obj2.zz[j]/obj2.dc[j]), CoordinateUnits::_radians_, m_angularUnits)));
+
+      const double ww = obj1.weight[i]*obj2.weight[j]*angWeight;
+      double cosmu2 = pow((obj2.dc[j]-obj1.dc[i])/dist, 2);
+
+      m_PP1D[kk] += 1.;
+      m_PP1D_weighted[kk] += ww;
+
+      double leg_pol_2 = 0.5*(3.*cosmu2-1);
+      m_PP1D[(m_nbins+1)+kk] += 5.*leg_pol_2 ;
+      m_PP1D_weighted[(m_nbins+1)+kk] += 5.*ww*leg_pol_2;
+
+      double leg_pol_4 = 0.125*(35.*cosmu2*cosmu2-30.*cosmu2+3.);
+      m_PP1D[2.*(m_nbins+1)+kk] += 9.*leg_pol_4;
+      m_PP1D_weighted[2.*(m_nbins+1)+kk] += 9.*ww*leg_pol_4;
+    }
+  }
+}
+
+
+// ============================================================================================
+
+
+bool cbl::pairs::Pair1D_angular_lin::put_cells (const chainmesh::CellObjects &obj1, const long i_min, const long i_max, const chainmesh::CellObjects &obj2, const long j_min, const long j_max, const bool auto_pairs, const double dist_min, const double dist_max)
+{
+  // angular separations corresponding to the minimum and maximum chord lengths (slightly enlarged to account for round-off errors)
+  const double theta_min = 2.*asin(min(0.5*dist_min, 1.))*(1.-1.e-10);
+  const double theta_max = 2.*asin(min(0.5*dist_max, 1.))*(1.+1.e-10);
+  const double sep_min = (m_angularUnits==CoordinateUnits::_radians_) ? theta_min : converted_angle(theta_min, CoordinateUnits::_radians_, m_angularUnits);
+  const double sep_max = (m_angularUnits==CoordinateUnits::_radians_) ? theta_max : converted_angle(theta_max, CoordinateUnits::_radians_, m_angularUnits);
+
+  // all the pairs are outside the binning range
+  if (sep_min>=m_thetaMax || sep_max<=m_thetaMin) return true;
+
+  // all the pairs are inside a single bin
+  if (m_pairInfo==PairInfo::_standard_ && m_thetaMin<sep_min && sep_max<m_thetaMax) {
+    const int kk = max(0, min(int((sep_min-m_thetaMin)*m_binSize_inv), m_nbins));
+    if (kk==max(0, min(int((sep_max-m_thetaMin)*m_binSize_inv), m_nbins))) {
+      double nPairs; ExactSum weight;
+      m_blocks_weight(obj1, i_min, i_max, obj2, j_min, j_max, auto_pairs, nPairs, weight);
+      m_PP1D[kk] += nPairs;
+      m_PP1D_weighted[kk] += weight;
+      return true;
+    }
+  }
+
+  return false;
+}
+
+
+// ============================================================================================
+
+
+bool cbl::pairs::Pair1D_angular_log::put_cells (const chainmesh::CellObjects &obj1, const long i_min, const long i_max, const chainmesh::CellObjects &obj2, const long j_min, const long j_max, const bool auto_pairs, const double dist_min, const double dist_max)
+{
+  // angular separations corresponding to the minimum and maximum chord lengths (slightly enlarged to account for round-off errors)
+  const double theta_min = 2.*asin(min(0.5*dist_min, 1.))*(1.-1.e-10);
+  const double theta_max = 2.*asin(min(0.5*dist_max, 1.))*(1.+1.e-10);
+  const double sep_min = (m_angularUnits==CoordinateUnits::_radians_) ? theta_min : converted_angle(theta_min, CoordinateUnits::_radians_, m_angularUnits);
+  const double sep_max = (m_angularUnits==CoordinateUnits::_radians_) ? theta_max : converted_angle(theta_max, CoordinateUnits::_radians_, m_angularUnits);
+
+  // all the pairs are outside the binning range
+  if (sep_min>=m_thetaMax || sep_max<=m_thetaMin) return true;
+
+  // all the pairs are inside a single bin
+  if (m_pairInfo==PairInfo::_standard_ && m_thetaMin<sep_min && sep_max<m_thetaMax) {
+    const int kk = max(0, min(int((log10(sep_min)-log10(m_thetaMin))*m_binSize_inv), m_nbins));
+    if (kk==max(0, min(int((log10(sep_max)-log10(m_thetaMin))*m_binSize_inv), m_nbins))) {
+      double nPairs; ExactSum weight;
+      m_blocks_weight(obj1, i_min, i_max, obj2, j_min, j_max, auto_pairs, nPairs, weight);
+      m_PP1D[kk] += nPairs;
+      m_PP1D_weighted[kk] += weight;
+      return true;
+    }
+  }
+
+  return false;
+}
+
+
+// ============================================================================================
+
+
+bool cbl::pairs::Pair1D_comoving_lin::put_cells (const chainmesh::CellObjects &obj1, const long i_min, const long i_max, const chainmesh::CellObjects &obj2, const long j_min, const long j_max, const bool auto_pairs, const double dist_min, const double dist_max)
+{
+  // minimum and maximum separations (slightly enlarged to account for round-off errors)
+  const double sep_min = dist_min*(1.-1.e-10);
+  const double sep_max = dist_max*(1.+1.e-10);
+
+  // all the pairs are outside the binning range
+  if (sep_min>=m_rMax || sep_max<=m_rMin) return true;
+
+  // all the pairs are inside a single bin (the angular weight depends on the single pairs)
+  if (m_pairInfo==PairInfo::_standard_ && m_angularWeight==nullptr && m_rMin<sep_min && sep_max<m_rMax) {
+    const int kk = max(0, min(int((sep_min-m_rMin)*m_binSize_inv), m_nbins));
+    if (kk==max(0, min(int((sep_max-m_rMin)*m_binSize_inv), m_nbins))) {
+      double nPairs; ExactSum weight;
+      m_blocks_weight(obj1, i_min, i_max, obj2, j_min, j_max, auto_pairs, nPairs, weight);
+      m_PP1D[kk] += nPairs;
+      m_PP1D_weighted[kk] += weight;
+      return true;
+    }
+  }
+
+  return false;
+}
+
+
+// ============================================================================================
+
+
+bool cbl::pairs::Pair1D_comoving_log::put_cells (const chainmesh::CellObjects &obj1, const long i_min, const long i_max, const chainmesh::CellObjects &obj2, const long j_min, const long j_max, const bool auto_pairs, const double dist_min, const double dist_max)
+{
+  // minimum and maximum separations (slightly enlarged to account for round-off errors)
+  const double sep_min = dist_min*(1.-1.e-10);
+  const double sep_max = dist_max*(1.+1.e-10);
+
+  // all the pairs are outside the binning range
+  if (sep_min>=m_rMax || sep_max<=m_rMin) return true;
+
+  // all the pairs are inside a single bin (the angular weight depends on the single pairs)
+  if (m_pairInfo==PairInfo::_standard_ && m_angularWeight==nullptr && m_rMin<sep_min && sep_max<m_rMax) {
+    const int kk = max(0, min(int((log10(sep_min)-log10(m_rMin))*m_binSize_inv), m_nbins));
+    if (kk==max(0, min(int((log10(sep_max)-log10(m_rMin))*m_binSize_inv), m_nbins))) {
+      double nPairs; ExactSum weight;
+      m_blocks_weight(obj1, i_min, i_max, obj2, j_min, j_max, auto_pairs, nPairs, weight);
+      m_PP1D[kk] += nPairs;
+      m_PP1D_weighted[kk] += weight;
+      return true;
+    }
+  }
+
+  return false;
+}
+
+
+// ============================================================================================
+
+
+bool cbl::pairs::Pair1D_comoving_multipoles::put_cells (const chainmesh::CellObjects &obj1, const long i_min, const long i_max, const chainmesh::CellObjects &obj2, const long j_min, const long j_max, const bool auto_pairs, const double dist_min, const double dist_max)
+{
+  (void)obj1; (void)i_min; (void)i_max; (void)obj2; (void)j_min; (void)j_max; (void)auto_pairs;
+
+  // all the pairs are outside the binning range (the separations are slightly enlarged to account for round-off errors)
+  return (dist_min*(1.-1.e-10)>=m_rMax || dist_max*(1.+1.e-10)<=m_rMin);
+}
+
+
+// ============================================================================================
+
+
 void cbl::pairs::Pair1D::add_data1D (const int i, const std::vector<double> data)
 {
-  m_PP1D[i] += data[0];
-  m_PP1D_weighted[i] += data[1];
+  add_data1D(i, data[0], data[1]);
 }
 
 
@@ -598,7 +923,22 @@ void cbl::pairs::Pair1D::add_data1D (const int i, const std::vector<double> data
 
 void cbl::pairs::Pair1D::add_data1D (const int i, const std::shared_ptr<pairs::Pair> pair, const double ww) 
 {
-  add_data1D(i, {ww*pair->PP1D(i), ww*pair->PP1D_weighted(i)});
+  if (ww==1.)
+    add_data1D(i, pair->PP1D_exact(i), pair->PP1D_weighted_exact(i));
+  else
+    add_data1D(i, ww*pair->PP1D(i), ww*pair->PP1D_weighted(i));
+}
+
+
+// ============================================================================================
+
+
+void cbl::pairs::Pair1D::add_data1D (const int i, const ExactSum pp, const ExactSum pp_weighted, const std::vector<double> extra)
+{
+  (void)extra;
+  
+  m_PP1D[i] += pp;
+  m_PP1D_weighted[i] += pp_weighted;
 }
 
 
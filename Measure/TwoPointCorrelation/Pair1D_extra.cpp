@@ -78,6 +78,49 @@ void cbl::pairs::Pair1D_angular_lin_extra::put (const shared_ptr<Object> obj1, c
 // ============================================================================================
 
 
+void cbl::pairs::Pair1D_angular_lin_extra::put (const chainmesh::CellObjects &obj1, const long i_min, const long i_max, const chainmesh::CellObjects &obj2, const long j_min, const long j_max, const bool auto_pairs)
+{
+  for (long i=i_min; i<i_max; ++i) {
+
+    // select the objects of the second block close to the object i of the first block
+    const long nClose = m_close_objects_angular(obj1, i, obj2, (auto_pairs) ? max(j_min, i+1) : j_min, j_max, m_thetaMin, m_thetaMax);
+
+    // separations and bins of the selected objects
+    m_bin_close_objects(nClose, m_thetaMin, m_thetaMax, m_binSize_inv, m_nbins, false, true);
+
+    for (long n=0; n<nClose; ++n) {
+
+      const int kk = m_bin[n];
+      if (kk<0) continue;
+      
+      const long j = m_close[n];
+      const double dist = m_dist[n];
+
+      const double WeightTOT = obj1.weight[i]*obj2.weight[j];
+
+      m_PP1D[kk] ++;
+      m_PP1D_weighted[kk] += WeightTOT;
+
+      if (m_PP1D_weighted[kk]>0) {
+
+        const double scale_mean_p = m_scale_mean[kk];    
+        m_scale_mean[kk] += WeightTOT/m_PP1D_weighted[kk]*(dist-scale_mean_p);
+        m_scale_S[kk] += WeightTOT*(dist-scale_mean_p)*(dist-m_scale_mean[kk]);
+
+        const double pair_redshift = (obj1.redshift[i]>0 && obj2.redshift[j]>0) ? (obj1.redshift[i]+obj2.redshift[j])*0.5 : -1.;
+        const double z_mean_p = m_z_mean[kk];
+        m_z_mean[kk] += WeightTOT/m_PP1D_weighted[kk]*(pair_redshift-z_mean_p); 
+        m_z_S[kk] += WeightTOT*(pair_redshift-z_mean_p)*(pair_redshift-m_z_mean[kk]);
+
+      }
+    }
+  }
+}
+
+
+// ============================================================================================
+
+
 void cbl::pairs::Pair1D_angular_log_extra::put (const shared_ptr<Object> obj1, const shared_ptr<Object> obj2)
 {
   const double dist = (m_angularUnits==CoordinateUnits::_radians_) ? angular_distance(obj1->xx(), obj2->xx(), obj1->yy(), obj2->yy(), obj1->zz(), obj2->zz()) 
@@ -112,6 +155,49 @@ void cbl::pairs::Pair1D_angular_log_extra::put (const shared_ptr<Object> obj1, c
 // ============================================================================================
 
 
+void cbl::pairs::Pair1D_angular_log_extra::put (const chainmesh::CellObjects &obj1, const long i_min, const long i_max, const chainmesh::CellObjects &obj2, const long j_min, const long j_max, const bool auto_pairs)
+{
+  for (long i=i_min; i<i_max; ++i) {
+
+    // select the objects of the second block close to the object i of the first block
+    const long nClose = m_close_objects_angular(obj1, i, obj2, (auto_pairs) ? max(j_min, i+1) : j_min, j_max, m_thetaMin, m_thetaMax);
+
+    // separations and bins of the selected objects
+    m_bin_close_objects(nClose, m_thetaMin, m_thetaMax, m_binSize_inv, m_nbins, true, true);
+
+    for (long n=0; n<nClose; ++n) {
+
+      const int kk = m_bin[n];
+      if (kk<0) continue;
+      
+      const long j = m_close[n];
+      const double dist = m_dist[n];
+
+      const double WeightTOT = obj1.weight[i]*obj2.weight[j];
+
+      m_PP1D[kk] ++;
+      m_PP1D_weighted[kk] += WeightTOT;
+
+      if (m_PP1D_weighted[kk]>0) {
+
+        const double scale_mean_p = m_scale_mean[kk];    
+        m_scale_mean[kk] += WeightTOT/m_PP1D_weighted[kk]*(dist-scale_mean_p);
+        m_scale_S[kk] += WeightTOT*(dist-scale_mean_p)*(dist-m_scale_mean[kk]);
+
+        const double pair_redshift = (obj1.redshift[i]>0 && obj2.redshift[j]>0) ? (obj1.redshift[i]+obj2.redshift[j])*0.5 : -1.;
+        const double z_mean_p = m_z_mean[kk];
+        m_z_mean[kk] += WeightTOT/m_PP1D_weighted[kk]*(pair_redshift-z_mean_p); 
+        m_z_S[kk] += WeightTOT*(pair_redshift-z_mean_p)*(pair_redshift-m_z_mean[kk]);
+
+      }
+    }
+  }
+}
+
+
+// ============================================================================================
+
+
 void cbl::pairs::Pair1D_comoving_lin_extra::put (const shared_ptr<Object> obj1, const shared_ptr<Object> obj2)
 {
   const double dist = Euclidean_distance(obj1->xx(), obj2->xx(), obj1->yy(), obj2->yy(), obj1->zz(), obj2->zz()); 
@@ -148,6 +234,52 @@ void cbl::pairs::Pair1D_comoving_lin_extra::put (const shared_ptr<Object> obj1,
 // ============================================================================================
 
 
+void cbl::pairs::Pair1D_comoving_lin_extra::put (const chainmesh::CellObjects &obj1, const long i_min, const long i_max, const chainmesh::CellObjects &obj2, const long j_min, const long j_max, const bool auto_pairs)
+{
+  for (long i=i_min; i<i_max; ++i) {
+
+    // select the objects of the second block close to the object i of the first block
+    const long nClose = m_close_objects_Euclidean(obj1, i, obj2, (auto_pairs) ? max(j_min, i+1) : j_min, j_max, m_rMin, m_rMax);
+
+    // separations and bins of the selected objects
+    m_bin_close_objects(nClose, m_rMin, m_rMax, m_binSize_inv, m_nbins, false, false);
+
+    for (long n=0; n<nClose; ++n) {
+
+      const int kk = m_bin[n];
+      if (kk<0) continue;
+      
+      const long j = m_close[n];
+      const double dist = m_dist[n];
+
+      const double angWeight = (m_angularWeight==nullptr) ? 1.
+        : max(0., m_angularWeight(converted_angle(angular_distance(obj1.xx[i]/obj1.dc[i], obj2.xx[j]/obj2.dc[j], obj1.yy[i]/obj1.dc[i], obj2.yy[j]/obj2.dc[j], obj1.zz[i]/obj1.dc[i], obj2.zz[j]/obj2.dc[j]), CoordinateUnits::_radians_, m_angularUnits)));
+
+      const double WeightTOT = obj1.weight[i]*obj2.weight[j]*angWeight;
+
+      m_PP1D[kk] ++;
+      m_PP1D_weighted[kk] += WeightTOT;
+
+      if (m_PP1D_weighted[kk]>0) {
+
+        const double scale_mean_p = m_scale_mean[kk];    
+        m_scale_mean[kk] += WeightTOT/m_PP1D_weighted[kk]*(dist-scale_mean_p);
+        m_scale_S[kk] += WeightTOT*(dist-scale_mean_p)*(dist-m_scale_mean[kk]);
+
+        const double pair_redshift = (obj1.redshift[i]>0 && obj2.redshift[j]>0) ? (obj1.redshift[i]+obj2.redshift[j])*0.5 : -1.;
+        const double z_mean_p = m_z_mean[kk];
+        m_z_mean[kk] += WeightTOT/m_PP1D_weighted[kk]*(pair_redshift-z_mean_p); 
+        m_z_S[kk] += WeightTOT*(pair_redshift-z_mean_p)*(pair_redshift-m_z_mean[kk]);
+
+      }
+    }
+  }
+}
+
+
+// ============================================================================================
+
+
 void cbl::pairs::Pair1D_comoving_log_extra::put (const shared_ptr<Object> obj1, const shared_ptr<Object> obj2)
 { 
   const double dist = Euclidean_distance(obj1->xx(), obj2->xx(), obj1->yy(), obj2->yy(), obj1->zz(), obj2->zz()); 
@@ -184,6 +316,52 @@ void cbl::pairs::Pair1D_comoving_log_extra::put (const shared_ptr<Object> obj1,
 // ============================================================================================
 
 
+void cbl::pairs::Pair1D_comoving_log_extra::put (const chainmesh::CellObjects &obj1, const long i_min, const long i_max, const chainmesh::CellObjects &obj2, const long j_min, const long j_max, const bool auto_pairs)
+{
+  for (long i=i_min; i<i_max; ++i) {
+
+    // select the objects of the second block close to the object i of the first block
+    const long nClose = m_close_objects_Euclidean(obj1, i, obj2, (auto_pairs) ? max(j_min, i+1) : j_min, j_max, m_rMin, m_rMax);
+
+    // separations and bins of the selected objects
+    m_bin_close_objects(nClose, m_rMin, m_rMax, m_binSize_inv, m_nbins, true, false);
+
+    for (long n=0; n<nClose; ++n) {
+
+      const int kk = m_bin[n];
+      if (kk<0) continue;
+      
+      const long j = m_close[n];
+      const double dist = m_dist[n];
+
+      const double angWeight = (m_angularWeight==nullptr) ? 1.
+        : max(0., m_angularWeight(converted_angle(angular_distance(obj1.xx[i]/obj1.dc[i], obj2.xx[j]/obj2.dc[j], obj1.yy[i]/obj1.dc[i], obj2.yy[j]/obj2.dc[j], obj1.zz[i]/obj1.dc[i], obj2.zz[j]/obj2.dc[j]), CoordinateUnits::_radians_, m_angularUnits)));
+
+      const double WeightTOT = obj1.weight[i]*obj2.weight[j]*angWeight;
+
+      m_PP1D[kk] ++;
+      m_PP1D_weighted[kk] += WeightTOT;
+
+      if (m_PP1D_weighted[kk]>0) {
+
+        const double scale_mean_p = m_scale_mean[kk];    
+        m_scale_mean[kk] += WeightTOT/m_PP1D_weighted[kk]*(dist-scale_mean_p);
+        m_scale_S[kk] += WeightTOT*(dist-scale_mean_p)*(dist-m_scale_mean[kk]);
+
+        const double pair_redshift = (obj1.redshift[i]>0 && obj2.redshift[j]>0) ? (obj1.redshift[i]+obj2.redshift[j])*0.5 : -1.;
+        const double z_mean_p = m_z_mean[kk];
+        m_z_mean[kk] += WeightTOT/m_PP1D_weighted[kk]*(pair_redshift-z_mean_p); 
+        m_z_S[kk] += WeightTOT*(pair_redshift-z_mean_p)*(pair_redshift-m_z_mean[kk]);
+
+      }
+    }
+  }
+}
+
+
+// ============================================================================================
+
+
 void cbl::pairs::Pair1D_comoving_multipoles_lin_extra::put (const shared_ptr<Object> obj1, const shared_ptr<Object> obj2)
 {
   const double dist = Euclidean_distance(obj1->xx(), obj2->xx(), obj1->yy(), obj2->yy(), obj1->zz(), obj2->zz()); 
@@ -233,6 +411,66 @@ void cbl::pairs::Pair1D_comoving_multipoles_lin_extra::put (const shared_ptr<Obj
 // ============================================================================================
 
 
+void cbl::pairs::Pair1D_comoving_multipoles_lin_extra::put (const chainmesh::CellObjects &obj1, const long i_min, const long i_max, const chainmesh::CellObjects &obj2, const long j_min, const long j_max, const bool auto_pairs)
+{
+  for (long i=i_min; i<i_max; ++i) {
+
+    // select the objects of the second block close to the object i of the first block
+    const long nClose = m_close_objects_Euclidean(obj1, i, obj2, (auto_pairs) ? max(j_min, i+1) : j_min, j_max, m_rMin, m_rMax);
+
+    // separations and bins of the selected objects
+    m_bin_close_objects(nClose, m_rMin, m_rMax, m_binSize_inv, m_nbins, false, false);
+
+    for (long n=0; n<nClose; ++n) {
+
+      const int kk = m_bin[n];
+      if (kk<0) continue;
+
+      const long j = m_close[n];
+      const double dist = m_dist[n];
+
+      const double angWeight = (m_angularWeight==nullptr) ? 1.
+        : max(0., m_angularWeight(converted_angle(angular_distance(obj1.xx[i]/obj1.dc[i], obj2.xx[j]/obj2.dc[j], obj1.yy[i]/obj1.dc[i], obj2.yy[j]/obj2.dc[j], obj1.zz[i]/obj1.dc[i], obj2.zz[j]/obj2.dc[j]), CoordinateUnits::_radians_, m_angularUnits)));
+
+      const double WeightTOT = obj1.weight[i]*obj2.weight[j]*angWeight;
+      const double cosmu2 = pow((obj2.dc[j]-obj1.dc[i])/dist, 2);
+
+      m_PP1D[kk] ++;
+      m_PP1D_weighted[kk] += WeightTOT;
+
+      double leg_pol_2 = 0.5*(3.*cosmu2-1.);
+      m_PP1D[(m_nbins+1)+kk] += 5.*leg_pol_2 ;
+      m_PP1D_weighted[(m_nbins+1)+kk] += 5.*WeightTOT*leg_pol_2;
+
+      double leg_pol_4 = 0.125*(35.*cosmu2*cosmu2-30.*cosmu2+3.);
+      m_PP1D[2.*(m_nbins+1)+kk] += 9.*leg_pol_4;
+      m_PP1D_weighted[2.*(m_nbins+1)+kk] += 9.*WeightTOT*leg_pol_4;
+
+      if (m_PP1D_weighted[kk]>0) {
+
+        const double scale_mean_p = m_scale_mean[kk];    
+        m_scale_mean[kk] += WeightTOT/m_PP1D_weighted[kk]*(dist-scale_mean_p);
+        m_scale_S[kk] += WeightTOT*(dist-scale_mean_p)*(dist-m_scale_mean[kk]);
+
+        const double pair_redshift = (obj1.redshift[i]>0 && obj2.redshift[j]>0) ? (obj1.redshift[i]+obj2.redshift[j])*0.5 : -1.;
+        const double z_mean_p = m_z_mean[kk];
+        m_z_mean[kk] += WeightTOT/m_PP1D_weighted[kk]*(pair_redshift-z_mean_p); 
+        m_z_S[kk] += WeightTOT*(pair_redshift-z_mean_p)*(pair_redshift-m_z_mean[kk]);
+
+        m_scale_mean[kk+(m_nbins+1)] += WeightTOT/m_PP1D_weighted[kk]*(dist-scale_mean_p);
+        m_scale_S[kk+(m_nbins+1)] += WeightTOT*(dist-scale_mean_p)*(dist-m_scale_mean[kk]);
+
+        m_scale_mean[kk+2*(m_nbins+1)] += WeightTOT/m_PP1D_weighted[kk]*(dist-scale_mean_p);
+        m_scale_S[kk+2*(m_nbins+1)] += WeightTOT*(dist-scale_mean_p)*(dist-m_scale_mean[kk]);
+      }
+    }
+  }
+}
+
+
+// ============================================================================================
+
+
 void cbl::pairs::Pair1D_comoving_multipoles_log_extra::put (const shared_ptr<Object> obj1, const shared_ptr<Object> obj2)
 {
   const double dist = Euclidean_distance(obj1->xx(), obj2->xx(), obj1->yy(), obj2->yy(), obj1->zz(), obj2->zz()); 
@@ -283,7 +521,90 @@ void cbl::pairs::Pair1D_comoving_multipoles_log_extra::put (const shared_ptr<Obj
 // ============================================================================================
 
 
+void cbl::pairs::Pair1D_comoving_multipoles_log_extra::put (const chainmesh::CellObjects &obj1, const long i_min, const long i_max, const chainmesh::CellObjects &obj2, const long j_min, const long j_max, const bool auto_pairs)
+{
+  for (long i=i_min; i<i_max; ++i) {
+
+    // select the objects of the second block close to the object i of the first block
+    const long nClose = m_close_objects_Euclidean(obj1, i, obj2, (auto_pairs) ? max(j_min, i+1) : j_min, j_max, m_rMin, m_rMax);
+
+    // separations and bins of the selected objects
+    m_bin_close_objects(nClose, m_rMin, m_rMax, m_binSize_inv, m_nbins, true, false);
+
+    for (long n=0; n<nClose; ++n) {
+
+      const int kk = m_bin[n];
+      if (kk<0) continue;
+
+      const long j = m_close[n];
+      const double dist = m_dist[n];
+
+      const double angWeight = (m_angularWeight==nullptr) ? 1.
+        : max(0., m_angularWeight(converted_angle(angular_distance(obj1.xx[i]/obj1.dc[i], obj2.xx[j]/obj2.dc[j], obj1.yy[i]/obj1.dc[i], obj2.yy[j]/obj2.dc[j], obj1.zz[i]/obj1.dc[i], obj2.zz[j]/obj2.dc[j]), CoordinateUnits::_radians_, m_angularUnits)));
+
+      const double WeightTOT = obj1.weight[i]*obj2.weight[j]*angWeight;
+      const double cosmu2 = pow((obj2.dc[j]-obj1.dc[i])/dist, 2);
+
+      m_PP1D[kk] ++;
+      m_PP1D_weighted[kk] += WeightTOT;
+
+      double leg_pol_2 = 0.5*(3.*cosmu2-1.);
+      m_PP1D[(m_nbins+1)+kk] += 5.*leg_pol_2 ;
+      m_PP1D_weighted[(m_nbins+1)+kk] += 5.*WeightTOT*leg_pol_2;
+
+      double leg_pol_4 = 0.125*(35.*cosmu2*cosmu2-30.*cosmu2+3.);
+      m_PP1D[2.*(m_nbins+1)+kk] += 9.*leg_pol_4;
+      m_PP1D_weighted[2.*(m_nbins+1)+kk] += 9.*WeightTOT*leg_pol_4;
+
+      if (m_PP1D_weighted[kk]>0) {
+
+        const double scale_mean_p = m_scale_mean[kk];    
+        m_scale_mean[kk] += WeightTOT/m_PP1D_weighted[kk]*(dist-scale_mean_p);
+        m_scale_S[kk] += WeightTOT*(dist-scale_mean_p)*(dist-m_scale_mean[kk]);
+
+        const double pair_redshift = (obj1.redshift[i]>0 && obj2.redshift[j]>0) ? (obj1.redshift[i]+obj2.redshift[j])*0.5 : -1.;
+        const double z_mean_p = m_z_mean[kk];
+        m_z_mean[kk] += WeightTOT/m_PP1D_weighted[kk]*(pair_redshift-z_mean_p); 
+        m_z_S[kk] += WeightTOT*(pair_redshift-z_mean_p)*(pair_redshift-m_z_mean[kk]);
+
+        m_scale_mean[kk+(m_nbins+1)] += WeightTOT/m_PP1D_weighted[kk]*(dist-scale_mean_p);
+        m_scale_S[kk+(m_nbins+1)] += WeightTOT*(dist-scale_mean_p)*(dist-m_scale_mean[kk]);
+
+        m_scale_mean[kk+2*(m_nbins+1)] += WeightTOT/m_PP1D_weighted[kk]*(dist-scale_mean_p);
+        m_scale_S[kk+2*(m_nbins+1)] += WeightTOT*(dist-scale_mean_p)*(dist-m_scale_mean[kk]);
+      }
+    }
+  }
+}
+
+
+// ============================================================================================
+
+
 void cbl::pairs::Pair1D_extra::add_data1D (const int i, const std::vector<double> data)
+{
+  add_data1D(i, data[0], data[1], {data[2], data[3], data[4], data[5]});
+}
+
+
+// ============================================================================================
+     
+
+void cbl::pairs::Pair1D_extra::add_data1D (const int i, const std::shared_ptr<pairs::Pair> pair, const double ww)
+{
+  const vector<double> extra = {pair->scale_mean(i), pair->scale_S(i), pair->z_mean(i), pair->z_S(i)};
+  
+  if (ww==1.)
+    add_data1D(i, pair->PP1D_exact(i), pair->PP1D_weighted_exact(i), extra);
+  else
+    add_data1D(i, ww*pair->PP1D(i), ww*pair->PP1D_weighted(i), extra);
+}
+
+
+// ============================================================================================
+
+
+void cbl::pairs::Pair1D_extra::add_data1D (const int i, const ExactSum pp, const ExactSum pp_weighted, const std::vector<double> extra)
 {
   /*
     checkDim(m_PP1D, i, "m_PP1D", false);
@@ -292,7 +613,7 @@ void cbl::pairs::Pair1D_extra::add_data1D (const int i, const std::vector<double
     checkDim(m_scale_sigma, i, "m_scale_sigma", false);
     checkDim(m_z_mean, i, "m_z_mean", false);
     checkDim(m_z_sigma, i, "m_z_sigma", false); 
-    checkDim(data, 6, "data");
+    checkDim(extra, 4, "extra");
   */
 
   // mean scale up to this computation step
@@ -302,42 +623,35 @@ void cbl::pairs::Pair1D_extra::add_data1D (const int i, const std::vector<double
   const double z_mean_temp_p = m_z_mean[i];
 
   // number of pairs
-  m_PP1D[i] += data[0];
+  m_PP1D[i] += pp;
 
   // number of weighted pairs
-  m_PP1D_weighted[i] += data[1];
+  m_PP1D_weighted[i] += pp_weighted;
   
+  // the extra information is averaged with the weighted number of pairs rounded to double
+  const double weight = pp_weighted, weight_tot = m_PP1D_weighted[i];
  
-  if (m_PP1D_weighted[i]>0) {
+  if (weight_tot>0) {
     
     // mean separation
-    m_scale_mean[i] += data[1]/m_PP1D_weighted[i]*(data[2]-scale_mean_temp_p);
+    m_scale_mean[i] += weight/weight_tot*(extra[0]-scale_mean_temp_p);
     
     // mean redshift
-    m_z_mean[i] += data[1]/m_PP1D_weighted[i]*(data[4]-z_mean_temp_p);
+    m_z_mean[i] += weight/weight_tot*(extra[2]-z_mean_temp_p);
 
     // compute the weighted standard deviation of the scale distribution
-    m_scale_S[i] += data[3]+pow(data[2]-scale_mean_temp_p, 2)*data[1]*(m_PP1D_weighted[i]-data[1])/m_PP1D_weighted[i];
-    m_scale_sigma[i] = sqrt(m_scale_S[i]/m_PP1D_weighted[i]);
+    m_scale_S[i] += extra[1]+pow(extra[0]-scale_mean_temp_p, 2)*weight*(weight_tot-weight)/weight_tot;
+    m_scale_sigma[i] = sqrt(m_scale_S[i]/weight_tot);
 
     // compute the weighted standard deviation of the redshift distribution
-    m_z_S[i] += data[5]+pow(data[4]-z_mean_temp_p, 2)*data[1]*(m_PP1D_weighted[i]-data[1])/m_PP1D_weighted[i];
-    m_z_sigma[i] = sqrt(m_z_S[i]/m_PP1D_weighted[i]);
+    m_z_S[i] += extra[3]+pow(extra[2]-z_mean_temp_p, 2)*weight*(weight_tot-weight)/weight_tot;
+    m_z_sigma[i] = sqrt(m_z_S[i]/weight_tot);
     
   }
   
 }
 
 
-// ============================================================================================
-     
-
-void cbl::pairs::Pair1D_extra::add_data1D (const int i, const std::shared_ptr<pairs::Pair> pair, const double ww)
-{
-  add_data1D(i, {ww*pair->PP1D(i), ww*pair->PP1D_weighted(i), pair->scale_mean(i), pair->scale_S(i), pair->z_mean(i), pair->z_S(i)});
-}
-
-
 // ============================================================================================
 
 
@@ -614,6 +614,38 @@ void cbl::pairs::Pair2D_comovingCartesian_linlin::put (const shared_ptr<Object>
 // ============================================================================================
 
 
+void cbl::pairs::Pair2D_comovingCartesian_linlin::put (const chainmesh::CellObjects &obj1, const long i_min, const long i_max, const chainmesh::CellObjects &obj2, const long j_min, const long j_max, const bool auto_pairs)
+{
+  for (long i=i_min; i<i_max; ++i) {
+
+    // select the objects of the second block close to the object i of the first block
+    const long nClose = m_close_objects_lineOfSight(obj1, i, obj2, (auto_pairs) ? max(j_min, i+1) : j_min, j_max, m_piMin, m_piMax);
+
+    // separations and bins of the selected objects
+    m_Cartesian_close_objects(nClose, obj1, i, obj2);
+    m_bin_close_objects_2D(nClose, m_rpMin, m_rpMax, m_binSize_inv_D1, m_nbins_D1, false, m_piMin, m_piMax, m_binSize_inv_D2, m_nbins_D2, false);
+
+    for (long n=0; n<nClose; ++n) {
+
+      const int ir = m_bin[n];
+      if (ir<0) continue;
+      const int jr = m_bin_D2[n];
+
+      const long j = m_close[n];
+
+      const double angWeight = (m_angularWeight==nullptr) ? 1.
+        : max(0., m_angularWeight(converted_angle(angular_distance(obj1.xx[i]/obj1.dc[i], obj2.xx[j]/obj2.dc[j], obj1.yy[i]/obj1.dc[i], obj2.yy[j]/obj2.dc[j], obj1.zz[i]/obj1.dc[i], obj2.zz[j]/obj2.dc[j]), CoordinateUnits::_radians_, m_angularUnits)));
+
+      m_PP2D[ir][jr] ++;
+      m_PP2D_weighted[ir][jr] += obj1.weight[i]*obj2.weight[j]*angWeight;
+    }
+  }
+}
+
+
+// ============================================================================================
+
+
 void cbl::pairs::Pair2D_comovingCartesian_linlog::put (const shared_ptr<Object> obj1, const shared_ptr<Object> obj2) 
 {
   const double rp = perpendicular_distance(obj1->ra(), obj2->ra(), obj1->dec(), obj2->dec(), obj1->dc(), obj2->dc());
@@ -637,6 +669,38 @@ void cbl::pairs::Pair2D_comovingCartesian_linlog::put (const shared_ptr<Object>
 // ============================================================================================
 
 
+void cbl::pairs::Pair2D_comovingCartesian_linlog::put (const chainmesh::CellObjects &obj1, const long i_min, const long i_max, const chainmesh::CellObjects &obj2, const long j_min, const long j_max, const bool auto_pairs)
+{
+  for (long i=i_min; i<i_max; ++i) {
+
+    // select the objects of the second block close to the object i of the first block
+    const long nClose = m_close_objects_lineOfSight(obj1, i, obj2, (auto_pairs) ? max(j_min, i+1) : j_min, j_max, m_piMin, m_piMax);
+
+    // separations and bins of the selected objects
+    m_Cartesian_close_objects(nClose, obj1, i, obj2);
+    m_bin_close_objects_2D(nClose, m_rpMin, m_rpMax, m_binSize_inv_D1, m_nbins_D1, false, m_piMin, m_piMax, m_binSize_inv_D2, m_nbins_D2, true);
+
+    for (long n=0; n<nClose; ++n) {
+
+      const int ir = m_bin[n];
+      if (ir<0) continue;
+      const int jr = m_bin_D2[n];
+
+      const long j = m_close[n];
+
+      const double angWeight = (m_angularWeight==nullptr) ? 1.
+        : max(0., m_angularWeight(converted_angle(angular_distance(obj1.xx[i]/obj1.dc[i], obj2.xx[j]/obj2.dc[j], obj1.yy[i]/obj1.dc[i], obj2.yy[j]/obj2.dc[j], obj1.zz[i]/obj1.dc[i], obj2.zz[j]/obj2.dc[j]), CoordinateUnits::_radians_, m_angularUnits)));
+
+      m_PP2D[ir][jr] ++;
+      m_PP2D_weighted[ir][jr] += obj1.weight[i]*obj2.weight[j]*angWeight;
+    }
+  }
+}
+
+
+// ============================================================================================
+
+
 void cbl::pairs::Pair2D_comovingCartesian_loglin::put (const shared_ptr<Object> obj1, const shared_ptr<Object> obj2) 
 {
   const double rp = perpendicular_distance(obj1->ra(), obj2->ra(), obj1->dec(), obj2->dec(), obj1->dc(), obj2->dc());
@@ -660,6 +724,38 @@ void cbl::pairs::Pair2D_comovingCartesian_loglin::put (const shared_ptr<Object>
 // ============================================================================================
 
 
+void cbl::pairs::Pair2D_comovingCartesian_loglin::put (const chainmesh::CellObjects &obj1, const long i_min, const long i_max, const chainmesh::CellObjects &obj2, const long j_min, const long j_max, const bool auto_pairs)
+{
+  for (long i=i_min; i<i_max; ++i) {
+
+    // select the objects of the second block close to the object i of the first block
+    const long nClose = m_close_objects_lineOfSight(obj1, i, obj2, (auto_pairs) ? max(j_min, i+1) : j_min, j_max, m_piMin, m_piMax);
+
+    // separations and bins of the selected objects
+    m_Cartesian_close_objects(nClose, obj1, i, obj2);
+    m_bin_close_objects_2D(nClose, m_rpMin, m_rpMax, m_binSize_inv_D1, m_nbins_D1, true, m_piMin, m_piMax, m_binSize_inv_D2, m_nbins_D2, false);
+
+    for (long n=0; n<nClose; ++n) {
+
+      const int ir = m_bin[n];
+      if (ir<0) continue;
+      const int jr = m_bin_D2[n];
+
+      const long j = m_close[n];
+
+      const double angWeight = (m_angularWeight==nullptr) ? 1.
+        : max(0., m_angularWeight(converted_angle(angular_distance(obj1.xx[i]/obj1.dc[i], obj2.xx[j]/obj2.dc[j], obj1.yy[i]/obj1.dc[i], obj2.yy[j]/obj2.dc[j], obj1.zz[i]/obj1.dc[i], obj2.zz[j]/obj2.dc[j]), CoordinateUnits::_radians_, m_angularUnits)));
+
+      m_PP2D[ir][jr] ++;
+      m_PP2D_weighted[ir][jr] += obj1.weight[i]*obj2.weight[j]*angWeight;
+    }
+  }
+}
+
+
+// ============================================================================================
+
+
 void cbl::pairs::Pair2D_comovingCartesian_loglog::put (const shared_ptr<Object> obj1, const shared_ptr<Object> obj2) 
 {
   const double rp = perpendicular_distance(obj1->ra(), obj2->ra(), obj1->dec(), obj2->dec(), obj1->dc(), obj2->dc());
@@ -683,6 +779,38 @@ void cbl::pairs::Pair2D_comovingCartesian_loglog::put (const shared_ptr<Object>
 // ============================================================================================
 
 
+void cbl::pairs::Pair2D_comovingCartesian_loglog::put (const chainmesh::CellObjects &obj1, const long i_min, const long i_max, const chainmesh::CellObjects &obj2, const long j_min, const long j_max, const bool auto_pairs)
+{
+  for (long i=i_min; i<i_max; ++i) {
+
+    // select the objects of the second block close to the object i of the first block
+    const long nClose = m_close_objects_lineOfSight(obj1, i, obj2, (auto_pairs) ? max(j_min, i+1) : j_min, j_max, m_piMin, m_piMax);
+
+    // separations and bins of the selected objects
+    m_Cartesian_close_objects(nClose, obj1, i, obj2);
+    m_bin_close_objects_2D(nClose, m_rpMin, m_rpMax, m_binSize_inv_D1, m_nbins_D1, true, m_piMin, m_piMax, m_binSize_inv_D2, m_nbins_D2, true);
+
+    for (long n=0; n<nClose; ++n) {
+
+      const int ir = m_bin[n];
+      if (ir<0) continue;
+      const int jr = m_bin_D2[n];
+
+      const long j = m_close[n];
+
+      const double angWeight = (m_angularWeight==nullptr) ? 1.
+        : max(0., m_angularWeight(converted_angle(angular_distance(obj1.xx[i]/obj1.dc[i], obj2.xx[j]/obj2.dc[j], obj1.yy[i]/obj1.dc[i], obj2.yy[j]/obj2.dc[j], obj1.zz[i]/obj1.dc[i], obj2.zz[j]/obj2.dc[j]), CoordinateUnits::_radians_, m_angularUnits)));
+
+      m_PP2D[ir][jr] ++;
+      m_PP2D_weighted[ir][jr] += obj1.weight[i]*obj2.weight[j]*angWeight;
+    }
+  }
+}
+
+
+// ============================================================================================
+
+
 void cbl::pairs::Pair2D_comovingPolar_linlin::put (const shared_ptr<Object> obj1, const shared_ptr<Object> obj2) 
 {
   const double rr = Euclidean_distance(obj1->xx(), obj2->xx(), obj1->yy(), obj2->yy(), obj1->zz(), obj2->zz());
@@ -706,6 +834,38 @@ void cbl::pairs::Pair2D_comovingPolar_linlin::put (const shared_ptr<Object> obj1
 // ============================================================================================
 
 
+void cbl::pairs::Pair2D_comovingPolar_linlin::put (const chainmesh::CellObjects &obj1, const long i_min, const long i_max, const chainmesh::CellObjects &obj2, const long j_min, const long j_max, const bool auto_pairs)
+{
+  for (long i=i_min; i<i_max; ++i) {
+
+    // select the objects of the second block close to the object i of the first block
+    const long nClose = m_close_objects_Euclidean(obj1, i, obj2, (auto_pairs) ? max(j_min, i+1) : j_min, j_max, m_rMin, m_rMax);
+
+    // separations and bins of the selected objects
+    m_polar_close_objects(nClose, obj1, i, obj2);
+    m_bin_close_objects_2D(nClose, m_rMin, m_rMax, m_binSize_inv_D1, m_nbins_D1, false, m_muMin, m_muMax, m_binSize_inv_D2, m_nbins_D2, false);
+
+    for (long n=0; n<nClose; ++n) {
+
+      const int ir = m_bin[n];
+      if (ir<0) continue;
+      const int jr = m_bin_D2[n];
+
+      const long j = m_close[n];
+
+      const double angWeight = (m_angularWeight==nullptr) ? 1.
+        : max(0., m_angularWeight(converted_angle(angular_distance(obj1.xx[i]/obj1.dc[i], obj2.xx[j]/obj2.dc[j], obj1.yy[i]/obj1.dc[i], obj2.yy[j]/obj2.dc[j], obj1.zz[i]/obj1.dc[i], obj2.zz[j]/obj2.dc[j]), CoordinateUnits::_radians_, m_angularUnits)));
+
+      m_PP2D[ir][jr] ++;
+      m_PP2D_weighted[ir][jr] += obj1.weight[i]*obj2.weight[j]*angWeight;
+    }
+  }
+}
+
+
+// ============================================================================================
+
+
 void cbl::pairs::Pair2D_comovingPolar_linlog::put (const shared_ptr<Object> obj1, const shared_ptr<Object> obj2) 
 {
   const double rr = Euclidean_distance(obj1->xx(), obj2->xx(), obj1->yy(), obj2->yy(), obj1->zz(), obj2->zz());
@@ -729,6 +889,38 @@ void cbl::pairs::Pair2D_comovingPolar_linlog::put (const shared_ptr<Object> obj1
 // ============================================================================================
 
 
+void cbl::pairs::Pair2D_comovingPolar_linlog::put (const chainmesh::CellObjects &obj1, const long i_min, const long i_max, const chainmesh::CellObjects &obj2, const long j_min, const long j_max, const bool auto_pairs)
+{
+  for (long i=i_min; i<i_max; ++i) {
+
+    // select the objects of the second block close to the object i of the first block
+    const long nClose = m_close_objects_Euclidean(obj1, i, obj2, (auto_pairs) ? max(j_min, i+1) : j_min, j_max, m_rMin, m_rMax);
+
+    // separations and bins of the selected objects
+    m_polar_close_objects(nClose, obj1, i, obj2);
+    m_bin_close_objects_2D(nClose, m_rMin, m_rMax, m_binSize_inv_D1, m_nbins_D1, false, m_muMin, m_muMax, m_binSize_inv_D2, m_nbins_D2, true);
+
+    for (long n=0; n<nClose; ++n) {
+
+      const int ir = m_bin[n];
+      if (ir<0) continue;
+      const int jr = m_bin_D2[n];
+
+      const long j = m_close[n];
+
+      const double angWeight = (m_angularWeight==nullptr) ? 1.
+        : max(0., m_angularWeight(converted_angle(angular_distance(obj1.xx[i]/obj1.dc[i], obj2.xx[j]/obj2.dc[j], obj1.yy[i]/obj1.dc[i], obj2.yy[j]/obj2.dc[j], obj1.zz[i]/obj1.dc[i], obj2.zz[j]/obj2.dc[j]), CoordinateUnits::_radians_, m_angularUnits)));
+
+      m_PP2D[ir][jr] ++;
+      m_PP2D_weighted[ir][jr] += obj1.weight[i]*obj2.weight[j]*angWeight;
+    }
+  }
+}
+
+
+// ============================================================================================
+
+
 void cbl::pairs::Pair2D_comovingPolar_loglin::put (const shared_ptr<Object> obj1, const shared_ptr<Object> obj2) 
 {
   const double rr = Euclidean_distance(obj1->xx(), obj2->xx(), obj1->yy(), obj2->yy(), obj1->zz(), obj2->zz());
@@ -752,6 +944,38 @@ void cbl::pairs::Pair2D_comovingPolar_loglin::put (const shared_ptr<Object> obj1
 // ============================================================================================
 
 
+void cbl::pairs::Pair2D_comovingPolar_loglin::put (const chainmesh::CellObjects &obj1, const long i_min, const long i_max, const chainmesh::CellObjects &obj2, const long j_min, const long j_max, const bool auto_pairs)
+{
+  for (long i=i_min; i<i_max; ++i) {
+
+    // select the objects of the second block close to the object i of the first block
+    const long nClose = m_close_objects_Euclidean(obj1, i, obj2, (auto_pairs) ? max(j_min, i+1) : j_min, j_max, m_rMin, m_rMax);
+
+    // separations and bins of the selected objects
+    m_polar_close_objects(nClose, obj1, i, obj2);
+    m_bin_close_objects_2D(nClose, m_rMin, m_rMax, m_binSize_inv_D1, m_nbins_D1, true, m_muMin, m_muMax, m_binSize_inv_D2, m_nbins_D2, false);
+
+    for (long n=0; n<nClose; ++n) {
+
+      const int ir = m_bin[n];
+      if (ir<0) continue;
+      const int jr = m_bin_D2[n];
+
+      const long j = m_close[n];
+
+      const double angWeight = (m_angularWeight==nullptr) ? 1.
+        : max(0., m_angularWeight(converted_angle(angular_distance(obj1.xx[i]/obj1.dc[i], obj2.xx[j]/obj2.dc[j], obj1.yy[i]/obj1.dc[i], obj2.yy[j]/obj2.dc[j], obj1.zz[i]/obj1.dc[i], obj2.zz[j]/obj2.dc[j]), CoordinateUnits::_radians_, m_angularUnits)));
+
+      m_PP2D[ir][jr] ++;
+      m_PP2D_weighted[ir][jr] += obj1.weight[i]*obj2.weight[j]*angWeight;
+    }
+  }
+}
+
+
+// ============================================================================================
+
+
 void cbl::pairs::Pair2D_comovingPolar_loglog::put (const shared_ptr<Object> obj1, const shared_ptr<Object> obj2) 
 {
   const double rr = Euclidean_distance(obj1->xx(), obj2->xx(), obj1->yy(), obj2->yy(), obj1->zz(), obj2->zz());
@@ -775,6 +999,50 @@ void cbl::pairs::Pair2D_comovingPolar_loglog::put (const shared_ptr<Object> obj1
 // ============================================================================================
 
 
+void cbl::pairs::Pair2D_comovingPolar_loglog::put (const chainmesh::CellObjects &obj1, const long i_min, const long i_max, const chainmesh::CellObjects &obj2, const long j_min, const long j_max, const bool auto_pairs)
+{
+  for (long i=i_min; i<i_max; ++i) {
+
+    // select the objects of the second block close to the object i of the first block
+    const long nClose = m_close_objects_Euclidean(obj1, i, obj2, (auto_pairs) ? max(j_min, i+1) : j_min, j_max, m_rMin, m_rMax);
+
+    // separations and bins of the selected objects
+    m_polar_close_objects(nClose, obj1, i, obj2);
+    m_bin_close_objects_2D(nClose, m_rMin, m_rMax, m_binSize_inv_D1, m_nbins_D1, true, m_muMin, m_muMax, m_binSize_inv_D2, m_nbins_D2, true);
+
+    for (long n=0; n<nClose; ++n) {
+
+      const int ir = m_bin[n];
+      if (ir<0) continue;
+      const int jr = m_bin_D2[n];
+
+      const long j = m_close[n];
+
+      const double angWeight = (m_angularWeight==nullptr) ? 1.
+        : max(0., m_angularWeight(converted_angle(angular_distance(obj1.xx[i]/obj1.dc[i], obj2.xx[j]/obj2.dc[j], obj1.yy[i]/obj1.dc[i], obj2.yy[j]/obj2.dc[j], obj1.zz[i]/obj1.dc[i], obj2.zz[j]/obj2.dc[j]), CoordinateUnits::_radians_, m_angularUnits)));
+
+      m_PP2D[ir][jr] ++;
+      m_PP2D_weighted[ir][jr] += obj1.weight[i]*obj2.weight[j]*angWeight;
+    }
+  }
+}
+
+
+// ============================================================================================
+
+
+bool cbl::pairs::Pair2D_comovingPolar::put_cells (const chainmesh::CellObjects &obj1, const long i_min, const long i_max, const chainmesh::CellObjects &obj2, const long j_min, const long j_max, const bool auto_pairs, const double dist_min, const double dist_max)
+{
+  (void)obj1; (void)i_min; (void)i_max; (void)obj2; (void)j_min; (void)j_max; (void)auto_pairs;
+  
+  // all the pairs are outside the binning range (the separations are slightly enlarged to account for round-off errors)
+  return (dist_min*(1.-1.e-10)>=m_rMax || dist_max*(1.+1.e-10)<=m_rMin);
+}
+
+
+// ============================================================================================
+
+
 void cbl::pairs::Pair2D_comovingCartesian_linlin::set_pair (const int ir, const int jr, const double ww, const double weight) 
 {
   if (ir>-1 && jr>-1){
@@ -879,8 +1147,7 @@ void cbl::pairs::Pair2D::add_data2D (const int i, const int j, const std::vector
     checkDim(data, 1, "data");
   */
   
-  m_PP2D[i][j] += data[0];
-  m_PP2D_weighted[i][j] += data[1];
+  add_data2D(i, j, data[0], data[1]);
 }
 
 
@@ -889,7 +1156,22 @@ void cbl::pairs::Pair2D::add_data2D (const int i, const int j, const std::vector
 
 void cbl::pairs::Pair2D::add_data2D (const int i, const int j, const std::shared_ptr<pairs::Pair> pair, const double ww)
 {
-  add_data2D(i, j, {ww*pair->PP2D(i, j), ww*pair->PP2D_weighted(i, j)});
+  if (ww==1.)
+    add_data2D(i, j, pair->PP2D_exact(i, j), pair->PP2D_weighted_exact(i, j));
+  else
+    add_data2D(i, j, ww*pair->PP2D(i, j), ww*pair->PP2D_weighted(i, j));
+}
+
+
+// ============================================================================================
+
+
+void cbl::pairs::Pair2D::add_data2D (const int i, const int j, const ExactSum pp, const ExactSum pp_weighted, const std::vector<double> extra)
+{
+  (void)extra;
+  
+  m_PP2D[i][j] += pp;
+  m_PP2D_weighted[i][j] += pp_weighted;
 }
 
 
@@ -81,6 +81,57 @@ void cbl::pairs::Pair2D_comovingCartesian_linlin_extra::put (const std::shared_p
   }
 }
 
+
+// ============================================================================================
+
+
+void cbl::pairs::Pair2D_comovingCartesian_linlin_extra::put (const chainmesh::CellObjects &obj1, const long i_min, const long i_max, const chainmesh::CellObjects &obj2, const long j_min, const long j_max, const bool auto_pairs)
+{
+  for (long i=i_min; i<i_max; ++i) {
+
+    // select the objects of the second block close to the object i of the first block
+    const long nClose = m_close_objects_lineOfSight(obj1, i, obj2, (auto_pairs) ? max(j_min, i+1) : j_min, j_max, m_piMin, m_piMax);
+
+    // separations and bins of the selected objects
+    m_Cartesian_close_objects(nClose, obj1, i, obj2);
+    m_bin_close_objects_2D(nClose, m_rpMin, m_rpMax, m_binSize_inv_D1, m_nbins_D1, false, m_piMin, m_piMax, m_binSize_inv_D2, m_nbins_D2, false);
+
+    for (long n=0; n<nClose; ++n) {
+
+      const int ir = m_bin[n];
+      if (ir<0) continue;
+      const int jr = m_bin_D2[n];
+
+      const long j = m_close[n];
+      const double rp = m_dist[n], pi = m_dist_D2[n];
+
+      const double angWeight = (m_angularWeight==nullptr) ? 1.
+        : max(0., m_angularWeight(converted_angle(angular_distance(obj1.xx[i]/obj1.dc[i], obj2.xx[j]/obj2.dc[j], obj1.yy[i]/obj1.dc[i], obj2.yy[j]/obj2.dc[j], obj1.zz[i]/obj1.dc[i], obj2.zz[j]/obj2.dc[j]), CoordinateUnits::_radians_, m_angularUnits)));
+
+      const double WeightTOT = obj1.weight[i]*obj2.weight[j]*angWeight;
+
+      m_PP2D[ir][jr] ++;
+      m_PP2D_weighted[ir][jr] += WeightTOT;
+
+      if (m_PP2D_weighted[ir][jr]>0) {
+
+        const double scale_D1_mean_p = m_scale_D1_mean[ir][jr];
+        const double scale_D2_mean_p = m_scale_D2_mean[ir][jr];
+        m_scale_D1_mean[ir][jr] += WeightTOT/m_PP2D_weighted[ir][jr]*(rp-scale_D1_mean_p);
+        m_scale_D2_mean[ir][jr] += WeightTOT/m_PP2D_weighted[ir][jr]*(pi-scale_D2_mean_p);
+        m_scale_D1_S[ir][jr] += WeightTOT*(rp-scale_D1_mean_p)*(rp-m_scale_D1_mean[ir][jr]);
+        m_scale_D2_S[ir][jr] += WeightTOT*(pi-scale_D2_mean_p)*(pi-m_scale_D2_mean[ir][jr]);
+
+        const double pair_redshift = (obj1.redshift[i]>0 && obj2.redshift[j]>0) ? (obj1.redshift[i]+obj2.redshift[j])*0.5 : -1.;
+        const double z_mean_p = m_z_mean[ir][jr];
+        m_z_mean[ir][jr] += WeightTOT/m_PP2D_weighted[ir][jr]*(pair_redshift-z_mean_p); 
+        m_z_S[ir][jr] += WeightTOT*(pair_redshift-z_mean_p)*(pair_redshift-m_z_mean[ir][jr]);
+
+      }
+    }
+  }
+}
+
 // ============================================================================================
 
 
@@ -125,6 +176,57 @@ void cbl::pairs::Pair2D_comovingCartesian_linlog_extra::put (const std::shared_p
 // ============================================================================================
 
 
+void cbl::pairs::Pair2D_comovingCartesian_linlog_extra::put (const chainmesh::CellObjects &obj1, const long i_min, const long i_max, const chainmesh::CellObjects &obj2, const long j_min, const long j_max, const bool auto_pairs)
+{
+  for (long i=i_min; i<i_max; ++i) {
+
+    // select the objects of the second block close to the object i of the first block
+    const long nClose = m_close_objects_lineOfSight(obj1, i, obj2, (auto_pairs) ? max(j_min, i+1) : j_min, j_max, m_piMin, m_piMax);
+
+    // separations and bins of the selected objects
+    m_Cartesian_close_objects(nClose, obj1, i, obj2);
+    m_bin_close_objects_2D(nClose, m_rpMin, m_rpMax, m_binSize_inv_D1, m_nbins_D1, false, m_piMin, m_piMax, m_binSize_inv_D2, m_nbins_D2, true);
+
+    for (long n=0; n<nClose; ++n) {
+
+      const int ir = m_bin[n];
+      if (ir<0) continue;
+      const int jr = m_bin_D2[n];
+
+      const long j = m_close[n];
+      const double rp = m_dist[n], pi = m_dist_D2[n];
+
+      const double angWeight = (m_angularWeight==nullptr) ? 1.
+        : max(0., m_angularWeight(converted_angle(angular_distance(obj1.xx[i]/obj1.dc[i], obj2.xx[j]/obj2.dc[j], obj1.yy[i]/obj1.dc[i], obj2.yy[j]/obj2.dc[j], obj1.zz[i]/obj1.dc[i], obj2.zz[j]/obj2.dc[j]), CoordinateUnits::_radians_, m_angularUnits)));
+
+      const double WeightTOT = obj1.weight[i]*obj2.weight[j]*angWeight;
+
+      m_PP2D[ir][jr] ++;
+      m_PP2D_weighted[ir][jr] += WeightTOT;
+
+      if (m_PP2D_weighted[ir][jr]>0) {
+
+        const double scale_D1_mean_p = m_scale_D1_mean[ir][jr];
+        const double scale_D2_mean_p = m_scale_D2_mean[ir][jr];
+        m_scale_D1_mean[ir][jr] += WeightTOT/m_PP2D_weighted[ir][jr]*(rp-scale_D1_mean_p);
+        m_scale_D2_mean[ir][jr] += WeightTOT/m_PP2D_weighted[ir][jr]*(pi-scale_D2_mean_p);
+        m_scale_D1_S[ir][jr] += WeightTOT*(rp-scale_D1_mean_p)*(rp-m_scale_D1_mean[ir][jr]);
+        m_scale_D2_S[ir][jr] += WeightTOT*(pi-scale_D2_mean_p)*(pi-m_scale_D2_mean[ir][jr]);
+
+        const double pair_redshift = (obj1.redshift[i]>0 && obj2.redshift[j]>0) ? (obj1.redshift[i]+obj2.redshift[j])*0.5 : -1.;
+        const double z_mean_p = m_z_mean[ir][jr];
+        m_z_mean[ir][jr] += WeightTOT/m_PP2D_weighted[ir][jr]*(pair_redshift-z_mean_p); 
+        m_z_S[ir][jr] += WeightTOT*(pair_redshift-z_mean_p)*(pair_redshift-m_z_mean[ir][jr]);
+
+      }
+    }
+  }
+}
+
+
+// ============================================================================================
+
+
 void cbl::pairs::Pair2D_comovingCartesian_loglin_extra::put (const std::shared_ptr<Object> obj1, const std::shared_ptr<Object> obj2) 
 {
   const double rp = perpendicular_distance(obj1->ra(), obj2->ra(), obj1->dec(), obj2->dec(), obj1->dc(), obj2->dc());
@@ -166,6 +268,57 @@ void cbl::pairs::Pair2D_comovingCartesian_loglin_extra::put (const std::shared_p
 // ============================================================================================
 
 
+void cbl::pairs::Pair2D_comovingCartesian_loglin_extra::put (const chainmesh::CellObjects &obj1, const long i_min, const long i_max, const chainmesh::CellObjects &obj2, const long j_min, const long j_max, const bool auto_pairs)
+{
+  for (long i=i_min; i<i_max; ++i) {
+
+    // select the objects of the second block close to the object i of the first block
+    const long nClose = m_close_objects_lineOfSight(obj1, i, obj2, (auto_pairs) ? max(j_min, i+1) : j_min, j_max, m_piMin, m_piMax);
+
+    // separations and bins of the selected objects
+    m_Cartesian_close_objects(nClose, obj1, i, obj2);
+    m_bin_close_objects_2D(nClose, m_rpMin, m_rpMax, m_binSize_inv_D1, m_nbins_D1, true, m_piMin, m_piMax, m_binSize_inv_D2, m_nbins_D2, false);
+
+    for (long n=0; n<nClose; ++n) {
+
+      const int ir = m_bin[n];
+      if (ir<0) continue;
+      const int jr = m_bin_D2[n];
+
+      const long j = m_close[n];
+      const double rp = m_dist[n], pi = m_dist_D2[n];
+
+      const double angWeight = (m_angularWeight==nullptr) ? 1.
+        : max(0., m_angularWeight(converted_angle(angular_distance(obj1.xx[i]/obj1.dc[i], obj2.xx[j]/obj2.dc[j], obj1.yy[i]/obj1.dc[i], obj2.yy[j]/obj2.dc[j], obj1.zz[i]/obj1.dc[i], obj2.zz[j]/obj2.dc[j]), CoordinateUnits::_radians_, m_angularUnits)));
+
+      const double WeightTOT = obj1.weight[i]*obj2.weight[j]*angWeight;
+
+      m_PP2D[ir][jr] ++;
+      m_PP2D_weighted[ir][jr] += WeightTOT;
+
+      if (m_PP2D_weighted[ir][jr]>0) {
+
+        const double scale_D1_mean_p = m_scale_D1_mean[ir][jr];
+        const double scale_D2_mean_p = m_scale_D2_mean[ir][jr];
+        m_scale_D1_mean[ir][jr] += WeightTOT/m_PP2D_weighted[ir][jr]*(rp-scale_D1_mean_p);
+        m_scale_D2_mean[ir][jr] += WeightTOT/m_PP2D_weighted[ir][jr]*(pi-scale_D2_mean_p);
+        m_scale_D1_S[ir][jr] += WeightTOT*(rp-scale_D1_mean_p)*(rp-m_scale_D1_mean[ir][jr]);
+        m_scale_D2_S[ir][jr] += WeightTOT*(pi-scale_D2_mean_p)*(pi-m_scale_D2_mean[ir][jr]);
+
+        const double pair_redshift = (obj1.redshift[i]>0 && obj2.redshift[j]>0) ? (obj1.redshift[i]+obj2.redshift[j])*0.5 : -1.;
+        const double z_mean_p = m_z_mean[ir][jr];
+        m_z_mean[ir][jr] += WeightTOT/m_PP2D_weighted[ir][jr]*(pair_redshift-z_mean_p); 
+        m_z_S[ir][jr] += WeightTOT*(pair_redshift-z_mean_p)*(pair_redshift-m_z_mean[ir][jr]);
+
+      }
+    }
+  }
+}
+
+
+// ============================================================================================
+
+
 void cbl::pairs::Pair2D_comovingCartesian_loglog_extra::put (const std::shared_ptr<Object> obj1, const std::shared_ptr<Object> obj2) 
 {
   const double rp = perpendicular_distance(obj1->ra(), obj2->ra(), obj1->dec(), obj2->dec(), obj1->dc(), obj2->dc());
@@ -207,6 +360,57 @@ void cbl::pairs::Pair2D_comovingCartesian_loglog_extra::put (const std::shared_p
 // ============================================================================================
 
 
+void cbl::pairs::Pair2D_comovingCartesian_loglog_extra::put (const chainmesh::CellObjects &obj1, const long i_min, const long i_max, const chainmesh::CellObjects &obj2, const long j_min, const long j_max, const bool auto_pairs)
+{
+  for (long i=i_min; i<i_max; ++i) {
+
+    // select the objects of the second block close to the object i of the first block
+    const long nClose = m_close_objects_lineOfSight(obj1, i, obj2, (auto_pairs) ? max(j_min, i+1) : j_min, j_max, m_piMin, m_piMax);
+
+    // separations and bins of the selected objects
+    m_Cartesian_close_objects(nClose, obj1, i, obj2);
+    m_bin_close_objects_2D(nClose, m_rpMin, m_rpMax, m_binSize_inv_D1, m_nbins_D1, true, m_piMin, m_piMax, m_binSize_inv_D2, m_nbins_D2, true);
+
+    for (long n=0; n<nClose; ++n) {
+
+      const int ir = m_bin[n];
+      if (ir<0) continue;
+      const int jr = m_bin_D2[n];
+
+      const long j = m_close[n];
+      const double rp = m_dist[n], pi = m_dist_D2[n];
+
+      const double angWeight = (m_angularWeight==nullptr) ? 1.
+        : max(0., m_angularWeight(converted_angle(angular_distance(obj1.xx[i]/obj1.dc[i], obj2.xx[j]/obj2.dc[j], obj1.yy[i]/obj1.dc[i], obj2.yy[j]/obj2.dc[j], obj1.zz[i]/obj1.dc[i], obj2.zz[j]/obj2.dc[j]), CoordinateUnits::_radians_, m_angularUnits)));
+
+      const double WeightTOT = obj1.weight[i]*obj2.weight[j]*angWeight;
+
+      m_PP2D[ir][jr] ++;
+      m_PP2D_weighted[ir][jr] += WeightTOT;
+
+      if (m_PP2D_weighted[ir][jr]>0) {
+
+        const double scale_D1_mean_p = m_scale_D1_mean[ir][jr];
+        const double scale_D2_mean_p = m_scale_D2_mean[ir][jr];
+        m_scale_D1_mean[ir][jr] += WeightTOT/m_PP2D_weighted[ir][jr]*(rp-scale_D1_mean_p);
+        m_scale_D2_mean[ir][jr] += WeightTOT/m_PP2D_weighted[ir][jr]*(pi-scale_D2_mean_p);
+        m_scale_D1_S[ir][jr] += WeightTOT*(rp-scale_D1_mean_p)*(rp-m_scale_D1_mean[ir][jr]);
+        m_scale_D2_S[ir][jr] += WeightTOT*(pi-scale_D2_mean_p)*(pi-m_scale_D2_mean[ir][jr]);
+
+        const double pair_redshift = (obj1.redshift[i]>0 && obj2.redshift[j]>0) ? (obj1.redshift[i]+obj2.redshift[j])*0.5 : -1.;
+        const double z_mean_p = m_z_mean[ir][jr];
+        m_z_mean[ir][jr] += WeightTOT/m_PP2D_weighted[ir][jr]*(pair_redshift-z_mean_p); 
+        m_z_S[ir][jr] += WeightTOT*(pair_redshift-z_mean_p)*(pair_redshift-m_z_mean[ir][jr]);
+
+      }
+    }
+  }
+}
+
+
+// ============================================================================================
+
+
 void cbl::pairs::Pair2D_comovingPolar_linlin_extra::put (const std::shared_ptr<Object> obj1, const std::shared_ptr<Object> obj2) 
 {
   double rr = Euclidean_distance(obj1->xx(), obj2->xx(), obj1->yy(), obj2->yy(), obj1->zz(), obj2->zz());
@@ -248,6 +452,57 @@ void cbl::pairs::Pair2D_comovingPolar_linlin_extra::put (const std::shared_ptr<O
 // ============================================================================================
 
 
+void cbl::pairs::Pair2D_comovingPolar_linlin_extra::put (const chainmesh::CellObjects &obj1, const long i_min, const long i_max, const chainmesh::CellObjects &obj2, const long j_min, const long j_max, const bool auto_pairs)
+{
+  for (long i=i_min; i<i_max; ++i) {
+
+    // select the objects of the second block close to the object i of the first block
+    const long nClose = m_close_objects_Euclidean(obj1, i, obj2, (auto_pairs) ? max(j_min, i+1) : j_min, j_max, m_rMin, m_rMax);
+
+    // separations and bins of the selected objects
+    m_polar_close_objects(nClose, obj1, i, obj2);
+    m_bin_close_objects_2D(nClose, m_rMin, m_rMax, m_binSize_inv_D1, m_nbins_D1, false, m_muMin, m_muMax, m_binSize_inv_D2, m_nbins_D2, false);
+
+    for (long n=0; n<nClose; ++n) {
+
+      const int ir = m_bin[n];
+      if (ir<0) continue;
+      const int jr = m_bin_D2[n];
+
+      const long j = m_close[n];
+      const double rr = m_dist[n], mu = m_dist_D2[n];
+
+      const double angWeight = (m_angularWeight==nullptr) ? 1.
+        : max(0., m_angularWeight(converted_angle(angular_distance(obj1.xx[i]/obj1.dc[i], obj2.xx[j]/obj2.dc[j], obj1.yy[i]/obj1.dc[i], obj2.yy[j]/obj2.dc[j], obj1.zz[i]/obj1.dc[i], obj2.zz[j]/obj2.dc[j]), CoordinateUnits::_radians_, m_angularUnits)));
+
+      const double WeightTOT = obj1.weight[i]*obj2.weight[j]*angWeight;
+
+      m_PP2D[ir][jr] ++;
+      m_PP2D_weighted[ir][jr] += WeightTOT;
+
+      if (m_PP2D_weighted[ir][jr]>0) {
+
+        const double scale_D1_mean_p = m_scale_D1_mean[ir][jr];
+        const double scale_D2_mean_p = m_scale_D2_mean[ir][jr];
+        m_scale_D1_mean[ir][jr] += WeightTOT/m_PP2D_weighted[ir][jr]*(rr-scale_D1_mean_p);
+        m_scale_D2_mean[ir][jr] += WeightTOT/m_PP2D_weighted[ir][jr]*(mu-scale_D2_mean_p);
+        m_scale_D1_S[ir][jr] += WeightTOT*(rr-scale_D1_mean_p)*(rr-m_scale_D1_mean[ir][jr]);
+        m_scale_D2_S[ir][jr] += WeightTOT*(mu-scale_D2_mean_p)*(mu-m_scale_D2_mean[ir][jr]);
+
+        const double pair_redshift = (obj1.redshift[i]>0 && obj2.redshift[j]>0) ? (obj1.redshift[i]+obj2.redshift[j])*0.5 : -1.;
+        const double z_mean_p = m_z_mean[ir][jr];
+        m_z_mean[ir][jr] += WeightTOT/m_PP2D_weighted[ir][jr]*(pair_redshift-z_mean_p); 
+        m_z_S[ir][jr] += WeightTOT*(pair_redshift-z_mean_p)*(pair_redshift-m_z_mean[ir][jr]);
+
+      }
+    }
+  }
+}
+
+
+// ============================================================================================
+
+
 void cbl::pairs::Pair2D_comovingPolar_linlog_extra::put (const std::shared_ptr<Object> obj1, const std::shared_ptr<Object> obj2) 
 {
   double rr = Euclidean_distance(obj1->xx(), obj2->xx(), obj1->yy(), obj2->yy(), obj1->zz(), obj2->zz());
@@ -289,6 +544,57 @@ void cbl::pairs::Pair2D_comovingPolar_linlog_extra::put (const std::shared_ptr<O
 // ============================================================================================
 
 
+void cbl::pairs::Pair2D_comovingPolar_linlog_extra::put (const chainmesh::CellObjects &obj1, const long i_min, const long i_max, const chainmesh::CellObjects &obj2, const long j_min, const long j_max, const bool auto_pairs)
+{
+  for (long i=i_min; i<i_max; ++i) {
+
+    // select the objects of the second block close to the object i of the first block
+    const long nClose = m_close_objects_Euclidean(obj1, i, obj2, (auto_pairs) ? max(j_min, i+1) : j_min, j_max, m_rMin, m_rMax);
+
+    // separations and bins of the selected objects
+    m_polar_close_objects(nClose, obj1, i, obj2);
+    m_bin_close_objects_2D(nClose, m_rMin, m_rMax, m_binSize_inv_D1, m_nbins_D1, false, m_muMin, m_muMax, m_binSize_inv_D2, m_nbins_D2, true);
+
+    for (long n=0; n<nClose; ++n) {
+
+      const int ir = m_bin[n];
+      if (ir<0) continue;
+      const int jr = m_bin_D2[n];
+
+      const long j = m_close[n];
+      const double rr = m_dist[n], mu = m_dist_D2[n];
+
+      const double angWeight = (m_angularWeight==nullptr) ? 1.
+        : max(0., m_angularWeight(converted_angle(angular_distance(obj1.xx[i]/obj1.dc[i], obj2.xx[j]/obj2.dc[j], obj1.yy[i]/obj1.dc[i], obj2.yy[j]/obj2.dc[j], obj1.zz[i]/obj1.dc[i], obj2.zz[j]/obj2.dc[j]), CoordinateUnits::_radians_, m_angularUnits)));
+
+      const double WeightTOT = obj1.weight[i]*obj2.weight[j]*angWeight;
+
+      m_PP2D[ir][jr] ++;
+      m_PP2D_weighted[ir][jr] += WeightTOT;
+
+      if (m_PP2D_weighted[ir][jr]>0) {
+
+        const double scale_D1_mean_p = m_scale_D1_mean[ir][jr];
+        const double scale_D2_mean_p = m_scale_D2_mean[ir][jr];
+        m_scale_D1_mean[ir][jr] += WeightTOT/m_PP2D_weighted[ir][jr]*(rr-scale_D1_mean_p);
+        m_scale_D2_mean[ir][jr] += WeightTOT/m_PP2D_weighted[ir][jr]*(mu-scale_D2_mean_p);
+        m_scale_D1_S[ir][jr] += WeightTOT*(rr-scale_D1_mean_p)*(rr-m_scale_D1_mean[ir][jr]);
+        m_scale_D2_S[ir][jr] += WeightTOT*(mu-scale_D2_mean_p)*(mu-m_scale_D2_mean[ir][jr]);
+
+        const double pair_redshift = (obj1.redshift[i]>0 && obj2.redshift[j]>0) ? (obj1.redshift[i]+obj2.redshift[j])*0.5 : -1.;
+        const double z_mean_p = m_z_mean[ir][jr];
+        m_z_mean[ir][jr] += WeightTOT/m_PP2D_weighted[ir][jr]*(pair_redshift-z_mean_p); 
+        m_z_S[ir][jr] += WeightTOT*(pair_redshift-z_mean_p)*(pair_redshift-m_z_mean[ir][jr]);
+
+      }
+    }
+  }
+}
+
+
+// ============================================================================================
+
+
 void cbl::pairs::Pair2D_comovingPolar_loglin_extra::put (const std::shared_ptr<Object> obj1, const std::shared_ptr<Object> obj2) 
 {
   double rr = Euclidean_distance(obj1->xx(), obj2->xx(), obj1->yy(), obj2->yy(), obj1->zz(), obj2->zz());
@@ -330,6 +636,57 @@ void cbl::pairs::Pair2D_comovingPolar_loglin_extra::put (const std::shared_ptr<O
 // ============================================================================================
 
 
+void cbl::pairs::Pair2D_comovingPolar_loglin_extra::put (const chainmesh::CellObjects &obj1, const long i_min, const long i_max, const chainmesh::CellObjects &obj2, const long j_min, const long j_max, const bool auto_pairs)
+{
+  for (long i=i_min; i<i_max; ++i) {
+
+    // select the objects of the second block close to the object i of the first block
+    const long nClose = m_close_objects_Euclidean(obj1, i, obj2, (auto_pairs) ? max(j_min, i+1) : j_min, j_max, m_rMin, m_rMax);
+
+    // separations and bins of the selected objects
+    m_polar_close_objects(nClose, obj1, i, obj2);
+    m_bin_close_objects_2D(nClose, m_rMin, m_rMax, m_binSize_inv_D1, m_nbins_D1, true, m_muMin, m_muMax, m_binSize_inv_D2, m_nbins_D2, false);
+
+    for (long n=0; n<nClose; ++n) {
+
+      const int ir = m_bin[n];
+      if (ir<0) continue;
+      const int jr = m_bin_D2[n];
+
+      const long j = m_close[n];
+      const double rr = m_dist[n], mu = m_dist_D2[n];
+
+      const double angWeight = (m_angularWeight==nullptr) ? 1.
+        : max(0., m_angularWeight(converted_angle(angular_distance(obj1.xx[i]/obj1.dc[i], obj2.xx[j]/obj2.dc[j], obj1.yy[i]/obj1.dc[i], obj2.yy[j]/obj2.dc[j], obj1.zz[i]/obj1.dc[i], obj2.zz[j]/obj2.dc[j]), CoordinateUnits::_radians_, m_angularUnits)));
+
+      const double WeightTOT = obj1.weight[i]*obj2.weight[j]*angWeight;
+
+      m_PP2D[ir][jr] ++;
+      m_PP2D_weighted[ir][jr] += WeightTOT;
+
+      if (m_PP2D_weighted[ir][jr]>0) {
+
+        const double scale_D1_mean_p = m_scale_D1_mean[ir][jr];
+        const double scale_D2_mean_p = m_scale_D2_mean[ir][jr];
+        m_scale_D1_mean[ir][jr] += WeightTOT/m_PP2D_weighted[ir][jr]*(rr-scale_D1_mean_p);
+        m_scale_D2_mean[ir][jr] += WeightTOT/m_PP2D_weighted[ir][jr]*(mu-scale_D2_mean_p);
+        m_scale_D1_S[ir][jr] += WeightTOT*(rr-scale_D1_mean_p)*(rr-m_scale_D1_mean[ir][jr]);
+        m_scale_D2_S[ir][jr] += WeightTOT*(mu-scale_D2_mean_p)*(mu-m_scale_D2_mean[ir][jr]);
+
+        const double pair_redshift = (obj1.redshift[i]>0 && obj2.redshift[j]>0) ? (obj1.redshift[i]+obj2.redshift[j])*0.5 : -1.;
+        const double z_mean_p = m_z_mean[ir][jr];
+        m_z_mean[ir][jr] += WeightTOT/m_PP2D_weighted[ir][jr]*(pair_redshift-z_mean_p); 
+        m_z_S[ir][jr] += WeightTOT*(pair_redshift-z_mean_p)*(pair_redshift-m_z_mean[ir][jr]);
+
+      }
+    }
+  }
+}
+
+
+// ============================================================================================
+
+
 void cbl::pairs::Pair2D_comovingPolar_loglog_extra::put (const std::shared_ptr<Object> obj1, const std::shared_ptr<Object> obj2) 
 {
   double rr = Euclidean_distance(obj1->xx(), obj2->xx(), obj1->yy(), obj2->yy(), obj1->zz(), obj2->zz());
@@ -371,7 +728,81 @@ void cbl::pairs::Pair2D_comovingPolar_loglog_extra::put (const std::shared_ptr<O
 // ============================================================================================
 
 
+void cbl::pairs::Pair2D_comovingPolar_loglog_extra::put (const chainmesh::CellObjects &obj1, const long i_min, const long i_max, const chainmesh::CellObjects &obj2, const long j_min, const long j_max, const bool auto_pairs)
+{
+  for (long i=i_min; i<i_max; ++i) {
+
+    // select the objects of the second block close to the object i of the first block
+    const long nClose = m_close_objects_Euclidean(obj1, i, obj2, (auto_pairs) ? max(j_min, i+1) : j_min, j_max, m_rMin, m_rMax);
+
+    // separations and bins of the selected objects
+    m_polar_close_objects(nClose, obj1, i, obj2);
+    m_bin_close_objects_2D(nClose, m_rMin, m_rMax, m_binSize_inv_D1, m_nbins_D1, true, m_muMin, m_muMax, m_binSize_inv_D2, m_nbins_D2, true);
+
+    for (long n=0; n<nClose; ++n) {
+
+      const int ir = m_bin[n];
+      if (ir<0) continue;
+      const int jr = m_bin_D2[n];
+
+      const long j = m_close[n];
+      const double rr = m_dist[n], mu = m_dist_D2[n];
+
+      const double angWeight = (m_angularWeight==nullptr) ? 1.
+        : max(0., m_angularWeight(converted_angle(angular_distance(obj1.xx[i]/obj1.dc[i], obj2.xx[j]/obj2.dc[j], obj1.yy[i]/obj1.dc[i], obj2.yy[j]/obj2.dc[j], obj1.zz[i]/obj1.dc[i], obj2.zz[j]/obj2.dc[j]), CoordinateUnits::_radians_, m_angularUnits)));
+
+      const double WeightTOT = obj1.weight[i]*obj2.weight[j]*angWeight;
+
+      m_PP2D[ir][jr] ++;
+      m_PP2D_weighted[ir][jr] += WeightTOT;
+
+      if (m_PP2D_weighted[ir][jr]>0) {
+
+        const double scale_D1_mean_p = m_scale_D1_mean[ir][jr];
+        const double scale_D2_mean_p = m_scale_D2_mean[ir][jr];
+        m_scale_D1_mean[ir][jr] += WeightTOT/m_PP2D_weighted[ir][jr]*(rr-scale_D1_mean_p);
+        m_scale_D2_mean[ir][jr] += WeightTOT/m_PP2D_weighted[ir][jr]*(mu-scale_D2_mean_p);
+        m_scale_D1_S[ir][jr] += WeightTOT*(rr-scale_D1_mean_p)*(rr-m_scale_D1_mean[ir][jr]);
+        m_scale_D2_S[ir][jr] += WeightTOT*(mu-scale_D2_mean_p)*(mu-m_scale_D2_mean[ir][jr]);
+
+        const double pair_redshift = (obj1.redshift[i]>0 && obj2.redshift[j]>0) ? (obj1.redshift[i]+obj2.redshift[j])*0.5 : -1.;
+        const double z_mean_p = m_z_mean[ir][jr];
+        m_z_mean[ir][jr] += WeightTOT/m_PP2D_weighted[ir][jr]*(pair_redshift-z_mean_p); 
+        m_z_S[ir][jr] += WeightTOT*(pair_redshift-z_mean_p)*(pair_redshift-m_z_mean[ir][jr]);
+
+      }
+    }
+  }
+}
+
+
+// ============================================================================================
+
+
 void cbl::pairs::Pair2D_extra::add_data2D (const int i, const int j, const std::vector<double> data)
+{
+  add_data2D(i, j, data[0], data[1], {data[2], data[3], data[4], data[5], data[6], data[7]});
+}
+
+
+// ============================================================================================
+
+
+void cbl::pairs::Pair2D_extra::add_data2D (const int i, const int j, const std::shared_ptr<pairs::Pair> pair, const double ww)
+{
+  const vector<double> extra = {pair->scale_D1_mean(i, j), pair->scale_D1_S(i, j), pair->scale_D2_mean(i, j), pair->scale_D2_S(i, j), pair->z_mean(i, j), pair->z_S(i, j)};
+  
+  if (ww==1.)
+    add_data2D(i, j, pair->PP2D_exact(i, j), pair->PP2D_weighted_exact(i, j), extra);
+  else
+    add_data2D(i, j, ww*pair->PP2D(i, j), ww*pair->PP2D_weighted(i, j), extra);
+}
+
+
+// ============================================================================================
+
+
+void cbl::pairs::Pair2D_extra::add_data2D (const int i, const int j, const ExactSum pp, const ExactSum pp_weighted, const std::vector<double> extra)
 {
   /*
     checkDim(m_PP2D, i, j, "m_PP2D", false);
@@ -382,7 +813,7 @@ void cbl::pairs::Pair2D_extra::add_data2D (const int i, const int j, const std::
     checkDim(m_scale_D2_sigma, i, j, "m_scale_D2_sigma", false);
     checkDim(m_z_mean, i, j, "m_z_mean", false);
     checkDim(m_z_sigma, i, j, "m_z_sigma", false);
-    checkDim(data, 8, "data");
+    checkDim(extra, 6, "extra");
   */
       
   // mean scale in the first dimension up to this computation step
@@ -395,34 +826,36 @@ void cbl::pairs::Pair2D_extra::add_data2D (const int i, const int j, const std::
   const double z_mean_temp_p = m_z_mean[i][j];
       
   // number of pairs 
-  m_PP2D[i][j] += data[0];
+  m_PP2D[i][j] += pp;
 
   // number of weighted pairs
-  m_PP2D_weighted[i][j] += data[1];
+  m_PP2D_weighted[i][j] += pp_weighted;
 
+  // the extra information is averaged with the weighted number of pairs rounded to double
+  const double weight = pp_weighted, weight_tot = m_PP2D_weighted[i][j];
 
-  if (m_PP2D_weighted[i][j]>0) {
+  if (weight_tot>0) {
 
     // mean separation in the first dimension
-    m_scale_D1_mean[i][j] += data[1]/m_PP2D_weighted[i][j]*(data[2]-scale_D1_mean_temp_p);
+    m_scale_D1_mean[i][j] += weight/weight_tot*(extra[0]-scale_D1_mean_temp_p);
     
     // mean separation in the first dimension
-    m_scale_D2_mean[i][j] += data[1]/m_PP2D_weighted[i][j]*(data[4]-scale_D2_mean_temp_p);
+    m_scale_D2_mean[i][j] += weight/weight_tot*(extra[2]-scale_D2_mean_temp_p);
     
     // mean redshift
-    m_z_mean[i][j] += data[1]/m_PP2D_weighted[i][j]*(data[6]-z_mean_temp_p);
+    m_z_mean[i][j] += weight/weight_tot*(extra[4]-z_mean_temp_p);
     
     // compute the weighted standard deviation of the scale distribution in the first dimension
-    m_scale_D1_S[i][j] += data[3]+pow(data[2]-scale_D1_mean_temp_p, 2)*data[1]*(m_PP2D_weighted[i][j]-data[1])/m_PP2D_weighted[i][j];
-    m_scale_D1_sigma[i][j] = sqrt(m_scale_D1_S[i][j]/m_PP2D_weighted[i][j]);
+    m_scale_D1_S[i][j] += extra[1]+pow(extra[0]-scale_D1_mean_temp_p, 2)*weight*(weight_tot-weight)/weight_tot;
+    m_scale_D1_sigma[i][j] = sqrt(m_scale_D1_S[i][j]/weight_tot);
 
     // compute the weighted standard deviation of the scale distribution in the second dimension
-    m_scale_D2_S[i][j] += data[5]+pow(data[4]-scale_D2_mean_temp_p, 2)*data[1]*(m_PP2D_weighted[i][j]-data[1])/m_PP2D_weighted[i][j];
-    m_scale_D2_sigma[i][j] = sqrt(m_scale_D2_S[i][j]/m_PP2D_weighted[i][j]);
+    m_scale_D2_S[i][j] += extra[3]+pow(extra[2]-scale_D2_mean_temp_p, 2)*weight*(weight_tot-weight)/weight_tot;
+    m_scale_D2_sigma[i][j] = sqrt(m_scale_D2_S[i][j]/weight_tot);
 
     // compute the weighted standard deviation of the redshift distribution
-    m_z_S[i][j] += data[7]+pow(data[6]-z_mean_temp_p, 2)*data[1]*(m_PP2D_weighted[i][j]-data[1])/m_PP2D_weighted[i][j];
-    m_z_sigma[i][j] = sqrt(m_z_S[i][j]/m_PP2D_weighted[i][j]);
+    m_z_S[i][j] += extra[5]+pow(extra[4]-z_mean_temp_p, 2)*weight*(weight_tot-weight)/weight_tot;
+    m_z_sigma[i][j] = sqrt(m_z_S[i][j]/weight_tot);
     
   }
 
@@ -432,15 +865,6 @@ void cbl::pairs::Pair2D_extra::add_data2D (const int i, const int j, const std::
 // ============================================================================================
 
 
-void cbl::pairs::Pair2D_extra::add_data2D (const int i, const int j, const std::shared_ptr<pairs::Pair> pair, const double ww)
-{
-  add_data2D(i, j, {ww*pair->PP2D(i, j), ww*pair->PP2D_weighted(i, j), pair->scale_D1_mean(i, j), pair->scale_D1_S(i, j), pair->scale_D2_mean(i, j), pair->scale_D2_S(i, j), pair->z_mean(i, j), pair->z_S(i, j)});
-}
-
-
-// ============================================================================================
-
-
 void cbl::pairs::Pair2D_extra::Sum (const std::shared_ptr<Pair> pair, const double ww)
 {
   if (m_nbins_D1 != pair->nbins_D1() || m_nbins_D2 != pair->nbins_D2()) 
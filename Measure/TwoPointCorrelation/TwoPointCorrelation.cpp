@@ -40,6 +40,7 @@
 #include "TwoPointCorrelation_multipoles_direct.h"
 #include "TwoPointCorrelation_multipoles_integrated.h"
 #include "TwoPointCorrelation_wedges.h"
+#include "Field3D.h"
 
 using namespace std;
 
@@ -54,13 +55,13 @@ using namespace measure::twopt;
 // ============================================================================
 
 
-shared_ptr<TwoPointCorrelation> cbl::measure::twopt::TwoPointCorrelation::Create (const TwoPType type, const catalogue::Catalogue data, const catalogue::Catalogue random, const BinType binType, const double Min, const double Max, const int nbins, const double shift, const CoordinateUnits angularUnits, std::function<double(double)> angularWeight, const bool compute_extra_info, const double random_dilution_fraction)
+shared_ptr<TwoPointCorrelation> cbl::measure::twopt::TwoPointCorrelation::Create (const TwoPType type, const catalogue::Catalogue &data, const catalogue::Catalogue &random, const BinType binType, const double Min, const double Max, const int nbins, const double shift, const CoordinateUnits angularUnits, std::function<double(double)> angularWeight, const bool compute_extra_info, const double random_dilution_fraction, const chainmesh::SpatialIndex spatialIndex)
 {
-  if (type==TwoPType::_angular_) return move(unique_ptr<TwoPointCorrelation1D_angular>(new TwoPointCorrelation1D_angular(data, random, binType, Min, Max, nbins, shift, angularUnits, angularWeight, compute_extra_info, random_dilution_fraction)));
+  if (type==TwoPType::_angular_) return move(unique_ptr<TwoPointCorrelation1D_angular>(new TwoPointCorrelation1D_angular(data, random, binType, Min, Max, nbins, shift, angularUnits, angularWeight, compute_extra_info, random_dilution_fraction, spatialIndex)));
   
-  else if (type==TwoPType::_monopole_) return move(unique_ptr<TwoPointCorrelation1D_monopole>(new TwoPointCorrelation1D_monopole(data, random, binType, Min, Max, nbins, shift, angularUnits, angularWeight, compute_extra_info, random_dilution_fraction)));
+  else if (type==TwoPType::_monopole_) return move(unique_ptr<TwoPointCorrelation1D_monopole>(new TwoPointCorrelation1D_monopole(data, random, binType, Min, Max, nbins, shift, angularUnits, angularWeight, compute_extra_info, random_dilution_fraction, spatialIndex)));
 
-  else if (type==TwoPType::_multipoles_direct_) return move(unique_ptr<TwoPointCorrelation_multipoles_direct>(new TwoPointCorrelation_multipoles_direct(data, random, binType, Min, Max, nbins, shift, angularUnits, angularWeight, compute_extra_info, random_dilution_fraction)));
+  else if (type==TwoPType::_multipoles_direct_) return move(unique_ptr<TwoPointCorrelation_multipoles_direct>(new TwoPointCorrelation_multipoles_direct(data, random, binType, Min, Max, nbins, shift, angularUnits, angularWeight, compute_extra_info, random_dilution_fraction, spatialIndex)));
   
   else ErrorCBL("Error in cbl::measure::twopt::TwoPointCorrelation::Create of TwoPointCorrelation.cpp: no such type of object, or error in the input parameters!");
   
@@ -71,13 +72,13 @@ shared_ptr<TwoPointCorrelation> cbl::measure::twopt::TwoPointCorrelation::Create
 // ============================================================================
 
 
-shared_ptr<TwoPointCorrelation> cbl::measure::twopt::TwoPointCorrelation::Create (const TwoPType type, const catalogue::Catalogue data, const catalogue::Catalogue random, const BinType binType, const double Min, const double Max, const double binSize, const double shift, const CoordinateUnits angularUnits, std::function<double(double)> angularWeight, const bool compute_extra_info, const double random_dilution_fraction)
+shared_ptr<TwoPointCorrelation> cbl::measure::twopt::TwoPointCorrelation::Create (const TwoPType type, const catalogue::Catalogue &data, const catalogue::Catalogue &random, const BinType binType, const double Min, const double Max, const double binSize, const double shift, const CoordinateUnits angularUnits, std::function<double(double)> angularWeight, const bool compute_extra_info, const double random_dilution_fraction, const chainmesh::SpatialIndex spatialIndex)
 {
-  if (type==TwoPType::_angular_) return move(unique_ptr<TwoPointCorrelation1D_angular>(new TwoPointCorrelation1D_angular(data, random, binType, Min, Max, binSize, shift, angularUnits, angularWeight, compute_extra_info, random_dilution_fraction)));
+  if (type==TwoPType::_angular_) return move(unique_ptr<TwoPointCorrelation1D_angular>(new TwoPointCorrelation1D_angular(data, random, binType, Min, Max, binSize, shift, angularUnits, angularWeight, compute_extra_info, random_dilution_fraction, spatialIndex)));
   
-  else if (type==TwoPType::_monopole_) return move(unique_ptr<TwoPointCorrelation1D_monopole>(new TwoPointCorrelation1D_monopole(data, random, binType, Min, Max, binSize, shift, angularUnits, angularWeight, compute_extra_info, random_dilution_fraction)));
+  else if (type==TwoPType::_monopole_) return move(unique_ptr<TwoPointCorrelation1D_monopole>(new TwoPointCorrelation1D_monopole(data, random, binType, Min, Max, binSize, shift, angularUnits, angularWeight, compute_extra_info, random_dilution_fraction, spatialIndex)));
 
-  else if (type==TwoPType::_multipoles_direct_) return move(unique_ptr<TwoPointCorrelation_multipoles_direct>(new TwoPointCorrelation_multipoles_direct(data, random, binType, Min, Max, binSize, shift, angularUnits, angularWeight, compute_extra_info, random_dilution_fraction)));
+  else if (type==TwoPType::_multipoles_direct_) return move(unique_ptr<TwoPointCorrelation_multipoles_direct>(new TwoPointCorrelation_multipoles_direct(data, random, binType, Min, Max, binSize, shift, angularUnits, angularWeight, compute_extra_info, random_dilution_fraction, spatialIndex)));
   
   else ErrorCBL("Error in cbl::measure::twopt::TwoPointCorrelation::Create of TwoPointCorrelation.cpp: no such type of object, or error in the input parameters!");
   
@@ -88,11 +89,11 @@ shared_ptr<TwoPointCorrelation> cbl::measure::twopt::TwoPointCorrelation::Create
 // ============================================================================
 
 
-shared_ptr<TwoPointCorrelation> cbl::measure::twopt::TwoPointCorrelation::Create (const TwoPType type, const catalogue::Catalogue data, const catalogue::Catalogue random, const BinType binType_D1, const double Min_D1, const double Max_D1, const int nbins_D1, const double shift_D1, const double Min_D2, const double Max_D2, const int nbins_D2, const double shift_D2, const CoordinateUnits angularUnits, std::function<double(double)> angularWeight, const bool compute_extra_info, const double random_dilution_fraction)
+shared_ptr<TwoPointCorrelation> cbl::measure::twopt::TwoPointCorrelation::Create (const TwoPType type, const catalogue::Catalogue &data, const catalogue::Catalogue &random, const BinType binType_D1, const double Min_D1, const double Max_D1, const int nbins_D1, const double shift_D1, const double Min_D2, const double Max_D2, const int nbins_D2, const double shift_D2, const CoordinateUnits angularUnits, std::function<double(double)> angularWeight, const bool compute_extra_info, const double random_dilution_fraction, const chainmesh::SpatialIndex spatialIndex)
 {
-  if (type==TwoPType::_multipoles_integrated_) return move(unique_ptr<TwoPointCorrelation_multipoles_integrated>(new TwoPointCorrelation_multipoles_integrated(data, random, binType_D1, Min_D1, Max_D1, nbins_D1, shift_D1, Min_D2, Max_D2, nbins_D2, shift_D2, angularUnits, angularWeight, compute_extra_info, random_dilution_fraction)));
+  if (type==TwoPType::_multipoles_integrated_) return move(unique_ptr<TwoPointCorrelation_multipoles_integrated>(new TwoPointCorrelation_multipoles_integrated(data, random, binType_D1, Min_D1, Max_D1, nbins_D1, shift_D1, Min_D2, Max_D2, nbins_D2, shift_D2, angularUnits, angularWeight, compute_extra_info, random_dilution_fraction, spatialIndex)));
   
-  else if (type==TwoPType::_filtered_) return move(unique_ptr<TwoPointCorrelation1D_filtered>(new TwoPointCorrelation1D_filtered(data, random, binType_D1, Min_D1, Max_D1, nbins_D1, shift_D1, Min_D2, Max_D2, nbins_D2, shift_D2, angularUnits, angularWeight, compute_extra_info, random_dilution_fraction)));
+  else if (type==TwoPType::_filtered_) return move(unique_ptr<TwoPointCorrelation1D_filtered>(new TwoPointCorrelation1D_filtered(data, random, binType_D1, Min_D1, Max_D1, nbins_D1, shift_D1, Min_D2, Max_D2, nbins_D2, shift_D2, angularUnits, angularWeight, compute_extra_info, random_dilution_fraction, spatialIndex)));
   
   else ErrorCBL("Error in cbl::measure::twopt::TwoPointCorrelation::Create of TwoPointCorrelation.cpp: no such type of object, or error in the input parameters!!");
   
@@ -103,11 +104,11 @@ shared_ptr<TwoPointCorrelation> cbl::measure::twopt::TwoPointCorrelation::Create
 // ============================================================================
 
 
-shared_ptr<TwoPointCorrelation> cbl::measure::twopt::TwoPointCorrelation::Create (const TwoPType type, const catalogue::Catalogue data, const catalogue::Catalogue random, const BinType binType_D1, const double Min_D1, const double Max_D1, const double binSize_D1, const double shift_D1, const double Min_D2, const double Max_D2, const double binSize_D2, const double shift_D2, const CoordinateUnits angularUnits, std::function<double(double)> angularWeight, const bool compute_extra_info, const double random_dilution_fraction)
+shared_ptr<TwoPointCorrelation> cbl::measure::twopt::TwoPointCorrelation::Create (const TwoPType type, const catalogue::Catalogue &data, const catalogue::Catalogue &random, const BinType binType_D1, const double Min_D1, const double Max_D1, const double binSize_D1, const double shift_D1, const double Min_D2, const double Max_D2, const double binSize_D2, const double shift_D2, const CoordinateUnits angularUnits, std::function<double(double)> angularWeight, const bool compute_extra_info, const double random_dilution_fraction, const chainmesh::SpatialIndex spatialIndex)
 {
-  if (type==TwoPType::_multipoles_integrated_) return move(unique_ptr<TwoPointCorrelation_multipoles_integrated>(new TwoPointCorrelation_multipoles_integrated(data, random, binType_D1, Min_D1, Max_D1, binSize_D1, shift_D1, Min_D2, Max_D2, binSize_D2, shift_D2, angularUnits, angularWeight, compute_extra_info, random_dilution_fraction)));
+  if (type==TwoPType::_multipoles_integrated_) return move(unique_ptr<TwoPointCorrelation_multipoles_integrated>(new TwoPointCorrelation_multipoles_integrated(data, random, binType_D1, Min_D1, Max_D1, binSize_D1, shift_D1, Min_D2, Max_D2, binSize_D2, shift_D2, angularUnits, angularWeight, compute_extra_info, random_dilution_fraction, spatialIndex)));
 
-  else if (type==TwoPType::_filtered_) return move(unique_ptr<TwoPointCorrelation1D_filtered>(new TwoPointCorrelation1D_filtered(data, random, binType_D1, Min_D1, Max_D1, binSize_D1, shift_D1, Min_D2, Max_D2, binSize_D2, shift_D2, angularUnits, angularWeight, compute_extra_info, random_dilution_fraction)));
+  else if (type==TwoPType::_filtered_) return move(unique_ptr<TwoPointCorrelation1D_filtered>(new TwoPointCorrelation1D_filtered(data, random, binType_D1, Min_D1, Max_D1, binSize_D1, shift_D1, Min_D2, Max_D2, binSize_D2, shift_D2, angularUnits, angularWeight, compute_extra_info, random_dilution_fraction, spatialIndex)));
   
   else ErrorCBL("Error in cbl::measure::twopt::TwoPointCorrelation::Create of TwoPointCorrelation.cpp: no such type of object, or error in the input parameters!!");
   
@@ -118,11 +119,11 @@ shared_ptr<TwoPointCorrelation> cbl::measure::twopt::TwoPointCorrelation::Create
 // ============================================================================
 
 
-shared_ptr<TwoPointCorrelation> cbl::measure::twopt::TwoPointCorrelation::Create (const TwoPType type, const catalogue::Catalogue data, const catalogue::Catalogue random, const BinType binType_D1, const double Min_D1, const double Max_D1, const int nbins_D1, const double shift_D1, const double Min_D2, const double Max_D2, const int nbins_D2, const double shift_D2, const double piMax_integral, const CoordinateUnits angularUnits, std::function<double(double)> angularWeight, const bool compute_extra_info, const double random_dilution_fraction)
+shared_ptr<TwoPointCorrelation> cbl::measure::twopt::TwoPointCorrelation::Create (const TwoPType type, const catalogue::Catalogue &data, const catalogue::Catalogue &random, const BinType binType_D1, const double Min_D1, const double Max_D1, const int nbins_D1, const double shift_D1, const double Min_D2, const double Max_D2, const int nbins_D2, const double shift_D2, const double piMax_integral, const CoordinateUnits angularUnits, std::function<double(double)> angularWeight, const bool compute_extra_info, const double random_dilution_fraction, const chainmesh::SpatialIndex spatialIndex)
 {
-  if (type==TwoPType::_projected_) return move(unique_ptr<TwoPointCorrelation_projected>(new TwoPointCorrelation_projected(data, random, binType_D1, Min_D1, Max_D1, nbins_D1, shift_D1, Min_D2, Max_D2, nbins_D2, shift_D2, piMax_integral, angularUnits, angularWeight, compute_extra_info, random_dilution_fraction)));
+  if (type==TwoPType::_projected_) return move(unique_ptr<TwoPointCorrelation_projected>(new TwoPointCorrelation_projected(data, random, binType_D1, Min_D1, Max_D1, nbins_D1, shift_D1, Min_D2, Max_D2, nbins_D2, shift_D2, piMax_integral, angularUnits, angularWeight, compute_extra_info, random_dilution_fraction, spatialIndex)));
 
-  else if (type==TwoPType::_deprojected_) return move(unique_ptr<TwoPointCorrelation_deprojected>(new TwoPointCorrelation_deprojected(data, random, Min_D1, Max_D1, nbins_D1, shift_D1, Min_D2, Max_D2, nbins_D2, shift_D2, piMax_integral, angularUnits, angularWeight, compute_extra_info, random_dilution_fraction)));
+  else if (type==TwoPType::_deprojected_) return move(unique_ptr<TwoPointCorrelation_deprojected>(new TwoPointCorrelation_deprojected(data, random, Min_D1, Max_D1, nbins_D1, shift_D1, Min_D2, Max_D2, nbins_D2, shift_D2, piMax_integral, angularUnits, angularWeight, compute_extra_info, random_dilution_fraction, spatialIndex)));
   
   else ErrorCBL("Error in cbl::measure::twopt::TwoPointCorrelation::Create of TwoPointCorrelation.cpp: no such type of object, or error in the input parameters!!");
   
@@ -133,11 +134,11 @@ shared_ptr<TwoPointCorrelation> cbl::measure::twopt::TwoPointCorrelation::Create
 // ============================================================================
 
 
-shared_ptr<TwoPointCorrelation> cbl::measure::twopt::TwoPointCorrelation::Create (const TwoPType type, const catalogue::Catalogue data, const catalogue::Catalogue random, const BinType binType_D1, const double Min_D1, const double Max_D1, const double binSize_D1, const double shift_D1, const double Min_D2, const double Max_D2, const double binSize_D2, const double shift_D2, const double piMax_integral, const CoordinateUnits angularUnits, std::function<double(double)> angularWeight, const bool compute_extra_info, const double random_dilution_fraction)
+shared_ptr<TwoPointCorrelation> cbl::measure::twopt::TwoPointCorrelation::Create (const TwoPType type, const catalogue::Catalogue &data, const catalogue::Catalogue &random, const BinType binType_D1, const double Min_D1, const double Max_D1, const double binSize_D1, const double shift_D1, const double Min_D2, const double Max_D2, const double binSize_D2, const double shift_D2, const double piMax_integral, const CoordinateUnits angularUnits, std::function<double(double)> angularWeight, const bool compute_extra_info, const double random_dilution_fraction, const chainmesh::SpatialIndex spatialIndex)
 {
-  if (type==TwoPType::_projected_) return move(unique_ptr<TwoPointCorrelation_projected>(new TwoPointCorrelation_projected(data, random, binType_D1, Min_D1, Max_D1, binSize_D1, shift_D1, Min_D2, Max_D2, binSize_D2, shift_D2, piMax_integral, angularUnits, angularWeight, compute_extra_info, random_dilution_fraction)));
+  if (type==TwoPType::_projected_) return move(unique_ptr<TwoPointCorrelation_projected>(new TwoPointCorrelation_projected(data, random, binType_D1, Min_D1, Max_D1, binSize_D1, shift_D1, Min_D2, Max_D2, binSize_D2, shift_D2, piMax_integral, angularUnits, angularWeight, compute_extra_info, random_dilution_fraction, spatialIndex)));
 
-  else if (type==TwoPType::_deprojected_) return move(unique_ptr<TwoPointCorrelation_deprojected>(new TwoPointCorrelation_deprojected(data, random, Min_D1, Max_D1, binSize_D1, shift_D1, Min_D2, Max_D2, binSize_D2, shift_D2, piMax_integral, angularUnits, angularWeight, compute_extra_info, random_dilution_fraction)));
+  else if (type==TwoPType::_deprojected_) return move(unique_ptr<TwoPointCorrelation_deprojected>(new TwoPointCorrelation_deprojected(data, random, Min_D1, Max_D1, binSize_D1, shift_D1, Min_D2, Max_D2, binSize_D2, shift_D2, piMax_integral, angularUnits, angularWeight, compute_extra_info, random_dilution_fraction, spatialIndex)));
   
   else ErrorCBL("Error in cbl::measure::twopt::TwoPointCorrelation::Create of TwoPointCorrelation.cpp: no such type of object, or error in the input parameters!!");
   
@@ -148,9 +149,9 @@ shared_ptr<TwoPointCorrelation> cbl::measure::twopt::TwoPointCorrelation::Create
 // ============================================================================
 
 
-shared_ptr<TwoPointCorrelation> cbl::measure::twopt::TwoPointCorrelation::Create (const TwoPType type, const catalogue::Catalogue data, const catalogue::Catalogue random, const BinType binType_D1, const double Min_D1, const double Max_D1, const int nbins_D1, const double shift_D1, const int nWedges, const int nbins_D2, const double shift_D2, const CoordinateUnits angularUnits, std::function<double(double)> angularWeight, const bool compute_extra_info, const double random_dilution_fraction)
+shared_ptr<TwoPointCorrelation> cbl::measure::twopt::TwoPointCorrelation::Create (const TwoPType type, const catalogue::Catalogue &data, const catalogue::Catalogue &random, const BinType binType_D1, const double Min_D1, const double Max_D1, const int nbins_D1, const double shift_D1, const int nWedges, const int nbins_D2, const double shift_D2, const CoordinateUnits angularUnits, std::function<double(double)> angularWeight, const bool compute_extra_info, const double random_dilution_fraction, const chainmesh::SpatialIndex spatialIndex)
 {
-  if (type==TwoPType::_wedges_) return move(unique_ptr<TwoPointCorrelation_wedges>(new TwoPointCorrelation_wedges(data, random, binType_D1, Min_D1, Max_D1, nbins_D1, shift_D1, nWedges, nbins_D2, shift_D2, angularUnits, angularWeight, compute_extra_info, random_dilution_fraction)));
+  if (type==TwoPType::_wedges_) return move(unique_ptr<TwoPointCorrelation_wedges>(new TwoPointCorrelation_wedges(data, random, binType_D1, Min_D1, Max_D1, nbins_D1, shift_D1, nWedges, nbins_D2, shift_D2, angularUnits, angularWeight, compute_extra_info, random_dilution_fraction, spatialIndex)));
   
   else ErrorCBL("Error in cbl::measure::twopt::TwoPointCorrelation::Create of TwoPointCorrelation.cpp: no such type of object, or error in the input parameters!!");
   
@@ -161,9 +162,9 @@ shared_ptr<TwoPointCorrelation> cbl::measure::twopt::TwoPointCorrelation::Create
 // ============================================================================
 
 
-shared_ptr<TwoPointCorrelation> cbl::measure::twopt::TwoPointCorrelation::Create (const TwoPType type, const catalogue::Catalogue data, const catalogue::Catalogue random, const BinType binType_D1, const double Min_D1, const double Max_D1, const double binSize_D1, const double shift_D1, const int nWedges, const double binSize_D2, const double shift_D2, const CoordinateUnits angularUnits, std::function<double(double)> angularWeight, const bool compute_extra_info, const double random_dilution_fraction)
+shared_ptr<TwoPointCorrelation> cbl::measure::twopt::TwoPointCorrelation::Create (const TwoPType type, const catalogue::Catalogue &data, const catalogue::Catalogue &random, const BinType binType_D1, const double Min_D1, const double Max_D1, const double binSize_D1, const double shift_D1, const int nWedges, const double binSize_D2, const double shift_D2, const CoordinateUnits angularUnits, std::function<double(double)> angularWeight, const bool compute_extra_info, const double random_dilution_fraction, const chainmesh::SpatialIndex spatialIndex)
 {
-  if (type==TwoPType::_wedges_) return move(unique_ptr<TwoPointCorrelation_wedges>(new TwoPointCorrelation_wedges(data, random, binType_D1, Min_D1, Max_D1, binSize_D1, shift_D1, nWedges, binSize_D2, shift_D2, angularUnits, angularWeight, compute_extra_info, random_dilution_fraction)));
+  if (type==TwoPType::_wedges_) return move(unique_ptr<TwoPointCorrelation_wedges>(new TwoPointCorrelation_wedges(data, random, binType_D1, Min_D1, Max_D1, binSize_D1, shift_D1, nWedges, binSize_D2, shift_D2, angularUnits, angularWeight, compute_extra_info, random_dilution_fraction, spatialIndex)));
   
   else ErrorCBL("Error in cbl::measure::twopt::TwoPointCorrelation::Create of TwoPointCorrelation.cpp: no such type of object, or error in the input parameters!!");
   
@@ -174,11 +175,11 @@ shared_ptr<TwoPointCorrelation> cbl::measure::twopt::TwoPointCorrelation::Create
 // ============================================================================
 
 
-shared_ptr<TwoPointCorrelation> cbl::measure::twopt::TwoPointCorrelation::Create (const TwoPType type, const catalogue::Catalogue data, const catalogue::Catalogue random, const BinType binType_D1, const double Min_D1, const double Max_D1, const int nbins_D1, const double shift_D1, const BinType binType_D2, const double Min_D2, const double Max_D2, const int nbins_D2, const double shift_D2, const CoordinateUnits angularUnits, std::function<double(double)> angularWeight, const bool compute_extra_info, const double random_dilution_fraction)
+shared_ptr<TwoPointCorrelation> cbl::measure::twopt::TwoPointCorrelation::Create (const TwoPType type, const catalogue::Catalogue &data, const catalogue::Catalogue &random, const BinType binType_D1, const double Min_D1, const double Max_D1, const int nbins_D1, const double shift_D1, const BinType binType_D2, const double Min_D2, const double Max_D2, const int nbins_D2, const double shift_D2, const CoordinateUnits angularUnits, std::function<double(double)> angularWeight, const bool compute_extra_info, const double random_dilution_fraction, const chainmesh::SpatialIndex spatialIndex)
 {
-  if (type==TwoPType::_2D_Cartesian_) return move(unique_ptr<TwoPointCorrelation2D_cartesian>(new TwoPointCorrelation2D_cartesian(data, random, binType_D1, Min_D1, Max_D1, nbins_D1, shift_D1, binType_D2, Min_D2, Max_D2, nbins_D2, shift_D2, angularUnits, angularWeight, compute_extra_info, random_dilution_fraction)));
+  if (type==TwoPType::_2D_Cartesian_) return move(unique_ptr<TwoPointCorrelation2D_cartesian>(new TwoPointCorrelation2D_cartesian(data, random, binType_D1, Min_D1, Max_D1, nbins_D1, shift_D1, binType_D2, Min_D2, Max_D2, nbins_D2, shift_D2, angularUnits, angularWeight, compute_extra_info, random_dilution_fraction, spatialIndex)));
 
-  else if (type==TwoPType::_2D_polar_) return move(unique_ptr<TwoPointCorrelation2D_polar>(new TwoPointCorrelation2D_polar(data, random, binType_D1, Min_D1, Max_D1, nbins_D1, shift_D1, binType_D2, Min_D2, Max_D2, nbins_D2, shift_D2, angularUnits, angularWeight, compute_extra_info, random_dilution_fraction)));
+  else if (type==TwoPType::_2D_polar_) return move(unique_ptr<TwoPointCorrelation2D_polar>(new TwoPointCorrelation2D_polar(data, random, binType_D1, Min_D1, Max_D1, nbins_D1, shift_D1, binType_D2, Min_D2, Max_D2, nbins_D2, shift_D2, angularUnits, angularWeight, compute_extra_info, random_dilution_fraction, spatialIndex)));
 
   else ErrorCBL("Error in cbl::measure::twopt::TwoPointCorrelation::Create of TwoPointCorrelation.cpp: no such type of object, or error in the input parameters!!");
   
@@ -189,11 +190,11 @@ shared_ptr<TwoPointCorrelation> cbl::measure::twopt::TwoPointCorrelation::Create
 // ============================================================================
 
 
-std::shared_ptr<TwoPointCorrelation> cbl::measure::twopt::TwoPointCorrelation::Create (const TwoPType type, const catalogue::Catalogue data, const catalogue::Catalogue random, const BinType binType_D1, const double Min_D1, const double Max_D1, const double binSize_D1, const double shift_D1, const BinType binType_D2, const double Min_D2, const double Max_D2, const double binSize_D2, const double shift_D2, const CoordinateUnits angularUnits, std::function<double(double)> angularWeight, const bool compute_extra_info, const double random_dilution_fraction)
+std::shared_ptr<TwoPointCorrelation> cbl::measure::twopt::TwoPointCorrelation::Create (const TwoPType type, const catalogue::Catalogue &data, const catalogue::Catalogue &random, const BinType binType_D1, const double Min_D1, const double Max_D1, const double binSize_D1, const double shift_D1, const BinType binType_D2, const double Min_D2, const double Max_D2, const double binSize_D2, const double shift_D2, const CoordinateUnits angularUnits, std::function<double(double)> angularWeight, const bool compute_extra_info, const double random_dilution_fraction, const chainmesh::SpatialIndex spatialIndex)
 {
-  if (type==TwoPType::_2D_Cartesian_) return move(unique_ptr<TwoPointCorrelation2D_cartesian>(new TwoPointCorrelation2D_cartesian(data, random, binType_D1, Min_D1, Max_D1, binSize_D1, shift_D1, binType_D2, Min_D2, Max_D2, binSize_D2, shift_D2, angularUnits, angularWeight, compute_extra_info, random_dilution_fraction)));
+  if (type==TwoPType::_2D_Cartesian_) return move(unique_ptr<TwoPointCorrelation2D_cartesian>(new TwoPointCorrelation2D_cartesian(data, random, binType_D1, Min_D1, Max_D1, binSize_D1, shift_D1, binType_D2, Min_D2, Max_D2, binSize_D2, shift_D2, angularUnits, angularWeight, compute_extra_info, random_dilution_fraction, spatialIndex)));
 
-  else if (type==TwoPType::_2D_polar_) return move(unique_ptr<TwoPointCorrelation2D_polar>(new TwoPointCorrelation2D_polar(data, random, binType_D1, Min_D1, Max_D1, binSize_D1, shift_D1, binType_D2, Min_D2, Max_D2, binSize_D2, shift_D2, angularUnits, angularWeight, compute_extra_info, random_dilution_fraction)));
+  else if (type==TwoPType::_2D_polar_) return move(unique_ptr<TwoPointCorrelation2D_polar>(new TwoPointCorrelation2D_polar(data, random, binType_D1, Min_D1, Max_D1, binSize_D1, shift_D1, binType_D2, Min_D2, Max_D2, binSize_D2, shift_D2, angularUnits, angularWeight, compute_extra_info, random_dilution_fraction, spatialIndex)));
 
   else ErrorCBL("Error in cbl::measure::twopt::TwoPointCorrelation::Create of TwoPointCorrelation.cpp: no such type of object, or error in the input parameters!!");
   
@@ -205,23 +206,104 @@ std::shared_ptr<TwoPointCorrelation> cbl::measure::twopt::TwoPointCorrelation::C
 
 
 void cbl::measure::twopt::TwoPointCorrelation::count_pairs (const std::shared_ptr<Catalogue> cat1, const ChainMesh_Catalogue &ChM, std::shared_ptr<Pair> pp, const bool cross, const bool tcount)
+{ 
+  // objects of the second catalogue (get from the chain mesh) and of the first catalogue, ordered by chain-mesh cell
+  const chainmesh::CellObjects &objects2 = ChM.cellObjects();
+  objects2.check_variables(pp->variables());
+  const chainmesh::CellObjects objects1_cross = (cross) ? ChM.cell_objects(cat1, pp->variables()) : chainmesh::CellObjects();
+  const chainmesh::CellObjects &objects1 = (cross) ? objects1_cross : objects2;
+
+  count_pairs_cells(objects1, objects2, [&] (const long i) { return ChM.close_cells(objects1.nonEmpty_cells[i]); }, pp, cross, tcount);
+}
+
+
+// ============================================================================
+
+
+void cbl::measure::twopt::TwoPointCorrelation::count_pairs (const std::shared_ptr<Catalogue> cat1, const KDTree_Catalogue &tree, std::shared_ptr<Pair> pp, const bool cross, const bool tcount)
+{ 
+  // objects of the second catalogue (get from the kd-tree) and of the first catalogue, ordered by leaf
+  const chainmesh::CellObjects &objects2 = tree.cellObjects();
+  objects2.check_variables(pp->variables());
+  const chainmesh::CellObjects objects1_cross = (cross) ? tree.cell_objects(cat1, pp->variables()) : chainmesh::CellObjects();
+  const chainmesh::CellObjects &objects1 = (cross) ? objects1_cross : objects2;
+
+  count_pairs_cells(objects1, objects2, [&] (const long i) { return tree.close_cells(objects1, i); }, pp, cross, tcount);
+}
+
+
+// ============================================================================
+
+
+// estimate the cost of counting the pairs of the i-th non-empty cell of the first set of objects,
+// i.e. the number of pairs between its objects and the objects of the close cells
+
+static double cell_cost (const chainmesh::CellObjects &objects1, const chainmesh::CellObjects &objects2, std::function<std::vector<long>(const long)> &close_cells, const int i, const bool cross)
+{
+  const long cell1 = objects1.nonEmpty_cells[i];
+  double nObj2 = 0.;
+  for (auto &&cell2 : close_cells(i))
+    if ((cross || cell2>=cell1) && objects2.nonEmpty_index(cell2)>-1)
+      nObj2 += objects2.first[cell2+1]-objects2.first[cell2];
+  return (objects1.first[cell1+1]-objects1.first[cell1])*nObj2+1.;
+}
+
+
+// ============================================================================
+
+
+// create a Pair with the same type and binning of a given Pair, and no pairs
+
+static std::shared_ptr<Pair> empty_pair (const std::shared_ptr<Pair> pp)
+{
+  if (pp->pairDim()==Dim::_1D_)
+    return Pair::Create(pp->pairType(), pp->pairInfo(), pp->sMin(), pp->sMax(), pp->nbins(), pp->shift(), pp->angularUnits(), pp->angularWeight());
+  return Pair::Create(pp->pairType(), pp->pairInfo(), pp->sMin_D1(), pp->sMax_D1(), pp->nbins_D1(), pp->shift_D1(), pp->sMin_D2(), pp->sMax_D2(), pp->nbins_D2(), pp->shift_D2(), pp->angularUnits(), pp->angularWeight());
+}
+
+
+// ============================================================================
+
+
+// get the cells sorted by decreasing cost; cells with the same cost keep their order, so that the
+// order does not depend on the number of threads
+
+static std::vector<int> cost_order (const std::vector<double> &cost)
+{
+  std::vector<int> order(cost.size());
+  for (size_t i=0; i<cost.size(); ++i) order[i] = i;
+  std::stable_sort(order.begin(), order.end(), [&cost] (const int i, const int j) { return cost[i]>cost[j]; });
+  return order;
+}
+
+
+// ============================================================================
+
+
+void cbl::measure::twopt::TwoPointCorrelation::count_pairs_cells (const chainmesh::CellObjects &objects1, const chainmesh::CellObjects &objects2, std::function<std::vector<long>(const long)> close_cells, std::shared_ptr<Pair> pp, const bool cross, const bool tcount, const bool verbose)
 { 
   // timer 
   time_t start; time(&start);
   int dp = cout.precision();
   cout.setf(ios::fixed); cout.setf(ios::showpoint); cout.precision(2);
   
-  // number of objects in the first catalogue
-  int nObj = cat1->nObjects();
+  // number of non-empty cells of the first catalogue
+  int nCells = objects1.nonEmpty_cells.size();
 
-  // factor used by the timer
-  float fact_count = 100./nObj;
+  // cost of each non-empty cell of the first catalogue, i.e. the number of pairs between its objects and the objects of the close cells
+  vector<double> cost(nCells, 0.);
 
-  // pointer to the second catalogue (get from the chain mesh)
-  shared_ptr<Catalogue> cat2 = ChM.catalogue();
+  // the non-empty cells of the first catalogue, sorted by decreasing cost
+  vector<int> order;
   
   // thread number
   int tid = 0;
+
+  // pairs computed by each thread, summed with a tree reduction
+  vector<shared_ptr<Pair>> pp_threads(omp_get_max_threads());
+
+  // progress of the pair count
+  shared_ptr<ProgressReporter> progress;
   
   // start the multithreading parallelization
 #pragma omp parallel num_threads(omp_get_max_threads()) private(tid)
@@ -234,39 +316,66 @@ void cbl::measure::twopt::TwoPointCorrelation::count_pairs (const std::shared_pt
     
     // internal object used by each thread to handle pairs
     
-    shared_ptr<Pair> pp_thread = (pp->pairDim()==Dim::_1D_) ? move(Pair::Create(pp->pairType(), pp->pairInfo(), pp->sMin(), pp->sMax(), pp->nbins(), pp->shift(), pp->angularUnits(), pp->angularWeight()))
-      : move(Pair::Create(pp->pairType(), pp->pairInfo(), pp->sMin_D1(), pp->sMax_D1(), pp->nbins_D1(), pp->shift_D1(), pp->sMin_D2(), pp->sMax_D2(), pp->nbins_D2(), pp->shift_D2(), pp->angularUnits(), pp->angularWeight()));
+    shared_ptr<Pair> pp_thread = empty_pair(pp);
+
+
+    // estimate the cost of each cell from the occupancy of the close cells
+#pragma omp for schedule(dynamic, 64)
+    for (int i=0; i<nCells; ++i) 
+      cost[i] = cell_cost(objects1, objects2, close_cells, i, cross);
+
+#pragma omp single
+    {
+      order = cost_order(cost);
+
+      // the progress of the pair count is weighted by the cost of the cells
+      progress = make_shared<ProgressReporter>(accumulate(cost.begin(), cost.end(), 0.), tcount, verbose);
+    }
     
     
-    // parallelized loop
-#pragma omp for schedule(static, 2)
+    // parallelized loop: the most expensive cells are handled first, and the idle threads take
+    // the next cell, so that the threads end at about the same time even in very clustered samples
+#pragma omp for schedule(dynamic)
 
-    // loop on the objects of the first catalogue    
-    for (int i=0; i<nObj; ++i) {
+    // loop on the non-empty cells of the first catalogue    
+    for (int k=0; k<nCells; ++k) {
 
-      // get the indexes of objects in the second catalogue that are close to the object i of the first catalogue
-      // (i.e. objects inside the close cells of the chain-mesh)
-      vector<long> close_objects = ChM.close_objects(cat1->coordinate(i), (cross) ? -1 : (long)i);
+      const int i = order[k];
+      const long cell1 = objects1.nonEmpty_cells[i];
       
-      // loop on the nearby objects
-      for (auto &&j : close_objects)
-	// estimate the distance between the two objects and update the pair count
-	pp_thread->put(cat1->catalogue_object(i), cat2->catalogue_object(j));
-    
-      // estimate the computational time and update the time count
-      time_t end_temp; time(&end_temp); double diff_temp = difftime(end_temp, start);
-      if (tcount && tid==0) { coutCBL << "\r" << float(i)*fact_count << "% completed (" << diff_temp << " seconds)\r"; cout.flush(); }    
-      if (i==int(nObj*0.25)) coutCBL << ".............25% completed" << endl;
-      if (i==int(nObj*0.5)) coutCBL << ".............50% completed" << endl;
-      if (i==int(nObj*0.75)) coutCBL << ".............75% completed"<< endl;   
+      // loop on the cells of the second catalogue close to the cell of the first catalogue
+      for (auto &&cell2 : close_cells(i)) {
+
+	// in the auto-correlation case, each couple of cells is considered only once
+	if (!cross && cell2<cell1) continue;
+
+	const long index2 = objects2.nonEmpty_index(cell2);
+	if (index2<0) continue;
+
+	// range of the distances between the objects of the two cells
+	double dist_min, dist_max;
+	objects1.separation_range(i, objects2, index2, dist_min, dist_max);
+
+	// count all the pairs of the two cells at once if possible (i.e. if the pairs are all outside
+	// the binning range or inside a single bin); otherwise estimate the distances between the objects
+	// of the two cells and update the pair count
+	if (!pp_thread->put_cells(objects1, objects1.first[cell1], objects1.first[cell1+1], objects2, objects2.first[cell2], objects2.first[cell2+1], (!cross && cell2==cell1), dist_min, dist_max))
+	  pp_thread->put(objects1, objects1.first[cell1], objects1.first[cell1+1], objects2, objects2.first[cell2], objects2.first[cell2+1], (!cross && cell2==cell1));
+
+      }
+      
+      // update the time count
+      progress->update(cost[i], tid);
    
     }
 
-#pragma omp critical
-    {
-      // sum all the object pairs computed by each thread
-      pp->Sum(pp_thread);
-    }
+    // sum all the object pairs computed by each thread: the pairs are summed exactly (see
+    // pairs::ExactSum), so the result does not depend on how the cells are shared among the threads
+    pp_threads[tid] = move(pp_thread);
+    tree_reduction<shared_ptr<Pair>>(pp_threads, [] (shared_ptr<Pair> &pp1, shared_ptr<Pair> &pp2) { pp1->Sum(pp2); });
+
+#pragma omp master
+    pp->Sum(pp_threads[0]);
     
   }
 
@@ -274,7 +383,7 @@ void cbl::measure::twopt::TwoPointCorrelation::count_pairs (const std::shared_pt
   // show the time spent by the method
   time_t end; time (&end);
   double diff = difftime(end, start);
-  if (tid==0) {
+  if (tid==0 && verbose) {
     if (diff<60) coutCBL << "   time spent to count the pairs: " << diff << " seconds" << endl ;
     else if (diff<3600) coutCBL << "   time spent to count the pairs: " << diff/60 << " minutes" << endl ;
     else coutCBL << "   time spent to count the pairs: " << diff/3600 << " hours" << endl ;
@@ -287,14 +396,507 @@ void cbl::measure::twopt::TwoPointCorrelation::count_pairs (const std::shared_pt
 // ============================================================================
 
 
+double cbl::measure::twopt::TwoPointCorrelation::chainMesh_cell_size (const std::shared_ptr<Catalogue> cat, const double rMAX, const std::shared_ptr<Pair> pp)
+{
+  if (m_cell_size!=par::defaultDouble) return m_cell_size;
+
+  // an empty catalogue has no pairs to count, and no sub-volume where the cost can be estimated
+  const long nObj = cat->nObjects();
+  if (nObj==0) return 0.1*rMAX;
+
+  
+  // ----------- the candidate cell sizes, enlarged as done by the chain-mesh if the cells are too many ----------- 
+
+  const vector<double> lim_min = {cat->Min(Var::_X_), cat->Min(Var::_Y_), cat->Min(Var::_Z_)};
+  const vector<double> lim_max = {cat->Max(Var::_X_), cat->Max(Var::_Y_), cat->Max(Var::_Z_)};
+  
+  const vector<double> fraction = {0.05, 0.075, 0.1, 0.15, 0.2, 0.3, 0.5};
+  
+  vector<double> cell_size;
+  for (size_t i=0; i<fraction.size(); ++i) {
+    ChainMesh chainMesh(fraction[i]*rMAX, 3);
+    chainMesh.set_cells(lim_min, lim_max, rMAX);
+    if (cell_size.size()==0 || chainMesh.cell_size()>cell_size.back()) cell_size.push_back(chainMesh.cell_size());
+  }
+
+  
+  // ----------- select the objects of a cubic sub-volume, centred on an object of the catalogue, that contains at least nMax objects and is larger than 4*rMAX ----------- 
+
+  const long nMax = 100000;
+  const vector<double> centre = {cat->xx(nObj/2), cat->yy(nObj/2), cat->zz(nObj/2)};
+  
+  double side = max(4.*rMAX, cbrt(double(nMax)/nObj*(lim_max[0]-lim_min[0])*(lim_max[1]-lim_min[1])*(lim_max[2]-lim_min[2])));
+
+  // the distance of each object from the centre along the farthest axis, computed once: the
+  // sub-volume of side l contains the objects closer than l/2, i.e. a prefix of the objects sorted
+  // by distance
+  vector<pair<double, long>> dist(nObj);
+  for (long i=0; i<nObj; ++i)
+    dist[i] = {max(fabs(cat->xx(i)-centre[0]), max(fabs(cat->yy(i)-centre[1]), fabs(cat->zz(i)-centre[2]))), i};
+
+  // only the position of the nSub-th closest object is needed to grow the sub-volume
+  const long nSub = min(nMax, nObj);
+  nth_element(dist.begin(), dist.begin()+nSub-1, dist.end());
+  
+  while (0.5*side<=dist[nSub-1].first) side *= 1.26;
+
+  const auto last = partition(dist.begin(), dist.end(), [&side] (const pair<double, long> &dd) { return dd.first<0.5*side; });
+  
+  vector<long> sub;
+  for (auto it=dist.begin(); it!=last; ++it) sub.push_back(it->second);
+  sort(sub.begin(), sub.end());
+
+  
+  // ----------- estimate the cost of the candidate cell sizes in the sub-volume ----------- 
+
+  vector<vector<double>> data_sub(3, vector<double>(sub.size()));
+  for (size_t i=0; i<sub.size(); ++i) {
+    data_sub[0][i] = cat->xx(sub[i]);
+    data_sub[1][i] = cat->yy(sub[i]);
+    data_sub[2][i] = cat->zz(sub[i]);
+  }
+  
+  const vector<double> cost = chainMesh_cost(data_sub, rMAX, cell_size);
+
+  vector<size_t> rank(cell_size.size());
+  for (size_t i=0; i<rank.size(); ++i) rank[i] = i;
+  sort(rank.begin(), rank.end(), [&cost] (const size_t i, const size_t j) { return cost[i]<cost[j]; });
+
+  double best = cell_size[rank[0]];
+
+  
+  // ----------- time the count of the pairs between a random subsample of the sub-volume and the sub-volume, with the best candidates ----------- 
+
+  if (m_cell_size_trial) {
+
+    const int nTrial = min((int)rank.size(), 3);
+
+    vector<shared_ptr<Object>> object_sub(sub.size());
+    for (size_t i=0; i<sub.size(); ++i) object_sub[i] = cat->catalogue_object(sub[i]);
+    
+    auto cat_trial = make_shared<catalogue::Catalogue>(catalogue::Catalogue(object_sub)); // the chain-mesh reorders the objects of the sub-volume only
+    auto cat_sub = make_shared<catalogue::Catalogue>(cat_trial->diluted_catalogue(min(1., max(1000., 0.01*sub.size())/sub.size())));
+
+    double time_min = numeric_limits<double>::max();
+    
+    for (int n=0; n<nTrial; ++n) {
+      ChainMesh_Catalogue ChM(cell_size[rank[n]], cat_trial, rMAX);
+      const chainmesh::CellObjects objects1 = ChM.cell_objects(cat_sub, pp->variables());
+      
+      shared_ptr<Pair> pp_trial = empty_pair(pp);
+
+      const double start = omp_get_wtime();
+      count_pairs_cells(objects1, ChM.cellObjects(), [&] (const long i) { return ChM.close_cells(objects1.nonEmpty_cells[i]); }, pp_trial, true, false, false);
+      const double time = omp_get_wtime()-start;
+
+      if (time<time_min) {
+	time_min = time;
+	best = cell_size[rank[n]];
+      }
+    }
+  }
+  
+  if (wrapper::mpi::rank()==0)
+    coutCBL << "cell size of the chain-mesh: " << best << " = " << best/rMAX << "*rMAX (chosen with the " << ((m_cell_size_trial) ? "timing trial" : "cost model") << " on " << sub.size() << " objects)" << endl;
+  
+  return best;
+}
+
+
+// ============================================================================
+
+
+void cbl::measure::twopt::TwoPointCorrelation::set_grid_estimator (const double transition_scale, const double cell_size, const int assignment_type)
+{
+  if (transition_scale>0. && cell_size<=0.)
+    ErrorCBL("Error in cbl::measure::twopt::TwoPointCorrelation::set_grid_estimator() of TwoPointCorrelation.cpp: the cell size of the grid must be positive!");
+
+  if (assignment_type<0 || assignment_type>3)
+    ErrorCBL("Error in cbl::measure::twopt::TwoPointCorrelation::set_grid_estimator() of TwoPointCorrelation.cpp: the mass assignment scheme must be 0 (NGP), 1 (CIC), 2 (TSC) or 3 (PCS)!");
+
+  if (transition_scale>0. && transition_scale<5.*cell_size)
+    WarningMsg("Attention in cbl::measure::twopt::TwoPointCorrelation::set_grid_estimator() of TwoPointCorrelation.cpp: the transition scale is smaller than 5 times the cell size, so the pair counts on the grid might be affected by the grid resolution!");
+
+  m_grid_transition = transition_scale;
+  m_grid_cell_size = cell_size;
+  m_grid_assignment_type = assignment_type;
+}
+
+
+// ============================================================================
+
+
+// get the limits of the (first dimension) bins of the pairs that can be counted on a grid
+
+static std::vector<double> grid_bin_limits (const std::shared_ptr<Pair> pp)
+{
+  const PairType type = pp->pairType();
+
+  const bool logarithmic = (type==PairType::_comoving_log_ || type==PairType::_comoving_multipoles_log_);
+
+  if (type!=PairType::_comoving_lin_ && type!=PairType::_comoving_log_ && type!=PairType::_comoving_multipoles_lin_ && type!=PairType::_comoving_multipoles_log_)
+    ErrorCBL("Error in grid_bin_limits() of TwoPointCorrelation.cpp: the pairs can be counted on a grid only for 1D comoving separations, also for multipoles!");
+
+  const int nbins = pp->nbins();
+  const double sMin = pp->sMin();
+  const double binSize = 1./pp->binSize_inv();
+
+  vector<double> limits(nbins+1);
+  for (int i=0; i<=nbins; ++i)
+    limits[i] = (logarithmic) ? pow(10., log10(sMin)+i*binSize) : sMin+i*binSize;
+
+  return limits;
+}
+
+
+// ============================================================================
+
+
+void cbl::measure::twopt::TwoPointCorrelation::count_pairs_grid (const std::shared_ptr<Catalogue> cat1, const std::shared_ptr<Catalogue> cat2, std::shared_ptr<Pair> pp, const bool cross, const double rMin) const
+{
+  if (pp->pairInfo()!=PairInfo::_standard_)
+    ErrorCBL("Error in cbl::measure::twopt::TwoPointCorrelation::count_pairs_grid() of TwoPointCorrelation.cpp: the extra information of the pairs cannot be computed on a grid!");
+
+  if (pp->angularWeight()!=nullptr)
+    ErrorCBL("Error in cbl::measure::twopt::TwoPointCorrelation::count_pairs_grid() of TwoPointCorrelation.cpp: the angular weights cannot be used with the pairs counted on a grid!");
+
+  const PairType type = pp->pairType();
+  const bool multipoles = (type==PairType::_comoving_multipoles_lin_ || type==PairType::_comoving_multipoles_log_);
+
+  const vector<double> limits = grid_bin_limits(pp);
+  const int nbins = limits.size()-1;
+
+  int first_bin = 0;
+  while (first_bin<nbins && limits[first_bin]<rMin) first_bin ++;
+  if (first_bin==nbins) return;
+
+  const double sMax = limits[nbins];
+  const int lMax = (multipoles) ? 4 : 0;
+
+  coutCBL << "counting the pairs above " << limits[first_bin] << " on a grid..." << endl;
+
+
+  // the grid encloses the two catalogues, with an empty layer wider than the maximum separation,
+  // so that the cross-correlation is not affected by the periodicity of the Fast Fourier Transforms
+
+  const double pad = (m_grid_assignment_type+2)*m_grid_cell_size;
+
+  const double minX = min(cat1->Min(Var::_X_), cat2->Min(Var::_X_))-pad, maxX = max(cat1->Max(Var::_X_), cat2->Max(Var::_X_))+sMax+pad;
+  const double minY = min(cat1->Min(Var::_Y_), cat2->Min(Var::_Y_))-pad, maxY = max(cat1->Max(Var::_Y_), cat2->Max(Var::_Y_))+sMax+pad;
+  const double minZ = min(cat1->Min(Var::_Z_), cat2->Min(Var::_Z_))-pad, maxZ = max(cat1->Max(Var::_Z_), cat2->Max(Var::_Z_))+sMax+pad;
+
+  data::ScalarField3D field(m_grid_cell_size, minX, maxX, minY, maxY, minZ, maxZ);
+
+  const int nx = field.nx(), ny = field.ny(), nz = field.nz(), nzF = field.nzFourier();
+  const double nCells = field.nCells();
+
+
+  // the bin of each separation on the grid (-1 if the separation is outside the bins counted on
+  // the grid), and the line of sight at the centre of each cell
+
+  vector<int> lag_bin(field.nCells(), -1);
+  vector<array<double, 3>> lag_dir(field.nCells()), los(field.nCells());
+
+#pragma omp parallel for schedule(static)
+  for (int i=0; i<nx; i++)
+    for (int j=0; j<ny; j++)
+      for (int k=0; k<nz; k++) {
+	const long int index = k+nz*(j+ny*i);
+
+	const double rr = sqrt(pow(field.XX(i), 2)+pow(field.YY(j), 2)+pow(field.ZZ(k), 2));
+	los[index] = (rr>0.) ? array<double, 3>{field.XX(i)/rr, field.YY(j)/rr, field.ZZ(k)/rr} : array<double, 3>{0., 0., 0.};
+
+	const double dx = ((i<=nx/2) ? i : i-nx)*field.deltaX(), dy = ((j<=ny/2) ? j : j-ny)*field.deltaY(), dz = ((k<=nz/2) ? k : k-nz)*field.deltaZ();
+	const double ss = sqrt(dx*dx+dy*dy+dz*dz);
+	if (ss<limits[first_bin] || ss>=sMax) continue;
+
+	lag_bin[index] = min(int(upper_bound(limits.begin(), limits.end(), ss)-limits.begin())-1, nbins-1);
+	lag_dir[index] = {dx/ss, dy/ss, dz/ss};
+      }
+
+
+  // count the pairs: moments[n/2][bin] = sum over the pairs in the bin of the weights times
+  // (s.r)^n, where s is the separation direction and r the line of sight, obtained from the
+  // cross-correlations of the first grid multiplied by the products of the components of r,
+  // r_x^a r_y^b r_z^c with a+b+c=n, and the second grid
+
+  auto ipow = [] (const double xx, const int nn) { double vv = 1.; for (int p=0; p<nn; ++p) vv *= xx; return vv; };
+
+  auto count = [&] (const bool weighted)
+    {
+      auto coordinates = [&] (const std::shared_ptr<Catalogue> cat, vector<double> &xx, vector<double> &yy, vector<double> &zz, vector<double> &ww)
+      {
+	xx = cat->var(Var::_X_); yy = cat->var(Var::_Y_); zz = cat->var(Var::_Z_);
+	ww = (weighted) ? cat->var(Var::_Weight_) : vector<double>(xx.size(), 1.);
+      };
+
+      vector<double> xx, yy, zz, ww;
+
+      coordinates(cat1, xx, yy, zz, ww);
+      field.assign_mass(xx, yy, zz, ww, m_grid_assignment_type);
+      const vector<double> grid1 = field.ScalarField();
+
+      if (cross) {
+	coordinates(cat2, xx, yy, zz, ww);
+	field.assign_mass(xx, yy, zz, ww, m_grid_assignment_type);
+      }
+      field.FourierTransformField();
+
+      vector<complex<double>> grid2_FourierSpace(field.nCellsFourier());
+#pragma omp parallel for schedule(static)
+      for (int i=0; i<nx; i++)
+	for (int j=0; j<ny; j++)
+	  for (int k=0; k<nzF; k++)
+	    grid2_FourierSpace[k+nzF*(j+ny*i)] = complex<double>(field.ScalarField_FourierSpace_real(i, j, k), field.ScalarField_FourierSpace_complex(i, j, k));
+
+      vector<vector<double>> moments(lMax/2+1, vector<double>(nbins, 0.));
+      const double factorial[5] = {1., 1., 2., 6., 24.};
+
+      for (int nn=0; nn<=lMax; nn+=2)
+	for (int a=nn; a>=0; --a)
+	  for (int b=nn-a; b>=0; --b) {
+	    const int c = nn-a-b;
+	    const double multinomial = factorial[nn]/(factorial[a]*factorial[b]*factorial[c]);
+
+#pragma omp parallel for schedule(static)
+	    for (int i=0; i<nx; i++)
+	      for (int j=0; j<ny; j++)
+		for (int k=0; k<nz; k++) {
+		  const long int index = k+nz*(j+ny*i);
+		  field.set_ScalarField(grid1[index]*ipow(los[index][0], a)*ipow(los[index][1], b)*ipow(los[index][2], c), i, j, k);
+		}
+
+	    field.FourierTransformField();
+
+#pragma omp parallel for schedule(static)
+	    for (int i=0; i<nx; i++)
+	      for (int j=0; j<ny; j++)
+		for (int k=0; k<nzF; k++) {
+		  const complex<double> cc = conj(complex<double>(field.ScalarField_FourierSpace_real(i, j, k), field.ScalarField_FourierSpace_complex(i, j, k)))*grid2_FourierSpace[k+nzF*(j+ny*i)];
+		  field.set_ScalarField_FourierSpace_real(cc.real(), i, j, k);
+		  field.set_ScalarField_FourierSpace_complex(cc.imag(), i, j, k);
+		}
+
+	    field.FourierAntiTransformField();
+
+#pragma omp parallel
+	    {
+	      vector<double> moments_thread(nbins, 0.);
+
+#pragma omp for schedule(static) nowait
+	      for (int i=0; i<nx; i++)
+		for (int j=0; j<ny; j++)
+		  for (int k=0; k<nz; k++) {
+		    const long int index = k+nz*(j+ny*i);
+		    if (lag_bin[index]<0) continue;
+		    moments_thread[lag_bin[index]] += field.ScalarField(i, j, k)*ipow(lag_dir[index][0], a)*ipow(lag_dir[index][1], b)*ipow(lag_dir[index][2], c);
+		  }
+
+#pragma omp critical (count_pairs_grid)
+	      for (int bin=0; bin<nbins; ++bin)
+		moments[nn/2][bin] += multinomial*moments_thread[bin];
+	    }
+	  }
+
+
+      // the cross-correlation is normalized by the number of cells, and the pairs of objects
+      // of the same catalogue are counted twice
+
+      const double norm = (cross) ? nCells : 0.5*nCells;
+
+      for (auto &&mm : moments)
+	for (auto &&vv : mm)
+	  vv *= norm;
+
+      return moments;
+    };
+
+
+  // the Legendre multipoles of the pairs, sum_pairs L_l(mu), where mu is the cosine of the angle
+  // between the separation and the line of sight
+
+  auto legendre = [&] (const vector<vector<double>> &moments)
+    {
+      vector<vector<double>> legendre_moments(lMax/2+1, vector<double>(nbins, 0.));
+      for (int bin=first_bin; bin<nbins; ++bin) {
+	legendre_moments[0][bin] = moments[0][bin];
+	if (lMax>=4) {
+	  legendre_moments[1][bin] = 0.5*(3.*moments[1][bin]-moments[0][bin]);
+	  legendre_moments[2][bin] = 0.125*(35.*moments[2][bin]-30.*moments[1][bin]+3.*moments[0][bin]);
+	}
+      }
+      return legendre_moments;
+    };
+
+  const vector<vector<double>> PP_weighted = legendre(count(true));
+
+  bool weighted = false;
+  for (auto &&cat : {cat1, cat2})
+    for (auto &&ww : cat->var(Var::_Weight_))
+      if (ww!=1.) weighted = true;
+
+  const vector<vector<double>> PP = (weighted) ? legendre(count(false)) : PP_weighted;
+
+
+  // set the pairs
+
+  for (int bin=first_bin; bin<nbins; ++bin)
+    for (int ll=0; ll<=lMax; ll+=2) {
+      pp->set_PP1D(bin+ll/2*(nbins+1), (2*ll+1)*PP[ll/2][bin]);
+      pp->set_PP1D_weighted(bin+ll/2*(nbins+1), (2*ll+1)*PP_weighted[ll/2][bin]);
+    }
+}
+
+
+// ============================================================================
+
+
+void cbl::measure::twopt::TwoPointCorrelation::set_periodic_box (const double boxSide, const std::vector<double> box_min)
+{
+  if (box_min.size()!=3)
+    ErrorCBL("Error in cbl::measure::twopt::TwoPointCorrelation::set_periodic_box() of TwoPointCorrelation.cpp: the minimum coordinates of the box must be 3!");
+
+  m_periodic_box = boxSide;
+  m_periodic_box_min = box_min;
+}
+
+
+// ============================================================================
+
+
+std::shared_ptr<Catalogue> cbl::measure::twopt::TwoPointCorrelation::periodic_images (const double rMAX) const
+{
+  const double side = m_periodic_box;
+  
+  if (rMAX>=0.5*side)
+    ErrorCBL("Error in cbl::measure::twopt::TwoPointCorrelation::periodic_images() of TwoPointCorrelation.cpp: the maximum separation must be smaller than half the side of the periodic box!");
+
+  const vector<vector<double>> coord = {m_data->var(Var::_X_), m_data->var(Var::_Y_), m_data->var(Var::_Z_)};
+  const vector<double> weight = m_data->var(Var::_Weight_);
+
+  vector<vector<double>> image(3);
+  vector<double> image_weight;
+  
+  for (size_t i=0; i<weight.size(); ++i) {
+
+    // the shifts of the object along each axis, in units of the box side
+    int shift_min[3], shift_max[3];
+    
+    for (int k=0; k<3; ++k) {
+      const double pos = coord[k][i]-m_periodic_box_min[k];
+      if (pos<0. || pos>side)
+	ErrorCBL("Error in cbl::measure::twopt::TwoPointCorrelation::periodic_images() of TwoPointCorrelation.cpp: the data objects must be inside the periodic box!");
+      shift_min[k] = (pos>side-rMAX) ? -1 : 0;
+      shift_max[k] = (pos<rMAX) ? 1 : 0;
+    }
+    
+    for (int a=shift_min[0]; a<=shift_max[0]; ++a)
+      for (int b=shift_min[1]; b<=shift_max[1]; ++b)
+	for (int c=shift_min[2]; c<=shift_max[2]; ++c)
+	  if (a!=0 || b!=0 || c!=0) {
+	    image[0].emplace_back(coord[0][i]+a*side);
+	    image[1].emplace_back(coord[1][i]+b*side);
+	    image[2].emplace_back(coord[2][i]+c*side);
+	    image_weight.emplace_back(weight[i]);
+	  }
+  }
+
+  auto images = make_shared<Catalogue>(ObjectType::_Galaxy_, CoordinateType::_comoving_, image[0], image[1], image[2], image_weight);
+  if (images->nObjects()>0) images->computePolarCoordinates();
+  
+  return images;
+}
+
+
+// ============================================================================
+
+
+void cbl::measure::twopt::TwoPointCorrelation::count_pairs_periodic (const double rMAX, std::shared_ptr<Pair> pp, const bool tcount)
+{
+  auto images = periodic_images(rMAX);
+
+  const size_t nImages = m_nObjects(images);
+  
+  if (nImages==0) return;
+  
+  coutCBL << "counting the pairs with " << nImages << " periodic images..." << endl;
+
+  shared_ptr<Pair> pp_images = empty_pair(pp);
+
+  if (wrapper::mpi::distributed())
+    count_pairs_distributed(m_data, images, rMAX, pp_images, {}, true, tcount);
+  
+  else if (m_spatialIndex==SpatialIndex::_kdTree_) {
+    KDTree_Catalogue tree(images, rMAX);
+    count_pairs(m_data, tree, pp_images, true, tcount);
+  }
+  
+  else {
+    ChainMesh_Catalogue ChM(chainMesh_cell_size(images, rMAX, pp), images, rMAX);
+    count_pairs(m_data, ChM, pp_images, true, tcount);
+  }
+
+  // each pair across the box faces is counted twice, with the images of both objects
+  pp->Sum(pp_images, 0.5);
+}
+
+
+// ============================================================================
+
+
+void cbl::measure::twopt::TwoPointCorrelation::set_pairs_periodic (std::shared_ptr<Pair> pp, const double nPairs, const double nPairs_weighted) const
+{
+  const PairType type = pp->pairType();
+
+  if (type!=PairType::_comoving_lin_ && type!=PairType::_comoving_log_)
+    ErrorCBL("Error in cbl::measure::twopt::TwoPointCorrelation::set_pairs_periodic() of TwoPointCorrelation.cpp: the number of pairs in a periodic box can be computed only for 1D comoving separations!");
+
+  const double volume = pow(m_periodic_box, 3);
+
+  // the limits of the bins
+  vector<double> ss(pp->nbins()+1);
+  for (int i=0; i<=pp->nbins(); ++i)
+    ss[i] = (type==PairType::_comoving_log_) ? pow(10., log10(pp->sMin())+i/pp->binSize_inv()) : pp->sMin()+i/pp->binSize_inv();
+
+  for (int i=0; i<pp->nbins(); ++i) {
+    const double fraction = 4./3.*par::pi*(pow(ss[i+1], 3)-pow(ss[i], 3))/volume;
+    pp->set_PP1D(i, fraction*nPairs);
+    pp->set_PP1D_weighted(i, fraction*nPairs_weighted);
+  }
+}
+
+
+// ============================================================================
+
+
 void cbl::measure::twopt::TwoPointCorrelation::count_allPairs (const TwoPType type, const std::string dir_output_pairs, const std::vector<std::string> dir_input_pairs, const bool count_dd, const bool count_rr, const bool count_dr, const bool tcount, const Estimator estimator)  
 {
+  // ----------- in a periodic box, the random pairs are computed analytically, and normalised with the number of data objects ----------- 
+
+  const bool periodic = (m_periodic_box>0.);
+
+  if (periodic) {
+    if (type==TwoPType::_angular_)
+      ErrorCBL("Error in count_allPairs() of TwoPointCorrelation.cpp: the angular two-point correlation function cannot be measured in a periodic box!");
+    // the line of sight of the pairs with the periodic images would depend on the image counted, so only the monopole is measured
+    if (m_dd->pairType()!=PairType::_comoving_lin_ && m_dd->pairType()!=PairType::_comoving_log_)
+      ErrorCBL("Error in count_allPairs() of TwoPointCorrelation.cpp: only the monopole of the two-point correlation function can be measured in a periodic box!");
+    if (m_compute_extra_info)
+      ErrorCBL("Error in count_allPairs() of TwoPointCorrelation.cpp: the extra information of the pairs cannot be computed in a periodic box!");
+    if (m_grid_transition>0.)
+      ErrorCBL("Error in count_allPairs() of TwoPointCorrelation.cpp: the pairs cannot be counted on a grid in a periodic box!");
+
+    // the random pairs are not diluted, as they are computed analytically
+    m_random_dilution_fraction = 1.;
+  }
+
+  
   // ----------- compute polar coordinates, if necessary ----------- 
 
   if (!m_data->isSetVar(Var::_RA_) || !m_data->isSetVar(Var::_Dec_) || !m_data->isSetVar(Var::_Dc_))
     m_data->computePolarCoordinates();
   
-  if (!m_random->isSetVar(Var::_RA_) || !m_random->isSetVar(Var::_Dec_) || !m_random->isSetVar(Var::_Dc_))
+  if (!periodic && (!m_random->isSetVar(Var::_RA_) || !m_random->isSetVar(Var::_Dec_) || !m_random->isSetVar(Var::_Dc_)))
     m_random->computePolarCoordinates();
   
   if (type==TwoPType::_angular_) {
@@ -310,7 +912,8 @@ void cbl::measure::twopt::TwoPointCorrelation::count_allPairs (const TwoPType ty
     WarningMsg("Attention: --> m_random_dilution_fraction = 1, since the random catalogue is not diluted when using the natural estimator!");
   }
 
-  auto random_dil = make_shared<catalogue::Catalogue>(catalogue::Catalogue(move(m_random->diluted_catalogue(m_random_dilution_fraction))));
+  // the random catalogue is not used in a periodic box
+  auto random_dil = (periodic) ? nullptr : make_shared<catalogue::Catalogue>(m_random->diluted_catalogue(m_random_dilution_fraction));
   
   
   // ----------- create the chain-mesh ----------- 
@@ -334,19 +937,47 @@ void cbl::measure::twopt::TwoPointCorrelation::count_allPairs (const TwoPType ty
 
   else
     ErrorCBL("Error in count_allPairs() of TwoPointCorrelation.cpp: the chosen two-point correlation function type is uknown!");
-  
-  double cell_size = rMAX*0.1; // to be optimized!!!
+
+
+  // ----------- the pairs above the transition scale are counted on a grid, so the close objects are searched only up to the first bin counted on the grid ----------- 
+
+  const bool grid = (m_grid_transition>0.);
+  double rGrid = rMAX;
+
+  if (grid) {
+    if (m_distributed_catalogues && wrapper::mpi::distributed())
+      ErrorCBL("Error in count_allPairs() of TwoPointCorrelation.cpp: the pairs cannot be counted on a grid if the catalogues are distributed across the MPI tasks!");
+    // the 2D pairs and the wedges would have to be reconstructed from the multipoles up to l=4, which is biased
+    if (type!=TwoPType::_monopole_ && type!=TwoPType::_multipoles_direct_ && type!=TwoPType::_filtered_ && type!=TwoPType::_multipoles_integrated_)
+      ErrorCBL("Error in count_allPairs() of TwoPointCorrelation.cpp: the pairs can be counted on a grid only for the monopole and the multipoles of the two-point correlation function!");
+    
+    const vector<double> limits = grid_bin_limits(m_dd);
+    rGrid = *lower_bound(limits.begin(), limits.end()-1, m_grid_transition);
+    rMAX = min(rMAX, rGrid);
+  }
   
   ChainMesh_Catalogue ChM_data, ChM_random, ChM_random_dil;
+  KDTree_Catalogue tree_data, tree_random, tree_random_dil;
   
-  if (count_dd)
-    ChM_data.set_par(cell_size, m_data, rMAX);
+  const bool kdTree = (m_spatialIndex==SpatialIndex::_kdTree_);
+
+  // if the count is distributed across MPI tasks, each task constructs the spatial indices of its slab
+  const bool distributed = wrapper::mpi::distributed();
   
-  if (count_rr)
-    ChM_random_dil.set_par(cell_size, random_dil, rMAX);
+  if (count_dd && !distributed) {
+    if (kdTree) tree_data.set_par(m_data, rMAX);
+    else ChM_data.set_par(chainMesh_cell_size(m_data, rMAX, m_dd), m_data, rMAX);
+  }
+  
+  if (count_rr && !distributed && !periodic) {
+    if (kdTree) tree_random_dil.set_par(random_dil, rMAX);
+    else ChM_random_dil.set_par(chainMesh_cell_size(random_dil, rMAX, m_rr), random_dil, rMAX);
+  }
 
-  if (count_dr)
-    ChM_random.set_par(cell_size, m_random, rMAX);    
+  if (count_dr && !distributed && !periodic) {
+    if (kdTree) tree_random.set_par(m_random, rMAX);
+    else ChM_random.set_par(chainMesh_cell_size(m_random, rMAX, m_dr), m_random, rMAX);    
+  }
   
   
   // ----------- count the number of pairs or read them from file -----------
@@ -357,8 +988,12 @@ void cbl::measure::twopt::TwoPointCorrelation::count_allPairs (const TwoPType ty
   file = "dd.dat";
  
   if (count_dd) {
-    count_pairs(m_data, ChM_data, m_dd, false, tcount);
-    if (dir_output_pairs!=par::defaultString) write_pairs(m_dd, dir_output_pairs, file);
+    if (distributed) count_pairs_distributed(m_data, m_data, rMAX, m_dd, {}, false, tcount);
+    else if (kdTree) count_pairs(m_data, tree_data, m_dd, false, tcount);
+    else count_pairs(m_data, ChM_data, m_dd, false, tcount);
+    if (grid) count_pairs_grid(m_data, m_data, m_dd, false, rGrid);
+    if (periodic) count_pairs_periodic(rMAX, m_dd, tcount);
+    if (dir_output_pairs!=par::defaultString && wrapper::mpi::rank()==0) write_pairs(m_dd, dir_output_pairs, file);
   }
   else read_pairs(m_dd, dir_input_pairs, file);
   
@@ -367,8 +1002,12 @@ void cbl::measure::twopt::TwoPointCorrelation::count_allPairs (const TwoPType ty
   file = "rr.dat";
  
   if (count_rr) {
-    count_pairs(random_dil, ChM_random_dil, m_rr, false, tcount);
-    if (dir_output_pairs!=par::defaultString) write_pairs(m_rr, dir_output_pairs, file);
+    if (periodic) set_pairs_periodic(m_rr, 0.5*m_nRandom()*(m_nRandom()-1.), 0.5*m_weightedN_random()*(m_weightedN_random()-1.));
+    else if (distributed) count_pairs_distributed(random_dil, random_dil, rMAX, m_rr, {}, false, tcount);
+    else if (kdTree) count_pairs(random_dil, tree_random_dil, m_rr, false, tcount);
+    else count_pairs(random_dil, ChM_random_dil, m_rr, false, tcount);
+    if (grid) count_pairs_grid(random_dil, random_dil, m_rr, false, rGrid);
+    if (dir_output_pairs!=par::defaultString && wrapper::mpi::rank()==0) write_pairs(m_rr, dir_output_pairs, file);
   }
   else read_pairs(m_rr, dir_input_pairs, file);
 
@@ -379,17 +1018,23 @@ void cbl::measure::twopt::TwoPointCorrelation::count_allPairs (const TwoPType ty
     file = "dr.dat";
     
     if (count_dr) {
-      count_pairs(m_data, ChM_random, m_dr, true, tcount);
-      if (dir_output_pairs!=par::defaultString) write_pairs(m_dr, dir_output_pairs, file);
+      if (periodic) set_pairs_periodic(m_dr, (double)m_nObjects(m_data)*m_nRandom(), m_weightedN(m_data)*m_weightedN_random());
+      else if (distributed) count_pairs_distributed(m_data, m_random, rMAX, m_dr, {}, true, tcount);
+      else if (kdTree) count_pairs(m_data, tree_random, m_dr, true, tcount);
+      else count_pairs(m_data, ChM_random, m_dr, true, tcount);
+      if (grid) count_pairs_grid(m_data, m_random, m_dr, true, rGrid);
+      if (dir_output_pairs!=par::defaultString && wrapper::mpi::rank()==0) write_pairs(m_dr, dir_output_pairs, file);
     }
     else read_pairs(m_dr, dir_input_pairs, file);
 
   }
   
-  if (count_dd)
+  // the kd-tree and the distributed count do not reorder the catalogues
+  
+  if (count_dd && !kdTree && !distributed)
     m_data->Order();
   
-  if (count_rr || count_dr)
+  if ((count_rr || count_dr) && !kdTree && !distributed && !periodic)
     m_random->Order();
 
   if (type==TwoPType::_angular_) {
@@ -432,70 +1077,162 @@ double cbl::measure::twopt::TwoPointCorrelation::PoissonError (const Estimator e
 
 
 void cbl::measure::twopt::TwoPointCorrelation::count_pairs_region (const std::shared_ptr<Catalogue> cat1, const ChainMesh_Catalogue &ChM, std::shared_ptr<Pair> pp, std::vector<std::shared_ptr<Pair>> pp_regions, const bool cross, const bool tcount)  
+{ 
+  // objects of the second catalogue (get from the chain mesh) and of the first catalogue, ordered by
+  // chain-mesh cell and, inside each cell, by region
+  const chainmesh::CellObjects &objects2 = ChM.cellObjects();
+  objects2.check_variables(pp->variables());
+  const chainmesh::CellObjects objects1_cross = (cross) ? ChM.cell_objects(cat1, pp->variables()) : chainmesh::CellObjects();
+  const chainmesh::CellObjects &objects1 = (cross) ? objects1_cross : objects2;
+
+  count_pairs_region_cells(objects1, objects2, [&] (const long i) { return ChM.close_cells(objects1.nonEmpty_cells[i]); }, pp, pp_regions, cross, tcount);
+}
+
+
+// ============================================================================
+
+
+void cbl::measure::twopt::TwoPointCorrelation::count_pairs_region (const std::shared_ptr<Catalogue> cat1, const KDTree_Catalogue &tree, std::shared_ptr<Pair> pp, std::vector<std::shared_ptr<Pair>> pp_regions, const bool cross, const bool tcount)  
+{ 
+  // objects of the second catalogue (get from the kd-tree) and of the first catalogue, ordered by
+  // leaf and, inside each leaf, by region
+  const chainmesh::CellObjects &objects2 = tree.cellObjects();
+  objects2.check_variables(pp->variables());
+  const chainmesh::CellObjects objects1_cross = (cross) ? tree.cell_objects(cat1, pp->variables()) : chainmesh::CellObjects();
+  const chainmesh::CellObjects &objects1 = (cross) ? objects1_cross : objects2;
+
+  count_pairs_region_cells(objects1, objects2, [&] (const long i) { return tree.close_cells(objects1, i); }, pp, pp_regions, cross, tcount);
+}
+
+
+// ============================================================================
+
+
+void cbl::measure::twopt::TwoPointCorrelation::count_pairs_region_cells (const chainmesh::CellObjects &objects1, const chainmesh::CellObjects &objects2, std::function<std::vector<long>(const long)> close_cells, std::shared_ptr<Pair> pp, std::vector<std::shared_ptr<Pair>> pp_regions, const bool cross, const bool tcount)  
 { 
   // timer 
   time_t start; time (&start);
   int dp = cout.precision();
   cout.setf(ios::fixed); cout.setf(ios::showpoint); cout.precision(2);
 
-  // number of objects in the first catalogue
-  int nObj = cat1->nObjects();
-
-  // factor used by the timer
-  float fact_count = 100./nObj;
-
-  // pointer to the second catalogue (get from the chain mesh)
-  shared_ptr<Catalogue> cat2 = ChM.catalogue();
+  // check the regions: their number is derived from the number of couples of regions, since
+  // the catalogues may contain only some of them (e.g. when distributed across MPI tasks)
+  const int nRegions = (cross) ? nint(sqrt(pp_regions.size())) : nint((sqrt(8.*pp_regions.size()+1.)-1.)*0.5);
+  for (auto &&objects : {&objects1, &objects2}) 
+    if (objects->nObjects()>0) {
+      const auto lim = minmax_element(objects->region.begin(), objects->region.end());
+      if (*lim.first<0 || *lim.second>=nRegions)
+	ErrorCBL("Error in cbl::measure::twopt::TwoPointCorrelation::count_pairs_region_cells(): check the regions! You might use the function cbl::check_regions()");
+    }
 
+  // index of the Pair of a couple of regions in pp_regions
+  auto couple = [&] (const long reg1, const long reg2) {
+    if (cross) return reg1*nRegions+reg2;
+    const long rr1 = min(reg1, reg2), rr2 = max(reg1, reg2);
+    return rr1*nRegions+rr2-(rr1-1)*rr1/2-rr1;
+  };
+  
+  // for each object, the index of the first object of the same cell with a different region (or the
+  // end of the cell), used to loop over the blocks of objects of each region of a cell
+  auto region_blocks = [] (const chainmesh::CellObjects &objects) {
+    vector<long> next(objects.nObjects());
+    for (auto &&cell : objects.nonEmpty_cells)
+      for (long i=objects.first[cell+1]-1; i>=objects.first[cell]; --i)
+	next[i] = (i+1<objects.first[cell+1] && objects.region[i+1]==objects.region[i]) ? next[i+1] : i+1;
+    return next;
+  };
+  const vector<long> next2 = region_blocks(objects2);
+  const vector<long> next1_cross = (cross) ? region_blocks(objects1) : vector<long>();
+  const vector<long> &next1 = (cross) ? next1_cross : next2;
+
+  // number of non-empty cells of the first catalogue
+  const int nCells = objects1.nonEmpty_cells.size();
+
+  // cost of each non-empty cell of the first catalogue, and the cells sorted by decreasing cost
+  vector<double> cost(nCells);
+  vector<int> order;
+  
+  // progress of the pair count
+  shared_ptr<ProgressReporter> progress;
+  
   // thread number
   int tid = 0;
 
-  // check the regions
-  const int nRegions = cat2->nRegions();
-  if (cat1->Max(catalogue::Var::_Region_)>=nRegions || cat2->Max(catalogue::Var::_Region_)>=nRegions)
-    WarningMsg("Error in cbl::measure::twopt::TwoPointCorrelation::count_pairs_region(): check the regions! You might use the function cbl::check_regions()");
-    
+  // the pairs computed by each thread for each couple of regions (see below)
+  vector<vector<shared_ptr<Pair>>> pp_threads(omp_get_max_threads());
+
 #pragma omp parallel num_threads(omp_get_max_threads()) private(tid)
   {
     tid = omp_get_thread_num();
 
-    vector<shared_ptr<Pair> > pp_thread(pp_regions.size());
-    
-    for (size_t i=0; i<pp_regions.size(); ++i) 
-      pp_thread[i] = (pp->pairDim()==Dim::_1D_) ? move(Pair::Create(pp->pairType(), pp->pairInfo(), pp->sMin(), pp->sMax(), pp->nbins(), pp->shift(), pp->angularUnits(), pp->angularWeight()))
-	: move(Pair::Create(pp->pairType(), pp->pairInfo(), pp->sMin_D1(), pp->sMax_D1(), pp->nbins_D1(), pp->shift_D1(), pp->sMin_D2(), pp->sMax_D2(), pp->nbins_D2(), pp->shift_D2(), pp->angularUnits(), pp->angularWeight()));
-    
-    
-    // parallelized loop
-#pragma omp for schedule(static, 2)
-    for (int i=0; i<nObj; ++i) {  
-      
-      vector<long int> close_objects = ChM.close_objects(cat1->coordinate(i), (cross) ? -1 : i);
+#pragma omp for schedule(dynamic, 64)
+    for (int i=0; i<nCells; ++i) 
+      cost[i] = cell_cost(objects1, objects2, close_cells, i, cross);
 
-      for (auto &&j : close_objects) {      
-	const int reg1 = (cross) ? cat1->region(i) : min(cat1->region(i), cat2->region(j));
-	const int reg2 = (cross) ? cat2->region(j) : max(cat1->region(i), cat2->region(j));
-	const size_t index = (cross) ? reg1*nRegions+reg2 : reg1*nRegions+reg2-(reg1-1)*reg1/2-reg1;
-	pp_thread[index]->put(cat1->catalogue_object(i), cat2->catalogue_object(j));
-      }
-      
-      // estimate the computational time and update the time count
-      time_t end_temp; time (&end_temp); double diff_temp = difftime(end_temp, start);
-      if (tcount && tid==0) { coutCBL << "\r" << float(i)*fact_count << "% completed (" << diff_temp << " seconds)\r"; cout.flush(); }    
-      if (i==int(nObj*0.25)) coutCBL << ".............25% completed" << endl;
-      if (i==int(nObj*0.5)) coutCBL << ".............50% completed" << endl;
-      if (i==int(nObj*0.75)) coutCBL << ".............75% completed"<< endl;   
+#pragma omp single
+    {
+      order = cost_order(cost);
+      progress = make_shared<ProgressReporter>(accumulate(cost.begin(), cost.end(), 0.), tcount);
     }
+
+    // the pairs computed by the thread for each couple of regions: the Pair of a couple is created
+    // the first time the thread finds it, and is then used for all the cells handled by the thread;
+    // each thread allocates its own row of the table and its own Pair objects, so that the threads
+    // do not write on the same cache lines
+    vector<shared_ptr<Pair>> &pp_thread = pp_threads[tid];
+    pp_thread.resize(pp_regions.size());
     
-#pragma omp critical
-    {
-      // sum all the object pairs computed by each thread
-      for (size_t i=0; i<pp_regions.size(); ++i)
-	pp_regions[i]->Sum(pp_thread[i]);
+    // parallelized loop: the cells are handled by the threads as in count_pairs_cells, the most
+    // expensive first, and the idle threads take the next cell
+#pragma omp for schedule(dynamic)
+    for (int k=0; k<nCells; ++k) {
+
+      const int i = order[k];
+      const long cell1 = objects1.nonEmpty_cells[i];
+
+      for (auto &&cell2 : close_cells(i)) {
+
+	// in the auto-correlation case, each couple of cells is considered only once
+	if (!cross && cell2<cell1) continue;
+	
+	const long index2 = objects2.nonEmpty_index(cell2);
+	if (index2<0) continue;
+
+	double dist_min, dist_max;
+	objects1.separation_range(i, objects2, index2, dist_min, dist_max);
+
+	const bool same_cell = (!cross && cell2==cell1);
+	
+	// loop on the blocks of objects of the same region in the two cells
+	for (long i1=objects1.first[cell1]; i1<objects1.first[cell1+1]; i1=next1[i1])
+	  for (long j1=(same_cell) ? i1 : objects2.first[cell2]; j1<objects2.first[cell2+1]; j1=next2[j1]) {
+
+	    shared_ptr<Pair> &pp_couple = pp_thread[couple(objects1.region[i1], objects2.region[j1])];
+	    if (!pp_couple) pp_couple = empty_pair(pp);
+
+	    // the same block kernels of count_pairs_cells
+	    const bool auto_pairs = (same_cell && j1==i1);
+	    if (!pp_couple->put_cells(objects1, i1, next1[i1], objects2, j1, next2[j1], auto_pairs, dist_min, dist_max))
+	      pp_couple->put(objects1, i1, next1[i1], objects2, j1, next2[j1], auto_pairs);
+	  }
+      }
+      
+      // update the time count
+      progress->update(cost[i], tid);
     }
 
-  }
+    // sum the pairs computed by the threads, in parallel over the couples of regions: the pairs are
+    // summed exactly (see pairs::ExactSum), so the result does not depend on how the cells are shared
+    // among the threads
+#pragma omp for schedule(dynamic)
+    for (size_t c=0; c<pp_regions.size(); ++c)
+      for (auto &&pp_t : pp_threads)
+	if (c<pp_t.size() && pp_t[c]) {
+	  pp_regions[c]->Sum(pp_t[c]);
+	  pp_t[c].reset();
+	}
 
+  }
   
   // show the time spent by the method
   time_t end; time (&end);
@@ -526,7 +1263,7 @@ void cbl::measure::twopt::TwoPointCorrelation::count_pairs_region (const std::sh
       break;
 
     default:
-      ErrorCBL("Error in count_pairs_region of TwoPointCorrelation.cpp, no such type of pair dimension");
+      ErrorCBL("Error in count_pairs_region_cells of TwoPointCorrelation.cpp, no such type of pair dimension");
       break;
   }
   
@@ -536,6 +1273,259 @@ void cbl::measure::twopt::TwoPointCorrelation::count_pairs_region (const std::sh
 // ============================================================================
 
 
+void cbl::measure::twopt::TwoPointCorrelation::count_pairs_distributed (const std::shared_ptr<Catalogue> cat1, const std::shared_ptr<Catalogue> cat2, const double rMAX, std::shared_ptr<Pair> pp, std::vector<std::shared_ptr<Pair>> pp_regions, const bool cross, const bool tcount)
+{
+  const int nTasks = wrapper::mpi::size(), task = wrapper::mpi::rank();
+
+  // the objects of a catalogue handled by this task: if the catalogues are distributed, each task
+  // holds a different part of them and handles all its objects; otherwise, the catalogues are read
+  // by all the tasks, and each task handles a contiguous block of them
+  auto block = [&] (const shared_ptr<Catalogue> cat)
+    {
+      const size_t nObj = cat->nObjects();
+      return (m_distributed_catalogues) ? vector<size_t> {0, nObj} : vector<size_t> {nObj*task/nTasks, nObj*(task+1)/nTasks};
+    };
+  
+
+  // ----------- slab decomposition -----------
+
+  // the slabs are perpendicular to the axis of largest extent of the first catalogue, and their
+  // boundaries are the quantiles of the object coordinates, estimated from a sample of the objects
+  // handled by each task, so that each task owns approximately the same number of objects of the
+  // first catalogue; the samples are gathered by all the tasks, so the boundaries are the same for
+  // all of them
+
+  const vector<size_t> block1 = block(cat1);
+  
+  vector<double> limits = {numeric_limits<double>::max(), numeric_limits<double>::max(), numeric_limits<double>::max(), -numeric_limits<double>::max(), -numeric_limits<double>::max(), -numeric_limits<double>::max()};
+  for (size_t i=block1[0]; i<block1[1]; ++i) {
+    const shared_ptr<Object> obj = cat1->catalogue_object(i);
+    const double pos[3] = {obj->xx(), obj->yy(), obj->zz()};
+    for (int k=0; k<3; ++k) {
+      limits[k] = min(limits[k], pos[k]);
+      limits[k+3] = max(limits[k+3], pos[k]);
+    }
+  }
+  
+  const vector<vector<double>> limits_tasks = wrapper::mpi::allgather(limits);
+  for (int t=0; t<nTasks; ++t) 
+    for (int k=0; k<3; ++k) {
+      limits[k] = min(limits[k], limits_tasks[t][k]);
+      limits[k+3] = max(limits[k+3], limits_tasks[t][k+3]);
+    }
+
+  int axis = 0;
+  for (int k=1; k<3; ++k)
+    if (limits[k+3]-limits[k]>limits[axis+3]-limits[axis]) axis = k;
+  
+  auto coordinate = [&axis] (const shared_ptr<Object> obj) { return (axis==0) ? obj->xx() : (axis==1) ? obj->yy() : obj->zz(); };
+
+  // each task provides the coordinates of a sample of its objects, equally spaced in rank, and the
+  // number of objects represented by each of them
+  const size_t nSample_max = 1024;
+  
+  vector<double> coord;
+  coord.reserve(block1[1]-block1[0]);
+  for (size_t i=block1[0]; i<block1[1]; ++i)
+    coord.emplace_back(coordinate(cat1->catalogue_object(i)));
+  sort(coord.begin(), coord.end());
+
+  const size_t nSample = min(nSample_max, coord.size());
+  vector<double> sample;
+  for (size_t k=0; k<nSample; ++k) {
+    sample.emplace_back(coord[(coord.size()*(2*k+1))/(2*nSample)]);
+    sample.emplace_back(double(coord.size())/nSample);
+  }
+  vector<double>().swap(coord);
+  
+  vector<pair<double, double>> samples;
+  double nTot = 0.;
+  for (auto &&sample_task : wrapper::mpi::allgather(sample))
+    for (size_t k=0; k<sample_task.size(); k+=2) {
+      samples.emplace_back(sample_task[k], sample_task[k+1]);
+      nTot += sample_task[k+1];
+    }
+  sort(samples.begin(), samples.end());
+  
+  vector<double> boundary(nTasks+1, 0.);
+  boundary[0] = -numeric_limits<double>::max();
+  boundary[nTasks] = numeric_limits<double>::max();
+  double cumulative = 0.;
+  int tt = 1;
+  for (size_t k=0; k<samples.size() && tt<nTasks; ++k) {
+    cumulative += samples[k].second;
+    while (tt<nTasks && cumulative>=nTot*tt/nTasks) boundary[tt++] = samples[k].first;
+  }
+  // the last boundaries might be missed because of the round-off of the cumulative numbers
+  for (; tt<nTasks; ++tt) boundary[tt] = (samples.size()>0) ? samples.back().first : 0.;
+  
+  // the task that owns the objects with a given coordinate
+  auto owner = [&boundary] (const double xx) { return int(upper_bound(boundary.begin()+1, boundary.end()-1, xx)-boundary.begin()-1); };
+
+  
+  // ----------- exchange the objects and the halos -----------
+
+  // each task sends the objects of a catalogue it handles: every object is sent to the task that owns
+  // it and, as part of the halo, to the tasks whose slab is closer than rMAX on the required sides;
+  // the objects received are returned as two catalogues, containing the owned objects and the halo,
+  // so that each task holds only the objects of its slab and of its halo
+
+  auto exchange = [&] (const shared_ptr<Catalogue> cat, const bool halo_left, const bool halo_right)
+    {
+      const size_t nData = 10;
+      const vector<size_t> lim = block(cat);
+      vector<vector<double>> send(nTasks);
+      
+      for (size_t i=lim[0]; i<lim[1]; ++i) {
+	shared_ptr<Object> obj = cat->catalogue_object(i);
+	const vector<double> data = {obj->xx(), obj->yy(), obj->zz(), (obj->isSet_ra()) ? obj->ra() : par::defaultDouble, (obj->isSet_dec()) ? obj->dec() : par::defaultDouble, (obj->isSet_dc()) ? obj->dc() : par::defaultDouble, (obj->isSet_redshift()) ? obj->redshift() : par::defaultDouble, obj->weight(), (obj->isSet_region()) ? double(obj->region()) : double(par::defaultLong)};
+	
+	const double xx = data[axis];
+	const int own = owner(xx);
+
+	auto add = [&] (const int t, const double owned) { send[t].push_back(owned); send[t].insert(send[t].end(), data.begin(), data.end()); };
+
+	add(own, 1.);
+	// the tasks on the left need this object if it is in the halo on the right of their slab, and viceversa
+	for (int t=own-1; halo_right && t>=0 && xx<boundary[t+1]+rMAX; --t) add(t, 0.);
+	for (int t=own+1; halo_left && t<nTasks && xx>=boundary[t]-rMAX; ++t) add(t, 0.);
+      }
+
+      const vector<vector<double>> received = wrapper::mpi::alltoall(send);
+
+      vector<shared_ptr<Object>> owned, halo;
+      for (int t=0; t<nTasks; ++t)
+	for (size_t k=0; k<received[t].size(); k+=nData) {
+	  const double *data = &received[t][k];
+	  auto obj = make_shared<Object>(data[1], data[2], data[3], data[4], data[5], data[7], data[8], long(data[9]));
+	  // the comoving distance is restored without changing the coordinates (that might have been normalised)
+	  if (isSet(data[6])) { obj->set_dc(data[6]); obj->set_xx(data[1]); obj->set_yy(data[2]); obj->set_zz(data[3]); }
+	  ((data[0]>0.) ? owned : halo).push_back(obj);
+	}
+
+      return vector<shared_ptr<Catalogue>> {make_shared<Catalogue>(Catalogue(owned)), make_shared<Catalogue>(Catalogue(halo))};
+    };
+
+  
+  // ----------- count the pairs of each task -----------
+
+  shared_ptr<Pair> pp_task = empty_pair(pp);
+  vector<shared_ptr<Pair>> pp_regions_task(pp_regions.size());
+  for (auto &&pp_region : pp_regions_task) pp_region = empty_pair(pp);
+
+  // function to count the pairs between two catalogues of this task
+  auto count = [&] (const shared_ptr<Catalogue> c1, const shared_ptr<Catalogue> c2, shared_ptr<Pair> pp_count, vector<shared_ptr<Pair>> pp_regions_count, const bool cross_count)
+    {
+      if (c1->nObjects()==0 || c2->nObjects()==0) return;
+      
+      if (pp_regions_count.size()>0) {
+	if (m_spatialIndex==SpatialIndex::_kdTree_)
+	  count_pairs_region(c1, KDTree_Catalogue(c2, rMAX), pp_count, pp_regions_count, cross_count, tcount && task==0);
+	else 
+	  count_pairs_region(c1, ChainMesh_Catalogue(chainMesh_cell_size(c2, rMAX, pp), c2, rMAX), pp_count, pp_regions_count, cross_count, tcount && task==0);
+      }
+      else if (m_spatialIndex==SpatialIndex::_kdTree_) 
+	count_pairs(c1, KDTree_Catalogue(c2, rMAX), pp_count, cross_count, tcount && task==0);
+      else 
+	count_pairs(c1, ChainMesh_Catalogue(chainMesh_cell_size(c2, rMAX, pp), c2, rMAX), pp_count, cross_count, tcount && task==0);
+    };
+  
+  if (cross) {
+    // the objects of the first catalogue owned by this task, and the objects of the second catalogue close to its slab
+    const shared_ptr<Catalogue> local1 = exchange(cat1, false, false)[0];
+    const vector<shared_ptr<Catalogue>> local2 = exchange(cat2, true, true);
+    local2[0]->add_objects(local2[1]->sample());
+    
+    count(local1, local2[0], pp_task, pp_regions_task, true);
+  }
+
+  else {
+    // the pairs of objects owned by different tasks are counted by the task with the lowest index,
+    // that receives only the halo on the right of its slab
+    const vector<shared_ptr<Catalogue>> local = exchange(cat1, false, true);
+
+    count(local[0], local[0], pp_task, pp_regions_task, false);
+
+    // the couples of regions of the pairs between the owned objects and the halo are ordered as
+    // the auto pairs, that is with the lowest region first
+    const int nRegions = nint((sqrt(8.*pp_regions.size()+1.)-1.)*0.5);
+    shared_ptr<Pair> pp_halo = empty_pair(pp);
+    vector<shared_ptr<Pair>> pp_regions_halo(nRegions*nRegions);
+    for (auto &&pp_region : pp_regions_halo) pp_region = empty_pair(pp);
+
+    count(local[0], local[1], pp_halo, pp_regions_halo, true);
+
+    pp_task->Sum(pp_halo);
+    for (int reg1=0; reg1<nRegions; ++reg1)
+      for (int reg2=0; reg2<nRegions; ++reg2) {
+	const int regMin = min(reg1, reg2), regMax = max(reg1, reg2);
+	pp_regions_task[regMin*nRegions+regMax-(regMin-1)*regMin/2-regMin]->Sum(pp_regions_halo[reg1*nRegions+reg2]);
+      }
+  }
+
+  
+  // ----------- sum the pairs of all the tasks -----------
+
+  // the pairs are gathered by all the tasks and summed in the same order, so that the result is
+  // the same for all of them and does not depend on the MPI implementation of the reduction; since
+  // the pairs are summed exactly (see pairs::ExactSum), the result is also the same as that of a
+  // single task, bit by bit
+  
+  vector<double> data = pp_task->data();
+  for (auto &&pp_region : pp_regions_task) {
+    const vector<double> data_region = pp_region->data();
+    data.insert(data.end(), data_region.begin(), data_region.end());
+  }
+  
+  const vector<vector<double>> data_tasks = wrapper::mpi::allgather(data);
+  const size_t nData = data.size()/(pp_regions.size()+1);
+
+  for (int t=0; t<nTasks; ++t) {
+    pp->add_data(vector<double>(data_tasks[t].begin(), data_tasks[t].begin()+nData));
+    for (size_t r=0; r<pp_regions.size(); ++r)
+      pp_regions[r]->add_data(vector<double>(data_tasks[t].begin()+(r+1)*nData, data_tasks[t].begin()+(r+2)*nData));
+  }
+
+  if (task==0) 
+    coutCBL << "the pairs have been counted by " << nTasks << " MPI tasks" << endl;
+}
+
+
+// ============================================================================
+
+
+size_t cbl::measure::twopt::TwoPointCorrelation::m_nObjects (const std::shared_ptr<Catalogue> catalogue) const
+{
+  if (!m_distributed_catalogues) return catalogue->nObjects();
+
+  // the numbers of objects are exact in double precision up to 2^53
+  size_t nObj = 0;
+  for (auto &&nObj_task : wrapper::mpi::allgather({double(catalogue->nObjects())}))
+    nObj += size_t(nObj_task[0]);
+
+  return nObj;
+}
+
+
+// ============================================================================
+
+
+double cbl::measure::twopt::TwoPointCorrelation::m_weightedN (const std::shared_ptr<Catalogue> catalogue) const
+{
+  if (!m_distributed_catalogues) return catalogue->weightedN();
+
+  // the weighted numbers of the tasks are summed in rank order, as the pairs
+  double nObj = 0.;
+  for (auto &&nObj_task : wrapper::mpi::allgather({catalogue->weightedN()}))
+    nObj += nObj_task[0];
+
+  return nObj;
+}
+
+
+// ============================================================================
+
+
 void cbl::measure::twopt::TwoPointCorrelation::count_pairs_region_test (const std::shared_ptr<Catalogue> cat1, const ChainMesh_Catalogue &ChM, std::shared_ptr<Pair> pp, std::vector<std::shared_ptr<Pair>> pp_res, const std::vector<double> weight, const bool cross, const bool tcount)  
 {
   if(pp->pairDim()==Dim::_1D_)
@@ -560,8 +1550,8 @@ void cbl::measure::twopt::TwoPointCorrelation::count_pairs_region_test_1D (const
   // number of objects in the first catalogue
   int nObj = cat1->nObjects();
 
-  // factor used by the timer
-  float fact_count = 100./nObj;
+  // progress of the count
+  ProgressReporter progress(nObj, tcount);
 
   // pointer to the second catalogue (get from the chain mesh)
   shared_ptr<Catalogue> cat2 = ChM.catalogue();
@@ -569,6 +1559,9 @@ void cbl::measure::twopt::TwoPointCorrelation::count_pairs_region_test_1D (const
   // thread number
   int tid = 0;
 
+  // pairs computed by each thread, summed with a tree reduction
+  vector<shared_ptr<Pair>> pp_threads(omp_get_max_threads());
+  vector<vector<shared_ptr<Pair>>> pp_res_threads(omp_get_max_threads());
    
 #pragma omp parallel num_threads(omp_get_max_threads()) private(tid)
   {
@@ -583,7 +1576,7 @@ void cbl::measure::twopt::TwoPointCorrelation::count_pairs_region_test_1D (const
       pp_res_thread[i] = move(Pair::Create(pp->pairType(), PairInfo::_standard_, pp->sMin(), pp->sMax(), pp->nbins(), pp->shift(), pp->angularUnits(), pp->angularWeight()));
     
     // parallelized loop
-#pragma omp for schedule(static, 2)
+#pragma omp for schedule(dynamic, 16)
     for (int i=0; i<nObj; ++i) {
 
       vector<long int> close_objects = ChM.close_objects(cat1->coordinate(i), (cross) ? -1 : i);
@@ -604,21 +1597,22 @@ void cbl::measure::twopt::TwoPointCorrelation::count_pairs_region_test_1D (const
 	  pp_res_thread[k]->set_pair(kk, wkk, ww[k]);
       }
       
-      // estimate the computational time and update the time count
-      time_t end_temp; time (&end_temp); double diff_temp = difftime(end_temp, start);
-      if (tcount && tid==0) { coutCBL << "\r" << float(i)*fact_count << "% completed (" << diff_temp << " seconds)\r"; cout.flush(); }    
-      if (i==int(nObj*0.25)) coutCBL << ".............25% completed" << endl;
-      if (i==int(nObj*0.5)) coutCBL << ".............50% completed" << endl;
-      if (i==int(nObj*0.75)) coutCBL << ".............75% completed"<< endl;   
+      // update the time count
+      progress.update(1., tid);
     }
     
-#pragma omp critical
+    // sum all the object pairs computed by each thread
+    pp_threads[tid] = move(pp_thread);
+    pp_res_threads[tid] = move(pp_res_thread);
+    tree_reduction<shared_ptr<Pair>>(pp_threads, [] (shared_ptr<Pair> &pp1, shared_ptr<Pair> &pp2) { pp1->Sum(pp2); });
+    tree_reduction<vector<shared_ptr<Pair>>>(pp_res_threads, [] (vector<shared_ptr<Pair>> &pp1, vector<shared_ptr<Pair>> &pp2) { for (size_t i=0; i<pp1.size(); ++i) pp1[i]->Sum(pp2[i]); });
+
+#pragma omp master
     {
-      // sum all the object pairs computed by each thread
-      pp->Sum(pp_thread);
+      pp->Sum(pp_threads[0]);
 
       for (size_t i=0; i<pp_res.size(); ++i)
-	pp_res[i]->Sum(pp_res_thread[i]);
+	pp_res[i]->Sum(pp_res_threads[0][i]);
     }
 
   }
@@ -650,14 +1644,18 @@ void cbl::measure::twopt::TwoPointCorrelation::count_pairs_region_test_2D (const
   // number of objects in the first catalogue
   int nObj = cat1->nObjects();
 
-  // factor used by the timer
-  float fact_count = 100./nObj;
+  // progress of the count
+  ProgressReporter progress(nObj, tcount);
 
   // pointer to the second catalogue (get from the chain mesh)
   shared_ptr<Catalogue> cat2 = ChM.catalogue();
 
   // thread number
   int tid = 0;
+
+  // pairs computed by each thread, summed with a tree reduction
+  vector<shared_ptr<Pair>> pp_threads(omp_get_max_threads());
+  vector<vector<shared_ptr<Pair>>> pp_res_threads(omp_get_max_threads());
    
 #pragma omp parallel num_threads(omp_get_max_threads()) private(tid)
   {
@@ -672,7 +1670,7 @@ void cbl::measure::twopt::TwoPointCorrelation::count_pairs_region_test_2D (const
       pp_res_thread[i] =  move(Pair::Create(pp->pairType(), PairInfo::_standard_, pp->sMin_D1(), pp->sMax_D1(), pp->nbins_D1(), pp->shift_D1(), pp->sMin_D2(), pp->sMax_D2(), pp->nbins_D2(), pp->shift_D2(), pp->angularUnits(), pp->angularWeight()));
     
     // parallelized loop
-#pragma omp for schedule(static, 2)
+#pragma omp for schedule(dynamic, 16)
     for (int i=0; i<nObj; ++i) {
 
       vector<long int> close_objects = ChM.close_objects(cat1->coordinate(i), (cross) ? -1 : i);
@@ -696,21 +1694,22 @@ void cbl::measure::twopt::TwoPointCorrelation::count_pairs_region_test_2D (const
 	  pp_res_thread[k]->set_pair(ir, jr, wkk, ww[k]);
       }
       
-      // estimate the computational time and update the time count
-      time_t end_temp; time (&end_temp); double diff_temp = difftime(end_temp, start);
-      if (tcount && tid==0) { coutCBL << "\r" << float(i)*fact_count << "% completed (" << diff_temp << " seconds)\r"; cout.flush(); }    
-      if (i==int(nObj*0.25)) coutCBL << ".............25% completed" << endl;
-      if (i==int(nObj*0.5)) coutCBL << ".............50% completed" << endl;
-      if (i==int(nObj*0.75)) coutCBL << ".............75% completed"<< endl;   
+      // update the time count
+      progress.update(1., tid);
     }
     
-#pragma omp critical
+    // sum all the object pairs computed by each thread
+    pp_threads[tid] = move(pp_thread);
+    pp_res_threads[tid] = move(pp_res_thread);
+    tree_reduction<shared_ptr<Pair>>(pp_threads, [] (shared_ptr<Pair> &pp1, shared_ptr<Pair> &pp2) { pp1->Sum(pp2); });
+    tree_reduction<vector<shared_ptr<Pair>>>(pp_res_threads, [] (vector<shared_ptr<Pair>> &pp1, vector<shared_ptr<Pair>> &pp2) { for (size_t i=0; i<pp1.size(); ++i) pp1[i]->Sum(pp2[i]); });
+
+#pragma omp master
     {
-      // sum all the object pairs computed by each thread
-      pp->Sum(pp_thread);
+      pp->Sum(pp_threads[0]);
 
       for (size_t i=0; i<pp_res.size(); ++i)
-	pp_res[i]->Sum(pp_res_thread[i]);
+	pp_res[i]->Sum(pp_res_threads[0][i]);
     }
 
   }
@@ -734,6 +1733,12 @@ void cbl::measure::twopt::TwoPointCorrelation::count_pairs_region_test_2D (const
 
 void cbl::measure::twopt::TwoPointCorrelation::count_allPairs_region (std::vector<std::shared_ptr<Pair> > &dd_regions, std::vector<std::shared_ptr<Pair> > &rr_regions, std::vector<std::shared_ptr<Pair> > &dr_regions, const TwoPType type, const std::string dir_output_pairs, const std::vector<std::string> dir_input_pairs, const bool count_dd, const bool count_rr, const bool count_dr, const bool tcount, const Estimator estimator)  
 {
+  if (m_periodic_box>0.)
+    ErrorCBL("Error in count_allPairs_region() of TwoPointCorrelation.cpp: the errors cannot be estimated with resampling methods in a periodic box!");
+  
+  if (m_grid_transition>0.)
+    WarningMsg("Attention in count_allPairs_region() of TwoPointCorrelation.cpp: the pairs are not counted on a grid when the errors are estimated with resampling methods!");
+
   // ----------- compute polar coordinates, if necessary ----------- 
 
   if (!m_data->isSetVar(Var::_RA_) || !m_data->isSetVar(Var::_Dec_) || !m_data->isSetVar(Var::_Dc_))
@@ -755,7 +1760,7 @@ void cbl::measure::twopt::TwoPointCorrelation::count_allPairs_region (std::vecto
     WarningMsg("Attention: --> m_random_dilution_fraction = 1, since the random catalogue is not diluted when using the natural estimator!");
   }
 
-  auto random_dil = make_shared<catalogue::Catalogue>(catalogue::Catalogue(move(m_random->diluted_catalogue(m_random_dilution_fraction))));
+  auto random_dil = make_shared<catalogue::Catalogue>(m_random->diluted_catalogue(m_random_dilution_fraction));
   
   
   // ----------- create the chain-mesh ----------- 
@@ -781,18 +1786,30 @@ void cbl::measure::twopt::TwoPointCorrelation::count_allPairs_region (std::vecto
     ErrorCBL("Error in count_allPairs_regions() of TwoPointCorrelation.cpp: the chosen two-point correlation function type is uknown!");
   
   
-  double cell_size = rMAX*0.1; // to be optimized!!!
-
   ChainMesh_Catalogue ChM_data, ChM_random, ChM_random_dil;
+  KDTree_Catalogue tree_data, tree_random, tree_random_dil;
 
-  if (count_dd)
-    ChM_data.set_par(cell_size, m_data, rMAX);
+  // if the count is distributed across MPI tasks, each task constructs the chain-meshes (or the kd-trees) of its slab
+  const bool distributed = wrapper::mpi::distributed();
+  const bool kdTree = (m_spatialIndex==SpatialIndex::_kdTree_);
 
-  if (count_rr || count_dr) 
-    ChM_random.set_par(cell_size, m_random, rMAX);
+  if (m_distributed_catalogues && distributed)
+    ErrorCBL("Error in count_allPairs_region() of TwoPointCorrelation.cpp: the pairs cannot be counted by region if the catalogues are distributed across the MPI tasks!");
 
-  if (count_dr)
-    ChM_random_dil.set_par(cell_size, random_dil, rMAX);
+  if (count_dd && !distributed) {
+    if (kdTree) tree_data.set_par(m_data, rMAX);
+    else ChM_data.set_par(chainMesh_cell_size(m_data, rMAX, m_dd), m_data, rMAX);
+  }
+
+  if ((count_rr || count_dr) && !distributed) {
+    if (kdTree) tree_random.set_par(m_random, rMAX);
+    else ChM_random.set_par(chainMesh_cell_size(m_random, rMAX, m_rr), m_random, rMAX);
+  }
+
+  if (count_dr && !distributed) {
+    if (kdTree) tree_random_dil.set_par(random_dil, rMAX);
+    else ChM_random_dil.set_par(chainMesh_cell_size(random_dil, rMAX, m_rr), random_dil, rMAX);
+  }
 
   
   // ----------- initialize the pair vectors used for resampling ----------- 
@@ -831,8 +1848,10 @@ void cbl::measure::twopt::TwoPointCorrelation::count_allPairs_region (std::vecto
   file_regions = "dd_regions.dat";
 
   if (count_dd) {
-    count_pairs_region(m_data, ChM_data, m_dd, dd_regions, false, tcount);
-    if (dir_output_pairs!=par::defaultString) {
+    if (distributed) count_pairs_distributed(m_data, m_data, rMAX, m_dd, dd_regions, false, tcount);
+    else if (kdTree) count_pairs_region(m_data, tree_data, m_dd, dd_regions, false, tcount);
+    else count_pairs_region(m_data, ChM_data, m_dd, dd_regions, false, tcount);
+    if (dir_output_pairs!=par::defaultString && wrapper::mpi::rank()==0) {
       write_pairs(m_dd, dir_output_pairs, file);
       write_pairs(dd_regions, dir_output_pairs, file_regions);
     }
@@ -849,8 +1868,10 @@ void cbl::measure::twopt::TwoPointCorrelation::count_allPairs_region (std::vecto
   file_regions = "rr_regions.dat";
 
   if (count_rr) {
-    count_pairs_region(random_dil, ChM_random_dil, m_rr, rr_regions, false, tcount);
-    if (dir_output_pairs!=par::defaultString) {
+    if (distributed) count_pairs_distributed(random_dil, random_dil, rMAX, m_rr, rr_regions, false, tcount);
+    else if (kdTree) count_pairs_region(random_dil, tree_random_dil, m_rr, rr_regions, false, tcount);
+    else count_pairs_region(random_dil, ChM_random_dil, m_rr, rr_regions, false, tcount);
+    if (dir_output_pairs!=par::defaultString && wrapper::mpi::rank()==0) {
       write_pairs(m_rr, dir_output_pairs, file);
       write_pairs(rr_regions, dir_output_pairs, file_regions);
     }
@@ -868,8 +1889,10 @@ void cbl::measure::twopt::TwoPointCorrelation::count_allPairs_region (std::vecto
     file_regions = "dr_regions.dat";
     
     if (count_dr) {
-      count_pairs_region(m_data, ChM_random, m_dr, dr_regions, true, tcount);
-      if (dir_output_pairs!=par::defaultString) {
+      if (distributed) count_pairs_distributed(m_data, m_random, rMAX, m_dr, dr_regions, true, tcount);
+      else if (kdTree) count_pairs_region(m_data, tree_random, m_dr, dr_regions, true, tcount);
+      else count_pairs_region(m_data, ChM_random, m_dr, dr_regions, true, tcount);
+      if (dir_output_pairs!=par::defaultString && wrapper::mpi::rank()==0) {
 	write_pairs(m_dr, dir_output_pairs, file);
 	write_pairs(dr_regions, dir_output_pairs, file_regions);
       }
@@ -881,10 +1904,11 @@ void cbl::measure::twopt::TwoPointCorrelation::count_allPairs_region (std::vecto
 
   }
   
-  if (count_dd)
+  // the kd-tree and the distributed count do not reorder the catalogues
+  if (count_dd && !kdTree && !distributed)
     m_data->Order();
   
-  if (count_rr || count_dr) 
+  if ((count_rr || count_dr) && !kdTree && !distributed) 
     m_random->Order();
  
   if (type==TwoPType::_angular_) {
@@ -900,6 +1924,12 @@ void cbl::measure::twopt::TwoPointCorrelation::count_allPairs_region (std::vecto
 
 void cbl::measure::twopt::TwoPointCorrelation::count_allPairs_region_test (const TwoPType type, const std::vector<double> weight, const std::string dir_output_pairs, const std::vector<std::string> dir_input_pairs, const bool count_dd, const bool count_rr, const bool count_dr, const bool tcount, const Estimator estimator)  
 {
+  if (m_periodic_box>0.)
+    ErrorCBL("Error in count_allPairs_region_test() of TwoPointCorrelation.cpp: the errors cannot be estimated with resampling methods in a periodic box!");
+
+  if (m_spatialIndex==SpatialIndex::_kdTree_)
+    WarningMsg("Attention in count_allPairs_region_test() of TwoPointCorrelation.cpp: the pairs are counted with the chain-mesh, since the kd-tree is not implemented for this method!");
+
   // ----------- compute polar coordinates, if necessary ----------- 
 
   if (!m_data->isSetVar(Var::_RA_) || !m_data->isSetVar(Var::_Dec_) || !m_data->isSetVar(Var::_Dc_))
@@ -921,7 +1951,7 @@ void cbl::measure::twopt::TwoPointCorrelation::count_allPairs_region_test (const
     WarningMsg("Attention: --> m_random_dilution_fraction = 1, since the random catalogue is not diluted when using the natural estimator!");
   }
 
-  auto random_dil = make_shared<catalogue::Catalogue>(catalogue::Catalogue(move(m_random->diluted_catalogue(m_random_dilution_fraction))));
+  auto random_dil = make_shared<catalogue::Catalogue>(m_random->diluted_catalogue(m_random_dilution_fraction));
   
   
   // ----------- create the chain-mesh ----------- 
@@ -947,18 +1977,16 @@ void cbl::measure::twopt::TwoPointCorrelation::count_allPairs_region_test (const
     ErrorCBL("Error in count_allPairs_regions() of TwoPointCorrelation.cpp: the chosen two-point correlation function type is uknown!");
   
   
-  double cell_size = rMAX*0.1; // to be optimized!!!
-
   ChainMesh_Catalogue ChM_data, ChM_random, ChM_random_dil;
 
   if (count_dd)
-    ChM_data.set_par(cell_size, m_data, rMAX);
+    ChM_data.set_par(chainMesh_cell_size(m_data, rMAX, m_dd), m_data, rMAX);
 
   if (count_rr || count_dr) 
-    ChM_random.set_par(cell_size, m_random, rMAX);
+    ChM_random.set_par(chainMesh_cell_size(m_random, rMAX, m_rr), m_random, rMAX);
 
   if (count_dr)
-    ChM_random_dil.set_par(cell_size, random_dil, rMAX);
+    ChM_random_dil.set_par(chainMesh_cell_size(random_dil, rMAX, m_rr), random_dil, rMAX);
 
   
   // ----------- initialize the pair vectors used for resampling ----------- 
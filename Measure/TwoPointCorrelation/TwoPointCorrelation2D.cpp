@@ -351,16 +351,16 @@ std::shared_ptr<Data> cbl::measure::twopt::TwoPointCorrelation2D::correlation_Na
   error.resize(m_dd->nbins_D1(), vector<double>(m_dd->nbins_D2(), 0));
 
   // number of objects in the data catalogue
-  int nD = (nData>0) ? nData : m_data->nObjects();
+  int nD = (nData>0) ? nData : m_nObjects(m_data);
 
   // weighted number of objects in the data catalogue
-  double nDw = (nData_weighted>0) ? nData_weighted : m_data->weightedN();
+  double nDw = (nData_weighted>0) ? nData_weighted : m_weightedN(m_data);
 
   // number of objects in the random catalogue
-  int nR = (nRandom>0) ? nRandom : m_random->nObjects();
+  int nR = (nRandom>0) ? nRandom : m_nRandom();
 
   // weighted number of objects in the random catalogue
-  double nRw = (nRandom_weighted>0) ? nRandom_weighted : m_random->weightedN();
+  double nRw = (nRandom_weighted>0) ? nRandom_weighted : m_weightedN_random();
 
   // inverse of the total number of data-data pairs
   double nDDi = 1./(nDw*(nDw-1.)*0.5);
@@ -414,16 +414,16 @@ std::shared_ptr<Data> cbl::measure::twopt::TwoPointCorrelation2D::correlation_La
   error.resize(m_dd->nbins_D1(), vector<double>(m_dd->nbins_D2(), 0));
   
   // number of objects in the data catalogue
-  int nD = (nData>0) ? nData : m_data->nObjects();
+  int nD = (nData>0) ? nData : m_nObjects(m_data);
 
   // weighted number of objects in the data catalogue
-  double nDw = (nData_weighted>0) ? nData_weighted : m_data->weightedN();
+  double nDw = (nData_weighted>0) ? nData_weighted : m_weightedN(m_data);
 
   // number of objects in the random catalogue
-  int nR = (nRandom>0) ? nRandom : m_random->nObjects();
+  int nR = (nRandom>0) ? nRandom : m_nRandom();
 
   // weighted number of objects in the random catalogue
-  double nRw = (nRandom_weighted>0) ? nRandom_weighted : m_random->weightedN();
+  double nRw = (nRandom_weighted>0) ? nRandom_weighted : m_weightedN_random();
 
   // inverse of the total number of data-data pairs
   double nDDi = 1./(nDw*(nDw-1.)*0.5);
@@ -75,7 +75,7 @@ void cbl::measure::twopt::TwoPointCorrelationCross::count_allPairs (const TwoPTy
     WarningMsg("Attention: --> m_random_dilution_fraction = 1, since the random catalogue is not diluted when using the natural estimator!");
   }
 
-  auto random_dil = make_shared<catalogue::Catalogue>(catalogue::Catalogue(move(m_random->diluted_catalogue(m_random_dilution_fraction))));
+  auto random_dil = make_shared<catalogue::Catalogue>(m_random->diluted_catalogue(m_random_dilution_fraction));
   
   
   // ----------- create the chain-mesh ----------- 
@@ -100,21 +100,19 @@ void cbl::measure::twopt::TwoPointCorrelationCross::count_allPairs (const TwoPTy
   else
     ErrorCBL("Error in count_allPairs() of TwoPointCorrelationCross.cpp: the chosen two-point correlation function type is uknown!");
   
-  double cell_size = rMAX*0.1; // to be optimized!!!
-  
   ChainMesh_Catalogue ChM_data1data2, ChM_random_dil, ChM_data1random, ChM_data2random;
   
   if (count_d1d2)
-    ChM_data1data2.set_par(cell_size, m_data2, rMAX);
+    ChM_data1data2.set_par(chainMesh_cell_size(m_data2, rMAX, m_d1d2), m_data2, rMAX);
 
   if (count_rr)
-    ChM_random_dil.set_par(cell_size, random_dil, rMAX);    
+    ChM_random_dil.set_par(chainMesh_cell_size(random_dil, rMAX, m_rr), random_dil, rMAX);    
 
   if (count_d1r)
-    ChM_data1random.set_par(cell_size, m_random, rMAX);
+    ChM_data1random.set_par(chainMesh_cell_size(m_random, rMAX, m_d1r), m_random, rMAX);
   
   if (count_d2r)
-    ChM_data2random.set_par(cell_size, m_random, rMAX);
+    ChM_data2random.set_par(chainMesh_cell_size(m_random, rMAX, m_d2r), m_random, rMAX);
   
   
   // ----------- count the number of pairs or read them from file -----------
@@ -56,22 +56,22 @@ shared_ptr<data::Data> cbl::measure::twopt::TwoPointCorrelationCross1D::correlat
   vector<double> rad(m_d1d2->nbins()), xi(m_d1d2->nbins(), -1.), error(m_d1d2->nbins(), 1000.);
 
   // number of objects in the first data catalogue
-  int nD1 = (nData1>0) ? nData1 : m_data->nObjects();
+  int nD1 = (nData1>0) ? nData1 : m_nObjects(m_data);
 
   // number of objects in the second data catalogue
-  int nD2 = (nData2>0) ? nData2 : m_data2->nObjects();
+  int nD2 = (nData2>0) ? nData2 : m_nObjects(m_data2);
   
   // weighted number of objects in the first data catalogue
-  double nD1w = (nData1_weighted>0) ? nData1_weighted : m_data->weightedN();
+  double nD1w = (nData1_weighted>0) ? nData1_weighted : m_weightedN(m_data);
 
   // weighted number of objects in the second data catalogue
-  double nD2w = (nData2_weighted>0) ? nData2_weighted : m_data2->weightedN();
+  double nD2w = (nData2_weighted>0) ? nData2_weighted : m_weightedN(m_data2);
   
   // number of objects in the random catalogue
-  int nR = (nRandom>0) ? nRandom : m_random->nObjects();
+  int nR = (nRandom>0) ? nRandom : m_nRandom();
 
   // weighted number of objects in the random catalogue
-  double nRw = (nRandom_weighted>0) ? nRandom_weighted : m_random->weightedN();
+  double nRw = (nRandom_weighted>0) ? nRandom_weighted : m_weightedN_random();
 
   // inverse of the total number of data1-data2 pairs
   double nD1D2i = 1./(nD1w*nD2w);
@@ -347,16 +347,16 @@ void cbl::measure::twopt::TwoPointCorrelation_multipoles_direct::read_pairs (std
 std::shared_ptr<data::Data> cbl::measure::twopt::TwoPointCorrelation_multipoles_direct::correlation_NaturalEstimator (const std::shared_ptr<pairs::Pair> dd, const std::shared_ptr<pairs::Pair> rr, const int nData, const double nData_weighted, const int nRandom, const double nRandom_weighted)
 {
   // number of objects in the data catalogue
-  int nD = (nData>0) ? nData : m_data->nObjects();
+  int nD = (nData>0) ? nData : m_nObjects(m_data);
 
   // weighted number of objects in the data catalogue
-  double nDw = (nData_weighted>0) ? nData_weighted : m_data->weightedN();
+  double nDw = (nData_weighted>0) ? nData_weighted : m_weightedN(m_data);
 
   // number of objects in the random catalogue
-  int nR = (nRandom>0) ? nRandom : m_random->nObjects();
+  int nR = (nRandom>0) ? nRandom : m_nRandom();
 
   // weighted number of objects in the random catalogue
-  double nRw = (nRandom_weighted>0) ? nRandom_weighted : m_random->weightedN();
+  double nRw = (nRandom_weighted>0) ? nRandom_weighted : m_weightedN_random();
 
   // inverse of the total number of data-data pairs
   double nDDi = 1./(nDw*(nDw-1.)*0.5);
@@ -404,16 +404,16 @@ std::shared_ptr<data::Data> cbl::measure::twopt::TwoPointCorrelation_multipoles_
 std::shared_ptr<data::Data> cbl::measure::twopt::TwoPointCorrelation_multipoles_direct::correlation_LandySzalayEstimator (const std::shared_ptr<pairs::Pair> dd, const std::shared_ptr<pairs::Pair> rr, const std::shared_ptr<pairs::Pair> dr, const int nData, const double nData_weighted, const int nRandom, const double nRandom_weighted)
 {
   // number of objects in the data catalogue
-  int nD = (nData>0) ? nData : m_data->nObjects();
+  int nD = (nData>0) ? nData : m_nObjects(m_data);
 
   // weighted number of objects in the data catalogue
-  double nDw = (nData_weighted>0) ? nData_weighted : m_data->weightedN();
+  double nDw = (nData_weighted>0) ? nData_weighted : m_weightedN(m_data);
 
   // number of objects in the random catalogue
-  int nR = (nRandom>0) ? nRandom : m_random->nObjects();
+  int nR = (nRandom>0) ? nRandom : m_nRandom();
 
   // weighted number of objects in the random catalogue
-  double nRw = (nRandom_weighted>0) ? nRandom_weighted : m_random->weightedN();
+  double nRw = (nRandom_weighted>0) ? nRandom_weighted : m_weightedN_random();
 
   // inverse of the total number of data-data pairs
   double nDDi = 1./(nDw*(nDw-1.)*0.5);
@@ -208,6 +208,16 @@ void cbl::modelling::Modelling::sample_posterior (const int chain_size, const in
 }
 
 
+// ============================================================================================
+
+
+void cbl::modelling::Modelling::sample_posterior_nested (const int nlive, const double dlogz, const int nsteps, const int nparallel, const int seed)
+{
+  m_set_posterior(seed);
+  m_posterior->sample_nested(nlive, dlogz, nsteps, nparallel);
+}
+
+
 // ============================================================================================
       
 
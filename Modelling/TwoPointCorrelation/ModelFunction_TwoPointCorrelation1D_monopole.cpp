@@ -326,6 +326,47 @@ std::vector<double> cbl::modelling::twopt::xi0_linear_sigma8_bias (const std::ve
 // ============================================================================================
 
 
+std::vector<std::vector<double>> cbl::modelling::twopt::xi0_linear_sigma8_bias_batch (const std::vector<double> rad, const std::shared_ptr<void> inputs, std::vector<std::vector<double>> &parameter)
+{
+  // structure contaning the required input data
+  shared_ptr<STR_data_model> pp = static_pointer_cast<STR_data_model>(inputs);
+
+
+  // the dark matter two-point correlation function, common to all the sets of parameters
+  
+  vector<double> xiDM(rad.size());
+  for (size_t i=0; i<rad.size(); i++) 
+    xiDM[i] = pp->func_xi->operator()(rad[i]);
+  
+
+  // return the redshift-space monopole of the two-point correlation function for each set of parameters
+
+  vector<vector<double>> xi(parameter.size(), vector<double>(rad.size(), 0));
+
+  for (size_t k=0; k<parameter.size(); k++) {
+
+    // sigma8(z)
+    const double sigma8 = parameter[k][0];
+
+    // bias
+    const double bias = parameter[k][1];
+
+    // f(z)*sigma8(z)
+    const double fsigma8 = pp->linear_growth_rate_z*sigma8;
+
+    const double fact = xi_ratio(fsigma8, bias*sigma8)*pow(bias, 2)*pow(sigma8/pp->sigma8_z, 2);
+
+    for (size_t i=0; i<rad.size(); i++) 
+      xi[k][i] = fact*xiDM[i];
+  }
+  
+  return xi;
+}
+
+
+// ============================================================================================
+
+
 std::vector<double> cbl::modelling::twopt::xi0_linear_cosmology (const std::vector<double> rad, const std::shared_ptr<void> inputs, std::vector<double> &parameter)
 {
   // structure contaning the required input data
@@ -609,8 +609,10 @@ void cbl::modelling::twopt::Modelling_TwoPointCorrelation1D_monopole::set_model_
   //set the priors
   m_set_prior(priors);
 
-  // construct the model
-  m_model = make_shared<statistics::Model1D>(statistics::Model1D(&xi0_linear_sigma8_bias, nparameters, parameterType, parameterName, m_data_model));
+  // construct the model, that can be computed for several sets of parameters at once
+  auto model = make_shared<statistics::Model1D>(statistics::Model1D(&xi0_linear_sigma8_bias, nparameters, parameterType, parameterName, m_data_model));
+  model->set_function_batch(&xi0_linear_sigma8_bias_batch);
+  m_model = model;
 }
 
 
@@ -23,6 +23,7 @@
 %include Lib/NumberCounts.i
 %include Lib/TwoPointCorrelation.i
 %include Lib/ThreePointCorrelation.i
+%include Lib/PowerSpectrum.i
 %include Lib/Modelling.i
 %include Lib/Modelling_NumberCounts.i
 %include Lib/Modelling_TwoPointCorrelation.i
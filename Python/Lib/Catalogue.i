@@ -23,6 +23,10 @@
 #include "Cluster.h"
 #include "Catalogue.h"
 #include "ChainMesh_Catalogue.h"
+#include "KDTree_Catalogue.h"
+#include "ColumnarFile.h"
+#include "CatalogueView.h"
+#include "MangleMask.h"
 #include "Void.h"
 #include "HostHalo.h"
 %}
@@ -35,6 +39,10 @@
 %include "Cluster.h"
 %include "Catalogue.h"
 %include "ChainMesh_Catalogue.h"
+%include "KDTree_Catalogue.h"
+%include "ColumnarFile.h"
+%include "CatalogueView.h"
+%include "MangleMask.h"
 %include "Void.h"
 %include "HostHalo.h"
 %template(RandomObjVector) std::vector<cbl::catalogue::RandomObject>;
@@ -0,0 +1,9 @@
+// SWIG Interface to PowerSpectrum
+
+%module cblPowerSpectrum
+
+%{
+#include "PowerSpectrum.h"
+%}
+
+%include "PowerSpectrum.h"
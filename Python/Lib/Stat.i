@@ -20,6 +20,8 @@
 %shared_ptr(cbl::statistics::LikelihoodFunction);
 %shared_ptr(cbl::statistics::Likelihood);
 %shared_ptr(cbl::statistics::Chi2);
+%shared_ptr(cbl::statistics::ChainFile);
+%shared_ptr(cbl::statistics::NestedSampler);
 %shared_ptr(cbl::statistics::Sampler);
 %shared_ptr(cbl::statistics::Posterior);
 
@@ -36,7 +38,9 @@
 #include "LikelihoodFunction.h"
 #include "Likelihood.h"
 #include "Chi2.h"
+#include "ChainFile.h"
 #include "Sampler.h"
+#include "NestedSampler.h"
 #include "Posterior.h"
 %}
 
@@ -52,7 +56,9 @@
 %include "LikelihoodFunction.h"
 %include "Likelihood.h"
 %include "Chi2.h"
+%include "ChainFile.h"
 %include "Sampler.h"
+%include "NestedSampler.h"
 %include "Posterior.h"
 
 %template(ParameterTypeVector) std::vector<cbl::statistics::ParameterType>;
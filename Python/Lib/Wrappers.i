@@ -7,9 +7,11 @@
 #include "FITSwrapper.h"
   //#include "GSLfunction.h"
 #include "GSLwrapper.h"
+#include "MPIwrapper.h"
 %}
 
 %include "CUBAwrapper.h"
 %include "FITSwrapper.h"
  //%include "GSLfunction.h"
 %include "GSLwrapper.h"
+%include "MPIwrapper.h"
@@ -316,3 +316,60 @@ double cbl::random::CustomDistributionRandomNumbers::operator () ()
 }
 
 
+// =====================================================================================
+
+
+cbl::random::CounterRandomNumbers::CounterRandomNumbers (const int seed, const uint64_t stream, const uint32_t substream)
+{
+  const uint64_t key = uint64_t(uint32_t(seed));
+  m_key = {{uint32_t(key), uint32_t(key>>32)}};
+  m_counter = {{0, substream, uint32_t(stream), uint32_t(stream>>32)}};
+  m_used = 4;
+}
+
+
+// =====================================================================================
+
+
+void cbl::random::CounterRandomNumbers::m_next_block ()
+{
+  const uint32_t M0 = 0xD2511F53, M1 = 0xCD9E8D57, W0 = 0x9E3779B9, W1 = 0xBB67AE85;
+
+  array<uint32_t, 4> ctr = m_counter;
+  array<uint32_t, 2> key = m_key;
+
+  for (int round=0; round<10; round++) {
+    const uint64_t p0 = uint64_t(M0)*ctr[0];
+    const uint64_t p1 = uint64_t(M1)*ctr[2];
+    ctr = {{uint32_t(p1>>32)^ctr[1]^key[0], uint32_t(p1), uint32_t(p0>>32)^ctr[3]^key[1], uint32_t(p0)}};
+    key[0] += W0; key[1] += W1;
+  }
+
+  m_block = ctr;
+  m_used = 0;
+  m_counter[0] ++;
+}
+
+
+// =====================================================================================
+
+
+double cbl::random::CounterRandomNumbers::operator () ()
+{
+  if (m_used>2) m_next_block();
+
+  // 53 random bits from two 32-bit numbers
+  const uint64_t aa = m_block[m_used]>>5, bb = m_block[m_used+1]>>6;
+  m_used += 2;
+
+  return (aa*67108864.+bb)*(1./9007199254740992.);
+}
+
+
+// =====================================================================================
+
+
+int cbl::random::CounterRandomNumbers::operator () (const int MinVal, const int MaxVal)
+{
+  return min(MinVal+int(this->operator()()*(MaxVal-MinVal+1)), MaxVal);
+}
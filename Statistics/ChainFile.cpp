@@ -0,0 +1,231 @@
+/********************************************************************
+ *  Copyright (C) 2014 by Federico Marulli and Alfonso Veropalumbo  *
+ *  federico.marulli3@unibo.it                                      *
+ *                                                                  *
+ *  This program is free software; you can redistribute it and/or   *
+ *  modify it under the terms of the GNU General Public License as  *
+ *  published by the Free Software Foundation; either version 2 of  *
+ *  the License, or (at your option) any later version.             *
+ *                                                                  *
+ *  This program is distributed in the hope that it will be useful, *
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of  *
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the   *
+ *  GNU General Public License for more details.                    *
+ *                                                                  *
+ *  You should have received a copy of the GNU General Public       *
+ *  License along with this program; if not, write to the Free      *
+ *  Software Foundation, Inc.,                                      *
+ *  59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.       *
+ ********************************************************************/
+
+/** @file Statistics/ChainFile.cpp
+ *
+ *  @brief Methods of the class ChainFile
+ *
+ *  This file contains the implementation of the methods of the class
+ *  ChainFile, used to store the MCMC chains in a binary file
+ *
+ *  @authors Federico Marulli, Alfonso Veropalumbo
+ *
+ *  @authors federico.marulli3@unbo.it, alfonso.veropalumbo@unibo.it
+ */
+
+#include "ChainFile.h"
+
+using namespace std;
+
+using namespace cbl;
+
+
+/// the string at the beginning of the binary chain files
+static const char chain_file_tag[8] = {'C', 'B', 'L', 'C', 'H', 'A', 'I', 'N'};
+
+
+// ============================================================================================
+
+
+std::streamoff cbl::statistics::ChainFile::m_header_size ()
+{
+  return sizeof(chain_file_tag)+3*sizeof(int32_t);
+}
+
+
+// ============================================================================================
+
+
+std::streamoff cbl::statistics::ChainFile::m_step_size () const
+{
+  return streamoff(m_nwalkers)*(m_npar+1)*sizeof(double);
+}
+
+
+// ============================================================================================
+
+
+bool cbl::statistics::ChainFile::is_chain_file (const std::string file)
+{
+  ifstream fin(file.c_str(), ios::binary);
+  if (!fin) return false;
+
+  char tag[8];
+  fin.read(tag, sizeof(tag));
+
+  return (fin && equal(tag, tag+sizeof(tag), chain_file_tag));
+}
+
+
+// ============================================================================================
+
+
+cbl::statistics::ChainFile::ChainFile (const std::string file, const int block_size)
+  : m_file(file), m_block_size(max(block_size, 1))
+{
+  if (!is_chain_file(m_file))
+    ErrorCBL("Error in cbl::statistics::ChainFile::ChainFile() of ChainFile.cpp: "+m_file+" is not a binary chain file!");
+
+  ifstream fin(m_file.c_str(), ios::binary); checkIO(fin, m_file);
+
+  int32_t nn[3];
+  fin.seekg(sizeof(chain_file_tag));
+  fin.read(reinterpret_cast<char*>(nn), sizeof(nn));
+  m_npar = nn[0];
+  m_nwalkers = nn[1];
+  m_seed = nn[2];
+
+  if (!fin || m_npar<1 || m_nwalkers<1)
+    ErrorCBL("Error in cbl::statistics::ChainFile::ChainFile() of ChainFile.cpp: the header of "+m_file+" is corrupted!");
+
+  // the complete steps only: an incomplete step is overwritten by the next one
+  fin.seekg(0, ios::end);
+  m_nsteps_file = int((fin.tellg()-m_header_size())/m_step_size());
+
+  fin.clear(); fin.close();
+}
+
+
+// ============================================================================================
+
+
+cbl::statistics::ChainFile::ChainFile (const std::string file, const int npar, const int nwalkers, const int seed, const int block_size)
+  : m_file(file), m_npar(npar), m_nwalkers(nwalkers), m_seed(seed), m_nsteps_file(0), m_block_size(max(block_size, 1))
+{
+  if (m_npar<1 || m_nwalkers<1)
+    ErrorCBL("Error in cbl::statistics::ChainFile::ChainFile() of ChainFile.cpp: the number of parameters and walkers must be positive!");
+
+  ofstream fout(m_file.c_str(), ios::binary|ios::trunc); checkIO(fout, m_file);
+
+  const int32_t nn[3] = {m_npar, m_nwalkers, m_seed};
+  fout.write(chain_file_tag, sizeof(chain_file_tag));
+  fout.write(reinterpret_cast<const char*>(nn), sizeof(nn));
+
+  fout.clear(); fout.close();
+}
+
+
+// ============================================================================================
+
+
+void cbl::statistics::ChainFile::append_step (const std::vector<std::vector<double>> &chain_step, const std::vector<double> &function_step)
+{
+  if (int(chain_step.size())!=m_nwalkers || int(function_step.size())!=m_nwalkers)
+    ErrorCBL("Error in cbl::statistics::ChainFile::append_step() of ChainFile.cpp: the number of walkers is not "+conv(m_nwalkers, par::fINT)+"!");
+
+  if (m_buffer.capacity()==0) m_buffer.reserve(m_block_size*m_nwalkers*(m_npar+1));
+
+  for (int i=0; i<m_nwalkers; i++) {
+    if (int(chain_step[i].size())<m_npar)
+      ErrorCBL("Error in cbl::statistics::ChainFile::append_step() of ChainFile.cpp: the number of parameters is not "+conv(m_npar, par::fINT)+"!");
+    m_buffer.insert(m_buffer.end(), chain_step[i].begin(), chain_step[i].begin()+m_npar);
+    m_buffer.push_back(function_step[i]);
+  }
+
+  if (int(m_buffer.size())>=m_block_size*m_nwalkers*(m_npar+1)) flush();
+}
+
+
+// ============================================================================================
+
+
+void cbl::statistics::ChainFile::flush ()
+{
+  if (m_buffer.size()==0) return;
+
+  const streamoff end = m_header_size()+m_nsteps_file*m_step_size();
+
+  // remove an incomplete step left by an interrupted run
+  if (truncate(m_file.c_str(), end)!=0)
+    ErrorCBL("Error in cbl::statistics::ChainFile::flush() of ChainFile.cpp: "+m_file+" cannot be written!");
+
+  ofstream fout(m_file.c_str(), ios::binary|ios::app); checkIO(fout, m_file);
+  fout.write(reinterpret_cast<const char*>(m_buffer.data()), m_buffer.size()*sizeof(double));
+  fout.flush();
+
+  if (!fout)
+    ErrorCBL("Error in cbl::statistics::ChainFile::flush() of ChainFile.cpp: "+m_file+" cannot be written!");
+
+  fout.clear(); fout.close();
+
+  m_nsteps_file += int(m_buffer.size()/(m_nwalkers*(m_npar+1)));
+  m_buffer.clear();
+}
+
+
+// ============================================================================================
+
+
+void cbl::statistics::ChainFile::last_step (std::vector<std::vector<double>> &chain_step, std::vector<double> &function_step)
+{
+  flush();
+
+  if (m_nsteps_file==0)
+    ErrorCBL("Error in cbl::statistics::ChainFile::last_step() of ChainFile.cpp: "+m_file+" does not contain any step!");
+
+  vector<vector<double>> chain_value;
+  vector<double> function;
+  read(chain_value, function, m_nsteps_file-1);
+
+  chain_step.resize(m_nwalkers, vector<double>(m_npar));
+  function_step = function;
+  for (int i=0; i<m_nwalkers; i++) {
+    chain_step[i].resize(m_npar);
+    for (int k=0; k<m_npar; k++)
+      chain_step[i][k] = chain_value[k][i];
+  }
+}
+
+
+// ============================================================================================
+
+
+void cbl::statistics::ChainFile::read (std::vector<std::vector<double>> &chain_value, std::vector<double> &function, const int start, const int thin)
+{
+  if (start<0 || thin<1)
+    ErrorCBL("Error in cbl::statistics::ChainFile::read() of ChainFile.cpp: start must be >=0 and thin >=1!");
+
+  flush();
+
+  ifstream fin(m_file.c_str(), ios::binary); checkIO(fin, m_file);
+
+  const int nread = (start<m_nsteps_file) ? (m_nsteps_file-start+thin-1)/thin : 0;
+
+  chain_value.assign(m_npar, vector<double>(size_t(nread)*m_nwalkers));
+  function.assign(size_t(nread)*m_nwalkers, 0.);
+
+  vector<double> step(m_nwalkers*(m_npar+1));
+
+  for (int j=0; j<nread; j++) {
+    fin.seekg(m_header_size()+streamoff(start+j*thin)*m_step_size());
+    fin.read(reinterpret_cast<char*>(step.data()), m_step_size());
+
+    if (!fin)
+      ErrorCBL("Error in cbl::statistics::ChainFile::read() of ChainFile.cpp: error reading "+m_file+"!");
+
+    for (int i=0; i<m_nwalkers; i++) {
+      for (int k=0; k<m_npar; k++)
+	chain_value[k][j*m_nwalkers+i] = step[i*(m_npar+1)+k];
+      function[j*m_nwalkers+i] = step[i*(m_npar+1)+m_npar];
+    }
+  }
+
+  fin.clear(); fin.close();
+}
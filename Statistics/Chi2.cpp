@@ -64,7 +64,7 @@ cbl::statistics::Chi2::Chi2 (const std::shared_ptr<data::Data> data, const std::
   else
     set_function(LikelihoodType::_Gaussian_Error_, m_x_index, m_w_index);
 
-  m_likelihood_inputs = make_shared<STR_likelihood_inputs>(STR_likelihood_inputs(m_data, m_model, m_x_index, m_w_index));
+  m_set_likelihood_inputs();
 }
 
 
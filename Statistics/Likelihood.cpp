@@ -171,6 +171,22 @@ double cbl::statistics::Likelihood::log (std::vector<double> &pp) const
 // ============================================================================================
 
 
+vector<double> cbl::statistics::Likelihood::log (std::vector<std::vector<double>> &pp) const
+{
+  if (!m_use_grid && m_log_likelihood_function_batch)
+    return m_log_likelihood_function_batch(pp, m_likelihood_inputs);
+
+  vector<double> LogLikelihood(pp.size());
+  for (size_t i=0; i<pp.size(); i++)
+    LogLikelihood[i] = log(pp[i]);
+
+  return LogLikelihood;
+}
+
+
+// ============================================================================================
+
+
 void cbl::statistics::Likelihood::set_data (const shared_ptr<data::Data> data)
 {
   m_data = data;
@@ -252,6 +268,7 @@ void cbl::statistics::Likelihood::set_function (const LikelihoodType likelihood_
   m_x_index = x_index;
   m_w_index = w_index;
   m_likelihood_type = likelihood_type;
+  m_log_likelihood_function_batch = nullptr;
 
   if (m_data->dataType()==data::DataType::_1D_ || m_data->dataType()==data::DataType::_1D_extra_) {
 
@@ -268,12 +285,13 @@ void cbl::statistics::Likelihood::set_function (const LikelihoodType likelihood_
 	}
 
 	m_log_likelihood_function = &LogLikelihood_Gaussian_1D_error;
+	m_log_likelihood_function_batch = &LogLikelihood_Gaussian_1D_error_batch;
 	break; 
 
       case (LikelihoodType::_Gaussian_Covariance_):
-	//Also invert covariance!
-	m_data->invert_covariance();
+	// the Cholesky factor of the covariance is computed with the likelihood inputs
 	m_log_likelihood_function = &LogLikelihood_Gaussian_1D_covariance;
+	m_log_likelihood_function_batch = &LogLikelihood_Gaussian_1D_covariance_batch;
 	break;
 
       case (LikelihoodType::_Poissonian_):
@@ -303,6 +321,11 @@ void cbl::statistics::Likelihood::set_function (const LikelihoodType likelihood_
 	m_log_likelihood_function = &LogLikelihood_Gaussian_2D_error;
 	break; 
 
+      case (LikelihoodType::_Gaussian_Covariance_):
+	m_log_likelihood_function = &LogLikelihood_Gaussian_2D_covariance;
+	m_log_likelihood_function_batch = &LogLikelihood_Gaussian_2D_covariance_batch;
+	break;
+
       case (LikelihoodType::_Poissonian_):
 	m_log_likelihood_function = &LogLikelihood_Poissonian_2D_;
 	break; 
@@ -323,10 +346,39 @@ void cbl::statistics::Likelihood::set_function (const LikelihoodType likelihood_
 // ============================================================================================
 
 
+void cbl::statistics::Likelihood::m_set_likelihood_inputs ()
+{
+  auto likelihood_inputs = make_shared<STR_likelihood_inputs>(STR_likelihood_inputs(m_data, m_model, m_x_index, m_w_index));
+
+  if (m_likelihood_type==LikelihoodType::_Gaussian_Covariance_)
+    likelihood_inputs->set_cholesky_covariance(m_covariance_correction, m_nMocks);
+
+  m_likelihood_inputs = likelihood_inputs;
+}
+
+
+// ============================================================================================
+
+
+void cbl::statistics::Likelihood::set_covariance_correction (const CovarianceCorrection covariance_correction, const int nMocks)
+{
+  m_covariance_correction = covariance_correction;
+  m_nMocks = nMocks;
+
+  // update the Cholesky factor, if the likelihood inputs have already been set
+  if (m_likelihood_inputs!=NULL && m_likelihood_type==LikelihoodType::_Gaussian_Covariance_)
+    static_pointer_cast<STR_likelihood_inputs>(m_likelihood_inputs)->set_cholesky_covariance(m_covariance_correction, m_nMocks);
+}
+
+
+// ============================================================================================
+
+
 void cbl::statistics::Likelihood::set_function (const Likelihood_function likelihood_function)
 {
   m_likelihood_type = LikelihoodType::_UserDefined_;
   m_likelihood_function = likelihood_function;
+  m_log_likelihood_function_batch = nullptr;
   m_log_likelihood_function = [&] (vector<double> &par, const shared_ptr<void> input) { return std::log(m_likelihood_function(par, input)); };
 }
 
@@ -360,7 +412,7 @@ void cbl::statistics::Likelihood::maximize (const std::vector<double> start, con
   else
     ErrorCBL("Error in cbl::statistics::Likelihood::maximize() of Likelihood.cpp: Check your inputs!");
 
-  m_likelihood_inputs = make_shared<STR_likelihood_inputs>(STR_likelihood_inputs(m_data, m_model, m_x_index, m_w_index));
+  m_set_likelihood_inputs();
 
   function<double(vector<double> &)> ll = [this](vector<double> & pp) { 
     return -m_log_likelihood_function(pp, m_likelihood_inputs); 
@@ -101,6 +101,71 @@ cbl::statistics::STR_likelihood_inputs::STR_likelihood_inputs (const std::shared
 // ============================================================================================
 
 
+void cbl::statistics::STR_likelihood_inputs::set_cholesky_covariance (const CovarianceCorrection correction, const int n_mocks)
+{
+  const int nd = data->ndata();
+
+  if (correction!=CovarianceCorrection::_None_ && n_mocks<=nd+2)
+    ErrorCBL("Error in cbl::statistics::STR_likelihood_inputs::set_cholesky_covariance() of LikelihoodFunction.cpp: the number of mocks must be larger than the number of data points plus 2!");
+
+  Eigen::MatrixXd covariance(nd, nd);
+  for (int i=0; i<nd; i++)
+    for (int j=0; j<nd; j++)
+      covariance(i, j) = data->covariance(i, j);
+
+  Eigen::LLT<Eigen::MatrixXd> llt(covariance);
+  if (llt.info()!=Eigen::Success)
+    ErrorCBL("Error in cbl::statistics::STR_likelihood_inputs::set_cholesky_covariance() of LikelihoodFunction.cpp: the covariance matrix is not positive definite!");
+
+  cholesky_covariance = llt.matrixL();
+
+  // the Hartlap factor rescales the inverse covariance, i.e. the Cholesky factor by its inverse square root
+  if (correction==CovarianceCorrection::_Hartlap_)
+    cholesky_covariance *= sqrt(double(n_mocks-1)/double(n_mocks-nd-2));
+
+  covariance_correction = correction;
+  nMocks = n_mocks;
+}
+
+
+// ============================================================================================
+
+
+double cbl::statistics::STR_likelihood_inputs::LogLikelihood_covariance (Eigen::VectorXd &diff) const
+{
+  if (cholesky_covariance.rows()!=diff.size())
+    ErrorCBL("Error in cbl::statistics::STR_likelihood_inputs::LogLikelihood_covariance() of LikelihoodFunction.cpp: the Cholesky factor of the covariance matrix is not set!");
+
+  cholesky_covariance.triangularView<Eigen::Lower>().solveInPlace(diff);
+  const double chi2 = diff.squaredNorm();
+
+  return (covariance_correction==CovarianceCorrection::_SellentinHeavens_) ? -0.5*nMocks*log(1.+chi2/(nMocks-1.)) : -0.5*chi2;
+}
+
+
+// ============================================================================================
+
+
+vector<double> cbl::statistics::STR_likelihood_inputs::LogLikelihood_covariance (Eigen::MatrixXd &diff) const
+{
+  if (cholesky_covariance.rows()!=diff.rows())
+    ErrorCBL("Error in cbl::statistics::STR_likelihood_inputs::LogLikelihood_covariance() of LikelihoodFunction.cpp: the Cholesky factor of the covariance matrix is not set!");
+
+  cholesky_covariance.triangularView<Eigen::Lower>().solveInPlace(diff);
+
+  vector<double> LogLikelihood(diff.cols());
+  for (int k=0; k<diff.cols(); k++) {
+    const double chi2 = diff.col(k).squaredNorm();
+    LogLikelihood[k] = (covariance_correction==CovarianceCorrection::_SellentinHeavens_) ? -0.5*nMocks*log(1.+chi2/(nMocks-1.)) : -0.5*chi2;
+  }
+
+  return LogLikelihood;
+}
+
+
+// ============================================================================================
+
+
 double statistics::LogLikelihood_1D_interpolated (std::vector<double> &likelihood_parameters, const std::shared_ptr<void> fixed_parameters)
 {
   // ----- extract the parameters ----- 
@@ -164,19 +229,14 @@ double statistics::LogLikelihood_Gaussian_1D_covariance (std::vector<double> &li
 
   // ----- compute the difference between model and data at each bin ----- 
   
-  vector<double> diff(pp->data->ndata(), 0);
+  Eigen::VectorXd diff(pp->data->ndata());
   for (int i=0; i<pp->data->ndata(); i++)
-    diff[i] = pp->data->data(i)-computed_model[i];
+    diff(i) = pp->data->data(i)-computed_model[i];
 
 
   // ----- estimate the Gaussian log-likelihood ----- 
   
-  double LogLikelihood = 0.;
-  for (int i=0; i<pp->data->ndata(); i++)
-    for (int j=0; j<pp->data->ndata(); j++)
-      LogLikelihood += diff[i]*pp->data->inverse_covariance(i, j)*diff[j];    
-
-  return -0.5*LogLikelihood;
+  return pp->LogLikelihood_covariance(diff);
 }
 
 
@@ -206,6 +266,31 @@ double statistics::LogLikelihood_Gaussian_2D_error (std::vector<double> &likelih
 // ============================================================================================
 
 
+double statistics::LogLikelihood_Gaussian_2D_covariance (std::vector<double> &likelihood_parameters, const std::shared_ptr<void> fixed_parameters)
+{
+  // ----- extract the parameters ----- 
+  shared_ptr<statistics::STR_likelihood_inputs> pp = static_pointer_cast<statistics::STR_likelihood_inputs>(fixed_parameters);
+  
+  // ----- compute the model values -----
+
+  vector<vector<double>> computed_model = pp->model->operator()(pp->xx, pp->yy, likelihood_parameters);
+
+  // ----- compute the difference between model and data at each bin, with the ordering of the covariance matrix ----- 
+
+  Eigen::VectorXd diff(pp->data->xsize()*pp->data->ysize());
+  for (int i=0; i<pp->data->xsize(); i++)
+    for (int j=0; j<pp->data->ysize(); j++)
+      diff(i*pp->data->ysize()+j) = pp->data->data(i, j)-computed_model[i][j];
+
+  // ----- estimate the Gaussian log-likelihood -----
+
+  return pp->LogLikelihood_covariance(diff);
+}
+
+
+// ============================================================================================
+
+
 double statistics::LogLikelihood_Poissonian_1D_ (std::vector<double> &likelihood_parameters, const std::shared_ptr<void> fixed_parameters)
 {
   // ----- extract the parameters ----- 
@@ -249,3 +334,78 @@ double statistics::LogLikelihood_Poissonian_2D_ (std::vector<double> &likelihood
   return LogLikelihood;
 }
 
+
+// ============================================================================================
+
+
+vector<double> statistics::LogLikelihood_Gaussian_1D_error_batch (std::vector<std::vector<double>> &likelihood_parameters, const std::shared_ptr<void> fixed_parameters)
+{
+  // ----- extract the parameters ----- 
+  shared_ptr<statistics::STR_likelihood_inputs> pp = static_pointer_cast<statistics::STR_likelihood_inputs>(fixed_parameters);
+
+  // ----- compute the model values for all the sets of parameters ----- 
+
+  vector<vector<double>> computed_model = pp->model->operator()(pp->xx, likelihood_parameters);
+ 
+  // ----- estimate the Gaussian log-likelihood -----
+
+  vector<double> LogLikelihood(computed_model.size(), 0.);
+  for (size_t k=0; k<computed_model.size(); k++) {
+    for (int i=0; i<pp->data->ndata(); i++)  
+      LogLikelihood[k] += pow((pp->data->data(i)-computed_model[k][i])/pp->data->error(i), 2);
+    LogLikelihood[k] *= -0.5;
+  }
+
+  return LogLikelihood;
+}
+
+
+// ============================================================================================
+
+
+vector<double> statistics::LogLikelihood_Gaussian_1D_covariance_batch (std::vector<std::vector<double>> &likelihood_parameters, const std::shared_ptr<void> fixed_parameters)
+{
+  // ----- extract the parameters ----- 
+  shared_ptr<statistics::STR_likelihood_inputs> pp = static_pointer_cast<statistics::STR_likelihood_inputs>(fixed_parameters);
+
+  // ----- compute the model values for all the sets of parameters ----- 
+
+  vector<vector<double>> computed_model = pp->model->operator()(pp->xx, likelihood_parameters);
+
+  // ----- compute the differences between model and data at each bin, one column for each set of parameters ----- 
+  
+  Eigen::MatrixXd diff(pp->data->ndata(), computed_model.size());
+  for (size_t k=0; k<computed_model.size(); k++)
+    for (int i=0; i<pp->data->ndata(); i++)
+      diff(i, k) = pp->data->data(i)-computed_model[k][i];
+
+  // ----- estimate the Gaussian log-likelihood ----- 
+  
+  return pp->LogLikelihood_covariance(diff);
+}
+
+
+// ============================================================================================
+
+
+vector<double> statistics::LogLikelihood_Gaussian_2D_covariance_batch (std::vector<std::vector<double>> &likelihood_parameters, const std::shared_ptr<void> fixed_parameters)
+{
+  // ----- extract the parameters ----- 
+  shared_ptr<statistics::STR_likelihood_inputs> pp = static_pointer_cast<statistics::STR_likelihood_inputs>(fixed_parameters);
+  
+  // ----- compute the model values for all the sets of parameters -----
+
+  vector<vector<vector<double>>> computed_model = pp->model->operator()(pp->xx, pp->yy, likelihood_parameters);
+
+  // ----- compute the differences between model and data at each bin, with the ordering of the covariance matrix ----- 
+
+  Eigen::MatrixXd diff(pp->data->xsize()*pp->data->ysize(), computed_model.size());
+  for (size_t k=0; k<computed_model.size(); k++)
+    for (int i=0; i<pp->data->xsize(); i++)
+      for (int j=0; j<pp->data->ysize(); j++)
+	diff(i*pp->data->ysize()+j, k) = pp->data->data(i, j)-computed_model[k][i][j];
+
+  // ----- estimate the Gaussian log-likelihood -----
+
+  return pp->LogLikelihood_covariance(diff);
+}
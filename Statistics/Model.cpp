@@ -50,6 +50,25 @@ vector<vector<double>> cbl::statistics::Model::operator() (const std::vector<std
 // ======================================================================================
 
 
+vector<vector<vector<double>>> cbl::statistics::Model::operator() (const std::vector<std::vector<double>> xx, std::vector<std::vector<double>> &parameters) const
+{
+  for (auto &&pp : parameters)
+    pp = m_parameters->full_parameters(pp);
+
+  if (m_function_batch)
+    return m_function_batch(xx, m_inputs, parameters);
+
+  vector<vector<vector<double>>> models(parameters.size());
+  for (size_t i=0; i<parameters.size(); i++)
+    models[i] = m_function(xx, m_inputs, parameters[i]);
+
+  return models;
+}
+
+
+// ======================================================================================
+
+
 void cbl::statistics::Model::set_parameters (const size_t nparameters, std::vector<ParameterType> parameterTypes, std::vector<std::string> parameterNames)
 {
   m_parameters = make_shared<cbl::statistics::ModelParameters>(cbl::statistics::ModelParameters(nparameters, parameterTypes, parameterNames));
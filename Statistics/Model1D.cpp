@@ -54,6 +54,37 @@ void cbl::statistics::Model1D::set_function (const model_function_1D function)
 // ======================================================================================
 
 
+void cbl::statistics::Model1D::set_function_batch (const model_function_1D_batch function_batch)
+{
+  m_function_batch = [function_batch](vector<vector<double>> xx, shared_ptr<void> inputs, vector<vector<double>> &parameters) 
+    {
+      vector<vector<double>> models = function_batch(xx[0], inputs, parameters);
+      vector<vector<vector<double>>> res(models.size());
+      for (size_t i=0; i<models.size(); i++)
+	res[i].emplace_back(move(models[i]));
+      return res;
+    };
+}
+
+
+// ======================================================================================
+
+
+vector<vector<double>> cbl::statistics::Model1D::operator() (const std::vector<double> xx, std::vector<std::vector<double>> &parameters) const
+{
+  vector<vector<vector<double>>> models = Model::operator()(vector<vector<double>>(1, xx), parameters);
+
+  vector<vector<double>> res(models.size());
+  for (size_t i=0; i<models.size(); i++)
+    res[i] = move(models[i][0]);
+
+  return res;
+}
+
+
+// ======================================================================================
+
+
 void cbl::statistics::Model1D::stats_from_chains (const vector<double> xx, vector<double> &median_model, vector<double> &low_model, vector<double> &up_model, const int start, const int thin) 
 {
   vector<vector<double>> _median, _low, _up;
@@ -53,6 +53,18 @@ void cbl::statistics::Model2D::set_function (const model_function_2D function)
 // ======================================================================================
 
 
+void cbl::statistics::Model2D::set_function_batch (const model_function_2D_batch function_batch)
+{
+  m_function_batch = [function_batch](vector<vector<double>> xx, shared_ptr<void> inputs, vector<vector<double>> &parameters) 
+    {
+      return function_batch(xx[0], xx[1], inputs, parameters);
+    };
+}
+
+
+// ======================================================================================
+
+
 void cbl::statistics::Model2D::stats_from_chains (const vector<double> xx, const vector<double> yy, vector<vector<double>> &median_model, vector<vector<double>> &low_model, vector<vector<double>> &up_model, const int start, const int thin) 
 {
   Model::stats_from_chains({xx, yy}, median_model, low_model, up_model, start, thin);
@@ -0,0 +1,338 @@
+/********************************************************************
+ *  Copyright (C) 2014 by Federico Marulli and Alfonso Veropalumbo  *
+ *  federico.marulli3@unibo.it                                      *
+ *                                                                  *
+ *  This program is free software; you can redistribute it and/or   *
+ *  modify it under the terms of the GNU General Public License as  *
+ *  published by the Free Software Foundation; either version 2 of  *
+ *  the License, or (at your option) any later version.             *
+ *                                                                  *
+ *  This program is distributed in the hope that it will be useful, *
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of  *
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the   *
+ *  GNU General Public License for more details.                    *
+ *                                                                  *
+ *  You should have received a copy of the GNU General Public       *
+ *  License along with this program; if not, write to the Free      *
+ *  Software Foundation, Inc.,                                      *
+ *  59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.       *
+ ********************************************************************/
+
+/** @file Statistics/NestedSampler.cpp
+ *
+ *  @brief Methods of the class NestedSampler
+ *
+ *  This file contains the implementation of the methods of the class
+ *  NestedSampler, used to sample the posterior and compute the
+ *  Bayesian evidence with the nested sampling algorithm
+ *
+ *  @authors Federico Marulli, Alfonso Veropalumbo
+ *
+ *  @authors federico.marulli3@unbo.it, alfonso.veropalumbo@unibo.it
+ */
+
+#include "NestedSampler.h"
+
+using namespace std;
+
+using namespace cbl;
+
+
+/// the probability of proposing a move with gamma=1, i.e. a jump between modes
+static const double mode_jump_probability = 0.1;
+
+
+// ============================================================================================
+
+
+/**
+ *  @brief the logarithm of the sum of two exponentials
+ *  @param aa the logarithm of the first addend
+ *  @param bb the logarithm of the second addend
+ *  @return \f$\log(e^a+e^b)\f$
+ */
+static double log_add_exp (const double aa, const double bb)
+{
+  if (aa<bb) return bb+log1p(exp(aa-bb));
+  return (bb==-numeric_limits<double>::infinity()) ? aa : aa+log1p(exp(bb-aa));
+}
+
+
+// ============================================================================================
+
+
+cbl::statistics::NestedSampler::NestedSampler (const int npar, const std::function<double(std::vector<double> &)> log_likelihood, const std::function<double(std::vector<double> &)> log_prior, const std::function<std::vector<double>()> prior_sample, const std::vector<unsigned int> free_parameters)
+  : m_npar(npar), m_free_parameters(free_parameters), m_log_likelihood(log_likelihood), m_log_prior(log_prior), m_prior_sample(prior_sample)
+{
+  if (m_npar<1)
+    ErrorCBL("Error in cbl::statistics::NestedSampler::NestedSampler() of NestedSampler.cpp: the number of parameters must be positive!");
+
+  if (m_free_parameters.size()==0)
+    for (int p=0; p<m_npar; p++)
+      m_free_parameters.emplace_back(p);
+
+  for (auto &&p : m_free_parameters)
+    if (int(p)>=m_npar)
+      ErrorCBL("Error in cbl::statistics::NestedSampler::NestedSampler() of NestedSampler.cpp: the index of a free parameter is larger than the number of parameters!");
+}
+
+
+// ============================================================================================
+
+
+void cbl::statistics::NestedSampler::m_constrained_walk (std::vector<double> &point, double &log_like, double &log_prior, const std::vector<std::vector<double>> &live, const std::vector<int> &index, const std::vector<double> &spread, const double log_like_min, const int nsteps, const double scale, random::CounterRandomNumbers &ran, int &naccepted, int &ncalls) const
+{
+  naccepted = 0;
+  ncalls = 0;
+
+  const int nindex = index.size();
+  vector<double> proposal(m_npar);
+
+  // if no move has been accepted after nsteps, the walk goes on, up to 10*nsteps
+  for (int step=0; step<nsteps || (naccepted==0 && step<10*nsteps); step++) {
+
+    // differential-evolution move, with two different live points
+    const int aa = index[ran(0, nindex-1)];
+    int bb = aa;
+    while (bb==aa && nindex>1) bb = index[ran(0, nindex-1)];
+
+    const double gamma = (ran()<mode_jump_probability) ? 1. : scale;
+
+    // only the free parameters are moved
+    proposal = point;
+    for (auto &&p : m_free_parameters)
+      proposal[p] = point[p]+gamma*(live[aa][p]-live[bb][p])+1.e-4*spread[p]*(2.*ran()-1.);
+
+    // Metropolis-Hastings acceptance on the prior
+    const double log_prior_proposal = m_log_prior(proposal);
+    if (log_prior_proposal<=par::defaultDouble || std::log(ran())>log_prior_proposal-log_prior) continue;
+
+    // likelihood constraint
+    const double log_like_proposal = m_log_likelihood(proposal);
+    ncalls ++;
+
+    if (log_like_proposal>log_like_min) {
+      point = proposal;
+      log_like = log_like_proposal;
+      log_prior = log_prior_proposal;
+      naccepted ++;
+    }
+  }
+}
+
+
+// ============================================================================================
+
+
+void cbl::statistics::NestedSampler::sample (const int nlive, const double dlogz, const int nsteps, const int nparallel, const int seed, const int max_iter)
+{
+  if (nlive<4 || nsteps<1 || nparallel<1 || dlogz<=0.)
+    ErrorCBL("Error in cbl::statistics::NestedSampler::sample() of NestedSampler.cpp: nlive must be >=4, nsteps and nparallel >=1, and dlogz >0!");
+
+  // the number of live points replaced at each iteration
+  const int kk = min(nparallel, nlive/2);
+
+  coutCBL << "Starting seed = " << seed << endl;
+  coutCBL << "Number of live points = " << nlive << ", replaced " << kk << " at a time" << endl;
+
+  const double neg_inf = -numeric_limits<double>::infinity();
+
+  m_samples.erase(m_samples.begin(), m_samples.end());
+  m_log_likelihood_samples.erase(m_log_likelihood_samples.begin(), m_log_likelihood_samples.end());
+  m_log_weight.erase(m_log_weight.begin(), m_log_weight.end());
+  m_nlikelihood = 0;
+  m_niterations = 0;
+
+
+  // ----- draw the live points from the prior -----
+
+  vector<vector<double>> live(nlive);
+  vector<double> live_logL(nlive), live_logP(nlive);
+
+  for (int i=0; i<nlive; i++) {
+    live[i] = m_prior_sample();
+    checkDim(live[i], m_npar, "live["+conv(i, par::fINT)+"]");
+  }
+
+#pragma omp parallel for schedule(dynamic)
+  for (int i=0; i<nlive; i++) {
+    live_logP[i] = m_log_prior(live[i]);
+    live_logL[i] = m_log_likelihood(live[i]);
+  }
+
+  m_nlikelihood += nlive;
+
+
+  // ----- the evidence and the information are updated with each discarded point -----
+
+  double logX = 0., logZ = neg_inf, HH = 0.;
+
+  auto add_sample = [&] (const vector<double> &pp, const double logL, const double logw)
+    {
+      const double logZ_new = log_add_exp(logZ, logw+logL);
+      HH = exp(logw+logL-logZ_new)*logL+((logZ>neg_inf) ? exp(logZ-logZ_new)*(HH+logZ) : 0.)-logZ_new;
+      logZ = logZ_new;
+
+      m_samples.emplace_back(pp);
+      m_log_likelihood_samples.emplace_back(logL);
+      m_log_weight.emplace_back(logw);
+    };
+
+
+  // ----- nested sampling iterations -----
+
+  vector<int> order(nlive);
+  vector<vector<double>> new_point(kk);
+  vector<double> new_logL(kk), new_logP(kk);
+  double scale = 1.;
+
+  while (m_niterations<max_iter) {
+
+    // stop when the live points cannot change the evidence by more than dlogz
+    const double remaining = log_add_exp(logZ, *max_element(live_logL.begin(), live_logL.end())+logX)-logZ;
+
+    if (m_niterations%100==0) {
+      coutCBL << "iteration " << m_niterations << ", log(Z) = " << setprecision(3) << logZ << ", remaining = " << remaining << "    \r"; cout.flush();
+    }
+
+    if (remaining<dlogz) break;
+
+    // discard the kk points with the lowest likelihood
+    for (int i=0; i<nlive; i++) order[i] = i;
+    partial_sort(order.begin(), order.begin()+kk, order.end(), [&] (const int ii, const int jj) { return live_logL[ii]<live_logL[jj]; });
+
+    for (int j=0; j<kk; j++) {
+      const double logX_new = logX-1./(nlive-j);
+      add_sample(live[order[j]], live_logL[order[j]], logX+log1p(-exp(logX_new-logX)));
+      logX = logX_new;
+    }
+
+    const double logL_min = live_logL[order[kk-1]];
+
+    // the surviving live points, used to construct the proposals
+    const vector<int> index(order.begin()+kk, order.end());
+
+    // the spread and the dimension of the live points, along the free parameters only
+    vector<double> spread(m_npar, 0.);
+    int ndim = 0;
+    for (auto &&p : m_free_parameters) {
+      double mean = 0., mean2 = 0.;
+      for (auto &&i : index) { mean += live[i][p]; mean2 += live[i][p]*live[i][p]; }
+      mean /= index.size(); mean2 /= index.size();
+      spread[p] = sqrt(max(mean2-mean*mean, 0.));
+      if (spread[p]>0.) ndim ++;
+    }
+
+    // the optimal scale of the differential-evolution moves for a Gaussian target (ter Braak 2006)
+    const double gamma = scale*2.38/sqrt(2.*max(ndim, 1));
+
+    // replace the discarded points
+    int naccepted_tot = 0, ncalls_tot = 0;
+
+#pragma omp parallel for schedule(dynamic) reduction(+:naccepted_tot, ncalls_tot)
+    for (int j=0; j<kk; j++) {
+      random::CounterRandomNumbers ran(seed, uint64_t(m_niterations), uint32_t(j));
+
+      const int start = index[ran(0, int(index.size())-1)];
+      new_point[j] = live[start];
+      new_logL[j] = live_logL[start];
+      new_logP[j] = live_logP[start];
+
+      int naccepted, ncalls;
+      m_constrained_walk(new_point[j], new_logL[j], new_logP[j], live, index, spread, logL_min, nsteps, gamma, ran, naccepted, ncalls);
+
+      naccepted_tot += naccepted;
+      ncalls_tot += ncalls;
+    }
+
+    for (int j=0; j<kk; j++) {
+      live[order[j]] = move(new_point[j]);
+      live_logL[order[j]] = new_logL[j];
+      live_logP[order[j]] = new_logP[j];
+    }
+
+    m_nlikelihood += ncalls_tot;
+
+    // adapt the scale of the moves to an acceptance rate of about 50%
+    scale = min(max(scale*exp(2.*(double(naccepted_tot)/(kk*nsteps)-0.5)), 1.e-4), 10.);
+
+    m_niterations ++;
+  }
+
+  cout << endl;
+
+  if (m_niterations==max_iter)
+    WarningMsg("Warning in cbl::statistics::NestedSampler::sample() of NestedSampler.cpp: the maximum number of iterations has been reached!");
+
+
+  // ----- add the live points, which share the remaining prior volume -----
+
+  for (int i=0; i<nlive; i++)
+    add_sample(live[i], live_logL[i], logX-std::log(double(nlive)));
+
+
+  // ----- evidence, posterior weights and effective sample size -----
+
+  m_log_evidence = logZ;
+  m_information = HH;
+  m_log_evidence_error = sqrt(max(HH, 0.)/nlive);
+
+  double sum_w2 = 0.;
+  for (size_t i=0; i<m_log_weight.size(); i++) {
+    m_log_weight[i] += m_log_likelihood_samples[i]-logZ;
+    sum_w2 += exp(2.*m_log_weight[i]);
+  }
+  m_effective_sample_size = 1./sum_w2;
+
+  coutCBL << "Done!" << endl;
+}
+
+
+// ============================================================================================
+
+
+void cbl::statistics::NestedSampler::get_samples (std::vector<std::vector<double>> &chain_value, std::vector<double> &log_likelihood, std::vector<double> &weight) const
+{
+  chain_value.assign(m_npar, vector<double>(m_samples.size()));
+  weight.resize(m_samples.size());
+
+  for (size_t i=0; i<m_samples.size(); i++) {
+    for (int p=0; p<m_npar; p++)
+      chain_value[p][i] = m_samples[i][p];
+    weight[i] = exp(m_log_weight[i]);
+  }
+
+  log_likelihood = m_log_likelihood_samples;
+}
+
+
+// ============================================================================================
+
+
+void cbl::statistics::NestedSampler::get_equal_weighted_samples (std::vector<std::vector<double>> &chain_value, std::vector<double> &log_likelihood, const int seed) const
+{
+  if (m_samples.size()==0)
+    ErrorCBL("Error in cbl::statistics::NestedSampler::get_equal_weighted_samples() of NestedSampler.cpp: the posterior has not been sampled!");
+
+  const int nn = max(1, int(m_effective_sample_size));
+
+  chain_value.assign(m_npar, vector<double>(nn));
+  log_likelihood.resize(nn);
+
+  // systematic resampling: one random offset, nn equally spaced positions in the cumulative weights
+  random::CounterRandomNumbers ran(seed, 0);
+  const double offset = ran();
+
+  double cumulative = exp(m_log_weight[0]);
+  size_t i = 0;
+
+  for (int k=0; k<nn; k++) {
+    const double position = (offset+k)/nn;
+    while (cumulative<position && i<m_samples.size()-1)
+      cumulative += exp(m_log_weight[++i]);
+
+    for (int p=0; p<m_npar; p++)
+      chain_value[p][k] = m_samples[i][p];
+    log_likelihood[k] = m_log_likelihood_samples[i];
+  }
+}
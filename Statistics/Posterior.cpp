@@ -71,7 +71,7 @@ cbl::statistics::Posterior::Posterior (const std::vector<std::shared_ptr<PriorDi
 
   m_prior = m_model_parameters->prior();
 
-  m_likelihood_inputs = make_shared<STR_likelihood_inputs>(STR_likelihood_inputs(m_data, m_model, m_x_index, m_w_index));
+  m_set_likelihood_inputs();
 
   m_set_seed(seed);
 }
@@ -113,6 +113,39 @@ double cbl::statistics::Posterior::log (std::vector<double> &pp) const
 // ============================================================================================
 
 
+vector<double> cbl::statistics::Posterior::log (std::vector<std::vector<double>> &pp) const
+{
+  vector<double> val(pp.size(), par::defaultDouble), logprior(pp.size());
+  vector<size_t> index;
+
+  for (size_t i=0; i<pp.size(); i++) {
+    pp[i] = m_model_parameters->full_parameters(pp[i]);
+    logprior[i] = m_prior->log(pp[i]);
+    if (logprior[i]>par::defaultDouble)
+      index.emplace_back(i);
+  }
+
+  if (index.size()==0) return val;
+
+  // compute the likelihood only for the parameters inside the prior range
+  vector<vector<double>> pp_prior(index.size());
+  for (size_t k=0; k<index.size(); k++)
+    pp_prior[k] = move(pp[index[k]]);
+
+  const vector<double> loglikelihood = Likelihood::log(pp_prior);
+
+  for (size_t k=0; k<index.size(); k++) {
+    pp[index[k]] = move(pp_prior[k]);
+    val[index[k]] = loglikelihood[k]+logprior[index[k]];
+  }
+
+  return val;
+}
+
+
+// ============================================================================================
+
+
 void cbl::statistics::Posterior::set_model (const std::shared_ptr<Model> model, const std::shared_ptr<ModelParameters> model_parameters)
 {
   switch (model->dimension()) {
@@ -150,7 +183,7 @@ void cbl::statistics::Posterior::set (const std::vector<std::shared_ptr<PriorDis
   m_prior = m_model_parameters->prior();
 
   set_function(likelihood_type, x_index, w_index);
-  m_likelihood_inputs = make_shared<STR_likelihood_inputs>(STR_likelihood_inputs(m_data, m_model, m_x_index, m_w_index));
+  m_set_likelihood_inputs();
 
   m_set_seed(seed);
 }
@@ -221,6 +254,11 @@ void cbl::statistics::Posterior::sample_stretch_move (const double aa, const boo
   auto posterior = [this] (vector<double> &pp) { return log(pp); }; 
 
   cbl::statistics::Sampler sampler(nparameters, nparameters_free, posterior); 
+
+  // evaluate the walkers of each half-ensemble at once, if the model can be computed for several sets of parameters
+  if (m_model->has_function_batch() && m_log_likelihood_function_batch && !m_use_grid)
+    sampler.set_function_batch([this] (vector<vector<double>> &pp) { return log(pp); });
+
   if (parallel)
     sampler.sample_stretch_move_parallel(chain_size, nwalkers, Start, seed, aa);
   else
@@ -240,6 +278,109 @@ void cbl::statistics::Posterior::sample_stretch_move (const double aa, const boo
 // ============================================================================================
 
 
+void cbl::statistics::Posterior::sample_stretch_move_streaming (const std::string output_dir, const std::string output_file, const double aa, const bool resume, const int block_size, const int start, const int thin, const int nbins)
+{
+  coutCBL << "Sampling the posterior..." << endl;
+
+  const int seed = m_generate_seed();
+  const int nparameters = m_model_parameters->nparameters();
+  const int nparameters_free = m_model_parameters->nparameters_free();
+  const int chain_size = m_model_parameters->chain_size();
+  const int nwalkers = m_model_parameters->chain_nwalkers();
+
+  string MK = "mkdir -p "+output_dir;
+  if (system(MK.c_str())) {}
+
+  const string file = output_dir+output_file;
+
+  shared_ptr<ChainFile> chain_file = (resume && ChainFile::is_chain_file(file)) ? make_shared<ChainFile>(file, block_size) : make_shared<ChainFile>(file, nparameters, nwalkers, seed, block_size);
+
+  vector<vector<double>> Start(nwalkers, vector<double>(nparameters, 0));
+
+  for (int i=0; i<nparameters; i++)
+    for (int j=0; j<nwalkers; j++)
+      Start[j][i] = m_model_parameters->chain_value(i, 0, j);
+
+  auto posterior = [this] (vector<double> &pp) { return log(pp); }; 
+
+  cbl::statistics::Sampler sampler(nparameters, nparameters_free, posterior); 
+
+  // evaluate the walkers of each half-ensemble at once, if the model can be computed for several sets of parameters
+  if (m_model->has_function_batch() && m_log_likelihood_function_batch && !m_use_grid)
+    sampler.set_function_batch([this] (vector<vector<double>> &pp) { return log(pp); });
+
+  sampler.sample_stretch_move_parallel(chain_file, chain_size, Start, seed, aa);
+
+  coutCBL << "I wrote the file: " << file << endl;
+
+  // read the chains, with burn-in and dilution, and set the best-fit
+  // parameters to their median values
+  read_chain_binary(output_dir, output_file, start, thin);
+  m_model_parameters->set_bestfit_values(0, 1, nbins, m_generate_seed());
+}
+
+
+// ============================================================================================
+
+
+void cbl::statistics::Posterior::sample_nested (const int nlive, const double dlogz, const int nsteps, const int nparallel, const int nbins)
+{
+  coutCBL << "Sampling the posterior with the nested sampler..." << endl;
+
+  const int seed = m_generate_seed();
+  const int nparameters = m_model_parameters->nparameters();
+
+  auto log_likelihood = [this] (vector<double> &pp) { pp = m_model_parameters->full_parameters(pp); return Likelihood::log(pp); };
+
+  auto log_prior = [this] (vector<double> &pp) { return m_prior->log(pp); };
+
+  // the base parameters are drawn from their priors, the derived ones are computed with the likelihood
+  auto prior_sample = [this, nparameters] ()
+    {
+      vector<double> pp(nparameters, 0.);
+      for (int i=0; i<nparameters; i++)
+	if (m_model_parameters->type(i)==ParameterType::_Base_)
+	  pp[i] = m_model_parameters->prior_distribution(i)->sample();
+      return pp;
+    };
+
+  // only the free base parameters are explored by the sampler
+  cbl::statistics::NestedSampler sampler(nparameters, log_likelihood, log_prior, prior_sample, m_model_parameters->free_parameters());
+  sampler.sample(nlive, dlogz, nsteps, nparallel, seed);
+
+  m_log_evidence = sampler.log_evidence();
+  m_log_evidence_error = sampler.log_evidence_error();
+  m_effective_sample_size = sampler.effective_sample_size();
+
+  coutCBL << "log(evidence) = " << setprecision(4) << m_log_evidence << " +/- " << m_log_evidence_error << endl;
+  coutCBL << "effective sample size = " << int(m_effective_sample_size) << endl;
+  coutCBL << "likelihood evaluations = " << sampler.nlikelihood() << " in " << sampler.niterations() << " iterations" << endl;
+
+  // the chains contain the equally weighted posterior samples
+  vector<vector<double>> chain_values;
+  vector<double> loglikelihood;
+  sampler.get_equal_weighted_samples(chain_values, loglikelihood, m_generate_seed());
+
+  m_logposterior_values.resize(loglikelihood.size());
+  for (size_t j=0; j<loglikelihood.size(); j++) {
+    vector<double> pp(nparameters);
+    for (int i=0; i<nparameters; i++)
+      pp[i] = chain_values[i][j];
+    m_logposterior_values[j] = loglikelihood[j]+m_prior->log(pp);
+  }
+
+  m_acceptance.erase(m_acceptance.begin(), m_acceptance.end());
+
+  m_model_parameters->set_chain_values(chain_values, 1);
+
+  // set the best-fit parameters to the median values of the posterior samples
+  m_model_parameters->set_bestfit_values(0, 1, nbins, m_generate_seed());
+}
+
+
+// ============================================================================================
+
+
 void cbl::statistics::Posterior::write_chain_ascii (const string output_dir, const string output_file, const int start, const int thin)
 {
   const int nparameters = m_model_parameters->nparameters();
@@ -349,7 +490,7 @@ void cbl::statistics::Posterior::write_chain (const string output_dir, const str
 // ============================================================================================
 
 
-void cbl::statistics::Posterior::read_chain_ascii (const string input_dir, const string input_file, const int nwalkers, const int skip_header)
+void cbl::statistics::Posterior::read_chain_ascii (const string input_dir, const string input_file, const int nwalkers, const int skip_header, const int start, const int thin)
 {
   string file = input_dir+input_file;
   coutCBL << "Reading the chain file " << file << endl;
@@ -360,11 +501,18 @@ void cbl::statistics::Posterior::read_chain_ascii (const string input_dir, const
   for (int i=0; i<skip_header; i++)
     getline(fin, line);
 
+  if (start<0 || thin<1)
+    ErrorCBL("Error in cbl::statistics::Posterior::read_chain_ascii() of Posterior.cpp: start must be >=0 and thin >=1!");
+
   vector<vector<double>> chain_value;
   m_logposterior_values.erase(m_logposterior_values.begin(), m_logposterior_values.end());
 
-  while (getline(fin, line))
+  for (int row=0; getline(fin, line); row++)
   {
+    // burn-in and dilution
+    const int step = row/nwalkers;
+    if (step<start || (step-start)%thin!=0) continue;
+
     stringstream ss(line);
     double NUM;
     vector<double> ll, params;
@@ -395,7 +543,7 @@ void cbl::statistics::Posterior::read_chain_ascii (const string input_dir, const
 // ============================================================================================
 
 
-void cbl::statistics::Posterior::read_chain_fits (const string input_dir, const string input_file, const int nwalkers)
+void cbl::statistics::Posterior::read_chain_fits (const string input_dir, const string input_file, const int nwalkers, const int start, const int thin)
 {
   const int nparameters = m_model_parameters->nparameters();
 
@@ -410,10 +558,17 @@ void cbl::statistics::Posterior::read_chain_fits (const string input_dir, const
 
   vector<vector<double>> values = cbl::wrapper::ccfits::read_table_fits(file, names);
 
-  for (int i=0; i<nparameters; i++)
-    chain_value[i] = values[i];
+  if (start<0 || thin<1)
+    ErrorCBL("Error in cbl::statistics::Posterior::read_chain_fits() of Posterior.cpp: start must be >=0 and thin >=1!");
 
-  m_logposterior_values = values[nparameters];
+  // burn-in and dilution
+  for (size_t row=0; row<values[nparameters].size(); row++) {
+    const int step = row/nwalkers;
+    if (step<start || (step-start)%thin!=0) continue;
+    for (int i=0; i<nparameters; i++)
+      chain_value[i].emplace_back(values[i][row]);
+    m_logposterior_values.emplace_back(values[nparameters][row]);
+  }
 
   int chain_size = m_logposterior_values.size()/nwalkers;
  
@@ -429,12 +584,42 @@ void cbl::statistics::Posterior::read_chain_fits (const string input_dir, const
 // ============================================================================================
 
 
-void cbl::statistics::Posterior::read_chain (const string input_dir, const string input_file, const int nwalkers, const int skip_header, const bool fits)
+void cbl::statistics::Posterior::read_chain_binary (const string input_dir, const string input_file, const int start, const int thin)
 {
-  if (!fits) 
-    read_chain_ascii(input_dir, input_file, nwalkers, skip_header);
+  string file = input_dir+input_file;
+  coutCBL << "Reading the chain file " << file << endl;
+
+  ChainFile chain_file(file);
+
+  if (chain_file.npar()!=int(m_model_parameters->nparameters()))
+    ErrorCBL("Error in cbl::statistics::Posterior::read_chain_binary() of Posterior.cpp: the number of parameters of the chain file is wrong!");
+
+  vector<vector<double>> chain_value;
+  chain_file.read(chain_value, m_logposterior_values, start, thin);
+
+  if (m_logposterior_values.size()==0)
+    ErrorCBL("Error in cbl::statistics::Posterior::read_chain_binary() of Posterior.cpp: no steps selected from "+file+"!");
+
+  m_model_parameters->set_chain_values(chain_value, chain_file.nwalkers());
+
+  coutCBL << "Done!" << endl << endl;
+}
+
+
+// ============================================================================================
+
+
+void cbl::statistics::Posterior::read_chain (const string input_dir, const string input_file, const int nwalkers, const int skip_header, const bool fits, const int start, const int thin)
+{
+  if (ChainFile::is_chain_file(input_dir+input_file)) {
+    if (ChainFile(input_dir+input_file).nwalkers()!=nwalkers)
+      ErrorCBL("Error in cbl::statistics::Posterior::read_chain() of Posterior.cpp: the number of walkers of the chain file is not "+conv(nwalkers, par::fINT)+"!");
+    read_chain_binary(input_dir, input_file, start, thin);
+  }
+  else if (!fits) 
+    read_chain_ascii(input_dir, input_file, nwalkers, skip_header, start, thin);
   else 
-    read_chain_fits(input_dir, input_file, nwalkers);
+    read_chain_fits(input_dir, input_file, nwalkers, start, thin);
 }
 
 
@@ -101,6 +101,15 @@ void cbl::statistics::Sampler::set_function (const function<double(vector<double
 }
 
 
+// ============================================================================================
+
+
+void cbl::statistics::Sampler::set_function_batch (const function<vector<double>(vector<vector<double>> &)> function_batch)
+{
+  m_function_batch = function_batch;
+}
+
+
 // ============================================================================================
 
 /*
@@ -207,85 +216,118 @@ void cbl::statistics::Sampler::sample_stretch_move (const int chain_size, const
 // ============================================================================================
 
 
-void cbl::statistics::Sampler::m_sample_stretch_move_parallel_cpp (const int chain_size, const int nwalkers, const vector<vector<double>> start, const int seed, const double aa)
+void cbl::statistics::Sampler::m_sample_stretch_move_parallel_cpp (const int chain_size, const int nwalkers, const vector<vector<double>> start, const int seed, const double aa, const shared_ptr<ChainFile> chain_file)
 {
-  set_chain(m_npar, m_npar_free, chain_size, nwalkers);
-
-  // set seeds and random_numbers
-  random::UniformRandomNumbers_Int seeds(0, 23412432, seed);
+  if (aa<=1)
+    ErrorCBL("Error in cbl::statistics::Sampler::m_sample_stretch_move_parallel_cpp() of Sampler.cpp: the stretch move parameter must be >1!");
 
-  vector<double> chains_index = linear_bin_vector(m_nwalkers, 0., m_nwalkers-1.);
-  vector<double> chains_weights(m_nwalkers,1);
+  // if the chains are written on a file, only the last two steps are kept in memory
+  const bool stream = (chain_file!=NULL);
+  set_chain(m_npar, m_npar_free, (stream) ? 2 : chain_size, nwalkers);
+  const int nmem = m_chain_size;
 
-  const int chain_seed1 = seeds();
-  const int chain_seed2 = seeds();
-  const int MH_seed = seeds();
-  const int gz_seed = seeds();
+  // each walker extracts its random numbers from its own stream,
+  // identified by the walker index and the step: the chains do not
+  // depend on the number of threads
 
   coutCBL << "Starting seed = " << seed << endl;
-  coutCBL << "Seed for random walker choice, first half = " << chain_seed1 << endl;
-  coutCBL << "Seed for random walker choice, second half = " << chain_seed2 << endl;
-  coutCBL << "Seed for Metropolis-Hastings algorithm = " << MH_seed << endl;
-  coutCBL << "Seed for random extraction from g(z) = " << gz_seed << endl;
-
-  int half = m_nwalkers/2;
-  random::UniformRandomNumbers_Int chains_first_half(0, half-1, chain_seed1);
-  random::UniformRandomNumbers_Int chains_second_half(half, m_nwalkers-1, chain_seed2);
 
-  vector<random::UniformRandomNumbers_Int> chains_sample = {chains_second_half, chains_first_half};
-
-  random::UniformRandomNumbers MH_random(0., 1., MH_seed);
-
-  auto gz = m_set_gz(gz_seed, aa);
+  const int half = m_nwalkers/2;
+
+  // the proposals of the walkers of one half, and the quantities
+  // used to accept them, allocated once
+  vector<vector<double>> proposals(half, vector<double>(m_npar, 0.));
+  vector<double> proposed_function_chains(half, par::defaultDouble), gen_z(half, 1.), MH_random(half, 0.);
+
+  // initialise the chains, or resume them from the last step
+  // written on the file
+  int n0 = 0;
+  if (stream && chain_file->nsteps()>0) {
+    if (chain_file->npar()!=m_npar || chain_file->nwalkers()!=m_nwalkers)
+      ErrorCBL("Error in cbl::statistics::Sampler::m_sample_stretch_move_parallel_cpp() of Sampler.cpp: the number of parameters or walkers of the chain file is wrong!");
+    // the random streams depend on the seed: a different seed would
+    // not continue the same chains
+    if (chain_file->seed()!=seed)
+      ErrorCBL("Error in cbl::statistics::Sampler::m_sample_stretch_move_parallel_cpp() of Sampler.cpp: the chains of the file have been sampled with seed = "+conv(chain_file->seed(), par::fINT)+", while seed = "+conv(seed, par::fINT)+"!");
+    n0 = chain_file->nsteps()-1;
+    chain_file->last_step(m_chains[n0%nmem], m_function_chain[n0%nmem]);
+    coutCBL << "Resuming the chains from step " << n0 << endl;
+  }
+  else {
+    m_initialize_chains(start);
+    if (stream) chain_file->append_step(m_chains[0], m_function_chain[0]);
+  }
 
-  // initialise the chains
-  m_initialize_chains(start);
+  const double acceptance_step = 1./(chain_size-n0);
   
   // stretch-move
 
-  for (int n=1; n<m_chain_size; n++) {
+  for (int n=n0+1; n<chain_size; n++) {
+
+    const int prev = (n-1)%nmem, curr = n%nmem;
+    
     for (int ss=0; ss<2; ss++) {
+
+      // the walkers of one half are moved towards the walkers of
+      // the other half, already moved if ss=1
+      const vector<vector<double>> &complementary = m_chains[(ss==0) ? prev : curr];
+      const int kMin = (ss==0) ? half : 0;
+
 #pragma omp parallel for schedule(dynamic)
       for (int ii=0; ii<half; ii++)
       {
-	int nn = n-1+ss; 
-	int i = half*ss+ii;
-	int kk = int(chains_sample[ss]());;
+	const int i = half*ss+ii;
 
-	vector<double> parameters_i= m_chains[n-1][i];
-	vector<double> parameters_k = m_chains[nn][kk];;
+	random::CounterRandomNumbers ran(seed, i, n);
 
-        vector<double> parameters(m_npar, 0);
-        double proposed_function_chains = par::defaultDouble;
+	const int kk = ran(kMin, kMin+half-1);
 
-        double gen_z = gz->operator()();
+	// extract z from g(z) ~ 1/sqrt(z), in [1/a, a], by inversion
+	const double uu = (aa-1.)*ran()+1.;
+	gen_z[ii] = uu*uu/aa;
+
+	MH_random[ii] = ran();
 
-	gen_z = gz->operator()();
 	for (int p=0; p<m_npar; p++)
-	  parameters[p] = parameters_k[p] + gen_z*(parameters_i[p]-parameters_k[p]);
-	proposed_function_chains = m_function(parameters);
+	  proposals[ii][p] = complementary[kk][p]+gen_z[ii]*(m_chains[prev][i][p]-complementary[kk][p]);
 
-        parameters_i = parameters;
+	if (!m_function_batch)
+	  proposed_function_chains[ii] = m_function(proposals[ii]);
+      }
 
-	double ratio = min(1.,pow(gen_z, m_npar_free-1)*exp(proposed_function_chains-m_function_chain[n-1][i]));
+      if (m_function_batch) {
+	proposed_function_chains = m_function_batch(proposals);
+	if (int(proposed_function_chains.size())!=half)
+	  ErrorCBL("Error in cbl::statistics::Sampler::m_sample_stretch_move_parallel_cpp() of Sampler.cpp: the batch function must return one value for each walker!");
+      }
 
-        if (MH_random() <ratio) {
-          m_function_chain[n][i] = proposed_function_chains;
-	  m_chains[n][i] = parameters_i;
-	  m_acceptance[i] += 1./m_chain_size;
+#pragma omp parallel for schedule(static)
+      for (int ii=0; ii<half; ii++)
+      {
+	const int i = half*ss+ii;
+
+	double ratio = min(1., pow(gen_z[ii], m_npar_free-1)*exp(proposed_function_chains[ii]-m_function_chain[prev][i]));
+
+	if (MH_random[ii]<ratio) {
+	  m_function_chain[curr][i] = proposed_function_chains[ii];
+	  m_chains[curr][i] = proposals[ii];
+	  m_acceptance[i] += acceptance_step;
 	}
 	else {
-	  m_function_chain[n][i] = m_function_chain[n-1][i];
-	  m_chains[n][i] = m_chains[n-1][i]; 
+	  m_function_chain[curr][i] = m_function_chain[prev][i];
+	  m_chains[curr][i] = m_chains[prev][i]; 
 	}
-
       }
     }
+
+    if (stream) chain_file->append_step(m_chains[curr], m_function_chain[curr]);
     
-    double progress = double((n+1)*m_nwalkers)/(m_nwalkers*m_chain_size)*100;
+    double progress = double((n+1)*m_nwalkers)/(m_nwalkers*chain_size)*100;
     coutCBL << setprecision(2) << setiosflags(ios::fixed) << setw(8) << progress << "% \r"; cout.flush();
   }
 
+  if (stream) chain_file->flush();
+
   cout << endl;
   coutCBL << "Done!" << endl;
 }
@@ -393,6 +435,24 @@ void cbl::statistics::Sampler::sample_stretch_move_parallel (const int chain_siz
 // ============================================================================================
 
 
+void cbl::statistics::Sampler::sample_stretch_move_parallel (const std::shared_ptr<ChainFile> chain_file, const int chain_size, const vector<vector<double>> start, const int seed, const double aa)
+{
+  if (chain_file==NULL)
+    ErrorCBL("Error in cbl::statistics::Sampler::sample_stretch_move_parallel() of Sampler.cpp: the chain file is not set!");
+  
+  if (chain_file->nwalkers()%2 != 0)
+    ErrorCBL("Error in cbl::statistics::Sampler::sample_stretch_move_parallel() of Sampler.cpp: the number of walkers must be an even integer!");
+
+  if (m_use_python)
+    ErrorCBL("Error in cbl::statistics::Sampler::sample_stretch_move_parallel() of Sampler.cpp: the chains cannot be written on a file while sampling python functions!");
+  
+  m_sample_stretch_move_parallel_cpp(chain_size, chain_file->nwalkers(), start, seed, aa, chain_file);
+}
+
+
+// ============================================================================================
+
+
 void cbl::statistics::Sampler::get_chain_function_acceptance (vector<vector<double>> &chains, vector<double> &function, vector<double> &acceptance, const int start, const int thin)
 {
   chains.resize(m_npar);
@@ -0,0 +1,169 @@
+/*******************************************************************
+ *  Copyright (C) 2010 by Federico Marulli                         *
+ *  federico.marulli3@unibo.it                                     *
+ *                                                                 *
+ *  This program is free software; you can redistribute it and/or  *
+ *  modify it under the terms of the GNU General Public License as *
+ *  published by the Free Software Foundation; either version 2 of *
+ *  the License, or (at your option) any later version.            *
+ *                                                                 *
+ *  This program is distributed in the hope that it will be useful,*
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of *
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the  *
+ *  GNU General Public License for more details.                   *
+ *                                                                 *
+ *  You should have received a copy of the GNU General Public      *
+ *  License along with this program; if not, write to the Free     *
+ *  Software Foundation, Inc.,                                     *
+ *  59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.      *
+ *******************************************************************/
+
+/**
+ *  @file Wrappers/MPIwrapper.cpp
+ *
+ *  @brief functions that wrap the MPI routines used to distribute
+ *  the computation across different tasks
+ *
+ *  This file contains the implementation of the wrappers of the MPI
+ *  routines
+ *
+ *  @author Federico Marulli
+ *
+ *  @author federico.marulli3@unbo.it
+ */
+
+#ifdef USE_MPI
+// the deprecated C++ bindings are not used
+#define OMPI_SKIP_MPICXX
+#define MPICH_SKIP_MPICXX
+#include <mpi.h>
+#endif
+
+#include "MPIwrapper.h"
+
+using namespace std;
+
+
+// ============================================================================
+
+
+bool cbl::wrapper::mpi::distributed ()
+{
+  return size()>1;
+}
+
+
+// ============================================================================
+
+
+int cbl::wrapper::mpi::rank ()
+{
+  int rank = 0;
+
+#ifdef USE_MPI
+  int initialized; MPI_Initialized(&initialized);
+  if (initialized) MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+#endif
+
+  return rank;
+}
+
+
+// ============================================================================
+
+
+int cbl::wrapper::mpi::size ()
+{
+  int size = 1;
+
+#ifdef USE_MPI
+  int initialized; MPI_Initialized(&initialized);
+  if (initialized) MPI_Comm_size(MPI_COMM_WORLD, &size);
+#endif
+
+  return size;
+}
+
+
+// ============================================================================
+
+
+std::vector<std::vector<double>> cbl::wrapper::mpi::allgather (const std::vector<double> &data)
+{
+  const int nTasks = size();
+
+  if (nTasks==1) return {data};
+
+  vector<vector<double>> gathered(nTasks);
+
+#ifdef USE_MPI
+
+  // the size of the vector of each task
+
+  int nData = data.size();
+  vector<int> count(nTasks), displ(nTasks, 0);
+  MPI_Allgather(&nData, 1, MPI_INT, count.data(), 1, MPI_INT, MPI_COMM_WORLD);
+
+  for (int i=1; i<nTasks; ++i)
+    displ[i] = displ[i-1]+count[i-1];
+
+
+  // the vectors of all the tasks
+
+  vector<double> buffer(displ[nTasks-1]+count[nTasks-1]);
+  MPI_Allgatherv(data.data(), nData, MPI_DOUBLE, buffer.data(), count.data(), displ.data(), MPI_DOUBLE, MPI_COMM_WORLD);
+
+  for (int i=0; i<nTasks; ++i)
+    gathered[i].assign(buffer.begin()+displ[i], buffer.begin()+displ[i]+count[i]);
+
+#endif
+
+  return gathered;
+}
+
+
+// ============================================================================
+
+
+std::vector<std::vector<double>> cbl::wrapper::mpi::alltoall (const std::vector<std::vector<double>> &data)
+{
+  const int nTasks = size();
+
+  if ((int)data.size()!=nTasks)
+    ErrorCBL("Error in alltoall() of MPIwrapper.cpp: the number of vectors must be equal to the number of tasks!");
+
+  if (nTasks==1) return data;
+
+  vector<vector<double>> received(nTasks);
+
+#ifdef USE_MPI
+
+  // the sizes of the vectors to be sent and received
+
+  vector<int> count_send(nTasks), displ_send(nTasks, 0), count_recv(nTasks), displ_recv(nTasks, 0);
+  for (int i=0; i<nTasks; ++i) count_send[i] = data[i].size();
+
+  MPI_Alltoall(count_send.data(), 1, MPI_INT, count_recv.data(), 1, MPI_INT, MPI_COMM_WORLD);
+
+  for (int i=1; i<nTasks; ++i) {
+    displ_send[i] = displ_send[i-1]+count_send[i-1];
+    displ_recv[i] = displ_recv[i-1]+count_recv[i-1];
+  }
+
+
+  // exchange the vectors
+
+  vector<double> buffer_send, buffer_recv(displ_recv[nTasks-1]+count_recv[nTasks-1]);
+  buffer_send.reserve(displ_send[nTasks-1]+count_send[nTasks-1]);
+  for (int i=0; i<nTasks; ++i)
+    buffer_send.insert(buffer_send.end(), data[i].begin(), data[i].end());
+
+  MPI_Alltoallv(buffer_send.data(), count_send.data(), displ_send.data(), MPI_DOUBLE, buffer_recv.data(), count_recv.data(), displ_recv.data(), MPI_DOUBLE, MPI_COMM_WORLD);
+
+  for (int i=0; i<nTasks; ++i)
+    received[i].assign(buffer_recv.begin()+displ_recv[i], buffer_recv.begin()+displ_recv[i]+count_recv[i]);
+
+#endif
+
+  return received;
+}
@@ -92,6 +92,7 @@ check("vectors", "vectors", "C++")
 check("eigen", "eigen", "C++") 
 
 check("randomNumbers", "randomNumbers", "C++") 
+check("randomNumbers", "counterRandomNumbers", "C++")
 
 check("wrappers", "integration_gsl", "C++")
 check("wrappers", "minimisation_gsl", "C++") 
@@ -108,14 +109,22 @@ check("cosmology", "model_cosmology", "C++")
 check("statistics/codes", "prior", "C++") 
 check("statistics/codes", "fit", "C++") 
 check("statistics/codes", "sampler", "C++")
+check("statistics/codes", "chainFile", "C++")
+check("statistics/codes", "nestedSampler", "C++")
 
 check("catalogue", "catalogue", "C++") 
+check("catalogue", "catalogueView", "C++")
+check("catalogue", "columnarFile", "C++")
+check("catalogue", "kdTree", "C++")
+check("catalogue", "mangleMask", "C++")
 
 check("numberCounts/codes", "numberCounts", "C++")
 check("numberCounts/codes", "numberCounts_errors", "C++")
 
 check("clustering/codes", "2pt_monopole", "C++") 
 check("clustering/codes", "2pt_monopole_errors", "C++")
+check("clustering/codes", "2pt_monopole_periodic", "C++")
+check("clustering/codes", "2pt_reproducibility", "C++")
 check("clustering/codes", "2pt_multipoles", "C++")
 check("clustering/codes", "2pt_2D", "C++")
 check("clustering/codes", "2pt_projected", "C++")